@@ -30,6 +30,7 @@
 #include <math.h>
 #include <stdint.h>
 #include <pios_math.h>
+#include <atan_lookup.h>
 #include "CoordinateConversions.h"
 
 #define MIN_ALLOWABLE_MAGNITUDE 1e-30f
@@ -148,6 +149,27 @@ void Quaternion2RPY(const float q[4], float rpy[3])
     // TODO: consider the cases where |R13| ~= 1, |pitch| ~= pi/2
 }
 
+// ****** find roll, pitch, yaw from quaternion using the table based trig
+// ****** routines; good to ~0.05 degree, for the per cycle state updates ******
+void Quaternion2RPYFast(const float q[4], float rpy[3])
+{
+    float R13, R11, R12, R23, R33;
+    float q0s = q[0] * q[0];
+    float q1s = q[1] * q[1];
+    float q2s = q[2] * q[2];
+    float q3s = q[3] * q[3];
+
+    R13    = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+    R11    = q0s + q1s - q2s - q3s;
+    R12    = 2.0f * (q[1] * q[2] + q[0] * q[3]);
+    R23    = 2.0f * (q[2] * q[3] + q[0] * q[1]);
+    R33    = q0s - q1s - q2s + q3s;
+
+    rpy[1] = RAD2DEG(fast_asinf(-R13)); // pitch always between -pi/2 to pi/2
+    rpy[2] = RAD2DEG(fast_atan2f(R12, R11));
+    rpy[0] = RAD2DEG(fast_atan2f(R23, R33));
+}
+
 // ****** find quaternion from roll, pitch, yaw ********
 void RPY2Quaternion(const float rpy[3], float q[4])
 {
@@ -266,6 +288,46 @@ void LLA2Base(int32_t LLAi[3], double BaseECEF[3], float Rne[3][3], float NED[3]
 }
 
 // ****** Express ECEF in a local NED Base Frame ********
+// ****** Precompute the local linearization of LLA to NED at a base ********
+void LLA2BaseLinearizedInit(LLA2BaseLinearization *lin, int32_t BaseLLAi[3])
+{
+    const float a  = 6378137.0f; // Equatorial Radius
+    const float e2 = 8.1819190842622e-2f * 8.1819190842622e-2f; // Eccentricity squared
+
+    float lat    = DEG2RAD((float)BaseLLAi[0] * 1e-7f);
+    float alt    = (float)BaseLLAi[2] * 1e-4f;
+    float sinLat = sinf(lat);
+    float cosLat = cosf(lat);
+    float den    = 1.0f - e2 * sinLat * sinLat;
+    float N = a / sqrtf(den); // prime vertical radius of curvature
+    float M = N * (1.0f - e2) / den; // meridional radius of curvature
+
+    lin->BaseLLAi[0] = BaseLLAi[0];
+    lin->BaseLLAi[1] = BaseLLAi[1];
+    lin->BaseLLAi[2] = BaseLLAi[2];
+    lin->mPerLati    = DEG2RAD(1e-7f) * (M + alt);
+    lin->mPerLoni    = DEG2RAD(1e-7f) * (N + alt) * cosLat;
+}
+
+// ****** Express LLA in a local NED Base Frame using the linearization ********
+// returns false if the position is outside the validity range of the
+// linearization and the caller should use the exact LLA2Base instead
+bool LLA2BaseLinearized(const LLA2BaseLinearization *lin, int32_t LLAi[3], float NED[3])
+{
+    int32_t dLat = LLAi[0] - lin->BaseLLAi[0];
+    int32_t dLon = LLAi[1] - lin->BaseLLAi[1];
+
+    if (dLat > LLA2BASE_LINEAR_RANGE || dLat < -LLA2BASE_LINEAR_RANGE ||
+        dLon > LLA2BASE_LINEAR_RANGE || dLon < -LLA2BASE_LINEAR_RANGE) {
+        return false;
+    }
+
+    NED[0] = (float)dLat * lin->mPerLati;
+    NED[1] = (float)dLon * lin->mPerLoni;
+    NED[2] = -(float)(LLAi[2] - lin->BaseLLAi[2]) * 1e-4f;
+    return true;
+}
+
 void ECEF2Base(double ECEF[3], double BaseECEF[3], float Rne[3][3], float NED[3])
 {
     float diff[3];
@@ -28,4 +28,8 @@
 #define PM_HEAP_SIZE 0x20000
 #define PM_FLOAT_LITTLE_ENDIAN
 
+/* All memspaces are flat memory on this platform, so fetch bytes in
+ * line rather than paying a function call per bytecode read. */
+#define mem_getByte(memspace, paddr) ((void)(memspace), *(*(paddr))++)
+
 #endif /* _PLAT_H_ */
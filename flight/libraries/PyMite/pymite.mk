@@ -62,7 +62,7 @@ $(OUTDIR)/pmlibusr_img.c: | $(OUTDIR)/pmlibusr_nat.c
 
 $(OUTDIR)/pmlibusr_nat.c: $(PYSCRIPTS)
 	@$(ECHO) $(MSG_PYMITEINIT) $(call toprel, $@)
-	$(V1) $(PYTHON) $(PYMITETOOLS)/pmImgCreator.py -c -u \
+	$(V1) $(PYTHON) $(PYMITETOOLS)/pmImgCreator.py -c -u --memspace=flash \
 			-f $(PYMITEPLAT)/pmfeatures.py \
 			-o $(OUTDIR)/pmlibusr_img.c \
 			--native-file=$(OUTDIR)/pmlibusr_nat.c \
@@ -54,7 +54,9 @@ typedef enum PmMemSpace_e
  * @return  byte from memory.
  *          paddr - points to the next byte
  */
+#ifndef mem_getByte
 #define mem_getByte(memspace, paddr) plat_memGetByte((memspace), (paddr))
+#endif
 
 /**
  * Returns the 2-byte word at the given address in memspace.
@@ -309,6 +309,88 @@ int WMM_GetMagVector(float Lat, float Lon, float AltEllipsoid, uint16_t Month, u
     return returned;
 }
 
+/**************************************************************************************
+* Cached grid front end to WMM_GetMagVector
+*
+* The full spherical harmonic evaluation takes long enough to visibly stall
+* the System thread, so repeated queries are served from a one cell
+* lat/lon/alt lattice that is filled lazily with the full model and
+* interpolated trilinearly.  The cell is only recomputed when the position
+* leaves it or the date changes, which keeps steady state queries down to a
+* handful of multiplies.
+**************************************************************************************/
+
+#define WMM_GRID_LAT_STEP 1.0f    // degrees, about 111 km
+#define WMM_GRID_LON_STEP 1.0f    // degrees
+#define WMM_GRID_ALT_STEP 2000.0f // meters
+
+static struct {
+    bool     valid;
+    uint16_t month;
+    uint16_t year;
+    float    lat0;
+    float    lon0;
+    float    alt0;
+    float    Be[2][2][2][3]; // corner field vectors indexed [lat][lon][alt]
+} mag_grid;
+
+int WMM_GetMagVectorInterpolated(float Lat, float Lon, float AltEllipsoid, uint16_t Month, uint16_t Day, uint16_t Year, float B[3])
+{
+    float lat0 = floorf(Lat / WMM_GRID_LAT_STEP) * WMM_GRID_LAT_STEP;
+    float lon0 = floorf(Lon / WMM_GRID_LON_STEP) * WMM_GRID_LON_STEP;
+    float alt0 = floorf(AltEllipsoid / WMM_GRID_ALT_STEP) * WMM_GRID_ALT_STEP;
+
+    if (lat0 + WMM_GRID_LAT_STEP > 90.0f) {
+        // no complete cell this close to the pole, use the full model
+        return WMM_GetMagVector(Lat, Lon, AltEllipsoid, Month, Day, Year, B);
+    }
+
+    if (!mag_grid.valid ||
+        lat0 != mag_grid.lat0 || lon0 != mag_grid.lon0 || alt0 != mag_grid.alt0 ||
+        Month != mag_grid.month || Year != mag_grid.year) {
+        // (re)fill the cell corners with the full model
+        mag_grid.valid = false;
+        for (int i = 0; i < 2; i++) {
+            for (int j = 0; j < 2; j++) {
+                for (int k = 0; k < 2; k++) {
+                    float lon = lon0 + (float)j * WMM_GRID_LON_STEP;
+                    if (lon > 180.0f) {
+                        lon -= 360.0f; // the field is continuous across the date line
+                    }
+                    if (WMM_GetMagVector(lat0 + (float)i * WMM_GRID_LAT_STEP, lon,
+                                         alt0 + (float)k * WMM_GRID_ALT_STEP,
+                                         Month, Day, Year, mag_grid.Be[i][j][k]) < 0) {
+                        // out of range or out of memory, let the full model decide
+                        return WMM_GetMagVector(Lat, Lon, AltEllipsoid, Month, Day, Year, B);
+                    }
+                }
+            }
+        }
+        mag_grid.lat0  = lat0;
+        mag_grid.lon0  = lon0;
+        mag_grid.alt0  = alt0;
+        mag_grid.month = Month;
+        mag_grid.year  = Year;
+        mag_grid.valid = true;
+    }
+
+    float fx = (Lat - lat0) / WMM_GRID_LAT_STEP;
+    float fy = (Lon - lon0) / WMM_GRID_LON_STEP;
+    float fz = (AltEllipsoid - alt0) / WMM_GRID_ALT_STEP;
+
+    for (int c = 0; c < 3; c++) {
+        float c00 = mag_grid.Be[0][0][0][c] * (1.0f - fx) + mag_grid.Be[1][0][0][c] * fx;
+        float c10 = mag_grid.Be[0][1][0][c] * (1.0f - fx) + mag_grid.Be[1][1][0][c] * fx;
+        float c01 = mag_grid.Be[0][0][1][c] * (1.0f - fx) + mag_grid.Be[1][0][1][c] * fx;
+        float c11 = mag_grid.Be[0][1][1][c] * (1.0f - fx) + mag_grid.Be[1][1][1][c] * fx;
+        float c0  = c00 * (1.0f - fy) + c10 * fy;
+        float c1  = c01 * (1.0f - fy) + c11 * fy;
+        B[c] = c0 * (1.0f - fz) + c1 * fz;
+    }
+
+    return 0;
+}
+
 int WMM_Geomag(WMMtype_CoordSpherical *CoordSpherical, WMMtype_CoordGeodetic *CoordGeodetic, WMMtype_GeoMagneticElements *GeoMagneticElements)
 /*
    The main subroutine that calls a sequence of WMM sub-functions to calculate the magnetic field elements for a single point.
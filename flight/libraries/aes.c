@@ -4,6 +4,13 @@
 
 #include "aes.h"
 
+/*
+ * When PIOS_INCLUDE_AES_HW is defined, a hardware backend (e.g. the STM32F4
+ * CRYP peripheral on targets that have it) provides the interface declared
+ * in aes.h and the software implementation below is compiled out.
+ */
+#ifndef PIOS_INCLUDE_AES_HW
+
 #define BPOLY 0x1B
 #define DPOLY 0x8D
 
@@ -45,98 +52,97 @@ const uint8_t isbox[256] = {
     0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
 };
 
-// #define xtime(x)	( (x << 1) ^ (((x >> 7) & 1) * BPOLY) )
-// #define xtime(x)	( (x << 1) ^ ((x & 0x80) ? BPOLY : 0) )
-
-const uint8_t xtime[256] = {
-    0x00, 0x02, 0x04, 0x06, 0x08, 0x0a, 0x0c, 0x0e, 0x10, 0x12, 0x14, 0x16, 0x18, 0x1a, 0x1c, 0x1e,
-    0x20, 0x22, 0x24, 0x26, 0x28, 0x2a, 0x2c, 0x2e, 0x30, 0x32, 0x34, 0x36, 0x38, 0x3a, 0x3c, 0x3e,
-    0x40, 0x42, 0x44, 0x46, 0x48, 0x4a, 0x4c, 0x4e, 0x50, 0x52, 0x54, 0x56, 0x58, 0x5a, 0x5c, 0x5e,
-    0x60, 0x62, 0x64, 0x66, 0x68, 0x6a, 0x6c, 0x6e, 0x70, 0x72, 0x74, 0x76, 0x78, 0x7a, 0x7c, 0x7e,
-    0x80, 0x82, 0x84, 0x86, 0x88, 0x8a, 0x8c, 0x8e, 0x90, 0x92, 0x94, 0x96, 0x98, 0x9a, 0x9c, 0x9e,
-    0xa0, 0xa2, 0xa4, 0xa6, 0xa8, 0xaa, 0xac, 0xae, 0xb0, 0xb2, 0xb4, 0xb6, 0xb8, 0xba, 0xbc, 0xbe,
-    0xc0, 0xc2, 0xc4, 0xc6, 0xc8, 0xca, 0xcc, 0xce, 0xd0, 0xd2, 0xd4, 0xd6, 0xd8, 0xda, 0xdc, 0xde,
-    0xe0, 0xe2, 0xe4, 0xe6, 0xe8, 0xea, 0xec, 0xee, 0xf0, 0xf2, 0xf4, 0xf6, 0xf8, 0xfa, 0xfc, 0xfe,
-    0x1b, 0x19, 0x1f, 0x1d, 0x13, 0x11, 0x17, 0x15, 0x0b, 0x09, 0x0f, 0x0d, 0x03, 0x01, 0x07, 0x05,
-    0x3b, 0x39, 0x3f, 0x3d, 0x33, 0x31, 0x37, 0x35, 0x2b, 0x29, 0x2f, 0x2d, 0x23, 0x21, 0x27, 0x25,
-    0x5b, 0x59, 0x5f, 0x5d, 0x53, 0x51, 0x57, 0x55, 0x4b, 0x49, 0x4f, 0x4d, 0x43, 0x41, 0x47, 0x45,
-    0x7b, 0x79, 0x7f, 0x7d, 0x73, 0x71, 0x77, 0x75, 0x6b, 0x69, 0x6f, 0x6d, 0x63, 0x61, 0x67, 0x65,
-    0x9b, 0x99, 0x9f, 0x9d, 0x93, 0x91, 0x97, 0x95, 0x8b, 0x89, 0x8f, 0x8d, 0x83, 0x81, 0x87, 0x85,
-    0xbb, 0xb9, 0xbf, 0xbd, 0xb3, 0xb1, 0xb7, 0xb5, 0xab, 0xa9, 0xaf, 0xad, 0xa3, 0xa1, 0xa7, 0xa5,
-    0xdb, 0xd9, 0xdf, 0xdd, 0xd3, 0xd1, 0xd7, 0xd5, 0xcb, 0xc9, 0xcf, 0xcd, 0xc3, 0xc1, 0xc7, 0xc5,
-    0xfb, 0xf9, 0xff, 0xfd, 0xf3, 0xf1, 0xf7, 0xf5, 0xeb, 0xe9, 0xef, 0xed, 0xe3, 0xe1, 0xe7, 0xe5
-};
-
-// ***********************************************************************************
-/*
-   void createXTimeTable(void)
-   {
-        uint8_t i = 0;
-        do {
-                xtime[i] = (i << 1) ^ ((i & 0x80) ? BPOLY : 0);
-        } while (++i != 0);
-   }
- */
-// ***********************************************************************************
 /*
-   uint8_t powTable[256];
-   uint8_t logTable[256];
-
-   uint8_t sbox[256];
-   uint8_t isbox[256];
-
-   void createPowLogTables(void)
-   {
-        uint8_t i = 0;
-        uint8_t t = 1;
-
-        do {
-                powTable[i] = t;
-                logTable[t] = i;
-                i++;
-                t ^= (t << 1) ^ ((t & 0x80) ? BPOLY : 0);
-        } while (t != 1);
-
-        powTable[255] = powTable[0];
-   }
-
-   void createSubstitueBoxTable(void)
-   {
-        int i = 0;
-        do {
-                uint8_t temp;
-
-                if (i > 0)
-                        temp = powTable[255 - logTable[i]];
-                else
-                        temp = 0;
-
-                uint8_t sb = temp ^ 0x63;
-                for (int j = 0; j < 4; j++)
-                {
-                        temp = (temp << 1) | (temp >> 7);
-                        sb ^= temp;
-                }
-
-                sbox[i] = sb;
-        } while (++i != 0);
-   }
-
-   void createInverseSubstitueBoxTable(void)
-   {
-        uint8_t i = 0;
-        uint8_t j = 0;
-        do {
-                do {
-                        if (sbox[j] == i)
-                        {
-                                isbox[i] = j;
-                                j = 255;
-                        }
-                } while (++j != 0);
-        } while (++i != 0);
-   }
+ * Round tables for the T-table formulation.  The state is held as four
+ * little endian 32 bit column words.  t_fwd[x] packs the MixColumns
+ * multiples of sbox[x] as (2s, s, s, 3s); a full encryption round then
+ * collapses SubBytes, ShiftRows and MixColumns into four table lookups
+ * plus rotations per column.  t_inv[x] packs (0e x, 09 x, 0d x, 0b x)
+ * and applies InvMixColumns to a column the same way.
  */
+static const uint32_t t_fwd[256] = {
+    0xa56363c6, 0x847c7cf8, 0x997777ee, 0x8d7b7bf6, 0x0df2f2ff, 0xbd6b6bd6, 0xb16f6fde, 0x54c5c591,
+    0x50303060, 0x03010102, 0xa96767ce, 0x7d2b2b56, 0x19fefee7, 0x62d7d7b5, 0xe6abab4d, 0x9a7676ec,
+    0x45caca8f, 0x9d82821f, 0x40c9c989, 0x877d7dfa, 0x15fafaef, 0xeb5959b2, 0xc947478e, 0x0bf0f0fb,
+    0xecadad41, 0x67d4d4b3, 0xfda2a25f, 0xeaafaf45, 0xbf9c9c23, 0xf7a4a453, 0x967272e4, 0x5bc0c09b,
+    0xc2b7b775, 0x1cfdfde1, 0xae93933d, 0x6a26264c, 0x5a36366c, 0x413f3f7e, 0x02f7f7f5, 0x4fcccc83,
+    0x5c343468, 0xf4a5a551, 0x34e5e5d1, 0x08f1f1f9, 0x937171e2, 0x73d8d8ab, 0x53313162, 0x3f15152a,
+    0x0c040408, 0x52c7c795, 0x65232346, 0x5ec3c39d, 0x28181830, 0xa1969637, 0x0f05050a, 0xb59a9a2f,
+    0x0907070e, 0x36121224, 0x9b80801b, 0x3de2e2df, 0x26ebebcd, 0x6927274e, 0xcdb2b27f, 0x9f7575ea,
+    0x1b090912, 0x9e83831d, 0x742c2c58, 0x2e1a1a34, 0x2d1b1b36, 0xb26e6edc, 0xee5a5ab4, 0xfba0a05b,
+    0xf65252a4, 0x4d3b3b76, 0x61d6d6b7, 0xceb3b37d, 0x7b292952, 0x3ee3e3dd, 0x712f2f5e, 0x97848413,
+    0xf55353a6, 0x68d1d1b9, 0x00000000, 0x2cededc1, 0x60202040, 0x1ffcfce3, 0xc8b1b179, 0xed5b5bb6,
+    0xbe6a6ad4, 0x46cbcb8d, 0xd9bebe67, 0x4b393972, 0xde4a4a94, 0xd44c4c98, 0xe85858b0, 0x4acfcf85,
+    0x6bd0d0bb, 0x2aefefc5, 0xe5aaaa4f, 0x16fbfbed, 0xc5434386, 0xd74d4d9a, 0x55333366, 0x94858511,
+    0xcf45458a, 0x10f9f9e9, 0x06020204, 0x817f7ffe, 0xf05050a0, 0x443c3c78, 0xba9f9f25, 0xe3a8a84b,
+    0xf35151a2, 0xfea3a35d, 0xc0404080, 0x8a8f8f05, 0xad92923f, 0xbc9d9d21, 0x48383870, 0x04f5f5f1,
+    0xdfbcbc63, 0xc1b6b677, 0x75dadaaf, 0x63212142, 0x30101020, 0x1affffe5, 0x0ef3f3fd, 0x6dd2d2bf,
+    0x4ccdcd81, 0x140c0c18, 0x35131326, 0x2fececc3, 0xe15f5fbe, 0xa2979735, 0xcc444488, 0x3917172e,
+    0x57c4c493, 0xf2a7a755, 0x827e7efc, 0x473d3d7a, 0xac6464c8, 0xe75d5dba, 0x2b191932, 0x957373e6,
+    0xa06060c0, 0x98818119, 0xd14f4f9e, 0x7fdcdca3, 0x66222244, 0x7e2a2a54, 0xab90903b, 0x8388880b,
+    0xca46468c, 0x29eeeec7, 0xd3b8b86b, 0x3c141428, 0x79dedea7, 0xe25e5ebc, 0x1d0b0b16, 0x76dbdbad,
+    0x3be0e0db, 0x56323264, 0x4e3a3a74, 0x1e0a0a14, 0xdb494992, 0x0a06060c, 0x6c242448, 0xe45c5cb8,
+    0x5dc2c29f, 0x6ed3d3bd, 0xefacac43, 0xa66262c4, 0xa8919139, 0xa4959531, 0x37e4e4d3, 0x8b7979f2,
+    0x32e7e7d5, 0x43c8c88b, 0x5937376e, 0xb76d6dda, 0x8c8d8d01, 0x64d5d5b1, 0xd24e4e9c, 0xe0a9a949,
+    0xb46c6cd8, 0xfa5656ac, 0x07f4f4f3, 0x25eaeacf, 0xaf6565ca, 0x8e7a7af4, 0xe9aeae47, 0x18080810,
+    0xd5baba6f, 0x887878f0, 0x6f25254a, 0x722e2e5c, 0x241c1c38, 0xf1a6a657, 0xc7b4b473, 0x51c6c697,
+    0x23e8e8cb, 0x7cdddda1, 0x9c7474e8, 0x211f1f3e, 0xdd4b4b96, 0xdcbdbd61, 0x868b8b0d, 0x858a8a0f,
+    0x907070e0, 0x423e3e7c, 0xc4b5b571, 0xaa6666cc, 0xd8484890, 0x05030306, 0x01f6f6f7, 0x120e0e1c,
+    0xa36161c2, 0x5f35356a, 0xf95757ae, 0xd0b9b969, 0x91868617, 0x58c1c199, 0x271d1d3a, 0xb99e9e27,
+    0x38e1e1d9, 0x13f8f8eb, 0xb398982b, 0x33111122, 0xbb6969d2, 0x70d9d9a9, 0x898e8e07, 0xa7949433,
+    0xb69b9b2d, 0x221e1e3c, 0x92878715, 0x20e9e9c9, 0x49cece87, 0xff5555aa, 0x78282850, 0x7adfdfa5,
+    0x8f8c8c03, 0xf8a1a159, 0x80898909, 0x170d0d1a, 0xdabfbf65, 0x31e6e6d7, 0xc6424284, 0xb86868d0,
+    0xc3414182, 0xb0999929, 0x772d2d5a, 0x110f0f1e, 0xcbb0b07b, 0xfc5454a8, 0xd6bbbb6d, 0x3a16162c
+};
+
+static const uint32_t t_inv[256] = {
+    0x00000000, 0x0b0d090e, 0x161a121c, 0x1d171b12, 0x2c342438, 0x27392d36, 0x3a2e3624, 0x31233f2a,
+    0x58684870, 0x5365417e, 0x4e725a6c, 0x457f5362, 0x745c6c48, 0x7f516546, 0x62467e54, 0x694b775a,
+    0xb0d090e0, 0xbbdd99ee, 0xa6ca82fc, 0xadc78bf2, 0x9ce4b4d8, 0x97e9bdd6, 0x8afea6c4, 0x81f3afca,
+    0xe8b8d890, 0xe3b5d19e, 0xfea2ca8c, 0xf5afc382, 0xc48cfca8, 0xcf81f5a6, 0xd296eeb4, 0xd99be7ba,
+    0x7bbb3bdb, 0x70b632d5, 0x6da129c7, 0x66ac20c9, 0x578f1fe3, 0x5c8216ed, 0x41950dff, 0x4a9804f1,
+    0x23d373ab, 0x28de7aa5, 0x35c961b7, 0x3ec468b9, 0x0fe75793, 0x04ea5e9d, 0x19fd458f, 0x12f04c81,
+    0xcb6bab3b, 0xc066a235, 0xdd71b927, 0xd67cb029, 0xe75f8f03, 0xec52860d, 0xf1459d1f, 0xfa489411,
+    0x9303e34b, 0x980eea45, 0x8519f157, 0x8e14f859, 0xbf37c773, 0xb43ace7d, 0xa92dd56f, 0xa220dc61,
+    0xf66d76ad, 0xfd607fa3, 0xe07764b1, 0xeb7a6dbf, 0xda595295, 0xd1545b9b, 0xcc434089, 0xc74e4987,
+    0xae053edd, 0xa50837d3, 0xb81f2cc1, 0xb31225cf, 0x82311ae5, 0x893c13eb, 0x942b08f9, 0x9f2601f7,
+    0x46bde64d, 0x4db0ef43, 0x50a7f451, 0x5baafd5f, 0x6a89c275, 0x6184cb7b, 0x7c93d069, 0x779ed967,
+    0x1ed5ae3d, 0x15d8a733, 0x08cfbc21, 0x03c2b52f, 0x32e18a05, 0x39ec830b, 0x24fb9819, 0x2ff69117,
+    0x8dd64d76, 0x86db4478, 0x9bcc5f6a, 0x90c15664, 0xa1e2694e, 0xaaef6040, 0xb7f87b52, 0xbcf5725c,
+    0xd5be0506, 0xdeb30c08, 0xc3a4171a, 0xc8a91e14, 0xf98a213e, 0xf2872830, 0xef903322, 0xe49d3a2c,
+    0x3d06dd96, 0x360bd498, 0x2b1ccf8a, 0x2011c684, 0x1132f9ae, 0x1a3ff0a0, 0x0728ebb2, 0x0c25e2bc,
+    0x656e95e6, 0x6e639ce8, 0x737487fa, 0x78798ef4, 0x495ab1de, 0x4257b8d0, 0x5f40a3c2, 0x544daacc,
+    0xf7daec41, 0xfcd7e54f, 0xe1c0fe5d, 0xeacdf753, 0xdbeec879, 0xd0e3c177, 0xcdf4da65, 0xc6f9d36b,
+    0xafb2a431, 0xa4bfad3f, 0xb9a8b62d, 0xb2a5bf23, 0x83868009, 0x888b8907, 0x959c9215, 0x9e919b1b,
+    0x470a7ca1, 0x4c0775af, 0x51106ebd, 0x5a1d67b3, 0x6b3e5899, 0x60335197, 0x7d244a85, 0x7629438b,
+    0x1f6234d1, 0x146f3ddf, 0x097826cd, 0x02752fc3, 0x335610e9, 0x385b19e7, 0x254c02f5, 0x2e410bfb,
+    0x8c61d79a, 0x876cde94, 0x9a7bc586, 0x9176cc88, 0xa055f3a2, 0xab58faac, 0xb64fe1be, 0xbd42e8b0,
+    0xd4099fea, 0xdf0496e4, 0xc2138df6, 0xc91e84f8, 0xf83dbbd2, 0xf330b2dc, 0xee27a9ce, 0xe52aa0c0,
+    0x3cb1477a, 0x37bc4e74, 0x2aab5566, 0x21a65c68, 0x10856342, 0x1b886a4c, 0x069f715e, 0x0d927850,
+    0x64d90f0a, 0x6fd40604, 0x72c31d16, 0x79ce1418, 0x48ed2b32, 0x43e0223c, 0x5ef7392e, 0x55fa3020,
+    0x01b79aec, 0x0aba93e2, 0x17ad88f0, 0x1ca081fe, 0x2d83bed4, 0x268eb7da, 0x3b99acc8, 0x3094a5c6,
+    0x59dfd29c, 0x52d2db92, 0x4fc5c080, 0x44c8c98e, 0x75ebf6a4, 0x7ee6ffaa, 0x63f1e4b8, 0x68fcedb6,
+    0xb1670a0c, 0xba6a0302, 0xa77d1810, 0xac70111e, 0x9d532e34, 0x965e273a, 0x8b493c28, 0x80443526,
+    0xe90f427c, 0xe2024b72, 0xff155060, 0xf418596e, 0xc53b6644, 0xce366f4a, 0xd3217458, 0xd82c7d56,
+    0x7a0ca137, 0x7101a839, 0x6c16b32b, 0x671bba25, 0x5638850f, 0x5d358c01, 0x40229713, 0x4b2f9e1d,
+    0x2264e947, 0x2969e049, 0x347efb5b, 0x3f73f255, 0x0e50cd7f, 0x055dc471, 0x184adf63, 0x1347d66d,
+    0xcadc31d7, 0xc1d138d9, 0xdcc623cb, 0xd7cb2ac5, 0xe6e815ef, 0xede51ce1, 0xf0f207f3, 0xfbff0efd,
+    0x92b479a7, 0x99b970a9, 0x84ae6bbb, 0x8fa362b5, 0xbe805d9f, 0xb58d5491, 0xa89a4f83, 0xa397468d
+};
+
+#define GETWORD(p)    ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+#define PUTWORD(p, w) \
+    do { \
+        (p)[0] = (uint8_t)(w); \
+        (p)[1] = (uint8_t)((w) >> 8); \
+        (p)[2] = (uint8_t)((w) >> 16); \
+        (p)[3] = (uint8_t)((w) >> 24); \
+    } while (0)
+
+#define ROTL8(w)      (((w) << 8) | ((w) >> 24))
+#define ROTL16(w)     (((w) << 16) | ((w) >> 16))
+#define ROTL24(w)     (((w) << 24) | ((w) >> 8))
+
 // ***********************************************************************************
 
 void copy_block(void *d, void *s)
@@ -186,106 +192,84 @@ void xor_sub_rot_word(uint8_t *d, uint8_t *s, uint8_t rc)
     *d++ ^= sbox[s[0]];
 }
 
-void mix_sub_column(uint8_t *a)
+// ***********************************************************************************
+
+static void load_state(uint32_t *s, uint8_t *data)
 {
-    uint8_t a0  = a[0];
-    uint8_t a1  = a[1];
-    uint8_t a2  = a[2];
-    uint8_t a3  = a[3];
-    uint8_t tmp = a0 ^ a1 ^ a2 ^ a3;
-
-    a[0] = a0 ^ xtime[a0 ^ a1] ^ tmp;
-    a[1] = a1 ^ xtime[a1 ^ a2] ^ tmp;
-    a[2] = a2 ^ xtime[a2 ^ a3] ^ tmp;
-    a[3] = a3 ^ xtime[a3 ^ a0] ^ tmp;
+    s[0] = GETWORD(data + 0);
+    s[1] = GETWORD(data + 4);
+    s[2] = GETWORD(data + 8);
+    s[3] = GETWORD(data + 12);
 }
 
-void mix_sub_columns(void *a)
+static void store_state(uint32_t *s, uint8_t *data)
 {
-    mix_sub_column((uint8_t *)a + 0);
-    mix_sub_column((uint8_t *)a + 4);
-    mix_sub_column((uint8_t *)a + 8);
-    mix_sub_column((uint8_t *)a + 12);
+    PUTWORD(data + 0, s[0]);
+    PUTWORD(data + 4, s[1]);
+    PUTWORD(data + 8, s[2]);
+    PUTWORD(data + 12, s[3]);
 }
 
-void inv_mix_sub_column(uint8_t *a)
+static void add_round_key(uint32_t *s, uint8_t *k)
 {
-    uint8_t tmp;
-
-    tmp   = xtime[xtime[a[0] ^ a[2]]];
-    a[0] ^= tmp;
-    a[2] ^= tmp;
-    tmp   = xtime[xtime[a[1] ^ a[3]]];
-    a[1] ^= tmp;
-    a[3] ^= tmp;
+    s[0] ^= GETWORD(k + 0);
+    s[1] ^= GETWORD(k + 4);
+    s[2] ^= GETWORD(k + 8);
+    s[3] ^= GETWORD(k + 12);
 }
 
-void inv_mix_sub_columns(void *a)
+// SubBytes + ShiftRows + MixColumns + AddRoundKey in one pass
+static void enc_round(uint32_t *s, uint8_t *k)
 {
-    inv_mix_sub_column((uint8_t *)a + 0);
-    inv_mix_sub_column((uint8_t *)a + 4);
-    inv_mix_sub_column((uint8_t *)a + 8);
-    inv_mix_sub_column((uint8_t *)a + 12);
+    uint32_t t0, t1, t2, t3;
+
+    t0   = t_fwd[s[0] & 0xff] ^ ROTL8(t_fwd[(s[1] >> 8) & 0xff]) ^ ROTL16(t_fwd[(s[2] >> 16) & 0xff]) ^ ROTL24(t_fwd[s[3] >> 24]) ^ GETWORD(k + 0);
+    t1   = t_fwd[s[1] & 0xff] ^ ROTL8(t_fwd[(s[2] >> 8) & 0xff]) ^ ROTL16(t_fwd[(s[3] >> 16) & 0xff]) ^ ROTL24(t_fwd[s[0] >> 24]) ^ GETWORD(k + 4);
+    t2   = t_fwd[s[2] & 0xff] ^ ROTL8(t_fwd[(s[3] >> 8) & 0xff]) ^ ROTL16(t_fwd[(s[0] >> 16) & 0xff]) ^ ROTL24(t_fwd[s[1] >> 24]) ^ GETWORD(k + 8);
+    t3   = t_fwd[s[3] & 0xff] ^ ROTL8(t_fwd[(s[0] >> 8) & 0xff]) ^ ROTL16(t_fwd[(s[1] >> 16) & 0xff]) ^ ROTL24(t_fwd[s[2] >> 24]) ^ GETWORD(k + 12);
+    s[0] = t0;
+    s[1] = t1;
+    s[2] = t2;
+    s[3] = t3;
+}
 
-    mix_sub_columns(a);
+// SubBytes + ShiftRows + AddRoundKey, the last round has no MixColumns
+static void enc_round_final(uint32_t *s, uint8_t *k)
+{
+    uint32_t t0, t1, t2, t3;
+
+    t0   = (uint32_t)sbox[s[0] & 0xff] | (uint32_t)sbox[(s[1] >> 8) & 0xff] << 8 | (uint32_t)sbox[(s[2] >> 16) & 0xff] << 16 | (uint32_t)sbox[s[3] >> 24] << 24;
+    t1   = (uint32_t)sbox[s[1] & 0xff] | (uint32_t)sbox[(s[2] >> 8) & 0xff] << 8 | (uint32_t)sbox[(s[3] >> 16) & 0xff] << 16 | (uint32_t)sbox[s[0] >> 24] << 24;
+    t2   = (uint32_t)sbox[s[2] & 0xff] | (uint32_t)sbox[(s[3] >> 8) & 0xff] << 8 | (uint32_t)sbox[(s[0] >> 16) & 0xff] << 16 | (uint32_t)sbox[s[1] >> 24] << 24;
+    t3   = (uint32_t)sbox[s[3] & 0xff] | (uint32_t)sbox[(s[0] >> 8) & 0xff] << 8 | (uint32_t)sbox[(s[1] >> 16) & 0xff] << 16 | (uint32_t)sbox[s[2] >> 24] << 24;
+    s[0] = t0 ^ GETWORD(k + 0);
+    s[1] = t1 ^ GETWORD(k + 4);
+    s[2] = t2 ^ GETWORD(k + 8);
+    s[3] = t3 ^ GETWORD(k + 12);
 }
 
-void shift_sub_rows(uint8_t *a)
+// InvShiftRows + InvSubBytes
+static void dec_sub_shift(uint32_t *s)
 {
-    uint8_t tmp;
-
-    a[0]  = sbox[a[0]];
-    a[4]  = sbox[a[4]];
-    a[8]  = sbox[a[8]];
-    a[12] = sbox[a[12]];
-
-    tmp   = a[1];
-    a[1]  = sbox[a[5]];
-    a[5]  = sbox[a[9]];
-    a[9]  = sbox[a[13]];
-    a[13] = sbox[tmp];
-
-    tmp   = a[2];
-    a[2]  = sbox[a[10]];
-    a[10] = sbox[tmp];
-    tmp   = a[6];
-    a[6]  = sbox[a[14]];
-    a[14] = sbox[tmp];
-
-    tmp   = a[15];
-    a[15] = sbox[a[11]];
-    a[11] = sbox[a[7]];
-    a[7]  = sbox[a[3]];
-    a[3]  = sbox[tmp];
+    uint32_t t0, t1, t2, t3;
+
+    t0   = (uint32_t)isbox[s[0] & 0xff] | (uint32_t)isbox[(s[3] >> 8) & 0xff] << 8 | (uint32_t)isbox[(s[2] >> 16) & 0xff] << 16 | (uint32_t)isbox[s[1] >> 24] << 24;
+    t1   = (uint32_t)isbox[s[1] & 0xff] | (uint32_t)isbox[(s[0] >> 8) & 0xff] << 8 | (uint32_t)isbox[(s[3] >> 16) & 0xff] << 16 | (uint32_t)isbox[s[2] >> 24] << 24;
+    t2   = (uint32_t)isbox[s[2] & 0xff] | (uint32_t)isbox[(s[1] >> 8) & 0xff] << 8 | (uint32_t)isbox[(s[0] >> 16) & 0xff] << 16 | (uint32_t)isbox[s[3] >> 24] << 24;
+    t3   = (uint32_t)isbox[s[3] & 0xff] | (uint32_t)isbox[(s[2] >> 8) & 0xff] << 8 | (uint32_t)isbox[(s[1] >> 16) & 0xff] << 16 | (uint32_t)isbox[s[0] >> 24] << 24;
+    s[0] = t0;
+    s[1] = t1;
+    s[2] = t2;
+    s[3] = t3;
 }
 
-void inv_shift_sub_rows(uint8_t *a)
+// InvMixColumns on all four columns
+static void dec_mix(uint32_t *s)
 {
-    uint8_t tmp;
-
-    a[0]  = isbox[a[0]];
-    a[4]  = isbox[a[4]];
-    a[8]  = isbox[a[8]];
-    a[12] = isbox[a[12]];
-
-    tmp   = a[13];
-    a[13] = isbox[a[9]];
-    a[9]  = isbox[a[5]];
-    a[5]  = isbox[a[1]];
-    a[1]  = isbox[tmp];
-
-    tmp   = a[2];
-    a[2]  = isbox[a[10]];
-    a[10] = isbox[tmp];
-    tmp   = a[6];
-    a[6]  = isbox[a[14]];
-    a[14] = isbox[tmp];
-
-    tmp   = a[3];
-    a[3]  = isbox[a[7]];
-    a[7]  = isbox[a[11]];
-    a[11] = isbox[a[15]];
-    a[15] = isbox[tmp];
+    for (int i = 0; i < 4; i++) {
+        uint32_t w = s[i];
+        s[i] = t_inv[w & 0xff] ^ ROTL8(t_inv[(w >> 8) & 0xff]) ^ ROTL16(t_inv[(w >> 16) & 0xff]) ^ ROTL24(t_inv[w >> 24]);
+    }
 }
 
 // ***********************************************************************************
@@ -305,22 +289,25 @@ void update_encrypt_key_128(uint8_t *k, uint8_t *rc)
 // Encrypt a single block of 16 bytes
 void aes_encrypt_cbc_128(void *data, void *key, void *chain_block)
 {
+    uint32_t s[4];
+
     uint8_t rc = 1;
 
     if (chain_block) {
         xor_block(data, chain_block);
     }
 
-    for (int round = 10; round; --round) {
-        xor_block(data, key); // add_round_key
-        update_encrypt_key_128((uint8_t *)key, &rc);
-        shift_sub_rows(data);
-        if (round <= 1) {
-            continue;
-        }
-        mix_sub_columns(data);
+    load_state(s, data);
+    add_round_key(s, key);
+
+    for (int round = 9; round; --round) {
+        update_encrypt_key_128(key, &rc);
+        enc_round(s, key);
     }
-    xor_block(data, key); // add_round_key
+    update_encrypt_key_128(key, &rc);
+    enc_round_final(s, key);
+
+    store_state(s, data);
 
     if (chain_block) {
         copy_block(chain_block, data);
@@ -343,21 +330,24 @@ void update_decrypt_key_128(uint8_t *k, uint8_t *rc)
 void aes_decrypt_cbc_128(void *data, void *key, void *chain_block)
 {
     uint8_t tmp_data[N_BLOCK];
+    uint32_t s[4];
 
     uint8_t rc = 0x6c;
 
     copy_block(tmp_data, data);
 
-    xor_block(data, key); // add_round_key
+    load_state(s, data);
+    add_round_key(s, key);
     for (int round = 10; round; --round) {
-        inv_shift_sub_rows(data);
+        dec_sub_shift(s);
         update_decrypt_key_128(key, &rc);
-        xor_block(data, key); // add_round_key
+        add_round_key(s, key);
         if (round <= 1) {
             continue;
         }
-        inv_mix_sub_columns(data);
+        dec_mix(s);
     }
+    store_state(s, data);
 
     if (chain_block) {
         xor_block(data, chain_block);
@@ -398,30 +388,27 @@ void update_encrypt_key_256(uint8_t *k, uint8_t *rc)
 // Encrypt a single block of 16 bytes
 void aes_encrypt_cbc_256(void *data, void *key, void *chain_block)
 {
+    uint32_t s[4];
+
     uint8_t rc = 1;
 
     if (chain_block) {
         xor_block(data, chain_block);
     }
 
-    for (int round = 7; round; --round) {
-// printf("key - ");
-// uint8_t *p = key;
-// for (int i = 0; i < 32; i++) printf("%0.2X ", *p++);
-// printf("\r\n");
-
-        xor_block(data, key); // add_round_key
-        shift_sub_rows(data);
-        mix_sub_columns(data);
-        xor_block(data, (uint8_t *)key + 16); // add_round_key
+    load_state(s, data);
+    add_round_key(s, key);
+
+    enc_round(s, (uint8_t *)key + 16);
+    for (int round = 6; round; --round) {
         update_encrypt_key_256(key, &rc);
-        shift_sub_rows(data);
-        if (round <= 1) {
-            continue;
-        }
-        mix_sub_columns(data);
+        enc_round(s, key);
+        enc_round(s, (uint8_t *)key + 16);
     }
-    xor_block(data, key); // add_round_key
+    update_encrypt_key_256(key, &rc);
+    enc_round_final(s, key);
+
+    store_state(s, data);
 
     if (chain_block) {
         copy_block(chain_block, data);
@@ -450,24 +437,27 @@ void update_decrypt_key_256(uint8_t *k, uint8_t *rc)
 void aes_decrypt_cbc_256(void *data, void *key, void *chain_block)
 {
     uint8_t tmp_data[N_BLOCK];
+    uint32_t s[4];
 
     uint8_t rc = 0x80;
 
     copy_block(tmp_data, data);
 
-    xor_block(data, key); // add_round_key
+    load_state(s, data);
+    add_round_key(s, key);
     for (int round = 7; round; --round) {
-        inv_shift_sub_rows(data);
+        dec_sub_shift(s);
         update_decrypt_key_256(key, &rc);
-        xor_block(data, (uint8_t *)key + 16); // add_round_key
-        inv_mix_sub_columns(data);
-        inv_shift_sub_rows(data);
-        xor_block(data, key); // add_round_key
+        add_round_key(s, (uint8_t *)key + 16);
+        dec_mix(s);
+        dec_sub_shift(s);
+        add_round_key(s, key);
         if (round <= 1) {
             continue;
         }
-        inv_mix_sub_columns(data);
+        dec_mix(s);
     }
+    store_state(s, data);
 
     if (chain_block) {
         xor_block(data, chain_block);
@@ -488,4 +478,6 @@ void aes_decrypt_key_256_create(void *enc_key, void *dec_key)
     }
 }
 
+#endif /* PIOS_INCLUDE_AES_HW */
+
 // ***********************************************************************************
@@ -37,14 +37,23 @@
         #define PIOS_ALARM_GRACETIME 1000
 #endif // PIOS_ALARM_GRACETIME
 
+// Maximum number of change notification callbacks
+#define ALARMS_MAX_CHANGE_CALLBACKS 2
+
 // Private types
 
 // Private variables
 static xSemaphoreHandle lock;
 static volatile uint16_t lastAlarmChange[SYSTEMALARMS_ALARM_NUMELEM] = { 0 }; // this deliberately overflows every 2^16 milliseconds to save memory
+// Per-severity bitmask of active alarms, maintained on every alarm write so
+// severity queries don't have to rescan the whole alarm array
+static volatile uint32_t severityMask[SYSTEMALARMS_ALARM_ERROR + 1];
+static AlarmsChangeCallback changeCallbacks[ALARMS_MAX_CHANGE_CALLBACKS];
 
 // Private functions
 static int32_t hasSeverity(SystemAlarmsAlarmOptions severity);
+static void updateSeverityMask(SystemAlarmsAlarmData *alarms);
+static void notifyChange(void);
 
 /**
  * Initialize the alarms library
@@ -57,9 +66,38 @@ int32_t AlarmsInitialize(void)
     // do not change the default states of the alarms, let the init code generated by the uavobjectgenerator handle that
     // AlarmsClearAll();
     // AlarmsDefaultAll();
+
+    // Seed the severity summary from the current alarm states
+    SystemAlarmsAlarmData alarms;
+    SystemAlarmsAlarmGet(&alarms);
+    updateSeverityMask(&alarms);
     return 0;
 }
 
+/**
+ * Register a callback to be invoked whenever an alarm severity changes.
+ * The callback runs in the context of the task that changed the alarm,
+ * after the alarms lock has been released, so consumers can cache the
+ * aggregate state instead of polling it.
+ * @param cb The callback function
+ * @return 0 if success, -1 if the callback table is full
+ */
+int32_t AlarmsRegisterChangeCallback(AlarmsChangeCallback cb)
+{
+    int32_t ret = -1;
+
+    xSemaphoreTakeRecursive(lock, portMAX_DELAY);
+    for (uint32_t n = 0; n < ALARMS_MAX_CHANGE_CALLBACKS; ++n) {
+        if (!changeCallbacks[n]) {
+            changeCallbacks[n] = cb;
+            ret = 0;
+            break;
+        }
+    }
+    xSemaphoreGiveRecursive(lock);
+    return ret;
+}
+
 /**
  * Set an alarm
  * @param alarm The system alarm to be modified
@@ -69,6 +107,7 @@ int32_t AlarmsInitialize(void)
 int32_t AlarmsSet(SystemAlarmsAlarmElem alarm, SystemAlarmsAlarmOptions severity)
 {
     SystemAlarmsAlarmData alarms;
+    bool changed = false;
 
     // Check that this is a valid alarm
     if (alarm >= SYSTEMALARMS_ALARM_NUMELEM) {
@@ -87,10 +126,15 @@ int32_t AlarmsSet(SystemAlarmsAlarmElem alarm, SystemAlarmsAlarmOptions severity
         SystemAlarmsAlarmToArray(alarms)[alarm] = severity;
         lastAlarmChange[alarm] = flightTime;
         SystemAlarmsAlarmSet(&alarms);
+        updateSeverityMask(&alarms);
+        changed = true;
     }
 
     // Release lock
     xSemaphoreGiveRecursive(lock);
+    if (changed) {
+        notifyChange();
+    }
     return 0;
 }
 
@@ -108,6 +152,7 @@ int32_t ExtendedAlarmsSet(SystemAlarmsAlarmElem alarm,
                           uint8_t subStatus)
 {
     SystemAlarmsData alarms;
+    bool changed = false;
 
     // Check that this is a valid alarm
     if (alarm >= SYSTEMALARMS_EXTENDEDALARMSTATUS_NUMELEM) {
@@ -128,10 +173,15 @@ int32_t ExtendedAlarmsSet(SystemAlarmsAlarmElem alarm,
         SystemAlarmsAlarmToArray(alarms.Alarm)[alarm] = severity;
         lastAlarmChange[alarm] = flightTime;
         SystemAlarmsSet(&alarms);
+        updateSeverityMask(&alarms.Alarm);
+        changed = true;
     }
 
     // Release lock
     xSemaphoreGiveRecursive(lock);
+    if (changed) {
+        notifyChange();
+    }
     return 0;
 }
 
@@ -233,52 +283,62 @@ int32_t AlarmsHasCritical()
  */
 static int32_t hasSeverity(SystemAlarmsAlarmOptions severity)
 {
-    SystemAlarmsAlarmData alarms;
-
-    // Lock
-    xSemaphoreTakeRecursive(lock, portMAX_DELAY);
-
-    // Read alarms
-    SystemAlarmsAlarmGet(&alarms);
-
-    // Go through alarms and check if any are of the given severity or higher
-    for (uint32_t n = 0; n < SYSTEMALARMS_ALARM_NUMELEM; ++n) {
-        if (SystemAlarmsAlarmToArray(alarms)[n] >= severity) {
-            xSemaphoreGiveRecursive(lock);
+    // Check the incrementally maintained summary instead of rescanning
+    // the alarm array, no lock needed for a single word read per severity
+    for (uint32_t n = severity; n <= SYSTEMALARMS_ALARM_ERROR; ++n) {
+        if (severityMask[n]) {
             return 1;
         }
     }
-
-    // If this point is reached then no alarms found
-    xSemaphoreGiveRecursive(lock);
     return 0;
 }
+
 /**
  * Get the highest alarm severity
  * @return
  */
 SystemAlarmsAlarmOptions AlarmsGetHighestSeverity()
 {
-    SystemAlarmsAlarmData alarmsData;
-    SystemAlarmsAlarmOptions highest = SYSTEMALARMS_ALARM_UNINITIALISED;
-
-    // Lock
-    xSemaphoreTakeRecursive(lock, portMAX_DELAY);
+    // Walk the severity summary from the top down
+    for (uint32_t n = SYSTEMALARMS_ALARM_ERROR; n > SYSTEMALARMS_ALARM_UNINITIALISED; --n) {
+        if (severityMask[n]) {
+            return (SystemAlarmsAlarmOptions)n;
+        }
+    }
+    return SYSTEMALARMS_ALARM_UNINITIALISED;
+}
 
-    // Read alarms
-    SystemAlarmsAlarmGet(&alarmsData);
+/**
+ * Rebuild the per-severity bitmask from the given alarm states.
+ * Must be called with the lock held whenever the alarms are written.
+ * @param alarms The alarm states just written to SystemAlarms
+ */
+static void updateSeverityMask(SystemAlarmsAlarmData *alarms)
+{
+    uint32_t mask[SYSTEMALARMS_ALARM_ERROR + 1] = { 0 };
 
-    // Go through alarms and find the highest severity
-    uint32_t n = 0;
-    while (n < SYSTEMALARMS_ALARM_NUMELEM && highest != SYSTEMALARMS_ALARM_CRITICAL) {
-        if (SystemAlarmsAlarmToArray(alarmsData)[n] > highest) {
-            highest = SystemAlarmsAlarmToArray(alarmsData)[n];
+    for (uint32_t n = 0; n < SYSTEMALARMS_ALARM_NUMELEM; ++n) {
+        SystemAlarmsAlarmOptions severity = SystemAlarmsAlarmToArray(*alarms)[n];
+        if (severity <= SYSTEMALARMS_ALARM_ERROR) {
+            mask[severity] |= 1 << n;
         }
-        n++;
     }
+    for (uint32_t n = 0; n <= SYSTEMALARMS_ALARM_ERROR; ++n) {
+        severityMask[n] = mask[n];
+    }
+}
 
-    xSemaphoreGiveRecursive(lock);
-    return highest;
+/**
+ * Invoke the registered change notification callbacks.
+ * Must be called without the lock held so callbacks can query alarms.
+ */
+static void notifyChange(void)
+{
+    for (uint32_t n = 0; n < ALARMS_MAX_CHANGE_CALLBACKS; ++n) {
+        if (changeCallbacks[n]) {
+            changeCallbacks[n]();
+        }
+    }
 }
 
 /**
@@ -128,6 +128,30 @@ int16_t fifoBuf_getByte(t_fifo_buffer *buf)
     return b; // return the byte
 }
 
+uint16_t fifoBuf_getContiguousPeek(t_fifo_buffer *buf, uint8_t **data)
+{ // expose the contiguous readable region at the read position without copying.
+  // the caller scans in place and releases the bytes with fifoBuf_removeData()
+    uint16_t rd        = buf->rd;
+    uint16_t buf_size  = buf->buf_size;
+
+    // get number of bytes available
+    uint16_t num_bytes = fifoBuf_getUsed(buf);
+
+    if (num_bytes < 1) {
+        return 0; // nothing readable
+    }
+
+    // clip to the end of the underlying buffer, a wrapped region needs two calls
+    uint16_t block_len = buf_size - rd;
+    if (block_len > num_bytes) {
+        block_len = num_bytes;
+    }
+
+    *data = buf->buf_ptr + rd;
+
+    return block_len; // return number of contiguous bytes readable at *data
+}
+
 uint16_t fifoBuf_getDataPeek(t_fifo_buffer *buf, void *data, uint16_t len)
 { // get data from the buffer without removing it
     uint16_t rd        = buf->rd;
@@ -232,6 +256,56 @@ uint16_t fifoBuf_putByte(t_fifo_buffer *buf, const uint8_t b)
     return 1; // return number of bytes copied
 }
 
+uint16_t fifoBuf_putContiguousReserve(t_fifo_buffer *buf, uint8_t **data)
+{ // expose the contiguous writable region at the write position without copying.
+  // a producer (e.g. a DMA channel) fills the bytes in place and publishes them
+  // with fifoBuf_putContiguousCommit(). the write position only moves on commit,
+  // so a reader never sees partially filled bytes
+    uint16_t wr        = buf->wr;
+    uint16_t buf_size  = buf->buf_size;
+
+    // get the free space size
+    uint16_t num_bytes = fifoBuf_getFree(buf);
+
+    if (num_bytes < 1) {
+        return 0; // nothing writable
+    }
+
+    // clip to the end of the underlying buffer, a wrapped region needs two calls
+    uint16_t block_len = buf_size - wr;
+    if (block_len > num_bytes) {
+        block_len = num_bytes;
+    }
+
+    *data = buf->buf_ptr + wr;
+
+    return block_len; // return number of contiguous bytes writable at *data
+}
+
+void fifoBuf_putContiguousCommit(t_fifo_buffer *buf, uint16_t len)
+{ // publish bytes filled in after fifoBuf_putContiguousReserve().
+  // len must not exceed what the reserve call returned
+    uint16_t wr        = buf->wr;
+    uint16_t buf_size  = buf->buf_size;
+
+    // get the free space size
+    uint16_t num_bytes = fifoBuf_getFree(buf);
+
+    if (num_bytes > len) {
+        num_bytes = len;
+    }
+
+    if (num_bytes < 1) {
+        return; // nothing to commit
+    }
+    wr += num_bytes;
+    if (wr >= buf_size) {
+        wr -= buf_size;
+    }
+
+    buf->wr = wr;
+}
+
 uint16_t fifoBuf_putData(t_fifo_buffer *buf, const void *data, uint16_t len)
 { // add data to the buffer
     uint16_t wr        = buf->wr;
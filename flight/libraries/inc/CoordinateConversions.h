@@ -30,6 +30,9 @@
 #ifndef COORDINATECONVERSIONS_H_
 #define COORDINATECONVERSIONS_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
 // ****** convert Lat,Lon,Alt to ECEF  ************
 void LLA2ECEF(int32_t LLAi[3], double ECEF[3]);
 
@@ -44,6 +47,9 @@ void Rv2Rot(float Rv[3], float R[3][3]);
 // ****** find roll, pitch, yaw from quaternion ********
 void Quaternion2RPY(const float q[4], float rpy[3]);
 
+// ****** find roll, pitch, yaw from quaternion using table based trig ********
+void Quaternion2RPYFast(const float q[4], float rpy[3]);
+
 // ****** find quaternion from roll, pitch, yaw ********
 void RPY2Quaternion(const float rpy[3], float q[4]);
 
@@ -68,6 +74,19 @@ void Quaternion2zB(const float q[4], float z[3]);
 // ****** Express LLA in a local NED Base Frame ********
 void LLA2Base(int32_t LLAi[3], double BaseECEF[3], float Rne[3][3], float NED[3]);
 
+// ****** Cached linearization of LLA to NED around a base location ********
+// valid within LLA2BASE_LINEAR_RANGE (1e-7 deg) of the base; precomputes the
+// local radii of curvature so the per fix conversion is three multiplies
+#define LLA2BASE_LINEAR_RANGE 500000 // 0.05 deg, about 5.5 km
+typedef struct {
+    int32_t BaseLLAi[3];
+    float   mPerLati; // meters north per 1e-7 deg latitude
+    float   mPerLoni; // meters east per 1e-7 deg longitude
+} LLA2BaseLinearization;
+
+void LLA2BaseLinearizedInit(LLA2BaseLinearization *lin, int32_t BaseLLAi[3]);
+bool LLA2BaseLinearized(const LLA2BaseLinearization *lin, int32_t LLAi[3], float NED[3]);
+
 // ****** Express ECEF in a local NED Base Frame ********
 void ECEF2Base(double ECEF[3], double BaseECEF[3], float Rne[3][3], float NED[3]);
 
@@ -5,6 +5,12 @@
 #define N_COL   4
 #define N_BLOCK (N_ROW * N_COL)
 
+/*
+ * Implemented by the T-table software backend in aes.c, or by a hardware
+ * backend (e.g. the STM32F4 CRYP peripheral on targets that have it) when
+ * PIOS_INCLUDE_AES_HW is defined.
+ */
+
 void aes_encrypt_cbc_128(void *data, void *key, void *chain_block);
 void aes_decrypt_cbc_128(void *data, void *key, void *chain_block);
 void aes_decrypt_key_128_create(void *enc_key, void *dec_key);
@@ -31,7 +31,11 @@
 #include <systemalarms.h>
 #define SYSTEMALARMS_ALARM_DEFAULT SYSTEMALARMS_ALARM_UNINITIALISED
 
+// Invoked after an alarm severity has changed, with the alarms lock released
+typedef void (*AlarmsChangeCallback)(void);
+
 int32_t AlarmsInitialize(void);
+int32_t AlarmsRegisterChangeCallback(AlarmsChangeCallback cb);
 int32_t AlarmsSet(SystemAlarmsAlarmElem alarm, SystemAlarmsAlarmOptions severity);
 int32_t ExtendedAlarmsSet(SystemAlarmsAlarmElem alarm,
                           SystemAlarmsAlarmOptions severity,
@@ -50,11 +50,15 @@ void fifoBuf_removeData(t_fifo_buffer *buf, uint16_t len);
 int16_t fifoBuf_getBytePeek(t_fifo_buffer *buf);
 int16_t fifoBuf_getByte(t_fifo_buffer *buf);
 
+uint16_t fifoBuf_getContiguousPeek(t_fifo_buffer *buf, uint8_t **data);
 uint16_t fifoBuf_getDataPeek(t_fifo_buffer *buf, void *data, uint16_t len);
 uint16_t fifoBuf_getData(t_fifo_buffer *buf, void *data, uint16_t len);
 
 uint16_t fifoBuf_putByte(t_fifo_buffer *buf, const uint8_t b);
 
+uint16_t fifoBuf_putContiguousReserve(t_fifo_buffer *buf, uint8_t **data);
+void fifoBuf_putContiguousCommit(t_fifo_buffer *buf, uint16_t len);
+
 uint16_t fifoBuf_putData(t_fifo_buffer *buf, const void *data, uint16_t len);
 
 void fifoBuf_init(t_fifo_buffer *buf, const void *buffer, const uint16_t buffer_size);
@@ -58,14 +58,17 @@ void INSStatePrediction(float gyro_data[3], float accel_data[3], float dT);
 void INSCovariancePrediction(float dT);
 void INSCorrection(float mag_data[3], float Pos[3], float Vel[3], float BaroAlt, uint16_t SensorsUsed);
 
-void INSResetP(float PDiag[13]);
-void INSGetP(float PDiag[13]);
+// PDiag length is ins_get_num_states(), i.e. 13 or 16 depending on
+// which INS implementation the firmware was linked against
+void INSResetP(float PDiag[]);
+void INSGetP(float PDiag[]);
 void INSSetState(float pos[3], float vel[3], float q[4], float gyro_bias[3], float accel_bias[3]);
 void INSSetPosVelVar(float PosVar[3], float VelVar[3]);
 void INSSetGyroBias(float gyro_bias[3]);
 void INSSetAccelVar(float accel_var[3]);
 void INSSetGyroVar(float gyro_var[3]);
 void INSSetGyroBiasVar(float gyro_bias_var[3]);
+void INSSetAccelBiasVar(float accel_bias_var[3]);
 void INSSetMagNorth(float B[3]);
 void INSSetMagVar(float scaled_mag_var[3]);
 void INSSetBaroVar(float baro_var);
@@ -76,7 +79,7 @@ void MagVelBaroCorrection(float mag_data[3], float Vel[3], float BaroAlt);
 void FullCorrection(float mag_data[3], float Pos[3], float Vel[3],
                     float BaroAlt);
 void GpsBaroCorrection(float Pos[3], float Vel[3], float BaroAlt);
-void GpsMagCorrection(float mag_data[3], float Pos[3], float Vel[2]);
+void GpsMagCorrection(float mag_data[3], float Pos[3], float Vel[3]);
 void VelBaroCorrection(float Vel[3], float BaroAlt);
 
 uint16_t ins_get_num_states();
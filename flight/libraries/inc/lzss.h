@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ *
+ * @file       lzss.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @brief      Lightweight block LZSS compression.
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef LZSS_H
+#define LZSS_H
+
+#include <stdint.h>
+
+// minimum match worth encoding, a back reference costs two bytes plus a flag bit
+#define LZSS_MATCH_MIN 3
+// maximum back reference distance, bounded by the one byte offset encoding
+#define LZSS_WINDOW    256
+
+/**
+ * Compress a block of data.  Each block is self contained (the dictionary is
+ * the block itself), so a lost block never desynchronizes the decompressor.
+ * @param[in]  in      data to compress
+ * @param[in]  in_len  number of input bytes
+ * @param[out] out     output buffer for the compressed stream
+ * @param[in]  out_max size of the output buffer
+ * @return compressed length, or 0 if the output did not fit in out_max
+ *         (the caller should send the block uncompressed instead)
+ */
+uint16_t lzss_compress(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_max);
+
+/**
+ * Decompress a block produced by lzss_compress().
+ * @param[in]  in      compressed stream
+ * @param[in]  in_len  compressed length
+ * @param[out] out     output buffer for the decompressed data
+ * @param[in]  out_max size of the output buffer
+ * @return decompressed length, or 0 if the stream is malformed or does not fit
+ */
+uint16_t lzss_decompress(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_max);
+
+#endif /* LZSS_H */
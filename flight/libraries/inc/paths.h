@@ -34,6 +34,27 @@ struct path_status {
     float correction_vector[3];
 };
 
-void path_progress(PathDesiredData *path, float *cur_point, struct path_status *status);
+/**
+ * A path segment compiled by path_compile(). All terms that only depend on
+ * the segment itself (unit vectors, lengths, arc parameters) are
+ * precalculated once per PathDesired update, so that path_progress() does
+ * not have to redo them on every PathFollower iteration.
+ */
+struct path_compiled {
+    uint8_t mode; // PATHDESIRED_MODE_xxx the segment was compiled from
+    bool    mode3D; // true if Down is part of the progress calculation
+    float   start[3]; // copy of PathDesired Start (North, East, Down)
+    float   end[3]; // copy of PathDesired End (North, East, Down)
+    float   starting_velocity;
+    float   ending_velocity;
+    /* per segment constants */
+    float   path_vector[3]; // end - start, Down forced to zero in 2D modes
+    float   path_length; // length of path_vector
+    float   inv_path_length; // 1 / path_length, zero if the segment is degenerate
+    float   arc_start_angle; // circle modes: angle of the radius vector, 0..2pi
+};
+
+void path_compile(PathDesiredData *path, struct path_compiled *cpath);
+void path_progress(struct path_compiled *cpath, float *cur_point, struct path_status *status);
 
 #endif
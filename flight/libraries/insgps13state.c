@@ -33,6 +33,19 @@
 #include <math.h>
 #include <stdint.h>
 #include <pios_math.h>
+#ifdef PIOS_INSGPS_USE_CMSIS_DSP
+#include <arm_math.h>
+#endif
+
+// Keep the filter working set in CCM on targets that have it; the EKF
+// matrices are CPU-only, so they belong in the zero-wait-state bank.
+// Local macro instead of <pios_mem.h> because this file also builds in
+// host-side test harnesses without the PiOS headers.
+#ifdef PIOS_TARGET_PROVIDES_FAST_HEAP
+#define EKF_HOT_SECTION __attribute__((section(".fast")))
+#else
+#define EKF_HOT_SECTION
+#endif
 
 // constants/macros/typdefs
 #define NUMX 13 // number of states, X is the state vector
@@ -75,8 +88,24 @@ void LinearizeH(float X[NUMX], float Be[3], float H[NUMV][NUMX]);
 // b.............  .......X.
 // c.............  ........X
 
-static const int8_t FrowMin[NUMX] = { 3, 4, 5, 6, 6, 6, 7, 6, 6, 6, 13, 13, 13 };
-static const int8_t FrowMax[NUMX] = { 3, 4, 5, 9, 9, 9, 12, 12, 12, 12, -1, -1, -1 };
+// exact nonzero column indices of each F row, -1 terminated; tighter
+// than a min..max range, which would include the interior zeros on the
+// diagonal of the quaternion block (rows 7..9)
+static const int8_t FrowIdx[NUMX][7] = {
+    { 3, -1, -1, -1, -1, -1, -1 },
+    { 4, -1, -1, -1, -1, -1, -1 },
+    { 5, -1, -1, -1, -1, -1, -1 },
+    { 6, 7, 8, 9, -1, -1, -1 },
+    { 6, 7, 8, 9, -1, -1, -1 },
+    { 6, 7, 8, 9, -1, -1, -1 },
+    { 7, 8, 9, 10, 11, 12, -1 },
+    { 6, 8, 9, 10, 11, 12, -1 },
+    { 6, 7, 9, 10, 11, 12, -1 },
+    { 6, 7, 8, 10, 11, 12, -1 },
+    { -1, -1, -1, -1, -1, -1, -1 },
+    { -1, -1, -1, -1, -1, -1, -1 },
+    { -1, -1, -1, -1, -1, -1, -1 }
+};
 
 static const int8_t GrowMin[NUMX] = { 9, 9, 9, 3, 3, 3, 0, 0, 0, 0, 6, 7, 8 };
 static const int8_t GrowMax[NUMX] = { -1, -1, -1, 5, 5, 5, 2, 2, 2, 2, 6, 7, 8 };
@@ -97,7 +126,7 @@ static struct EKFData {
     // input noise and measurement noise variances
     float Q[NUMW];
     float R[NUMV];
-} ekf;
+} ekf EKF_HOT_SECTION;
 
 // Global variables
 struct NavStruct Nav;
@@ -162,7 +191,7 @@ void INSGPSInit() // pretty much just a place holder for now
     ekf.R[9]  = .25f;                    // High freq altimeter noise variance (m^2)
 }
 
-void INSResetP(float PDiag[NUMX])
+void INSResetP(float PDiag[])
 {
     uint8_t i, j;
 
@@ -177,7 +206,7 @@ void INSResetP(float PDiag[NUMX])
     }
 }
 
-void INSGetP(float PDiag[NUMX])
+void INSGetP(float PDiag[])
 {
     uint8_t i;
 
@@ -265,6 +294,11 @@ void INSSetGyroBiasVar(float gyro_bias_var[3])
     ekf.Q[8] = gyro_bias_var[2];
 }
 
+void INSSetAccelBiasVar(__attribute__((unused)) float accel_bias_var[3])
+{
+    /* Note: accel bias not used in 13 state INS */
+}
+
 void INSSetMagVar(float scaled_mag_var[3])
 {
     ekf.R[6] = scaled_mag_var[0];
@@ -434,6 +468,68 @@ void INSCorrection(float mag_data[3], float Pos[3], float Vel[3],
 // The first Method is very specific to this implementation
 // ************************************************
 
+#ifdef PIOS_INSGPS_USE_CMSIS_DSP
+
+// Scratch areas for the CMSIS-DSP backend.  The EKF is only ever run
+// from a single task, so these can be static rather than on the stack.
+static float dsp_a[NUMX * NUMX] EKF_HOT_SECTION; // A  = I + F*dT
+static float dsp_at[NUMX * NUMX] EKF_HOT_SECTION; // A'
+static float dsp_tmp[NUMX * NUMX] EKF_HOT_SECTION; // intermediate products
+static float dsp_gq[NUMX * NUMW] EKF_HOT_SECTION; // G * diag(Q) * dT^2
+static float dsp_gt[NUMW * NUMX] EKF_HOT_SECTION; // G'
+
+__attribute__((optimize("O3")))
+void CovariancePrediction(float F[NUMX][NUMX], float G[NUMX][NUMW],
+                          float Q[NUMW], float dT, float P[NUMX][NUMX])
+{
+    // Pnew = (I+F*dT)*P*(I+F*dT)' + (dT^2)*G*Q*G'
+    // computed with the CMSIS-DSP matrix kernels which keep the M4F FPU
+    // pipeline busy instead of the scalar triple loops
+    float dTsq = dT * dT;
+    int8_t i;
+    int8_t j;
+
+    arm_matrix_instance_f32 A   = { NUMX, NUMX, dsp_a };
+    arm_matrix_instance_f32 At  = { NUMX, NUMX, dsp_at };
+    arm_matrix_instance_f32 Tmp = { NUMX, NUMX, dsp_tmp };
+    arm_matrix_instance_f32 GQ  = { NUMX, NUMW, dsp_gq };
+    arm_matrix_instance_f32 Gt  = { NUMW, NUMX, dsp_gt };
+    arm_matrix_instance_f32 Gm  = { NUMX, NUMW, &G[0][0] };
+    arm_matrix_instance_f32 Pm  = { NUMX, NUMX, &P[0][0] };
+
+    // A = I + F*dT
+    for (i = 0; i < NUMX; i++) {
+        for (j = 0; j < NUMX; j++) {
+            dsp_a[i * NUMX + j] = F[i][j] * dT;
+        }
+        dsp_a[i * NUMX + i] += 1.0f;
+    }
+
+    // Tmp = A*P ; P = Tmp*A'
+    arm_mat_mult_f32(&A, &Pm, &Tmp);
+    arm_mat_trans_f32(&A, &At);
+    arm_mat_mult_f32(&Tmp, &At, &Pm);
+
+    // Tmp = (G*diag(Q)*dT^2)*G' ; P += Tmp
+    for (i = 0; i < NUMX; i++) {
+        for (j = 0; j < NUMW; j++) {
+            dsp_gq[i * NUMW + j] = G[i][j] * Q[j] * dTsq;
+        }
+    }
+    arm_mat_trans_f32(&Gm, &Gt);
+    arm_mat_mult_f32(&GQ, &Gt, &Tmp);
+    arm_mat_add_f32(&Pm, &Tmp, &Pm);
+
+    // restore exact symmetry lost to floating point rounding
+    for (i = 0; i < NUMX; i++) {
+        for (j = i + 1; j < NUMX; j++) {
+            P[j][i] = P[i][j];
+        }
+    }
+}
+
+#else /* ifdef PIOS_INSGPS_USE_CMSIS_DSP */
+
 __attribute__((optimize("O3")))
 void CovariancePrediction(float F[NUMX][NUMX], float G[NUMX][NUMW],
                           float Q[NUMW], float dT, float P[NUMX][NUMX])
@@ -447,17 +543,16 @@ void CovariancePrediction(float F[NUMX][NUMX], float G[NUMX][NUMW],
     int8_t i;
 
     for (i = 0; i < NUMX; i++) { // Calculate Dummy = (P/T +F*P)
-        float *Firow   = F[i];
-        float *Pirow   = P[i];
-        float *Dirow   = Dummy[i];
-        int8_t Fistart = FrowMin[i];
-        int8_t Fiend   = FrowMax[i];
+        float *Firow = F[i];
+        float *Pirow = P[i];
+        float *Dirow = Dummy[i];
+        const int8_t *Fidx = FrowIdx[i];
         int8_t j;
         for (j = 0; j < NUMX; j++) {
             Dirow[j] = Pirow[j] * dT1; // Dummy = P / T ...
-            int8_t k;
-            for (k = Fistart; k <= Fiend; k++) {
-                Dirow[j] += Firow[k] * P[k][j]; // [] + F * P
+            const int8_t *k;
+            for (k = Fidx; *k >= 0; k++) {
+                Dirow[j] += Firow[*k] * P[*k][j]; // [] + F * P
             }
         }
     }
@@ -472,12 +567,10 @@ void CovariancePrediction(float F[NUMX][NUMX], float G[NUMX][NUMW],
             float Ptmp = Dirow[j] * dT1; // Pnew = Dummy / T ...
 
             {
-                float *Fjrow   = F[j];
-                int8_t Fjstart = FrowMin[j];
-                int8_t Fjend   = FrowMax[j];
-                int8_t k;
-                for (k = Fjstart; k <= Fjend; k++) {
-                    Ptmp += Dirow[k] * Fjrow[k]; // [] + Dummy*F' ...
+                float *Fjrow = F[j];
+                const int8_t *k;
+                for (k = FrowIdx[j]; *k >= 0; k++) {
+                    Ptmp += Dirow[*k] * Fjrow[*k]; // [] + Dummy*F' ...
                 }
             }
 
@@ -496,6 +589,8 @@ void CovariancePrediction(float F[NUMX][NUMX], float G[NUMX][NUMW],
     }
 }
 
+#endif /* ifdef PIOS_INSGPS_USE_CMSIS_DSP */
+
 // *************  SerialUpdate *******************
 // Does the update step of the Kalman filter for the covariance and estimate
 // Outputs are Xnew & Pnew, and are written over P and X
@@ -536,12 +631,25 @@ void SerialUpdate(float H[NUMV][NUMX], float R[NUMV], float Z[NUMV],
             for (k = 0; k < NUMX; k++) {
                 Km[k] = HP[k] / HPHR; // find K = HP/HPHR
             }
+#ifdef PIOS_INSGPS_USE_CMSIS_DSP
+            {
+                // Find P(m)= P(m-1) - K*HP as a rank-1 DSP kernel update;
+                // K*HP is symmetric since K = HP/HPHR
+                arm_matrix_instance_f32 Kv  = { NUMX, 1, Km };
+                arm_matrix_instance_f32 HPv = { 1, NUMX, HP };
+                arm_matrix_instance_f32 Tmp = { NUMX, NUMX, dsp_tmp };
+                arm_matrix_instance_f32 Pm  = { NUMX, NUMX, &P[0][0] };
+                arm_mat_mult_f32(&Kv, &HPv, &Tmp);
+                arm_mat_sub_f32(&Pm, &Tmp, &Pm);
+            }
+#else
             for (i = 0; i < NUMX; i++) { // Find P(m)= P(m-1) + K*HP
                 for (j = i; j < NUMX; j++) {
                     P[i][j] = P[j][i] =
                                   P[i][j] - Km[i] * HP[j];
                 }
             }
+#endif /* ifdef PIOS_INSGPS_USE_CMSIS_DSP */
 
             Error = Z[m] - Y[m];
             for (i = 0; i < NUMX; i++) { // Find X(m)= X(m-1) + K*Error
@@ -58,6 +58,8 @@ typedef struct {
     uint8_t  next_sequence_rep; // next sequence repetition counter (valid if sequence.repeats > 1)
     uint8_t  led_set_start; // first target led for this set
     uint8_t  led_set_end; // last target led for this set
+    Color_t  current_color; // color currently composed into the framebuffer
+    bool     color_valid; // current_color has been pushed at least once
 } NotifierLedStatus_t;
 
 static bool led_status_initialized = false;
@@ -217,14 +219,15 @@ static void advance_sequence(NotifierLedStatus_t *status)
 }
 
 /**
- * run a led set
+ * run a led set.  Returns true when the framebuffer content for this
+ * set changed and an update cycle needs to be started.
  */
-static void run_led(NotifierLedStatus_t *status)
+static bool run_led(NotifierLedStatus_t *status)
 {
     const uint32_t currentTime = GET_CURRENT_MILLIS;
 
     if (!status->running || currentTime < status->next_run_time) {
-        return;
+        return false;
     }
     status->next_run_time = currentTime;
     uint8_t step = status->next_sequence_step;
@@ -232,11 +235,22 @@ static void run_led(NotifierLedStatus_t *status)
     LedSequence_t *activeSequence = &status->queued_sequences[status->active_sequence_num];
     const Color_t color = status->step_phase_on ? activeSequence->steps[step].color : Color_Off;
 
-    for (uint8_t i = status->led_set_start; i <= status->led_set_end; i++) {
-        PIOS_WS2811_setColorRGB(color, i, false);
+    // compose the strip only when the visible color actually changes;
+    // repeated steps and solid background sequences otherwise re-push
+    // an identical framebuffer every tick
+    bool dirty = !status->color_valid
+                 || color.R != status->current_color.R
+                 || color.G != status->current_color.G
+                 || color.B != status->current_color.B;
+    if (dirty) {
+        for (uint8_t i = status->led_set_start; i <= status->led_set_end; i++) {
+            PIOS_WS2811_setColorRGB(color, i, false);
+        }
+        status->current_color = color;
+        status->color_valid   = true;
     }
-    PIOS_WS2811_Update();
     advance_sequence(status);
+    return dirty;
 }
 
 void LedNotificationExtLedsRun()
@@ -252,8 +266,13 @@ void LedNotificationExtLedsRun()
         push_queued_sequence(newNotification, &led_status[0]);
     }
 
-    // Run Leds
+    // Run Leds; kick a single DMA transfer once every dirty set has
+    // been composed into the framebuffer
+    bool update = false;
     for (uint8_t i = 0; i < MAX_HANDLED_LED; i++) {
-        run_led(&led_status[i]);
+        update |= run_led(&led_status[i]);
+    }
+    if (update) {
+        PIOS_WS2811_Update();
     }
 }
@@ -0,0 +1,135 @@
+/**
+ ******************************************************************************
+ *
+ * @file       lzss.c
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @brief      Lightweight block LZSS compression.
+ *
+ * The encoded stream is a sequence of groups, each introduced by a flag
+ * byte.  Flag bits are consumed LSB first: a set bit is followed by one
+ * literal byte, a clear bit by a two byte back reference holding the
+ * distance minus one and the match length minus LZSS_MATCH_MIN.  Blocks
+ * are self contained so the codec needs no state between blocks, which
+ * keeps a lossy link from desynchronizing the receiving end.
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "lzss.h"
+
+// longest match the one byte length encoding can express
+#define LZSS_MATCH_MAX (LZSS_MATCH_MIN + 255)
+
+uint16_t lzss_compress(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_max)
+{
+    uint16_t in_pos   = 0;
+    uint16_t out_pos  = 0;
+    uint16_t flag_pos = 0;
+    uint8_t flag_bit  = 0;
+
+    while (in_pos < in_len) {
+        if (flag_bit == 0) {
+            // start a new group
+            if (out_pos >= out_max) {
+                return 0;
+            }
+            flag_pos = out_pos++;
+            out[flag_pos] = 0;
+        }
+
+        // look for the longest match in the window preceding in_pos
+        uint16_t best_len  = 0;
+        uint16_t best_dist = 0;
+        uint16_t max_dist  = (in_pos < LZSS_WINDOW) ? in_pos : LZSS_WINDOW;
+        uint16_t max_len   = in_len - in_pos;
+        if (max_len > LZSS_MATCH_MAX) {
+            max_len = LZSS_MATCH_MAX;
+        }
+        for (uint16_t dist = 1; dist <= max_dist; dist++) {
+            const uint8_t *ref = &in[in_pos - dist];
+            uint16_t len = 0;
+            // matches may overlap the current position, references repeat
+            while (len < max_len && ref[len] == in[in_pos + len]) {
+                len++;
+            }
+            if (len > best_len) {
+                best_len  = len;
+                best_dist = dist;
+                if (len == max_len) {
+                    break;
+                }
+            }
+        }
+
+        if (best_len >= LZSS_MATCH_MIN) {
+            if (out_pos + 2 > out_max) {
+                return 0;
+            }
+            out[out_pos++] = (uint8_t)(best_dist - 1);
+            out[out_pos++] = (uint8_t)(best_len - LZSS_MATCH_MIN);
+            in_pos += best_len;
+        } else {
+            if (out_pos >= out_max) {
+                return 0;
+            }
+            out[flag_pos] |= (uint8_t)(1 << flag_bit);
+            out[out_pos++] = in[in_pos++];
+        }
+        flag_bit = (flag_bit + 1) & 7;
+    }
+
+    return out_pos;
+}
+
+uint16_t lzss_decompress(const uint8_t *in, uint16_t in_len, uint8_t *out, uint16_t out_max)
+{
+    uint16_t in_pos  = 0;
+    uint16_t out_pos = 0;
+
+    while (in_pos < in_len) {
+        uint8_t flags = in[in_pos++];
+        for (uint8_t bit = 0; bit < 8 && in_pos < in_len; bit++) {
+            if (flags & (1 << bit)) {
+                // literal
+                if (out_pos >= out_max) {
+                    return 0;
+                }
+                out[out_pos++] = in[in_pos++];
+            } else {
+                // back reference
+                if (in_pos + 2 > in_len) {
+                    return 0;
+                }
+                uint16_t dist = (uint16_t)in[in_pos] + 1;
+                uint16_t len  = (uint16_t)in[in_pos + 1] + LZSS_MATCH_MIN;
+                in_pos += 2;
+                if (dist > out_pos || out_pos + len > out_max) {
+                    return 0;
+                }
+                // copy byte by byte, the match may overlap its own output
+                for (uint16_t i = 0; i < len; i++) {
+                    out[out_pos] = out[out_pos - dist];
+                    out_pos++;
+                }
+            }
+        }
+    }
+
+    return out_pos;
+}
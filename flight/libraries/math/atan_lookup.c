@@ -0,0 +1,120 @@
+/**
+ ******************************************************************************
+ * @addtogroup OpenPilot Math Utilities
+ * @{
+ * @addtogroup Fast inverse trigonometry methods based on a lookup table
+ * @{
+ *
+ * @file       atan_lookup.c
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @brief      Table based atan2/asin approximations for hot paths
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "math.h"
+#include <pios_math.h>
+#include <mathmisc.h>
+
+#include "atan_lookup.h"
+
+#define ATAN_LOOKUP_SIZE 64
+
+// Precomputed atan(i / 64) for i = 0..64.  With linear interpolation the
+// worst case error over [0,1] is about 2e-5 rad, far below sensor noise.
+static const float atan_table[ATAN_LOOKUP_SIZE + 1] = {
+    0.000000f, 0.015624f, 0.031240f, 0.046841f, 0.062419f, 0.077967f, 0.093477f, 0.108942f,
+    0.124355f, 0.139709f, 0.154997f, 0.170212f, 0.185348f, 0.200399f, 0.215358f, 0.230220f,
+    0.244979f, 0.259630f, 0.274167f, 0.288587f, 0.302885f, 0.317056f, 0.331096f, 0.345002f,
+    0.358771f, 0.372398f, 0.385883f, 0.399221f, 0.412410f, 0.425450f, 0.438337f, 0.451070f,
+    0.463648f, 0.476069f, 0.488334f, 0.500441f, 0.512389f, 0.524180f, 0.535811f, 0.547284f,
+    0.558599f, 0.569756f, 0.580756f, 0.591600f, 0.602287f, 0.612820f, 0.623199f, 0.633426f,
+    0.643501f, 0.653426f, 0.663203f, 0.672833f, 0.682317f, 0.691657f, 0.700854f, 0.709912f,
+    0.718830f, 0.727611f, 0.736257f, 0.744770f, 0.753151f, 0.761403f, 0.769526f, 0.777524f,
+    0.785398f
+};
+
+/**
+ * Interpolate atan(z) from the table for z in [0,1]
+ */
+static inline float atan_interpolate(float z)
+{
+    float idx = z * (float)ATAN_LOOKUP_SIZE;
+    int i     = (int)idx;
+
+    if (i >= ATAN_LOOKUP_SIZE) {
+        return atan_table[ATAN_LOOKUP_SIZE];
+    }
+    return atan_table[i] + (atan_table[i + 1] - atan_table[i]) * (idx - (float)i);
+}
+
+/**
+ * Fast table based replacement for atan2f
+ * @param[in] y Numerator
+ * @param[in] x Denominator
+ * @returns Angle in radians in (-pi, pi], same convention as atan2f
+ *
+ * One division, one table interpolation and a couple of sign fixups per
+ * call; no libm.  Worst case error is about 2e-5 rad.
+ */
+float fast_atan2f(float y, float x)
+{
+    if (y == 0.0f && x == 0.0f) {
+        return 0.0f;
+    }
+
+    float ay = fabsf(y);
+    float ax = fabsf(x);
+    float angle;
+
+    // reduce to the first octant, atan(z) with z in [0,1]
+    if (ax >= ay) {
+        angle = atan_interpolate(ay / ax);
+    } else {
+        angle = M_PI_2_F - atan_interpolate(ax / ay);
+    }
+
+    if (x < 0.0f) {
+        angle = M_PI_F - angle;
+    }
+    return (y < 0.0f) ? -angle : angle;
+}
+
+/**
+ * Fast replacement for asinf built on fast_atan2f
+ * @param[in] x Sine value, clamped to [-1, 1]
+ * @returns Angle in radians in [-pi/2, pi/2]
+ *
+ * Computed as atan2(x, sqrt(1 - x^2)) so the interpolation error stays
+ * bounded near +-1 where asin itself has infinite slope; the square root
+ * comes from fast_invsqrtf which dominates the error at roughly 1e-3 rad
+ * worst case near the ends of the range.
+ */
+float fast_asinf(float x)
+{
+    if (x >= 1.0f) {
+        return M_PI_2_F;
+    }
+    if (x <= -1.0f) {
+        return -M_PI_2_F;
+    }
+
+    float s = 1.0f - x * x;
+    return fast_atan2f(x, s * fast_invsqrtf(s));
+}
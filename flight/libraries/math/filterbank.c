@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @addtogroup OpenPilot Math Utilities
+ * @{
+ * @addtogroup Cascaded biquad filter bank
+ * @{
+ *
+ * @file       filterbank.c
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @brief      Cascade of direct form 1 biquads for gyro conditioning
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "openpilot.h"
+#include "math.h"
+#include "filterbank.h"
+
+// finalize stage coefficients shared by the lowpass and notch designs:
+// normalize by a0 and negate the feedback terms for the DF1 convention
+static void pushStage(struct FilterBank *bank, const float b0, const float b1, const float b2,
+                      const float a0, const float a1, const float a2)
+{
+    if (bank->numStages >= FILTERBANK_MAX_STAGES) {
+        return;
+    }
+    float *c = &bank->coeffs[5 * bank->numStages];
+    c[0] = b0 / a0;
+    c[1] = b1 / a0;
+    c[2] = b2 / a0;
+    c[3] = -a1 / a0;
+    c[4] = -a2 / a0;
+    bank->numStages++;
+
+    memset(bank->state, 0, sizeof(bank->state));
+#ifdef PIOS_STABILIZATION_USE_CMSIS_DSP
+    for (int axis = 0; axis < FILTERBANK_AXES; axis++) {
+        arm_biquad_cascade_df1_init_f32(&bank->instance[axis], bank->numStages,
+                                        bank->coeffs, bank->state[axis]);
+    }
+#endif
+}
+
+/**
+ * Empty the bank; FilterBankApply() is then a pass-through until
+ * stages are added
+ */
+void FilterBankInit(struct FilterBank *bank)
+{
+    memset(bank, 0, sizeof(*bank));
+}
+
+/**
+ * Append a second order Butterworth lowpass stage
+ * \param[in] cutoff corner frequency (Hz)
+ * \param[in] dT sampling period (s)
+ */
+void FilterBankAddLowPass(struct FilterBank *bank, const float cutoff, const float dT)
+{
+    const float o  = 2.0f * M_PI_F * cutoff * dT;
+    const float sn = sinf(o);
+    const float cs = cosf(o);
+    const float alpha = sn / M_SQRT2_F;
+
+    pushStage(bank,
+              (1.0f - cs) * 0.5f, 1.0f - cs, (1.0f - cs) * 0.5f,
+              1.0f + alpha, -2.0f * cs, 1.0f - alpha);
+}
+
+/**
+ * Append a notch stage
+ * \param[in] center notch frequency (Hz)
+ * \param[in] q quality factor, center / bandwidth
+ * \param[in] dT sampling period (s)
+ */
+void FilterBankAddNotch(struct FilterBank *bank, const float center, const float q, const float dT)
+{
+    const float o  = 2.0f * M_PI_F * center * dT;
+    const float sn = sinf(o);
+    const float cs = cosf(o);
+    const float alpha = sn / (2.0f * q);
+
+    pushStage(bank,
+              1.0f, -2.0f * cs, 1.0f,
+              1.0f + alpha, -2.0f * cs, 1.0f - alpha);
+}
+
+/**
+ * Run one sample of all three axes through the cascade, in place
+ * \param[in,out] axes pointer to FILTERBANK_AXES samples
+ */
+void FilterBankApply(struct FilterBank *bank, float *axes)
+{
+    if (!bank->numStages) {
+        return;
+    }
+    for (int axis = 0; axis < FILTERBANK_AXES; axis++) {
+#ifdef PIOS_STABILIZATION_USE_CMSIS_DSP
+        arm_biquad_cascade_df1_f32(&bank->instance[axis], &axes[axis], &axes[axis], 1);
+#else
+        float x = axes[axis];
+        for (int s = 0; s < bank->numStages; s++) {
+            const float *c = &bank->coeffs[5 * s];
+            float *w = &bank->state[axis][4 * s];
+            // w: x[n-1], x[n-2], y[n-1], y[n-2]
+            float y = c[0] * x + c[1] * w[0] + c[2] * w[1] + c[3] * w[2] + c[4] * w[3];
+            w[1] = w[0];
+            w[0] = x;
+            w[3] = w[2];
+            w[2] = y;
+            x    = y;
+        }
+        axes[axis] = x;
+#endif
+    }
+}
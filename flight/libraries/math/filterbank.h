@@ -0,0 +1,64 @@
+/**
+ ******************************************************************************
+ * @addtogroup OpenPilot Math Utilities
+ * @{
+ * @addtogroup Cascaded biquad filter bank
+ * @{
+ *
+ * @file       filterbank.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @brief      Cascade of direct form 1 biquads for gyro conditioning
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef FILTERBANK_H
+#define FILTERBANK_H
+
+#include <stdint.h>
+
+#ifdef PIOS_STABILIZATION_USE_CMSIS_DSP
+#include <arm_math.h>
+#endif
+
+// lowpass plus up to two notches
+#define FILTERBANK_MAX_STAGES 3
+#define FILTERBANK_AXES       3
+
+/*
+ * Coefficients are shared by all axes and stored in the CMSIS DF1
+ * convention, y = b0*x + b1*x1 + b2*x2 + a1*y1 + a2*y2, five per stage.
+ * Each axis keeps its own four state values per stage.
+ */
+struct FilterBank {
+    uint8_t numStages;
+    float   coeffs[5 * FILTERBANK_MAX_STAGES];
+    float   state[FILTERBANK_AXES][4 * FILTERBANK_MAX_STAGES];
+#ifdef PIOS_STABILIZATION_USE_CMSIS_DSP
+    arm_biquad_casd_df1_inst_f32 instance[FILTERBANK_AXES];
+#endif
+};
+
+// Function declarations
+void FilterBankInit(struct FilterBank *bank);
+void FilterBankAddLowPass(struct FilterBank *bank, const float cutoff, const float dT);
+void FilterBankAddNotch(struct FilterBank *bank, const float center, const float q, const float dT);
+void FilterBankApply(struct FilterBank *bank, float *axes);
+
+#endif /* FILTERBANK_H */
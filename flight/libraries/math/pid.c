@@ -99,6 +99,83 @@ float pid_apply_setpoint(struct pid *pid, const pid_scaler *scaler, const float
     return (err * scaler->p * pid->p) + pid->iAccumulator / 1000.0f + dterm;
 }
 
+/**
+ * Update all three axes of a pid3 bank with setpoint weighting on the
+ * derivative, equivalent to calling pid_apply_setpoint once per axis
+ * @param[in] pid The three axis PID bank
+ * @param[in] scaler Per axis dynamic factors to scale pid's by
+ * @param[in] setpoint The setpoints to use
+ * @param[in] measured The measured values of output
+ * @param[in] dT  The time step
+ * @param[out] out The computed controller values
+ *
+ * The derivative filter coefficient and the 1/dT factor are identical for all
+ * axes and are hoisted out of the loop; the structure-of-arrays layout keeps
+ * the three independent dependency chains in flight on the FPU at once.
+ */
+void pid3_apply_setpoint(struct pid3 *pid, const pid_scaler scaler[3], const float setpoint[3], const float measured[3], float dT, float out[3])
+{
+    float deriv_alpha = 0.0f;
+    float inv_dT = 0.0f;
+
+    if (dT > 0.0f) {
+        deriv_alpha = dT / (dT + deriv_tau);
+        inv_dT      = 1.0f / dT;
+    }
+
+    for (int t = 0; t < 3; t++) {
+        float err = setpoint[t] - measured[t];
+
+        // Scale up accumulator by 1000 while computing to avoid losing precision
+        float acc = pid->iAccumulator[t] + err * (scaler[t].i * pid->i[t] * dT * 1000.0f);
+        acc = boundf(acc, pid->iLim[t] * -1000.0f, pid->iLim[t] * 1000.0f);
+        pid->iAccumulator[t] = acc;
+
+        // Calculate DT1 term
+        float dterm   = 0;
+        float weighted = deriv_gamma * setpoint[t] - measured[t];
+        float diff    = weighted - pid->lastErr[t];
+        pid->lastErr[t] = weighted;
+        if (pid->d[t] > 0.0f && dT > 0.0f) {
+            dterm = pid->lastDer[t] + deriv_alpha * ((scaler[t].d * diff * pid->d[t] * inv_dT) - pid->lastDer[t]);
+            pid->lastDer[t] = dterm;
+        }
+
+        out[t] = (err * scaler[t].p * pid->p[t]) + acc / 1000.0f + dterm;
+    }
+}
+
+/**
+ * Update a single axis of a pid3 bank, for callers that mix per axis modes
+ * and cannot evaluate all three axes together
+ * @param[in] pid The three axis PID bank
+ * @param[in] axis The axis to update
+ * @param[in] scaler A dynamic factor to scale pid's by
+ * @param[in] setpoint The setpoint to use
+ * @param[in] measured The measured value of output
+ * @param[in] dT  The time step
+ * @returns Output the computed controller value
+ */
+float pid3_apply_setpoint_axis(struct pid3 *pid, int axis, const pid_scaler *scaler, const float setpoint, const float measured, float dT)
+{
+    float err = setpoint - measured;
+
+    // Scale up accumulator by 1000 while computing to avoid losing precision
+    pid->iAccumulator[axis] += err * (scaler->i * pid->i[axis] * dT * 1000.0f);
+    pid->iAccumulator[axis]  = boundf(pid->iAccumulator[axis], pid->iLim[axis] * -1000.0f, pid->iLim[axis] * 1000.0f);
+
+    // Calculate DT1 term
+    float dterm = 0;
+    float diff  = ((deriv_gamma * setpoint - measured) - pid->lastErr[axis]);
+    pid->lastErr[axis] = (deriv_gamma * setpoint - measured);
+    if (pid->d[axis] > 0.0f && dT > 0.0f) {
+        dterm = pid->lastDer[axis] + dT / (dT + deriv_tau) * ((scaler->d * diff * pid->d[axis] / dT) - pid->lastDer[axis]);
+        pid->lastDer[axis] = dterm;
+    }
+
+    return (err * scaler->p * pid->p[axis]) + pid->iAccumulator[axis] / 1000.0f + dterm;
+}
+
 /**
  * Reset a bit
  * @param[in] pid The pid to reset
@@ -143,3 +220,40 @@ void pid_configure(struct pid *pid, float p, float i, float d, float iLim)
     pid->d    = d;
     pid->iLim = iLim;
 }
+
+/**
+ * Reset the state of all three axes of a pid3 bank
+ * @param[in] pid The pid bank to reset
+ */
+void pid3_zero(struct pid3 *pid)
+{
+    if (!pid) {
+        return;
+    }
+
+    for (int t = 0; t < 3; t++) {
+        pid->iAccumulator[t] = 0;
+        pid->lastErr[t] = 0;
+        pid->lastDer[t] = 0;
+    }
+}
+
+/**
+ * Configure one axis of a pid3 bank
+ * @param[out] pid The PID bank to configure
+ * @param[in] axis The axis to configure
+ * @param[in] p The proportional term
+ * @param[in] i The integral term
+ * @param[in] d The derivative term
+ */
+void pid3_configure_axis(struct pid3 *pid, int axis, float p, float i, float d, float iLim)
+{
+    if (!pid) {
+        return;
+    }
+
+    pid->p[axis]    = p;
+    pid->i[axis]    = i;
+    pid->d[axis]    = d;
+    pid->iLim[axis] = iLim;
+}
@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @addtogroup OpenPilot Math Utilities
+ * @{
+ * @addtogroup Reuseable math functions
+ * @{
+ *
+ * @file       vecquat.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @brief      Inline 3-vector and quaternion operations for the hot control path
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef VECQUAT_H
+#define VECQUAT_H
+
+#include <mathmisc.h>
+
+/*
+ * Header-only counterparts of the CrossProduct/quat_* helpers in
+ * CoordinateConversions.c.  Inlining lets the compiler keep the operands
+ * in the M4F register file across consecutive operations instead of
+ * spilling them around a function call, which is worth several percent
+ * of loop cost in the attitude filters and the stabilization loops.
+ * Quaternions are stored w,x,y,z as everywhere else in this tree.
+ */
+
+static inline float vector3f_dot(const float a[3], const float b[3])
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+static inline void vector3f_cross(const float a[3], const float b[3], float r[3])
+{
+    r[0] = a[1] * b[2] - a[2] * b[1];
+    r[1] = a[2] * b[0] - a[0] * b[2];
+    r[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static inline void vector3f_scale(float v[3], const float s)
+{
+    v[0] *= s;
+    v[1] *= s;
+    v[2] *= s;
+}
+
+// normalizes in place using the fast reciprocal square root and returns
+// the reciprocal length, so callers can sanity check the input magnitude
+static inline float vector3f_normalize_fast(float v[3])
+{
+    float invlen = fast_invsqrtf(vector3f_dot(v, v));
+
+    vector3f_scale(v, invlen);
+    return invlen;
+}
+
+static inline void quatf_conjugate(float q[4])
+{
+    q[1] = -q[1];
+    q[2] = -q[2];
+    q[3] = -q[3];
+}
+
+static inline void quatf_mult(const float q1[4], const float q2[4], float qout[4])
+{
+    qout[0] = q1[0] * q2[0] - q1[1] * q2[1] - q1[2] * q2[2] - q1[3] * q2[3];
+    qout[1] = q1[0] * q2[1] + q1[1] * q2[0] + q1[2] * q2[3] - q1[3] * q2[2];
+    qout[2] = q1[0] * q2[2] - q1[1] * q2[3] + q1[2] * q2[0] + q1[3] * q2[1];
+    qout[3] = q1[0] * q2[3] + q1[1] * q2[2] - q1[2] * q2[1] + q1[3] * q2[0];
+}
+
+// rotates a vector from the earth fixed frame into the body frame,
+// i.e. applies the Rbe matrix of Quaternion2R without materializing it
+static inline void quatf_rotate(const float q[4], const float v[3], float vout[3])
+{
+    // expanded rotation matrix rows, cheaper than two quaternion products
+    vout[0] = (q[0] * q[0] + q[1] * q[1] - q[2] * q[2] - q[3] * q[3]) * v[0]
+              + 2.0f * (q[1] * q[2] + q[0] * q[3]) * v[1]
+              + 2.0f * (q[1] * q[3] - q[0] * q[2]) * v[2];
+    vout[1] = 2.0f * (q[1] * q[2] - q[0] * q[3]) * v[0]
+              + (q[0] * q[0] - q[1] * q[1] + q[2] * q[2] - q[3] * q[3]) * v[1]
+              + 2.0f * (q[2] * q[3] + q[0] * q[1]) * v[2];
+    vout[2] = 2.0f * (q[1] * q[3] + q[0] * q[2]) * v[0]
+              + 2.0f * (q[2] * q[3] - q[0] * q[1]) * v[1]
+              + (q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3]) * v[2];
+}
+
+// time derivative of q under body rates w in rad/s: qdot = 0.5 * q ⊗ (0, w)
+static inline void quatf_derivative(const float q[4], const float w[3], float qdot[4])
+{
+    qdot[0] = 0.5f * (-q[1] * w[0] - q[2] * w[1] - q[3] * w[2]);
+    qdot[1] = 0.5f * (q[0] * w[0] - q[3] * w[1] + q[2] * w[2]);
+    qdot[2] = 0.5f * (q[3] * w[0] + q[0] * w[1] - q[1] * w[2]);
+    qdot[3] = 0.5f * (-q[2] * w[0] + q[1] * w[1] + q[0] * w[2]);
+}
+
+// normalizes in place using the fast reciprocal square root and returns
+// the reciprocal length, so callers can detect degenerate quaternions
+static inline float quatf_normalize_fast(float q[4])
+{
+    float invlen = fast_invsqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+    q[0] *= invlen;
+    q[1] *= invlen;
+    q[2] *= invlen;
+    q[3] *= invlen;
+    return invlen;
+}
+
+#endif /* VECQUAT_H */
+
+/**
+ * @}
+ * @}
+ */
@@ -141,19 +141,30 @@ static bool handleAlarms(uint16_t *r_pattern, uint16_t *b_pattern);
 static bool handleNotifications(pios_notify_notification runningNotification, uint16_t *r_pattern, uint16_t *b_pattern);
 static void handleFlightMode(uint16_t *r_pattern, uint16_t *b_pattern);
 static void handleHeartbeat(uint16_t *r_pattern, uint16_t *b_pattern);
+static void alarmsChanged(void);
 
 
 void NotificationUpdateStatus()
 {
-    started = true;
+    if (!started) {
+        // keep the cached alarm level fresh through the change callback
+        // instead of rescanning the alarms on every update
+        AlarmsRegisterChangeCallback(alarmsChanged);
+        currentAlarmLevel = AlarmsGetHighestSeverity();
+        started = true;
+    }
     // get values to be used for led handling
     FlightStatusGet((FlightStatusData *)&currentFlightStatus);
-    currentAlarmLevel = AlarmsGetHighestSeverity();
     if (nextNotification == NOTIFY_NONE) {
         nextNotification = PIOS_NOTIFY_GetActiveNotification(true);
     }
 }
 
+static void alarmsChanged(void)
+{
+    currentAlarmLevel = AlarmsGetHighestSeverity();
+}
+
 void NotificationOnboardLedsRun()
 {
     static uint32_t lastRunTimestamp;
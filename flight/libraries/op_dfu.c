@@ -246,6 +246,7 @@ void processComand(uint8_t *xReceive_Buffer)
                                 }
                             }
                         }
+                        PIOS_BL_HELPER_CRC_Invalidate();
                         break;
                     case Remote_flash_via_spi:
                         result = false; // No support for this for the OPLink Mini
@@ -34,45 +34,81 @@
 // no direct UAVObject usage allowed in this file
 
 // private functions
-static void path_endpoint(PathDesiredData *path, float *cur_point, struct path_status *status, bool mode);
-static void path_vector(PathDesiredData *path, float *cur_point, struct path_status *status, bool mode);
-static void path_circle(PathDesiredData *path, float *cur_point, struct path_status *status, bool clockwise);
+static void path_endpoint(struct path_compiled *cpath, float *cur_point, struct path_status *status);
+static void path_vector(struct path_compiled *cpath, float *cur_point, struct path_status *status);
+static void path_circle(struct path_compiled *cpath, float *cur_point, struct path_status *status, bool clockwise);
 
 /**
- * @brief Compute progress along path and deviation from it
+ * @brief Compile a path segment into the form consumed by path_progress()
  * @param[in] path  PathDesired structure
+ * @param[out] cpath Compiled segment
+ *
+ * All terms that are constant along the segment (direction vector, lengths,
+ * arc parameters) are calculated here, once per PathDesired update, instead
+ * of on every path_progress() iteration.
+ */
+void path_compile(PathDesiredData *path, struct path_compiled *cpath)
+{
+    cpath->mode     = path->Mode;
+    // circles are always horizontal (for now - TODO: allow 3d circles - problem: clockwise/counterclockwise does no longer apply)
+    cpath->mode3D   = (path->Mode == PATHDESIRED_MODE_FLYVECTOR || path->Mode == PATHDESIRED_MODE_FLYENDPOINT);
+    cpath->start[0] = path->Start.North;
+    cpath->start[1] = path->Start.East;
+    cpath->start[2] = path->Start.Down;
+    cpath->end[0]   = path->End.North;
+    cpath->end[1]   = path->End.East;
+    cpath->end[2]   = path->End.Down;
+    cpath->starting_velocity = path->StartingVelocity;
+    cpath->ending_velocity   = path->EndingVelocity;
+
+    cpath->path_vector[0]    = path->End.North - path->Start.North;
+    cpath->path_vector[1]    = path->End.East - path->Start.East;
+    cpath->path_vector[2]    = cpath->mode3D ? path->End.Down - path->Start.Down : 0.0f;
+
+    // in the circle modes path_vector is the radius vector and path_length
+    // the wanted radius, since Down is forced to zero above
+    cpath->path_length = vector_lengthf(cpath->path_vector, 3);
+    if (cpath->path_length > 1e-6f) {
+        cpath->inv_path_length = 1.0f / cpath->path_length;
+    } else {
+        cpath->inv_path_length = 0.0f;
+    }
+
+    cpath->arc_start_angle = atan2f(cpath->path_vector[0], cpath->path_vector[1]);
+    if (cpath->arc_start_angle < 0) {
+        cpath->arc_start_angle += 2.0f * M_PI_F;
+    }
+}
+
+/**
+ * @brief Compute progress along path and deviation from it
+ * @param[in] cpath  Compiled path segment, see path_compile()
  * @param[in] cur_point Current location
  * @param[out] status Structure containing progress along path and deviation
  */
-void path_progress(PathDesiredData *path, float *cur_point, struct path_status *status)
+void path_progress(struct path_compiled *cpath, float *cur_point, struct path_status *status)
 {
-    switch (path->Mode) {
+    switch (cpath->mode) {
     case PATHDESIRED_MODE_FLYVECTOR:
-        return path_vector(path, cur_point, status, true);
-
-        break;
     case PATHDESIRED_MODE_DRIVEVECTOR:
-        return path_vector(path, cur_point, status, false);
+        return path_vector(cpath, cur_point, status);
 
         break;
     case PATHDESIRED_MODE_FLYCIRCLERIGHT:
     case PATHDESIRED_MODE_DRIVECIRCLERIGHT:
-        return path_circle(path, cur_point, status, 1);
+        return path_circle(cpath, cur_point, status, 1);
 
         break;
     case PATHDESIRED_MODE_FLYCIRCLELEFT:
     case PATHDESIRED_MODE_DRIVECIRCLELEFT:
-        return path_circle(path, cur_point, status, 0);
+        return path_circle(cpath, cur_point, status, 0);
 
         break;
     case PATHDESIRED_MODE_FLYENDPOINT:
-        return path_endpoint(path, cur_point, status, true);
-
-        break;
     case PATHDESIRED_MODE_DRIVEENDPOINT:
     default:
         // use the endpoint as default failsafe if called in unknown modes
-        return path_endpoint(path, cur_point, status, false);
+        return path_endpoint(cpath, cur_point, status);
 
         break;
     }
@@ -80,28 +116,27 @@ void path_progress(PathDesiredData *path, float *cur_point, struct path_status *
 
 /**
  * @brief Compute progress towards endpoint. Deviation equals distance
- * @param[in] path PathDesired
+ * @param[in] cpath Compiled path segment
  * @param[in] cur_point Current location
  * @param[out] status Structure containing progress along path and deviation
- * @param[in] mode3D set true to include altitude in distance and progress calculation
  */
-static void path_endpoint(PathDesiredData *path, float *cur_point, struct path_status *status, bool mode3D)
+static void path_endpoint(struct path_compiled *cpath, float *cur_point, struct path_status *status)
 {
     float diff[3];
     float dist_path, dist_diff;
 
     // Distance to go
-    status->path_vector[0] = path->End.North - path->Start.North;
-    status->path_vector[1] = path->End.East - path->Start.East;
-    status->path_vector[2] = mode3D ? path->End.Down - path->Start.Down : 0.0f;
+    status->path_vector[0] = cpath->path_vector[0];
+    status->path_vector[1] = cpath->path_vector[1];
+    status->path_vector[2] = cpath->path_vector[2];
 
     // Current progress location relative to end
-    diff[0]   = path->End.North - cur_point[0];
-    diff[1]   = path->End.East - cur_point[1];
-    diff[2]   = mode3D ? path->End.Down - cur_point[2] : 0.0f;
+    diff[0]   = cpath->end[0] - cur_point[0];
+    diff[1]   = cpath->end[1] - cur_point[1];
+    diff[2]   = cpath->mode3D ? cpath->end[2] - cur_point[2] : 0.0f;
 
     dist_diff = vector_lengthf(diff, 3);
-    dist_path = vector_lengthf(status->path_vector, 3);
+    dist_path = cpath->path_length;
 
     if (dist_diff < 1e-6f) {
         status->fractional_progress  = 1;
@@ -126,53 +161,50 @@ static void path_endpoint(PathDesiredData *path, float *cur_point, struct path_s
     status->correction_vector[2] = diff[2];
 
     // base movement direction in this mode is a constant velocity offset on top of correction in the same direction
-    status->path_vector[0] = path->EndingVelocity * status->correction_vector[0] / dist_diff;
-    status->path_vector[1] = path->EndingVelocity * status->correction_vector[1] / dist_diff;
-    status->path_vector[2] = path->EndingVelocity * status->correction_vector[2] / dist_diff;
+    status->path_vector[0] = cpath->ending_velocity * status->correction_vector[0] / dist_diff;
+    status->path_vector[1] = cpath->ending_velocity * status->correction_vector[1] / dist_diff;
+    status->path_vector[2] = cpath->ending_velocity * status->correction_vector[2] / dist_diff;
 }
 
 /**
  * @brief Compute progress along path and deviation from it
- * @param[in] path PathDesired
+ * @param[in] cpath Compiled path segment
  * @param[in] cur_point Current location
  * @param[out] status Structure containing progress along path and deviation
- * @param[in] mode3D set true to include altitude in distance and progress calculation
  */
-static void path_vector(PathDesiredData *path, float *cur_point, struct path_status *status, bool mode3D)
+static void path_vector(struct path_compiled *cpath, float *cur_point, struct path_status *status)
 {
     float diff[3];
-    float dist_path;
     float dot;
     float velocity;
     float track_point[3];
 
     // Distance to go
-    status->path_vector[0] = path->End.North - path->Start.North;
-    status->path_vector[1] = path->End.East - path->Start.East;
-    status->path_vector[2] = mode3D ? path->End.Down - path->Start.Down : 0.0f;
+    status->path_vector[0] = cpath->path_vector[0];
+    status->path_vector[1] = cpath->path_vector[1];
+    status->path_vector[2] = cpath->path_vector[2];
 
     // Current progress location relative to start
-    diff[0]   = cur_point[0] - path->Start.North;
-    diff[1]   = cur_point[1] - path->Start.East;
-    diff[2]   = mode3D ? cur_point[2] - path->Start.Down : 0.0f;
+    diff[0] = cur_point[0] - cpath->start[0];
+    diff[1] = cur_point[1] - cpath->start[1];
+    diff[2] = cpath->mode3D ? cur_point[2] - cpath->start[2] : 0.0f;
 
-    dot       = status->path_vector[0] * diff[0] + status->path_vector[1] * diff[1] + status->path_vector[2] * diff[2];
-    dist_path = vector_lengthf(status->path_vector, 3);
+    dot     = status->path_vector[0] * diff[0] + status->path_vector[1] * diff[1] + status->path_vector[2] * diff[2];
 
-    if (dist_path > 1e-6f) {
+    if (cpath->inv_path_length > 0.0f) {
         // Compute direction to travel & progress
-        status->fractional_progress = dot / (dist_path * dist_path);
+        status->fractional_progress = dot * cpath->inv_path_length * cpath->inv_path_length;
     } else {
         // Fly towards the endpoint to prevent flying away,
         // but assume progress=1 either way.
-        path_endpoint(path, cur_point, status, mode3D);
+        path_endpoint(cpath, cur_point, status);
         status->fractional_progress = 1;
         return;
     }
     // Compute point on track that is closest to our current position.
-    track_point[0] = status->fractional_progress * status->path_vector[0] + path->Start.North;
-    track_point[1] = status->fractional_progress * status->path_vector[1] + path->Start.East;
-    track_point[2] = status->fractional_progress * status->path_vector[2] + path->Start.Down;
+    track_point[0] = status->fractional_progress * status->path_vector[0] + cpath->start[0];
+    track_point[1] = status->fractional_progress * status->path_vector[1] + cpath->start[1];
+    track_point[2] = status->fractional_progress * status->path_vector[2] + cpath->start[2];
 
     status->correction_vector[0] = track_point[0] - cur_point[0];
     status->correction_vector[1] = track_point[1] - cur_point[1];
@@ -181,37 +213,35 @@ static void path_vector(PathDesiredData *path, float *cur_point, struct path_sta
     status->error = vector_lengthf(status->correction_vector, 3);
 
     // correct movement vector to current velocity
-    velocity = path->StartingVelocity + boundf(status->fractional_progress, 0.0f, 1.0f) * (path->EndingVelocity - path->StartingVelocity);
-    status->path_vector[0] = velocity * status->path_vector[0] / dist_path;
-    status->path_vector[1] = velocity * status->path_vector[1] / dist_path;
-    status->path_vector[2] = velocity * status->path_vector[2] / dist_path;
+    velocity = cpath->starting_velocity + boundf(status->fractional_progress, 0.0f, 1.0f) * (cpath->ending_velocity - cpath->starting_velocity);
+    status->path_vector[0] = velocity * status->path_vector[0] * cpath->inv_path_length;
+    status->path_vector[1] = velocity * status->path_vector[1] * cpath->inv_path_length;
+    status->path_vector[2] = velocity * status->path_vector[2] * cpath->inv_path_length;
 }
 
 /**
  * @brief Compute progress along circular path and deviation from it
- * @param[in] path PathDesired
+ * @param[in] cpath Compiled path segment, End is the center of the circle
  * @param[in] cur_point Current location
  * @param[out] status Structure containing progress along path and deviation
  */
-static void path_circle(PathDesiredData *path, float *cur_point, struct path_status *status, bool clockwise)
+static void path_circle(struct path_compiled *cpath, float *cur_point, struct path_status *status, bool clockwise)
 {
-    float radius_north, radius_east, diff_north, diff_east, diff_down;
+    float diff_north, diff_east, diff_down;
     float radius, cradius;
     float normal[2];
     float progress;
-    float a_diff, a_radius;
+    float a_diff;
 
-    // Radius
-    radius_north = path->End.North - path->Start.North;
-    radius_east  = path->End.East - path->Start.East;
+    // Wanted radius, precompiled from the Start to End vector
+    radius     = cpath->path_length;
 
     // Current location relative to center
-    diff_north   = cur_point[0] - path->End.North;
-    diff_east    = cur_point[1] - path->End.East;
-    diff_down    = cur_point[2] - path->End.Down;
+    diff_north = cur_point[0] - cpath->end[0];
+    diff_east  = cur_point[1] - cpath->end[1];
+    diff_down  = cur_point[2] - cpath->end[2];
 
-    radius  = sqrtf(squaref(radius_north) + squaref(radius_east));
-    cradius = sqrtf(squaref(diff_north) + squaref(diff_east));
+    cradius    = sqrtf(squaref(diff_north) + squaref(diff_east));
 
     // circles are always horizontal (for now - TODO: allow 3d circles - problem: clockwise/counterclockwise does no longer apply)
     status->path_vector[2] = 0.0f;
@@ -224,7 +254,7 @@ static void path_circle(PathDesiredData *path, float *cur_point, struct path_sta
         status->fractional_progress  = 1;
         status->correction_vector[0] = 0;
         status->correction_vector[1] = 0;
-        status->path_vector[0] = path->EndingVelocity;
+        status->path_vector[0] = cpath->ending_velocity;
         status->path_vector[1] = 0;
     } else {
         if (clockwise) {
@@ -237,18 +267,15 @@ static void path_circle(PathDesiredData *path, float *cur_point, struct path_sta
             normal[1] = -diff_north / cradius;
         }
 
-        // normalize progress to 0..1
+        // normalize progress to 0..1, the angle of the radius vector is
+        // precompiled into arc_start_angle
         a_diff   = atan2f(diff_north, diff_east);
-        a_radius = atan2f(radius_north, radius_east);
 
         if (a_diff < 0) {
             a_diff += 2.0f * M_PI_F;
         }
-        if (a_radius < 0) {
-            a_radius += 2.0f * M_PI_F;
-        }
 
-        progress = (a_diff - a_radius + M_PI_F) / (2.0f * M_PI_F);
+        progress = (a_diff - cpath->arc_start_angle + M_PI_F) / (2.0f * M_PI_F);
 
         if (progress < 0.0f) {
             progress += 1.0f;
@@ -263,8 +290,8 @@ static void path_circle(PathDesiredData *path, float *cur_point, struct path_sta
         status->fractional_progress = progress;
 
         // Compute direction to travel
-        status->path_vector[0] = normal[0] * path->EndingVelocity;
-        status->path_vector[1] = normal[1] * path->EndingVelocity;
+        status->path_vector[0] = normal[0] * cpath->ending_velocity;
+        status->path_vector[1] = normal[1] * cpath->ending_velocity;
 
         // Compute direction to correct error
         status->correction_vector[0] = status->error * diff_north / cradius;
@@ -38,6 +38,10 @@ int synBytes[MAXDEG];
 /* generator polynomial */
 int genPoly[MAXDEG*2];
 
+/* logarithms of the generator polynomial coefficients, so the encoder
+ * inner loop only takes the log of the feedback byte once */
+static int genLog[RS_ECC_NPARITY];
+
 //int DEBUG = FALSE;
 
 static void
@@ -47,11 +51,15 @@ compute_genpoly (int nbytes, int genpoly[]);
 void
 initialize_ecc ()
 {
+  int i;
+
   /* Initialize the galois field arithmetic tables */
     init_galois_tables();
 
     /* Compute the encoder generator polynomial */
     compute_genpoly(RS_ECC_NPARITY, genPoly);
+
+    for (i = 0; i < RS_ECC_NPARITY; i++) genLog[i] = glog[genPoly[i]];
 }
 
 void
@@ -111,12 +119,20 @@ void
 decode_data(unsigned char data[], int nbytes)
 {
   int i, j, sum;
-  for (j = 0; j < RS_ECC_NPARITY;  j++) {
-    sum	= 0;
-    for (i = 0; i < nbytes; i++) {
-      sum = data[i] ^ gmult(gexp[j+1], sum);
+
+  /* Stream the data once with all accumulators in flight instead of
+   * rescanning it per syndrome.  S_j is multiplied by alpha^(j+1) with a
+   * single antilog lookup; taking glog of gexp[j+1] again on every byte,
+   * as gmult() would, is what made this loop expensive. */
+  for (j = 0; j < RS_ECC_NPARITY;  j++) synBytes[j] = 0;
+
+  for (i = 0; i < nbytes; i++) {
+    int d = data[i];
+    for (j = 0; j < RS_ECC_NPARITY;  j++) {
+      sum = synBytes[j];
+      if (sum) sum = gexp[j + 1 + glog[sum]];
+      synBytes[j] = d ^ sum;
     }
-    synBytes[j]  = sum;
   }
 }
 
@@ -187,21 +203,31 @@ compute_genpoly (int nbytes, int genpoly[])
 void
 encode_data (unsigned char msg[], int nbytes, unsigned char dst[])
 {
-  int i, LFSR[RS_ECC_NPARITY+1],dbyte, j;
-	
+  int i, LFSR[RS_ECC_NPARITY+1],dbyte, dlog, j;
+
   for(i=0; i < RS_ECC_NPARITY+1; i++) LFSR[i]=0;
 
   for (i = 0; i < nbytes; i++) {
     dbyte = msg[i] ^ LFSR[RS_ECC_NPARITY-1];
-    for (j = RS_ECC_NPARITY-1; j > 0; j--) {
-      LFSR[j] = LFSR[j-1] ^ gmult(genPoly[j], dbyte);
+    if (dbyte) {
+      /* one log lookup for the feedback byte, the generator
+       * coefficient logs are precomputed in genLog[] */
+      dlog = glog[dbyte];
+      for (j = RS_ECC_NPARITY-1; j > 0; j--) {
+        LFSR[j] = LFSR[j-1] ^ gexp[genLog[j] + dlog];
+      }
+      LFSR[0] = gexp[genLog[0] + dlog];
+    } else {
+      for (j = RS_ECC_NPARITY-1; j > 0; j--) {
+        LFSR[j] = LFSR[j-1];
+      }
+      LFSR[0] = 0;
     }
-    LFSR[0] = gmult(genPoly[0], dbyte);
   }
 
-  for (i = 0; i < RS_ECC_NPARITY; i++) 
+  for (i = 0; i < RS_ECC_NPARITY; i++)
     pBytes[i] = LFSR[i];
-	
+
   build_codeword(msg, nbytes, dst);
 }
 
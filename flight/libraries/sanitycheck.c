@@ -54,12 +54,69 @@
 // ! Check a stabilization mode switch position for safety
 static bool check_stabilization_settings(int index, bool multirotor, bool coptercontrol);
 
+// Runtime (non settings) inputs of the checks.  They cannot be tracked
+// through object callbacks, but they are cheap to sample; a change in
+// any of them triggers a full re-evaluation like a settings update does.
+struct runtime_inputs {
+    uint8_t autotuneRunning;
+    uint8_t pathPlanAlarm;
+    uint8_t hitlOverride;
+};
+
+static volatile bool settingsDirty = true;
+static bool callbacksRegistered    = false;
+static struct runtime_inputs lastRuntime;
+
+// ! Mark the cached verdict stale whenever an input object changes
+static void settingsUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
+{
+    settingsDirty = true;
+}
+
 /**
  * Run a preflight check over the hardware configuration
- * and currently active modules
+ * and currently active modules.  The verdict is only re-evaluated when
+ * one of the objects the checks read has changed since the last run, so
+ * the steady state cost of the periodic arming guard is a few object
+ * field reads.
  */
 int32_t configuration_check()
 {
+    if (!callbacksRegistered) {
+        callbacksRegistered = true;
+        // the objects the checks below read; a change to any of them
+        // invalidates the cached verdict
+        SystemSettingsConnectCallback(settingsUpdatedCb);
+        ManualControlSettingsConnectCallback(settingsUpdatedCb);
+        FlightModeSettingsConnectCallback(settingsUpdatedCb);
+#ifdef REVOLUTION
+        RevoSettingsInitialize();
+        RevoSettingsConnectCallback(settingsUpdatedCb);
+#endif
+    }
+
+    // Sample the runtime inputs
+    struct runtime_inputs runtime;
+    SystemAlarmsAlarmData alarms;
+    SystemAlarmsAlarmGet(&alarms);
+    runtime.autotuneRunning = PIOS_TASK_MONITOR_IsRunning(TASKINFO_RUNNING_AUTOTUNE);
+    runtime.pathPlanAlarm   = alarms.PathPlan;
+#ifdef REVOLUTION
+    runtime.hitlOverride    = PositionStateHandle() && PositionStateReadOnly();
+#else
+    runtime.hitlOverride    = false;
+#endif
+
+    if (!settingsDirty
+        && runtime.autotuneRunning == lastRuntime.autotuneRunning
+        && runtime.pathPlanAlarm == lastRuntime.pathPlanAlarm
+        && runtime.hitlOverride == lastRuntime.hitlOverride) {
+        // nothing the checks read has changed, the published verdict stands
+        return 0;
+    }
+    settingsDirty = false;
+    lastRuntime   = runtime;
+
     int32_t severity = SYSTEMALARMS_ALARM_OK;
     SystemAlarmsExtendedAlarmStatusOptions alarmstatus = SYSTEMALARMS_EXTENDEDALARMSTATUS_NONE;
     uint8_t alarmsubstatus = 0;
@@ -69,7 +126,6 @@ int32_t configuration_check()
 
     // Classify navigation capability
 #ifdef REVOLUTION
-    RevoSettingsInitialize();
     uint8_t revoFusion;
     RevoSettingsFusionAlgorithmGet(&revoFusion);
     bool navCapableFusion;
@@ -79,14 +135,9 @@ int32_t configuration_check()
         navCapableFusion = true;
         break;
     default:
-        navCapableFusion = false;
         // check for hitl.  hitl allows to feed position and velocity state via
         // telemetry, this makes nav possible even with an unsuited algorithm
-        if (PositionStateHandle()) {
-            if (PositionStateReadOnly()) {
-                navCapableFusion = true;
-            }
-        }
+        navCapableFusion = runtime.hitlOverride;
     }
 #else
     const bool navCapableFusion = false;
@@ -128,17 +179,13 @@ int32_t configuration_check()
             ADDSEVERITY(check_stabilization_settings(6, multirotor, coptercontrol));
             break;
         case FLIGHTMODESETTINGS_FLIGHTMODEPOSITION_AUTOTUNE:
-            ADDSEVERITY(PIOS_TASK_MONITOR_IsRunning(TASKINFO_RUNNING_AUTOTUNE));
+            ADDSEVERITY(runtime.autotuneRunning);
             break;
         case FLIGHTMODESETTINGS_FLIGHTMODEPOSITION_PATHPLANNER:
-        {
             // Revo supports PathPlanner and that must be OK or we are not sane
             // PathPlan alarm is uninitialized if not running
             // PathPlan alarm is warning or error if the flightplan is invalid
-            SystemAlarmsAlarmData alarms;
-            SystemAlarmsAlarmGet(&alarms);
-            ADDSEVERITY(alarms.PathPlan == SYSTEMALARMS_ALARM_OK);
-        }
+            ADDSEVERITY(runtime.pathPlanAlarm == SYSTEMALARMS_ALARM_OK);
         // intentionally no break as this also needs pathfollower
         case FLIGHTMODESETTINGS_FLIGHTMODEPOSITION_POSITIONHOLD:
         case FLIGHTMODESETTINGS_FLIGHTMODEPOSITION_POSITIONVARIOFPV:
@@ -777,18 +777,35 @@ static int16_t sf_ReceivePacket(Port_t *thisport)
             sf_SendAckPacket(thisport, thisport->rxBuf[SEQNUM]);
             value = FALSE;
         } else {
-            // New Packet
-            thisport->rxSeqNo = thisport->rxBuf[SEQNUM];
-            // Let the application do something with the data/packet.
-            if (thisport->pfCallBack != NULL) {
-                // skip the first two bytes (length and seq. no.) in the buffer.
-                thisport->pfCallBack(&(thisport->rxBuf[2]), thisport->rxBufLen);
+            // Figure out the sequence number we expect next. Sequence numbers
+            // roll over from 0x7F back to 1, zero is reserved for
+            // synchronization requests.
+            uint8_t expectedSeqNo = thisport->rxSeqNo + 1;
+            if (expectedSeqNo > 0x7F) {
+                expectedSeqNo = 1;
+            }
+            if ((thisport->rxSeqNo == 255) || (thisport->rxBuf[SEQNUM] == expectedSeqNo)) {
+                // New Packet
+                thisport->rxSeqNo = thisport->rxBuf[SEQNUM];
+                // Let the application do something with the data/packet.
+                if (thisport->pfCallBack != NULL) {
+                    // skip the first two bytes (length and seq. no.) in the buffer.
+                    thisport->pfCallBack(&(thisport->rxBuf[2]), thisport->rxBufLen);
+                }
+                // after we send the ACK, it is possible for the host to send a new packet.
+                // Thus the application needs to copy the data and reset the receive buffer
+                // inside of thisport->pfCallBack()
+                sf_SendAckPacket(thisport, thisport->rxBuf[SEQNUM]);
+                value = TRUE;
+            } else {
+                // Out of sequence, a packet in between must have been lost.
+                // Drop the packet but re-ack the last one received in order, so
+                // a host that streams several packets at a time backs up and
+                // resends from the first missing packet.
+                thisport->RxError++;
+                sf_SendAckPacket(thisport, thisport->rxSeqNo);
+                value = FALSE;
             }
-            // after we send the ACK, it is possible for the host to send a new packet.
-            // Thus the application needs to copy the data and reset the receive buffer
-            // inside of thisport->pfCallBack()
-            sf_SendAckPacket(thisport, thisport->rxBuf[SEQNUM]);
-            value = TRUE;
         }
     }
     return value;
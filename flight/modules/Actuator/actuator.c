@@ -81,11 +81,21 @@ static volatile bool actuator_settings_updated;
 // used to inform the actuator thread that mixer settings are changed
 static volatile bool mixer_settings_updated;
 
+// Compiled mixer state, rebuilt by compileMixerSettings() whenever
+// MixerSettings change: the int8 mixer weights are prescaled to float once
+// and the throttle curve segment slopes are precomputed, so the per-update
+// path is a dense multiply-accumulate over the command vector.
+static float mixerMatrixScaled[MAX_MIX_ACTUATORS][MIXERSETTINGS_MIXER1VECTOR_NUMELEM];
+static float throttleCurve1Slope[MIXERSETTINGS_THROTTLECURVE1_NUMELEM];
+static float throttleCurve2Slope[MIXERSETTINGS_THROTTLECURVE2_NUMELEM];
+static uint8_t mixerActiveCount;
+
 // Private functions
 static void actuatorTask(void *parameters);
 static int16_t scaleChannel(float value, int16_t max, int16_t min, int16_t neutral);
 static void setFailsafe(const ActuatorSettingsData *actuatorSettings, const MixerSettingsData *mixerSettings);
-static float MixerCurve(const float throttle, const float *curve, uint8_t elements);
+static float MixerCurve(const float throttle, const float *curve, const float *slope, uint8_t elements);
+static void compileMixerSettings(const MixerSettingsData *mixerSettings);
 static bool set_channel(uint8_t mixer_channel, uint16_t value, const ActuatorSettingsData *actuatorSettings);
 static void actuator_update_rate_if_changed(const ActuatorSettingsData *actuatorSettings, bool force_update);
 static void MixerSettingsUpdatedCb(UAVObjEvent *ev);
@@ -191,6 +201,7 @@ static void actuatorTask(__attribute__((unused)) void *parameters)
     MixerSettingsData mixerSettings;
     mixer_settings_updated = false;
     MixerSettingsGet(&mixerSettings);
+    compileMixerSettings(&mixerSettings);
 
     /* Force an initial configuration of the actuator update rates */
     actuator_update_rate_if_changed(&actuatorSettings, true);
@@ -219,6 +230,7 @@ static void actuatorTask(__attribute__((unused)) void *parameters)
         if (mixer_settings_updated) {
             mixer_settings_updated = false;
             MixerSettingsGet(&mixerSettings);
+            compileMixerSettings(&mixerSettings);
         }
 
         if (rc != pdTRUE) {
@@ -275,14 +287,8 @@ static void actuatorTask(__attribute__((unused)) void *parameters)
 #ifdef DIAG_MIXERSTATUS
         MixerStatusGet(&mixerStatus);
 #endif
-        int nMixers     = 0;
         Mixer_t *mixers = (Mixer_t *)&mixerSettings.Mixer1Type;
-        for (int ct = 0; ct < MAX_MIX_ACTUATORS; ct++) {
-            if (mixers[ct].type != MIXERSETTINGS_MIXER1TYPE_DISABLED) {
-                nMixers++;
-            }
-        }
-        if ((nMixers < 2) && !ActuatorCommandReadOnly()) { // Nothing can fly with less than two mixers.
+        if ((mixerActiveCount < 2) && !ActuatorCommandReadOnly()) { // Nothing can fly with less than two mixers.
             setFailsafe(&actuatorSettings, &mixerSettings); // So that channels like PWM buzzer keep working
             continue;
         }
@@ -293,27 +299,27 @@ static void actuatorTask(__attribute__((unused)) void *parameters)
         bool positiveThrottle = (throttleDesired > 0.00f);
         bool spinWhileArmed   = actuatorSettings.MotorsSpinWhileArmed == ACTUATORSETTINGS_MOTORSSPINWHILEARMED_TRUE;
 
-        float curve1 = MixerCurve(throttleDesired, mixerSettings.ThrottleCurve1, MIXERSETTINGS_THROTTLECURVE1_NUMELEM);
+        float curve1 = MixerCurve(throttleDesired, mixerSettings.ThrottleCurve1, throttleCurve1Slope, MIXERSETTINGS_THROTTLECURVE1_NUMELEM);
 
         // The source for the secondary curve is selectable
         float curve2 = 0;
         AccessoryDesiredData accessory;
         switch (mixerSettings.Curve2Source) {
         case MIXERSETTINGS_CURVE2SOURCE_THROTTLE:
-            curve2 = MixerCurve(throttleDesired, mixerSettings.ThrottleCurve2, MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
+            curve2 = MixerCurve(throttleDesired, mixerSettings.ThrottleCurve2, throttleCurve2Slope, MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
             break;
         case MIXERSETTINGS_CURVE2SOURCE_ROLL:
-            curve2 = MixerCurve(desired.Roll, mixerSettings.ThrottleCurve2, MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
+            curve2 = MixerCurve(desired.Roll, mixerSettings.ThrottleCurve2, throttleCurve2Slope, MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
             break;
         case MIXERSETTINGS_CURVE2SOURCE_PITCH:
-            curve2 = MixerCurve(desired.Pitch, mixerSettings.ThrottleCurve2,
+            curve2 = MixerCurve(desired.Pitch, mixerSettings.ThrottleCurve2, throttleCurve2Slope,
                                 MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
             break;
         case MIXERSETTINGS_CURVE2SOURCE_YAW:
-            curve2 = MixerCurve(desired.Yaw, mixerSettings.ThrottleCurve2, MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
+            curve2 = MixerCurve(desired.Yaw, mixerSettings.ThrottleCurve2, throttleCurve2Slope, MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
             break;
         case MIXERSETTINGS_CURVE2SOURCE_COLLECTIVE:
-            curve2 = MixerCurve(collectiveDesired, mixerSettings.ThrottleCurve2,
+            curve2 = MixerCurve(collectiveDesired, mixerSettings.ThrottleCurve2, throttleCurve2Slope,
                                 MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
             break;
         case MIXERSETTINGS_CURVE2SOURCE_ACCESSORY0:
@@ -323,7 +329,7 @@ static void actuatorTask(__attribute__((unused)) void *parameters)
         case MIXERSETTINGS_CURVE2SOURCE_ACCESSORY4:
         case MIXERSETTINGS_CURVE2SOURCE_ACCESSORY5:
             if (AccessoryDesiredInstGet(mixerSettings.Curve2Source - MIXERSETTINGS_CURVE2SOURCE_ACCESSORY0, &accessory) == 0) {
-                curve2 = MixerCurve(accessory.AccessoryVal, mixerSettings.ThrottleCurve2, MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
+                curve2 = MixerCurve(accessory.AccessoryVal, mixerSettings.ThrottleCurve2, throttleCurve2Slope, MIXERSETTINGS_THROTTLECURVE2_NUMELEM);
             } else {
                 curve2 = 0;
             }
@@ -454,6 +460,9 @@ static void actuatorTask(__attribute__((unused)) void *parameters)
             success &= set_channel(n, command.Channel[n], &actuatorSettings);
         }
 
+        // Trigger synchronous (OneShot) output banks now that every channel is written
+        PIOS_Servo_Update();
+
         if (!success) {
             command.NumFailedUpdates++;
             ActuatorCommandSet(&command);
@@ -475,12 +484,13 @@ float ProcessMixer(const int index, const float curve1, const float curve2,
     static float lastFilteredResult[MAX_MIX_ACTUATORS];
     const Mixer_t *mixers = (Mixer_t *)&mixerSettings->Mixer1Type; // pointer to array of mixers in UAVObjects
     const Mixer_t *mixer  = &mixers[index];
+    const float *matrix   = mixerMatrixScaled[index]; // weights prescaled by compileMixerSettings()
 
-    float result = (((float)mixer->matrix[MIXERSETTINGS_MIXER1VECTOR_THROTTLECURVE1] / 128.0f) * curve1) +
-                   (((float)mixer->matrix[MIXERSETTINGS_MIXER1VECTOR_THROTTLECURVE2] / 128.0f) * curve2) +
-                   (((float)mixer->matrix[MIXERSETTINGS_MIXER1VECTOR_ROLL] / 128.0f) * desired->Roll) +
-                   (((float)mixer->matrix[MIXERSETTINGS_MIXER1VECTOR_PITCH] / 128.0f) * desired->Pitch) +
-                   (((float)mixer->matrix[MIXERSETTINGS_MIXER1VECTOR_YAW] / 128.0f) * desired->Yaw);
+    float result = (matrix[MIXERSETTINGS_MIXER1VECTOR_THROTTLECURVE1] * curve1) +
+                   (matrix[MIXERSETTINGS_MIXER1VECTOR_THROTTLECURVE2] * curve2) +
+                   (matrix[MIXERSETTINGS_MIXER1VECTOR_ROLL] * desired->Roll) +
+                   (matrix[MIXERSETTINGS_MIXER1VECTOR_PITCH] * desired->Pitch) +
+                   (matrix[MIXERSETTINGS_MIXER1VECTOR_YAW] * desired->Yaw);
 
     // note: no feedforward for reversable motors yet for safety reasons
     if (mixer->type == MIXERSETTINGS_MIXER1TYPE_MOTOR) {
@@ -527,8 +537,11 @@ float ProcessMixer(const int index, const float curve1, const float curve2,
 /**
  * Interpolate a throttle curve. Throttle input should be in the range 0 to 1.
  * Output is in the range 0 to 1.
+ *
+ * The slope of each curve segment is precomputed by compileMixerSettings()
+ * so the lookup is a single multiply-add.
  */
-static float MixerCurve(const float throttle, const float *curve, uint8_t elements)
+static float MixerCurve(const float throttle, const float *curve, const float *slope, uint8_t elements)
 {
     float scale = throttle * (float)(elements - 1);
     int idx1    = scale;
@@ -540,15 +553,42 @@ static float MixerCurve(const float throttle, const float *curve, uint8_t elemen
     if (idx1 < 0) {
         idx1  = 0; // clamp to lowest entry in table
         scale = 0;
+    } else if (idx1 >= elements - 1) {
+        idx1  = elements - 1; // clamp to highest entry in table
+        scale = 0;
     }
-    int idx2 = idx1 + 1;
-    if (idx2 >= elements) {
-        idx2 = elements - 1; // clamp to highest entry in table
-        if (idx1 >= elements) {
-            idx1 = elements - 1;
+    return curve[idx1] + slope[idx1] * scale;
+}
+
+/**
+ * Compile MixerSettings into the flat per-channel coefficient matrix and
+ * curve slope tables used by the update path. Called from the actuator task
+ * whenever the settings change, so ProcessMixer() and MixerCurve() never pay
+ * for the int8 to float conversion and segment slope division per update.
+ */
+static void compileMixerSettings(const MixerSettingsData *mixerSettings)
+{
+    const Mixer_t *mixers = (Mixer_t *)&mixerSettings->Mixer1Type; // pointer to array of mixers in UAVObjects
+
+    mixerActiveCount = 0;
+    for (int ct = 0; ct < MAX_MIX_ACTUATORS; ct++) {
+        for (int i = 0; i < MIXERSETTINGS_MIXER1VECTOR_NUMELEM; i++) {
+            mixerMatrixScaled[ct][i] = (float)mixers[ct].matrix[i] * (1.0f / 128.0f);
+        }
+        if (mixers[ct].type != MIXERSETTINGS_MIXER1TYPE_DISABLED) {
+            mixerActiveCount++;
         }
     }
-    return curve[idx1] * (1.0f - scale) + curve[idx2] * scale;
+
+    // last entry is the clamp value, slope zero
+    for (int i = 0; i < MIXERSETTINGS_THROTTLECURVE1_NUMELEM - 1; i++) {
+        throttleCurve1Slope[i] = mixerSettings->ThrottleCurve1[i + 1] - mixerSettings->ThrottleCurve1[i];
+    }
+    throttleCurve1Slope[MIXERSETTINGS_THROTTLECURVE1_NUMELEM - 1] = 0;
+    for (int i = 0; i < MIXERSETTINGS_THROTTLECURVE2_NUMELEM - 1; i++) {
+        throttleCurve2Slope[i] = mixerSettings->ThrottleCurve2[i + 1] - mixerSettings->ThrottleCurve2[i];
+    }
+    throttleCurve2Slope[MIXERSETTINGS_THROTTLECURVE2_NUMELEM - 1] = 0;
 }
 
 
@@ -616,6 +656,9 @@ static void setFailsafe(const ActuatorSettingsData *actuatorSettings, const Mixe
         set_channel(n, Channel[n], actuatorSettings);
     }
 
+    // Trigger synchronous (OneShot) output banks now that every channel is written
+    PIOS_Servo_Update();
+
     // Update output object's parts that we changed
     ActuatorCommandChannelSet(Channel);
 }
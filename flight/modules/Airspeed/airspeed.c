@@ -127,7 +127,8 @@ int32_t AirspeedInitialize()
 
     return 0;
 }
-MODULE_INITCALL(AirspeedInitialize, AirspeedStart);
+// Airspeed sensor setup is not needed to arm
+MODULE_INITCALL_DEFERRED(AirspeedInitialize, AirspeedStart);
 
 
 /**
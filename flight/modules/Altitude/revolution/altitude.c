@@ -52,11 +52,21 @@
 #define TASK_PRIORITY       (tskIDLE_PRIORITY + 1)
 
 // Interval in number of sample to recalculate temp bias
-#define TEMP_CALIB_INTERVAL 10
-
-// LPF
-#define TEMP_DT             (1.0f / 120.0f)
-#define TEMP_LPF_FC         5.0f
+#define TEMP_CALIB_INTERVAL   10
+
+// Sensor tap rates.  The die temperature moves far slower than the
+// pressure, so one temperature conversion per TEMP_PRESS_INTERLEAVE
+// pressure conversions keeps the correction current while nearly
+// halving the I2C traffic and conversion wait time of the task.
+#define TEMP_PRESS_INTERLEAVE 10
+// Number of pressure conversions averaged into one BaroSensor
+// publication; subscribers get one pre-filtered sample instead of
+// every raw conversion
+#define PRESS_DECIMATE        2
+
+// LPF, dT is the interval between temperature conversions
+#define TEMP_DT               (TEMP_PRESS_INTERLEAVE / 100.0f)
+#define TEMP_LPF_FC           5.0f
 static const float temp_alpha = TEMP_DT / (TEMP_DT + 1.0f / (2.0f * M_PI_F * TEMP_LPF_FC));
 
 // Private types
@@ -70,9 +80,12 @@ static volatile bool tempCorrectionEnabled;
 static float baro_temp_bias   = 0;
 static float baro_temperature = NAN;
 static uint8_t temp_calibration_count = 0;
+static uint8_t press_decimate_count   = PRESS_DECIMATE;
+static float press_accumulator = 0.0f;
 
 // Private functions
 static void altitudeTask(void *parameters);
+static void baroConversionCallback(ConversionTypeTypeDef type);
 static void SettingsUpdatedCb(UAVObjEvent *ev);
 
 /**
@@ -109,8 +122,6 @@ MODULE_INITCALL(AltitudeInitialize, AltitudeStart);
  */
 static void altitudeTask(__attribute__((unused)) void *parameters)
 {
-    BaroSensorData data;
-
 #if defined(PIOS_INCLUDE_HCSR04)
     SonarAltitudeData sonardata;
     int32_t value = 0, timeout = 10, sample_rate = 0;
@@ -120,17 +131,23 @@ static void altitudeTask(__attribute__((unused)) void *parameters)
 
     // TODO: Check the pressure sensor and set a warning if it fails test
 
-// Option to change the interleave between Temp and Pressure conversions
-// Undef for normal operation
-// #define PIOS_MS5611_SLOW_TEMP_RATE 20
-
     RevoSettingsBaroTempCorrectionPolynomialGet(&baroCorrection);
 
-#ifdef PIOS_MS5611_SLOW_TEMP_RATE
-    uint8_t temp_press_interleave_count = 1;
-#endif
+    // The driver runs the temperature/pressure interleave and reports
+    // completed conversions through baroConversionCallback()
+    PIOS_MS5611_SetTempInterleave(TEMP_PRESS_INTERLEAVE);
+    PIOS_MS5611_RegisterConversionCallback(baroConversionCallback);
+
     // Main task loop
     while (1) {
+        if (PIOS_MS5611_Update() != 0) {
+            // A conversion is in flight; sleep until it is expected to
+            // complete instead of busy-waiting in the driver
+            uint32_t remaining_us = PIOS_MS5611_GetRemainingDelayUs();
+            vTaskDelay((remaining_us / (1000 * portTICK_RATE_MS)) + 1);
+            continue;
+        }
+
 #if defined(PIOS_INCLUDE_HCSR04)
         // Compute the current altitude
         // depends on baro samplerate
@@ -157,28 +174,20 @@ static void altitudeTask(__attribute__((unused)) void *parameters)
             sample_rate = 25;
         }
 #endif /* if defined(PIOS_INCLUDE_HCSR04) */
-        float temp, press;
-#ifdef PIOS_MS5611_SLOW_TEMP_RATE
-        temp_press_interleave_count--;
-        if (temp_press_interleave_count == 0) {
-#endif
-        // Update the temperature data
-        PIOS_MS5611_StartADC(TemperatureConv);
-        vTaskDelay(PIOS_MS5611_GetDelay());
-        PIOS_MS5611_ReadADC();
-
-#ifdef PIOS_MS5611_SLOW_TEMP_RATE
-        temp_press_interleave_count = PIOS_MS5611_SLOW_TEMP_RATE;
     }
-#endif
+}
 
-        // Update the pressure data
-        PIOS_MS5611_StartADC(PressureConv);
-        vTaskDelay(PIOS_MS5611_GetDelay());
-        PIOS_MS5611_ReadADC();
+/**
+ * Called by the MS5611 driver after each completed conversion, from the
+ * altitude task context. Temperature conversions feed the bias filter,
+ * pressure conversions are accumulated and published.
+ */
+static void baroConversionCallback(ConversionTypeTypeDef type)
+{
+    float temp, press;
 
-        temp  = PIOS_MS5611_GetTemperature();
-        press = PIOS_MS5611_GetPressure();
+    if (type == TemperatureConv) {
+        temp = PIOS_MS5611_GetTemperature();
 
         if (isnan(baro_temperature)) {
             baro_temperature = temp;
@@ -193,18 +202,28 @@ static void altitudeTask(__attribute__((unused)) void *parameters)
             float ctemp = boundf(baro_temperature, baroCorrectionExtent.max, baroCorrectionExtent.min);
             baro_temp_bias = baroCorrection.a + ((baroCorrection.d * ctemp + baroCorrection.c) * ctemp + baroCorrection.b) * ctemp;
         }
+        return;
+    }
 
-        press -= baro_temp_bias;
-
-        float altitude = 44330.0f * (1.0f - powf((press) / MS5611_P0, (1.0f / 5.255f)));
+    temp = PIOS_MS5611_GetTemperature();
+    press_accumulator += PIOS_MS5611_GetPressure() - baro_temp_bias;
 
-        if (!isnan(altitude)) {
-            data.Altitude    = altitude;
-            data.Temperature = temp;
-            data.Pressure    = press;
-            // Update the BasoSensor UAVObject
-            BaroSensorSet(&data);
-        }
+    if (--press_decimate_count > 0) {
+        return;
+    }
+    press_decimate_count = PRESS_DECIMATE;
+    press = press_accumulator / PRESS_DECIMATE;
+    press_accumulator    = 0.0f;
+
+    float altitude = 44330.0f * (1.0f - powf((press) / MS5611_P0, (1.0f / 5.255f)));
+
+    if (!isnan(altitude)) {
+        BaroSensorData data;
+        data.Altitude    = altitude;
+        data.Temperature = temp;
+        data.Pressure    = press;
+        // Update the BasoSensor UAVObject
+        BaroSensorSet(&data);
     }
 }
 
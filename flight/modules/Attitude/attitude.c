@@ -698,7 +698,7 @@ __attribute__((optimize("O3"))) static void updateAttitude(AccelStateData *accel
     quat_copy(q, &attitudeState.q1);
 
     // Convert into eueler degrees (makes assumptions about RPY order)
-    Quaternion2RPY(&attitudeState.q1, &attitudeState.Roll);
+    Quaternion2RPYFast(&attitudeState.q1, &attitudeState.Roll);
 
     AttitudeStateSet(&attitudeState);
 }
@@ -60,10 +60,20 @@
 #include "stabilizationsettings.h"
 #include "taskinfo.h"
 
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+#include "gyrostate.h"
+#include "fft_ident.h"
+#endif
+
 // Private constants
 #define STACK_SIZE_BYTES 1024
 #define TASK_PRIORITY    (tskIDLE_PRIORITY + 2)
 
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+// The task loop samples the gyro every 10 ms
+#define FFT_IDENT_SAMPLE_RATE 100.0f
+#endif
+
 // Private types
 enum AUTOTUNE_STATE { AT_INIT, AT_START, AT_ROLL, AT_PITCH, AT_FINISHED, AT_SET };
 
@@ -75,6 +85,43 @@ static bool autotuneEnabled;
 static void AutotuneTask(void *parameters);
 static void update_stabilization_settings();
 
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+static float fft_window[FFT_IDENT_WINDOW_SIZE];
+static uint16_t fft_sample_count;
+
+/**
+ * Accumulate gyro samples for the given axis (0 = roll, 1 = pitch) and
+ * run the FFT identification once the window is full.
+ * \returns true when the axis result has been written to @ref RelayTuning
+ */
+static bool fft_ident_capture(uint8_t axis)
+{
+    GyroStateData gyros;
+
+    GyroStateGet(&gyros);
+    fft_window[fft_sample_count++] = (axis == 0) ? gyros.x : gyros.y;
+    if (fft_sample_count < FFT_IDENT_WINDOW_SIZE) {
+        return false;
+    }
+    fft_sample_count = 0;
+
+    struct fft_ident_result ident;
+    if (fft_ident_analyse(fft_window, FFT_IDENT_SAMPLE_RATE, &ident) != 0
+        || ident.frequency <= 0.0f) {
+        // No clear oscillation yet, keep exciting and try the next window
+        return false;
+    }
+
+    RelayTuningData relayTuning;
+    RelayTuningGet(&relayTuning);
+    relayTuning.Period[axis] = 1000.0f / ident.frequency; // ms, as the relay measurement reported it
+    relayTuning.Gain[axis]   = ident.amplitude;
+    RelayTuningSet(&relayTuning);
+
+    return true;
+}
+#endif /* PIOS_AUTOTUNE_USE_CMSIS_FFT */
+
 /**
  * Initialise the module, called on startup
  * \returns 0 on success or -1 if initialisation failed
@@ -97,6 +144,10 @@ int32_t AutotuneInitialize(void)
     }
 #endif
 
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+    GyroStateInitialize();
+#endif
+
     return 0;
 }
 
@@ -205,6 +256,9 @@ static void AutotuneTask(__attribute__((unused)) void *parameters)
             if (diffTime > PREPARE_TIME) {
                 state = AT_ROLL;
                 lastUpdateTime = xTaskGetTickCount();
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+                fft_sample_count = 0;
+#endif
             }
             break;
 
@@ -215,9 +269,22 @@ static void AutotuneTask(__attribute__((unused)) void *parameters)
             // Run relay mode on the roll axis for the measurement time
             stabDesired.StabilizationMode[STABILIZATIONDESIRED_STABILIZATIONMODE_ROLL] = rate ? STABILIZATIONDESIRED_STABILIZATIONMODE_RELAYRATE :
                                                                                          STABILIZATIONDESIRED_STABILIZATIONMODE_RELAYATTITUDE;
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+            // A short captured burst identified over the FFT replaces the
+            // long zero-crossing measurement
+            if (fft_ident_capture(0)) {
+                state = AT_PITCH;
+                lastUpdateTime = xTaskGetTickCount();
+                fft_sample_count = 0;
+                break;
+            }
+#endif
             if (diffTime > MEAURE_TIME) { // Move on to next state
                 state = AT_PITCH;
                 lastUpdateTime = xTaskGetTickCount();
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+                fft_sample_count = 0;
+#endif
             }
             break;
 
@@ -228,6 +295,13 @@ static void AutotuneTask(__attribute__((unused)) void *parameters)
             // Run relay mode on the pitch axis for the measurement time
             stabDesired.StabilizationMode[STABILIZATIONDESIRED_STABILIZATIONMODE_PITCH] = rate ? STABILIZATIONDESIRED_STABILIZATIONMODE_RELAYRATE :
                                                                                           STABILIZATIONDESIRED_STABILIZATIONMODE_RELAYATTITUDE;
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+            if (fft_ident_capture(1)) {
+                state = AT_FINISHED;
+                lastUpdateTime = xTaskGetTickCount();
+                break;
+            }
+#endif
             if (diffTime > MEAURE_TIME) { // Move on to next state
                 state = AT_FINISHED;
                 lastUpdateTime = xTaskGetTickCount();
@@ -0,0 +1,122 @@
+/**
+ ******************************************************************************
+ * @addtogroup OpenPilotModules OpenPilot Modules
+ * @{
+ * @addtogroup Autotuning module
+ * @{
+ *
+ * @file       fft_ident.c
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @brief      FFT based identification of the relay oscillation
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "fft_ident.h"
+
+#ifdef PIOS_AUTOTUNE_USE_CMSIS_FFT
+
+#include <arm_math.h>
+
+static arm_rfft_fast_instance_f32 rfft_instance;
+static bool rfft_initialized;
+
+// Spectrum scratch space, interleaved re/im pairs from the rfft
+static float32_t fft_work[FFT_IDENT_WINDOW_SIZE];
+
+int32_t fft_ident_analyse(float *samples, float sample_rate, struct fft_ident_result *result)
+{
+    const uint32_t n = FFT_IDENT_WINDOW_SIZE;
+
+    if (!rfft_initialized) {
+        if (arm_rfft_fast_init_f32(&rfft_instance, n) != ARM_MATH_SUCCESS) {
+            return -1;
+        }
+        rfft_initialized = true;
+    }
+
+    // Remove the mean so the relay offset does not leak into the low bins,
+    // then apply a Hann window to contain spectral leakage
+    float32_t mean;
+    arm_mean_f32(samples, n, &mean);
+    for (uint32_t i = 0; i < n; i++) {
+        float w = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * (float)i / (float)(n - 1));
+        samples[i] = (samples[i] - mean) * w;
+    }
+
+    arm_rfft_fast_f32(&rfft_instance, samples, fft_work, 0);
+
+    // Find the strongest bin, skipping DC (fft_work[0]) and the packed
+    // Nyquist term (fft_work[1])
+    float peak_mag2   = 0.0f;
+    uint32_t peak_bin = 0;
+    for (uint32_t k = 1; k < n / 2; k++) {
+        float re   = fft_work[2 * k];
+        float im   = fft_work[2 * k + 1];
+        float mag2 = re * re + im * im;
+        if (mag2 > peak_mag2) {
+            peak_mag2 = mag2;
+            peak_bin  = k;
+        }
+    }
+    if (peak_bin == 0 || peak_mag2 <= 0.0f) {
+        // nothing oscillating yet
+        return -2;
+    }
+
+    // Refine the frequency below bin resolution by fitting a parabola
+    // through the peak and its neighbours
+    float delta = 0.0f;
+    if (peak_bin > 1 && peak_bin < n / 2 - 1) {
+        float m0 = sqrtf(fft_work[2 * (peak_bin - 1)] * fft_work[2 * (peak_bin - 1)]
+                         + fft_work[2 * (peak_bin - 1) + 1] * fft_work[2 * (peak_bin - 1) + 1]);
+        float m1 = sqrtf(peak_mag2);
+        float m2 = sqrtf(fft_work[2 * (peak_bin + 1)] * fft_work[2 * (peak_bin + 1)]
+                         + fft_work[2 * (peak_bin + 1) + 1] * fft_work[2 * (peak_bin + 1) + 1]);
+        float denom = m0 - 2.0f * m1 + m2;
+        if (fabsf(denom) > 1e-6f) {
+            delta = 0.5f * (m0 - m2) / denom;
+        }
+    }
+
+    result->frequency = ((float)peak_bin + delta) * sample_rate / (float)n;
+    // single sided amplitude, compensating the Hann coherent gain of 0.5
+    result->amplitude = sqrtf(peak_mag2) * 4.0f / (float)n;
+    result->phase     = atan2f(fft_work[2 * peak_bin + 1], fft_work[2 * peak_bin]);
+
+    return 0;
+}
+
+#else /* PIOS_AUTOTUNE_USE_CMSIS_FFT */
+
+int32_t fft_ident_analyse(__attribute__((unused)) float *samples,
+                          __attribute__((unused)) float sample_rate,
+                          __attribute__((unused)) struct fft_ident_result *result)
+{
+    // No DSP library on this target, the caller falls back to the
+    // full length relay measurement
+    return -1;
+}
+
+#endif /* PIOS_AUTOTUNE_USE_CMSIS_FFT */
+
+/**
+ * @}
+ * @}
+ */
@@ -0,0 +1,53 @@
+/**
+ ******************************************************************************
+ * @addtogroup OpenPilotModules OpenPilot Modules
+ * @{
+ * @addtogroup Autotuning module
+ * @{
+ *
+ * @file       fft_ident.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @brief      FFT based identification of the relay oscillation
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef FFT_IDENT_H
+#define FFT_IDENT_H
+
+#include "openpilot.h"
+
+// Number of gyro samples analysed per identification burst.  Must be a
+// power of two supported by the CMSIS rfft kernels.
+#define FFT_IDENT_WINDOW_SIZE 256
+
+struct fft_ident_result {
+    float frequency; // dominant oscillation frequency (Hz)
+    float amplitude; // oscillation amplitude at that frequency (input units)
+    float phase;     // phase of the dominant bin at the window start (rad)
+};
+
+/**
+ * Identify the dominant oscillation in a captured gyro window.
+ * The samples are windowed in place, so the buffer is consumed.
+ * \returns 0 on success, negative when no clear oscillation was found or
+ *          the FFT backend is not compiled in
+ */
+int32_t fft_ident_analyse(float *samples, float sample_rate, struct fft_ident_result *result);
+
+#endif // FFT_IDENT_H
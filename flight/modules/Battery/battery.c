@@ -160,9 +160,30 @@ static void onTimer(__attribute__((unused)) UAVObjEvent *ev)
 
     // For safety reasons consider only positive currents in energy comsumption, i.e. no charging up.
     // necesary when sensor are not perfectly calibrated
+#ifdef PIOS_ADC_PROVIDES_COULOMB_COUNTER
+    // The ADC DMA engine sums every raw sample it takes at a fixed hardware
+    // rate, so the mean over the measured elapsed time integrates exactly
+    // even when this callback jitters or is delayed.
+    static portTickType lastCoulombTime;
+    portTickType coulombTime = xTaskGetTickCount();
+    uint64_t rawSum;
+    uint32_t rawCount;
+    if (currentADCPin >= 0 && flightBatteryData.Voltage > 0.f
+        && PIOS_ADC_PinGetAccumulator(currentADCPin, &rawSum, &rawCount) == 0
+        && rawCount > 0 && lastCoulombTime != 0) {
+        float meanCurrent = (((float)rawSum / (float)rawCount) * PIOS_ADC_VOLTAGE_SCALE
+                             - batterySettings.SensorCalibrations.CurrentZero) * batterySettings.SensorCalibrations.CurrentFactor; // in Amps
+        float elapsed     = (float)(coulombTime - lastCoulombTime) * portTICK_RATE_MS / 1000.0f; // in Sec
+        if (meanCurrent > 0) {
+            flightBatteryData.ConsumedEnergy += (meanCurrent * elapsed * 1000.0f / 3600.0f); // in mAh
+        }
+    }
+    lastCoulombTime = coulombTime;
+#else
     if (flightBatteryData.Current > 0) {
         flightBatteryData.ConsumedEnergy += (flightBatteryData.Current * dT * 1000.0f / 3600.0f); // in mAh
     }
+#endif /* PIOS_ADC_PROVIDES_COULOMB_COUNTER */
 
     // Apply a 2 second rise time low-pass filter to average the current
     float alpha = 1.0f - dT / (dT + 2.0f);
@@ -49,6 +49,7 @@
 
 #include "accessorydesired.h"
 #include "attitudestate.h"
+#include "gyrostate.h"
 #include "camerastabsettings.h"
 #include "cameradesired.h"
 #include "hwsettings.h"
@@ -74,10 +75,18 @@ static struct CameraStab_data {
     float ffLastAttitudeFiltered[CAMERASTABSETTINGS_INPUT_NUMELEM];
     float ffFilterAccumulator[CAMERASTABSETTINGS_INPUT_NUMELEM];
 #endif
+
+    // gyro feed-forward fast path, updated on every GyroState sample
+    float    baseOutput[CAMERASTABSETTINGS_INPUT_NUMELEM];     // last output of the attitude path
+    float    baseOutputRange[CAMERASTABSETTINGS_INPUT_NUMELEM]; // output range cached for the fast path
+    float    gyroCorrection[CAMERASTABSETTINGS_INPUT_NUMELEM]; // integrated body rates since that output
+    uint32_t lastGyroTime;
+    bool     gyroFeedForward;
 } *csd;
 
 // Private functions
 static void attitudeUpdated(UAVObjEvent *ev);
+static void gyroUpdated(UAVObjEvent *ev);
 
 #ifdef USE_GIMBAL_FF
 static void applyFeedForward(uint8_t index, float dT, float *attitude, CameraStabSettingsData *cameraStab);
@@ -119,6 +128,7 @@ int32_t CameraStabInitialize(void)
         csd->lastSysTime = xTaskGetTickCount();
 
         AttitudeStateInitialize();
+        GyroStateInitialize();
         CameraStabSettingsInitialize();
         CameraDesiredInitialize();
 
@@ -130,6 +140,10 @@ int32_t CameraStabInitialize(void)
         };
         EventPeriodicCallbackCreate(&ev, attitudeUpdated, SAMPLE_PERIOD_MS / portTICK_RATE_MS);
 
+        // fast path correction on every gyro sample, bails out cheaply unless
+        // enabled in the settings (cached by the attitude path)
+        GyroStateConnectCallback(&gyroUpdated);
+
         return 0;
     }
 
@@ -168,6 +182,12 @@ static void attitudeUpdated(UAVObjEvent *ev)
     // so we init it or turn the warning/error off for each compiler
     float elevon_roll = 0.0f;
 
+    // refresh the fast path cache; elevon mixing is left to the attitude
+    // path alone since its outputs are not per-axis
+    csd->gyroFeedForward = (cameraStab.GyroFeedForward == CAMERASTABSETTINGS_GYROFEEDFORWARD_TRUE)
+                           && (cameraStab.GimbalType != CAMERASTABSETTINGS_GIMBALTYPE_ROLLPITCHMIXED);
+    csd->lastGyroTime    = PIOS_DELAY_GetRaw();
+
     // process axes
     for (uint8_t i = 0; i < CAMERASTABSETTINGS_INPUT_NUMELEM; i++) {
         // read and process control input
@@ -230,6 +250,11 @@ static void attitudeUpdated(UAVObjEvent *ev)
         // of both the unmixed pitch and unmixed roll
         float output = boundf((attitude + csd->inputs[i]) / CameraStabSettingsOutputRangeToArray(cameraStab.OutputRange)[i], -1.0f, 1.0f);
 
+        // the attitude path output becomes the new baseline for the fast path
+        csd->baseOutput[i]      = output;
+        csd->baseOutputRange[i] = (float)CameraStabSettingsOutputRangeToArray(cameraStab.OutputRange)[i];
+        csd->gyroCorrection[i]  = 0.0f;
+
         // set output channels
         switch (i) {
         case CAMERASTABSETTINGS_INPUT_ROLL:
@@ -281,6 +306,55 @@ static void attitudeUpdated(UAVObjEvent *ev)
     }
 }
 
+/**
+ * Feed-forward fast path, called on every GyroState update.  Body rates
+ * integrated since the last attitude path output approximate how far the
+ * airframe has rotated away from it, so the correction reaches the servos
+ * a full gyro sample after the motion instead of a scheduling period
+ * later.  The attitude path keeps absorbing the small angle error this
+ * approximation leaves behind.
+ */
+static void gyroUpdated(UAVObjEvent *ev)
+{
+    if (ev->obj != GyroStateHandle() || !csd->gyroFeedForward) {
+        return;
+    }
+
+    GyroStateData gyros;
+    GyroStateGet(&gyros);
+
+    float dT = PIOS_DELAY_DiffuS(csd->lastGyroTime) * 1.0e-6f;
+    csd->lastGyroTime = PIOS_DELAY_GetRaw();
+    if (dT <= 0.0f || dT > (float)SAMPLE_PERIOD_MS * 0.001f) {
+        // stale timestamp right after enabling, skip this sample
+        return;
+    }
+
+    csd->gyroCorrection[CAMERASTABSETTINGS_INPUT_ROLL]  += gyros.x * dT;
+    csd->gyroCorrection[CAMERASTABSETTINGS_INPUT_PITCH] += gyros.y * dT;
+    csd->gyroCorrection[CAMERASTABSETTINGS_INPUT_YAW]   += gyros.z * dT;
+
+    for (uint8_t i = 0; i < CAMERASTABSETTINGS_INPUT_NUMELEM; i++) {
+        if (csd->baseOutputRange[i] < 1.0f) {
+            continue;
+        }
+        float output = boundf(csd->baseOutput[i] + csd->gyroCorrection[i] / csd->baseOutputRange[i], -1.0f, 1.0f);
+        switch (i) {
+        case CAMERASTABSETTINGS_INPUT_ROLL:
+            CameraDesiredRollOrServo1Set(&output);
+            break;
+        case CAMERASTABSETTINGS_INPUT_PITCH:
+            CameraDesiredPitchOrServo2Set(&output);
+            break;
+        case CAMERASTABSETTINGS_INPUT_YAW:
+            CameraDesiredYawSet(&output);
+            break;
+        default:
+            PIOS_Assert(0);
+        }
+    }
+}
+
 #ifdef USE_GIMBAL_FF
 void applyFeedForward(uint8_t index, float dT_millis, float *attitude, CameraStabSettingsData *cameraStab)
 {
@@ -175,30 +175,41 @@ static void updateSettings(__attribute__((unused)) UAVObjEvent *ev)
         // Retrieve settings
         uint8_t speed;
         HwSettingsComUsbBridgeSpeedGet(&speed);
+        uint32_t baud = 0;
 
-        // Set port speed
         switch (speed) {
         case HWSETTINGS_COMUSBBRIDGESPEED_2400:
-            PIOS_COM_ChangeBaud(usart_port, 2400);
+            baud = 2400;
             break;
         case HWSETTINGS_COMUSBBRIDGESPEED_4800:
-            PIOS_COM_ChangeBaud(usart_port, 4800);
+            baud = 4800;
             break;
         case HWSETTINGS_COMUSBBRIDGESPEED_9600:
-            PIOS_COM_ChangeBaud(usart_port, 9600);
+            baud = 9600;
             break;
         case HWSETTINGS_COMUSBBRIDGESPEED_19200:
-            PIOS_COM_ChangeBaud(usart_port, 19200);
+            baud = 19200;
             break;
         case HWSETTINGS_COMUSBBRIDGESPEED_38400:
-            PIOS_COM_ChangeBaud(usart_port, 38400);
+            baud = 38400;
             break;
         case HWSETTINGS_COMUSBBRIDGESPEED_57600:
-            PIOS_COM_ChangeBaud(usart_port, 57600);
+            baud = 57600;
             break;
         case HWSETTINGS_COMUSBBRIDGESPEED_115200:
-            PIOS_COM_ChangeBaud(usart_port, 115200);
+            baud = 115200;
             break;
         }
+
+        if (baud) {
+            // Set port speed
+            PIOS_COM_ChangeBaud(usart_port, baud);
+#ifdef PIOS_INCLUDE_COM_STATS
+            // Shape usb -> com to the wire rate (10 bits per byte at 8N1) so a
+            // VCP burst the usart cannot carry is dropped and counted in
+            // ComStats instead of stalling the bridge task on a full fifo
+            PIOS_COM_SetTxRateLimit(usart_port, baud / 10);
+#endif
+        }
     }
 }
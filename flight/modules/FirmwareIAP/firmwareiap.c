@@ -144,12 +144,13 @@ static void FirmwareIAPCallback(UAVObjEvent *ev)
         this_time = get_time();
         delta     = this_time - last_time;
         last_time = this_time;
-        if ((data.BoardType == bdinfo->board_type) && (data.crc != PIOS_BL_HELPER_CRC_Memory_Calc())) {
+        uint32_t fw_crc = PIOS_BL_HELPER_CRC_Memory_Calc();
+        if ((data.BoardType == bdinfo->board_type) && (data.crc != fw_crc)) {
             PIOS_BL_HELPER_FLASH_Read_Description(data.Description, FIRMWAREIAPOBJ_DESCRIPTION_NUMELEM);
             PIOS_SYS_SerialNumberGetBinary(data.CPUSerial);
             data.BoardRevision = bdinfo->board_rev;
             data.BootloaderRevision = bdinfo->bl_rev;
-            data.crc = PIOS_BL_HELPER_CRC_Memory_Calc();
+            data.crc = fw_crc;
             FirmwareIAPObjSet(&data);
         }
         if ((data.ArmReset == 1) && (iap_state != IAP_STATE_RESETTING)) {
@@ -92,7 +92,8 @@ int32_t FlightPlanInitialize()
 
     return 0;
 }
-MODULE_INITCALL(FlightPlanInitialize, FlightPlanStart);
+// Starting the PyMite VM is slow and not needed to arm
+MODULE_INITCALL_DEFERRED(FlightPlanInitialize, FlightPlanStart);
 /**
  * Module task
  */
@@ -38,7 +38,6 @@
 #include "gpssatellites.h"
 #include "gpsvelocitysensor.h"
 #include "gpssettings.h"
-#include "taskinfo.h"
 #include "hwsettings.h"
 #include "auxmagsensor.h"
 #include "WorldMagModel.h"
@@ -59,7 +58,8 @@ PERF_DEFINE_COUNTER(counterParse);
 // ****************
 // Private functions
 
-static void gpsTask(void *parameters);
+static void gpsCallback(void);
+static void gpsRxNotify(uint32_t context, bool *task_woken);
 static void updateHwSettings();
 
 #ifdef PIOS_GPS_SETS_HOMELOCATION
@@ -90,18 +90,14 @@ void updateGpsSettings(UAVObjEvent *ev);
         #define STACK_SIZE_BYTES   1024
 #else
 #if defined(PIOS_GPS_MINIMAL)
-        #define GPS_READ_BUFFER    32
         #define STACK_SIZE_BYTES   500
 #else
         #define STACK_SIZE_BYTES   650
 #endif // PIOS_GPS_MINIMAL
 #endif // PIOS_GPS_SETS_HOMELOCATION
 
-#ifndef GPS_READ_BUFFER
-#define GPS_READ_BUFFER            128
-#endif
-
-#define TASK_PRIORITY              (tskIDLE_PRIORITY + 1)
+#define CALLBACK_PRIORITY          CALLBACK_PRIORITY_REGULAR
+#define CBTASK_PRIORITY            CALLBACK_TASK_AUXILIARY
 
 // ****************
 // Private variables
@@ -109,10 +105,13 @@ void updateGpsSettings(UAVObjEvent *ev);
 static uint32_t gpsPort;
 static bool gpsEnabled = false;
 
-static xTaskHandle gpsTaskHandle;
+static DelayedCallbackInfo *gpsCallbackHandle;
 
 static char *gps_rx_buffer;
 
+static GPSPositionSensorData gpspositionsensor;
+static GPSSettingsData gpsSettings;
+
 static uint32_t timeOfLastCommandMs;
 static uint32_t timeOfLastUpdateMs;
 
@@ -131,9 +130,28 @@ int32_t GPSStart(void)
 {
     if (gpsEnabled) {
         if (gpsPort) {
-            // Start gps task
-            xTaskCreate(gpsTask, "GPS", STACK_SIZE_BYTES / 4, NULL, TASK_PRIORITY, &gpsTaskHandle);
-            PIOS_TASK_MONITOR_RegisterTask(TASKINFO_RUNNING_GPS, gpsTaskHandle);
+            uint32_t timeNowMs = xTaskGetTickCount() * portTICK_RATE_MS;
+
+            timeOfLastUpdateMs  = timeNowMs;
+            timeOfLastCommandMs = timeNowMs;
+
+            GPSSettingsGet(&gpsSettings);
+            GPSPositionSensorGet(&gpspositionsensor);
+#if defined(PIOS_INCLUDE_GPS_UBX_PARSER) && !defined(PIOS_GPS_MINIMAL)
+            updateGpsSettings(0);
+#endif
+
+            PERF_INIT_COUNTER(counterBytesIn, 0x97510001);
+            PERF_INIT_COUNTER(counterRate, 0x97510002);
+            PERF_INIT_COUNTER(counterParse, 0x97510003);
+
+            // No dedicated task: the callback is dispatched whenever the
+            // com layer delivers a span and rescheduled on a short period
+            // for autoconfig and timeout handling
+            gpsCallbackHandle = PIOS_CALLBACKSCHEDULER_Create(&gpsCallback, CALLBACK_PRIORITY, CBTASK_PRIORITY, -1, STACK_SIZE_BYTES);
+            PIOS_Assert(gpsCallbackHandle);
+            PIOS_COM_RegisterRxNotify(gpsPort, gpsRxNotify, 0);
+            PIOS_CALLBACKSCHEDULER_Schedule(gpsCallbackHandle, GPS_LOOP_DELAY_MS, CALLBACK_UPDATEMODE_SOONER);
             return 0;
         }
     }
@@ -222,145 +240,143 @@ int32_t GPSInitialize(void)
     return -1;
 }
 
-MODULE_INITCALL(GPSInitialize, GPSStart);
+// GPS setup (including ubx autoconfig) is slow and not needed to arm
+MODULE_INITCALL_DEFERRED(GPSInitialize, GPSStart);
 
 // ****************
 /**
- * Main gps task. It does not return.
+ * Notification from the com layer, called in the rx delivery context
+ * (usually an ISR) when a span has been added to the receive fifo.
  */
-
-static void gpsTask(__attribute__((unused)) void *parameters)
+static void gpsRxNotify(__attribute__((unused)) uint32_t context, bool *task_woken)
 {
-    portTickType xDelay = 100 / portTICK_RATE_MS;
-    uint32_t timeNowMs  = xTaskGetTickCount() * portTICK_RATE_MS;
-
-#ifdef PIOS_GPS_SETS_HOMELOCATION
-    portTickType homelocationSetDelay = 0;
-#endif
-    GPSPositionSensorData gpspositionsensor;
-    GPSSettingsData gpsSettings;
+    long xHigherPriorityTaskWoken = pdFALSE;
 
-    GPSSettingsGet(&gpsSettings);
+    PIOS_CALLBACKSCHEDULER_DispatchFromISR(gpsCallbackHandle, &xHigherPriorityTaskWoken);
+    *task_woken = (xHigherPriorityTaskWoken == pdTRUE);
+}
 
-    timeOfLastUpdateMs  = timeNowMs;
-    timeOfLastCommandMs = timeNowMs;
+/**
+ * Main gps worker.  Dispatched by gpsRxNotify whenever the com layer
+ * delivers a span and rescheduled on a short period to run the ubx
+ * autoconfig state machine and the receive timeout check, replacing the
+ * dedicated gps task and its stack.
+ */
+static void gpsCallback(void)
+{
+    uint32_t timeNowMs = xTaskGetTickCount() * portTICK_RATE_MS;
 
-    GPSPositionSensorGet(&gpspositionsensor);
-#if defined(PIOS_INCLUDE_GPS_UBX_PARSER) && !defined(PIOS_GPS_MINIMAL)
-    updateGpsSettings(0);
+#ifdef PIOS_GPS_SETS_HOMELOCATION
+    static portTickType homelocationSetDelay = 0;
 #endif
+    uint8_t *c;
 
-    TickType_t xLastWakeTime;
-    xLastWakeTime = xTaskGetTickCount();
-    PERF_INIT_COUNTER(counterBytesIn, 0x97510001);
-    PERF_INIT_COUNTER(counterRate, 0x97510002);
-    PERF_INIT_COUNTER(counterParse, 0x97510003);
-    uint8_t c[GPS_READ_BUFFER];
-
-    // Loop forever
-    while (1) {
 #if defined(PIOS_INCLUDE_GPS_UBX_PARSER) && !defined(PIOS_GPS_MINIMAL)
-        if (gpsSettings.DataProtocol == GPSSETTINGS_DATAPROTOCOL_UBX) {
-            char *buffer   = 0;
-            uint16_t count = 0;
-            uint8_t status;
-            GPSPositionSensorStatusGet(&status);
-            ubx_autoconfig_run(&buffer, &count, status != GPSPOSITIONSENSOR_STATUS_NOGPS);
-            // Something to send?
-            if (count) {
-                PIOS_COM_SendBuffer(gpsPort, (uint8_t *)buffer, count);
-            }
+    if (gpsSettings.DataProtocol == GPSSETTINGS_DATAPROTOCOL_UBX) {
+        char *buffer   = 0;
+        uint16_t count = 0;
+        uint8_t status;
+        GPSPositionSensorStatusGet(&status);
+        ubx_autoconfig_run(&buffer, &count, status != GPSPOSITIONSENSOR_STATUS_NOGPS);
+        // Something to send?
+        if (count) {
+            PIOS_COM_SendBuffer(gpsPort, (uint8_t *)buffer, count);
         }
+    }
 #endif
-        // This blocks the task until there is something on the buffer
-        uint16_t cnt;
-        while ((cnt = PIOS_COM_ReceiveBuffer(gpsPort, c, GPS_READ_BUFFER, xDelay)) > 0) {
-            PERF_TIMED_SECTION_START(counterParse);
-            PERF_TRACK_VALUE(counterBytesIn, cnt);
-            PERF_MEASURE_PERIOD(counterRate);
-            int res;
-            switch (gpsSettings.DataProtocol) {
+    // Drain whatever has accumulated since the last run without blocking;
+    // the parsers scan the receive fifo in place and only copy completed payloads
+    uint16_t cnt;
+    while ((cnt = PIOS_COM_ReceiveBufferPeek(gpsPort, &c, 0)) > 0) {
+        PERF_TIMED_SECTION_START(counterParse);
+        PERF_TRACK_VALUE(counterBytesIn, cnt);
+        PERF_MEASURE_PERIOD(counterRate);
+        int res;
+        switch (gpsSettings.DataProtocol) {
 #if defined(PIOS_INCLUDE_GPS_NMEA_PARSER)
-            case GPSSETTINGS_DATAPROTOCOL_NMEA:
-                res = parse_nmea_stream(c, cnt, gps_rx_buffer, &gpspositionsensor, &gpsRxStats);
-                break;
+        case GPSSETTINGS_DATAPROTOCOL_NMEA:
+            res = parse_nmea_stream(c, cnt, gps_rx_buffer, &gpspositionsensor, &gpsRxStats);
+            break;
 #endif
 #if defined(PIOS_INCLUDE_GPS_UBX_PARSER)
-            case GPSSETTINGS_DATAPROTOCOL_UBX:
-            {
+        case GPSSETTINGS_DATAPROTOCOL_UBX:
+        {
 #if defined(PIOS_INCLUDE_GPS_UBX_PARSER) && !defined(PIOS_GPS_MINIMAL)
-                int32_t ac_status = ubx_autoconfig_get_status();
-                static uint8_t lastStatus = 0;
-
-                gpspositionsensor.AutoConfigStatus =
-                    ac_status == UBX_AUTOCONFIG_STATUS_DISABLED ? GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_DISABLED :
-                    ac_status == UBX_AUTOCONFIG_STATUS_DONE ? GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_DONE :
-                    ac_status == UBX_AUTOCONFIG_STATUS_ERROR ? GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_ERROR :
-                    GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_RUNNING;
-                if (gpspositionsensor.AutoConfigStatus != lastStatus) {
-                    GPSPositionSensorAutoConfigStatusSet(&gpspositionsensor.AutoConfigStatus);
-                    lastStatus = gpspositionsensor.AutoConfigStatus;
-                }
-#endif
-                res = parse_ubx_stream(c, cnt, gps_rx_buffer, &gpspositionsensor, &gpsRxStats);
+            int32_t ac_status = ubx_autoconfig_get_status();
+            static uint8_t lastStatus = 0;
+
+            gpspositionsensor.AutoConfigStatus =
+                ac_status == UBX_AUTOCONFIG_STATUS_DISABLED ? GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_DISABLED :
+                ac_status == UBX_AUTOCONFIG_STATUS_DONE ? GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_DONE :
+                ac_status == UBX_AUTOCONFIG_STATUS_ERROR ? GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_ERROR :
+                GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_RUNNING;
+            if (gpspositionsensor.AutoConfigStatus != lastStatus) {
+                GPSPositionSensorAutoConfigStatusSet(&gpspositionsensor.AutoConfigStatus);
+                lastStatus = gpspositionsensor.AutoConfigStatus;
             }
-            break;
 #endif
-            default:
-                res = NO_PARSER; // this should not happen
-                break;
-            }
+            res = parse_ubx_stream(c, cnt, gps_rx_buffer, &gpspositionsensor, &gpsRxStats);
+        }
+        break;
+#endif
+        default:
+            res = NO_PARSER; // this should not happen
+            break;
+        }
 
-            PERF_TIMED_SECTION_END(counterParse);
-            if (res == PARSER_COMPLETE) {
-                timeNowMs = xTaskGetTickCount() * portTICK_RATE_MS;
-                timeOfLastUpdateMs = timeNowMs;
-                timeOfLastCommandMs = timeNowMs;
-            }
+        PERF_TIMED_SECTION_END(counterParse);
+        PIOS_COM_ReceiveBufferConsume(gpsPort, cnt);
+        if (res == PARSER_COMPLETE) {
+            timeNowMs = xTaskGetTickCount() * portTICK_RATE_MS;
+            timeOfLastUpdateMs = timeNowMs;
+            timeOfLastCommandMs = timeNowMs;
         }
+    }
 
-        // Check for GPS timeout
-        timeNowMs = xTaskGetTickCount() * portTICK_RATE_MS;
-        if ((timeNowMs - timeOfLastUpdateMs) >= GPS_TIMEOUT_MS ||
-            (gpsSettings.DataProtocol == GPSSETTINGS_DATAPROTOCOL_UBX && gpspositionsensor.AutoConfigStatus == GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_ERROR)) {
-            // we have not received any valid GPS sentences for a while.
-            // either the GPS is not plugged in or a hardware problem or the GPS has locked up.
-            uint8_t status = GPSPOSITIONSENSOR_STATUS_NOGPS;
-            GPSPositionSensorStatusSet(&status);
-            AlarmsSet(SYSTEMALARMS_ALARM_GPS, SYSTEMALARMS_ALARM_ERROR);
-        } else {
-            // we appear to be receiving GPS sentences OK, we've had an update
-            // criteria for GPS-OK taken from this post...
-            // http://forums.openpilot.org/topic/1523-professors-insgps-in-svn/page__view__findpost__p__5220
-            if ((gpspositionsensor.PDOP < gpsSettings.MaxPDOP) && (gpspositionsensor.Satellites >= gpsSettings.MinSatellites) &&
-                (gpspositionsensor.Status == GPSPOSITIONSENSOR_STATUS_FIX3D) &&
-                (gpspositionsensor.Latitude != 0 || gpspositionsensor.Longitude != 0)) {
-                AlarmsClear(SYSTEMALARMS_ALARM_GPS);
+    // Check for GPS timeout
+    timeNowMs = xTaskGetTickCount() * portTICK_RATE_MS;
+    if ((timeNowMs - timeOfLastUpdateMs) >= GPS_TIMEOUT_MS ||
+        (gpsSettings.DataProtocol == GPSSETTINGS_DATAPROTOCOL_UBX && gpspositionsensor.AutoConfigStatus == GPSPOSITIONSENSOR_AUTOCONFIGSTATUS_ERROR)) {
+        // we have not received any valid GPS sentences for a while.
+        // either the GPS is not plugged in or a hardware problem or the GPS has locked up.
+        uint8_t status = GPSPOSITIONSENSOR_STATUS_NOGPS;
+        GPSPositionSensorStatusSet(&status);
+        AlarmsSet(SYSTEMALARMS_ALARM_GPS, SYSTEMALARMS_ALARM_ERROR);
+    } else {
+        // we appear to be receiving GPS sentences OK, we've had an update
+        // criteria for GPS-OK taken from this post...
+        // http://forums.openpilot.org/topic/1523-professors-insgps-in-svn/page__view__findpost__p__5220
+        if ((gpspositionsensor.PDOP < gpsSettings.MaxPDOP) && (gpspositionsensor.Satellites >= gpsSettings.MinSatellites) &&
+            (gpspositionsensor.Status == GPSPOSITIONSENSOR_STATUS_FIX3D) &&
+            (gpspositionsensor.Latitude != 0 || gpspositionsensor.Longitude != 0)) {
+            AlarmsClear(SYSTEMALARMS_ALARM_GPS);
 #ifdef PIOS_GPS_SETS_HOMELOCATION
-                HomeLocationData home;
-                HomeLocationGet(&home);
-
-                if (home.Set == HOMELOCATION_SET_FALSE) {
-                    if (homelocationSetDelay == 0) {
-                        homelocationSetDelay = xTaskGetTickCount();
-                    }
-                    if (xTaskGetTickCount() - homelocationSetDelay > GPS_HOMELOCATION_SET_DELAY) {
-                        setHomeLocation(&gpspositionsensor);
-                        homelocationSetDelay = 0;
-                    }
-                } else {
+            HomeLocationData home;
+            HomeLocationGet(&home);
+
+            if (home.Set == HOMELOCATION_SET_FALSE) {
+                if (homelocationSetDelay == 0) {
+                    homelocationSetDelay = xTaskGetTickCount();
+                }
+                if (xTaskGetTickCount() - homelocationSetDelay > GPS_HOMELOCATION_SET_DELAY) {
+                    setHomeLocation(&gpspositionsensor);
                     homelocationSetDelay = 0;
                 }
-#endif
-            } else if ((gpspositionsensor.Status == GPSPOSITIONSENSOR_STATUS_FIX3D) &&
-                       (gpspositionsensor.Latitude != 0 || gpspositionsensor.Longitude != 0)) {
-                AlarmsSet(SYSTEMALARMS_ALARM_GPS, SYSTEMALARMS_ALARM_WARNING);
             } else {
-                AlarmsSet(SYSTEMALARMS_ALARM_GPS, SYSTEMALARMS_ALARM_CRITICAL);
+                homelocationSetDelay = 0;
             }
+#endif
+        } else if ((gpspositionsensor.Status == GPSPOSITIONSENSOR_STATUS_FIX3D) &&
+                   (gpspositionsensor.Latitude != 0 || gpspositionsensor.Longitude != 0)) {
+            AlarmsSet(SYSTEMALARMS_ALARM_GPS, SYSTEMALARMS_ALARM_WARNING);
+        } else {
+            AlarmsSet(SYSTEMALARMS_ALARM_GPS, SYSTEMALARMS_ALARM_CRITICAL);
         }
-        vTaskDelayUntil(&xLastWakeTime, GPS_LOOP_DELAY_MS / portTICK_RATE_MS);
     }
+
+    // Keep the periodic schedule alive; an rx notification dispatches
+    // the callback sooner when data arrives
+    PIOS_CALLBACKSCHEDULER_Schedule(gpsCallbackHandle, GPS_LOOP_DELAY_MS, CALLBACK_UPDATEMODE_SOONER);
 }
 
 #ifdef PIOS_GPS_SETS_HOMELOCATION
@@ -403,7 +419,7 @@ static void setHomeLocation(GPSPositionSensorData *gpsData)
         float LLA[3] = { (home.Latitude) / 10e6f, (home.Longitude) / 10e6f, (home.Altitude) };
 
         /* Compute magnetic flux direction at home location */
-        if (WMM_GetMagVector(LLA[0], LLA[1], LLA[2], gps.Month, gps.Day, gps.Year, &home.Be[0]) == 0) {
+        if (WMM_GetMagVectorInterpolated(LLA[0], LLA[1], LLA[2], gps.Month, gps.Day, gps.Year, &home.Be[0]) == 0) {
             /*Compute local acceleration due to gravity.  Vehicles that span a very large
              * range of altitude (say, weather balloons) may need to update this during the
              * flight. */
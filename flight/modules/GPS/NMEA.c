@@ -63,8 +63,16 @@
 #define MAX_NB_PARAMS 20
 /* NMEA sentence parsers */
 
+/* Pack the four trailing characters of a 5 character sentence header into
+ * one word, so looking up a parser is an integer compare per candidate
+ * instead of a strcmp. The leading 'G' is common to all supported headers
+ * and is checked separately. */
+#define NMEA_PREFIX_KEY(b, c, d, e) \
+    (((uint32_t)(b) << 24) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 8) | (uint32_t)(e))
+
 struct nmea_parser {
     const char *prefix;
+    uint32_t   key;
     bool (*handler)(GPSPositionSensorData *GpsData, bool *gpsDataUpdated, char *param[], uint8_t nbParam);
 };
 
@@ -80,33 +88,39 @@ static bool nmeaProcessGPGSV(GPSPositionSensorData *GpsData, bool *gpsDataUpdate
 static const struct nmea_parser nmea_parsers[] = {
     {
         .prefix  = "GPGGA",
+        .key     = NMEA_PREFIX_KEY('P', 'G', 'G', 'A'),
         .handler = nmeaProcessGPGGA,
     },
     {
         .prefix  = "GPVTG",
+        .key     = NMEA_PREFIX_KEY('P', 'V', 'T', 'G'),
         .handler = nmeaProcessGPVTG,
     },
     {
         .prefix  = "GPGSA",
+        .key     = NMEA_PREFIX_KEY('P', 'G', 'S', 'A'),
         .handler = nmeaProcessGPGSA,
     },
     {
         .prefix  = "GPRMC",
+        .key     = NMEA_PREFIX_KEY('P', 'R', 'M', 'C'),
         .handler = nmeaProcessGPRMC,
     },
 #if !defined(PIOS_GPS_MINIMAL)
     {
         .prefix  = "GPZDA",
+        .key     = NMEA_PREFIX_KEY('P', 'Z', 'D', 'A'),
         .handler = nmeaProcessGPZDA,
     },
     {
         .prefix  = "GPGSV",
+        .key     = NMEA_PREFIX_KEY('P', 'G', 'S', 'V'),
         .handler = nmeaProcessGPGSV,
     },
 #endif // PIOS_GPS_MINIMAL
 };
 
-int parse_nmea_stream(uint8_t *rx, uint8_t len, char *gps_rx_buffer, GPSPositionSensorData *GpsData, struct GPS_RX_STATS *gpsRxStats)
+int parse_nmea_stream(uint8_t *rx, uint16_t len, char *gps_rx_buffer, GPSPositionSensorData *GpsData, struct GPS_RX_STATS *gpsRxStats)
 {
     int ret = PARSER_INCOMPLETE;
     static uint8_t rx_count = 0;
@@ -184,17 +198,18 @@ int parse_nmea_stream(uint8_t *rx, uint8_t len, char *gps_rx_buffer, GPSPosition
 
 static const struct nmea_parser *NMEA_find_parser_by_prefix(const char *prefix)
 {
-    if (!prefix) {
+    /* All supported headers are exactly 5 characters and start with 'G' */
+    if (!prefix || (prefix[0] != 'G') ||
+        !prefix[1] || !prefix[2] || !prefix[3] || !prefix[4] || prefix[5]) {
         return NULL;
     }
 
-    for (uint8_t i = 0; i < NELEMENTS(nmea_parsers); i++) {
-        const struct nmea_parser *parser = &nmea_parsers[i];
+    uint32_t key = NMEA_PREFIX_KEY(prefix[1], prefix[2], prefix[3], prefix[4]);
 
-        /* Use strcmp to check for exact equality over the entire prefix */
-        if (!strcmp(prefix, parser->prefix)) {
+    for (uint8_t i = 0; i < NELEMENTS(nmea_parsers); i++) {
+        if (nmea_parsers[i].key == key) {
             /* Found an appropriate parser */
-            return parser;
+            return &nmea_parsers[i];
         }
     }
 
@@ -244,38 +259,58 @@ bool NMEA_checksum(char *nmea_sentence)
  * into a signed whole part and an unsigned fractional part.
  * The fract_units field indicates the units of the fractional part as
  *   1 whole = 10^fract_units fract
+ *
+ * Single pass over the field with no library calls and no intermediate
+ * copies; fractional digits beyond what fits a uint32 are skipped.
  */
 static bool NMEA_parse_real(int32_t *whole, uint32_t *fract, uint8_t *fract_units, char *field)
 {
-    char *s = field;
-    char *field_w;
-    char *field_f;
+    const char *s  = field;
+    bool negative  = false;
+    int32_t num_w  = 0;
+    uint32_t num_f = 0;
+    uint8_t units  = 0;
 
     PIOS_DEBUG_Assert(whole);
     PIOS_DEBUG_Assert(fract);
     PIOS_DEBUG_Assert(fract_units);
     PIOS_DEBUG_Assert(field);
 
-    field_w = strsep(&s, ".");
-    field_f = s;
+    if (*s == '-') {
+        negative = true;
+        s++;
+    } else if (*s == '+') {
+        s++;
+    }
 
-    *whole  = strtol(field_w, NULL, 10);
+    while ((*s >= '0') && (*s <= '9')) {
+        num_w = (num_w * 10) + (*s++ - '0');
+    }
 
-    if (field_w) {
-        /* decimal was found so we may have a fractional part */
-        *fract = strtoul(field_f, NULL, 10);
-        *fract_units = strlen(field_f);
-    } else {
-        /* no decimal was found, fractional part is zero */
-        *fract = 0;
-        *fract_units = 0;
+    if (*s == '.') {
+        s++;
+        while ((*s >= '0') && (*s <= '9')) {
+            if (units < 9) {
+                num_f = (num_f * 10) + (*s - '0');
+                units++;
+            }
+            s++;
+        }
     }
 
+    *whole = negative ? -num_w : num_w;
+    *fract = num_f;
+    *fract_units = units;
+
     return true;
 }
 
 static float NMEA_real_to_float(char *nmea_real)
 {
+    /* 10^-fract_units, indexed by fract_units (cheaper than powf()) */
+    static const float fract_scale[] = {
+        1.0f, 1e-1f, 1e-2f, 1e-3f, 1e-4f, 1e-5f, 1e-6f, 1e-7f, 1e-8f, 1e-9f
+    };
     int32_t whole;
     uint32_t fract;
     uint8_t fract_units;
@@ -285,7 +320,7 @@ static float NMEA_real_to_float(char *nmea_real)
     }
 
     /* Convert to float */
-    return ((float)whole) + fract * powf(10.0f, -fract_units);
+    return ((float)whole) + fract * fract_scale[fract_units];
 }
 
 /*
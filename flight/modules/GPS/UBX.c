@@ -40,6 +40,7 @@
 
 #ifndef PIOS_GPS_MINIMAL
 #include <auxmagsupport.h>
+#include "inc/ubx_autoconfig.h"
 
 static bool useMag = false;
 #endif
@@ -105,99 +106,114 @@ struct UBX_ACK_NAK ubxLastNak;
 
 // If a PVT sentence is received in the last UBX_PVT_TIMEOUT (ms) timeframe it disables VELNED/POSLLH/SOL/TIMEUTC
 #define UBX_PVT_TIMEOUT (1000)
-// parse incoming character stream for messages in UBX binary format
+// parse incoming stream spans for messages in UBX binary format
+// the parser consumes whole spans (sync search via memchr, payload via
+// memcpy) instead of running the state machine once per byte; frames may
+// still straddle span boundaries, the state is kept across calls
 
-int parse_ubx_stream(uint8_t *rx, uint8_t len, char *gps_rx_buffer, GPSPositionSensorData *GpsData, struct GPS_RX_STATS *gpsRxStats)
+int parse_ubx_stream(uint8_t *rx, uint16_t len, char *gps_rx_buffer, GPSPositionSensorData *GpsData, struct GPS_RX_STATS *gpsRxStats)
 {
     int ret = PARSER_INCOMPLETE; // message not (yet) complete
     enum proto_states {
         START,
         UBX_SY2,
-        UBX_CLASS,
-        UBX_ID,
-        UBX_LEN1,
-        UBX_LEN2,
+        UBX_HEADER,
         UBX_PAYLOAD,
-        UBX_CHK1,
-        UBX_CHK2,
-        FINISHED
+        UBX_CHK
     };
-    uint8_t c;
     static enum proto_states proto_state = START;
-    static uint8_t rx_count = 0;
-    struct UBXPacket *ubx   = (struct UBXPacket *)gps_rx_buffer;
+    static uint16_t rx_count = 0;
+    static uint8_t header_buf[4]; // class, id, len low, len high
+    struct UBXPacket *ubx    = (struct UBXPacket *)gps_rx_buffer;
+    uint16_t chunk;
 
-    for (int i = 0; i < len; i++) {
-        c = rx[i];
+    while (len > 0) {
         switch (proto_state) {
         case START: // detect protocol
-            if (c == UBX_SYNC1) { // first UBX sync char found
-                proto_state = UBX_SY2;
+        {
+            uint8_t *sync = (uint8_t *)memchr(rx, UBX_SYNC1, len);
+            if (sync == NULL) { // no frame start in the remaining span
+                return (ret != PARSER_COMPLETE) ? PARSER_ERROR : PARSER_COMPLETE;
             }
+            if (sync != rx) { // bytes before the sync could not be used
+                ret = (ret != PARSER_COMPLETE) ? PARSER_ERROR : PARSER_COMPLETE;
+            }
+            len -= (sync - rx) + 1;
+            rx   = sync + 1;
+            proto_state = UBX_SY2;
             break;
+        }
         case UBX_SY2:
-            if (c == UBX_SYNC2) { // second UBX sync char found
-                proto_state = UBX_CLASS;
+            if (*rx == UBX_SYNC2) { // second UBX sync char found
+                rx_count    = 0;
+                proto_state = UBX_HEADER;
             } else {
                 proto_state = START; // reset state
+                ret = (ret != PARSER_COMPLETE) ? PARSER_ERROR : PARSER_COMPLETE;
             }
+            rx++;
+            len--;
             break;
-        case UBX_CLASS:
-            ubx->header.class = c;
-            proto_state      = UBX_ID;
-            break;
-        case UBX_ID:
-            ubx->header.id   = c;
-            proto_state      = UBX_LEN1;
-            break;
-        case UBX_LEN1:
-            ubx->header.len  = c;
-            proto_state      = UBX_LEN2;
-            break;
-        case UBX_LEN2:
-            ubx->header.len += (c << 8);
-            if (ubx->header.len > sizeof(UBXPayload)) {
-                gpsRxStats->gpsRxOverflow++;
-                proto_state = START;
-            } else {
-                rx_count    = 0;
-                proto_state = UBX_PAYLOAD;
+        case UBX_HEADER:
+            chunk = sizeof(header_buf) - rx_count;
+            if (chunk > len) {
+                chunk = len;
             }
-            break;
-        case UBX_PAYLOAD:
-            if (rx_count < ubx->header.len) {
-                ubx->payload.payload[rx_count] = c;
-                if (++rx_count == ubx->header.len) {
-                    proto_state = UBX_CHK1;
+            memcpy(&header_buf[rx_count], rx, chunk);
+            rx_count += chunk;
+            rx  += chunk;
+            len -= chunk;
+            if (rx_count == sizeof(header_buf)) {
+                ubx->header.class = header_buf[0];
+                ubx->header.id    = header_buf[1];
+                ubx->header.len   = header_buf[2] + (header_buf[3] << 8);
+                if (ubx->header.len > sizeof(UBXPayload)) {
+                    gpsRxStats->gpsRxOverflow++;
+                    proto_state = START;
+                    ret = (ret != PARSER_COMPLETE) ? PARSER_ERROR : PARSER_COMPLETE;
+                } else {
+                    rx_count    = 0;
+                    proto_state = UBX_PAYLOAD;
                 }
-            } else {
-                gpsRxStats->gpsRxOverflow++;
-                proto_state = START;
             }
             break;
-        case UBX_CHK1:
-            ubx->header.ck_a = c;
-            proto_state = UBX_CHK2;
+        case UBX_PAYLOAD:
+            chunk = ubx->header.len - rx_count;
+            if (chunk > len) {
+                chunk = len;
+            }
+            memcpy(&ubx->payload.payload[rx_count], rx, chunk);
+            rx_count += chunk;
+            rx  += chunk;
+            len -= chunk;
+            if (rx_count == ubx->header.len) {
+                rx_count    = 0;
+                proto_state = UBX_CHK;
+            }
             break;
-        case UBX_CHK2:
-            ubx->header.ck_b = c;
-            if (checksum_ubx_message(ubx)) { // message complete and valid
-                parse_ubx_message(ubx, GpsData);
-                proto_state = FINISHED;
+        case UBX_CHK:
+            if (rx_count == 0) {
+                ubx->header.ck_a = *rx;
+                rx_count = 1;
             } else {
-                gpsRxStats->gpsRxChkSumError++;
+                ubx->header.ck_b = *rx;
+                // checksum over the whole assembled frame in one pass
+                if (checksum_ubx_message(ubx)) { // message complete and valid
+                    parse_ubx_message(ubx, GpsData);
+                    gpsRxStats->gpsRxReceived++;
+                    ret = PARSER_COMPLETE; // message complete & processed
+                } else {
+                    gpsRxStats->gpsRxChkSumError++;
+                    ret = (ret != PARSER_COMPLETE) ? PARSER_ERROR : PARSER_COMPLETE;
+                }
                 proto_state = START;
             }
+            rx++;
+            len--;
             break;
-        default: break;
-        }
-
-        if (proto_state == START) {
-            ret = (ret != PARSER_COMPLETE) ? PARSER_ERROR : PARSER_COMPLETE; // parser couldn't use this byte
-        } else if (proto_state == FINISHED) {
-            gpsRxStats->gpsRxReceived++;
+        default:
             proto_state = START;
-            ret = PARSER_COMPLETE; // message complete & processed
+            break;
         }
     }
     return ret;
@@ -438,6 +454,8 @@ static void parse_ubx_ack_ack(struct UBXPacket *ubx, __attribute__((unused)) GPS
     struct UBX_ACK_ACK *ack_ack = &ubx->payload.ack_ack;
 
     ubxLastAck = *ack_ack;
+    // let autoconfig tick off its outstanding request table
+    ubx_autoconfig_ack_received(ack_ack->clsID, ack_ack->msgID);
 }
 
 static void parse_ubx_ack_nak(struct UBXPacket *ubx, __attribute__((unused)) GPSPositionSensorData *GpsPosition)
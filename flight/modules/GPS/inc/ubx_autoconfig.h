@@ -188,5 +188,6 @@ typedef union {
 
 void ubx_autoconfig_run(char * *buffer, uint16_t *bytes_to_send, bool gps_connected);
 void ubx_autoconfig_set(ubx_autoconfig_settings_t config);
+void ubx_autoconfig_ack_received(uint8_t clsID, uint8_t msgID);
 int32_t ubx_autoconfig_get_status();
 #endif /* UBX_AUTOCONFIG_H_ */
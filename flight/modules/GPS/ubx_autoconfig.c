@@ -29,29 +29,41 @@
  */
 #include "inc/ubx_autoconfig.h"
 #include <pios_mem.h>
+
+// must hold the largest sentence table plus rate, nav, sbas and save requests
+#define UBX_PIPELINE_MAX_REQUESTS 32
+
 // private type definitions
 typedef enum {
     INIT_STEP_DISABLED = 0,
     INIT_STEP_START,
     INIT_STEP_ASK_VER,
     INIT_STEP_WAIT_VER,
-    INIT_STEP_ENABLE_SENTENCES,
-    INIT_STEP_ENABLE_SENTENCES_WAIT_ACK,
-    INIT_STEP_CONFIGURE,
-    INIT_STEP_CONFIGURE_WAIT_ACK,
+    INIT_STEP_STREAM_CFG,
+    INIT_STEP_WAIT_ACKS,
     INIT_STEP_DONE,
     INIT_STEP_ERROR,
 } initSteps_t;
 
+// one entry per configuration message streamed to the GPS.  The whole CFG
+// set is sent back to back and acks are matched against this table as they
+// arrive, instead of stalling UBX_REPLY_TIMEOUT on every single message.
+typedef struct {
+    struct UBX_ACK_ACK expectedAck; // Class and id the GPS will ack for this request
+    bool sent;
+    bool acked;
+} request_t;
+
 typedef struct {
     initSteps_t        currentStep; // Current configuration "fsm" status
     uint32_t           lastStepTimestampRaw; // timestamp of last operation
     uint32_t           lastConnectedRaw; // timestamp of last time gps was connected
     UBXSentPacket_t    working_packet; // outbound "buffer"
     ubx_autoconfig_settings_t currentSettings;
-    int8_t lastConfigSent; // index of last configuration string sent
-    struct UBX_ACK_ACK requiredAck; // Class and id of the message we are waiting for an ACK from GPS
-    uint8_t retryCount;
+    request_t requests[UBX_PIPELINE_MAX_REQUESTS]; // outstanding request table
+    uint8_t   requestCount;
+    uint8_t   nextRequest; // next table index to stream
+    bool      retryPass; // unacked requests are streamed a second time before giving up
 } status_t;
 
 ubx_cfg_msg_t msg_config_ubx6[] = {
@@ -113,10 +125,6 @@ ubx_cfg_msg_t msg_config_ubx7[] = {
     { .msgClass = UBX_CLASS_NAV, .msgID = UBX_ID_NAV_SVINFO,    .rate = 10 },
 };
 
-// private defines
-#define LAST_CONFIG_SENT_START     (-1)
-#define LAST_CONFIG_SENT_COMPLETED (-2)
-
 // private variables
 
 // enable the autoconfiguration system
@@ -177,8 +185,6 @@ void config_rate(uint16_t *bytes_to_send)
     status->working_packet.message.payload.cfg_rate.navRate  = 1; // must be set to 1
     status->working_packet.message.payload.cfg_rate.timeRef  = 1; // 0 = UTC Time, 1 = GPS Time
     *bytes_to_send = prepare_packet(&status->working_packet, UBX_CLASS_CFG, UBX_ID_CFG_RATE, sizeof(ubx_cfg_rate_t));
-    status->requiredAck.clsID = UBX_CLASS_CFG;
-    status->requiredAck.msgID = UBX_ID_CFG_RATE;
 }
 
 void config_nav(uint16_t *bytes_to_send)
@@ -191,8 +197,6 @@ void config_nav(uint16_t *bytes_to_send)
 
     status->working_packet.message.payload.cfg_nav5.mask     = 0x01 + 0x04; // Dyn Model | posFixMode configuration
     *bytes_to_send = prepare_packet(&status->working_packet, UBX_CLASS_CFG, UBX_ID_CFG_NAV5, sizeof(ubx_cfg_nav5_t));
-    status->requiredAck.clsID = UBX_CLASS_CFG;
-    status->requiredAck.msgID = UBX_ID_CFG_NAV5;
 }
 
 void config_sbas(uint16_t *bytes_to_send)
@@ -220,8 +224,6 @@ void config_sbas(uint16_t *bytes_to_send)
     status->working_packet.message.payload.cfg_sbas.scanmode2 = UBX_CFG_SBAS_SCANMODE2;
 
     *bytes_to_send = prepare_packet(&status->working_packet, UBX_CLASS_CFG, UBX_ID_CFG_SBAS, sizeof(ubx_cfg_sbas_t));
-    status->requiredAck.clsID = UBX_CLASS_CFG;
-    status->requiredAck.msgID = UBX_ID_CFG_SBAS;
 }
 
 void config_save(uint16_t *bytes_to_send)
@@ -231,52 +233,99 @@ void config_save(uint16_t *bytes_to_send)
     status->working_packet.message.payload.cfg_cfg.saveMask   = 0x02 | 0x08; // msgConf + navConf
     status->working_packet.message.payload.cfg_cfg.deviceMask = UBX_CFG_CFG_ALL_DEVICES_MASK;
     *bytes_to_send = prepare_packet(&status->working_packet, UBX_CLASS_CFG, UBX_ID_CFG_CFG, sizeof(ubx_cfg_cfg_t));
-    status->requiredAck.clsID = UBX_CLASS_CFG;
-    status->requiredAck.msgID = UBX_ID_CFG_CFG;
 }
-static void configure(uint16_t *bytes_to_send)
+static uint8_t sentence_count(void)
+{
+    return (ubxHwVersion >= UBX_HW_VERSION_7) ?
+           NELEMENTS(msg_config_ubx7) : NELEMENTS(msg_config_ubx6);
+}
+
+static void add_pipeline_request(uint8_t msgID)
+{
+    request_t *request = &status->requests[status->requestCount++];
+
+    request->expectedAck.clsID = UBX_CLASS_CFG;
+    request->expectedAck.msgID = msgID;
+    request->sent  = false;
+    request->acked = false;
+}
+
+/**
+ * (re)build the outstanding request table for the whole CFG set, in the
+ * order the messages are streamed out.  Indexes below the sentence table
+ * size map onto CFG-MSG entries, the remainder onto rate/nav/sbas/save.
+ */
+static void pipeline_start(void)
+{
+    uint8_t msg_count = sentence_count();
+
+    status->requestCount = 0;
+    status->nextRequest  = 0;
+    status->retryPass    = false;
+    for (uint8_t msg = 0; msg < msg_count; msg++) {
+        add_pipeline_request(UBX_ID_CFG_MSG);
+    }
+    add_pipeline_request(UBX_ID_CFG_RATE);
+    add_pipeline_request(UBX_ID_CFG_NAV5);
+    add_pipeline_request(UBX_ID_CFG_SBAS);
+    if (status->currentSettings.storeSettings) {
+        add_pipeline_request(UBX_ID_CFG_CFG);
+    }
+}
+
+static void build_pipeline_request(uint8_t index, uint16_t *bytes_to_send)
 {
-    switch (status->lastConfigSent) {
-    case LAST_CONFIG_SENT_START:
+    uint8_t msg_count = sentence_count();
+
+    if (index < msg_count) {
+        ubx_cfg_msg_t *msg_config = (ubxHwVersion >= UBX_HW_VERSION_7) ?
+                                    &msg_config_ubx7[0] : &msg_config_ubx6[0];
+        status->working_packet.message.payload.cfg_msg = msg_config[index];
+        *bytes_to_send = prepare_packet(&status->working_packet, UBX_CLASS_CFG, UBX_ID_CFG_MSG, sizeof(ubx_cfg_msg_t));
+        return;
+    }
+    switch (index - msg_count) {
+    case 0:
         config_rate(bytes_to_send);
         break;
-    case LAST_CONFIG_SENT_START + 1:
+    case 1:
         config_nav(bytes_to_send);
         break;
-    case LAST_CONFIG_SENT_START + 2:
+    case 2:
         config_sbas(bytes_to_send);
-        if (!status->currentSettings.storeSettings) {
-            // skips saving
-            status->lastConfigSent = LAST_CONFIG_SENT_COMPLETED;
-        }
         break;
-    case LAST_CONFIG_SENT_START + 3:
+    case 3:
         config_save(bytes_to_send);
-        status->lastConfigSent = LAST_CONFIG_SENT_COMPLETED;
-        return;
-
+        break;
     default:
-        status->lastConfigSent = LAST_CONFIG_SENT_COMPLETED;
-        return;
+        break;
     }
 }
 
-static void enable_sentences(__attribute__((unused)) uint16_t *bytes_to_send)
+/**
+ * Match an incoming CFG ack against the outstanding request table.  Called
+ * from the UBX parser (same gps task) for every ACK-ACK received, so acks
+ * arriving while later requests are still being streamed are not lost.
+ * Identical acks (all CFG-MSG requests share one class/id pair) are matched
+ * against outstanding requests in send order.
+ */
+void ubx_autoconfig_ack_received(uint8_t clsID, uint8_t msgID)
 {
-    int8_t msg = status->lastConfigSent + 1;
-    uint8_t msg_count = (ubxHwVersion >= UBX_HW_VERSION_7) ?
-                        NELEMENTS(msg_config_ubx7) : NELEMENTS(msg_config_ubx6);
-    ubx_cfg_msg_t *msg_config = (ubxHwVersion >= UBX_HW_VERSION_7) ?
-                                &msg_config_ubx7[0] : &msg_config_ubx6[0];
-
-    if (msg >= 0 && msg < msg_count) {
-        status->working_packet.message.payload.cfg_msg = msg_config[msg];
-
-        *bytes_to_send = prepare_packet(&status->working_packet, UBX_CLASS_CFG, UBX_ID_CFG_MSG, sizeof(ubx_cfg_msg_t));
-        status->requiredAck.clsID = UBX_CLASS_CFG;
-        status->requiredAck.msgID = UBX_ID_CFG_MSG;
-    } else {
-        status->lastConfigSent = LAST_CONFIG_SENT_COMPLETED;
+    if (!status || !enabled) {
+        return;
+    }
+    if (status->currentStep != INIT_STEP_STREAM_CFG && status->currentStep != INIT_STEP_WAIT_ACKS) {
+        return;
+    }
+    for (uint8_t i = 0; i < status->requestCount; i++) {
+        request_t *request = &status->requests[i];
+        if (request->sent && !request->acked &&
+            request->expectedAck.clsID == clsID && request->expectedAck.msgID == msgID) {
+            request->acked = true;
+            // acks count as progress, restart the reply timeout
+            status->lastStepTimestampRaw = PIOS_DELAY_GetRaw();
+            return;
+        }
     }
 }
 
@@ -320,10 +369,6 @@ void ubx_autoconfig_run(char * *buffer, uint16_t *bytes_to_send, bool gps_connec
 
     case INIT_STEP_START:
     case INIT_STEP_ASK_VER:
-        // clear ack
-        ubxLastAck.clsID = 0x00;
-        ubxLastAck.msgID = 0x00;
-
         status->lastStepTimestampRaw = PIOS_DELAY_GetRaw();
         build_request(&status->working_packet, UBX_CLASS_MON, UBX_ID_MON_VER, bytes_to_send);
         status->currentStep = INIT_STEP_WAIT_VER;
@@ -331,8 +376,8 @@ void ubx_autoconfig_run(char * *buffer, uint16_t *bytes_to_send, bool gps_connec
 
     case INIT_STEP_WAIT_VER:
         if (ubxHwVersion > 0) {
-            status->lastConfigSent = LAST_CONFIG_SENT_START;
-            status->currentStep    = INIT_STEP_ENABLE_SENTENCES;
+            pipeline_start();
+            status->currentStep = INIT_STEP_STREAM_CFG;
             status->lastStepTimestampRaw = PIOS_DELAY_GetRaw();
             return;
         }
@@ -342,51 +387,48 @@ void ubx_autoconfig_run(char * *buffer, uint16_t *bytes_to_send, bool gps_connec
         }
         return;
 
-    case INIT_STEP_ENABLE_SENTENCES:
-    case INIT_STEP_CONFIGURE:
-    {
-        bool step_configure = (status->currentStep == INIT_STEP_CONFIGURE);
-        if (step_configure) {
-            configure(bytes_to_send);
-        } else {
-            enable_sentences(bytes_to_send);
+    case INIT_STEP_STREAM_CFG:
+        // stream the CFG set back to back, one request per step; acks are
+        // matched asynchronously by ubx_autoconfig_ack_received() meanwhile.
+        // on the retry pass requests already acked are skipped.
+        while (status->nextRequest < status->requestCount && status->requests[status->nextRequest].acked) {
+            status->nextRequest++;
         }
-
-        status->lastStepTimestampRaw = PIOS_DELAY_GetRaw();
-        if (status->lastConfigSent == LAST_CONFIG_SENT_COMPLETED) {
-            status->lastConfigSent = LAST_CONFIG_SENT_START;
-            status->currentStep    = step_configure ? INIT_STEP_DONE : INIT_STEP_CONFIGURE;
-        } else {
-            status->currentStep = step_configure ? INIT_STEP_CONFIGURE_WAIT_ACK : INIT_STEP_ENABLE_SENTENCES_WAIT_ACK;
+        if (status->nextRequest < status->requestCount) {
+            build_pipeline_request(status->nextRequest, bytes_to_send);
+            status->requests[status->nextRequest].sent = true;
+            status->nextRequest++;
+            status->lastStepTimestampRaw = PIOS_DELAY_GetRaw();
+            return;
         }
+        status->currentStep = INIT_STEP_WAIT_ACKS;
+        status->lastStepTimestampRaw = PIOS_DELAY_GetRaw();
         return;
-    }
-    case INIT_STEP_ENABLE_SENTENCES_WAIT_ACK:
-    case INIT_STEP_CONFIGURE_WAIT_ACK: // Wait for an ack from GPS
+
+    case INIT_STEP_WAIT_ACKS: // wait for the outstanding request table to drain
     {
-        bool step_configure = (status->currentStep == INIT_STEP_CONFIGURE_WAIT_ACK);
-        if (ubxLastAck.clsID == status->requiredAck.clsID && ubxLastAck.msgID == status->requiredAck.msgID) {
-            // clear ack
-            ubxLastAck.clsID   = 0x00;
-            ubxLastAck.msgID   = 0x00;
-
-            // Continue with next configuration option
-            status->retryCount = 0;
-            status->lastConfigSent++;
-        } else if (PIOS_DELAY_DiffuS(status->lastStepTimestampRaw) > UBX_REPLY_TIMEOUT) {
-            // timeout, resend the message or abort
-            status->retryCount++;
-            if (status->retryCount > UBX_MAX_RETRIES) {
+        bool pending = false;
+        for (uint8_t i = 0; i < status->requestCount; i++) {
+            if (!status->requests[i].acked) {
+                pending = true;
+                break;
+            }
+        }
+        if (!pending) {
+            status->currentStep = INIT_STEP_DONE;
+            status->lastStepTimestampRaw = PIOS_DELAY_GetRaw();
+            return;
+        }
+        if (PIOS_DELAY_DiffuS(status->lastStepTimestampRaw) > UBX_REPLY_TIMEOUT) {
+            if (status->retryPass) {
                 status->currentStep = INIT_STEP_ERROR;
                 status->lastStepTimestampRaw = PIOS_DELAY_GetRaw();
                 return;
             }
-        }
-        // no abort condition, continue or retries.,
-        if (step_configure) {
-            status->currentStep = INIT_STEP_CONFIGURE;
-        } else {
-            status->currentStep = INIT_STEP_ENABLE_SENTENCES;
+            // single retry pass: stream whatever is still unacked once more
+            status->retryPass   = true;
+            status->nextRequest = 0;
+            status->currentStep = INIT_STEP_STREAM_CFG;
         }
         return;
     }
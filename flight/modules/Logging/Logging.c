@@ -37,6 +37,10 @@
 #include "debuglogentry.h"
 #include "flightstatus.h"
 
+// number of consecutive entries sent for one RetrieveStream request,
+// must match the window size used by the GCS flight log download
+#define LOG_STREAM_WINDOW 16
+
 // private variables
 static DebugLogSettingsData settings;
 static DebugLogControlData control;
@@ -96,6 +100,17 @@ static void StatusUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
 static void FlightStatusUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
 {
     FlightStatusGet(&flightstatus);
+    if (flightstatus.Armed != FLIGHTSTATUS_ARMED_ARMED) {
+        // on the ground: report how close the RAM ring buffer came to
+        // overflowing, then push everything still buffered out to flash
+        uint8_t highWater = 0;
+        uint32_t drops    = 0;
+        PIOS_DEBUGLOG_BufferStats(&highWater, &drops);
+        if (highWater) {
+            PIOS_DEBUGLOG_Printf("Log buffer high water %u, dropped blocks %u.", (unsigned)highWater, (unsigned)drops);
+        }
+        PIOS_DEBUGLOG_Flush();
+    }
     if (settings.LoggingEnabled == DEBUGLOGSETTINGS_LOGGINGENABLED_ONLYWHENARMED) {
         if (flightstatus.Armed != FLIGHTSTATUS_ARMED_ARMED) {
             PIOS_DEBUGLOG_Printf("FlightStatus Disarmed: On board Logging disabled.");
@@ -133,6 +148,22 @@ static void ControlUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
             entry->Type   = DEBUGLOGENTRY_TYPE_EMPTY;
         }
         DebugLogEntrySet(entry);
+    } else if (control.Operation == DEBUGLOGCONTROL_OPERATION_RETRIEVESTREAM) {
+        // stream a window of consecutive entries without waiting for a
+        // request per entry, the GCS asks for the next window once the
+        // last entry of this one has arrived
+        for (uint16_t slot = 0; slot < LOG_STREAM_WINDOW; slot++) {
+            memset(entry, 0, sizeof(DebugLogEntryData));
+            if (PIOS_DEBUGLOG_Read(entry, control.Flight, control.Entry + slot) != 0) {
+                // no more entries, terminate the stream with an empty marker
+                entry->Flight = control.Flight;
+                entry->Entry  = control.Entry + slot;
+                entry->Type   = DEBUGLOGENTRY_TYPE_EMPTY;
+                DebugLogEntrySet(entry);
+                break;
+            }
+            DebugLogEntrySet(entry);
+        }
     } else if (control.Operation == DEBUGLOGCONTROL_OPERATION_FORMATFLASH) {
         uint8_t armed;
         FlightStatusArmedGet(&armed);
@@ -109,8 +109,10 @@ MODULE_INITCALL(OPLinkModInitialize, 0);
 static void systemTask(__attribute__((unused)) void *parameters)
 {
     portTickType lastSysTime;
-    uint16_t prev_tx_count = 0;
-    uint16_t prev_rx_count = 0;
+    uint16_t prev_tx_count  = 0;
+    uint16_t prev_rx_count  = 0;
+    uint16_t prev_ppm_count = 0;
+    uint16_t prev_com_count = 0;
     bool first_time = true;
 
     /* create all modules thread */
@@ -167,14 +169,22 @@ static void systemTask(__attribute__((unused)) void *parameters)
             if (first_time) {
                 first_time = false;
             } else {
-                uint16_t tx_count = radio_stats.tx_byte_count;
-                uint16_t rx_count = radio_stats.rx_byte_count;
-                uint16_t tx_bytes = (tx_count < prev_tx_count) ? (0xffff - prev_tx_count + tx_count) : (tx_count - prev_tx_count);
-                uint16_t rx_bytes = (rx_count < prev_rx_count) ? (0xffff - prev_rx_count + rx_count) : (rx_count - prev_rx_count);
-                oplinkStatus.TXRate = (uint16_t)((float)(tx_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
-                oplinkStatus.RXRate = (uint16_t)((float)(rx_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
-                prev_tx_count = tx_count;
-                prev_rx_count = rx_count;
+                uint16_t tx_count  = radio_stats.tx_byte_count;
+                uint16_t rx_count  = radio_stats.rx_byte_count;
+                uint16_t ppm_count = radio_stats.tx_ppm_byte_count;
+                uint16_t com_count = radio_stats.tx_com_byte_count;
+                uint16_t tx_bytes  = (tx_count < prev_tx_count) ? (0xffff - prev_tx_count + tx_count) : (tx_count - prev_tx_count);
+                uint16_t rx_bytes  = (rx_count < prev_rx_count) ? (0xffff - prev_rx_count + rx_count) : (rx_count - prev_rx_count);
+                uint16_t ppm_bytes = (ppm_count < prev_ppm_count) ? (0xffff - prev_ppm_count + ppm_count) : (ppm_count - prev_ppm_count);
+                uint16_t com_bytes = (com_count < prev_com_count) ? (0xffff - prev_com_count + com_count) : (com_count - prev_com_count);
+                oplinkStatus.TXRate    = (uint16_t)((float)(tx_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
+                oplinkStatus.RXRate    = (uint16_t)((float)(rx_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
+                oplinkStatus.TXPPMRate = (uint16_t)((float)(ppm_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
+                oplinkStatus.TXComRate = (uint16_t)((float)(com_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
+                prev_tx_count  = tx_count;
+                prev_rx_count  = rx_count;
+                prev_ppm_count = ppm_count;
+                prev_com_count = com_count;
             }
             oplinkStatus.TXSeq     = radio_stats.tx_seq;
             oplinkStatus.RXSeq     = radio_stats.rx_seq;
@@ -126,10 +126,71 @@ uint16_t mirror(uint16_t source)
     return result;
 }
 
+// Dirty row extent for each of the two flip buffers, keyed by the buffer
+// pointer because pios_video swaps the draw/display roles underneath us.
+// It records which rows were drawn into a buffer on its previous pass so
+// clearGraphics() only has to wipe those instead of the whole buffer pair.
+struct dirty_rows {
+    uint8_t *buf;
+    int16_t top;
+    int16_t bottom;
+};
+static struct dirty_rows dirty_rows[2];
+
+static struct dirty_rows *getDirtyRows()
+{
+    // key on the level buffer; level and mask always swap together
+    for (int i = 0; i < 2; i++) {
+        if (dirty_rows[i].buf == draw_buffer_level) {
+            return &dirty_rows[i];
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        if (dirty_rows[i].buf == 0) {
+            dirty_rows[i].buf    = draw_buffer_level;
+            // content unknown on first sight, force one full wipe
+            dirty_rows[i].top    = 0;
+            dirty_rows[i].bottom = GRAPHICS_HEIGHT - 1;
+            return &dirty_rows[i];
+        }
+    }
+    // can't happen, there are only two buffers
+    return &dirty_rows[0];
+}
+
+static void markDirtyRows(int y0, int y1)
+{
+    struct dirty_rows *dirty = getDirtyRows();
+
+    if (y0 < 0) {
+        y0 = 0;
+    }
+    if (y1 > GRAPHICS_HEIGHT - 1) {
+        y1 = GRAPHICS_HEIGHT - 1;
+    }
+    if (y0 > y1) {
+        return;
+    }
+    if (y0 < dirty->top) {
+        dirty->top = y0;
+    }
+    if (y1 > dirty->bottom) {
+        dirty->bottom = y1;
+    }
+}
+
 void clearGraphics()
 {
-    memset((uint8_t *)draw_buffer_mask, 0, GRAPHICS_WIDTH * GRAPHICS_HEIGHT);
-    memset((uint8_t *)draw_buffer_level, 0, GRAPHICS_WIDTH * GRAPHICS_HEIGHT);
+    struct dirty_rows *dirty = getDirtyRows();
+
+    if (dirty->top <= dirty->bottom) {
+        uint32_t offset = (uint32_t)dirty->top * GRAPHICS_WIDTH;
+        uint32_t length = (uint32_t)(dirty->bottom - dirty->top + 1) * GRAPHICS_WIDTH;
+        memset((uint8_t *)draw_buffer_mask + offset, 0, length);
+        memset((uint8_t *)draw_buffer_level + offset, 0, length);
+    }
+    dirty->top    = GRAPHICS_HEIGHT;
+    dirty->bottom = -1;
 }
 
 void copyimage(uint16_t offsetx, uint16_t offsety, int image)
@@ -140,6 +201,7 @@ void copyimage(uint16_t offsetx, uint16_t offsety, int image)
     }
     struct splashEntry splash_info;
     splash_info = splash[image];
+    markDirtyRows(offsety, offsety + splash_info.height - 1);
     offsetx     = offsetx / 8;
     for (uint16_t y = offsety; y < ((splash_info.height) + offsety); y++) {
         uint16_t x1 = offsetx;
@@ -348,6 +410,9 @@ void drawBox(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
 void write_pixel(uint8_t *buff, unsigned int x, unsigned int y, int mode)
 {
     CHECK_COORDS(x, y);
+    if (mode) {
+        markDirtyRows(y, y);
+    }
     // Determine the bit in the word to be set and the word
     // index to set it in.
     int bitnum    = CALC_BIT_IN_WORD(x);
@@ -369,6 +434,9 @@ void write_pixel(uint8_t *buff, unsigned int x, unsigned int y, int mode)
 void write_pixel_lm(unsigned int x, unsigned int y, int mmode, int lmode)
 {
     CHECK_COORDS(x, y);
+    if (mmode || lmode) {
+        markDirtyRows(y, y);
+    }
     // Determine the bit in the word to be set and the word
     // index to set it in.
     int bitnum    = CALC_BIT_IN_WORD(x);
@@ -398,6 +466,9 @@ void write_hline(uint8_t *buff, unsigned int x0, unsigned int x1, unsigned int y
     if (x0 == x1) {
         return;
     }
+    if (mode) {
+        markDirtyRows(y, y);
+    }
     /* This is an optimised algorithm for writing horizontal lines.
     * We begin by finding the addresses of the x0 and x1 points. */
     int addr0     = CALC_BUFF_ADDR(x0, y);
@@ -491,6 +562,9 @@ void write_vline(uint8_t *buff, unsigned int x, unsigned int y0, unsigned int y1
     if (y0 == y1) {
         return;
     }
+    if (mode) {
+        markDirtyRows(y0, y1);
+    }
     /* This is an optimised algorithm for writing vertical lines.
      * We begin by finding the addresses of the x,y0 and x,y1 points. */
     unsigned int addr0  = CALC_BUFF_ADDR(x, y0);
@@ -575,6 +649,9 @@ void write_filled_rectangle(uint8_t *buff, unsigned int x, unsigned int y, unsig
     if (width <= 0 || height <= 0) {
         return;
     }
+    if (mode) {
+        markDirtyRows(y, y + height - 1);
+    }
     // Calculate as if the rectangle was only a horizontal line. We then
     // step these addresses through each row until we iterate `height` times.
     unsigned int addr0     = CALC_BUFF_ADDR(x, y);
@@ -673,6 +750,9 @@ void write_rectangle_outlined(unsigned int x, unsigned int y, int width, int hei
 void write_circle(uint8_t *buff, unsigned int cx, unsigned int cy, unsigned int r, unsigned int dashp, int mode)
 {
     CHECK_COORDS(cx, cy);
+    if (mode) {
+        markDirtyRows(cy - r, cy + r);
+    }
     int error = -r, x = r, y = 0;
     while (x >= y) {
         if (dashp == 0 || (y % dashp) < (dashp / 2)) {
@@ -760,6 +840,9 @@ void write_circle_outlined(unsigned int cx, unsigned int cy, unsigned int r, uns
 void write_circle_filled(uint8_t *buff, unsigned int cx, unsigned int cy, unsigned int r, int mode)
 {
     CHECK_COORDS(cx, cy);
+    if (mode) {
+        markDirtyRows(cy - r, cy + r);
+    }
     int error = -r, x = r, y = 0, xch = 0;
     // It turns out that filled circles can take advantage of the midpoint
     // circle algorithm. We simply draw very fast horizontal lines across each
@@ -804,6 +887,9 @@ void write_circle_filled(uint8_t *buff, unsigned int cx, unsigned int cy, unsign
  */
 void write_line(uint8_t *buff, unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1, int mode)
 {
+    if (mode) {
+        markDirtyRows(y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0);
+    }
     // Based on http://en.wikipedia.org/wiki/Bresenham%27s_line_algorithm
     unsigned int steep = abs(y1 - y0) > abs(x1 - x0);
 
@@ -1032,10 +1118,43 @@ void write_word_misaligned_OR(uint8_t *buff, uint16_t word, unsigned int addr, u
  */
 void write_word_misaligned_lm(uint16_t wordl, uint16_t wordm, unsigned int addr, unsigned int xoff, int lmode, int mmode)
 {
+    if (lmode || mmode) {
+        markDirtyRows(addr / (GRAPHICS_WIDTH_REAL / 8), addr / (GRAPHICS_WIDTH_REAL / 8));
+    }
     write_word_misaligned(draw_buffer_level, wordl, addr, xoff, lmode);
     write_word_misaligned(draw_buffer_mask, wordm, addr, xoff, mmode);
 }
 
+/**
+ * blit_glyph_row: composite one glyph row into the mask and level
+ * buffers in a single pass.
+ *
+ * The row is expanded once into a 24 bit window (most significant
+ * byte first) and every affected framebuffer byte is read and written
+ * exactly once, with the level OR and NAND folded into one access.
+ * The text writers used to make three separate misaligned word passes
+ * per row, re-shifting the glyph data each time.
+ *
+ * @param       or_mask         glyph pixels, left aligned (already << xshift)
+ * @param       and_mask        pixels to clear in the level buffer, left aligned
+ * @param       addr            address of first byte
+ * @param       xoff            x offset (0-7)
+ */
+static inline void blit_glyph_row(uint16_t or_mask, uint16_t and_mask, unsigned int addr, unsigned int xoff)
+{
+    uint32_t or24  = (uint32_t)or_mask << (8 - xoff);
+    uint32_t and24 = (uint32_t)and_mask << (8 - xoff);
+
+    draw_buffer_mask[addr] |= (or24 >> 16);
+    draw_buffer_level[addr] = (draw_buffer_level[addr] | (uint8_t)(or24 >> 16)) & (uint8_t)~(and24 >> 16);
+    draw_buffer_mask[addr + 1]  |= (or24 >> 8) & 0xff;
+    draw_buffer_level[addr + 1]  = (draw_buffer_level[addr + 1] | (uint8_t)(or24 >> 8)) & (uint8_t)~(and24 >> 8);
+    if (xoff > 0) {
+        draw_buffer_mask[addr + 2]  |= or24 & 0xff;
+        draw_buffer_level[addr + 2] = (draw_buffer_level[addr + 2] | (uint8_t)or24) & (uint8_t)~and24;
+    }
+}
+
 /**
  * fetch_font_info: Fetch font info structs.
  *
@@ -1073,7 +1192,7 @@ int fetch_font_info(uint8_t ch, int font, struct FontEntry *font_info, char *loo
  */
 void write_char16(char ch, unsigned int x, unsigned int y, int font)
 {
-    unsigned int yy, addr_temp, row, row_temp, xshift;
+    unsigned int yy, row, xshift;
     uint16_t and_mask, or_mask, levels;
     struct FontEntry font_info;
 
@@ -1092,27 +1211,14 @@ void write_char16(char ch, unsigned int x, unsigned int y, int font)
         if (x + wbit > GRAPHICS_WIDTH_REAL) {
             return;
         }
+        markDirtyRows(y, y + font_info.height - 1);
         // Load data pointer.
-        row       = ch * font_info.height;
-        row_temp  = row;
-        addr_temp = addr;
-        xshift    = 16 - font_info.width;
-        // We can write mask words easily.
-        for (yy = y; yy < y + font_info.height; yy++) {
-            if (font == 3) {
-                write_word_misaligned_OR(draw_buffer_mask, font_mask12x18[row] << xshift, addr, wbit);
-            } else {
-                write_word_misaligned_OR(draw_buffer_mask, font_mask8x10[row] << xshift, addr, wbit);
-            }
-            addr += GRAPHICS_WIDTH_REAL / 8;
-            row++;
-        }
-        // Level bits are more complicated. We need to set or clear
-        // level bits, but only where the mask bit is set; otherwise,
-        // we need to leave them alone. To do this, for each word, we
-        // construct an AND mask and an OR mask, and apply each individually.
-        row  = row_temp;
-        addr = addr_temp;
+        row    = ch * font_info.height;
+        xshift = 16 - font_info.width;
+        // Composite mask and level bits row by row.  Level bits must
+        // only change where the mask bit is set, so each row carries an
+        // OR mask (pixels to set) and an AND mask (pixels to clear);
+        // blit_glyph_row() applies both in one framebuffer pass.
         for (yy = y; yy < y + font_info.height; yy++) {
             if (font == 3) {
                 levels   = font_frame12x18[row];
@@ -1127,10 +1233,7 @@ void write_char16(char ch, unsigned int x, unsigned int y, int font)
                 or_mask  = font_mask8x10[row] << xshift;
                 and_mask = (font_mask8x10[row] & levels) << xshift;
             }
-            write_word_misaligned_OR(draw_buffer_level, or_mask, addr, wbit);
-            // If we're not bold write the AND mask.
-            // if(!(flags & FONT_BOLD))
-            write_word_misaligned_NAND(draw_buffer_level, and_mask, addr, wbit);
+            blit_glyph_row(or_mask, and_mask, addr, wbit);
             addr += GRAPHICS_WIDTH_REAL / 8;
             row++;
         }
@@ -1150,7 +1253,7 @@ void write_char16(char ch, unsigned int x, unsigned int y, int font)
  */
 void write_char(char ch, unsigned int x, unsigned int y, int flags, int font)
 {
-    unsigned int yy, addr_temp, row, row_temp, xshift;
+    unsigned int yy, row, xshift;
     uint16_t and_mask, or_mask, levels;
     struct FontEntry font_info;
     char lookup = 0;
@@ -1173,23 +1276,11 @@ void write_char(char ch, unsigned int x, unsigned int y, int flags, int font)
         if (x + wbit > GRAPHICS_WIDTH_REAL) {
             return;
         }
+        markDirtyRows(y, y + font_info.height - 1);
         // Load data pointer.
-        row       = lookup * font_info.height * 2;
-        row_temp  = row;
-        addr_temp = addr;
-        xshift    = 16 - font_info.width;
-        // We can write mask words easily.
-        for (yy = y; yy < y + font_info.height; yy++) {
-            write_word_misaligned_OR(draw_buffer_mask, font_info.data[row] << xshift, addr, wbit);
-            addr += GRAPHICS_WIDTH_REAL / 8;
-            row++;
-        }
-        // Level bits are more complicated. We need to set or clear
-        // level bits, but only where the mask bit is set; otherwise,
-        // we need to leave them alone. To do this, for each word, we
-        // construct an AND mask and an OR mask, and apply each individually.
-        row  = row_temp;
-        addr = addr_temp;
+        row    = lookup * font_info.height * 2;
+        xshift = 16 - font_info.width;
+        // Composite mask and level bits row by row, see write_char16()
         for (yy = y; yy < y + font_info.height; yy++) {
             levels = font_info.data[row + font_info.height];
             if (!(flags & FONT_INVERT)) {
@@ -1198,10 +1289,7 @@ void write_char(char ch, unsigned int x, unsigned int y, int flags, int font)
             }
             or_mask  = font_info.data[row] << xshift;
             and_mask = (font_info.data[row] & levels) << xshift;
-            write_word_misaligned_OR(draw_buffer_level, or_mask, addr, wbit);
-            // If we're not bold write the AND mask.
-            // if(!(flags & FONT_BOLD))
-            write_word_misaligned_NAND(draw_buffer_level, and_mask, addr, wbit);
+            blit_glyph_row(or_mask, and_mask, addr, wbit);
             addr += GRAPHICS_WIDTH_REAL / 8;
             row++;
         }
@@ -2391,6 +2479,7 @@ void updateOnceEveryFrame()
 {
     clearGraphics();
     updateGraphics();
+    PIOS_Video_FrameReady();
 }
 
 // ****************
@@ -2463,6 +2552,7 @@ static void osdgenTask(__attribute__((unused)) void *parameters)
 #endif
             clearGraphics();
             introGraphics();
+            PIOS_Video_FrameReady();
         }
     }
     for (int i = 0; i < 63; i++) {
@@ -2473,6 +2563,7 @@ static void osdgenTask(__attribute__((unused)) void *parameters)
             clearGraphics();
             introGraphics();
             introText();
+            PIOS_Video_FrameReady();
         }
     }
 
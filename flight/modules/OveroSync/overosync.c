@@ -179,8 +179,13 @@ static void overoSyncTask(__attribute__((unused)) void *parameters)
     while (1) {
         // Wait for queue message
         if (xQueueReceive(queue, &ev, portMAX_DELAY) == pdTRUE) {
-            // Process event.  This calls transmitData
-            UAVTalkSendObjectTimestamped(uavTalkCon, ev.obj, ev.instId, false, 0);
+            // Drain every queued update into the same burst, so a DMA
+            // frame carries as many objects as fit instead of whatever
+            // had trickled into the fifo since the last wakeup.
+            do {
+                // Process event.  This calls transmitData
+                UAVTalkSendObjectTimestamped(uavTalkCon, ev.obj, ev.instId, false, 0);
+            } while (xQueueReceive(queue, &ev, 0) == pdTRUE);
 
             updateTime = xTaskGetTickCount();
             if (((portTickType)(updateTime - lastUpdateTime)) > 1000) {
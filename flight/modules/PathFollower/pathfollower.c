@@ -107,6 +107,7 @@ static uint32_t updatePeriod = PF_IDLE_UPDATE_RATE_MS;
 static struct Globals global;
 static PathStatusData pathStatus;
 static PathDesiredData pathDesired;
+static struct path_compiled pathCompiled;
 static FixedWingPathFollowerSettingsData fixedWingPathFollowerSettings;
 static VtolPathFollowerSettingsData vtolPathFollowerSettings;
 
@@ -259,6 +260,7 @@ static void SettingsUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
     pid_configure(&global.PIDvel[2], vtolPathFollowerSettings.VerticalVelPID.Kp, vtolPathFollowerSettings.VerticalVelPID.Ki, vtolPathFollowerSettings.VerticalVelPID.Kd, vtolPathFollowerSettings.VerticalVelPID.ILimit);
 
     PathDesiredGet(&pathDesired);
+    path_compile(&pathDesired, &pathCompiled);
 }
 
 
@@ -478,7 +480,7 @@ static float updatePathBearing()
                      positionState.Down };
     struct path_status progress;
 
-    path_progress(&pathDesired, cur, &progress);
+    path_progress(&pathCompiled, cur, &progress);
 
     // atan2f always returns in between + and - 180 degrees
     return RAD2DEG(atan2f(progress.path_vector[1], progress.path_vector[0]));
@@ -591,6 +593,9 @@ static void processPOI()
             pathDesired.StartingVelocity = 1.0f;
             pathDesired.EndingVelocity   = 0.0f;
             pathDesired.Mode = PATHDESIRED_MODE_FLYENDPOINT;
+            // recompile right away, the PathDesired callback only runs after
+            // the event dispatcher gets scheduled
+            path_compile(&pathDesired, &pathCompiled);
             PathDesiredSet(&pathDesired);
         }
     }
@@ -626,7 +631,7 @@ static void updatePathVelocity(float kFF, bool limited)
                        positionState.Down + (velocityState.Down * kFF) };
     struct path_status progress;
 
-    path_progress(&pathDesired, cur, &progress);
+    path_progress(&pathCompiled, cur, &progress);
 
     // calculate velocity - can be zero if waypoints are too close
     VelocityDesiredData velocityDesired;
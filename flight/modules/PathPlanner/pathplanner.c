@@ -58,10 +58,11 @@
 static void pathPlannerTask();
 static void commandUpdated(UAVObjEvent *ev);
 static void statusUpdated(UAVObjEvent *ev);
+static void planUpdated(UAVObjEvent *ev);
 static void updatePathDesired();
 static void setWaypoint(uint16_t num);
 
-static uint8_t checkPathPlan();
+static void validatePathPlan();
 static uint8_t pathConditionCheck();
 static uint8_t conditionNone();
 static uint8_t conditionTimeOut();
@@ -78,11 +79,31 @@ static uint8_t conditionImmediate();
 // Private variables
 static DelayedCallbackInfo *pathPlannerHandle;
 static DelayedCallbackInfo *pathDesiredUpdaterHandle;
+static DelayedCallbackInfo *pathPlanValidatorHandle;
 static WaypointActiveData waypointActive;
 static WaypointData waypoint;
 static PathActionData pathAction;
 static bool pathplanner_active = false;
 
+/*
+ * Path plan validation runs incrementally in a low priority callback
+ * instead of inline with the planner state machine.  The event
+ * callbacks record the lowest changed instance since the last pass so
+ * the CRC chain is only re-walked from that point, and the planner
+ * itself just consumes the cached verdict - a mission upload never
+ * blocks the navigation chain for a full plan scan.
+ */
+#define DIRTY_NONE 0xFFFF
+static volatile uint8_t pathPlanValid   = false;
+static volatile uint16_t dirtyWaypoint  = 0;
+static volatile uint16_t dirtyAction    = 0;
+// crcPrefix[i] caches the CRC chain value before instance i;
+// waypoint prefixes are followed by action prefixes in one array
+static uint8_t *crcPrefix;
+static uint16_t crcPrefixCapacity;
+static uint16_t lastWaypointCount;
+static uint16_t lastActionCount;
+
 
 /**
  * Module initialization
@@ -94,10 +115,13 @@ int32_t PathPlannerStart()
     WaypointConnectCallback(commandUpdated);
     WaypointActiveConnectCallback(commandUpdated);
     PathActionConnectCallback(commandUpdated);
+    PathPlanConnectCallback(planUpdated);
     PathStatusConnectCallback(statusUpdated);
 
     // Start main task callback
     PIOS_CALLBACKSCHEDULER_Dispatch(pathPlannerHandle);
+    // initial full validation of whatever plan is already loaded
+    PIOS_CALLBACKSCHEDULER_Dispatch(pathPlanValidatorHandle);
 
     return 0;
 }
@@ -119,6 +143,7 @@ int32_t PathPlannerInitialize()
 
     pathPlannerHandle = PIOS_CALLBACKSCHEDULER_Create(&pathPlannerTask, CALLBACK_PRIORITY_REGULAR, TASK_PRIORITY, CALLBACKINFO_RUNNING_PATHPLANNER0, STACK_SIZE_BYTES);
     pathDesiredUpdaterHandle = PIOS_CALLBACKSCHEDULER_Create(&updatePathDesired, CALLBACK_PRIORITY_CRITICAL, TASK_PRIORITY, CALLBACKINFO_RUNNING_PATHPLANNER1, STACK_SIZE_BYTES);
+    pathPlanValidatorHandle  = PIOS_CALLBACKSCHEDULER_Create(&validatePathPlan, CALLBACK_PRIORITY_LOW, TASK_PRIORITY, CALLBACKINFO_RUNNING_PATHPLANNER2, STACK_SIZE_BYTES);
 
     return 0;
 }
@@ -134,9 +159,8 @@ static void pathPlannerTask()
 
     bool endCondition = false;
 
-    // check path plan validity early to raise alarm
-    // even if not in guided mode
-    uint8_t validPathPlan = checkPathPlan();
+    // consume the verdict of the background validation, see validatePathPlan()
+    uint8_t validPathPlan = pathPlanValid;
 
     FlightStatusData flightStatus;
     FlightStatusGet(&flightStatus);
@@ -245,8 +269,28 @@ static void pathPlannerTask()
     }
 }
 
-// safety checks for path plan integrity
-static uint8_t checkPathPlan()
+// make sure the CRC prefix cache can hold both instance chains
+static bool growCrcPrefix(uint16_t entries)
+{
+    if (entries <= crcPrefixCapacity) {
+        return true;
+    }
+    uint8_t *grown = pios_malloc(entries);
+    if (!grown) {
+        return false;
+    }
+    if (crcPrefix) {
+        memcpy(grown, crcPrefix, crcPrefixCapacity);
+        pios_free(crcPrefix);
+    }
+    crcPrefix = grown;
+    crcPrefixCapacity = entries;
+    return true;
+}
+
+// safety checks for path plan integrity, run in a low priority callback
+// whenever part of the plan has changed
+static void validatePathPlan()
 {
     uint16_t i;
     uint16_t waypointCount;
@@ -254,40 +298,64 @@ static uint8_t checkPathPlan()
     uint8_t pathCrc;
     PathPlanData pathPlan;
 
-    // WaypointData waypoint; // using global instead (?)
-    // PathActionData action; // using global instead (?)
+    // snapshot and reset the dirty watermarks; events raised during
+    // validation lower them again and redispatch this callback
+    PIOS_IRQ_Disable();
+    uint16_t wDirty = dirtyWaypoint;
+    uint16_t aDirty = dirtyAction;
+    dirtyWaypoint = DIRTY_NONE;
+    dirtyAction   = DIRTY_NONE;
+    PIOS_IRQ_Enable();
 
     PathPlanGet(&pathPlan);
 
     waypointCount = pathPlan.WaypointCount;
+    actionCount   = pathPlan.PathActionCount;
+    pathPlanValid = false;
     if (waypointCount == 0) {
         // an empty path plan is invalid
-        return false;
+        return;
     }
-    actionCount = pathPlan.PathActionCount;
 
     // check count consistency
     if (waypointCount > UAVObjGetNumInstances(WaypointHandle())) {
         // PIOS_DEBUGLOG_Printf("PathPlan : waypoint count error!");
-        return false;
+        return;
     }
     if (actionCount > UAVObjGetNumInstances(PathActionHandle())) {
         // PIOS_DEBUGLOG_Printf("PathPlan : path action count error!");
-        return false;
+        return;
     }
 
-    // check CRC
-    pathCrc = 0;
-    for (i = 0; i < waypointCount; i++) {
-        pathCrc = UAVObjUpdateCRC(WaypointHandle(), i, pathCrc);
+    if (!growCrcPrefix(waypointCount + actionCount)) {
+        return;
     }
-    for (i = 0; i < actionCount; i++) {
-        pathCrc = UAVObjUpdateCRC(PathActionHandle(), i, pathCrc);
+    // a count change shifts the chain, recompute from the shorter length
+    if (waypointCount != lastWaypointCount) {
+        wDirty = MIN(wDirty, MIN(waypointCount, lastWaypointCount));
+    }
+    if ((actionCount != lastActionCount) || (wDirty < waypointCount)) {
+        // action prefixes embed the final waypoint chain value, so any
+        // waypoint change invalidates all of them
+        aDirty = 0;
     }
+    lastWaypointCount = waypointCount;
+    lastActionCount   = actionCount;
+
+    // check CRC, re-walking the chains only behind the dirty watermarks
+    for (i = wDirty; i < waypointCount; i++) {
+        pathCrc = (i == 0) ? 0 : crcPrefix[i - 1];
+        crcPrefix[i] = UAVObjUpdateCRC(WaypointHandle(), i, pathCrc);
+    }
+    for (i = aDirty; i < actionCount; i++) {
+        pathCrc = (i == 0) ? crcPrefix[waypointCount - 1] : crcPrefix[waypointCount + i - 1];
+        crcPrefix[waypointCount + i] = UAVObjUpdateCRC(PathActionHandle(), i, pathCrc);
+    }
+    pathCrc = actionCount ? crcPrefix[waypointCount + actionCount - 1] : crcPrefix[waypointCount - 1];
     if (pathCrc != pathPlan.Crc) {
         // failed crc check
         // PIOS_DEBUGLOG_Printf("PathPlan : bad CRC (%d / %d)!", pathCrc, pathPlan.Crc);
-        return false;
+        return;
     }
 
     // waypoint consistency
@@ -295,7 +363,7 @@ static uint8_t checkPathPlan()
         WaypointInstGet(i, &waypoint);
         if (waypoint.Action >= actionCount) {
             // path action id is out of range
-            return false;
+            return;
         }
     }
 
@@ -304,25 +372,46 @@ static uint8_t checkPathPlan()
         PathActionInstGet(i, &pathAction);
         if (pathAction.ErrorDestination >= waypointCount) {
             // waypoint id is out of range
-            return false;
+            return;
         }
         if (pathAction.JumpDestination >= waypointCount) {
             // waypoint id is out of range
-            return false;
+            return;
         }
     }
 
     // path plan passed checks
 
-    return true;
+    pathPlanValid = true;
 }
 
 // callback function when status changed, issue execution of state machine
-void commandUpdated(__attribute__((unused)) UAVObjEvent *ev)
+void commandUpdated(UAVObjEvent *ev)
 {
+    // lower the validation watermark for the changed instance and kick
+    // the background validator
+    if (ev && (ev->obj == WaypointHandle())) {
+        if (ev->instId < dirtyWaypoint) {
+            dirtyWaypoint = ev->instId;
+        }
+        PIOS_CALLBACKSCHEDULER_Dispatch(pathPlanValidatorHandle);
+    } else if (ev && (ev->obj == PathActionHandle())) {
+        if (ev->instId < dirtyAction) {
+            dirtyAction = ev->instId;
+        }
+        PIOS_CALLBACKSCHEDULER_Dispatch(pathPlanValidatorHandle);
+    }
     PIOS_CALLBACKSCHEDULER_Dispatch(pathDesiredUpdaterHandle);
 }
 
+// callback function when the path plan object changed, revalidate everything
+void planUpdated(__attribute__((unused)) UAVObjEvent *ev)
+{
+    dirtyWaypoint = 0;
+    dirtyAction   = 0;
+    PIOS_CALLBACKSCHEDULER_Dispatch(pathPlanValidatorHandle);
+}
+
 // callback function when waypoints changed in any way, update pathDesired
 void statusUpdated(__attribute__((unused)) UAVObjEvent *ev)
 {
@@ -523,8 +612,10 @@ static uint8_t conditionLegRemaining()
 
     float cur[3] = { positionState.North, positionState.East, positionState.Down };
     struct path_status progress;
+    struct path_compiled pathCompiled;
 
-    path_progress(&pathDesired,
+    path_compile(&pathDesired, &pathCompiled);
+    path_progress(&pathCompiled,
                   cur, &progress);
     if (progress.fractional_progress >= 1.0f - pathAction.ConditionParameters[0]) {
         return true;
@@ -547,8 +638,10 @@ static uint8_t conditionBelowError()
 
     float cur[3] = { positionState.North, positionState.East, positionState.Down };
     struct path_status progress;
+    struct path_compiled pathCompiled;
 
-    path_progress(&pathDesired,
+    path_compile(&pathDesired, &pathCompiled);
+    path_progress(&pathCompiled,
                   cur, &progress);
     if (progress.error <= pathAction.ConditionParameters[0]) {
         return true;
@@ -41,6 +41,7 @@
 #include <uavtalk_priv.h>
 #include <pios_rfm22b.h>
 #include <ecc.h>
+#include <lzss.h>
 #if defined(PIOS_INCLUDE_FLASH_EEPROM)
 #include <pios_eeprom.h>
 #endif
@@ -59,10 +60,27 @@
 #define SERIAL_RX_BUF_LEN 100
 #define PPM_INPUT_TIMEOUT 100
 
+// Framing for the compressed raw serial path.  Both modems must have
+// OPLinkSettings.Compression enabled (like ComSpeed, the setting has to
+// match on both ends of the link).
+#define FRAME_SYNC             0x7E
+#define FRAME_FLAG_COMPRESSED  0x01
+// sync + flags + raw length + payload length, then payload, then crc
+#define FRAME_HEADER_LEN       4
+
 
 // ****************
 // Private types
 
+typedef enum {
+    FRAME_STATE_SYNC = 0,
+    FRAME_STATE_FLAGS,
+    FRAME_STATE_RAW_LEN,
+    FRAME_STATE_PAYLOAD_LEN,
+    FRAME_STATE_PAYLOAD,
+    FRAME_STATE_CRC,
+} FrameRxState;
+
 typedef struct {
     // The task handles.
     xTaskHandle telemetryTxTaskHandle;
@@ -83,6 +101,19 @@ typedef struct {
     // The raw serial Rx buffer
     uint8_t  serialRxBuf[SERIAL_RX_BUF_LEN];
 
+    // Compression state for the raw serial path
+    bool     compressSerial;
+    // Outbound frame: header + payload (at most the raw block) + crc
+    uint8_t  frameTxBuf[FRAME_HEADER_LEN + SERIAL_RX_BUF_LEN + 1];
+    // Inbound frame payload and decompressed output
+    uint8_t  framePayload[SERIAL_RX_BUF_LEN];
+    uint8_t  decompressBuf[SERIAL_RX_BUF_LEN];
+    FrameRxState frameState;
+    uint8_t  frameFlags;
+    uint8_t  frameRawLen;
+    uint8_t  framePayloadLen;
+    uint8_t  framePos;
+
     // Error statistics.
     uint32_t telemetryTxRetries;
     uint32_t radioTxRetries;
@@ -110,6 +141,8 @@ static int32_t UAVTalkSendHandler(uint8_t *buf, int32_t length);
 static int32_t RadioSendHandler(uint8_t *buf, int32_t length);
 static void ProcessTelemetryStream(UAVTalkConnection inConnectionHandle, UAVTalkConnection outConnectionHandle, uint8_t rxbyte);
 static void ProcessRadioStream(UAVTalkConnection inConnectionHandle, UAVTalkConnection outConnectionHandle, uint8_t rxbyte);
+static uint16_t BuildSerialFrame(uint8_t *buf, uint16_t length);
+static void ProcessSerialFrameByte(uint8_t rxbyte);
 static void objectPersistenceUpdatedCb(UAVObjEvent *objEv);
 static void registerObject(UAVObjHandle obj);
 
@@ -138,6 +171,9 @@ static int32_t RadioComBridgeStart(void)
                                (oplinkSettings.FlexiPort != OPLINKSETTINGS_FLEXIPORT_SERIAL) &&
                                (oplinkSettings.VCPPort != OPLINKSETTINGS_VCPPORT_SERIAL));
 
+        // Compress the raw serial stream if requested.  The setting must match on both modems.
+        data->compressSerial = !data->parseUAVTalk && (oplinkSettings.Compression == OPLINKSETTINGS_COMPRESSION_TRUE);
+
         // Set the maximum radio RF power.
         switch (oplinkSettings.MaxRFPower) {
         case OPLINKSETTINGS_MAXRFPOWER_125:
@@ -248,7 +284,9 @@ static int32_t RadioComBridgeInitialize(void)
     data->telemetryTxRetries = 0;
     data->radioTxRetries     = 0;
 
-    data->parseUAVTalk = true;
+    data->parseUAVTalk   = true;
+    data->compressSerial = false;
+    data->frameState     = FRAME_STATE_SYNC;
     data->comSpeed     = OPLINKSETTINGS_COMSPEED_9600;
     PIOS_COM_RADIO     = PIOS_COM_RFM22B;
 
@@ -412,13 +450,20 @@ static void radioRxTask(__attribute__((unused)) void *parameters)
                         ProcessRadioStream(data->radioUAVTalkCon, data->telemUAVTalkCon, serial_data[i]);
                     }
                 } else if (PIOS_COM_TELEMETRY) {
-                    // Send the data straight to the telemetry port.
-                    // Following call can fail with -2 error code (buffer full) or -3 error code (could not acquire send mutex)
-                    // It is the caller responsibility to retry in such cases...
-                    int32_t ret   = -2;
-                    uint8_t count = 5;
-                    while (count-- > 0 && ret < -1) {
-                        ret = PIOS_COM_SendBufferNonBlocking(PIOS_COM_TELEMETRY, serial_data, bytes_to_process);
+                    if (data->compressSerial) {
+                        // Reassemble and decompress the framed stream.
+                        for (uint8_t i = 0; i < bytes_to_process; i++) {
+                            ProcessSerialFrameByte(serial_data[i]);
+                        }
+                    } else {
+                        // Send the data straight to the telemetry port.
+                        // Following call can fail with -2 error code (buffer full) or -3 error code (could not acquire send mutex)
+                        // It is the caller responsibility to retry in such cases...
+                        int32_t ret   = -2;
+                        uint8_t count = 5;
+                        while (count-- > 0 && ret < -1) {
+                            ret = PIOS_COM_SendBufferNonBlocking(PIOS_COM_TELEMETRY, serial_data, bytes_to_process);
+                        }
                     }
                 }
             }
@@ -512,13 +557,19 @@ static void serialRxTask(__attribute__((unused)) void *parameters)
             uint16_t bytes_to_process = PIOS_COM_ReceiveBuffer(inputPort, data->serialRxBuf, sizeof(data->serialRxBuf), MAX_PORT_DELAY);
 
             if (bytes_to_process > 0) {
+                uint8_t *send_buf = data->serialRxBuf;
+                uint16_t send_len = bytes_to_process;
+                if (data->compressSerial) {
+                    send_len = BuildSerialFrame(data->serialRxBuf, bytes_to_process);
+                    send_buf = data->frameTxBuf;
+                }
                 // Send the data over the radio link.
                 // Following call can fail with -2 error code (buffer full) or -3 error code (could not acquire send mutex)
                 // It is the caller responsibility to retry in such cases...
                 int32_t ret   = -2;
                 uint8_t count = 5;
                 while (count-- > 0 && ret < -1) {
-                    ret = PIOS_COM_SendBufferNonBlocking(PIOS_COM_RADIO, data->serialRxBuf, bytes_to_process);
+                    ret = PIOS_COM_SendBufferNonBlocking(PIOS_COM_RADIO, send_buf, send_len);
                 }
             }
         } else {
@@ -527,6 +578,105 @@ static void serialRxTask(__attribute__((unused)) void *parameters)
     }
 }
 
+/**
+ * @brief Build a framed (and if worthwhile compressed) block from raw serial data.
+ *
+ * @param[in] buf Raw data block
+ * @param[in] length Length of the block
+ * @return total frame length in data->frameTxBuf
+ */
+static uint16_t BuildSerialFrame(uint8_t *buf, uint16_t length)
+{
+    uint8_t *frame = data->frameTxBuf;
+    uint8_t flags  = FRAME_FLAG_COMPRESSED;
+    // only worth it if the compressed payload is strictly smaller than the raw block
+    uint16_t payload_len = lzss_compress(buf, length, &frame[FRAME_HEADER_LEN], length - 1);
+
+    if (payload_len == 0) {
+        // incompressible, frame the block as is
+        memcpy(&frame[FRAME_HEADER_LEN], buf, length);
+        payload_len = length;
+        flags = 0;
+    }
+    frame[0] = FRAME_SYNC;
+    frame[1] = flags;
+    frame[2] = (uint8_t)length;
+    frame[3] = (uint8_t)payload_len;
+    uint8_t crc = 0;
+    for (uint16_t i = 1; i < FRAME_HEADER_LEN + payload_len; i++) {
+        crc = PIOS_CRC_updateByte(crc, frame[i]);
+    }
+    frame[FRAME_HEADER_LEN + payload_len] = crc;
+    return FRAME_HEADER_LEN + payload_len + 1;
+}
+
+/**
+ * @brief Process a byte of the framed serial stream received over the radio.
+ * Completed frames that pass the crc are decompressed (if needed) and sent
+ * on to the telemetry port.  A corrupted frame is dropped and the parser
+ * hunts for the next sync byte.
+ *
+ * @param[in] rxbyte  The received byte.
+ */
+static void ProcessSerialFrameByte(uint8_t rxbyte)
+{
+    switch (data->frameState) {
+    case FRAME_STATE_SYNC:
+        if (rxbyte == FRAME_SYNC) {
+            data->frameState = FRAME_STATE_FLAGS;
+        }
+        break;
+    case FRAME_STATE_FLAGS:
+        data->frameFlags = rxbyte;
+        data->frameState = FRAME_STATE_RAW_LEN;
+        break;
+    case FRAME_STATE_RAW_LEN:
+        data->frameRawLen = rxbyte;
+        data->frameState  = (rxbyte > 0 && rxbyte <= SERIAL_RX_BUF_LEN) ? FRAME_STATE_PAYLOAD_LEN : FRAME_STATE_SYNC;
+        break;
+    case FRAME_STATE_PAYLOAD_LEN:
+        data->framePayloadLen = rxbyte;
+        data->framePos   = 0;
+        data->frameState = (rxbyte > 0 && rxbyte <= SERIAL_RX_BUF_LEN) ? FRAME_STATE_PAYLOAD : FRAME_STATE_SYNC;
+        break;
+    case FRAME_STATE_PAYLOAD:
+        data->framePayload[data->framePos++] = rxbyte;
+        if (data->framePos == data->framePayloadLen) {
+            data->frameState = FRAME_STATE_CRC;
+        }
+        break;
+    case FRAME_STATE_CRC:
+    {
+        data->frameState = FRAME_STATE_SYNC;
+        uint8_t crc = PIOS_CRC_updateByte(0, data->frameFlags);
+        crc = PIOS_CRC_updateByte(crc, data->frameRawLen);
+        crc = PIOS_CRC_updateByte(crc, data->framePayloadLen);
+        crc = PIOS_CRC_updateCRC(crc, data->framePayload, data->framePayloadLen);
+        if (crc != rxbyte) {
+            break;
+        }
+        uint8_t *buf = data->framePayload;
+        uint16_t len = data->framePayloadLen;
+        if (data->frameFlags & FRAME_FLAG_COMPRESSED) {
+            len = lzss_decompress(data->framePayload, data->framePayloadLen, data->decompressBuf, sizeof(data->decompressBuf));
+            if (len != data->frameRawLen) {
+                // corrupted frame that slipped past the crc
+                break;
+            }
+            buf = data->decompressBuf;
+        }
+        // Following call can fail with -2 error code (buffer full) or -3 error code (could not acquire send mutex)
+        // It is the caller responsibility to retry in such cases...
+        int32_t ret   = -2;
+        uint8_t count = 5;
+        while (count-- > 0 && ret < -1) {
+            ret = PIOS_COM_SendBufferNonBlocking(PIOS_COM_TELEMETRY, buf, len);
+        }
+        break;
+    }
+    }
+}
+
 /**
  * @brief Transmit data buffer to the com port.
  *
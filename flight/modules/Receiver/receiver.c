@@ -37,6 +37,9 @@
 #include <manualcontrolsettings.h>
 #include <manualcontrolcommand.h>
 #include <receiveractivity.h>
+#ifdef PIOS_INCLUDE_RCVR_STATS
+#include <receiverstatus.h>
+#endif
 #include <flightstatus.h>
 #include <flighttelemetrystats.h>
 #include <flightmodesettings.h>
@@ -47,6 +50,11 @@
 #include "pios_usb_rctx.h"
 #endif /* PIOS_INCLUDE_USB_RCTX */
 
+#define PIOS_INSTRUMENT_MODULE
+#include <pios_instrumentation_helper.h>
+
+PERF_DEFINE_COUNTER(counterFrameLatency);
+
 // Private constants
 #if defined(PIOS_RECEIVER_STACK_SIZE)
 #define STACK_SIZE_BYTES  PIOS_RECEIVER_STACK_SIZE
@@ -95,6 +103,10 @@ static struct rcvr_activity_fsm activity_fsm;
 static void resetRcvrActivity(struct rcvr_activity_fsm *fsm);
 static bool updateRcvrActivity(struct rcvr_activity_fsm *fsm);
 
+#ifdef PIOS_INCLUDE_RCVR_STATS
+static void updateReceiverStatus(ManualControlSettingsData *settings);
+#endif
+
 #define assumptions \
     ( \
         ((int)MANUALCONTROLCOMMAND_CHANNEL_NUMELEM == (int)MANUALCONTROLSETTINGS_CHANNELGROUPS_NUMELEM) && \
@@ -128,6 +140,9 @@ int32_t ReceiverInitialize()
 
     ManualControlCommandInitialize();
     ReceiverActivityInitialize();
+#ifdef PIOS_INCLUDE_RCVR_STATS
+    ReceiverStatusInitialize();
+#endif
     ManualControlSettingsInitialize();
 
     return 0;
@@ -155,6 +170,9 @@ static void receiverTask(__attribute__((unused)) void *parameters)
 
     ManualControlCommandGet(&cmd);
     FlightStatusGet(&flightStatus);
+    ManualControlSettingsGet(&settings);
+
+    PERF_INIT_COUNTER(counterFrameLatency, 0x52000001);
 
     /* Initialize the RcvrActivty FSM */
     portTickType lastActivityTime = xTaskGetTickCount();
@@ -167,8 +185,32 @@ static void receiverTask(__attribute__((unused)) void *parameters)
     SystemSettingsThrustControlOptions thrustType;
 
     while (1) {
+#ifdef PIOS_RECEIVER_LOW_LATENCY
+        // Wake as soon as the receiver driver signals a fresh frame instead of
+        // polling on a fixed period.  Fall back to the periodic wait when the
+        // configured driver has no new-sample semaphore or no frame arrives in
+        // time, so activity monitoring and failsafe handling keep running.
+        xSemaphoreHandle frameSemaphore = 0;
+        if (ManualControlSettingsChannelGroupsToArray(settings.ChannelGroups)[MANUALCONTROLSETTINGS_CHANNELGROUPS_THROTTLE]
+            < MANUALCONTROLSETTINGS_CHANNELGROUPS_NONE) {
+            extern uint32_t pios_rcvr_group_map[];
+            frameSemaphore = PIOS_RCVR_GetSemaphore(pios_rcvr_group_map[
+                                                        ManualControlSettingsChannelGroupsToArray(settings.ChannelGroups)[MANUALCONTROLSETTINGS_CHANNELGROUPS_THROTTLE]],
+                                                    ManualControlSettingsChannelNumberToArray(settings.ChannelNumber)[MANUALCONTROLSETTINGS_CHANNELGROUPS_THROTTLE]);
+        }
+        if (frameSemaphore) {
+            xSemaphoreTake(frameSemaphore, UPDATE_PERIOD_MS / portTICK_RATE_MS);
+            lastSysTime = xTaskGetTickCount();
+        } else {
+            vTaskDelayUntil(&lastSysTime, UPDATE_PERIOD_MS / portTICK_RATE_MS);
+        }
+#else /* PIOS_RECEIVER_LOW_LATENCY */
         // Wait until next update
         vTaskDelayUntil(&lastSysTime, UPDATE_PERIOD_MS / portTICK_RATE_MS);
+#endif /* PIOS_RECEIVER_LOW_LATENCY */
+        // Time from here to ManualControlCommandSet() is the stick input
+        // latency added by this module on top of the frame arrival time
+        PERF_TIMED_SECTION_START(counterFrameLatency);
 #ifdef PIOS_INCLUDE_WDG
         PIOS_WDG_UpdateFlag(PIOS_WDG_MANUAL);
 #endif
@@ -189,6 +231,10 @@ static void receiverTask(__attribute__((unused)) void *parameters)
             lastActivityTime = lastSysTime;
         }
 
+#ifdef PIOS_INCLUDE_RCVR_STATS
+        updateReceiverStatus(&settings);
+#endif
+
         if (ManualControlCommandReadOnly()) {
             FlightTelemetryStatsData flightTelemStats;
             FlightTelemetryStatsGet(&flightTelemStats);
@@ -440,6 +486,8 @@ static void receiverTask(__attribute__((unused)) void *parameters)
 
         // Update cmd object
         ManualControlCommandSet(&cmd);
+        // The update callback chains straight into manualcontrol from here
+        PERF_TIMED_SECTION_END(counterFrameLatency);
 #if defined(PIOS_INCLUDE_USB_RCTX)
         if (pios_usb_rctx_id) {
             PIOS_USB_RCTX_Update(pios_usb_rctx_id,
@@ -588,6 +636,46 @@ group_completed:
     return activity_updated;
 }
 
+#ifdef PIOS_INCLUDE_RCVR_STATS
+/**
+ * Publish the frame timing statistics of the primary input driver (the
+ * group the throttle channel is mapped to) roughly once per second.
+ * Drivers that keep no frame statistics (PWM, PPM, GCS) leave the
+ * object untouched.
+ */
+static void updateReceiverStatus(ManualControlSettingsData *settings)
+{
+    static portTickType lastStatusTime;
+
+    portTickType now = xTaskGetTickCount();
+
+    if (timeDifferenceMs(lastStatusTime, now) < 1000) {
+        return;
+    }
+    lastStatusTime = now;
+
+    uint8_t group = ManualControlSettingsChannelGroupsToArray(settings->ChannelGroups)[MANUALCONTROLSETTINGS_CHANNELGROUPS_THROTTLE];
+    if (group >= MANUALCONTROLSETTINGS_CHANNELGROUPS_NONE) {
+        return;
+    }
+
+    extern uint32_t pios_rcvr_group_map[];
+    struct pios_rcvr_frame_stats stats;
+    if (PIOS_RCVR_GetFrameStats(pios_rcvr_group_map[group], &stats) < 0) {
+        return;
+    }
+
+    ReceiverStatusData status;
+    status.FrameCount      = stats.frame_count;
+    status.FrameAge        = stats.frame_age_us;
+    status.FramePeriod     = stats.period_us;
+    status.MeanFramePeriod = stats.mean_period_us;
+    status.FrameJitter     = stats.jitter_us;
+    status.MaxFrameJitter  = stats.max_jitter_us;
+    ReceiverStatusSet(&status);
+}
+#endif /* PIOS_INCLUDE_RCVR_STATS */
+
 /**
  * Convert channel from servo pulse duration (microseconds) to scaled -1/+1 range.
  */
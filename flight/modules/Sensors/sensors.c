@@ -181,8 +181,11 @@ int32_t mag_test;
 
 
 /**
- * The sensor task.  This polls the gyros at 500 Hz and pumps that data to
- * stabilization and to the attitude loop
+ * The sensor task.  On boards whose IMU driver streams completed transfers
+ * into a queue from its interrupt handler the task blocks on that queue and
+ * wakes as soon as a sample lands, so scaling and publication happen within
+ * the same sample period.  Boards without a queue driven IMU fall back to
+ * periodic polling.
  *
  * This function has a lot of if/defs right now to allow these configurations:
  * 1. BMA180 accel and MPU6000 gyro
@@ -245,6 +248,17 @@ static void SensorsTask(__attribute__((unused)) void *parameters)
     }
     PERF_INIT_COUNTER(counterGyroSamples, 0x53000001);
     PERF_INIT_COUNTER(counterSensorPeriod, 0x53000002);
+
+    // The MPU6000 posts every completed transfer to its queue from the EXTI
+    // handler, so the blocking receive on that queue paces the loop at the
+    // sensor output rate.  Adding a delay on top of that would only let
+    // samples age in the queue.
+#if defined(PIOS_INCLUDE_MPU6000)
+    bool event_paced = (bdinfo->board_rev == 0x02 || bdinfo->board_rev == 0x03);
+#else
+    const bool event_paced = false;
+#endif
+
     // Main task loop
     lastSysTime = xTaskGetTickCount();
     bool error = false;
@@ -344,6 +358,8 @@ static void SensorsTask(__attribute__((unused)) void *parameters)
                 struct pios_mpu6000_data mpu6000_data;
                 xQueueHandle queue = PIOS_MPU6000_GetQueue();
 
+                // Block until the driver posts a sample, then drain whatever
+                // backlog a burst FIFO read may have queued behind it
                 while (xQueueReceive(queue, (void *)&mpu6000_data, gyro_samples == 0 ? 10 : 0) != errQUEUE_EMPTY) {
                     gyro_accum[0]  += mpu6000_data.gyro_x;
                     gyro_accum[1]  += mpu6000_data.gyro_y;
@@ -476,7 +492,13 @@ static void SensorsTask(__attribute__((unused)) void *parameters)
 #ifdef PIOS_INCLUDE_WDG
         PIOS_WDG_UpdateFlag(PIOS_WDG_SENSORS);
 #endif
-        vTaskDelayUntil(&lastSysTime, sensor_period_ms / portTICK_RATE_MS);
+        if (event_paced) {
+            // The queue receive above already blocked until fresh data
+            // arrived; go straight back to waiting for the next sample.
+            lastSysTime = xTaskGetTickCount();
+        } else {
+            vTaskDelayUntil(&lastSysTime, sensor_period_ms / portTICK_RATE_MS);
+        }
     }
 }
 
@@ -35,6 +35,7 @@
 
 #include <openpilot.h>
 #include <pid.h>
+#include <filterbank.h>
 #include <stabilizationsettings.h>
 #include <stabilizationbank.h>
 
@@ -45,6 +46,7 @@ typedef struct {
     StabilizationSettingsData settings;
     StabilizationBankData     stabBank;
     float gyro_alpha;
+    struct FilterBank gyroFilterBank;
     struct {
         float min_thrust;
         float max_thrust;
@@ -58,7 +60,8 @@ typedef struct {
         int8_t rateupdates;
     }     monitor;
     float rattitude_mode_transition_stick_position;
-    struct pid innerPids[3], outerPids[3];
+    struct pid3 innerPids;
+    struct pid outerPids[3];
     // TPS [Roll,Pitch,Yaw][P,I,D]
     bool  thrust_pid_scaling_enabled[3][3];
 } StabilizationData;
@@ -63,6 +63,9 @@
 static DelayedCallbackInfo *callbackHandle;
 static float gyro_filtered[3] = { 0, 0, 0 };
 static float axis_lock_accum[3] = { 0, 0, 0 };
+static float rate_interp_from[3] = { 0, 0, 0 };
+static float rate_interp_to[3] = { 0, 0, 0 };
+static uint8_t rate_interp_step = OUTERLOOP_SKIPCOUNT + 1;
 static uint8_t previous_mode[AXES] = { 255, 255, 255, 255 };
 static PiOSDeltatimeConfig timeval;
 static float speedScaleFactor = 1.0f;
@@ -241,13 +244,63 @@ static void stabilizationInnerloopTask()
     float dT;
     dT = PIOS_DELTATIME_GetAverageSeconds(&timeval);
 
-    for (t = 0; t < AXES; t++) {
+    // The outer loop only publishes a new rate setpoint every
+    // OUTERLOOP_SKIPCOUNT gyro updates, so the inner loop would otherwise see
+    // a staircase that puts periodic steps into the D term.  Ramp linearly
+    // from the previous outer loop output to the current one instead.
+    // monitor.rateupdates is reset to 0 by the outer loop and was decremented
+    // once above, so -1 means the outer loop ran right before this cycle.
+    if (stabSettings.monitor.rateupdates == -1) {
+        for (t = 0; t < 3; t++) {
+            rate_interp_from[t] = rate_interp_to[t];
+            rate_interp_to[t]   = rate[t];
+        }
+        rate_interp_step = 1;
+    }
+    if (rate_interp_step <= OUTERLOOP_SKIPCOUNT) {
+        float w = (float)rate_interp_step / (float)OUTERLOOP_SKIPCOUNT;
+        for (t = 0; t < 3; t++) {
+            rate[t] = rate_interp_from[t] + (rate_interp_to[t] - rate_interp_from[t]) * w;
+        }
+        // once the target is reached stop touching the setpoint, so a stalled
+        // outer loop degrades to the old staircase behaviour
+        rate_interp_step++;
+    }
+
+    // When roll, pitch and yaw are all in plain rate mode -- the common
+    // multirotor configuration -- evaluate the three axis PIDs in one fused
+    // pass over the pid3 bank instead of three separate calls
+    bool rate3 = (StabilizationStatusInnerLoopToArray(enabled)[0] == STABILIZATIONSTATUS_INNERLOOP_RATE &&
+                  StabilizationStatusInnerLoopToArray(enabled)[1] == STABILIZATIONSTATUS_INNERLOOP_RATE &&
+                  StabilizationStatusInnerLoopToArray(enabled)[2] == STABILIZATIONSTATUS_INNERLOOP_RATE);
+
+    if (rate3) {
+        pid_scaler scaler[3];
+        for (t = 0; t < 3; t++) {
+            if (previous_mode[t] != STABILIZATIONSTATUS_INNERLOOP_RATE) {
+                previous_mode[t] = STABILIZATIONSTATUS_INNERLOOP_RATE;
+                stabSettings.innerPids.iAccumulator[t] = 0;
+            }
+            // limit rate to maximum configured limits (once here instead of 5 times in outer loop)
+            rate[t] = boundf(rate[t],
+                             -StabilizationBankMaximumRateToArray(stabSettings.stabBank.MaximumRate)[t],
+                             StabilizationBankMaximumRateToArray(stabSettings.stabBank.MaximumRate)[t]
+                             );
+            scaler[t] = create_pid_scaler(t);
+        }
+        pid3_apply_setpoint(&stabSettings.innerPids, scaler, rate, gyro_filtered, dT, actuatorDesiredAxis);
+        for (t = 0; t < 3; t++) {
+            actuatorDesiredAxis[t] = boundf(actuatorDesiredAxis[t], -1.0f, 1.0f);
+        }
+    }
+
+    for (t = rate3 ? 3 : 0; t < AXES; t++) {
         bool reinit = (StabilizationStatusInnerLoopToArray(enabled)[t] != previous_mode[t]);
         previous_mode[t] = StabilizationStatusInnerLoopToArray(enabled)[t];
 
         if (t < STABILIZATIONSTATUS_INNERLOOP_THRUST) {
             if (reinit) {
-                stabSettings.innerPids[t].iAccumulator = 0;
+                stabSettings.innerPids.iAccumulator[t] = 0;
             }
             switch (StabilizationStatusInnerLoopToArray(enabled)[t]) {
             case STABILIZATIONSTATUS_INNERLOOP_VIRTUALFLYBAR:
@@ -272,7 +325,7 @@ static void stabilizationInnerloopTask()
                                  StabilizationBankMaximumRateToArray(stabSettings.stabBank.MaximumRate)[t]
                                  );
                 pid_scaler scaler = create_pid_scaler(t);
-                actuatorDesiredAxis[t] = pid_apply_setpoint(&stabSettings.innerPids[t], &scaler, rate[t], gyro_filtered[t], dT);
+                actuatorDesiredAxis[t] = pid3_apply_setpoint_axis(&stabSettings.innerPids, t, &scaler, rate[t], gyro_filtered[t], dT);
                 break;
             case STABILIZATIONSTATUS_INNERLOOP_ACRO:
             {
@@ -286,7 +339,7 @@ static void stabilizationInnerloopTask()
                                  );
                 pid_scaler ascaler = create_pid_scaler(t);
                 ascaler.i *= boundf(1.0f - (1.5f * fabsf(stickinput[t])), 0.0f, 1.0f); // this prevents Integral from getting too high while controlled manually
-                float arate  = pid_apply_setpoint(&stabSettings.innerPids[t], &ascaler, rate[t], gyro_filtered[t], dT);
+                float arate  = pid3_apply_setpoint_axis(&stabSettings.innerPids, t, &ascaler, rate[t], gyro_filtered[t], dT);
                 float factor = fabsf(stickinput[t]) * stabSettings.stabBank.AcroInsanityFactor;
                 actuatorDesiredAxis[t] = factor * stickinput[t] + (1.0f - factor) * arate;
             }
@@ -322,15 +375,15 @@ static void stabilizationInnerloopTask()
         }
     }
 
-    if (stabSettings.stabBank.EnablePiroComp == STABILIZATIONBANK_ENABLEPIROCOMP_TRUE && stabSettings.innerPids[0].iLim > 1e-3f && stabSettings.innerPids[1].iLim > 1e-3f) {
+    if (stabSettings.stabBank.EnablePiroComp == STABILIZATIONBANK_ENABLEPIROCOMP_TRUE && stabSettings.innerPids.iLim[0] > 1e-3f && stabSettings.innerPids.iLim[1] > 1e-3f) {
         // attempted piro compensation - rotate pitch and yaw integrals (experimental)
         float angleYaw = DEG2RAD(gyro_filtered[2] * dT);
         float sinYaw   = sinf(angleYaw);
         float cosYaw   = cosf(angleYaw);
-        float rollAcc  = stabSettings.innerPids[0].iAccumulator / stabSettings.innerPids[0].iLim;
-        float pitchAcc = stabSettings.innerPids[1].iAccumulator / stabSettings.innerPids[1].iLim;
-        stabSettings.innerPids[0].iAccumulator = stabSettings.innerPids[0].iLim * (cosYaw * rollAcc + sinYaw * pitchAcc);
-        stabSettings.innerPids[1].iAccumulator = stabSettings.innerPids[1].iLim * (cosYaw * pitchAcc - sinYaw * rollAcc);
+        float rollAcc  = stabSettings.innerPids.iAccumulator[0] / stabSettings.innerPids.iLim[0];
+        float pitchAcc = stabSettings.innerPids.iAccumulator[1] / stabSettings.innerPids.iLim[1];
+        stabSettings.innerPids.iAccumulator[0] = stabSettings.innerPids.iLim[0] * (cosYaw * rollAcc + sinYaw * pitchAcc);
+        stabSettings.innerPids.iAccumulator[1] = stabSettings.innerPids.iLim[1] * (cosYaw * pitchAcc - sinYaw * rollAcc);
     }
 
     {
@@ -360,6 +413,8 @@ static void GyroStateUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
     gyro_filtered[1] = gyro_filtered[1] * stabSettings.gyro_alpha + gyroState.y * (1 - stabSettings.gyro_alpha);
     gyro_filtered[2] = gyro_filtered[2] * stabSettings.gyro_alpha + gyroState.z * (1 - stabSettings.gyro_alpha);
 
+    FilterBankApply(&stabSettings.gyroFilterBank, gyro_filtered);
+
     PIOS_CALLBACKSCHEDULER_Dispatch(callbackHandle);
     stabSettings.monitor.gyroupdates++;
 }
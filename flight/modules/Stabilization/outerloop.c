@@ -47,6 +47,7 @@
 #include <cruisecontrol.h>
 #include <altitudeloop.h>
 #include <CoordinateConversions.h>
+#include <vecquat.h>
 
 // Private constants
 
@@ -128,9 +129,10 @@ static void stabilizationOuterloopTask()
         }
 
         RPY2Quaternion(rpy_desired, q_desired);
-        quat_inverse(q_desired);
-        quat_mult(q_desired, &attitudeState.q1, q_error);
-        quat_inverse(q_error);
+        // inline quaternion ops keep the intermediates in registers
+        quatf_conjugate(q_desired);
+        quatf_mult(q_desired, &attitudeState.q1, q_error);
+        quatf_conjugate(q_error);
         Quaternion2RPY(q_error, local_error);
 
 #else /* if defined(PIOS_QUATERNION_STABILIZATION) */
@@ -52,7 +52,9 @@
 
 
 // Public variables
-StabilizationData stabSettings;
+// Read every inner/outer loop iteration and never touched by DMA, so
+// place it in zero-wait-state CCM where the target provides one.
+StabilizationData stabSettings PIOS_MEM_HOT_NODMA_SECTION;
 
 // Private variables
 static int cur_flight_mode = -1;
@@ -113,9 +115,7 @@ int32_t StabilizationInitialize()
     pid_zero(&stabSettings.outerPids[0]);
     pid_zero(&stabSettings.outerPids[1]);
     pid_zero(&stabSettings.outerPids[2]);
-    pid_zero(&stabSettings.innerPids[0]);
-    pid_zero(&stabSettings.innerPids[1]);
-    pid_zero(&stabSettings.innerPids[2]);
+    pid3_zero(&stabSettings.innerPids);
     return 0;
 }
 
@@ -286,22 +286,22 @@ static void BankUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
     StabilizationBankGet(&stabSettings.stabBank);
 
     // Set the roll rate PID constants
-    pid_configure(&stabSettings.innerPids[0], stabSettings.stabBank.RollRatePID.Kp,
-                  stabSettings.stabBank.RollRatePID.Ki,
-                  stabSettings.stabBank.RollRatePID.Kd,
-                  stabSettings.stabBank.RollRatePID.ILimit);
+    pid3_configure_axis(&stabSettings.innerPids, 0, stabSettings.stabBank.RollRatePID.Kp,
+                        stabSettings.stabBank.RollRatePID.Ki,
+                        stabSettings.stabBank.RollRatePID.Kd,
+                        stabSettings.stabBank.RollRatePID.ILimit);
 
     // Set the pitch rate PID constants
-    pid_configure(&stabSettings.innerPids[1], stabSettings.stabBank.PitchRatePID.Kp,
-                  stabSettings.stabBank.PitchRatePID.Ki,
-                  stabSettings.stabBank.PitchRatePID.Kd,
-                  stabSettings.stabBank.PitchRatePID.ILimit);
+    pid3_configure_axis(&stabSettings.innerPids, 1, stabSettings.stabBank.PitchRatePID.Kp,
+                        stabSettings.stabBank.PitchRatePID.Ki,
+                        stabSettings.stabBank.PitchRatePID.Kd,
+                        stabSettings.stabBank.PitchRatePID.ILimit);
 
     // Set the yaw rate PID constants
-    pid_configure(&stabSettings.innerPids[2], stabSettings.stabBank.YawRatePID.Kp,
-                  stabSettings.stabBank.YawRatePID.Ki,
-                  stabSettings.stabBank.YawRatePID.Kd,
-                  stabSettings.stabBank.YawRatePID.ILimit);
+    pid3_configure_axis(&stabSettings.innerPids, 2, stabSettings.stabBank.YawRatePID.Kp,
+                        stabSettings.stabBank.YawRatePID.Ki,
+                        stabSettings.stabBank.YawRatePID.Kd,
+                        stabSettings.stabBank.YawRatePID.ILimit);
 
     // Set the roll attitude PI constants
     pid_configure(&stabSettings.outerPids[0], stabSettings.stabBank.RollPI.Kp,
@@ -361,6 +361,17 @@ static void SettingsUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
         stabSettings.gyro_alpha = expf(-fakeDt / stabSettings.settings.GyroTau);
     }
 
+    // Gyro conditioning filter bank, stages with zero frequency stay disabled
+    FilterBankInit(&stabSettings.gyroFilterBank);
+    if (stabSettings.settings.GyroFilterLowPassFreq > 0.0f) {
+        FilterBankAddLowPass(&stabSettings.gyroFilterBank, stabSettings.settings.GyroFilterLowPassFreq, fakeDt);
+    }
+    for (int i = 0; i < STABILIZATIONSETTINGS_GYROFILTERNOTCHFREQ_NUMELEM; i++) {
+        if ((stabSettings.settings.GyroFilterNotchFreq[i] > 0.0f) && (stabSettings.settings.GyroFilterNotchQ[i] > 0.0f)) {
+            FilterBankAddNotch(&stabSettings.gyroFilterBank, stabSettings.settings.GyroFilterNotchFreq[i], stabSettings.settings.GyroFilterNotchQ[i], fakeDt);
+        }
+    }
+
     // force flight mode update
     cur_flight_mode = -1;
 
@@ -82,6 +82,7 @@ int32_t filterAltitudeInitialize(stateFilter *handle)
 {
     handle->init      = &init;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_LIGHT;
     handle->localdata = pios_malloc(sizeof(struct data));
     HomeLocationInitialize();
     AttitudeStateInitialize();
@@ -42,6 +42,8 @@
 #include <revocalibration.h>
 
 #include <CoordinateConversions.h>
+#include <mathmisc.h>
+#include <vecquat.h>
 #include <pios_notify.h>
 // Private constants
 
@@ -106,6 +108,7 @@ int32_t filterCFInitialize(stateFilter *handle)
     globalInit();
     handle->init      = &initwithoutmag;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_LIGHT;
     handle->localdata = pios_malloc(sizeof(struct data));
     return STACK_REQUIRED;
 }
@@ -115,6 +118,7 @@ int32_t filterCFMInitialize(stateFilter *handle)
     globalInit();
     handle->init      = &initwithmag;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_LIGHT;
     handle->localdata = pios_malloc(sizeof(struct data));
     return STACK_REQUIRED;
 }
@@ -340,54 +344,43 @@ static filterResult complementaryFilter(struct data *this, float gyro[3], float
     float accel_err[3];
     apply_accel_filter(this, grot, this->grot_filtered);
 
-    CrossProduct((const float *)this->accels_filtered, (const float *)this->grot_filtered, accel_err);
+    vector3f_cross(this->accels_filtered, this->grot_filtered, accel_err);
 
-    // Account for accel magnitude
-    float accel_mag = sqrtf(this->accels_filtered[0] * this->accels_filtered[0] + this->accels_filtered[1] * this->accels_filtered[1] + this->accels_filtered[2] * this->accels_filtered[2]);
-    if (accel_mag < 1.0e-3f) {
+    // Account for accel magnitude, the reciprocal square root saves a
+    // division chain on the soft float targets (same trick as the CC
+    // attitude module)
+    float inv_accel_mag = fast_invsqrtf(vector3f_dot(this->accels_filtered, this->accels_filtered));
+    if (inv_accel_mag > 1.0e3f) {
         return FILTERRESULT_CRITICAL; // safety feature copied from CC
     }
 
     // Account for filtered gravity vector magnitude
-    float grot_mag;
+    float inv_grot_mag;
     if (this->accel_filter_enabled) {
-        grot_mag = sqrtf(this->grot_filtered[0] * this->grot_filtered[0] + this->grot_filtered[1] * this->grot_filtered[1] + this->grot_filtered[2] * this->grot_filtered[2]);
+        inv_grot_mag = fast_invsqrtf(vector3f_dot(this->grot_filtered, this->grot_filtered));
     } else {
-        grot_mag = 1.0f;
+        inv_grot_mag = 1.0f;
     }
-    if (grot_mag < 1.0e-3f) {
+    if (inv_grot_mag > 1.0e3f) {
         return FILTERRESULT_CRITICAL;
     }
 
-    accel_err[0] /= (accel_mag * grot_mag);
-    accel_err[1] /= (accel_mag * grot_mag);
-    accel_err[2] /= (accel_mag * grot_mag);
+    vector3f_scale(accel_err, inv_accel_mag * inv_grot_mag);
 
     float mag_err[3] = { 0.0f };
     if (this->magUpdated && this->useMag) {
-        // Rotate gravity to body frame and cross with accels
+        // Rotate the local field estimate to body frame and cross with mag
         float brot[3];
-        float Rbe[3][3];
+        quatf_rotate(attitude, this->homeLocation.Be, brot);
 
-        Quaternion2R(attitude, Rbe);
-
-        rot_mult(Rbe, this->homeLocation.Be, brot);
-
-        float mag_len = sqrtf(mag[0] * mag[0] + mag[1] * mag[1] + mag[2] * mag[2]);
-        mag[0]  /= mag_len;
-        mag[1]  /= mag_len;
-        mag[2]  /= mag_len;
-
-        float bmag = sqrtf(brot[0] * brot[0] + brot[1] * brot[1] + brot[2] * brot[2]);
-        brot[0] /= bmag;
-        brot[1] /= bmag;
-        brot[2] /= bmag;
+        float inv_mag_len = vector3f_normalize_fast(mag);
+        float inv_bmag    = vector3f_normalize_fast(brot);
 
         // Only compute if neither vector is null
-        if (bmag < 1.0f || mag_len < 1.0f) {
+        if (inv_bmag > 1.0f || inv_mag_len > 1.0f) {
             mag_err[0] = mag_err[1] = mag_err[2] = 0.0f;
         } else {
-            CrossProduct((const float *)mag, (const float *)brot, mag_err);
+            vector3f_cross(mag, brot, mag_err);
         }
     } else {
         mag_err[0] = mag_err[1] = mag_err[2] = 0.0f;
@@ -409,27 +402,26 @@ static filterResult complementaryFilter(struct data *this, float gyro[3], float
 
     float gyrotmp[3] = { gyro[0], gyro[1], gyro[2] };
     // Correct rates based on proportional coefficient
-    gyrotmp[0] += accel_err[0] * this->attitudeSettings.AccelKp / dT;
-    gyrotmp[1] += accel_err[1] * this->attitudeSettings.AccelKp / dT;
+    const float accelKpInvdT = this->attitudeSettings.AccelKp / dT;
+    gyrotmp[0] += accel_err[0] * accelKpInvdT;
+    gyrotmp[1] += accel_err[1] * accelKpInvdT;
     if (this->useMag) {
-        gyrotmp[2] += accel_err[2] * this->attitudeSettings.AccelKp / dT + mag_err[2] * this->attitudeSettings.MagKp / dT;
+        gyrotmp[2] += accel_err[2] * accelKpInvdT + mag_err[2] * this->attitudeSettings.MagKp / dT;
     } else {
-        gyrotmp[2] += accel_err[2] * this->attitudeSettings.AccelKp / dT;
+        gyrotmp[2] += accel_err[2] * accelKpInvdT;
     }
 
     // Work out time derivative from INSAlgo writeup
     // Also accounts for the fact that gyros are in deg/s
+    float omega[3] = { DEG2RAD(gyrotmp[0]), DEG2RAD(gyrotmp[1]), DEG2RAD(gyrotmp[2]) };
     float qdot[4];
-    qdot[0]     = DEG2RAD(-attitude[1] * gyrotmp[0] - attitude[2] * gyrotmp[1] - attitude[3] * gyrotmp[2]) * dT / 2;
-    qdot[1]     = DEG2RAD(attitude[0] * gyrotmp[0] - attitude[3] * gyrotmp[1] + attitude[2] * gyrotmp[2]) * dT / 2;
-    qdot[2]     = DEG2RAD(attitude[3] * gyrotmp[0] + attitude[0] * gyrotmp[1] - attitude[1] * gyrotmp[2]) * dT / 2;
-    qdot[3]     = DEG2RAD(-attitude[2] * gyrotmp[0] + attitude[1] * gyrotmp[1] + attitude[0] * gyrotmp[2]) * dT / 2;
+    quatf_derivative(attitude, omega, qdot);
 
     // Take a time step
-    attitude[0] = attitude[0] + qdot[0];
-    attitude[1] = attitude[1] + qdot[1];
-    attitude[2] = attitude[2] + qdot[2];
-    attitude[3] = attitude[3] + qdot[3];
+    attitude[0] = attitude[0] + qdot[0] * dT;
+    attitude[1] = attitude[1] + qdot[1] * dT;
+    attitude[2] = attitude[2] + qdot[2] * dT;
+    attitude[3] = attitude[3] + qdot[3] * dT;
 
     if (attitude[0] < 0.0f) {
         attitude[0] = -attitude[0];
@@ -439,15 +431,11 @@ static filterResult complementaryFilter(struct data *this, float gyro[3], float
     }
 
     // Renomalize
-    float qmag = sqrtf(attitude[0] * attitude[0] + attitude[1] * attitude[1] + attitude[2] * attitude[2] + attitude[3] * attitude[3]);
-    attitude[0] = attitude[0] / qmag;
-    attitude[1] = attitude[1] / qmag;
-    attitude[2] = attitude[2] / qmag;
-    attitude[3] = attitude[3] / qmag;
+    float inv_qmag = quatf_normalize_fast(attitude);
 
     // If quaternion has become inappropriately short or is nan reinit.
     // THIS SHOULD NEVER ACTUALLY HAPPEN
-    if ((fabsf(qmag) < 1.0e-3f) || isnan(qmag)) {
+    if ((fabsf(inv_qmag) > 1.0e3f) || isnan(inv_qmag)) {
         this->first_run = 1;
         return FILTERRESULT_WARNING;
     }
@@ -8,8 +8,9 @@
  *
  * @file       filterekf.c
  * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2013.
- * @brief      Extended Kalman Filter. Calculates complete system state except
- *             accelerometer drift.
+ * @brief      Extended Kalman Filter. Calculates complete system state.
+ *             Accelerometer drift is only estimated when the firmware was
+ *             linked against the 16 state INS library (USE_INS16=YES).
  *
  * @see        The GNU Public License (GPL) Version 3
  *
@@ -63,6 +64,7 @@ struct data {
     HomeLocationData     homeLocation;
 
     bool    usePos;
+    bool    use16states;
 
     int32_t init_stage;
 
@@ -81,6 +83,8 @@ static bool initialized = 0;
 
 static int32_t init13i(stateFilter *self);
 static int32_t init13(stateFilter *self);
+static int32_t init16i(stateFilter *self);
+static int32_t init16(stateFilter *self);
 static int32_t maininit(stateFilter *self);
 static filterResult filter(stateFilter *self, stateEstimation *state);
 static inline bool invalid_var(float data);
@@ -103,6 +107,7 @@ int32_t filterEKF13iInitialize(stateFilter *handle)
     globalInit();
     handle->init      = &init13i;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_HEAVY;
     handle->localdata = pios_malloc(sizeof(struct data));
     return STACK_REQUIRED;
 }
@@ -111,25 +116,25 @@ int32_t filterEKF13Initialize(stateFilter *handle)
     globalInit();
     handle->init      = &init13;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_HEAVY;
     handle->localdata = pios_malloc(sizeof(struct data));
     return STACK_REQUIRED;
 }
-// XXX
-// TODO: Until the 16 state EKF is implemented, run 13 state, so compilation runs through
-// XXX
 int32_t filterEKF16iInitialize(stateFilter *handle)
 {
     globalInit();
-    handle->init      = &init13i;
+    handle->init      = &init16i;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_HEAVY;
     handle->localdata = pios_malloc(sizeof(struct data));
     return STACK_REQUIRED;
 }
 int32_t filterEKF16Initialize(stateFilter *handle)
 {
     globalInit();
-    handle->init      = &init13;
+    handle->init      = &init16;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_HEAVY;
     handle->localdata = pios_malloc(sizeof(struct data));
     return STACK_REQUIRED;
 }
@@ -139,7 +144,8 @@ static int32_t init13i(stateFilter *self)
 {
     struct data *this = (struct data *)self->localdata;
 
-    this->usePos = 0;
+    this->usePos      = 0;
+    this->use16states = 0;
     return maininit(self);
 }
 
@@ -147,7 +153,26 @@ static int32_t init13(stateFilter *self)
 {
     struct data *this = (struct data *)self->localdata;
 
-    this->usePos = 1;
+    this->usePos      = 1;
+    this->use16states = 0;
+    return maininit(self);
+}
+
+static int32_t init16i(stateFilter *self)
+{
+    struct data *this = (struct data *)self->localdata;
+
+    this->usePos      = 0;
+    this->use16states = 1;
+    return maininit(self);
+}
+
+static int32_t init16(stateFilter *self)
+{
+    struct data *this = (struct data *)self->localdata;
+
+    this->usePos      = 1;
+    this->use16states = 1;
     return maininit(self);
 }
 
@@ -158,6 +183,11 @@ static int32_t maininit(stateFilter *self)
     this->inited       = false;
     this->init_stage   = 0;
     this->work.updated = 0;
+    // 13 and 16 state INS share the same interface but only one of them is
+    // linked into the firmware - refuse to init a 16 state chain without it
+    if (this->use16states && ins_get_num_states() < 16) {
+        return 2;
+    }
     PIOS_DELTATIME_Init(&this->dtconfig, DT_INIT, DT_MIN, DT_MAX, DT_ALPHA);
 
     EKFConfigurationGet(&this->ekfConfiguration);
@@ -258,6 +288,11 @@ static filterResult filter(stateFilter *self, stateEstimation *state)
                                            this->ekfConfiguration.Q.GyroDriftY,
                                            this->ekfConfiguration.Q.GyroDriftZ }
                               );
+            // a no-op on the 13 state INS which has no accel bias states
+            INSSetAccelBiasVar((float[3]) { this->ekfConfiguration.Q.AccelDriftX,
+                                            this->ekfConfiguration.Q.AccelDriftY,
+                                            this->ekfConfiguration.Q.AccelDriftZ }
+                               );
             INSSetBaroVar(this->ekfConfiguration.R.BaroZ);
 
             // Initialize the gyro bias
@@ -424,7 +459,9 @@ static filterResult filter(stateFilter *self, stateEstimation *state)
     INSGetP(EKFStateVariancePToArray(vardata.P));
     EKFStateVarianceSet(&vardata);
     int t;
-    for (t = 0; t < EKFSTATEVARIANCE_P_NUMELEM; t++) {
+    // on a 13 state INS the accel drift elements of P are never filled in
+    int numStates = ins_get_num_states();
+    for (t = 0; t < EKFSTATEVARIANCE_P_NUMELEM && t < numStates; t++) {
         if (!IS_REAL(EKFStateVariancePToArray(vardata.P)[t]) || EKFStateVariancePToArray(vardata.P)[t] <= 0.0f) {
             INSResetP(EKFConfigurationPToArray(this->ekfConfiguration.P));
             this->init_stage = -1;
@@ -46,32 +46,43 @@ struct data {
     HomeLocationData home;
     double HomeECEF[3];
     float HomeRne[3][3];
+    LLA2BaseLinearization HomeLin;
 };
 
 // Private variables
 
+// set by the HomeLocation callback so the cached transforms are rebuilt on
+// the next fix instead of staying keyed to a stale home position
+static volatile bool homeUpdated;
+
 // Private functions
 
 static int32_t init(stateFilter *self);
 static filterResult filter(stateFilter *self, stateEstimation *state);
+static void homeLocationUpdatedCb(UAVObjEvent *ev);
+static void updateHomeReference(struct data *this);
 
 
 int32_t filterLLAInitialize(stateFilter *handle)
 {
     handle->init      = &init;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_LIGHT;
     handle->localdata = pios_malloc(sizeof(struct data));
     GPSSettingsInitialize();
     GPSPositionSensorInitialize();
     HomeLocationInitialize();
+    HomeLocationConnectCallback(&homeLocationUpdatedCb);
     return STACK_REQUIRED;
 }
 
-static int32_t init(__attribute__((unused)) stateFilter *self)
+static void homeLocationUpdatedCb(__attribute__((unused)) UAVObjEvent *ev)
 {
-    struct data *this = (struct data *)self->localdata;
+    homeUpdated = true;
+}
 
-    GPSSettingsGet(&this->settings);
+static void updateHomeReference(struct data *this)
+{
     HomeLocationGet(&this->home);
     if (this->home.Set == HOMELOCATION_SET_TRUE) {
         // calculate home location coordinate reference
@@ -82,7 +93,17 @@ static int32_t init(__attribute__((unused)) stateFilter *self)
         };
         LLA2ECEF(LLAi, this->HomeECEF);
         RneFromLLA(LLAi, this->HomeRne);
+        LLA2BaseLinearizedInit(&this->HomeLin, LLAi);
     }
+}
+
+static int32_t init(__attribute__((unused)) stateFilter *self)
+{
+    struct data *this = (struct data *)self->localdata;
+
+    GPSSettingsGet(&this->settings);
+    homeUpdated = false;
+    updateHomeReference(this);
     return 0;
 }
 
@@ -90,6 +111,12 @@ static filterResult filter(__attribute__((unused)) stateFilter *self, stateEstim
 {
     struct data *this = (struct data *)self->localdata;
 
+    // rebuild the cached home transforms if the home location moved
+    if (homeUpdated) {
+        homeUpdated = false;
+        updateHomeReference(this);
+    }
+
     // cannot update local NED if home location is unset
     if (this->home.Set != HOMELOCATION_SET_TRUE) {
         return FILTERRESULT_WARNING;
@@ -111,7 +138,12 @@ static filterResult filter(__attribute__((unused)) stateFilter *self, stateEstim
                 gpsdata.Longitude,
                 (int32_t)((gpsdata.Altitude + gpsdata.GeoidSeparation) * 1e4f),
             };
-            LLA2Base(LLAi, this->HomeECEF, this->HomeRne, state->pos);
+            // close to home the precomputed linearization avoids the double
+            // precision ECEF trip every fix; far away fall back to the exact
+            // conversion
+            if (!LLA2BaseLinearized(&this->HomeLin, LLAi, state->pos)) {
+                LLA2Base(LLAi, this->HomeECEF, this->HomeRne, state->pos);
+            }
             state->updated |= SENSORUPDATES_pos;
         }
     }
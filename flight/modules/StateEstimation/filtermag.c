@@ -71,6 +71,7 @@ int32_t filterMagInitialize(stateFilter *handle)
 {
     handle->init      = &init;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_LIGHT;
     handle->localdata = pios_malloc(sizeof(struct data));
     HomeLocationInitialize();
     return STACK_REQUIRED;
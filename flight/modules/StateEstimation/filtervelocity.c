@@ -64,6 +64,7 @@ int32_t filterVelocityInitialize(stateFilter *handle)
 {
     handle->init      = &init;
     handle->filter    = &filter;
+    handle->cost      = FILTERCOST_LIGHT;
     handle->localdata = pios_malloc(sizeof(struct data));
     return STACK_REQUIRED;
 }
@@ -75,9 +75,19 @@ typedef struct {
     sensorUpdates updated;
 } stateEstimation;
 
+// Cost class of a filter stage.  The state estimation callback batches
+// consecutive light stages into a single invocation but yields back to
+// the callback scheduler before and after every heavy one, so that other
+// callbacks (e.g. Stabilization) can interleave with the expensive math.
+typedef enum {
+    FILTERCOST_LIGHT = 0,
+    FILTERCOST_HEAVY = 1,
+} filterCost;
+
 typedef struct stateFilterStruct {
     int32_t (*init)(struct stateFilterStruct *self);
     filterResult (*filter)(struct stateFilterStruct *self, stateEstimation *state);
+    filterCost cost;
     void *localdata;
 } stateFilter;
 
@@ -156,6 +156,8 @@ static stateFilter cfFilter;
 static stateFilter cfmFilter;
 static stateFilter ekf13iFilter;
 static stateFilter ekf13Filter;
+static stateFilter ekf16iFilter;
+static stateFilter ekf16Filter;
 
 // this is a hack to provide a computational shortcut for faster gyro state progression
 static float gyroRaw[3];
@@ -249,6 +251,44 @@ static const filterPipeline *ekf13Queue = &(filterPipeline) {
         }
     }
 };
+static const filterPipeline *ekf16iQueue = &(filterPipeline) {
+    .filter = &magFilter,
+    .next   = &(filterPipeline) {
+        .filter = &airFilter,
+        .next   = &(filterPipeline) {
+            .filter = &baroiFilter,
+            .next   = &(filterPipeline) {
+                .filter = &stationaryFilter,
+                .next   = &(filterPipeline) {
+                    .filter = &ekf16iFilter,
+                    .next   = &(filterPipeline) {
+                        .filter = &velocityFilter,
+                        .next   = NULL,
+                    }
+                }
+            }
+        }
+    }
+};
+static const filterPipeline *ekf16Queue = &(filterPipeline) {
+    .filter = &magFilter,
+    .next   = &(filterPipeline) {
+        .filter = &airFilter,
+        .next   = &(filterPipeline) {
+            .filter = &llaFilter,
+            .next   = &(filterPipeline) {
+                .filter = &baroFilter,
+                .next   = &(filterPipeline) {
+                    .filter = &ekf16Filter,
+                    .next   = &(filterPipeline) {
+                        .filter = &velocityFilter,
+                        .next   = NULL,
+                    }
+                }
+            }
+        }
+    }
+};
 
 // Private functions
 
@@ -317,6 +357,8 @@ int32_t StateEstimationInitialize(void)
     stack_required = maxint32_t(stack_required, filterCFMInitialize(&cfmFilter));
     stack_required = maxint32_t(stack_required, filterEKF13iInitialize(&ekf13iFilter));
     stack_required = maxint32_t(stack_required, filterEKF13Initialize(&ekf13Filter));
+    stack_required = maxint32_t(stack_required, filterEKF16iInitialize(&ekf16iFilter));
+    stack_required = maxint32_t(stack_required, filterEKF16Initialize(&ekf16Filter));
 
     stateEstimationCallback = PIOS_CALLBACKSCHEDULER_Create(&StateEstimationCb, CALLBACK_PRIORITY, TASK_PRIORITY, CALLBACKINFO_RUNNING_STATEESTIMATION, stack_required);
 
@@ -397,6 +439,12 @@ static void StateEstimationCb(void)
                 case REVOSETTINGS_FUSIONALGORITHM_GPSNAVIGATIONINS13:
                     newFilterChain = ekf13Queue;
                     break;
+                case REVOSETTINGS_FUSIONALGORITHM_INS16INDOOR:
+                    newFilterChain = ekf16iQueue;
+                    break;
+                case REVOSETTINGS_FUSIONALGORITHM_GPSNAVIGATIONINS16:
+                    newFilterChain = ekf16Queue;
+                    break;
                 default:
                     newFilterChain = NULL;
                 }
@@ -454,12 +502,19 @@ static void StateEstimationCb(void)
 
     case RUNSTATE_FILTER:
 
+        // batch consecutive light stages into this invocation, but yield
+        // back to the scheduler before and after every heavy stage so other
+        // callbacks can interleave with the expensive math
         if (current != NULL) {
-            filterResult result = current->filter->filter((stateFilter *)current->filter, &states);
-            if (result > alarm) {
-                alarm = result;
-            }
-            current = current->next;
+            bool yield = false;
+            do {
+                filterResult result = current->filter->filter((stateFilter *)current->filter, &states);
+                if (result > alarm) {
+                    alarm = result;
+                }
+                yield   = (current->filter->cost == FILTERCOST_HEAVY);
+                current = current->next;
+            } while (current != NULL && !yield && current->filter->cost == FILTERCOST_LIGHT);
         }
 
         // we are not done, re-dispatch self execution
@@ -510,7 +565,7 @@ static void StateEstimationCb(void)
             s.q2 = states.attitude[1];
             s.q3 = states.attitude[2];
             s.q4 = states.attitude[3];
-            Quaternion2RPY(&s.q1, &s.Roll);
+            Quaternion2RPYFast(&s.q1, &s.Roll);
             AttitudeStateSet(&s);
         }
 
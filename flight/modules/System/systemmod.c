@@ -54,9 +54,16 @@
 #include <systemsettings.h>
 #include <i2cstats.h>
 #include <taskinfo.h>
+#include <taskstats.h>
 #include <watchdogstatus.h>
 #include <callbackinfo.h>
 #include <hwsettings.h>
+#ifdef PIOS_INCLUDE_MEM_POOLS
+#include <memorystats.h>
+#endif
+#ifdef PIOS_INCLUDE_COM_STATS
+#include <comstats.h>
+#endif
 #include <pios_flashfs.h>
 #include <pios_notify.h>
 
@@ -83,6 +90,9 @@
 
 // Private constants
 #define SYSTEM_UPDATE_PERIOD_MS 250
+// Length of the task statistics sampling window, samples are taken every
+// SYSTEM_UPDATE_PERIOD_MS so this must be a multiple of it
+#define TASKSTATS_UPDATE_PERIOD_MS 10000
 
 #if defined(PIOS_SYSTEM_STACK_SIZE)
 #define STACK_SIZE_BYTES        PIOS_SYSTEM_STACK_SIZE
@@ -92,10 +102,16 @@
 
 #define TASK_PRIORITY           (tskIDLE_PRIORITY + 1)
 
+/* Persistence worker, saves and loads must never stall System housekeeping */
+#define PERSISTENCE_STACK_SIZE_BYTES 800
+#define PERSISTENCE_TASK_PRIORITY    (tskIDLE_PRIORITY + 1)
+#define PERSISTENCE_QUEUE_SIZE       4
+
 // Private types
 
 // Private variables
 static xTaskHandle systemTaskHandle;
+static xTaskHandle persistenceTaskHandle;
 static xQueueHandle objectPersistenceQueue;
 static enum { STACKOVERFLOW_NONE = 0, STACKOVERFLOW_WARNING = 1, STACKOVERFLOW_CRITICAL = 3 } stackOverflow;
 static bool mallocFailed;
@@ -108,11 +124,19 @@ static void objectUpdatedCb(UAVObjEvent *ev);
 static void checkSettingsUpdatedCb(UAVObjEvent *ev);
 #ifdef DIAG_TASKS
 static void taskMonitorForEachCallback(uint16_t task_id, const struct pios_task_info *task_info, void *context);
+static void taskStatsForEachCallback(uint16_t task_id, const struct pios_task_stats *task_stats, void *context);
 static void callbackSchedulerForEachCallback(int16_t callback_id, const struct pios_callback_info *callback_info, void *context);
 #endif
 static void updateStats();
+#ifdef PIOS_INCLUDE_MEM_POOLS
+static void updateMemoryStats();
+#endif
+#ifdef PIOS_INCLUDE_COM_STATS
+static void updateComStats();
+#endif
 static void updateSystemAlarms();
 static void systemTask(void *parameters);
+static void persistenceTask(void *parameters);
 #ifdef DIAG_I2C_WDG_STATS
 static void updateI2Cstats();
 static void updateWDGstats();
@@ -134,6 +158,9 @@ int32_t SystemModStart(void)
     xTaskCreate(systemTask, "System", STACK_SIZE_BYTES / 4, NULL, TASK_PRIORITY, &systemTaskHandle);
     // Register task
     PIOS_TASK_MONITOR_RegisterTask(TASKINFO_RUNNING_SYSTEM, systemTaskHandle);
+    // Create the persistence worker so flash saves never block the system task
+    xTaskCreate(persistenceTask, "Persistence", PERSISTENCE_STACK_SIZE_BYTES / 4, NULL, PERSISTENCE_TASK_PRIORITY, &persistenceTaskHandle);
+    PIOS_TASK_MONITOR_RegisterTask(TASKINFO_RUNNING_PERSISTENCE, persistenceTaskHandle);
 
     return 0;
 }
@@ -151,18 +178,25 @@ int32_t SystemModInitialize(void)
     ObjectPersistenceInitialize();
 #ifdef DIAG_TASKS
     TaskInfoInitialize();
+    TaskStatsInitialize();
     CallbackInfoInitialize();
 #endif
 #ifdef DIAG_I2C_WDG_STATS
     I2CStatsInitialize();
     WatchdogStatusInitialize();
 #endif
+#ifdef PIOS_INCLUDE_MEM_POOLS
+    MemoryStatsInitialize();
+#endif
+#ifdef PIOS_INCLUDE_COM_STATS
+    ComStatsInitialize();
+#endif
 
 #ifdef PIOS_INCLUDE_INSTRUMENTATION
     InstrumentationInit();
 #endif
 
-    objectPersistenceQueue = xQueueCreate(1, sizeof(UAVObjEvent));
+    objectPersistenceQueue = xQueueCreate(PERSISTENCE_QUEUE_SIZE, sizeof(UAVObjEvent));
     if (objectPersistenceQueue == NULL) {
         return -1;
     }
@@ -195,6 +229,11 @@ static void systemTask(__attribute__((unused)) void *parameters)
     /* Record a successful boot */
     PIOS_IAP_WriteBootCount(0);
 #endif
+
+    /* Initialize and start the deferred modules. The critical module tasks
+     * created above are already running at higher priority, so slow
+     * initializations here no longer hold up the armable state. */
+    MODULE_INITIALISE_DEFERRED;
     // Listen for SettingPersistance object updates, connect a callback function
     ObjectPersistenceConnectQueue(objectPersistenceQueue);
 
@@ -214,6 +253,14 @@ static void systemTask(__attribute__((unused)) void *parameters)
         NotificationUpdateStatus();
         // Update the system statistics
         updateStats();
+#ifdef PIOS_INCLUDE_MEM_POOLS
+        // Update the memory pool statistics
+        updateMemoryStats();
+#endif
+#ifdef PIOS_INCLUDE_COM_STATS
+        // Update the com port statistics
+        updateComStats();
+#endif
         // Update the system alarms
         updateSystemAlarms();
 #ifdef DIAG_I2C_WDG_STATS
@@ -229,6 +276,12 @@ static void systemTask(__attribute__((unused)) void *parameters)
         // Update the task status object
         PIOS_TASK_MONITOR_ForEachTask(taskMonitorForEachCallback, &taskInfoData);
         TaskInfoSet(&taskInfoData);
+        // Publish the task statistics window and start a new one
+        static uint8_t taskStatsLoopCount;
+        if (++taskStatsLoopCount >= (TASKSTATS_UPDATE_PERIOD_MS / SYSTEM_UPDATE_PERIOD_MS)) {
+            taskStatsLoopCount = 0;
+            PIOS_TASK_MONITOR_ForEachTaskStats(taskStatsForEachCallback, NULL);
+        }
         // Update the callback status object
 // if(FALSE){
         PIOS_CALLBACKSCHEDULER_ForEachCallback(callbackSchedulerForEachCallback, &callbackInfoData);
@@ -238,7 +291,6 @@ static void systemTask(__attribute__((unused)) void *parameters)
 // }
 
 
-        UAVObjEvent ev;
         int delayTime = SYSTEM_UPDATE_PERIOD_MS;
 
 #if defined(PIOS_INCLUDE_RFM22B)
@@ -257,8 +309,10 @@ static void systemTask(__attribute__((unused)) void *parameters)
 
             // Update the OPLInk status
             static bool first_time = true;
-            static uint16_t prev_tx_count = 0;
-            static uint16_t prev_rx_count = 0;
+            static uint16_t prev_tx_count  = 0;
+            static uint16_t prev_rx_count  = 0;
+            static uint16_t prev_ppm_count = 0;
+            static uint16_t prev_com_count = 0;
             oplinkStatus.HeapRemaining = xPortGetFreeHeapSize();
             oplinkStatus.DeviceID = PIOS_RFM22B_DeviceID(pios_rfm22b_id);
             oplinkStatus.RxGood = radio_stats.rx_good;
@@ -276,14 +330,22 @@ static void systemTask(__attribute__((unused)) void *parameters)
             if (first_time) {
                 first_time = false;
             } else {
-                uint16_t tx_count = radio_stats.tx_byte_count;
-                uint16_t rx_count = radio_stats.rx_byte_count;
-                uint16_t tx_bytes = (tx_count < prev_tx_count) ? (0xffff - prev_tx_count + tx_count) : (tx_count - prev_tx_count);
-                uint16_t rx_bytes = (rx_count < prev_rx_count) ? (0xffff - prev_rx_count + rx_count) : (rx_count - prev_rx_count);
-                oplinkStatus.TXRate = (uint16_t)((float)(tx_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
-                oplinkStatus.RXRate = (uint16_t)((float)(rx_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
-                prev_tx_count = tx_count;
-                prev_rx_count = rx_count;
+                uint16_t tx_count  = radio_stats.tx_byte_count;
+                uint16_t rx_count  = radio_stats.rx_byte_count;
+                uint16_t ppm_count = radio_stats.tx_ppm_byte_count;
+                uint16_t com_count = radio_stats.tx_com_byte_count;
+                uint16_t tx_bytes  = (tx_count < prev_tx_count) ? (0xffff - prev_tx_count + tx_count) : (tx_count - prev_tx_count);
+                uint16_t rx_bytes  = (rx_count < prev_rx_count) ? (0xffff - prev_rx_count + rx_count) : (rx_count - prev_rx_count);
+                uint16_t ppm_bytes = (ppm_count < prev_ppm_count) ? (0xffff - prev_ppm_count + ppm_count) : (ppm_count - prev_ppm_count);
+                uint16_t com_bytes = (com_count < prev_com_count) ? (0xffff - prev_com_count + com_count) : (com_count - prev_com_count);
+                oplinkStatus.TXRate    = (uint16_t)((float)(tx_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
+                oplinkStatus.RXRate    = (uint16_t)((float)(rx_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
+                oplinkStatus.TXPPMRate = (uint16_t)((float)(ppm_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
+                oplinkStatus.TXComRate = (uint16_t)((float)(com_bytes * 1000) / SYSTEM_UPDATE_PERIOD_MS);
+                prev_tx_count  = tx_count;
+                prev_rx_count  = rx_count;
+                prev_ppm_count = ppm_count;
+                prev_com_count = com_count;
             }
             oplinkStatus.TXSeq     = radio_stats.tx_seq;
             oplinkStatus.RXSeq     = radio_stats.rx_seq;
@@ -296,7 +358,21 @@ static void systemTask(__attribute__((unused)) void *parameters)
 
 #endif /* if defined(PIOS_INCLUDE_RFM22B) */
 
-        if (xQueueReceive(objectPersistenceQueue, &ev, delayTime) == pdTRUE) {
+        vTaskDelay(delayTime / portTICK_RATE_MS);
+    }
+}
+
+/**
+ * Persistence task, drains the ObjectPersistence request queue and runs
+ * the flash operations at low priority so a save-all from the GCS never
+ * starves the system task's alarm and sanity check duties
+ */
+static void persistenceTask(__attribute__((unused)) void *parameters)
+{
+    UAVObjEvent ev;
+
+    while (1) {
+        if (xQueueReceive(objectPersistenceQueue, &ev, portMAX_DELAY) == pdTRUE) {
             // If object persistence is updated call the callback
             objectUpdatedCb(&ev);
         }
@@ -360,7 +436,8 @@ static void objectUpdatedCb(UAVObjEvent *ev)
                     retval = UAVObjLoad(obj, objper.InstanceID);
                 }
             } else if (objper.Selection == OBJECTPERSISTENCE_SELECTION_ALLSETTINGS || objper.Selection == OBJECTPERSISTENCE_SELECTION_ALLOBJECTS) {
-                retval = UAVObjSaveSettings();
+                // Only write objects that differ from their flash copy
+                retval = UAVObjSaveDirtySettings();
             } else if (objper.Selection == OBJECTPERSISTENCE_SELECTION_ALLMETAOBJECTS || objper.Selection == OBJECTPERSISTENCE_SELECTION_ALLOBJECTS) {
                 retval = UAVObjSaveMetaobjects();
             }
@@ -378,6 +455,20 @@ static void objectUpdatedCb(UAVObjEvent *ev)
             } else if (objper.Selection == OBJECTPERSISTENCE_SELECTION_ALLMETAOBJECTS || objper.Selection == OBJECTPERSISTENCE_SELECTION_ALLOBJECTS) {
                 retval = UAVObjDeleteMetaobjects();
             }
+        } else if (objper.Operation == OBJECTPERSISTENCE_OPERATION_DIGEST) {
+            // Get selected object
+            obj = UAVObjGetByID(objper.ObjectID);
+            if (obj == 0) {
+                return;
+            }
+            // Report the settings digest so the GCS can skip objects
+            // that already match its local profile
+            objper.CRC = UAVObjGetSettingsCRC(obj);
+            retval     = 0;
+        } else if (objper.Operation == OBJECTPERSISTENCE_OPERATION_SNAPSHOT) {
+            retval = UAVObjSnapshotSettings();
+        } else if (objper.Operation == OBJECTPERSISTENCE_OPERATION_REVERT) {
+            retval = UAVObjRevertSettings();
         } else if (objper.Operation == OBJECTPERSISTENCE_OPERATION_FULLERASE) {
 #if defined(PIOS_INCLUDE_FLASH_LOGFS_SETTINGS)
             retval = PIOS_FLASHFS_Format(0);
@@ -429,6 +520,27 @@ static void taskMonitorForEachCallback(uint16_t task_id, const struct pios_task_
     ((uint8_t *)&taskData->RunningTime)[task_id] = task_info->running_time_percentage;
 }
 
+static void taskStatsForEachCallback(uint16_t task_id, const struct pios_task_stats *task_stats, __attribute__((unused)) void *context)
+{
+    static uint16_t publishedTaskStatsInstances = 1;
+
+    if (!task_stats->is_running) {
+        return;
+    }
+    // One TaskStats instance per monitored task, created on first sight
+    while (publishedTaskStatsInstances < task_id + 1) {
+        TaskStatsCreateInstance();
+        publishedTaskStatsInstances++;
+    }
+    TaskStatsData data;
+    PIOS_STATIC_ASSERT(sizeof(data.LoadHistogram) == sizeof(task_stats->load_histogram));
+    data.TaskId = task_id;
+    memcpy(data.LoadHistogram, task_stats->load_histogram, sizeof(data.LoadHistogram));
+    data.MaxLoad = task_stats->max_load;
+    data.StackLowWater = task_stats->stack_low_water;
+    TaskStatsInstSet(task_id, &data);
+}
+
 static void callbackSchedulerForEachCallback(int16_t callback_id, const struct pios_callback_info *callback_info, void *context)
 {
     CallbackInfoData *callbackData = (CallbackInfoData *)context;
@@ -446,6 +558,11 @@ static void callbackSchedulerForEachCallback(int16_t callback_id, const struct p
     ((uint8_t *)&callbackData->Running)[callback_id] = callback_info->is_running;
     ((uint32_t *)&callbackData->RunningTime)[callback_id]   = callback_info->running_time_count;
     ((int16_t *)&callbackData->StackRemaining)[callback_id] = callback_info->stack_remaining;
+    ((uint32_t *)&callbackData->RuntimeMin)[callback_id]    = callback_info->runtime_min;
+    ((uint32_t *)&callbackData->RuntimeMax)[callback_id]    = callback_info->runtime_max;
+    ((uint32_t *)&callbackData->RuntimeAvg)[callback_id]    = callback_info->runtime_avg;
+    ((uint32_t *)&callbackData->LatencyAvg)[callback_id]    = callback_info->latency_avg;
+    ((uint32_t *)&callbackData->MissedDeadlines)[callback_id] = callback_info->missed_deadlines;
 }
 #endif /* ifdef DIAG_TASKS */
 
@@ -561,6 +678,82 @@ static void updateStats()
     SystemStatsSet(&stats);
 }
 
+#ifdef PIOS_INCLUDE_MEM_POOLS
+/**
+ * Called periodically to publish the pios_mem pool occupancy
+ */
+static void updateMemoryStats()
+{
+    MemoryStatsData memStats;
+    struct pios_mem_pool_stats poolStats;
+
+    MemoryStatsGet(&memStats);
+    for (uint8_t i = 0; i < PIOS_MEM_NUM_POOLS && i < MEMORYSTATS_POOLINUSE_NUMELEM; i++) {
+        if (!PIOS_MEM_GetPoolStats(i, &poolStats)) {
+            continue;
+        }
+        memStats.PoolBlockSize[i] = poolStats.block_size;
+        memStats.PoolBlocks[i]    = poolStats.num_blocks;
+        memStats.PoolInUse[i]     = poolStats.in_use;
+        memStats.PoolHighWater[i] = poolStats.high_water;
+        memStats.PoolFallbacks[i] = poolStats.fallbacks;
+    }
+    memStats.HeapRemaining = xPortGetFreeHeapSize();
+    MemoryStatsSet(&memStats);
+}
+#endif /* PIOS_INCLUDE_MEM_POOLS */
+
+#ifdef PIOS_INCLUDE_COM_STATS
+static void fillComStats(uint32_t com_id, uint8_t port, ComStatsData *data)
+{
+    struct pios_com_stats stats;
+
+    if (PIOS_COM_GetStats(com_id, &stats) < 0) {
+        /* Port not configured on this board/session, leave its elements at 0 */
+        return;
+    }
+    data->RxBytes[port]     = stats.rx_bytes;
+    data->TxBytes[port]     = stats.tx_bytes;
+    data->RxDropped[port]   = stats.rx_dropped;
+    data->TxDropped[port]   = stats.tx_dropped;
+    data->RxHighWater[port] = stats.rx_high_water;
+    data->TxHighWater[port] = stats.tx_high_water;
+}
+
+/**
+ * Called periodically to publish the PIOS_COM port counters
+ */
+static void updateComStats()
+{
+    ComStatsData comStats;
+
+    memset(&comStats, 0, sizeof(comStats));
+    /* All fields share the same element names, index with the RxBytes enum */
+#ifdef PIOS_COM_TELEM_RF
+    fillComStats(PIOS_COM_TELEM_RF, COMSTATS_RXBYTES_TELEMRF, &comStats);
+#endif
+#ifdef PIOS_COM_TELEM_USB
+    fillComStats(PIOS_COM_TELEM_USB, COMSTATS_RXBYTES_TELEMUSB, &comStats);
+#endif
+#ifdef PIOS_COM_GPS
+    fillComStats(PIOS_COM_GPS, COMSTATS_RXBYTES_GPS, &comStats);
+#endif
+#ifdef PIOS_COM_RF
+    fillComStats(PIOS_COM_RF, COMSTATS_RXBYTES_RF, &comStats);
+#endif
+#ifdef PIOS_COM_BRIDGE
+    fillComStats(PIOS_COM_BRIDGE, COMSTATS_RXBYTES_BRIDGE, &comStats);
+#endif
+#ifdef PIOS_COM_VCP
+    fillComStats(PIOS_COM_VCP, COMSTATS_RXBYTES_VCP, &comStats);
+#endif
+#ifdef PIOS_COM_OSDHK
+    fillComStats(PIOS_COM_OSDHK, COMSTATS_RXBYTES_OSDHK, &comStats);
+#endif
+    ComStatsSet(&comStats);
+}
+#endif /* PIOS_INCLUDE_COM_STATS */
+
 /**
  * Update system alarms
  */
@@ -64,6 +64,13 @@
 #define STATS_UPDATE_PERIOD_MS    4000
 #define CONNECTION_TIMEOUT_MS     8000
 
+// Adaptive rate scheduling: periodic updates of non-priority objects are
+// stretched by rateScale when the link shows signs of congestion (send
+// failures within a stats window), and relaxed back when it recovers.
+// Priority objects (FlightStatus, alarms, settings) are never scaled.
+#define RATE_SCALE_MAX            8
+#define RATE_SCALE_UP_TX_ERRORS   2
+
 // Private types
 
 // Private variables
@@ -75,8 +82,12 @@ static xQueueHandle queue;
 
 #if defined(PIOS_TELEM_PRIORITY_QUEUE)
 static xQueueHandle priorityQueue;
+// Bulk lane for host driven transfers (log download, waypoint dumps);
+// only drained when the other two lanes are idle
+static xQueueHandle bulkQueue;
 #else
 #define priorityQueue queue
+#define bulkQueue     queue
 #endif
 
 static xTaskHandle telemetryTxTaskHandle;
@@ -87,6 +98,7 @@ static xTaskHandle radioRxTaskHandle;
 static uint32_t txErrors;
 static uint32_t txRetries;
 static uint32_t timeOfLastObjectUpdate;
+static uint8_t rateScale = 1;
 static UAVTalkConnection uavTalkCon;
 #ifdef PIOS_INCLUDE_RFM22B
 static UAVTalkConnection radioUavTalkCon;
@@ -106,6 +118,8 @@ static int32_t setUpdatePeriod(UAVObjHandle obj, int32_t updatePeriodMs);
 static int32_t setLoggingPeriod(UAVObjHandle obj, int32_t updatePeriodMs);
 static void processObjEvent(UAVObjEvent *ev);
 static void updateTelemetryStats();
+static void updateRateScale(uint32_t windowTxErrors);
+static void rescaleObjectPeriods(UAVObjHandle obj);
 static void gcsTelemetryStatsUpdated();
 static void updateSettings();
 static uint32_t getComPort(bool input);
@@ -154,6 +168,7 @@ int32_t TelemetryInitialize(void)
     queue = xQueueCreate(MAX_QUEUE_SIZE, sizeof(UAVObjEvent));
 #if defined(PIOS_TELEM_PRIORITY_QUEUE)
     priorityQueue = xQueueCreate(MAX_QUEUE_SIZE, sizeof(UAVObjEvent));
+    bulkQueue     = xQueueCreate(MAX_QUEUE_SIZE, sizeof(UAVObjEvent));
 #endif
 
     // Update telemetry settings
@@ -292,6 +307,11 @@ static void updateObject(UAVObjHandle obj, int32_t eventType)
     // note that all setting objects have implicitly IsPriority=true
     if (UAVObjIsPriority(obj)) {
         UAVObjConnectQueue(obj, priorityQueue, eventMask);
+    } else if (updateMode == UPDATEMODE_MANUAL) {
+        // Manual mode non-priority objects carry host driven transfers
+        // (log download, waypoint dumps): keep them off the lane used by
+        // realtime state objects
+        UAVObjConnectQueue(obj, bulkQueue, eventMask);
     } else {
         UAVObjConnectQueue(obj, queue, eventMask);
     }
@@ -405,7 +425,12 @@ static void telemetryTxTask(__attribute__((unused)) void *parameters)
         if (xQueueReceive(queue, &ev, 0) == pdTRUE) {
             // Process event
             processObjEvent(&ev);
-            // if both queues are empty, wait on priority queue for updates (1 tick) then repeat cycle
+        } else if (xQueueReceive(bulkQueue, &ev, 0) == pdTRUE) {
+            // The bulk lane only gets a frame out when both lanes above
+            // are idle, so a log download yields to realtime traffic at
+            // every frame boundary
+            processObjEvent(&ev);
+            // if all queues are empty, wait on priority queue for updates (1 tick) then repeat cycle
         } else if (xQueueReceive(priorityQueue, &ev, 1) == pdTRUE) {
             // Process event
             processObjEvent(&ev);
@@ -431,15 +456,14 @@ static void telemetryRxTask(__attribute__((unused)) void *parameters)
         uint32_t inputPort = getComPort(true);
 
         if (inputPort) {
-            // Block until data are available
-            uint8_t serial_data[1];
+            // Block until data are available, then parse in place in the receive fifo
+            uint8_t *serial_data;
             uint16_t bytes_to_process;
 
-            bytes_to_process = PIOS_COM_ReceiveBuffer(inputPort, serial_data, sizeof(serial_data), 500);
+            bytes_to_process = PIOS_COM_ReceiveBufferPeek(inputPort, &serial_data, 500);
             if (bytes_to_process > 0) {
-                for (uint8_t i = 0; i < bytes_to_process; i++) {
-                    UAVTalkProcessInputStream(uavTalkCon, serial_data[i]);
-                }
+                UAVTalkProcessInputSpan(uavTalkCon, serial_data, bytes_to_process);
+                PIOS_COM_ReceiveBufferConsume(inputPort, bytes_to_process);
             }
         } else {
             vTaskDelay(5);
@@ -456,15 +480,14 @@ static void radioRxTask(__attribute__((unused)) void *parameters)
     // Task loop
     while (1) {
         if (radioPort) {
-            // Block until data are available
-            uint8_t serial_data[1];
+            // Block until data are available, then parse in place in the receive fifo
+            uint8_t *serial_data;
             uint16_t bytes_to_process;
 
-            bytes_to_process = PIOS_COM_ReceiveBuffer(radioPort, serial_data, sizeof(serial_data), 500);
+            bytes_to_process = PIOS_COM_ReceiveBufferPeek(radioPort, &serial_data, 500);
             if (bytes_to_process > 0) {
-                for (uint8_t i = 0; i < bytes_to_process; i++) {
-                    UAVTalkProcessInputStream(radioUavTalkCon, serial_data[i]);
-                }
+                UAVTalkProcessInputSpan(radioUavTalkCon, serial_data, bytes_to_process);
+                PIOS_COM_ReceiveBufferConsume(radioPort, bytes_to_process);
             }
         } else {
             vTaskDelay(5);
@@ -518,6 +541,15 @@ static int32_t setUpdatePeriod(UAVObjHandle obj, int32_t updatePeriodMs)
     UAVObjEvent ev;
     int32_t ret;
 
+    // Stretch non-priority periods when the link is congested
+    if (updatePeriodMs > 0 && !UAVObjIsPriority(obj)) {
+        updatePeriodMs *= rateScale;
+        // the event dispatcher carries periods as uint16_t
+        if (updatePeriodMs > 0xFFFF) {
+            updatePeriodMs = 0xFFFF;
+        }
+    }
+
     // Add or update object for periodic updates
     ev.obj    = obj;
     ev.instId = UAVOBJ_ALL_INSTANCES;
@@ -533,6 +565,50 @@ static int32_t setUpdatePeriod(UAVObjHandle obj, int32_t updatePeriodMs)
     return ret;
 }
 
+/**
+ * Closed-loop scaling of periodic update rates.
+ *
+ * Send failures within a stats window mean the TX queue or radio link
+ * cannot keep up with the configured periods; rather than letting the
+ * queue collapse (and critical objects stall behind it), back off the
+ * periodic rates of non-priority objects by doubling the scale, and
+ * halve it again once a whole window passes without failures.
+ * \param[in] windowTxErrors Number of send failures in the last window
+ */
+static void updateRateScale(uint32_t windowTxErrors)
+{
+    uint8_t newScale = rateScale;
+
+    if (windowTxErrors >= RATE_SCALE_UP_TX_ERRORS) {
+        if (newScale < RATE_SCALE_MAX) {
+            newScale *= 2;
+        }
+    } else if (windowTxErrors == 0) {
+        if (newScale > 1) {
+            newScale /= 2;
+        }
+    }
+
+    if (newScale != rateScale) {
+        rateScale = newScale;
+        // Re-register every periodic object so the new scale takes effect
+        UAVObjIterate(&rescaleObjectPeriods);
+    }
+}
+
+/**
+ * Object iterator used when the rate scale changes.  Re-runs the normal
+ * update-mode setup for data objects so their periodic entries pick up
+ * the new scale; priority objects keep their configured period.
+ */
+static void rescaleObjectPeriods(UAVObjHandle obj)
+{
+    if (UAVObjIsMetaobject(obj) || UAVObjIsPriority(obj)) {
+        return;
+    }
+    updateObject(obj, EV_NONE);
+}
+
 /**
  * Set logging update period of object (it must be already setup for periodic updates)
  * \param[in] obj The object to update
@@ -623,6 +699,9 @@ static void updateTelemetryStats()
         flightStats.RxSyncErrors = 0;
         flightStats.RxCrcErrors  = 0;
     }
+    // Adapt periodic rates to the observed link health
+    updateRateScale(txErrors);
+
     txErrors  = 0;
     txRetries = 0;
 
@@ -33,8 +33,8 @@
 /**
  * Output object: StabilizationSettings
  *
- * This module will periodically update values of stabilization PID settings
- * depending on configured input control channels. New values of stabilization
+ * This module updates values of stabilization PID settings whenever a
+ * configured input control channel moves. New values of stabilization
  * settings are not saved to flash, but updated in RAM. It is expected that the
  * module will be enabled only for tuning. When desired values are found, they
  * can be read via GCS and saved permanently. Then this module should be
@@ -65,9 +65,13 @@
 //
 // Configuration
 //
-#define SAMPLE_PERIOD_MS           200
 #define TELEMETRY_UPDATE_PERIOD_MS 0 // 0 = update on change (default)
 
+// Minimum input change (fraction of the full [-1..1] accessory range)
+// before a new value is applied, so channel jitter does not trigger
+// settings updates.
+#define TXPID_INPUT_DEADBAND       0.01f
+
 // Sanity checks
 #if (TXPIDSETTINGS_PIDS_NUMELEM != TXPIDSETTINGS_INPUTS_NUMELEM) || \
     (TXPIDSETTINGS_PIDS_NUMELEM != TXPIDSETTINGS_MINPID_NUMELEM) || \
@@ -79,8 +83,20 @@
 
 // Private variables
 
+// Last raw input value applied per instance, used for the deadband
+static float lastInput[TXPIDSETTINGS_PIDS_NUMELEM];
+
+// Changed fields collected by the update helpers, written back
+// individually so a knob twist does not redistribute the whole bank
+static struct {
+    void   *addr;
+    uint8_t size;
+} changedFields[2 * TXPIDSETTINGS_PIDS_NUMELEM];
+static uint8_t changedFieldCount;
+
 // Private functions
 static void updatePIDs(UAVObjEvent *ev);
+static void markChanged(void *addr, uint8_t size);
 static uint8_t update(float *var, float val);
 static uint8_t updateUint8(uint8_t *var, float val);
 static uint8_t updateInt8(int8_t *var, float val);
@@ -108,13 +124,13 @@ int32_t TxPIDInitialize(void)
         TxPIDSettingsInitialize();
         AccessoryDesiredInitialize();
 
-        UAVObjEvent ev = {
-            .obj    = AccessoryDesiredHandle(),
-            .instId = 0,
-            .event  = 0,
-            .lowPriority = false,
-        };
-        EventPeriodicCallbackCreate(&ev, updatePIDs, SAMPLE_PERIOD_MS / portTICK_RATE_MS);
+        for (uint8_t i = 0; i < TXPIDSETTINGS_PIDS_NUMELEM; i++) {
+            lastInput[i] = NAN;
+        }
+
+        // Run on accessory channel updates; the deadband filters out
+        // channel jitter so unchanged knobs cause no settings writes.
+        AccessoryDesiredConnectCallback(updatePIDs);
 
 #if (TELEMETRY_UPDATE_PERIOD_MS != 0)
         // Change StabilizationSettings update rate from OnChange to periodic
@@ -169,6 +185,50 @@ static void updatePIDs(UAVObjEvent *ev)
         return;
     }
 
+    // Sample the inputs and apply the deadband before touching any
+    // settings object, so jitter on unchanged knobs returns early.
+    float values[TXPIDSETTINGS_PIDS_NUMELEM];
+    bool apply[TXPIDSETTINGS_PIDS_NUMELEM];
+    bool anyChanged = false;
+    AccessoryDesiredData accessory;
+
+    for (uint8_t i = 0; i < TXPIDSETTINGS_PIDS_NUMELEM; i++) {
+        apply[i] = false;
+        if (TxPIDSettingsPIDsToArray(inst.PIDs)[i] == TXPIDSETTINGS_PIDS_DISABLED) {
+            continue;
+        }
+        float raw;
+        if (TxPIDSettingsInputsToArray(inst.Inputs)[i] == TXPIDSETTINGS_INPUTS_THROTTLE) {
+            ManualControlCommandThrottleGet(&raw);
+        } else if (AccessoryDesiredInstGet(
+                       TxPIDSettingsInputsToArray(inst.Inputs)[i] - TXPIDSETTINGS_INPUTS_ACCESSORY0,
+                       &accessory) == 0) {
+            raw = accessory.AccessoryVal;
+        } else {
+            continue;
+        }
+        if (fabsf(raw - lastInput[i]) < TXPID_INPUT_DEADBAND) {
+            continue;
+        }
+        lastInput[i] = raw;
+        if (TxPIDSettingsInputsToArray(inst.Inputs)[i] == TXPIDSETTINGS_INPUTS_THROTTLE) {
+            values[i] = scale(raw,
+                              inst.ThrottleRange.Min,
+                              inst.ThrottleRange.Max,
+                              TxPIDSettingsMinPIDToArray(inst.MinPID)[i],
+                              TxPIDSettingsMaxPIDToArray(inst.MaxPID)[i]);
+        } else {
+            values[i] = scale(raw, -1.0f, 1.0f,
+                              TxPIDSettingsMinPIDToArray(inst.MinPID)[i],
+                              TxPIDSettingsMaxPIDToArray(inst.MaxPID)[i]);
+        }
+        apply[i]   = true;
+        anyChanged = true;
+    }
+    if (!anyChanged) {
+        return;
+    }
+
     StabilizationBankData bank;
     switch (inst.BankNumber) {
     case 0:
@@ -188,197 +248,202 @@ static void updatePIDs(UAVObjEvent *ev)
     }
     StabilizationSettingsData stab;
     StabilizationSettingsGet(&stab);
-    AccessoryDesiredData accessory;
 
-    uint8_t needsUpdateBank = 0;
-    uint8_t needsUpdateStab = 0;
+    changedFieldCount = 0;
 
     // Loop through every enabled instance
     for (uint8_t i = 0; i < TXPIDSETTINGS_PIDS_NUMELEM; i++) {
-        if (TxPIDSettingsPIDsToArray(inst.PIDs)[i] != TXPIDSETTINGS_PIDS_DISABLED) {
-            float value;
-            if (TxPIDSettingsInputsToArray(inst.Inputs)[i] == TXPIDSETTINGS_INPUTS_THROTTLE) {
-                ManualControlCommandThrottleGet(&value);
-                value = scale(value,
-                              inst.ThrottleRange.Min,
-                              inst.ThrottleRange.Max,
-                              TxPIDSettingsMinPIDToArray(inst.MinPID)[i],
-                              TxPIDSettingsMaxPIDToArray(inst.MaxPID)[i]);
-            } else if (AccessoryDesiredInstGet(
-                           TxPIDSettingsInputsToArray(inst.Inputs)[i] - TXPIDSETTINGS_INPUTS_ACCESSORY0,
-                           &accessory) == 0) {
-                value = scale(accessory.AccessoryVal, -1.0f, 1.0f,
-                              TxPIDSettingsMinPIDToArray(inst.MinPID)[i],
-                              TxPIDSettingsMaxPIDToArray(inst.MaxPID)[i]);
-            } else {
-                continue;
-            }
+        if (apply[i]) {
+            float value = values[i];
 
             switch (TxPIDSettingsPIDsToArray(inst.PIDs)[i]) {
             case TXPIDSETTINGS_PIDS_ROLLRATEKP:
-                needsUpdateBank |= update(&bank.RollRatePID.Kp, value);
+                update(&bank.RollRatePID.Kp, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLRATEKI:
-                needsUpdateBank |= update(&bank.RollRatePID.Ki, value);
+                update(&bank.RollRatePID.Ki, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLRATEKD:
-                needsUpdateBank |= update(&bank.RollRatePID.Kd, value);
+                update(&bank.RollRatePID.Kd, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLRATEILIMIT:
-                needsUpdateBank |= update(&bank.RollRatePID.ILimit, value);
+                update(&bank.RollRatePID.ILimit, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLRATERESP:
-                needsUpdateBank |= update(&bank.ManualRate.Roll, value);
+                update(&bank.ManualRate.Roll, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLATTITUDEKP:
-                needsUpdateBank |= update(&bank.RollPI.Kp, value);
+                update(&bank.RollPI.Kp, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLATTITUDEKI:
-                needsUpdateBank |= update(&bank.RollPI.Ki, value);
+                update(&bank.RollPI.Ki, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLATTITUDEILIMIT:
-                needsUpdateBank |= update(&bank.RollPI.ILimit, value);
+                update(&bank.RollPI.ILimit, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLATTITUDERESP:
-                needsUpdateBank |= updateUint8(&bank.RollMax, value);
+                updateUint8(&bank.RollMax, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHRATEKP:
-                needsUpdateBank |= update(&bank.PitchRatePID.Kp, value);
+                update(&bank.PitchRatePID.Kp, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHRATEKI:
-                needsUpdateBank |= update(&bank.PitchRatePID.Ki, value);
+                update(&bank.PitchRatePID.Ki, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHRATEKD:
-                needsUpdateBank |= update(&bank.PitchRatePID.Kd, value);
+                update(&bank.PitchRatePID.Kd, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHRATEILIMIT:
-                needsUpdateBank |= update(&bank.PitchRatePID.ILimit, value);
+                update(&bank.PitchRatePID.ILimit, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHRATERESP:
-                needsUpdateBank |= update(&bank.ManualRate.Pitch, value);
+                update(&bank.ManualRate.Pitch, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHATTITUDEKP:
-                needsUpdateBank |= update(&bank.PitchPI.Kp, value);
+                update(&bank.PitchPI.Kp, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHATTITUDEKI:
-                needsUpdateBank |= update(&bank.PitchPI.Ki, value);
+                update(&bank.PitchPI.Ki, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHATTITUDEILIMIT:
-                needsUpdateBank |= update(&bank.PitchPI.ILimit, value);
+                update(&bank.PitchPI.ILimit, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHATTITUDERESP:
-                needsUpdateBank |= updateUint8(&bank.PitchMax, value);
+                updateUint8(&bank.PitchMax, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHRATEKP:
-                needsUpdateBank |= update(&bank.RollRatePID.Kp, value);
-                needsUpdateBank |= update(&bank.PitchRatePID.Kp, value);
+                update(&bank.RollRatePID.Kp, value);
+                update(&bank.PitchRatePID.Kp, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHRATEKI:
-                needsUpdateBank |= update(&bank.RollRatePID.Ki, value);
-                needsUpdateBank |= update(&bank.PitchRatePID.Ki, value);
+                update(&bank.RollRatePID.Ki, value);
+                update(&bank.PitchRatePID.Ki, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHRATEKD:
-                needsUpdateBank |= update(&bank.RollRatePID.Kd, value);
-                needsUpdateBank |= update(&bank.PitchRatePID.Kd, value);
+                update(&bank.RollRatePID.Kd, value);
+                update(&bank.PitchRatePID.Kd, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHRATEILIMIT:
-                needsUpdateBank |= update(&bank.RollRatePID.ILimit, value);
-                needsUpdateBank |= update(&bank.PitchRatePID.ILimit, value);
+                update(&bank.RollRatePID.ILimit, value);
+                update(&bank.PitchRatePID.ILimit, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHRATERESP:
-                needsUpdateBank |= update(&bank.ManualRate.Roll, value);
-                needsUpdateBank |= update(&bank.ManualRate.Pitch, value);
+                update(&bank.ManualRate.Roll, value);
+                update(&bank.ManualRate.Pitch, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHATTITUDEKP:
-                needsUpdateBank |= update(&bank.RollPI.Kp, value);
-                needsUpdateBank |= update(&bank.PitchPI.Kp, value);
+                update(&bank.RollPI.Kp, value);
+                update(&bank.PitchPI.Kp, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHATTITUDEKI:
-                needsUpdateBank |= update(&bank.RollPI.Ki, value);
-                needsUpdateBank |= update(&bank.PitchPI.Ki, value);
+                update(&bank.RollPI.Ki, value);
+                update(&bank.PitchPI.Ki, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHATTITUDEILIMIT:
-                needsUpdateBank |= update(&bank.RollPI.ILimit, value);
-                needsUpdateBank |= update(&bank.PitchPI.ILimit, value);
+                update(&bank.RollPI.ILimit, value);
+                update(&bank.PitchPI.ILimit, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHATTITUDERESP:
-                needsUpdateBank |= updateUint8(&bank.RollMax, value);
-                needsUpdateBank |= updateUint8(&bank.PitchMax, value);
+                updateUint8(&bank.RollMax, value);
+                updateUint8(&bank.PitchMax, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWRATEKP:
-                needsUpdateBank |= update(&bank.YawRatePID.Kp, value);
+                update(&bank.YawRatePID.Kp, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWRATEKI:
-                needsUpdateBank |= update(&bank.YawRatePID.Ki, value);
+                update(&bank.YawRatePID.Ki, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWRATEKD:
-                needsUpdateBank |= update(&bank.YawRatePID.Kd, value);
+                update(&bank.YawRatePID.Kd, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWRATEILIMIT:
-                needsUpdateBank |= update(&bank.YawRatePID.ILimit, value);
+                update(&bank.YawRatePID.ILimit, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWRATERESP:
-                needsUpdateBank |= update(&bank.ManualRate.Yaw, value);
+                update(&bank.ManualRate.Yaw, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWATTITUDEKP:
-                needsUpdateBank |= update(&bank.YawPI.Kp, value);
+                update(&bank.YawPI.Kp, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWATTITUDEKI:
-                needsUpdateBank |= update(&bank.YawPI.Ki, value);
+                update(&bank.YawPI.Ki, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWATTITUDEILIMIT:
-                needsUpdateBank |= update(&bank.YawPI.ILimit, value);
+                update(&bank.YawPI.ILimit, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWATTITUDERESP:
-                needsUpdateBank |= updateUint8(&bank.YawMax, value);
+                updateUint8(&bank.YawMax, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLEXPO:
-                needsUpdateBank |= updateInt8(&bank.StickExpo.Roll, value);
+                updateInt8(&bank.StickExpo.Roll, value);
                 break;
             case TXPIDSETTINGS_PIDS_PITCHEXPO:
-                needsUpdateBank |= updateInt8(&bank.StickExpo.Pitch, value);
+                updateInt8(&bank.StickExpo.Pitch, value);
                 break;
             case TXPIDSETTINGS_PIDS_ROLLPITCHEXPO:
-                needsUpdateBank |= updateInt8(&bank.StickExpo.Roll, value);
-                needsUpdateBank |= updateInt8(&bank.StickExpo.Pitch, value);
+                updateInt8(&bank.StickExpo.Roll, value);
+                updateInt8(&bank.StickExpo.Pitch, value);
                 break;
             case TXPIDSETTINGS_PIDS_YAWEXPO:
-                needsUpdateBank |= updateInt8(&bank.StickExpo.Yaw, value);
+                updateInt8(&bank.StickExpo.Yaw, value);
                 break;
             case TXPIDSETTINGS_PIDS_GYROTAU:
-                needsUpdateStab |= update(&stab.GyroTau, value);
+                update(&stab.GyroTau, value);
                 break;
             case TXPIDSETTINGS_PIDS_ACROPLUSFACTOR:
-                needsUpdateBank |= update(&bank.AcroInsanityFactor, value);
+                update(&bank.AcroInsanityFactor, value);
                 break;
             default:
                 PIOS_Assert(0);
             }
         }
     }
-    if (needsUpdateStab) {
-        StabilizationSettingsSet(&stab);
+    if (changedFieldCount == 0) {
+        return;
+    }
+
+    UAVObjHandle bankHandle;
+    switch (inst.BankNumber) {
+    case 0:
+        bankHandle = StabilizationSettingsBank1Handle();
+        break;
+
+    case 1:
+        bankHandle = StabilizationSettingsBank2Handle();
+        break;
+
+    case 2:
+        bankHandle = StabilizationSettingsBank3Handle();
+        break;
+
+    default:
+        return;
     }
-    if (needsUpdateBank) {
-        switch (inst.BankNumber) {
-        case 0:
-            StabilizationSettingsBank1Set((StabilizationSettingsBank1Data *)&bank);
-            break;
-
-        case 1:
-            StabilizationSettingsBank2Set((StabilizationSettingsBank2Data *)&bank);
-            break;
-
-        case 2:
-            StabilizationSettingsBank3Set((StabilizationSettingsBank3Data *)&bank);
-            break;
-
-        default:
-            return;
+
+    // Write back only the fields that actually changed, so a knob twist
+    // updates one gain instead of re-dispatching the whole settings object.
+    for (uint8_t i = 0; i < changedFieldCount; i++) {
+        uint8_t *addr = changedFields[i].addr;
+        if ((addr >= (uint8_t *)&bank) && (addr < ((uint8_t *)&bank + sizeof(bank)))) {
+            UAVObjSetDataField(bankHandle, addr, (uint32_t)(addr - (uint8_t *)&bank), changedFields[i].size);
+        } else {
+            UAVObjSetDataField(StabilizationSettingsHandle(), addr, (uint32_t)(addr - (uint8_t *)&stab), changedFields[i].size);
         }
     }
 }
 
+/**
+ * Records a changed field for the final per-field write back.
+ */
+static void markChanged(void *addr, uint8_t size)
+{
+    if (changedFieldCount < NELEMENTS(changedFields)) {
+        changedFields[changedFieldCount].addr = addr;
+        changedFields[changedFieldCount].size = size;
+        changedFieldCount++;
+    }
+}
+
 /**
  * Scales input val from [inMin..inMax] range to [outMin..outMax].
  * If val is out of input range (inMin <= inMax), it will be bound.
@@ -427,6 +492,7 @@ static uint8_t update(float *var, float val)
      * of numbers we see here*/
     if (fabsf(*var - val) > 1e-9f) {
         *var = val;
+        markChanged(var, sizeof(*var));
         return 1;
     }
     return 0;
@@ -442,6 +508,7 @@ static uint8_t updateUint8(uint8_t *var, float val)
 
     if (*var != roundedVal) {
         *var = roundedVal;
+        markChanged(var, sizeof(*var));
         return 1;
     }
     return 0;
@@ -457,6 +524,7 @@ static uint8_t updateInt8(int8_t *var, float val)
 
     if (*var != roundedVal) {
         *var = roundedVal;
+        markChanged(var, sizeof(*var));
         return 1;
     }
     return 0;
@@ -132,9 +132,9 @@ uint32_t DFS_WriteSector(uint8_t unit, uint8_t *buffer, uint32_t sector, uint32_
 	/* Invalidate cache */
 	last_sector = 0xffffffff;
 
-	/* Forward to PIOS */
+	/* Forward to PIOS - the sector is copied and queued, reads drain the queue first */
 	int32_t status;
-	if((status = PIOS_SDCARD_SectorWrite(sector, buffer)) < 0) {
+	if((status = PIOS_SDCARD_SectorWriteAsync(sector, buffer, NULL)) < 0) {
 		/* Cannot access SD Card */
 		return 3;
 	}
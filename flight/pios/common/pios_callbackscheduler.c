@@ -66,6 +66,12 @@ struct DelayedCallbackInfoStruct {
     uint16_t stackSafetyCount;
     uint16_t currentSafetyCount;
     uint32_t runCount;
+    uint32_t volatile dispatchTime;
+    uint32_t runtimeMin;
+    uint32_t runtimeMax;
+    uint32_t runtimeAvg;
+    uint32_t latencyAvg;
+    uint32_t missedDeadlines;
     struct DelayedCallbackTaskStruct *task;
     struct DelayedCallbackInfoStruct *next;
 };
@@ -209,6 +215,8 @@ int32_t PIOS_CALLBACKSCHEDULER_Dispatch(DelayedCallbackInfo *cbinfo)
 
     // no semaphore needed for the callback
     cbinfo->waiting = true;
+    // timestamp of the dispatch, to measure how long the callback sat in the queue
+    cbinfo->dispatchTime = PIOS_DELAY_GetRaw();
     // but the scheduler as a whole needs to be notified
     return xSemaphoreGive(cbinfo->task->signal);
 }
@@ -233,6 +241,8 @@ int32_t PIOS_CALLBACKSCHEDULER_DispatchFromISR(DelayedCallbackInfo *cbinfo, long
 
     // no semaphore needed for the callback
     cbinfo->waiting = true;
+    // timestamp of the dispatch, to measure how long the callback sat in the queue
+    cbinfo->dispatchTime = PIOS_DELAY_GetRaw();
     // but the scheduler as a whole needs to be notified
     return xSemaphoreGiveFromISR(cbinfo->task->signal, pxHigherPriorityTaskWoken);
 }
@@ -341,6 +351,12 @@ DelayedCallbackInfo *PIOS_CALLBACKSCHEDULER_Create(
     info->cb = cb;
     info->callbackID         = callbackID;
     info->runCount           = 0;
+    info->dispatchTime       = 0;
+    info->runtimeMin         = UINT32_MAX;
+    info->runtimeMax         = 0;
+    info->runtimeAvg         = 0;
+    info->latencyAvg         = 0;
+    info->missedDeadlines    = 0;
     info->stackSize          = stacksize - STACK_SIZE;
     info->stackNotFree       = info->stackSize;
     info->stackFree          = 0;
@@ -380,6 +396,11 @@ void PIOS_CALLBACKSCHEDULER_ForEachCallback(CallbackSchedulerCallbackInfoCallbac
                 info.is_running = true;
                 info.stack_remaining    = cbinfo->stackNotFree;
                 info.running_time_count = cbinfo->runCount;
+                info.runtime_min = (cbinfo->runCount > 0) ? cbinfo->runtimeMin : 0;
+                info.runtime_max = cbinfo->runtimeMax;
+                info.runtime_avg = cbinfo->runtimeAvg;
+                info.latency_avg = cbinfo->latencyAvg;
+                info.missed_deadlines   = cbinfo->missedDeadlines;
                 xSemaphoreGiveRecursive(mutex);
                 callback(cbinfo->callbackID, &info, context);
             }
@@ -500,24 +521,47 @@ static int32_t runNextCallback(struct DelayedCallbackTaskStruct *task, DelayedCa
                 diff = current->scheduletime - xTaskGetTickCount();
                 if (diff <= 0) {
                     current->waiting = true;
+                    current->dispatchTime = PIOS_DELAY_GetRaw();
+                    if (diff < 0) {
+                        // scheduler got to the callback at least a tick after its requested time
+                        current->missedDeadlines++;
+                    }
                 } else if (diff < result) {
                     result = diff; // adjust sleep time
                 }
             }
             if (current->waiting) {
+                uint32_t start;
+                uint32_t runtime;
                 task->queueCursor[priority] = next;
                 current->scheduletime = 0; // any schedules are reset
                 current->waiting = false; // the flag is reset just before execution.
+                if (current->dispatchTime) {
+                    // how long the callback sat dispatched before this scheduler got to run it
+                    current->latencyAvg   = (current->latencyAvg * 15 + PIOS_DELAY_DiffuS(current->dispatchTime)) / 16;
+                    current->dispatchTime = 0;
+                }
                 xSemaphoreGiveRecursive(mutex);
 
                 /* callback gets invoked here - check stack sizes */
                 markStack(current);
 
+                start = PIOS_DELAY_GetRaw();
+
                 current->cb(); // call the callback
 
+                runtime = PIOS_DELAY_DiffuS(start);
+
                 checkStack(current);
 
                 current->runCount++;
+                if (runtime < current->runtimeMin) {
+                    current->runtimeMin = runtime;
+                }
+                if (runtime > current->runtimeMax) {
+                    current->runtimeMax = runtime;
+                }
+                current->runtimeAvg = (current->runtimeAvg * 15 + runtime) / 16;
 
                 return 0;
             }
@@ -59,6 +59,18 @@ struct pios_com_dev {
 
     t_fifo_buffer rx;
     t_fifo_buffer tx;
+
+    /* Optional notification for event driven rx consumers */
+    pios_com_rx_notify_cb rx_notify_cb;
+    uint32_t rx_notify_context;
+
+#ifdef PIOS_INCLUDE_COM_STATS
+    struct pios_com_stats stats;
+    /* Optional token bucket shaping the tx side (0 = no limit) */
+    uint32_t tx_rate_limit;  // bytes per second
+    uint32_t tx_tokens;      // send credit currently available, in bytes
+    uint32_t tx_token_stamp; // PIOS_DELAY_GetRaw() of the last refill
+#endif /* PIOS_INCLUDE_COM_STATS */
 };
 
 static bool PIOS_COM_validate(struct pios_com_dev *com_dev)
@@ -225,7 +237,21 @@ static uint16_t PIOS_COM_RxInCallback(uint32_t context, uint8_t *buf, uint16_t b
     if (bytes_into_fifo > 0) {
         /* Data has been added to the buffer */
         PIOS_COM_UnblockRx(com_dev, need_yield);
+        if (com_dev->rx_notify_cb) {
+            bool notify_yield = false;
+            (com_dev->rx_notify_cb)(com_dev->rx_notify_context, &notify_yield);
+            *need_yield = *need_yield || notify_yield;
+        }
     }
+#ifdef PIOS_INCLUDE_COM_STATS
+    com_dev->stats.rx_bytes   += bytes_into_fifo;
+    /* Bytes the fifo refused; drivers without their own buffering drop them */
+    com_dev->stats.rx_dropped += buf_len - bytes_into_fifo;
+    uint16_t rx_used = fifoBuf_getUsed(&com_dev->rx);
+    if (rx_used > com_dev->stats.rx_high_water) {
+        com_dev->stats.rx_high_water = rx_used;
+    }
+#endif /* PIOS_INCLUDE_COM_STATS */
 
     if (headroom) {
         *headroom = fifoBuf_getFree(&com_dev->rx);
@@ -251,6 +277,9 @@ static uint16_t PIOS_COM_TxOutCallback(uint32_t context, uint8_t *buf, uint16_t
         /* More space has been made in the buffer */
         PIOS_COM_UnblockTx(com_dev, need_yield);
     }
+#ifdef PIOS_INCLUDE_COM_STATS
+    com_dev->stats.tx_bytes += bytes_from_fifo;
+#endif /* PIOS_INCLUDE_COM_STATS */
 
     if (headroom) {
         *headroom = fifoBuf_getUsed(&com_dev->tx);
@@ -296,6 +325,9 @@ static int32_t PIOS_COM_SendBufferNonBlockingInternal(struct pios_com_dev *com_d
          * possibly having the caller block trying to send to a device that's
          * no longer accepting data.
          */
+#ifdef PIOS_INCLUDE_COM_STATS
+        com_dev->stats.tx_dropped += fifoBuf_getUsed(&com_dev->tx) + len;
+#endif /* PIOS_INCLUDE_COM_STATS */
         fifoBuf_clearData(&com_dev->tx);
         return len;
     }
@@ -305,6 +337,35 @@ static int32_t PIOS_COM_SendBufferNonBlockingInternal(struct pios_com_dev *com_d
         return -2;
     }
 
+#ifdef PIOS_INCLUDE_COM_STATS
+    /* Shaping runs after the free-space check so a -2 retry never burns credit */
+    if (com_dev->tx_rate_limit) {
+        /* Refill the token bucket, carrying the fractional credit over to
+         * the next refill by only moving the stamp when credit was earned */
+        uint32_t credit = (uint32_t)((uint64_t)PIOS_DELAY_DiffuS(com_dev->tx_token_stamp) * com_dev->tx_rate_limit / 1000000);
+        if (credit > 0) {
+            com_dev->tx_token_stamp = PIOS_DELAY_GetRaw();
+            if (credit > com_dev->tx_rate_limit - com_dev->tx_tokens) {
+                /* Cap the burst at one second worth of credit */
+                com_dev->tx_tokens = com_dev->tx_rate_limit;
+            } else {
+                com_dev->tx_tokens += credit;
+            }
+        }
+        if (len > com_dev->tx_tokens) {
+            /*
+             * Over the configured rate.  Discard like the link-down case
+             * above instead of reporting a full buffer, so blocking senders
+             * degrade to counted drops rather than stalling on a fifo that
+             * is intentionally not being filled.
+             */
+            com_dev->stats.tx_dropped += len;
+            return len;
+        }
+        com_dev->tx_tokens -= len;
+    }
+#endif /* PIOS_INCLUDE_COM_STATS */
+
     uint16_t bytes_into_fifo = fifoBuf_putData(&com_dev->tx, buffer, len);
 
     if (bytes_into_fifo > 0) {
@@ -314,6 +375,12 @@ static int32_t PIOS_COM_SendBufferNonBlockingInternal(struct pios_com_dev *com_d
                                       fifoBuf_getUsed(&com_dev->tx));
         }
     }
+#ifdef PIOS_INCLUDE_COM_STATS
+    uint16_t tx_used = fifoBuf_getUsed(&com_dev->tx);
+    if (tx_used > com_dev->stats.tx_high_water) {
+        com_dev->stats.tx_high_water = tx_used;
+    }
+#endif /* PIOS_INCLUDE_COM_STATS */
     return bytes_into_fifo;
 }
 
@@ -570,6 +637,111 @@ check_again:
     return bytes_from_fifo;
 }
 
+/**
+ * Expose the contiguous readable region of a port's receive fifo without
+ * copying.  Protocol parsers can scan the returned span in place and then
+ * release it with PIOS_COM_ReceiveBufferConsume(), avoiding the intermediate
+ * caller buffer.  The underlying driver only ever appends beyond the write
+ * position, so the exposed region stays stable until it is consumed.
+ * \param[in] port COM port
+ * \param[out] buf Receives a pointer into the receive fifo
+ * \param[in] timeout_ms How long to wait for data if the fifo is empty
+ * \returns Number of contiguous bytes readable at *buf (0 on timeout)
+ */
+uint16_t PIOS_COM_ReceiveBufferPeek(uint32_t com_id, uint8_t **buf, uint32_t timeout_ms)
+{
+    PIOS_Assert(buf);
+    uint16_t bytes_in_fifo;
+
+    struct pios_com_dev *com_dev = (struct pios_com_dev *)com_id;
+
+    if (!PIOS_COM_validate(com_dev)) {
+        /* Undefined COM port for this board (see pios_board.c) */
+        PIOS_Assert(0);
+    }
+    PIOS_Assert(com_dev->has_rx);
+
+check_again:
+    bytes_in_fifo = fifoBuf_getContiguousPeek(&com_dev->rx, buf);
+
+    if (bytes_in_fifo == 0) {
+        /* No more bytes in receive buffer */
+        /* Make sure the receiver is running while we wait */
+        if (com_dev->driver->rx_start) {
+            /* Notify the lower layer that there is now room in the rx buffer */
+            (com_dev->driver->rx_start)(com_dev->lower_id,
+                                        fifoBuf_getFree(&com_dev->rx));
+        }
+        if (timeout_ms > 0) {
+#if defined(PIOS_INCLUDE_FREERTOS)
+            if (xSemaphoreTake(com_dev->rx_sem, timeout_ms / portTICK_RATE_MS) == pdTRUE) {
+                /* Make sure we don't come back here again */
+                timeout_ms = 0;
+                goto check_again;
+            }
+#else
+            PIOS_DELAY_WaitmS(1);
+            timeout_ms--;
+            goto check_again;
+#endif
+        }
+    }
+
+    return bytes_in_fifo;
+}
+
+/**
+ * Release bytes previously exposed by PIOS_COM_ReceiveBufferPeek()
+ * \param[in] port COM port
+ * \param[in] bytes Number of bytes the parser has finished with
+ */
+void PIOS_COM_ReceiveBufferConsume(uint32_t com_id, uint16_t bytes)
+{
+    struct pios_com_dev *com_dev = (struct pios_com_dev *)com_id;
+
+    if (!PIOS_COM_validate(com_dev)) {
+        /* Undefined COM port for this board (see pios_board.c) */
+        PIOS_Assert(0);
+    }
+    PIOS_Assert(com_dev->has_rx);
+
+    fifoBuf_removeData(&com_dev->rx, bytes);
+
+    if (com_dev->driver->rx_start) {
+        /* Notify the lower layer that there is now room in the rx buffer */
+        (com_dev->driver->rx_start)(com_dev->lower_id,
+                                    fifoBuf_getFree(&com_dev->rx));
+    }
+}
+
+/**
+ * Register a callback invoked whenever a span of data is delivered into
+ * the receive fifo of a port.  Event driven consumers use this to get
+ * dispatched on arrival instead of parking a task on the rx semaphore.
+ * The callback runs in the delivery context, usually an ISR, and must
+ * behave accordingly.
+ * \param[in] com_id COM port
+ * \param[in] notify_cb Callback to invoke, NULL to unregister
+ * \param[in] context Opaque value passed through to the callback
+ * \return -1 if port not available
+ * \return 0 on success
+ */
+int32_t PIOS_COM_RegisterRxNotify(uint32_t com_id, pios_com_rx_notify_cb notify_cb, uint32_t context)
+{
+    struct pios_com_dev *com_dev = (struct pios_com_dev *)com_id;
+
+    if (!PIOS_COM_validate(com_dev)) {
+        /* Undefined COM port for this board (see pios_board.c) */
+        return -1;
+    }
+    PIOS_Assert(com_dev->has_rx);
+
+    /* Stage the context before the callback becomes visible to the rx path */
+    com_dev->rx_notify_context = context;
+    com_dev->rx_notify_cb      = notify_cb;
+    return 0;
+}
+
 /**
  * Query if a com port is available for use.  That can be
  * used to check a link is established even if the device
@@ -592,6 +764,56 @@ bool PIOS_COM_Available(uint32_t com_id)
     return (com_dev->driver->available)(com_dev->lower_id);
 }
 
+#ifdef PIOS_INCLUDE_COM_STATS
+/**
+ * Fetch the byte/drop/high water counters of a com port
+ * \param[in] com_id COM port
+ * \param[out] stats counters accumulated since boot
+ * \return -1 if port not available
+ * \return 0 on success
+ */
+int32_t PIOS_COM_GetStats(uint32_t com_id, struct pios_com_stats *stats)
+{
+    struct pios_com_dev *com_dev = (struct pios_com_dev *)com_id;
+
+    if (!PIOS_COM_validate(com_dev)) {
+        /* Undefined COM port for this board (see pios_board.c) */
+        return -1;
+    }
+
+    /* Counters are word sized so the unlocked copy cannot tear on this
+     * architecture, it can merely lag the interrupt side by a few bytes */
+    *stats = com_dev->stats;
+    return 0;
+}
+
+/**
+ * Limit the transmit rate of a com port with a token bucket.
+ * Bytes sent above the configured rate are discarded and counted in
+ * tx_dropped rather than queued, so a sender feeding a slow link slows
+ * down predictably instead of blocking on a full fifo.
+ * \param[in] com_id COM port
+ * \param[in] bytes_per_sec sustained rate, 0 disables shaping
+ * \return -1 if port not available
+ * \return 0 on success
+ */
+int32_t PIOS_COM_SetTxRateLimit(uint32_t com_id, uint32_t bytes_per_sec)
+{
+    struct pios_com_dev *com_dev = (struct pios_com_dev *)com_id;
+
+    if (!PIOS_COM_validate(com_dev)) {
+        /* Undefined COM port for this board (see pios_board.c) */
+        return -1;
+    }
+
+    com_dev->tx_rate_limit  = bytes_per_sec;
+    /* Start with a full bucket so a freshly configured port can send */
+    com_dev->tx_tokens      = bytes_per_sec;
+    com_dev->tx_token_stamp = PIOS_DELAY_GetRaw();
+    return 0;
+}
+#endif /* PIOS_INCLUDE_COM_STATS */
+
 #endif /* PIOS_INCLUDE_COM */
 
 /**
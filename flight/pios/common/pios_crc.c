@@ -9,8 +9,8 @@
 
 #include "pios.h"
 
-// CRC lookup table
-static const uint8_t crc_table[256] = {
+// CRC lookup table (exported for the inline per-byte update in pios_crc.h)
+const uint8_t PIOS_CRC_Table[256] = {
     0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b, 0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d,
     0x70, 0x77, 0x7e, 0x79, 0x6c, 0x6b, 0x62, 0x65, 0x48, 0x4f, 0x46, 0x41, 0x54, 0x53, 0x5a, 0x5d,
     0xe0, 0xe7, 0xee, 0xe9, 0xfc, 0xfb, 0xf2, 0xf5, 0xd8, 0xdf, 0xd6, 0xd1, 0xc4, 0xc3, 0xca, 0xcd,
@@ -117,18 +117,6 @@ static const uint32_t CRC_Table32[] = {
  * \param length   Number of bytes in the \a data buffer.
  * \return         The updated crc value.
  */
-uint8_t PIOS_CRC_updateByte(uint8_t crc, const uint8_t data)
-{
-    return crc_table[crc ^ data];
-}
-
-/**
- * @brief Update a CRC with a data buffer
- * @param[in] crc Starting CRC value
- * @param[in] data Data buffer
- * @param[in] length Number of bytes to process
- * @returns Updated CRC
- */
 uint8_t PIOS_CRC_updateCRC(uint8_t crc, const uint8_t *data, int32_t length)
 {
     // use registers for speed
@@ -136,8 +124,17 @@ uint8_t PIOS_CRC_updateCRC(uint8_t crc, const uint8_t *data, int32_t length)
     register uint8_t crc8     = crc;
     register const uint8_t *p = data;
 
+    // unroll four lookups per iteration to cut loop overhead on bulk data
+    while (len >= 4) {
+        crc8 = PIOS_CRC_Table[crc8 ^ p[0]];
+        crc8 = PIOS_CRC_Table[crc8 ^ p[1]];
+        crc8 = PIOS_CRC_Table[crc8 ^ p[2]];
+        crc8 = PIOS_CRC_Table[crc8 ^ p[3]];
+        p   += 4;
+        len -= 4;
+    }
     while (len--) {
-        crc8 = crc_table[crc8 ^ *p++];
+        crc8 = PIOS_CRC_Table[crc8 ^ *p++];
     }
 
     return crc8;
@@ -50,6 +50,8 @@ static xSemaphoreHandle mutex = 0;
 
 static bool logging_enabled = false;
 #define MAX_CONSECUTIVE_FAILS_COUNT 10
+// maximum argument words captured by a deferred-format entry
+#define DEBUGLOG_BINARY_MAX_ARGS    8
 static bool log_is_full     = false;
 static uint8_t fails_count  = 0;
 static uint16_t flightnum   = 0;
@@ -59,6 +61,26 @@ static DebugLogEntryData *buffer = 0;
 static DebugLogEntryData staticbuffer;
 #endif
 
+#if defined(PIOS_INCLUDE_FREERTOS)
+// Ring buffer between log producers and the flash writer task.  Producers
+// only ever memcpy into RAM here, so they never see the latency spikes of
+// the flash filesystem (garbage collection can stall a save for tens of
+// ms).  The low priority writer task absorbs those stalls instead.
+#define DEBUGLOG_RING_ENTRIES        8
+#define DEBUGLOG_WRITER_STACK_BYTES  400
+#define DEBUGLOG_WRITER_PRIORITY     (tskIDLE_PRIORITY + 1)
+static DebugLogEntryData *ring  = 0;
+static volatile uint8_t ring_head; // next slot to fill
+static volatile uint8_t ring_tail; // next slot to save to flash
+static volatile uint8_t ring_count;
+static uint8_t ring_high_water;
+static uint32_t ring_drops;
+static xSemaphoreHandle ring_sema = 0;
+static xTaskHandle writer_task_handle;
+
+static void writerTask(void *parameters);
+#endif /* PIOS_INCLUDE_FREERTOS */
+
 #define LOG_ENTRY_MAX_DATA_SIZE (sizeof(((DebugLogEntryData *)0)->Data))
 #define LOG_ENTRY_HEADER_SIZE   (sizeof(DebugLogEntryData) - LOG_ENTRY_MAX_DATA_SIZE)
 // build the obj_id as a DEBUGLOGENTRY ID with least significant byte zeroed and filled with flight number
@@ -78,6 +100,11 @@ void PIOS_DEBUGLOG_Initialize()
     if (!mutex) {
         mutex  = xSemaphoreCreateRecursiveMutex();
         buffer = pios_malloc(sizeof(DebugLogEntryData));
+        ring   = pios_malloc(DEBUGLOG_RING_ENTRIES * sizeof(DebugLogEntryData));
+        if (ring) {
+            ring_sema = xSemaphoreCreateCounting(DEBUGLOG_RING_ENTRIES, 0);
+            xTaskCreate(writerTask, "DbgLog", DEBUGLOG_WRITER_STACK_BYTES / 4, NULL, DEBUGLOG_WRITER_PRIORITY, &writer_task_handle);
+        }
     }
 #else
     buffer = &staticbuffer;
@@ -91,6 +118,13 @@ void PIOS_DEBUGLOG_Initialize()
     fails_count = 0;
     used_buffer_space = 0;
     log_is_full = false;
+#if defined(PIOS_INCLUDE_FREERTOS)
+    ring_head       = 0;
+    ring_tail       = 0;
+    ring_count      = 0;
+    ring_high_water = 0;
+    ring_drops      = 0;
+#endif
     while (PIOS_FLASHFS_ObjLoad(pios_user_fs_id, LOG_GET_FLIGHT_OBJID(flightnum), lognum, (uint8_t *)buffer, sizeof(DebugLogEntryData)) == 0) {
         flightnum++;
     }
@@ -162,9 +196,73 @@ void PIOS_DEBUGLOG_Printf(char *format, ...)
     buffer->InstanceID = 0;
     buffer->Size       = strlen((const char *)buffer->Data);
 
-    if (PIOS_FLASHFS_ObjSave(pios_user_fs_id, LOG_GET_FLIGHT_OBJID(flightnum), lognum, (uint8_t *)buffer, sizeof(DebugLogEntryData)) == 0) {
-        lognum++;
+    write_current_buffer();
+    mutexunlock();
+}
+
+
+/**
+ * @brief Write a binary debug log entry, deferring the formatting
+ * @param[in] format - as in printf, but never rendered on the flight side
+ * @param[in] variable arguments, each recorded as a raw 32 bit word
+ * @param...
+ *
+ * Only the flash address of the format string and the raw argument words
+ * are stored, so the cost is a handful of va_arg reads and a memcpy
+ * instead of a vsnprintf.  The ground side resolves the address against
+ * the firmware map file and renders the text there.  Because arguments
+ * are captured as 32 bit words, only integer, character and pointer
+ * conversions may be used; float arguments are promoted to double by the
+ * varargs ABI and would be recorded truncated.
+ */
+void PIOS_DEBUGLOG_BinaryPrintf(const char *format, ...)
+{
+    if (!logging_enabled || !buffer || log_is_full) {
+        return;
     }
+
+    // count the conversions so we know how many words to capture
+    uint32_t num_args = 0;
+    for (const char *p = format; *p; p++) {
+        if (*p == '%') {
+            if (p[1] == '%') {
+                p++;
+            } else {
+                num_args++;
+            }
+        }
+    }
+    if (num_args > DEBUGLOG_BINARY_MAX_ARGS) {
+        num_args = DEBUGLOG_BINARY_MAX_ARGS;
+    }
+
+    uint32_t words[1 + DEBUGLOG_BINARY_MAX_ARGS];
+    words[0] = (uint32_t)format;
+    va_list args;
+    va_start(args, format);
+    for (uint32_t i = 0; i < num_args; i++) {
+        words[1 + i] = va_arg(args, uint32_t);
+    }
+    va_end(args);
+
+    mutexlock();
+    // flush any pending buffer before writing debug data
+    if (used_buffer_space) {
+        write_current_buffer();
+    }
+    memset(buffer->Data, 0xff, sizeof(buffer->Data));
+    buffer->Flight     = flightnum;
+
+    buffer->FlightTime = PIOS_DELAY_GetuS();
+
+    buffer->Entry      = lognum;
+    buffer->Type       = DEBUGLOGENTRY_TYPE_BINARYFORMAT;
+    buffer->ObjectID   = 0;
+    buffer->InstanceID = 0;
+    buffer->Size       = (1 + num_args) * sizeof(uint32_t);
+    memcpy(buffer->Data, words, buffer->Size);
+
+    write_current_buffer();
     mutexunlock();
 }
 
@@ -217,6 +315,9 @@ void PIOS_DEBUGLOG_Info(uint16_t *flight, uint16_t *entry, uint16_t *free, uint1
  */
 void PIOS_DEBUGLOG_Format(void)
 {
+    // let the writer task drain first so stale entries cannot be
+    // written back after the format
+    PIOS_DEBUGLOG_Flush();
     mutexlock();
     PIOS_FLASHFS_Format(pios_user_fs_id);
     lognum      = 0;
@@ -268,6 +369,32 @@ void enqueue_data(uint32_t objid, uint16_t instid, size_t size, uint8_t *data)
 
 bool write_current_buffer()
 {
+#if defined(PIOS_INCLUDE_FREERTOS)
+    if (ring) {
+        // hand the block over to the writer task; producers must never
+        // block on flash, so shed the block if the ring is full
+        if (ring_count >= DEBUGLOG_RING_ENTRIES) {
+            ring_drops++;
+            if (fails_count++ > MAX_CONSECUTIVE_FAILS_COUNT) {
+                log_is_full = true;
+            }
+            return false;
+        }
+        buffer->Entry = lognum++;
+        memcpy(&ring[ring_head], buffer, sizeof(DebugLogEntryData));
+        ring_head = (ring_head + 1) % DEBUGLOG_RING_ENTRIES;
+        taskENTER_CRITICAL();
+        ring_count++;
+        if (ring_count > ring_high_water) {
+            ring_high_water = ring_count;
+        }
+        taskEXIT_CRITICAL();
+        fails_count       = 0;
+        used_buffer_space = 0;
+        xSemaphoreGive(ring_sema);
+        return true;
+    }
+#endif /* PIOS_INCLUDE_FREERTOS */
     // not enough space, write the block and start a new one
     if (PIOS_FLASHFS_ObjSave(pios_user_fs_id, LOG_GET_FLIGHT_OBJID(flightnum), lognum, (uint8_t *)buffer, sizeof(DebugLogEntryData)) == 0) {
         lognum++;
@@ -281,6 +408,79 @@ bool write_current_buffer()
     }
     return true;
 }
+
+#if defined(PIOS_INCLUDE_FREERTOS)
+/**
+ * @brief Drain the RAM ring buffer to the flash filesystem.
+ * Runs at low priority so flash stalls only delay this task.
+ */
+static void writerTask(__attribute__((unused)) void *parameters)
+{
+    while (1) {
+        if (xSemaphoreTake(ring_sema, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        DebugLogEntryData *entry = &ring[ring_tail];
+        if (PIOS_FLASHFS_ObjSave(pios_user_fs_id, LOG_GET_FLIGHT_OBJID(entry->Flight), entry->Entry, (uint8_t *)entry, sizeof(DebugLogEntryData)) != 0) {
+            if (fails_count++ > MAX_CONSECUTIVE_FAILS_COUNT) {
+                log_is_full = true;
+            }
+        }
+        ring_tail = (ring_tail + 1) % DEBUGLOG_RING_ENTRIES;
+        taskENTER_CRITICAL();
+        ring_count--;
+        taskEXIT_CRITICAL();
+    }
+}
+#endif /* PIOS_INCLUDE_FREERTOS */
+
+/**
+ * @brief Push any partially filled block into the write path and wait
+ * until all buffered entries have reached the flash filesystem.
+ * Call while disarmed; may block for as long as the flash needs.
+ */
+void PIOS_DEBUGLOG_Flush(void)
+{
+    if (!buffer) {
+        return;
+    }
+    mutexlock();
+    if (used_buffer_space) {
+        write_current_buffer();
+    }
+    mutexunlock();
+#if defined(PIOS_INCLUDE_FREERTOS)
+    while (ring_count) {
+        vTaskDelay(2 / portTICK_RATE_MS);
+    }
+#endif
+    // quiescent point: persist the filesystem index for a fast next mount
+    PIOS_FLASHFS_SaveIndex(pios_user_fs_id);
+}
+
+/**
+ * @brief Retrieve occupancy statistics of the RAM ring buffer
+ * @param[out] high_water deepest ring occupancy seen since boot
+ * @param[out] drops number of blocks shed because the ring was full
+ */
+void PIOS_DEBUGLOG_BufferStats(uint8_t *high_water, uint32_t *drops)
+{
+#if defined(PIOS_INCLUDE_FREERTOS)
+    if (high_water) {
+        *high_water = ring_high_water;
+    }
+    if (drops) {
+        *drops = ring_drops;
+    }
+#else
+    if (high_water) {
+        *high_water = 0;
+    }
+    if (drops) {
+        *drops = 0;
+    }
+#endif
+}
 /**
  * @}
  * @}
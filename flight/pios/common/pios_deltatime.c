@@ -58,6 +58,68 @@ float PIOS_DELTATIME_GetAverageSeconds(PiOSDeltatimeConfig *config)
 }
 
 
+/*
+ * 64 bit monotonic microsecond timebase.
+ *
+ * Extends the architecture's 32 bit microsecond counter (which wraps
+ * roughly every 71 minutes) by detecting wraps lazily on each read, so
+ * the wrap handling lives here instead of in every consumer. Any read
+ * keeps the extension current; with the periodic tasks all over the
+ * system the required one-read-per-wrap is always satisfied.
+ */
+
+/**
+ * @brief Query the monotonic microsecond clock
+ * @return microseconds since PIOS_DELAY_Init(), never wraps in practice
+ */
+uint64_t PIOS_DELAY_GetuS64(void)
+{
+    static uint64_t high; // accumulated wrapped periods, multiple of 2^32
+    static uint32_t last;
+
+    PIOS_IRQ_Disable();
+    uint32_t now = PIOS_DELAY_GetuS();
+    if (now < last) {
+        high += (uint64_t)1 << 32;
+    }
+    last = now;
+    uint64_t t = high | now;
+    PIOS_IRQ_Enable();
+
+    return t;
+}
+
+/**
+ * @brief Calculate time in microseconds since a previous 64 bit timestamp
+ * @param[in] t previous PIOS_DELAY_GetuS64() value
+ * @return time in us since t
+ */
+uint64_t PIOS_DELAY_DiffuS64(uint64_t t)
+{
+    return PIOS_DELAY_GetuS64() - t;
+}
+
+/**
+ * @brief Compute a deadline a given interval from now
+ * @param[in] delay_us interval in microseconds
+ * @return deadline for use with PIOS_DELAY_DeadlineExpired()
+ */
+uint64_t PIOS_DELAY_GetDeadline(uint32_t delay_us)
+{
+    return PIOS_DELAY_GetuS64() + delay_us;
+}
+
+/**
+ * @brief Check whether a deadline has passed
+ * @param[in] deadline value from PIOS_DELAY_GetDeadline()
+ * @return true once the deadline has been reached
+ */
+bool PIOS_DELAY_DeadlineExpired(uint64_t deadline)
+{
+    return PIOS_DELAY_GetuS64() >= deadline;
+}
+
+
 /**
  * @}
  * @}
@@ -253,6 +253,17 @@ int32_t PIOS_FLASHFS_GetStats(__attribute__((unused)) uintptr_t fs_id, __attribu
     return 0;
 }
 
+/**
+ * @brief Persist mount state - meaningless for a directory based backend
+ * @param[in] fs_id The filesystem to use for this action
+ * @return 0 always
+ */
+int32_t PIOS_FLASHFS_SaveIndex(__attribute__((unused)) uintptr_t fs_id)
+{
+    /* stub - nothing to persist, mount state lives in the FAT filesystem */
+    return 0;
+}
+
 #endif /* PIOS_USE_SETTINGS_ON_SDCARD */
 
 /**
@@ -72,6 +72,7 @@ struct jedec_flash_dev {
 #if defined(FLASH_FREERTOS)
     xSemaphoreHandle transaction_lock;
 #endif
+    bool write_pending;
     enum pios_jedec_dev_magic magic;
 };
 
@@ -88,6 +89,7 @@ static int32_t PIOS_Flash_Jedec_ClaimBus(struct jedec_flash_dev *flash_dev, bool
 static int32_t PIOS_Flash_Jedec_ReleaseBus(struct jedec_flash_dev *flash_dev);
 static int32_t PIOS_Flash_Jedec_WriteEnable(struct jedec_flash_dev *flash_dev);
 static int32_t PIOS_Flash_Jedec_Busy(struct jedec_flash_dev *flash_dev);
+static int32_t PIOS_Flash_Jedec_WaitForWrite(struct jedec_flash_dev *flash_dev);
 
 /**
  * @brief Allocate a new device
@@ -102,6 +104,7 @@ static struct jedec_flash_dev *PIOS_Flash_Jedec_alloc(void)
     }
 
     flash_dev->claimed = false;
+    flash_dev->write_pending = false;
     flash_dev->magic   = PIOS_JEDEC_DEV_MAGIC;
 #if defined(FLASH_FREERTOS)
     flash_dev->transaction_lock = xSemaphoreCreateMutex();
@@ -206,6 +209,43 @@ static int32_t PIOS_Flash_Jedec_Busy(struct jedec_flash_dev *flash_dev)
     return status & JEDEC_STATUS_BUSY;
 }
 
+/**
+ * @brief Wait for a previously pipelined page write to complete
+ *
+ * Page writes return as soon as the data is clocked out and only set
+ * write_pending; the WIP poll is deferred to here so the caller can
+ * prepare the next page while the chip programs the last one.
+ *
+ * @returns 0 when the chip is idle, -1 on failure
+ */
+static int32_t PIOS_Flash_Jedec_WaitForWrite(struct jedec_flash_dev *flash_dev)
+{
+    if (!flash_dev->write_pending) {
+        return 0;
+    }
+
+#if defined(FLASH_FREERTOS)
+    while (PIOS_Flash_Jedec_Busy(flash_dev) != 0) {
+        vTaskDelay(1);
+    }
+#else
+    // Query status this way to prevent accel chip locking us out
+    if (PIOS_Flash_Jedec_ClaimBus(flash_dev, true) < 0) {
+        return -1;
+    }
+
+    PIOS_SPI_TransferByte(flash_dev->spi_id, JEDEC_READ_STATUS);
+    while (PIOS_SPI_TransferByte(flash_dev->spi_id, JEDEC_READ_STATUS) & JEDEC_STATUS_BUSY) {
+        ;
+    }
+
+    PIOS_Flash_Jedec_ReleaseBus(flash_dev);
+#endif /* if defined(FLASH_FREERTOS) */
+
+    flash_dev->write_pending = false;
+    return 0;
+}
+
 /**
  * @brief Execute the write enable instruction and returns the status
  * @returns 0 if successful, -1 if unable to claim bus
@@ -353,6 +393,10 @@ static int32_t PIOS_Flash_Jedec_EraseSector(uintptr_t flash_id, uint32_t addr)
     uint8_t ret;
     uint8_t out[] = { flash_dev->cfg->sector_erase, (addr >> 16) & 0xff, (addr >> 8) & 0xff, addr & 0xff };
 
+    if (PIOS_Flash_Jedec_WaitForWrite(flash_dev) != 0) {
+        return -1;
+    }
+
     if ((ret = PIOS_Flash_Jedec_WriteEnable(flash_dev)) != 0) {
         return ret;
     }
@@ -393,6 +437,10 @@ static int32_t PIOS_Flash_Jedec_EraseChip(uintptr_t flash_id)
     uint8_t ret;
     uint8_t out[] = { flash_dev->cfg->chip_erase };
 
+    if (PIOS_Flash_Jedec_WaitForWrite(flash_dev) != 0) {
+        return -1;
+    }
+
     if ((ret = PIOS_Flash_Jedec_WriteEnable(flash_dev)) != 0) {
         return ret;
     }
@@ -458,6 +506,12 @@ static int32_t PIOS_Flash_Jedec_WriteData(uintptr_t flash_id, uint32_t addr, uin
     if (((addr & 0xff) + len) > 0x100) {
         return -3;
     }
+
+    /* Let the previous page finish programming while the caller prepared this one */
+    if (PIOS_Flash_Jedec_WaitForWrite(flash_dev) != 0) {
+        return -1;
+    }
+
     if ((ret = PIOS_Flash_Jedec_WriteEnable(flash_dev)) != 0) {
         return ret;
     }
@@ -479,26 +533,9 @@ static int32_t PIOS_Flash_Jedec_WriteData(uintptr_t flash_id, uint32_t addr, uin
 
     PIOS_Flash_Jedec_ReleaseBus(flash_dev);
 
-    // Keep polling when bus is busy too
-#if defined(FLASH_FREERTOS)
-    while (PIOS_Flash_Jedec_Busy(flash_dev) != 0) {
-        vTaskDelay(1);
-    }
-#else
-
-    // Query status this way to prevent accel chip locking us out
-    if (PIOS_Flash_Jedec_ClaimBus(flash_dev, true) < 0) {
-        return -1;
-    }
+    /* Return while the chip programs; the next operation waits on WIP */
+    flash_dev->write_pending = true;
 
-    PIOS_SPI_TransferByte(flash_dev->spi_id, JEDEC_READ_STATUS);
-    while (PIOS_SPI_TransferByte(flash_dev->spi_id, JEDEC_READ_STATUS) & JEDEC_STATUS_BUSY) {
-        ;
-    }
-
-    PIOS_Flash_Jedec_ReleaseBus(flash_dev);
-
-#endif
     return 0;
 }
 
@@ -537,6 +574,12 @@ static int32_t PIOS_Flash_Jedec_WriteChunks(uintptr_t flash_id, uint32_t addr, s
     if (((addr & 0xff) + len) > 0x100) {
         return -3;
     }
+
+    /* Let the previous page finish programming while the caller prepared this one */
+    if (PIOS_Flash_Jedec_WaitForWrite(flash_dev) != 0) {
+        return -1;
+    }
+
     if ((ret = PIOS_Flash_Jedec_WriteEnable(flash_dev)) != 0) {
         return ret;
     }
@@ -562,7 +605,9 @@ static int32_t PIOS_Flash_Jedec_WriteChunks(uintptr_t flash_id, uint32_t addr, s
     }
     PIOS_Flash_Jedec_ReleaseBus(flash_dev);
 
-    // Skip checking for busy with this to get OS running again fast
+    /* Skip checking for busy with this to get OS running again fast;
+     * the next operation waits on WIP before touching the chip */
+    flash_dev->write_pending = true;
 
     return 0;
 }
@@ -582,6 +627,10 @@ static int32_t PIOS_Flash_Jedec_ReadData(uintptr_t flash_id, uint32_t addr, uint
     if (PIOS_Flash_Jedec_Validate(flash_dev) != 0) {
         return -1;
     }
+    if (PIOS_Flash_Jedec_WaitForWrite(flash_dev) != 0) {
+        return -1;
+    }
+
     bool fast_read = flash_dev->cfg->fast_read != 0;
     if (PIOS_Flash_Jedec_ClaimBus(flash_dev, fast_read) == -1) {
         return -1;
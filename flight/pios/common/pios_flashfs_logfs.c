@@ -30,9 +30,12 @@
 #ifdef PIOS_INCLUDE_FLASH
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
 #include <openpilot.h>
 #include <pios_math.h>
 #include <pios_wdg.h>
+#include <pios_crc.h>
 #include "pios_flashfs_logfs_priv.h"
 
 /*
@@ -56,6 +59,10 @@ struct logfs_state {
     uint16_t num_free_slots; /* slots in free state */
     uint16_t num_active_slots; /* slots in active state */
 
+    /* Persisted mount index bookkeeping (see the logfs_index_* helpers) */
+    int16_t  index_valid_record; /* journal record holding the current counters, -1 if none */
+    uint16_t index_next_record; /* first erased journal record in slot 0 */
+
     /* Underlying flash driver glue */
     const struct pios_flash_driver *driver;
     uintptr_t flash_id;
@@ -416,12 +423,111 @@ static bool logfs_log_is_full(const struct logfs_state *logfs)
     return logfs->num_free_slots == 0;
 }
 
+/*
+ * Persisted mount index
+ *
+ * The tail of slot 0 (after the arena header) holds a small journal of
+ * index records.  Each record captures the slot usage counters that
+ * logfs_mount_log() would otherwise rebuild by reading every slot
+ * header in the arena - the dominant cost of mounting large external
+ * flash.  A record is appended at an explicit quiescent point
+ * (PIOS_FLASHFS_SaveIndex) and invalidated in place (magic zeroed, a
+ * pure 1->0 NOR write) before the next mutation, so any valid record
+ * found at mount time is in sync with the flash contents.  When no
+ * valid record exists the full scan runs as before.  The journal is
+ * recycled whenever garbage collection erases the arena.
+ */
+#define LOGFS_INDEX_MAGIC 0x494E4458 /* 'INDX' */
+
+struct index_record {
+    uint32_t magic;
+    uint16_t num_active_slots;
+    uint16_t num_free_slots;
+    uint8_t  crc; /* CRC-8 over the preceding fields */
+    uint8_t  pad; /* keep halfword alignment for STM32F30X flash writes */
+} __attribute__((packed));
+
+static uint16_t logfs_index_num_records(const struct logfs_state *logfs)
+{
+    return (logfs->cfg->slot_size - sizeof(struct arena_header)) / sizeof(struct index_record);
+}
+
+static uintptr_t logfs_index_addr(const struct logfs_state *logfs, uint16_t record_id)
+{
+    return logfs_get_addr(logfs, logfs->active_arena_id, 0) +
+           sizeof(struct arena_header) +
+           (record_id * sizeof(struct index_record));
+}
+
+static uint8_t logfs_index_crc(const struct index_record *record)
+{
+    return PIOS_CRC_updateCRC(0, (const uint8_t *)record, offsetof(struct index_record, crc));
+}
+
+/**
+ * @brief Restore the slot usage counters from the newest valid index record
+ * @return 0 if the counters were restored, < 0 if a full scan is required
+ * @note Must be called while holding the flash transaction lock
+ */
+static int32_t logfs_index_restore(struct logfs_state *logfs)
+{
+    logfs->index_valid_record = -1;
+    logfs->index_next_record  = logfs_index_num_records(logfs);
+
+    for (uint16_t record_id = 0; record_id < logfs_index_num_records(logfs); record_id++) {
+        struct index_record record;
+        if (logfs->driver->read_data(logfs->flash_id,
+                                     logfs_index_addr(logfs, record_id),
+                                     (uint8_t *)&record,
+                                     sizeof(record)) != 0) {
+            /* Journal state unknown; don't write into it this session */
+            logfs->index_next_record = logfs_index_num_records(logfs);
+            return -1;
+        }
+        if (record.magic == 0xFFFFFFFF) {
+            /* Hit the erased part of the journal */
+            logfs->index_next_record = record_id;
+            break;
+        }
+        if ((record.magic == LOGFS_INDEX_MAGIC) &&
+            (record.crc == logfs_index_crc(&record))) {
+            logfs->index_valid_record = record_id;
+            logfs->num_active_slots   = record.num_active_slots;
+            logfs->num_free_slots     = record.num_free_slots;
+        }
+    }
+
+    return (logfs->index_valid_record >= 0) ? 0 : -2;
+}
+
+/**
+ * @brief Invalidate the current index record before mutating the filesystem
+ * @note Best effort: a failing write here comes from the same driver the
+ *       mutation is about to use, so the mutation itself will fail too
+ * @note Must be called while holding the flash transaction lock
+ */
+static void logfs_index_invalidate(struct logfs_state *logfs)
+{
+    if (logfs->index_valid_record < 0) {
+        return;
+    }
+
+    struct index_record record;
+    memset(&record, 0, sizeof(record));
+    logfs->driver->write_data(logfs->flash_id,
+                              logfs_index_addr(logfs, logfs->index_valid_record),
+                              (uint8_t *)&record,
+                              sizeof(record));
+    logfs->index_valid_record = -1;
+}
+
 static int32_t logfs_unmount_log(struct logfs_state *logfs)
 {
     PIOS_Assert(logfs->mounted);
 
-    logfs->num_active_slots = 0;
-    logfs->num_free_slots   = 0;
+    logfs->num_active_slots   = 0;
+    logfs->num_free_slots     = 0;
+    logfs->index_valid_record = -1;
     logfs->mounted = false;
 
     return 0;
@@ -435,6 +541,14 @@ static int32_t logfs_mount_log(struct logfs_state *logfs, uint8_t arena_id)
     logfs->num_free_slots   = 0;
     logfs->active_arena_id  = arena_id;
 
+    /* A valid persisted index lets us skip the full slot scan */
+    if (logfs_index_restore(logfs) == 0) {
+        logfs->mounted = true;
+        return 0;
+    }
+    logfs->num_active_slots = 0;
+    logfs->num_free_slots   = 0;
+
     /* Scan the log to find out how full it is */
     for (uint16_t slot_id = 1;
          slot_id < (logfs->cfg->arena_size / logfs->cfg->slot_size);
@@ -936,6 +1050,9 @@ int32_t PIOS_FLASHFS_ObjSave(uintptr_t fs_id, uint32_t obj_id, uint16_t obj_inst
         goto out_exit;
     }
 
+    /* The persisted counters are about to go stale */
+    logfs_index_invalidate(logfs);
+
     if (logfs_delete_object(logfs, obj_id, obj_inst_id) != 0) {
         rc = -3;
         goto out_end_trans;
@@ -1087,6 +1204,9 @@ int32_t PIOS_FLASHFS_ObjDelete(uintptr_t fs_id, uint32_t obj_id, uint16_t obj_in
         goto out_exit;
     }
 
+    /* The persisted counters are about to go stale */
+    logfs_index_invalidate(logfs);
+
     if (logfs_delete_object(logfs, obj_id, obj_inst_id) != 0) {
         rc = -3;
         goto out_end_trans;
@@ -1176,6 +1296,64 @@ int32_t PIOS_FLASHFS_GetStats(uintptr_t fs_id, struct PIOS_FLASHFS_Stats *stats)
     stats->num_free_slots   = logfs->num_free_slots;
     return 0;
 }
+
+/**
+ * @brief Persist the slot usage counters so the next mount can skip the full arena scan
+ * @param[in] fs_id The filesystem to use for this action
+ * @return 0 if success (including nothing to do) or error code
+ * @retval -1 if fs_id is not a valid filesystem instance
+ * @retval -2 if failed to start transaction
+ * @retval -3 if writing the index record failed
+ * @note Call at a quiescent point (eg. on disarm); the record is
+ *       invalidated automatically by the next save or delete
+ */
+int32_t PIOS_FLASHFS_SaveIndex(uintptr_t fs_id)
+{
+    int32_t rc;
+
+    struct logfs_state *logfs = (struct logfs_state *)fs_id;
+
+    if (!PIOS_FLASHFS_Logfs_validate(logfs)) {
+        return -1;
+    }
+
+    if (logfs->index_valid_record >= 0) {
+        /* The persisted index is already current */
+        return 0;
+    }
+
+    if (logfs->index_next_record >= logfs_index_num_records(logfs)) {
+        /* Journal is full; it is recycled when garbage collection erases the arena */
+        return 0;
+    }
+
+    if (logfs->driver->start_transaction(logfs->flash_id) != 0) {
+        return -2;
+    }
+
+    struct index_record record = {
+        .magic = LOGFS_INDEX_MAGIC,
+        .num_active_slots = logfs->num_active_slots,
+        .num_free_slots   = logfs->num_free_slots,
+        .pad   = 0xFF,
+    };
+    record.crc = logfs_index_crc(&record);
+
+    if (logfs->driver->write_data(logfs->flash_id,
+                                  logfs_index_addr(logfs, logfs->index_next_record),
+                                  (uint8_t *)&record,
+                                  sizeof(record)) == 0) {
+        logfs->index_valid_record = logfs->index_next_record;
+        logfs->index_next_record++;
+        rc = 0;
+    } else {
+        rc = -3;
+    }
+
+    logfs->driver->end_transaction(logfs->flash_id);
+
+    return rc;
+}
 #endif /* PIOS_INCLUDE_FLASH */
 
 /**
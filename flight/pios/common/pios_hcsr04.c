@@ -41,6 +41,11 @@
 /* 100 ms timeout without updates on channels */
 const static uint32_t PWM_SUPERVISOR_TIMEOUT = 100000;
 
+/* Echoes longer than this are out-of-range pings and are discarded */
+#define HCSR04_ECHO_MAX_US 30000
+/* Median window, enough to swallow two consecutive bad echoes */
+#define HCSR04_FILTER_TAPS 5
+
 struct pios_hcsr04_dev *hcsr04_dev_loc;
 
 enum pios_hcsr04_dev_magic {
@@ -57,8 +62,32 @@ struct pios_hcsr04_dev {
     uint32_t CaptureValue[PIOS_PWM_NUM_INPUTS];
     uint32_t CapCounter[PIOS_PWM_NUM_INPUTS];
     uint32_t us_since_update[PIOS_PWM_NUM_INPUTS];
+
+    uint32_t History[PIOS_PWM_NUM_INPUTS][HCSR04_FILTER_TAPS];
+    uint8_t  HistoryIndex[PIOS_PWM_NUM_INPUTS];
+    uint8_t  HistoryCount[PIOS_PWM_NUM_INPUTS];
 };
 
+/**
+ * Median of the last captures; with a five sample window up to two
+ * spiky echoes are rejected without lagging the output by more than
+ * two pings.
+ */
+static uint32_t PIOS_HCSR04_median(const uint32_t *history, uint8_t count)
+{
+    uint32_t sorted[HCSR04_FILTER_TAPS];
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > history[i]) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = history[i];
+    }
+    return sorted[count / 2];
+}
+
 static bool PIOS_HCSR04_validate(struct pios_hcsr04_dev *hcsr04_dev)
 {
     return hcsr04_dev->magic == PIOS_HCSR04_DEV_MAGIC;
@@ -128,6 +157,8 @@ int32_t PIOS_HCSR04_Init(uint32_t *pwm_id, const struct pios_hcsr04_cfg *cfg)
         hcsr04_dev->RiseValue[i]    = 0;
         hcsr04_dev->FallValue[i]    = 0;
         hcsr04_dev->CaptureValue[i] = PIOS_RCVR_TIMEOUT;
+        hcsr04_dev->HistoryIndex[i] = 0;
+        hcsr04_dev->HistoryCount[i] = 0;
     }
 
     uint32_t tim_id;
@@ -235,6 +266,8 @@ static void PIOS_HCSR04_tim_overflow_cb(uint32_t tim_id, uint32_t context, uint8
         hcsr04_dev->FallValue[channel]       = 0;
         hcsr04_dev->CaptureValue[channel]    = PIOS_RCVR_TIMEOUT;
         hcsr04_dev->us_since_update[channel] = 0;
+        hcsr04_dev->HistoryIndex[channel]    = 0;
+        hcsr04_dev->HistoryCount[channel]    = 0;
     }
 }
 
@@ -275,17 +308,28 @@ static void PIOS_HCSR04_tim_edge_cb(uint32_t tim_id, uint32_t context, uint8_t c
         TIM_ICInit(chan->timer, &TIM_ICInitStructure);
     } else {
         /* Capture computation */
+        uint32_t pulse;
         if (hcsr04_dev->FallValue[chan_idx] > hcsr04_dev->RiseValue[chan_idx]) {
-            hcsr04_dev->CaptureValue[chan_idx] = (hcsr04_dev->FallValue[chan_idx] - hcsr04_dev->RiseValue[chan_idx]);
+            pulse = (hcsr04_dev->FallValue[chan_idx] - hcsr04_dev->RiseValue[chan_idx]);
         } else {
-            hcsr04_dev->CaptureValue[chan_idx] = ((chan->timer->ARR - hcsr04_dev->RiseValue[chan_idx]) + hcsr04_dev->FallValue[chan_idx]);
+            pulse = ((chan->timer->ARR - hcsr04_dev->RiseValue[chan_idx]) + hcsr04_dev->FallValue[chan_idx]);
         }
 
         /* Switch states */
         hcsr04_dev->CaptureState[chan_idx] = 0;
 
-        /* Increase supervisor counter */
-        hcsr04_dev->CapCounter[chan_idx]++;
+        /* Out-of-range pings never enter the filter window */
+        if (pulse <= HCSR04_ECHO_MAX_US) {
+            hcsr04_dev->History[chan_idx][hcsr04_dev->HistoryIndex[chan_idx]] = pulse;
+            hcsr04_dev->HistoryIndex[chan_idx] = (hcsr04_dev->HistoryIndex[chan_idx] + 1) % HCSR04_FILTER_TAPS;
+            if (hcsr04_dev->HistoryCount[chan_idx] < HCSR04_FILTER_TAPS) {
+                hcsr04_dev->HistoryCount[chan_idx]++;
+            }
+            hcsr04_dev->CaptureValue[chan_idx] = PIOS_HCSR04_median(hcsr04_dev->History[chan_idx], hcsr04_dev->HistoryCount[chan_idx]);
+
+            /* Increase supervisor counter */
+            hcsr04_dev->CapCounter[chan_idx]++;
+        }
 
         /* Switch polarity of input capture */
         TIM_ICInitStructure.TIM_ICPolarity = TIM_ICPolarity_Rising;
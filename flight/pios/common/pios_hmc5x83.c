@@ -49,6 +49,39 @@ typedef struct {
 } pios_hmc5x83_dev_data_t;
 
 static int32_t PIOS_HMC5x83_Config(pios_hmc5x83_dev_data_t *dev);
+static int32_t PIOS_HMC5x83_GetSensitivity(pios_hmc5x83_dev_data_t *dev);
+
+#ifdef PIOS_INCLUDE_I2C
+/* DRDY-driven oversampling pipeline (I2C only): each data-ready interrupt
+ * queues a burst read on the asynchronous I2C queue and the completion
+ * callback accumulates the raw sample, so consumers get a pre-averaged
+ * value with no polling and no bus traffic of their own. The I2C
+ * completion callback carries no context, so the pipeline supports a
+ * single device; every board wires at most one DRDY line. */
+
+/* Raw counts a sample may jump from the last accepted one before it is
+ * treated as a spike (~0.23Ga at the default 1.3Ga gain) */
+#define PIOS_HMC5X83_SPIKE_LIMIT    256
+/* A jump persisting this many samples is accepted as a real field step */
+#define PIOS_HMC5X83_SPIKE_SAMPLES  2
+/* Stop accumulating when the consumer stalls, keeps the sums well away
+ * from overflowing int32 after the 1000x scaling */
+#define PIOS_HMC5X83_OVERSAMPLE_MAX 256
+
+static pios_hmc5x83_dev_data_t *async_dev;
+static uint8_t async_reg = PIOS_HMC5x83_DATAOUT_XMSB_REG;
+static uint8_t async_buffer[6];
+static struct pios_i2c_txn async_txn_list[2];
+static volatile bool async_in_flight;
+static volatile int32_t async_accum[3]; // raw counts in X,Z,Y chip order
+static volatile uint16_t async_accum_count;
+static int16_t async_last[3];
+static bool async_last_valid;
+static uint8_t async_spike_count;
+
+static void PIOS_HMC5x83_AsyncComplete(void);
+static int32_t PIOS_HMC5x83_ReadMagAverage(pios_hmc5x83_dev_data_t *dev, int16_t out[3]);
+#endif /* PIOS_INCLUDE_I2C */
 
 /**
  * Allocate the device setting structure
@@ -201,59 +234,183 @@ int32_t PIOS_HMC5x83_ReadMag(pios_hmc5x83_dev_t handler, int16_t out[3])
 {
     pios_hmc5x83_dev_data_t *dev = dev_validate(handler);
 
+#ifdef PIOS_INCLUDE_I2C
+    if (dev == async_dev) {
+        /* The DRDY pipeline already holds accumulated samples */
+        return PIOS_HMC5x83_ReadMagAverage(dev, out);
+    }
+#endif
+
     dev->data_ready = false;
     uint8_t buffer[6];
     int32_t temp;
-    int32_t sensitivity;
+    int32_t sensitivity = PIOS_HMC5x83_GetSensitivity(dev);
 
     if (dev->cfg->Driver->Read(handler, PIOS_HMC5x83_DATAOUT_XMSB_REG, buffer, 6) != 0) {
         return -1;
     }
 
+    for (int i = 0; i < 3; i++) {
+        temp   = ((int16_t)((uint16_t)buffer[2 * i] << 8)
+                  + buffer[2 * i + 1]) * 1000 / sensitivity;
+        out[i] = temp;
+    }
+    // Data reads out as X,Z,Y
+    temp   = out[2];
+    out[2] = out[1];
+    out[1] = temp;
+
+    // This should not be necessary but for some reason it is coming out of continuous conversion mode
+    dev->cfg->Driver->Write(handler, PIOS_HMC5x83_MODE_REG, PIOS_HMC5x83_MODE_CONTINUOUS);
+
+    return 0;
+}
+
+/**
+ * @brief Return the sensitivity for the configured gain in LSB/Ga
+ */
+static int32_t PIOS_HMC5x83_GetSensitivity(pios_hmc5x83_dev_data_t *dev)
+{
     switch (dev->CTRLB & 0xE0) {
     case 0x00:
-        sensitivity = PIOS_HMC5x83_Sensitivity_0_88Ga;
-        break;
+        return PIOS_HMC5x83_Sensitivity_0_88Ga;
+
     case 0x20:
-        sensitivity = PIOS_HMC5x83_Sensitivity_1_3Ga;
-        break;
+        return PIOS_HMC5x83_Sensitivity_1_3Ga;
+
     case 0x40:
-        sensitivity = PIOS_HMC5x83_Sensitivity_1_9Ga;
-        break;
+        return PIOS_HMC5x83_Sensitivity_1_9Ga;
+
     case 0x60:
-        sensitivity = PIOS_HMC5x83_Sensitivity_2_5Ga;
-        break;
+        return PIOS_HMC5x83_Sensitivity_2_5Ga;
+
     case 0x80:
-        sensitivity = PIOS_HMC5x83_Sensitivity_4_0Ga;
-        break;
+        return PIOS_HMC5x83_Sensitivity_4_0Ga;
+
     case 0xA0:
-        sensitivity = PIOS_HMC5x83_Sensitivity_4_7Ga;
-        break;
+        return PIOS_HMC5x83_Sensitivity_4_7Ga;
+
     case 0xC0:
-        sensitivity = PIOS_HMC5x83_Sensitivity_5_6Ga;
-        break;
+        return PIOS_HMC5x83_Sensitivity_5_6Ga;
+
     case 0xE0:
-        sensitivity = PIOS_HMC5x83_Sensitivity_8_1Ga;
-        break;
+        return PIOS_HMC5x83_Sensitivity_8_1Ga;
+
     default:
         PIOS_Assert(0);
     }
+    return 0;
+}
+
+#ifdef PIOS_INCLUDE_I2C
+/**
+ * @brief Enable the DRDY-driven oversampling pipeline for this device.
+ * Only valid for I2C connected parts with a wired data-ready line; once
+ * enabled, PIOS_HMC5x83_ReadMag() returns the accumulated average.
+ * \return 0 for success, -1 for failure
+ */
+int32_t PIOS_HMC5x83_AsyncStart(pios_hmc5x83_dev_t handler)
+{
+    pios_hmc5x83_dev_data_t *dev = dev_validate(handler);
+
+    if (dev->cfg->Driver != &PIOS_HMC5x83_I2C_DRIVER) {
+        return -1;
+    }
+
+    async_txn_list[0].info = __func__;
+    async_txn_list[0].addr = PIOS_HMC5x83_I2C_ADDR;
+    async_txn_list[0].rw   = PIOS_I2C_TXN_WRITE;
+    async_txn_list[0].len  = sizeof(async_reg);
+    async_txn_list[0].buf  = &async_reg;
+
+    async_txn_list[1].info = __func__;
+    async_txn_list[1].addr = PIOS_HMC5x83_I2C_ADDR;
+    async_txn_list[1].rw   = PIOS_I2C_TXN_READ;
+    async_txn_list[1].len  = sizeof(async_buffer);
+    async_txn_list[1].buf  = async_buffer;
+
+    async_dev = dev;
+    return 0;
+}
+
+/**
+ * @brief Completion callback for the DRDY burst read, runs in interrupt
+ * context: rejects single-sample spikes and accumulates the rest.
+ */
+static void PIOS_HMC5x83_AsyncComplete(void)
+{
+    int16_t raw[3];
+
+    for (int i = 0; i < 3; i++) {
+        raw[i] = (int16_t)(((uint16_t)async_buffer[2 * i] << 8) + async_buffer[2 * i + 1]);
+    }
+
+    if (async_last_valid && (async_spike_count < PIOS_HMC5X83_SPIKE_SAMPLES)) {
+        for (int i = 0; i < 3; i++) {
+            int32_t delta = (int32_t)raw[i] - async_last[i];
+            if ((delta > PIOS_HMC5X83_SPIKE_LIMIT) || (delta < -PIOS_HMC5X83_SPIKE_LIMIT)) {
+                /* isolated spike, drop it; a persistent jump gets through */
+                async_spike_count++;
+                async_in_flight = false;
+                return;
+            }
+        }
+    }
+    async_spike_count = 0;
 
     for (int i = 0; i < 3; i++) {
-        temp   = ((int16_t)((uint16_t)buffer[2 * i] << 8)
-                  + buffer[2 * i + 1]) * 1000 / sensitivity;
-        out[i] = temp;
+        async_last[i] = raw[i];
+        if (async_accum_count < PIOS_HMC5X83_OVERSAMPLE_MAX) {
+            async_accum[i] += raw[i];
+        }
+    }
+    async_last_valid = true;
+    if (async_accum_count < PIOS_HMC5X83_OVERSAMPLE_MAX) {
+        async_accum_count++;
+    }
+    if (async_dev) { // may have been suspended while this read was in flight
+        async_dev->data_ready = true;
+    }
+    async_in_flight = false;
+}
+
+/**
+ * @brief Return the average of the samples accumulated since the last
+ * call, scaled like PIOS_HMC5x83_ReadMag()
+ * \return 0 for success, -1 when no sample has arrived yet
+ */
+static int32_t PIOS_HMC5x83_ReadMagAverage(pios_hmc5x83_dev_data_t *dev, int16_t out[3])
+{
+    int32_t accum[3];
+    uint16_t count;
+    int32_t temp;
+    int32_t sensitivity = PIOS_HMC5x83_GetSensitivity(dev);
+
+    PIOS_IRQ_Disable();
+    count = async_accum_count;
+    for (int i = 0; i < 3; i++) {
+        accum[i]       = async_accum[i];
+        async_accum[i] = 0;
+    }
+    async_accum_count = 0;
+    dev->data_ready   = false;
+    PIOS_IRQ_Enable();
+
+    if (!count) {
+        return -1;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        out[i] = (accum[i] * 1000) / (sensitivity * (int32_t)count);
     }
     // Data reads out as X,Z,Y
     temp   = out[2];
     out[2] = out[1];
     out[1] = temp;
 
-    // This should not be necessary but for some reason it is coming out of continuous conversion mode
-    dev->cfg->Driver->Write(handler, PIOS_HMC5x83_MODE_REG, PIOS_HMC5x83_MODE_CONTINUOUS);
-
     return 0;
 }
+#endif /* PIOS_INCLUDE_I2C */
 
 
 /**
@@ -282,11 +439,29 @@ bool PIOS_HMC5x83_NewDataAvailable(pios_hmc5x83_dev_t handler)
     return dev->data_ready;
 }
 
+static int32_t PIOS_HMC5x83_TestInternal(pios_hmc5x83_dev_t handler);
+
 /**
  * @brief Run self-test operation.  Do not call this during operational use!!
  * \return 0 if success, -1 if test failed
  */
 int32_t PIOS_HMC5x83_Test(pios_hmc5x83_dev_t handler)
+{
+#ifdef PIOS_INCLUDE_I2C
+    /* Suspend the DRDY pipeline so the test reads the part directly */
+    pios_hmc5x83_dev_data_t *saved_async_dev = async_dev;
+    async_dev = NULL;
+#endif
+
+    int32_t res = PIOS_HMC5x83_TestInternal(handler);
+
+#ifdef PIOS_INCLUDE_I2C
+    async_dev = saved_async_dev;
+#endif
+    return res;
+}
+
+static int32_t PIOS_HMC5x83_TestInternal(pios_hmc5x83_dev_t handler)
 {
     int32_t failed = 0;
     uint8_t registers[3] = { 0, 0, 0 };
@@ -383,6 +558,19 @@ bool PIOS_HMC5x83_IRQHandler(pios_hmc5x83_dev_t handler)
 {
     pios_hmc5x83_dev_data_t *dev = dev_validate(handler);
 
+#ifdef PIOS_INCLUDE_I2C
+    if ((dev == async_dev) && !async_in_flight) {
+        /* Queue the burst read right from the DRDY edge; if the bus is
+         * owned by a synchronous transfer the async queue holds it */
+        async_in_flight = true;
+        if (PIOS_I2C_Transfer_Callback(dev->port_id, async_txn_list,
+                                       NELEMENTS(async_txn_list), (void *)PIOS_HMC5x83_AsyncComplete) != 0) {
+            async_in_flight = false;
+        }
+        return false;
+    }
+#endif
+
     dev->data_ready = true;
     return false;
 }
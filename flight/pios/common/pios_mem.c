@@ -27,6 +27,122 @@
 #include <pios.h>
 #include <pios_mem.h>
 
+#ifdef PIOS_INCLUDE_MEM_POOLS
+/*
+ * Size class pools served from static slabs in front of the general
+ * heap.  The classes cover the hot small allocations (event list
+ * entries, periodic event records, com and queue bookkeeping), which
+ * are the ones that churn while armed and fragment the heap over a
+ * long mission.  A pool allocation is a deterministic free list pop;
+ * when a pool runs dry the request falls back to the heap and the miss
+ * is counted, so the sizing can be verified in flight through the
+ * MemoryStats object.
+ */
+struct mem_pool {
+    void     *free_list;
+    uint8_t  *slab;
+    uint32_t slab_size;
+    struct pios_mem_pool_stats stats;
+};
+
+// block sizes must stay multiples of 8 to preserve heap alignment
+#define MEM_POOL_SLAB(bsize, nblocks) \
+    static uint8_t pool_slab_##bsize[(bsize) * (nblocks)] __attribute__((aligned(8)))
+#define MEM_POOL_INIT(bsize, nblocks) \
+    { .slab = pool_slab_##bsize, .slab_size = (bsize) * (nblocks), \
+      .stats = { .block_size = (bsize), .num_blocks = (nblocks) } }
+
+MEM_POOL_SLAB(16, 32);
+MEM_POOL_SLAB(32, 32);
+MEM_POOL_SLAB(64, 16);
+MEM_POOL_SLAB(128, 8);
+
+static struct mem_pool pools[PIOS_MEM_NUM_POOLS] = {
+    MEM_POOL_INIT(16, 32),
+    MEM_POOL_INIT(32, 32),
+    MEM_POOL_INIT(64, 16),
+    MEM_POOL_INIT(128, 8),
+};
+static bool pools_initialized;
+
+// chain all blocks of all pools onto their free lists, called with IRQs disabled
+static void pool_init(void)
+{
+    for (int i = 0; i < PIOS_MEM_NUM_POOLS; i++) {
+        struct mem_pool *pool = &pools[i];
+        for (uint32_t b = 0; b < pool->stats.num_blocks; b++) {
+            void *block = pool->slab + b * pool->stats.block_size;
+            *(void **)block = pool->free_list;
+            pool->free_list = block;
+        }
+    }
+    pools_initialized = true;
+}
+
+static void *pool_malloc(size_t size)
+{
+    void *p = NULL;
+
+    PIOS_IRQ_Disable();
+    if (!pools_initialized) {
+        pool_init();
+    }
+    for (int i = 0; i < PIOS_MEM_NUM_POOLS; i++) {
+        struct mem_pool *pool = &pools[i];
+        if (size > pool->stats.block_size) {
+            continue;
+        }
+        if (pool->free_list) {
+            p = pool->free_list;
+            pool->free_list  = *(void **)p;
+            pool->stats.in_use++;
+            if (pool->stats.in_use > pool->stats.high_water) {
+                pool->stats.high_water = pool->stats.in_use;
+            }
+        } else {
+            pool->stats.fallbacks++;
+        }
+        break;
+    }
+    PIOS_IRQ_Enable();
+    return p;
+}
+
+// returns true if the pointer belonged to a pool and was returned to it
+static bool pool_free(void *p)
+{
+    for (int i = 0; i < PIOS_MEM_NUM_POOLS; i++) {
+        struct mem_pool *pool = &pools[i];
+        if ((uint8_t *)p >= pool->slab && (uint8_t *)p < pool->slab + pool->slab_size) {
+            PIOS_IRQ_Disable();
+            *(void **)p     = pool->free_list;
+            pool->free_list = p;
+            pool->stats.in_use--;
+            PIOS_IRQ_Enable();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Retrieve occupancy statistics of one size class pool
+ * @param[in] pool index (0 .. PIOS_MEM_NUM_POOLS - 1)
+ * @param[out] stats statistics snapshot
+ * @return true on success, false for an invalid pool index
+ */
+bool PIOS_MEM_GetPoolStats(uint8_t pool, struct pios_mem_pool_stats *stats)
+{
+    if (pool >= PIOS_MEM_NUM_POOLS || !stats) {
+        return false;
+    }
+    PIOS_IRQ_Disable();
+    *stats = pools[pool].stats;
+    PIOS_IRQ_Enable();
+    return true;
+}
+#endif /* PIOS_INCLUDE_MEM_POOLS */
+
 #ifdef PIOS_TARGET_PROVIDES_FAST_HEAP
 // relies on pios_general_malloc to perform the allocation (i.e. pios_msheap.c)
 extern void *pios_general_malloc(size_t size, bool fastheap);
@@ -39,11 +155,22 @@ void *pios_fastheapmalloc(size_t size)
 
 void *pios_malloc(size_t size)
 {
+#ifdef PIOS_INCLUDE_MEM_POOLS
+    void *p = pool_malloc(size);
+    if (p) {
+        return p;
+    }
+#endif
     return pios_general_malloc(size, false);
 }
 
 void pios_free(void *p)
 {
+#ifdef PIOS_INCLUDE_MEM_POOLS
+    if (pool_free(p)) {
+        return;
+    }
+#endif
     vPortFree(p);
 }
 
@@ -57,12 +184,37 @@ void *pios_fastheapmalloc(size_t size)
 
 void *pios_malloc(size_t size)
 {
+#ifdef PIOS_INCLUDE_MEM_POOLS
+    void *p = pool_malloc(size);
+    if (p) {
+        return p;
+    }
+#endif
     return pvPortMalloc(size);
 }
 
 void pios_free(void *p)
 {
+#ifdef PIOS_INCLUDE_MEM_POOLS
+    if (pool_free(p)) {
+        return;
+    }
+#endif
     vPortFree(p);
 }
 
 #endif /* ifdef PIOS_TARGET_PROVIDES_FAST_HEAP */
+
+/**
+ * @brief Allocate from a declared allocation class
+ * @param[in] mem_class placement class for the data
+ * @param[in] size number of bytes
+ * @return pointer to the allocation, NULL on failure
+ */
+void *pios_malloc_class(enum pios_mem_class mem_class, size_t size)
+{
+    if (mem_class == PIOS_MEM_CLASS_HOT_NODMA) {
+        return pios_fastheapmalloc(size);
+    }
+    return pios_malloc(size);
+}
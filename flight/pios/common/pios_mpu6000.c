@@ -84,6 +84,10 @@ typedef union {
 
 #define GET_SENSOR_DATA(mpudataptr, sensor) (mpudataptr.data.sensor##_h << 8 | mpudataptr.data.sensor##_l)
 
+// Maximum number of complete samples drained from the FIFO in one burst
+// SPI transaction; any further backlog is left for the next interrupt
+#define PIOS_MPU6000_FIFO_BURST_MAX 4
+
 // ! Global structure for this device device
 static struct mpu6000_dev *dev;
 volatile bool mpu6000_configured = false;
@@ -740,13 +744,27 @@ static bool PIOS_MPU6000_ReadFifo(bool *woken)
         return false;
     }
 
+    /* Drain every complete sample in the FIFO with a single burst
+     * transaction instead of paying the transfer setup cost per sample.
+     * The register address wraps back to the FIFO data register, so one
+     * read delivers consecutive samples in order. */
+    uint8_t frames = mpu6000_count / PIOS_MPU6000_SAMPLES_BYTES;
+    if (frames > PIOS_MPU6000_FIFO_BURST_MAX) {
+        /* Cap the transfer; the backlog is picked up by the next interrupt */
+        frames = PIOS_MPU6000_FIFO_BURST_MAX;
+        mpu6000_fifo_backup++;
+    }
+    mpu6000_last_read_count = frames;
+    mpu6000_transfer_size   = 1 + (frames * PIOS_MPU6000_SAMPLES_BYTES);
+
+    static const uint8_t mpu6000_send_buf[1 + (PIOS_MPU6000_SAMPLES_BYTES * PIOS_MPU6000_FIFO_BURST_MAX)] = { PIOS_MPU6000_FIFO_REG | 0x80 };
+    static uint8_t mpu6000_rec_buf[1 + (PIOS_MPU6000_SAMPLES_BYTES * PIOS_MPU6000_FIFO_BURST_MAX)];
+
     if (PIOS_MPU6000_ClaimBusISR(woken, true) != 0) {
         return false;
     }
 
-    const uint8_t mpu6000_send_buf[1 + PIOS_MPU6000_SAMPLES_BYTES] = { PIOS_MPU6000_FIFO_REG | 0x80 };
-
-    if (PIOS_SPI_TransferBlock(dev->spi_id, &mpu6000_send_buf[0], &mpu6000_data.buffer[0], sizeof(mpu6000_data_t), NULL) < 0) {
+    if (PIOS_SPI_TransferBlock(dev->spi_id, &mpu6000_send_buf[0], &mpu6000_rec_buf[0], mpu6000_transfer_size, NULL) < 0) {
         PIOS_MPU6000_ReleaseBusISR(woken);
         mpu6000_fails++;
         return false;
@@ -754,20 +772,17 @@ static bool PIOS_MPU6000_ReadFifo(bool *woken)
 
     PIOS_MPU6000_ReleaseBusISR(woken);
 
-    // In the case where extras samples backed up grabbed an extra
-    if (mpu6000_count >= PIOS_MPU6000_SAMPLES_BYTES * 2) {
-        mpu6000_fifo_backup++;
-        if (PIOS_MPU6000_ClaimBusISR(woken, true) != 0) {
-            return false;
-        }
-
-        if (PIOS_SPI_TransferBlock(dev->spi_id, &mpu6000_send_buf[0], &mpu6000_data.buffer[0], sizeof(mpu6000_data_t), NULL) < 0) {
-            PIOS_MPU6000_ReleaseBusISR(woken);
-            mpu6000_fails++;
-            return false;
+    /* Queue all but the newest sample here; the newest one is left in
+     * mpu6000_data and queued by the caller as in the single sample path.
+     * The samples are equally spaced at the configured output rate, so
+     * their order in the queue carries the timing. */
+    for (uint8_t i = 0; i < frames; i++) {
+        memcpy(&mpu6000_data.buffer[1], &mpu6000_rec_buf[1 + (i * PIOS_MPU6000_SAMPLES_BYTES)], PIOS_MPU6000_SAMPLES_BYTES);
+        if ((i + 1) < frames) {
+            if (PIOS_MPU6000_HandleData()) {
+                *woken = true;
+            }
         }
-
-        PIOS_MPU6000_ReleaseBusISR(woken);
     }
     return true;
 }
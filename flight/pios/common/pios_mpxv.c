@@ -40,13 +40,18 @@
 
 #include "pios_mpxv.h"
 
+// Averaging 4^n hardware paced samples gains n bits of resolution; two
+// extra bits quadruple the pressure resolution of the 12 bit ADC
+#define PIOS_MPXV_OVERSAMPLE_BITS 2
+
 /*
  * Reads ADC.
  */
 uint16_t PIOS_MPXV_Measure(PIOS_MPXV_descriptor *desc)
 {
     if (desc) {
-        return PIOS_ADC_PinGet(desc->airspeedADCPin);
+        PIOS_ADC_PinSetOversampleBits(desc->airspeedADCPin, PIOS_MPXV_OVERSAMPLE_BITS);
+        return PIOS_ADC_PinGetOversampled(desc->airspeedADCPin);
     }
     return 0;
 }
@@ -69,7 +74,7 @@ uint16_t PIOS_MPXV_Calibrate(PIOS_MPXV_descriptor *desc, uint16_t measurement)
 float PIOS_MPXV_CalcAirspeed(PIOS_MPXV_descriptor *desc, uint16_t measurement)
 {
     // Calculate dynamic pressure, as per docs
-    float Qc = 3.3f / 4096.0f * (float)(measurement - desc->zeroPoint);
+    float Qc = 3.3f / (float)(4096 << PIOS_MPXV_OVERSAMPLE_BITS) * (float)(measurement - desc->zeroPoint);
 
     // Saturate Qc on the lower bound, in order to make sure we don't have negative airspeeds. No need
     // to saturate on the upper bound, we'll handle that later with calibratedAirspeed.
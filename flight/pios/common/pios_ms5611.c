@@ -61,6 +61,14 @@ static uint32_t oversampling;
 static const struct pios_ms5611_cfg *dev_cfg;
 static int32_t i2c_id;
 
+/* Non-blocking conversion state machine, driven by PIOS_MS5611_Update() */
+static PIOS_MS5611_ConversionCallback conversion_callback;
+static uint8_t temp_interleave = 1; // pressure conversions per temperature conversion
+static uint8_t temp_interleave_count;
+static bool conversion_pending;
+
+static int32_t PIOS_MS5611_ProcessADC(void);
+
 
 /**
  * Initialise the MS5611 sensor
@@ -170,6 +178,32 @@ uint32_t PIOS_MS5611_GetDelayUs()
  * \return 0 if successfully read the ADC, -1 if failed
  */
 int32_t PIOS_MS5611_ReadADC(void)
+{
+    while (PIOS_MS5611_GetDelayUs() > PIOS_DELAY_DiffuS(lastConversionStart)) {
+        vTaskDelay(0);
+    }
+    return PIOS_MS5611_ProcessADC();
+}
+
+/**
+ * Read the ADC conversion value without waiting for it
+ * \return 0 if successfully read the ADC, -1 if the conversion is still
+ * running or the read failed
+ */
+int32_t PIOS_MS5611_PollADC(void)
+{
+    if (PIOS_MS5611_GetDelayUs() > PIOS_DELAY_DiffuS(lastConversionStart)) {
+        /* conversion still running */
+        return -1;
+    }
+    return PIOS_MS5611_ProcessADC();
+}
+
+/**
+ * Read and compensate a completed ADC conversion
+ * \return 0 if successfully read the ADC, -1 if failed
+ */
+static int32_t PIOS_MS5611_ProcessADC(void)
 {
     uint8_t Data[3];
 
@@ -177,9 +211,6 @@ int32_t PIOS_MS5611_ReadADC(void)
     Data[1] = 0;
     Data[2] = 0;
 
-    while (PIOS_MS5611_GetDelayUs() > PIOS_DELAY_DiffuS(lastConversionStart)) {
-        vTaskDelay(0);
-    }
     static int64_t deltaTemp;
 
     /* Read and store the 16bit result */
@@ -245,6 +276,81 @@ int32_t PIOS_MS5611_ReadADC(void)
     return 0;
 }
 
+/**
+ * Register a callback invoked after each completed conversion. Runs in
+ * the context calling PIOS_MS5611_Update().
+ */
+void PIOS_MS5611_RegisterConversionCallback(PIOS_MS5611_ConversionCallback callback)
+{
+    conversion_callback = callback;
+}
+
+/**
+ * Set how many pressure conversions are run for each temperature
+ * conversion. The die temperature moves far slower than the pressure, so
+ * refreshing it less often raises the achievable pressure rate.
+ */
+void PIOS_MS5611_SetTempInterleave(uint8_t conversions)
+{
+    if (conversions) {
+        temp_interleave = conversions;
+    }
+}
+
+/**
+ * Time until the running conversion is expected to complete, so callers
+ * can sleep instead of polling.
+ * \return remaining time in microseconds, 0 if no conversion is running
+ */
+uint32_t PIOS_MS5611_GetRemainingDelayUs(void)
+{
+    uint32_t delay   = PIOS_MS5611_GetDelayUs();
+    uint32_t elapsed = PIOS_DELAY_DiffuS(lastConversionStart);
+
+    if (!conversion_pending || (elapsed >= delay)) {
+        return 0;
+    }
+    return delay - elapsed;
+}
+
+/**
+ * Drive the conversion state machine: starts conversions, returns
+ * immediately while one is running and reads, compensates and reports
+ * completed ones via the registered callback. Temperature and pressure
+ * phases are interleaved per PIOS_MS5611_SetTempInterleave().
+ * \return 0 if a conversion completed on this call, -1 otherwise
+ */
+int32_t PIOS_MS5611_Update(void)
+{
+    if (conversion_pending) {
+        ConversionTypeTypeDef completed = CurrentRead;
+
+        if (PIOS_MS5611_PollADC() != 0) {
+            /* still converting, or the read failed and the sample is lost */
+            if (PIOS_MS5611_GetRemainingDelayUs() == 0) {
+                conversion_pending = false;
+            }
+            return -1;
+        }
+        conversion_pending = false;
+        if (conversion_callback) {
+            conversion_callback(completed);
+        }
+        return 0;
+    }
+
+    /* Start the next conversion so the sensor is never left idle */
+    if (temp_interleave_count == 0) {
+        temp_interleave_count = temp_interleave;
+        PIOS_MS5611_StartADC(TemperatureConv);
+    } else {
+        temp_interleave_count--;
+        PIOS_MS5611_StartADC(PressureConv);
+    }
+    conversion_pending = true;
+    return -1;
+}
+
 /**
  * Return the most recently computed temperature in kPa
  */
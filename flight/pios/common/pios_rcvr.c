@@ -145,6 +145,66 @@ xSemaphoreHandle PIOS_RCVR_GetSemaphore(uint32_t rcvr_id, uint8_t channel)
     return NULL;
 }
 
+#ifdef PIOS_INCLUDE_RCVR_STATS
+/**
+ * @brief Get the frame timing statistics from the underlying driver
+ * @param[in] rcvr_id driver to query
+ * @param[out] stats filled in on success
+ * @returns 0 on success, -1 when the driver keeps no frame statistics
+ */
+int32_t PIOS_RCVR_GetFrameStats(uint32_t rcvr_id, struct pios_rcvr_frame_stats *stats)
+{
+    if (rcvr_id == 0) {
+        return -1;
+    }
+
+    struct pios_rcvr_dev *rcvr_dev = (struct pios_rcvr_dev *)rcvr_id;
+
+    if (!PIOS_RCVR_validate(rcvr_dev)) {
+        /* Undefined RCVR port for this board (see pios_board.c) */
+        PIOS_Assert(0);
+    }
+
+    if (rcvr_dev->driver->get_frame_stats) {
+        return rcvr_dev->driver->get_frame_stats(rcvr_dev->lower_id, stats);
+    }
+    return -1;
+}
+
+/**
+ * @brief Fold a completed frame into the driver's timing statistics.
+ *
+ * Called by the frame decoding drivers from the rx interrupt when the
+ * last byte of a good frame has been processed.  The period statistics
+ * are smoothed with a 1/8 weight so a single delayed frame is visible
+ * in jitter_us without swinging the mean.
+ */
+void PIOS_RCVR_RecordFrame(struct pios_rcvr_frame_stats *stats, uint32_t *last_frame_raw)
+{
+    if (stats->frame_count++) {
+        uint32_t period = PIOS_DELAY_DiffuS(*last_frame_raw);
+        if (period > 0xffff) {
+            period = 0xffff;
+        }
+        stats->period_us = period;
+        if (stats->mean_period_us == 0) {
+            stats->mean_period_us = period;
+        } else {
+            stats->mean_period_us += ((int32_t)period - stats->mean_period_us) / 8;
+        }
+        int32_t deviation = (int32_t)period - stats->mean_period_us;
+        if (deviation < 0) {
+            deviation = -deviation;
+        }
+        stats->jitter_us += (deviation - stats->jitter_us) / 8;
+        if (deviation > stats->max_jitter_us) {
+            stats->max_jitter_us = deviation;
+        }
+    }
+    *last_frame_raw = PIOS_DELAY_GetRaw();
+}
+#endif /* PIOS_INCLUDE_RCVR_STATS */
+
 #endif /* PIOS_INCLUDE_RCVR */
 
 /**
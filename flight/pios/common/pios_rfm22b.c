@@ -76,6 +76,18 @@
 #define RFM22B_DEFAULT_CHANNEL_SET       24
 #define RFM22B_PPM_ONLY_DATARATE         RFM22_datarate_9600
 
+// Control frame encoding.  The header byte carries the frame type in its top
+// bits and a rolling sequence number in the low bits.  A key frame carries
+// the validity bitmask and all channel values; a delta frame only carries the
+// channels that moved since the previous frame, as modulo 256 differences.
+#define RFM22B_CONTROL_FRAME_DELTA       0x00
+#define RFM22B_CONTROL_FRAME_KEY         0x40
+#define RFM22B_CONTROL_TYPE_MASK         0xC0
+#define RFM22B_CONTROL_SEQ_MASK          0x3F
+// Delta frames sent between two key frames.  Each key frame resynchronizes a
+// receiver that missed a frame, so this bounds the outage after a lost frame.
+#define RFM22B_CONTROL_KEY_INTERVAL      8
+
 // The maximum amount of time without activity before initiating a reset.
 #define PIOS_RFM22B_SUPERVISOR_TIMEOUT   150  // ms
 
@@ -360,6 +372,11 @@ static const uint8_t packet_time[] = { 80, 40, 25, 15, 13, 10, 8, 6, 5 };
 static const uint8_t packet_time_ppm[] = { 26, 25, 25, 15, 13, 10, 8, 6, 5 };
 static const uint8_t num_channels[] = { 4, 4, 4, 6, 8, 8, 10, 12, 16 };
 
+// Frame aggregation: a payload shorter than half the packet is held back for
+// up to this many of our own transmit opportunities so the preamble/sync/ECC
+// overhead is spent on fuller frames.
+#define RFM22B_AGGREGATION_SLOTS 2
+
 static struct pios_rfm22b_dev *g_rfm22b_dev = NULL;
 
 
@@ -582,6 +599,15 @@ void PIOS_RFM22B_SetChannelConfig(uint32_t rfm22b_id, enum rfm22b_datarate datar
     rfm22b_dev->coordinator   = coordinator;
     rfm22b_dev->ppm_send_mode = ppm_mode && coordinator;
     rfm22b_dev->ppm_recv_mode = ppm_mode && !coordinator;
+
+    // Reset the control frame delta coder on both sides.  The first frame
+    // sent after a (re)configuration is always a key frame.
+    rfm22b_dev->ppm_sent_mask     = 0;
+    rfm22b_dev->ppm_seq           = 0;
+    rfm22b_dev->ppm_frames_to_key = 0;
+    rfm22b_dev->ppm_recv_mask     = 0;
+    rfm22b_dev->ppm_recv_seq      = 0;
+    rfm22b_dev->ppm_base_valid    = false;
     if (ppm_mode && (datarate <= RFM22B_PPM_ONLY_DATARATE)) {
         ppm_only = true;
     }
@@ -1348,6 +1374,8 @@ static enum pios_radio_event rfm22_init(struct pios_rfm22b_dev *rfm22b_dev)
     // Initialize the devide state
     rfm22b_dev->rx_buffer_wr       = 0;
     rfm22b_dev->tx_data_rd         = rfm22b_dev->tx_data_wr = 0;
+    rfm22b_dev->tx_staged_len      = 0;
+    rfm22b_dev->tx_stage_ticks     = 0;
     rfm22b_dev->channel = 0;
     rfm22b_dev->channel_index      = 0;
     rfm22b_dev->afc_correction_Hz  = 0;
@@ -1760,42 +1788,88 @@ static enum pios_radio_event radio_txStart(struct pios_rfm22b_dev *radio_dev)
 
     // Should we append PPM data to the packet?
     if (radio_dev->ppm_send_mode) {
-        len = RFM22B_PPM_NUM_CHANNELS + (radio_dev->ppm_only_mode ? 2 : 1);
-
-        // Ensure we can fit the PPM data in the packet.
-        if (max_data_len < len) {
+        // Ensure the worst case control frame (a key frame) fits in the packet.
+        if (max_data_len < RFM22B_PPM_NUM_CHANNELS + 3) {
             return RADIO_EVENT_RX_MODE;
         }
 
-        // The first byte is a bitmask of valid channels.
-        p[0] = 0;
-
-        // Read the PPM input.
+        // Quantize the PPM inputs to the on-air range.
+        uint8_t vals[RFM22B_PPM_NUM_CHANNELS];
+        uint8_t valid = 0;
         for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
             int32_t val = radio_dev->ppm[i];
             if ((val == PIOS_RCVR_INVALID) || (val == PIOS_RCVR_TIMEOUT)) {
-                p[i + 1] = 0;
+                vals[i] = 0;
             } else {
-                p[0]    |= 1 << i;
-                p[i + 1] = (val < 1000) ? 0 : ((val >= 1900) ? 255 : (uint8_t)(256 * (val - 1000) / 900));
+                valid  |= 1 << i;
+                vals[i] = (val < 1000) ? 0 : ((val >= 1900) ? 255 : (uint8_t)(256 * (val - 1000) / 900));
             }
         }
 
-        // The last byte is a CRC.
-        if (radio_dev->ppm_only_mode) {
-            uint8_t crc = 0;
-            for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS + 1; ++i) {
-                crc = PIOS_CRC_updateByte(crc, p[i]);
+        // A delta frame references the values last sent on air, so a key
+        // frame is needed whenever the validity mask changed, and
+        // periodically so a receiver that missed a frame resynchronizes.
+        bool key_frame = (radio_dev->ppm_frames_to_key == 0) || (valid != radio_dev->ppm_sent_mask);
+
+        radio_dev->ppm_seq = (radio_dev->ppm_seq + 1) & RFM22B_CONTROL_SEQ_MASK;
+        if (key_frame) {
+            p[0] = RFM22B_CONTROL_FRAME_KEY | radio_dev->ppm_seq;
+            p[1] = valid;
+            for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
+                p[i + 2] = vals[i];
+            }
+            len = RFM22B_PPM_NUM_CHANNELS + 2;
+            radio_dev->ppm_frames_to_key = RFM22B_CONTROL_KEY_INTERVAL;
+        } else {
+            // Only the channels that moved carry a byte.  The differences
+            // are modulo 256, so any change fits in a single byte.
+            p[0] = RFM22B_CONTROL_FRAME_DELTA | radio_dev->ppm_seq;
+            p[1] = 0;
+            len  = 2;
+            for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
+                if ((valid & (1 << i)) && (vals[i] != radio_dev->ppm_sent[i])) {
+                    p[1]    |= 1 << i;
+                    p[len++] = vals[i] - radio_dev->ppm_sent[i];
+                }
             }
-            p[RFM22B_PPM_NUM_CHANNELS + 1] = crc;
+            --radio_dev->ppm_frames_to_key;
         }
+        radio_dev->ppm_sent_mask = valid;
+        memcpy(radio_dev->ppm_sent, vals, sizeof(vals));
+
+        // Every control frame closes with its own CRC, so a corrupted
+        // control block can never reach the servos even when the com data
+        // around it would still have decoded.
+        p[len] = PIOS_CRC_updateCRC(0, p, len);
+        ++len;
     }
 
-    // Append data from the com interface if applicable.
+    // The PPM block is written first, so control data always preempts
+    // bulk com data at the packet boundary: com bytes only ever use the
+    // capacity left over after the control stream is served.
+    uint8_t ppm_len = len;
+
+    // Append data from the com interface if applicable.  New bytes are staged
+    // behind whatever a previous deferred slot already pulled from the queue.
     if (!radio_dev->ppm_only_mode && radio_dev->tx_out_cb) {
         // Try to get some data to send
         bool need_yield = false;
-        len += (radio_dev->tx_out_cb)(radio_dev->tx_out_context, p + len, max_data_len - len, NULL, &need_yield);
+        if (radio_dev->tx_staged_len == 0) {
+            radio_dev->tx_stage_ticks = xTaskGetTickCount();
+        }
+        radio_dev->tx_staged_len += (radio_dev->tx_out_cb)(radio_dev->tx_out_context, p + len + radio_dev->tx_staged_len,
+                                                           max_data_len - len - radio_dev->tx_staged_len, NULL, &need_yield);
+        len += radio_dev->tx_staged_len;
+    }
+
+    // Hold a short payload back to let the queue fill the frame, unless PPM
+    // needs the slot, this is the coordinator sync channel, or the staged
+    // bytes have been waiting longer than the aggregation latency budget.
+    if (!radio_dev->ppm_send_mode && (len > 0) && (len < (max_data_len / 2)) &&
+        ((radio_dev->channel_index != 0) || !rfm22_isCoordinator(radio_dev)) &&
+        (pios_rfm22_time_difference_ms(radio_dev->tx_stage_ticks, xTaskGetTickCount()) <
+         (radio_dev->packet_time * 2 * RFM22B_AGGREGATION_SLOTS))) {
+        return RADIO_EVENT_RX_MODE;
     }
 
     // Always send a packet on the sync channel if this modem is a coordinator.
@@ -1806,6 +1880,11 @@ static enum pios_radio_event radio_txStart(struct pios_rfm22b_dev *radio_dev)
     // Increment the packet sequence number.
     radio_dev->stats.tx_seq++;
 
+    // Per-stream airtime accounting; preamble, sync and ECC overhead is
+    // charged to neither stream (it is the same for both).
+    radio_dev->stats.tx_ppm_byte_count += ppm_len;
+    radio_dev->stats.tx_com_byte_count += len - ppm_len;
+
     // Add the error correcting code.
     if (!radio_dev->ppm_only_mode) {
         if (len != 0) {
@@ -1839,6 +1918,8 @@ static enum pios_radio_event radio_txData(struct pios_rfm22b_dev *radio_dev)
         ret_event = RADIO_EVENT_RX_MODE;
         radio_dev->tx_packet_handle   = 0;
         radio_dev->tx_data_wr = radio_dev->tx_data_rd = 0;
+        // The staged com bytes went out with this packet.
+        radio_dev->tx_staged_len      = 0;
         // Start a new transaction
         radio_dev->packet_start_ticks = 0;
 
@@ -1898,45 +1979,79 @@ static enum pios_radio_event radio_receivePacket(struct pios_rfm22b_dev *radio_d
         }
     }
 
-    // Should we pull PPM data off of the head of the packet?
+    // Should we pull a control frame off of the head of the packet?
     if ((good_packet || corrected_packet) && radio_dev->ppm_recv_mode) {
-        uint8_t ppm_len = RFM22B_PPM_NUM_CHANNELS + (radio_dev->ppm_only_mode ? 2 : 1);
-
-        // Ensure the packet it long enough
-        if (data_len < ppm_len) {
-            good_packet = false;
-        }
-
-        // Verify the CRC if this is a PPM only packet.
-        if ((good_packet || corrected_packet) && radio_dev->ppm_only_mode) {
-            uint8_t crc = 0;
-            for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS + 1; ++i) {
-                crc = PIOS_CRC_updateByte(crc, p[i]);
-            }
-            if (p[RFM22B_PPM_NUM_CHANNELS + 1] != crc) {
-                good_packet = false;
-                corrected_packet = false;
+        uint8_t hdr = 0;
+        uint8_t frame_len = 0;
+
+        // Work out the frame length from the header and the channel bitmask,
+        // then verify the control CRC that closes the frame.
+        if (data_len >= 2) {
+            hdr = p[0];
+            if ((hdr & RFM22B_CONTROL_TYPE_MASK) == RFM22B_CONTROL_FRAME_KEY) {
+                frame_len = RFM22B_PPM_NUM_CHANNELS + 3;
+            } else if ((hdr & RFM22B_CONTROL_TYPE_MASK) == RFM22B_CONTROL_FRAME_DELTA) {
+                frame_len = 3;
+                for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
+                    if (p[1] & (1 << i)) {
+                        ++frame_len;
+                    }
+                }
             }
         }
+        if ((frame_len == 0) || (data_len < frame_len) ||
+            (p[frame_len - 1] != PIOS_CRC_updateCRC(0, p, frame_len - 1))) {
+            good_packet      = false;
+            corrected_packet = false;
+        }
 
         if (good_packet || corrected_packet) {
-            for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
-                // Is this a valid channel?
-                if (p[0] & (1 << i)) {
-                    uint32_t val = p[i + 1];
-                    radio_dev->ppm[i] = (uint16_t)(1000 + val * 900 / 256);
-                } else {
-                    radio_dev->ppm[i] = PIOS_RCVR_INVALID;
+            uint8_t seq = hdr & RFM22B_CONTROL_SEQ_MASK;
+            bool fresh  = false;
+            if ((hdr & RFM22B_CONTROL_TYPE_MASK) == RFM22B_CONTROL_FRAME_KEY) {
+                // A key frame carries the full channel state.
+                radio_dev->ppm_recv_mask = p[1];
+                for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
+                    radio_dev->ppm_recv[i] = p[i + 2];
+                }
+                radio_dev->ppm_base_valid = true;
+                fresh = true;
+            } else if (radio_dev->ppm_base_valid && (seq == ((radio_dev->ppm_recv_seq + 1) & RFM22B_CONTROL_SEQ_MASK))) {
+                // The differences reference the previous frame, so they can
+                // only be applied when no frame was lost in between.
+                uint8_t d = 2;
+                for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
+                    if (p[1] & (1 << i)) {
+                        radio_dev->ppm_recv[i] += p[d++];
+                    }
                 }
+                fresh = true;
+            } else {
+                // A frame was lost.  Hold the outputs on the last applied
+                // values until the next key frame rebases the state.
+                radio_dev->ppm_base_valid = false;
             }
+            radio_dev->ppm_recv_seq = seq;
 
-            p += RFM22B_PPM_NUM_CHANNELS + 1;
-            data_len -= RFM22B_PPM_NUM_CHANNELS + 1;
+            if (fresh) {
+                for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
+                    // Is this a valid channel?
+                    if (radio_dev->ppm_recv_mask & (1 << i)) {
+                        uint32_t val = radio_dev->ppm_recv[i];
+                        radio_dev->ppm[i] = (uint16_t)(1000 + val * 900 / 256);
+                    } else {
+                        radio_dev->ppm[i] = PIOS_RCVR_INVALID;
+                    }
+                }
 
-            // Call the PPM received callback if it's available.
-            if (radio_dev->ppm_callback) {
-                radio_dev->ppm_callback(radio_dev->ppm);
+                // Call the PPM received callback if it's available.
+                if (radio_dev->ppm_callback) {
+                    radio_dev->ppm_callback(radio_dev->ppm);
+                }
             }
+
+            p += frame_len;
+            data_len -= frame_len;
         }
     }
 
@@ -2238,6 +2353,9 @@ static uint8_t rfm22_calcChannel(struct pios_rfm22b_dev *rfm22b_dev, uint8_t ind
                 for (uint8_t i = 0; i < RFM22B_PPM_NUM_CHANNELS; ++i) {
                     rfm22b_dev->ppm[i] = PIOS_RCVR_INVALID;
                 }
+                // The delta reference is stale after an outage; wait for a
+                // key frame before applying control frames again.
+                rfm22b_dev->ppm_base_valid = false;
             }
 
             // Stay on the sync channel.
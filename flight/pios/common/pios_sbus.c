@@ -36,17 +36,29 @@
 
 /* Forward Declarations */
 static int32_t PIOS_SBus_Get(uint32_t rcvr_id, uint8_t channel);
+#if defined(PIOS_INCLUDE_FREERTOS)
+static xSemaphoreHandle PIOS_SBus_Get_Semaphore(uint32_t rcvr_id, uint8_t channel);
+#endif
 static uint16_t PIOS_SBus_RxInCallback(uint32_t context,
                                        uint8_t *buf,
                                        uint16_t buf_len,
                                        uint16_t *headroom,
                                        bool *need_yield);
 static void PIOS_SBus_Supervisor(uint32_t sbus_id);
+#ifdef PIOS_INCLUDE_RCVR_STATS
+static int32_t PIOS_SBus_GetFrameStats(uint32_t rcvr_id, struct pios_rcvr_frame_stats *stats);
+#endif
 
 
 /* Local Variables */
 const struct pios_rcvr_driver pios_sbus_rcvr_driver = {
-    .read = PIOS_SBus_Get,
+    .read            = PIOS_SBus_Get,
+#if defined(PIOS_INCLUDE_FREERTOS)
+    .get_semaphore   = PIOS_SBus_Get_Semaphore,
+#endif
+#ifdef PIOS_INCLUDE_RCVR_STATS
+    .get_frame_stats = PIOS_SBus_GetFrameStats,
+#endif
 };
 
 enum pios_sbus_dev_magic {
@@ -60,12 +72,21 @@ struct pios_sbus_state {
     uint8_t  failsafe_timer;
     uint8_t  frame_found;
     uint8_t  byte_count;
+#ifdef PIOS_INCLUDE_RCVR_STATS
+    struct pios_rcvr_frame_stats frame_stats;
+    uint32_t last_frame_raw;
+#endif
 };
 
 struct pios_sbus_dev {
     enum pios_sbus_dev_magic   magic;
     const struct pios_sbus_cfg *cfg;
     struct pios_sbus_state     state;
+#if defined(PIOS_INCLUDE_FREERTOS)
+    /* Signalled when a good frame updates channel_data[].  A single
+     * semaphore covers all channels since a frame carries all of them. */
+    xSemaphoreHandle new_frame_semaphore;
+#endif
 };
 
 /* Allocate S.Bus device descriptor */
@@ -80,6 +101,7 @@ static struct pios_sbus_dev *PIOS_SBus_Alloc(void)
     }
 
     sbus_dev->magic = PIOS_SBUS_DEV_MAGIC;
+    sbus_dev->new_frame_semaphore = 0;
     return sbus_dev;
 }
 #else
@@ -120,6 +142,9 @@ static void PIOS_SBus_ResetState(struct pios_sbus_state *state)
     state->receive_timer  = 0;
     state->failsafe_timer = 0;
     state->frame_found    = 0;
+#ifdef PIOS_INCLUDE_RCVR_STATS
+    memset(&state->frame_stats, 0, sizeof(state->frame_stats));
+#endif
     PIOS_SBus_ResetChannels(state);
 }
 
@@ -188,6 +213,48 @@ static int32_t PIOS_SBus_Get(uint32_t rcvr_id, uint8_t channel)
     return sbus_dev->state.channel_data[channel];
 }
 
+#if defined(PIOS_INCLUDE_FREERTOS)
+static xSemaphoreHandle PIOS_SBus_Get_Semaphore(uint32_t rcvr_id, uint8_t channel)
+{
+    struct pios_sbus_dev *sbus_dev = (struct pios_sbus_dev *)rcvr_id;
+
+    if (!PIOS_SBus_Validate(sbus_dev)) {
+        /* Invalid device specified */
+        return 0;
+    }
+
+    if (channel >= PIOS_SBUS_NUM_INPUTS) {
+        /* Channel out of range */
+        return 0;
+    }
+
+    if (sbus_dev->new_frame_semaphore == 0) {
+        vSemaphoreCreateBinary(sbus_dev->new_frame_semaphore);
+    }
+    return sbus_dev->new_frame_semaphore;
+}
+#endif /* if defined(PIOS_INCLUDE_FREERTOS) */
+
+#ifdef PIOS_INCLUDE_RCVR_STATS
+/**
+ * Get the frame timing statistics
+ * \output 0 stats filled in
+ * \output -1 invalid device
+ */
+static int32_t PIOS_SBus_GetFrameStats(uint32_t rcvr_id, struct pios_rcvr_frame_stats *stats)
+{
+    struct pios_sbus_dev *sbus_dev = (struct pios_sbus_dev *)rcvr_id;
+
+    if (!PIOS_SBus_Validate(sbus_dev)) {
+        return -1;
+    }
+
+    *stats = sbus_dev->state.frame_stats;
+    stats->frame_age_us = stats->frame_count ? PIOS_DELAY_DiffuS(sbus_dev->state.last_frame_raw) : 0;
+    return 0;
+}
+#endif /* PIOS_INCLUDE_RCVR_STATS */
+
 /**
  * Compute channel_data[] from received_data[].
  * For efficiency it unrolls first 8 channels without loops and does the
@@ -225,12 +292,13 @@ static void PIOS_SBus_UnrollChannels(struct pios_sbus_state *state)
     *d++ = (s[22] & SBUS_FLAG_DC2) ? SBUS_VALUE_MAX : SBUS_VALUE_MIN;
 }
 
-/* Update decoder state processing input byte from the S.Bus stream */
-static void PIOS_SBus_UpdateState(struct pios_sbus_state *state, uint8_t b)
+/* Update decoder state processing input byte from the S.Bus stream.
+ * Returns true when a good frame has refreshed channel_data[] */
+static bool PIOS_SBus_UpdateState(struct pios_sbus_state *state, uint8_t b)
 {
     /* should not process any data until new frame is found */
     if (!state->frame_found) {
-        return;
+        return false;
     }
 
     if (state->byte_count == 0) {
@@ -241,7 +309,7 @@ static void PIOS_SBus_UpdateState(struct pios_sbus_state *state, uint8_t b)
             /* do not store the SOF byte */
             state->byte_count++;
         }
-        return;
+        return false;
     }
 
     /* do not store last frame byte as well */
@@ -250,6 +318,7 @@ static void PIOS_SBus_UpdateState(struct pios_sbus_state *state, uint8_t b)
         state->received_data[state->byte_count - 1] = b;
         state->byte_count++;
     } else {
+        bool frame_completed = false;
         if (b == SBUS_EOF_BYTE || (b & SBUS_R7008SB_EOF_COUNTER_MASK) == 0) {
             /* full frame received */
             uint8_t flags = state->received_data[SBUS_FRAME_LENGTH - 3];
@@ -262,6 +331,11 @@ static void PIOS_SBus_UpdateState(struct pios_sbus_state *state, uint8_t b)
                 /* data looking good */
                 PIOS_SBus_UnrollChannels(state);
                 state->failsafe_timer = 0;
+#ifdef PIOS_INCLUDE_RCVR_STATS
+                /* timestamp the frame while still in the rx interrupt */
+                PIOS_RCVR_RecordFrame(&state->frame_stats, &state->last_frame_raw);
+#endif
+                frame_completed = true;
             }
         } else {
             /* discard whole frame */
@@ -269,7 +343,9 @@ static void PIOS_SBus_UpdateState(struct pios_sbus_state *state, uint8_t b)
 
         /* prepare for the next frame */
         state->frame_found = 0;
+        return frame_completed;
     }
+    return false;
 }
 
 /* Comm byte received callback */
@@ -287,9 +363,21 @@ static uint16_t PIOS_SBus_RxInCallback(uint32_t context,
 
     struct pios_sbus_state *state = &(sbus_dev->state);
 
+    bool yield = false;
+
     /* process byte(s) and clear receive timer */
     for (uint8_t i = 0; i < buf_len; i++) {
-        PIOS_SBus_UpdateState(state, buf[i]);
+        if (PIOS_SBus_UpdateState(state, buf[i])) {
+#if defined(PIOS_INCLUDE_FREERTOS)
+            /* Signal that a new frame of samples is ready */
+            if (sbus_dev->new_frame_semaphore != 0) {
+                signed portBASE_TYPE pxHigherPriorityTaskWoken = pdFALSE;
+                if (xSemaphoreGiveFromISR(sbus_dev->new_frame_semaphore, &pxHigherPriorityTaskWoken) == pdTRUE) {
+                    yield |= (pxHigherPriorityTaskWoken == pdTRUE);
+                }
+            }
+#endif /* PIOS_INCLUDE_FREERTOS */
+        }
         state->receive_timer = 0;
     }
 
@@ -298,8 +386,8 @@ static uint16_t PIOS_SBus_RxInCallback(uint32_t context,
         *headroom = SBUS_FRAME_LENGTH;
     }
 
-    /* We never need a yield */
-    *need_yield = false;
+    /* Yield if waking the receiver task unblocked something more urgent */
+    *need_yield = yield;
 
     /* Always indicate that all bytes were consumed */
     return buf_len;
@@ -91,6 +91,52 @@ static int32_t sdcard_mounted;
 
 static uint32_t PIOS_SDCARD_SPI;
 
+#if defined(PIOS_INCLUDE_FREERTOS)
+/*
+ * Double buffered asynchronous sector writes
+ *
+ * A caller of PIOS_SDCARD_SectorWriteAsync() only copies its sector into
+ * one of two RAM slots; a low priority writer task performs the actual
+ * (DMA based) SPI transfer and the write-completion busy wait.  One slot
+ * can be filled while the other drains, so sustained logging does not
+ * stall the producer on SD write latency spikes.  The producer blocks
+ * only when both slots are in flight.
+ */
+#define SDCARD_ASYNC_NUM_SLOTS      2
+#define SDCARD_ASYNC_STACK_BYTES    512
+#define SDCARD_ASYNC_TASK_PRIORITY  (tskIDLE_PRIORITY + 1)
+/* longer than one video field (20ms PAL), so a wait only ever skips a
+ * window when video generation has stalled */
+#define SDCARD_ASYNC_BLANKING_WAIT_MS 40
+
+struct sdcard_async_slot {
+    uint32_t sector;
+    SDCARDWriteCallback callback;
+    uint8_t  data[SECTOR_SIZE];
+};
+
+static struct sdcard_async_slot sdcard_async_slots[SDCARD_ASYNC_NUM_SLOTS];
+static uint8_t sdcard_async_head; /* next slot to fill */
+static uint8_t sdcard_async_tail; /* next slot to drain */
+static volatile uint8_t sdcard_async_pending;
+static xSemaphoreHandle sdcard_async_free_sema; /* counts free slots */
+static xSemaphoreHandle sdcard_async_used_sema; /* counts filled slots */
+static xTaskHandle sdcard_async_task_handle;
+
+static void PIOS_SDCARD_AsyncWriterTask(void *parameters);
+
+/* Wait until all queued asynchronous writes have reached the card so
+ * reads always observe the latest data */
+static void PIOS_SDCARD_AsyncDrain(void)
+{
+    while (sdcard_async_pending) {
+        vTaskDelay(1);
+    }
+}
+#else
+#define PIOS_SDCARD_AsyncDrain()
+#endif /* PIOS_INCLUDE_FREERTOS */
+
 /**
  * Initialises SPI pins and peripheral to access MMC/SD Card
  * \param[in] mode currently only mode 0 supported
@@ -422,6 +468,9 @@ int32_t PIOS_SDCARD_SectorRead(uint32_t sector, uint8_t *buffer)
     int32_t status;
     int i;
 
+    /* Make sure no newer version of this sector is still queued for writing */
+    PIOS_SDCARD_AsyncDrain();
+
     if (!(CardType & CT_BLOCK)) {
         sector *= 512;
     }
@@ -553,6 +602,88 @@ error:
     return status;
 }
 
+/**
+ * Queues 512 bytes for writing into the selected sector.
+ * The data is copied into an internal slot, so the caller's buffer may
+ * be reused immediately; the transfer itself is performed by a low
+ * priority writer task.  Blocks only when both internal slots are
+ * already in flight.  Falls back to a synchronous write when the writer
+ * task cannot be brought up (no FreeRTOS, allocation failure).
+ * \param[in] sector 32bit sector
+ * \param[in] *buffer pointer to 512 byte buffer
+ * \param[in] callback invoked from the writer task with the final status, may be NULL
+ * \return 0 if the sector was queued (or written) successfully
+ * \return < 0 on synchronous fallback errors (see PIOS_SDCARD_SectorWrite)
+ */
+int32_t PIOS_SDCARD_SectorWriteAsync(uint32_t sector, uint8_t *buffer, SDCARDWriteCallback callback)
+{
+#if defined(PIOS_INCLUDE_FREERTOS)
+    if (!sdcard_async_task_handle) {
+        /* First use: bring up the writer task */
+        sdcard_async_free_sema = xSemaphoreCreateCounting(SDCARD_ASYNC_NUM_SLOTS, SDCARD_ASYNC_NUM_SLOTS);
+        sdcard_async_used_sema = xSemaphoreCreateCounting(SDCARD_ASYNC_NUM_SLOTS, 0);
+        if (sdcard_async_free_sema && sdcard_async_used_sema) {
+            xTaskCreate(PIOS_SDCARD_AsyncWriterTask, "SDWrite", SDCARD_ASYNC_STACK_BYTES / 4, NULL, SDCARD_ASYNC_TASK_PRIORITY, &sdcard_async_task_handle);
+        }
+    }
+
+    if (sdcard_async_task_handle) {
+        xSemaphoreTake(sdcard_async_free_sema, portMAX_DELAY);
+
+        struct sdcard_async_slot *slot = &sdcard_async_slots[sdcard_async_head];
+        slot->sector   = sector;
+        slot->callback = callback;
+        memcpy(slot->data, buffer, SECTOR_SIZE);
+        sdcard_async_head = (sdcard_async_head + 1) % SDCARD_ASYNC_NUM_SLOTS;
+
+        taskENTER_CRITICAL();
+        sdcard_async_pending++;
+        taskEXIT_CRITICAL();
+
+        xSemaphoreGive(sdcard_async_used_sema);
+        return 0;
+    }
+#endif /* PIOS_INCLUDE_FREERTOS */
+
+    int32_t status = PIOS_SDCARD_SectorWrite(sector, buffer);
+    if (callback) {
+        callback(sector, status);
+    }
+    return status;
+}
+
+#if defined(PIOS_INCLUDE_FREERTOS)
+static void PIOS_SDCARD_AsyncWriterTask(__attribute__((unused)) void *parameters)
+{
+    while (1) {
+        if (xSemaphoreTake(sdcard_async_used_sema, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        struct sdcard_async_slot *slot = &sdcard_async_slots[sdcard_async_tail];
+
+#if defined(PIOS_INCLUDE_VIDEO)
+        /* Defer the SPI/DMA transfer into the vertical blanking interval
+         * so it cannot disturb active video scanout; proceed anyway on
+         * timeout so logging survives a stopped video generator */
+        PIOS_Video_WaitForBlanking(SDCARD_ASYNC_BLANKING_WAIT_MS);
+#endif
+
+        int32_t status = PIOS_SDCARD_SectorWrite(slot->sector, slot->data);
+        if (slot->callback) {
+            slot->callback(slot->sector, status);
+        }
+        sdcard_async_tail = (sdcard_async_tail + 1) % SDCARD_ASYNC_NUM_SLOTS;
+
+        taskENTER_CRITICAL();
+        sdcard_async_pending--;
+        taskEXIT_CRITICAL();
+
+        xSemaphoreGive(sdcard_async_free_sema);
+    }
+}
+#endif /* PIOS_INCLUDE_FREERTOS */
+
 /**
  * Reads the CID informations from SD Card
  * \param[in] *cid pointer to buffer which holds the CID informations
@@ -32,10 +32,14 @@
 // Private variables
 static xSemaphoreHandle mLock;
 static xTaskHandle *mTaskHandles;
+static struct pios_task_stats *mTaskStats;
 static uint32_t mLastMonitorTime;
 static uint32_t mLastIdleMonitorTime;
 static uint16_t mMaxTasks;
 
+// Private functions
+static void resetTaskStats(struct pios_task_stats *stats);
+
 /**
  * Initialize the Task Monitor
  */
@@ -52,6 +56,14 @@ int32_t PIOS_TASK_MONITOR_Initialize(uint16_t max_tasks)
     }
     memset(mTaskHandles, 0, max_tasks * sizeof(xTaskHandle));
 
+    mTaskStats = (struct pios_task_stats *)pios_malloc(max_tasks * sizeof(struct pios_task_stats));
+    if (!mTaskStats) {
+        return -1;
+    }
+    for (uint16_t n = 0; n < max_tasks; ++n) {
+        resetTaskStats(&mTaskStats[n]);
+    }
+
     mMaxTasks = max_tasks;
 #if (configGENERATE_RUN_TIME_STATS == 1)
     mLastMonitorTime     = portGET_RUN_TIME_COUNTER_VALUE();
@@ -142,6 +154,26 @@ void PIOS_TASK_MONITOR_ForEachTask(TaskMonitorTaskInfoCallback callback, void *c
             info.stack_remaining = 0;
             info.running_time_percentage = 0;
         }
+
+        /* Accumulate the sample into the per-task statistics window */
+        struct pios_task_stats *stats = &mTaskStats[n];
+        stats->is_running = info.is_running;
+        if (info.is_running) {
+            uint8_t bin = (info.running_time_percentage * PIOS_TASK_MONITOR_HISTOGRAM_BINS) / 100;
+            if (bin >= PIOS_TASK_MONITOR_HISTOGRAM_BINS) {
+                bin = PIOS_TASK_MONITOR_HISTOGRAM_BINS - 1;
+            }
+            if (stats->load_histogram[bin] < UINT16_MAX) {
+                stats->load_histogram[bin]++;
+            }
+            if (info.running_time_percentage > stats->max_load) {
+                stats->max_load = info.running_time_percentage;
+            }
+            if (info.stack_remaining < stats->stack_low_water) {
+                stats->stack_low_water = info.stack_remaining;
+            }
+        }
+
         /* Pass the information for this task back to the caller */
         callback(n, &info, context);
     }
@@ -149,6 +181,35 @@ void PIOS_TASK_MONITOR_ForEachTask(TaskMonitorTaskInfoCallback callback, void *c
     xSemaphoreGiveRecursive(mLock);
 }
 
+/**
+ * Report the statistics accumulated since the previous call via a
+ * task-by-task callback and start a new sampling window
+ */
+void PIOS_TASK_MONITOR_ForEachTaskStats(TaskMonitorTaskStatsCallback callback, void *context)
+{
+    if (!mTaskStats) {
+        return;
+    }
+
+    xSemaphoreTakeRecursive(mLock, portMAX_DELAY);
+
+    for (uint16_t n = 0; n < mMaxTasks; ++n) {
+        callback(n, &mTaskStats[n], context);
+        resetTaskStats(&mTaskStats[n]);
+    }
+
+    xSemaphoreGiveRecursive(mLock);
+}
+
+/**
+ * Reset the statistics of a task to start a new sampling window
+ */
+static void resetTaskStats(struct pios_task_stats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->stack_low_water = UINT16_MAX;
+}
+
 uint8_t PIOS_TASK_MONITOR_GetIdlePercentage()
 {
 #if defined(ARCH_POSIX) || defined(ARCH_WIN32)
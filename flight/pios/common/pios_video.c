@@ -77,6 +77,17 @@ volatile uint16_t line = 0;
 volatile uint16_t Vsync_update = 0;
 volatile uint16_t Hsync_update = 0;
 static int16_t m_osdLines = 0;
+// Set by the OSD task when it has finished rendering the draw buffer.
+// The VSync handler only swaps buffers once this is set, so a frame that
+// takes longer than a field period keeps displaying the previous image
+// instead of being scanned out half drawn.
+static volatile uint8_t frame_ready  = 0;
+// Set while lines are being clocked out, cleared at the start of the
+// vertical blanking interval.  The blanking semaphore is given on that
+// falling edge so other drivers can defer bus traffic that would
+// otherwise disturb the pixel DMA (sparkle artifacts).
+static volatile uint8_t video_active = 0;
+static xSemaphoreHandle blankingSemaphore;
 
 /**
  * swap_buffers: Swaps the two buffers. Contents in the display
@@ -98,8 +109,9 @@ bool PIOS_Hsync_ISR()
 {
     // On tenth line prepare data which will start clocking out on GRAPHICS_LINE+1
     if (Hsync_update == GRAPHICS_LINE) {
+        video_active = 1;
         prepare_line(0);
-        gActiveLine = 1;
+        gActiveLine  = 1;
     }
     Hsync_update++;
     return true;
@@ -119,16 +131,28 @@ bool PIOS_Vsync_ISR()
     flush_spi();
     TIM_Cmd(dev_cfg->pixel_timer.timer, DISABLE);
 
+    // Start of the vertical blanking interval (unless the last-line DMA
+    // interrupt already marked it): wake deferred bus traffic
+    if (video_active && blankingSemaphore) {
+        video_active = 0;
+        xSemaphoreGiveFromISR(blankingSemaphore, &xHigherPriorityTaskWoken);
+    }
+
     gActiveLine  = 0;
     Hsync_update = 0;
     Vsync_update++;
     if (Vsync_update >= 2) {
-        // load second image buffer
-        swap_buffers();
         Vsync_update = 0;
 
-        // trigger redraw every second field
-        xHigherPriorityTaskWoken = xSemaphoreGiveFromISR(osdSemaphore, &xHigherPriorityTaskWoken);
+        // load second image buffer, but only if drawing is complete so a
+        // partially rendered frame is never displayed
+        if (frame_ready) {
+            swap_buffers();
+            frame_ready = 0;
+
+            // trigger redraw every second field
+            xHigherPriorityTaskWoken = xSemaphoreGiveFromISR(osdSemaphore, &xHigherPriorityTaskWoken);
+        }
     }
 
     portEND_SWITCHING_ISR(xHigherPriorityTaskWoken); // portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
@@ -141,6 +165,51 @@ uint16_t PIOS_Video_GetOSDLines(void)
     return m_osdLines;
 }
 
+/**
+ * Mark the draw buffer as fully rendered so the next VSync may flip it
+ * onto the output.  To be called by the OSD task after each frame.
+ */
+void PIOS_Video_FrameReady(void)
+{
+    frame_ready = 1;
+}
+
+/**
+ * \return true while no lines are being clocked out, i.e. during the
+ * vertical blanking interval (or while video generation is stopped)
+ */
+bool PIOS_Video_InBlanking(void)
+{
+    return !video_active;
+}
+
+/**
+ * Block the calling task until the vertical blanking interval.
+ *
+ * Returns immediately when no field is being clocked out; otherwise waits
+ * for the blanking edge published by the video ISRs.  Drivers use this to
+ * defer non-critical SPI/DMA traffic out of active scanout, where the bus
+ * contention shows up as sparkle artifacts on the OSD output.
+ * \param[in] timeout_ms how long to wait for the blanking edge
+ * \return 0 when in the blanking interval, -1 on timeout or if video is
+ * not initialized
+ */
+int32_t PIOS_Video_WaitForBlanking(uint32_t timeout_ms)
+{
+    if (!blankingSemaphore) {
+        return -1;
+    }
+    if (!video_active) {
+        return 0;
+    }
+    // Eat a leftover give from an earlier field so we wake on the next edge
+    xSemaphoreTake(blankingSemaphore, 0);
+    if (xSemaphoreTake(blankingSemaphore, timeout_ms / portTICK_RATE_MS) != pdTRUE) {
+        return -1;
+    }
+    return 0;
+}
+
 /**
  * Stops the pixel clock and ensures it ignores the rising edge.  To be used after a
  * vsync until the first line is to be displayed
@@ -279,6 +348,10 @@ void PIOS_Video_Init(const struct pios_video_cfg *cfg)
 {
     dev_cfg = cfg; // store config before enabling interrupt
 
+    // Signalled at the start of each vertical blanking interval
+    vSemaphoreCreateBinary(blankingSemaphore);
+    xSemaphoreTake(blankingSemaphore, 0);
+
     configure_hsync_timers();
 
     /* needed for HW hack */
@@ -463,6 +536,15 @@ void PIOS_VIDEO_DMA_Handler(void)
             // STOP DMA, master first
             DMA_Cmd(dev_cfg->mask.dma.tx.channel, DISABLE);
             DMA_Cmd(dev_cfg->level.dma.tx.channel, DISABLE);
+
+            // The field is fully clocked out: this is the earliest point
+            // of the blanking interval, publish it
+            if (video_active && blankingSemaphore) {
+                portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+                video_active = 0;
+                xSemaphoreGiveFromISR(blankingSemaphore, &xHigherPriorityTaskWoken);
+                portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+            }
         }
         gActiveLine++;
     } else if (DMA_GetFlagStatus(dev_cfg->level.dma.tx.channel, DMA_FLAG_HTIF5)) {
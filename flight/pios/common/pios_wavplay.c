@@ -130,6 +130,37 @@ FILEINFO file;
 static uint8_t buffer1[BUFFERSIZE], buffer2[BUFFERSIZE] = { 0 }; // Two cycling buffers which contain the WAV data.
 uint32_t wavecounter;
 
+#if defined(PIOS_INCLUDE_FREERTOS)
+/*
+ * Buffer refills used to run inside the DMA transfer complete interrupt,
+ * reading from the SD card with interrupts masked; a busy System task or
+ * slow card then underran the DAC and produced audible glitches.  The
+ * interrupt now only records which half of the double buffer was released
+ * and wakes a low priority refill task that does the actual read.
+ *
+ * Clips small enough for the cache are decoded into RAM on their first
+ * play, so the frequent short alerts never touch the card at all.
+ */
+#define WAVPLAY_STACK_BYTES     512
+#define WAVPLAY_TASK_PRIORITY   (tskIDLE_PRIORITY + 1)
+#define WAVPLAY_CLIP_CACHE_SIZE 16384 // per clip cap, cache skipped above this
+
+struct wav_clip_cache {
+    uint8_t  *data;        // decoded PCM stream, NULL when not cached
+    uint32_t length;       // bytes in data
+    uint16_t timer_period; // TIM6ARRValue matching the clip sample rate
+    uint32_t data_size;    // WAVE_Format.DataSize of the clip
+};
+static struct wav_clip_cache clip_cache[5];
+static int8_t cache_playing = -1;   // table index played from cache, -1 = streaming
+static uint32_t cache_pos;          // read position inside the cached clip
+
+static xSemaphoreHandle refill_semaphore;
+static xTaskHandle refill_task_handle;
+static volatile uint8_t refill_buffer_idx; // buffer released by the DMA, 1 or 2
+static volatile uint8_t refill_end;        // clip finished, advance in task context
+#endif /* PIOS_INCLUDE_FREERTOS */
+
 typedef struct {
     unsigned int format;
     unsigned int sample_rate;
@@ -339,6 +370,40 @@ static ErrorCode WavePlayer_WaveParsing(uint8_t *DirName, uint8_t *FileName, uin
 int wavfile = 0;
 const uint8_t table[5][20] = { "openpilo.wav", "uav.wav", "beepsoun.wav", "warning.wav", "lowaltit.wav" };
 
+#if defined(PIOS_INCLUDE_FREERTOS)
+/**
+ * @brief  Slurp the clip just parsed by WavePlayer_WaveParsing into RAM.
+ * The stream head is already in buffer1/buffer2, the rest is read from
+ * the open file.  On allocation failure the clip simply keeps streaming.
+ */
+static void wav_cache_fill(struct wav_clip_cache *cache)
+{
+    uint32_t total = ((WAVE_Format.DataSize + BUFFERSIZE - 1) / BUFFERSIZE) * BUFFERSIZE;
+
+    if (total < 2 * BUFFERSIZE) {
+        total = 2 * BUFFERSIZE;
+    }
+    uint8_t *data = pios_malloc(total);
+    if (!data) {
+        return;
+    }
+    memcpy(data, buffer1, BUFFERSIZE);
+    memcpy(data + BUFFERSIZE, buffer2, BUFFERSIZE);
+    uint32_t pos = 2 * BUFFERSIZE;
+    uint32_t bytesRead = 0;
+    while (pos < total) {
+        if (PIOS_FREAD(&file, data + pos, BUFFERSIZE, &bytesRead)) {
+            break;
+        }
+        pos += BUFFERSIZE;
+    }
+    cache->length       = total;
+    cache->timer_period = TIM6ARRValue;
+    cache->data_size    = WAVE_Format.DataSize;
+    cache->data = data;
+}
+#endif /* PIOS_INCLUDE_FREERTOS */
+
 uint8_t WavePlayer_Start(void)
 {
     // Check for file system availability
@@ -349,6 +414,26 @@ uint8_t WavePlayer_Start(void)
     /* Read the Speech wave file status */
 
     if (wavfile < 5) {
+#if defined(PIOS_INCLUDE_FREERTOS)
+        struct wav_clip_cache *cache = &clip_cache[wavfile];
+        if (cache->data) {
+            /* Replay straight from the decoded clip cache, no card access */
+            cache_playing = wavfile++;
+            if (wavfile > 4) {
+                wavfile = 5;
+            }
+            WaveDataLength = cache->data_size;
+            memcpy(buffer1, cache->data, BUFFERSIZE);
+            memcpy(buffer2, cache->data + BUFFERSIZE, BUFFERSIZE);
+            cache_pos = 2 * BUFFERSIZE;
+
+            TIM_Cmd(dev_cfg->timer, DISABLE);
+            TIM_SetAutoreload(dev_cfg->timer, cache->timer_period);
+            TIM_Cmd(dev_cfg->timer, ENABLE);
+            return 0;
+        }
+        cache_playing = -1;
+#endif /* PIOS_INCLUDE_FREERTOS */
         WaveFileStatus = WavePlayer_WaveParsing(" ", table[wavfile++], &wavelen);
         if (wavfile > 4) {
             wavfile = 5;
@@ -360,6 +445,17 @@ uint8_t WavePlayer_Start(void)
             /* Set WaveDataLenght to the Speech wave length */
             WaveDataLength = WAVE_Format.DataSize;
 
+#if defined(PIOS_INCLUDE_FREERTOS)
+            if (WAVE_Format.DataSize <= WAVPLAY_CLIP_CACHE_SIZE) {
+                /* Short alert clip, keep the decoded stream for replays */
+                wav_cache_fill(cache);
+                if (cache->data) {
+                    PIOS_FCLOSE(file);
+                    cache_playing = (int8_t)(wavfile - 1);
+                    cache_pos     = 2 * BUFFERSIZE;
+                }
+            }
+#endif /* PIOS_INCLUDE_FREERTOS */
             TIM_Cmd(dev_cfg->timer, DISABLE);
             TIM_SetAutoreload(dev_cfg->timer, TIM6ARRValue);
             /* Start TIM6 */
@@ -483,6 +579,12 @@ void PIOS_WavPlay_Init(const struct pios_dac_cfg *cfg)
     DAC_Cmd(cfg->channel, ENABLE);
     DAC_DMACmd(cfg->channel, ENABLE);
 #endif /* if 1 */
+
+#if defined(PIOS_INCLUDE_FREERTOS)
+    vSemaphoreCreateBinary(refill_semaphore);
+    xSemaphoreTake(refill_semaphore, 0);
+    xTaskCreate(wavplay_refill_task, "WavRefill", WAVPLAY_STACK_BYTES / 4, NULL, WAVPLAY_TASK_PRIORITY, &refill_task_handle);
+#endif
     // WavePlayer_Start();
 }
 
@@ -527,11 +629,23 @@ void DMA1_Stream5_IRQHandler(void) __attribute__((alias("DAC_DMA_Handler")));
  */
 void DAC_DMA_Handler(void)
 {
+#if defined(PIOS_INCLUDE_FREERTOS)
+    portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+#else
     uint8_t status     = 0;
     uint32_t bytesRead = 0;
+#endif
 
     if (DMA_GetFlagStatus(dev_cfg->dma.tx.channel, DMA_FLAG_TCIF5)) { // whole double buffer filled
         if (WaveDataLength) {
+#if defined(PIOS_INCLUDE_FREERTOS)
+            /* Only note which buffer the DMA released; the refill task
+             * does the card or cache read outside interrupt context. */
+            refill_buffer_idx = (DMA_GetCurrentMemoryTarget(dev_cfg->dma.tx.channel) == 0) ? 2 : 1;
+            if (refill_semaphore) {
+                xSemaphoreGiveFromISR(refill_semaphore, &xHigherPriorityTaskWoken);
+            }
+#else /* PIOS_INCLUDE_FREERTOS */
             if (DMA_GetCurrentMemoryTarget(dev_cfg->dma.tx.channel) == 0) {
                 // DMA_MemoryTargetConfig(DMA1_Stream5,(uint32_t)&buffer2,DMA_Memory_1);
                 PIOS_FREAD(&file, buffer2, BUFFERSIZE, &bytesRead);
@@ -551,6 +665,7 @@ void DAC_DMA_Handler(void)
                 // PIOS_FCLOSE(file);
                 // LoadWav();
             }
+#endif /* PIOS_INCLUDE_FREERTOS */
             WaveDataLength -= 512;
         }
         if (WaveDataLength < 512) {
@@ -558,15 +673,64 @@ void DAC_DMA_Handler(void)
         }
         /* If we reach the WaveDataLength of the wave to play */
         if (WaveDataLength == 0) {
+#if defined(PIOS_INCLUDE_FREERTOS)
+            /* Stop here, advance to the next clip in task context */
+            WavePlayer_Stop();
+            refill_end = 1;
+            if (refill_semaphore) {
+                xSemaphoreGiveFromISR(refill_semaphore, &xHigherPriorityTaskWoken);
+            }
+#else
             /* Stop wave playing */
             WavePlayer_Stop();
             PIOS_FCLOSE(file);
             WavePlayer_Start();
+#endif
         }
         DMA_ClearFlag(dev_cfg->dma.tx.channel, DMA_FLAG_TCIF5);
     } else if (DMA_GetFlagStatus(dev_cfg->dma.tx.channel, DMA_FLAG_HTIF5)) {
         DMA_ClearFlag(dev_cfg->dma.tx.channel, DMA_FLAG_HTIF5);
     } else {}
+#if defined(PIOS_INCLUDE_FREERTOS)
+    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+#endif
+}
+
+#if defined(PIOS_INCLUDE_FREERTOS)
+/**
+ * @brief Background buffer refill.  Woken by the DMA transfer complete
+ * interrupt, copies the next chunk from the clip cache or reads it from
+ * the card, and advances to the next clip when one finishes.
+ */
+static void wavplay_refill_task(__attribute__((unused)) void *parameters)
+{
+    uint32_t bytesRead = 0;
+
+    while (1) {
+        xSemaphoreTake(refill_semaphore, portMAX_DELAY);
+
+        if (refill_end) {
+            refill_end = 0;
+            if (cache_playing < 0) {
+                PIOS_FCLOSE(file);
+            }
+            cache_playing = -1;
+            WavePlayer_Start();
+            continue;
+        }
+
+        uint8_t *buf = (refill_buffer_idx == 1) ? buffer1 : buffer2;
+        if (cache_playing >= 0) {
+            struct wav_clip_cache *cache = &clip_cache[(int)cache_playing];
+            if (cache_pos + BUFFERSIZE <= cache->length) {
+                memcpy(buf, cache->data + cache_pos, BUFFERSIZE);
+                cache_pos += BUFFERSIZE;
+            }
+        } else {
+            PIOS_FREAD(&file, buf, BUFFERSIZE, &bytesRead);
+        }
+    }
 }
+#endif /* PIOS_INCLUDE_FREERTOS */
 
 #endif /* PIOS_INCLUDE_WAVE */
@@ -40,9 +40,14 @@ typedef void (*ADCCallback)(float *data);
 void PIOS_ADC_Config(uint32_t oversampling);
 int32_t PIOS_ADC_PinGet(uint32_t pin);
 float PIOS_ADC_PinGetVolt(uint32_t pin);
+void PIOS_ADC_PinSetOversampleBits(uint32_t pin, uint8_t bits);
+int32_t PIOS_ADC_PinGetOversampled(uint32_t pin);
 int16_t *PIOS_ADC_GetRawBuffer(void);
 uint8_t PIOS_ADC_GetOverSampling(void);
 void PIOS_ADC_SetCallback(ADCCallback new_function);
+#if defined(PIOS_ADC_PROVIDES_COULOMB_COUNTER)
+int32_t PIOS_ADC_PinGetAccumulator(uint32_t pin, uint64_t *raw_sum, uint32_t *sample_count);
+#endif
 #if defined(PIOS_INCLUDE_FREERTOS)
 void PIOS_ADC_SetQueue(xQueueHandle data_queue);
 #endif
@@ -197,6 +197,16 @@ struct pios_callback_info {
     bool     is_running;
     /** Count of executions of the callback since system start */
     uint32_t running_time_count;
+    /** Shortest observed execution time in microseconds (0 if never run). */
+    uint32_t runtime_min;
+    /** Longest observed execution time in microseconds. */
+    uint32_t runtime_max;
+    /** Exponentially weighted average execution time in microseconds. */
+    uint32_t runtime_avg;
+    /** Exponentially weighted average time in microseconds between dispatch and execution. */
+    uint32_t latency_avg;
+    /** Count of scheduled executions that started at least a tick late. */
+    uint32_t missed_deadlines;
 };
 
 /**
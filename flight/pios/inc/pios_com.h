@@ -36,6 +36,10 @@
 
 typedef uint16_t (*pios_com_callback)(uint32_t context, uint8_t *buf, uint16_t buf_len, uint16_t *headroom, bool *task_woken);
 
+/* Invoked from the rx delivery context (usually ISR) whenever a span of
+ * data has been added to the receive fifo of the port */
+typedef void (*pios_com_rx_notify_cb)(uint32_t context, bool *task_woken);
+
 struct pios_com_driver {
     void (*init)(uint32_t id);
     void (*set_baud)(uint32_t id, uint32_t baud);
@@ -46,6 +50,17 @@ struct pios_com_driver {
     bool (*available)(uint32_t id);
 };
 
+#ifdef PIOS_INCLUDE_COM_STATS
+struct pios_com_stats {
+    uint32_t rx_bytes;      // bytes accepted into the rx fifo
+    uint32_t tx_bytes;      // bytes handed to the underlying device
+    uint32_t rx_dropped;    // bytes offered by the driver that did not fit in the rx fifo
+    uint32_t tx_dropped;    // bytes discarded because the link was down or the rate limit hit
+    uint16_t rx_high_water; // deepest rx fifo occupancy seen since boot
+    uint16_t tx_high_water; // deepest tx fifo occupancy seen since boot
+};
+#endif /* PIOS_INCLUDE_COM_STATS */
+
 /* Public Functions */
 extern int32_t PIOS_COM_ChangeBaud(uint32_t com_id, uint32_t baud);
 extern int32_t PIOS_COM_SendCharNonBlocking(uint32_t com_id, char c);
@@ -57,7 +72,14 @@ extern int32_t PIOS_COM_SendString(uint32_t com_id, const char *str);
 extern int32_t PIOS_COM_SendFormattedStringNonBlocking(uint32_t com_id, const char *format, ...);
 extern int32_t PIOS_COM_SendFormattedString(uint32_t com_id, const char *format, ...);
 extern uint16_t PIOS_COM_ReceiveBuffer(uint32_t com_id, uint8_t *buf, uint16_t buf_len, uint32_t timeout_ms);
+extern uint16_t PIOS_COM_ReceiveBufferPeek(uint32_t com_id, uint8_t **buf, uint32_t timeout_ms);
+extern void PIOS_COM_ReceiveBufferConsume(uint32_t com_id, uint16_t bytes);
+extern int32_t PIOS_COM_RegisterRxNotify(uint32_t com_id, pios_com_rx_notify_cb notify_cb, uint32_t context);
 extern bool PIOS_COM_Available(uint32_t com_id);
+#ifdef PIOS_INCLUDE_COM_STATS
+extern int32_t PIOS_COM_GetStats(uint32_t com_id, struct pios_com_stats *stats);
+extern int32_t PIOS_COM_SetTxRateLimit(uint32_t com_id, uint32_t bytes_per_sec);
+#endif /* PIOS_INCLUDE_COM_STATS */
 
 #endif /* PIOS_COM_H */
 
@@ -30,7 +30,20 @@
 #ifndef PIOS_CRC_H
 #define PIOS_CRC_H
 
-uint8_t PIOS_CRC_updateByte(uint8_t crc, const uint8_t data);
+/*
+ * The CRC-8 table is exported so that the per-byte update used in the
+ * UAVTalk RX/TX state machines inlines to a single table lookup instead
+ * of paying a function call per received byte.  (The STM32 hardware CRC
+ * unit only implements the fixed CRC-32 MPEG-2 polynomial over words,
+ * so it cannot serve the UAVTalk CRC-8.)
+ */
+extern const uint8_t PIOS_CRC_Table[256];
+
+static inline uint8_t PIOS_CRC_updateByte(uint8_t crc, const uint8_t data)
+{
+    return PIOS_CRC_Table[crc ^ data];
+}
+
 uint8_t PIOS_CRC_updateCRC(uint8_t crc, const uint8_t *data, int32_t length);
 
 uint16_t PIOS_CRC16_updateByte(uint16_t crc, const uint8_t data);
@@ -61,6 +61,16 @@ void PIOS_DEBUGLOG_UAVObject(uint32_t objid, uint16_t instid, size_t size, uint8
  */
 void PIOS_DEBUGLOG_Printf(char *format, ...);
 
+/**
+ * @brief Write a binary debug log entry, deferring the formatting
+ * @param[in] format - as in printf, but only its flash address is stored
+ * @param[in] variable arguments, each recorded as a raw 32 bit word
+ * @param...
+ * @note integer, character and pointer conversions only; the text is
+ *       rendered on the ground using the firmware map file
+ */
+void PIOS_DEBUGLOG_BinaryPrintf(const char *format, ...);
+
 /**
  * @brief Load one object instance from the filesystem
  * @param[out] buffer where to store the uavobject
@@ -84,6 +94,19 @@ int32_t PIOS_DEBUGLOG_Read(void *buffer, uint16_t flight, uint16_t inst);
  */
 void PIOS_DEBUGLOG_Info(uint16_t *flight, uint16_t *entry, uint16_t *free, uint16_t *used);
 
+/**
+ * @brief Push any partially filled block into the write path and wait
+ * until all buffered entries have reached the flash filesystem
+ */
+void PIOS_DEBUGLOG_Flush(void);
+
+/**
+ * @brief Retrieve occupancy statistics of the RAM ring buffer
+ * @param[out] deepest ring occupancy seen since boot
+ * @param[out] number of blocks shed because the ring was full
+ */
+void PIOS_DEBUGLOG_BufferStats(uint8_t *high_water, uint32_t *drops);
+
 /**
  * @brief Format entire flash memory!!!
  */
@@ -40,6 +40,12 @@ extern uint32_t PIOS_DELAY_GetuSSince(uint32_t t);
 extern uint32_t PIOS_DELAY_GetRaw();
 extern uint32_t PIOS_DELAY_DiffuS(uint32_t raw);
 
+/* 64 bit monotonic microsecond timebase, see pios_deltatime.c */
+extern uint64_t PIOS_DELAY_GetuS64(void);
+extern uint64_t PIOS_DELAY_DiffuS64(uint64_t t);
+extern uint64_t PIOS_DELAY_GetDeadline(uint32_t delay_us);
+extern bool PIOS_DELAY_DeadlineExpired(uint64_t deadline);
+
 #endif /* PIOS_DELAY_H */
 
 /**
@@ -123,6 +123,9 @@ struct pios_hmc5x83_cfg {
 
 /* Public Functions */
 extern pios_hmc5x83_dev_t PIOS_HMC5x83_Init(const struct pios_hmc5x83_cfg *cfg, uint32_t port_id, uint8_t device_num);
+#ifdef PIOS_INCLUDE_I2C
+extern int32_t PIOS_HMC5x83_AsyncStart(pios_hmc5x83_dev_t handler);
+#endif
 extern bool PIOS_HMC5x83_NewDataAvailable(pios_hmc5x83_dev_t handler);
 extern int32_t PIOS_HMC5x83_ReadMag(pios_hmc5x83_dev_t handler, int16_t out[3]);
 extern uint8_t PIOS_HMC5x83_ReadID(pios_hmc5x83_dev_t handler, uint8_t out[4]);
@@ -46,6 +46,16 @@ enum pios_i2c_adapter_magic {
     PIOS_I2C_DEV_MAGIC = 0xa9a9b8b8,
 };
 
+/* number of callback transfers that can wait for the bus */
+#define PIOS_I2C_TXN_QUEUE_LEN 4
+
+/* a callback transfer waiting for the bus to become free */
+struct pios_i2c_queued_txn {
+    const struct pios_i2c_txn *txn_list;
+    uint32_t num_txns;
+    void     (*callback)();
+};
+
 struct pios_i2c_adapter {
     enum pios_i2c_adapter_magic magic;
     const struct pios_i2c_adapter_cfg *cfg;
@@ -70,6 +80,11 @@ struct pios_i2c_adapter {
 
     void    (*callback)();
 
+    /* pending callback transfers, started in order as the bus frees up */
+    struct pios_i2c_queued_txn txn_queue[PIOS_I2C_TXN_QUEUE_LEN];
+    volatile uint8_t txn_queue_head;
+    volatile uint8_t txn_queue_count;
+
     uint8_t *active_byte;
     uint8_t *last_byte;
 };
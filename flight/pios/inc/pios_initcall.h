@@ -50,6 +50,9 @@ typedef struct {
 
 /* Init module section */
 extern initmodule_t __module_initcall_start[], __module_initcall_end[];
+/* Deferred init module section, initialized from the system task after
+ * the critical module tasks have been created */
+extern initmodule_t __module_deferred_initcall_start[], __module_deferred_initcall_end[];
 
 #ifdef USE_SIM_POSIX
 
@@ -57,6 +60,7 @@ extern void InitModules();
 extern void StartModules();
 
 #define MODULE_INITCALL(ifn, sfn)
+#define MODULE_INITCALL_DEFERRED(ifn, sfn)
 
 #define MODULE_TASKCREATE_ALL \
     { \
@@ -71,6 +75,8 @@ extern void StartModules();
         /* Initialize the system thread */ \
         SystemModInitialize(); }
 
+#define MODULE_INITIALISE_DEFERRED
+
 #else
 
 /* initcalls are now grouped by functionality into separate
@@ -89,7 +95,13 @@ extern void StartModules();
     static initmodule_t __initcall_##ifn __attribute__((__used__)) \
     __attribute__((__section__(".initcall" level ".init"))) = { .fn_minit = ifn, .fn_tinit = sfn }
 
-#define MODULE_INITCALL(ifn, sfn) __define_module_initcall("module", ifn, sfn)
+#define MODULE_INITCALL(ifn, sfn)          __define_module_initcall("module", ifn, sfn)
+
+/* Modules that are not needed to reach the armable state can register here
+ * instead; they are initialized and started from the system task after all
+ * regular module tasks are already running, so slow initializations no
+ * longer gate boot-to-armable time. */
+#define MODULE_INITCALL_DEFERRED(ifn, sfn) __define_module_initcall("moduledeferred", ifn, sfn)
 
 #define MODULE_INITIALISE_ALL \
     { for (initmodule_t *fn = __module_initcall_start; fn < __module_initcall_end; fn++) { \
@@ -105,6 +117,15 @@ extern void StartModules();
       } \
     }
 
+#define MODULE_INITIALISE_DEFERRED \
+    { for (initmodule_t *fn = __module_deferred_initcall_start; fn < __module_deferred_initcall_end; fn++) { \
+          if (fn->fn_minit) { \
+              (fn->fn_minit)(); } \
+          if (fn->fn_tinit) { \
+              (fn->fn_tinit)(); } \
+      } \
+    }
+
 #endif /* USE_SIM_POSIX */
 
 #endif /* PIOS_INITCALL_H */
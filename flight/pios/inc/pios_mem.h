@@ -33,4 +33,43 @@ void *pios_malloc(size_t size);
 
 void pios_free(void *p);
 
+/*
+ * Declared allocation classes.  HOT_NODMA data goes to the fast heap
+ * (CCM on STM32F4: zero wait state for the CPU, unreachable by DMA);
+ * DMA_CAPABLE always comes from the general SRAM heap.  On targets
+ * without a fast heap both classes fall back to the general heap.
+ */
+enum pios_mem_class {
+    PIOS_MEM_CLASS_DMA_CAPABLE,
+    PIOS_MEM_CLASS_HOT_NODMA,
+};
+
+void *pios_malloc_class(enum pios_mem_class mem_class, size_t size);
+
+/*
+ * Places a static in the CCM bank on targets that have one.  The
+ * section is not loaded but cleared at startup, so only use this for
+ * zero-initialised data, and never for DMA buffers.
+ */
+#ifdef PIOS_TARGET_PROVIDES_FAST_HEAP
+#define PIOS_MEM_HOT_NODMA_SECTION __attribute__((section(".fast")))
+#else
+#define PIOS_MEM_HOT_NODMA_SECTION
+#endif
+
+#ifdef PIOS_INCLUDE_MEM_POOLS
+// number of size class pools in front of the general heap
+#define PIOS_MEM_NUM_POOLS 4
+
+struct pios_mem_pool_stats {
+    uint16_t block_size; // payload size of one block
+    uint16_t num_blocks; // total blocks in the pool
+    uint16_t in_use;     // blocks currently allocated
+    uint16_t high_water; // deepest occupancy seen since boot
+    uint32_t fallbacks;  // requests served from the heap because the pool ran dry
+};
+
+bool PIOS_MEM_GetPoolStats(uint8_t pool, struct pios_mem_pool_stats *stats);
+#endif /* PIOS_INCLUDE_MEM_POOLS */
+
 #endif /* PIOS_MEM_H */
@@ -64,10 +64,20 @@ enum pios_ms5611_osr {
     MS5611_OSR_4096 = 8,
 };
 
+/* Called after each completed conversion, from the context driving
+ * PIOS_MS5611_Update(). Compensated values are available through
+ * PIOS_MS5611_GetTemperature() / PIOS_MS5611_GetPressure(). */
+typedef void (*PIOS_MS5611_ConversionCallback)(ConversionTypeTypeDef type);
+
 /* Public Functions */
 extern void PIOS_MS5611_Init(const struct pios_ms5611_cfg *cfg, int32_t i2c_device);
 extern int32_t PIOS_MS5611_StartADC(ConversionTypeTypeDef Type);
 extern int32_t PIOS_MS5611_ReadADC(void);
+extern int32_t PIOS_MS5611_PollADC(void);
+extern void PIOS_MS5611_RegisterConversionCallback(PIOS_MS5611_ConversionCallback callback);
+extern void PIOS_MS5611_SetTempInterleave(uint8_t conversions);
+extern int32_t PIOS_MS5611_Update(void);
+extern uint32_t PIOS_MS5611_GetRemainingDelayUs(void);
 extern float PIOS_MS5611_GetTemperature(void);
 extern float PIOS_MS5611_GetPressure(void);
 extern int32_t PIOS_MS5611_Test();
@@ -31,15 +31,40 @@
 #ifndef PIOS_RCVR_H
 #define PIOS_RCVR_H
 
+#ifdef PIOS_INCLUDE_RCVR_STATS
+/**
+ * Frame timing statistics kept by receiver drivers that decode a serial
+ * frame stream (DSM, S.Bus).  Timestamps are taken with the cycle
+ * counter when the last byte of a good frame is seen in the rx
+ * interrupt, so they reflect frame arrival, not task scheduling.
+ */
+struct pios_rcvr_frame_stats {
+    uint32_t frame_count;    // good frames decoded since boot
+    uint32_t frame_age_us;   // time since the last good frame, filled in at read time
+    uint16_t period_us;      // most recent inter-frame period
+    uint16_t mean_period_us; // smoothed inter-frame period
+    uint16_t jitter_us;      // smoothed absolute deviation from the mean period
+    uint16_t max_jitter_us;  // worst deviation seen since boot
+};
+#endif /* PIOS_INCLUDE_RCVR_STATS */
+
 struct pios_rcvr_driver {
     void    (*init)(uint32_t id);
     int32_t (*read)(uint32_t id, uint8_t channel);
     xSemaphoreHandle (*get_semaphore)(uint32_t id, uint8_t channel);
+#ifdef PIOS_INCLUDE_RCVR_STATS
+    int32_t (*get_frame_stats)(uint32_t id, struct pios_rcvr_frame_stats *stats);
+#endif
 };
 
 /* Public Functions */
 extern int32_t PIOS_RCVR_Read(uint32_t rcvr_id, uint8_t channel);
 extern xSemaphoreHandle PIOS_RCVR_GetSemaphore(uint32_t rcvr_id, uint8_t channel);
+#ifdef PIOS_INCLUDE_RCVR_STATS
+extern int32_t PIOS_RCVR_GetFrameStats(uint32_t rcvr_id, struct pios_rcvr_frame_stats *stats);
+/* Driver-side helper, called from the rx interrupt on good frame completion */
+extern void PIOS_RCVR_RecordFrame(struct pios_rcvr_frame_stats *stats, uint32_t *last_frame_raw);
+#endif
 
 /*! Define error codes for PIOS_RCVR_Get */
 enum PIOS_RCVR_errors {
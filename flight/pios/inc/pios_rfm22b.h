@@ -82,6 +82,10 @@ struct rfm22b_stats {
     uint16_t packets_per_sec;
     uint16_t tx_byte_count;
     uint16_t rx_byte_count;
+    // per-stream share of the transmitted payload: control (PPM) bytes
+    // versus bulk com bytes, for airtime accounting
+    uint16_t tx_ppm_byte_count;
+    uint16_t tx_com_byte_count;
     uint16_t tx_seq;
     uint16_t rx_seq;
     uint8_t  rx_good;
@@ -733,6 +733,10 @@ struct pios_rfm22b_dev {
     uint16_t tx_data_wr;
     // The tx packet sequence number
     uint16_t tx_seq;
+    // Number of com bytes staged in the tx packet awaiting aggregation
+    uint8_t  tx_staged_len;
+    // Tick count when the first staged byte was pulled from the com layer
+    portTickType tx_stage_ticks;
 
     // The rx data packet
     uint8_t  rx_packet[RFM22B_MAX_PACKET_LEN];
@@ -747,6 +751,22 @@ struct pios_rfm22b_dev {
     int16_t  ppm[RFM22B_PPM_NUM_CHANNELS];
     // The PPM packet received callback.
     PPMReceivedCallback ppm_callback;
+    // The quantized channel values last sent on air (delta frame reference)
+    uint8_t  ppm_sent[RFM22B_PPM_NUM_CHANNELS];
+    // The validity bitmask last sent on air
+    uint8_t  ppm_sent_mask;
+    // The sequence number of the last sent control frame
+    uint8_t  ppm_seq;
+    // Delta frames left before the next key frame is forced
+    uint8_t  ppm_frames_to_key;
+    // The channel values reconstructed from received control frames
+    uint8_t  ppm_recv[RFM22B_PPM_NUM_CHANNELS];
+    // The validity bitmask from the last received key frame
+    uint8_t  ppm_recv_mask;
+    // The sequence number of the last received control frame
+    uint8_t  ppm_recv_seq;
+    // True while the delta reference matches the transmitter side
+    bool     ppm_base_valid;
 
     // The id that the packet was received from
     uint32_t     rx_destination_id;
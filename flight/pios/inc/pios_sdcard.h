@@ -97,6 +97,10 @@ extern int32_t PIOS_SDCARD_CheckAvailable(uint8_t was_available);
 extern int32_t PIOS_SDCARD_SendSDCCmd(uint8_t cmd, uint32_t addr, uint8_t crc);
 extern int32_t PIOS_SDCARD_SectorRead(uint32_t sector, uint8_t *buffer);
 extern int32_t PIOS_SDCARD_SectorWrite(uint32_t sector, uint8_t *buffer);
+
+/* Completion callback for asynchronous sector writes; status as per PIOS_SDCARD_SectorWrite */
+typedef void (*SDCARDWriteCallback)(uint32_t sector, int32_t status);
+extern int32_t PIOS_SDCARD_SectorWriteAsync(uint32_t sector, uint8_t *buffer, SDCARDWriteCallback callback);
 extern int32_t PIOS_SDCARD_CIDRead(SDCARDCidTypeDef *cid);
 extern int32_t PIOS_SDCARD_CSDRead(SDCARDCsdTypeDef *csd);
 
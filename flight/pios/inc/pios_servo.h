@@ -33,6 +33,7 @@
 /* Public Functions */
 extern void PIOS_Servo_SetHz(const uint16_t *update_rates, uint8_t banks);
 extern void PIOS_Servo_Set(uint8_t Servo, uint16_t Position);
+extern void PIOS_Servo_Update(void);
 
 #endif /* PIOS_SERVO_H */
 
@@ -42,6 +42,11 @@ typedef enum {
     PIOS_SPI_PRESCALER_256 = 7
 } SPIPrescalerTypeDef;
 
+typedef enum {
+    PIOS_SPI_CLAIM_PRIO_LOW  = 0, /* bulk transfers, e.g. flash logging, OSD */
+    PIOS_SPI_CLAIM_PRIO_HIGH = 1 /* control path sensor reads, e.g. gyro */
+} SPIClaimPrioTypeDef;
+
 /* Public Functions */
 extern int32_t PIOS_SPI_SetClockSpeed(uint32_t spi_id, SPIPrescalerTypeDef spi_prescaler);
 extern int32_t PIOS_SPI_RC_PinSet(uint32_t spi_id, uint32_t slave_id, uint8_t pin_value);
@@ -50,6 +55,8 @@ extern int32_t PIOS_SPI_TransferBlock(uint32_t spi_id, const uint8_t *send_buffe
 extern int32_t PIOS_SPI_Busy(uint32_t spi_id);
 extern int32_t PIOS_SPI_ClaimBus(uint32_t spi_id);
 extern int32_t PIOS_SPI_ClaimBusISR(uint32_t spi_id, bool *woken);
+extern int32_t PIOS_SPI_ClaimBusCallback(uint32_t spi_id, void (*callback)(uint32_t spi_id), SPIClaimPrioTypeDef priority);
+extern int32_t PIOS_SPI_ClaimBusCallbackISR(uint32_t spi_id, void (*callback)(uint32_t spi_id), SPIClaimPrioTypeDef priority, bool *woken);
 extern int32_t PIOS_SPI_ReleaseBus(uint32_t spi_id);
 extern int32_t PIOS_SPI_ReleaseBusISR(uint32_t spi_id, bool *woken);
 extern void    PIOS_SPI_IRQ_Handler(uint32_t spi_id);
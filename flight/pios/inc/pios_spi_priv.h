@@ -47,6 +47,15 @@ struct pios_spi_cfg {
     struct stm32_gpio ssel[];
 };
 
+/* number of callback bus claims that can wait for the bus */
+#define PIOS_SPI_CLAIM_QUEUE_LEN 4
+
+/* a prioritized bus claim waiting for the bus to become free */
+struct pios_spi_pending_claim {
+    void    (*callback)(uint32_t spi_id);
+    uint8_t priority;
+};
+
 struct pios_spi_dev {
     const struct pios_spi_cfg *cfg;
     void    (*callback)(uint8_t, uint8_t);
@@ -57,6 +66,10 @@ struct pios_spi_dev {
 #else
     uint8_t busy;
 #endif
+
+    /* pending callback claims, dispatched highest priority first on bus release */
+    struct pios_spi_pending_claim claim_queue[PIOS_SPI_CLAIM_QUEUE_LEN];
+    volatile uint8_t claim_queue_count;
 };
 
 extern int32_t PIOS_SPI_Init(uint32_t *spi_id, const struct pios_spi_cfg *cfg);
@@ -71,6 +71,10 @@ extern int32_t PIOS_TASK_MONITOR_UnregisterTask(uint16_t task_id);
  */
 extern bool PIOS_TASK_MONITOR_IsRunning(uint16_t task_id);
 
+/** Number of bins in the per-task load histogram. Each bin covers an
+ *  equal share of the 0-100% load range. */
+#define PIOS_TASK_MONITOR_HISTOGRAM_BINS 8
+
 /**
  * Information about a running task that has been registered
  * via a call to PIOS_TASK_MONITOR_Add().
@@ -104,6 +108,38 @@ typedef void (*TaskMonitorTaskInfoCallback)(uint16_t task_id, const struct pios_
  */
 extern void PIOS_TASK_MONITOR_ForEachTask(TaskMonitorTaskInfoCallback callback, void *context);
 
+/**
+ * Load and stack statistics accumulated for a task over a sampling window.
+ * A sample is taken on every call to PIOS_TASK_MONITOR_ForEachTask(); the
+ * window is the span between two calls to PIOS_TASK_MONITOR_ForEachTaskStats(),
+ * which reports the statistics and starts a new window.
+ */
+struct pios_task_stats {
+    /** Number of load samples that fell into each load band. */
+    uint16_t load_histogram[PIOS_TASK_MONITOR_HISTOGRAM_BINS];
+    /** Lowest remaining stack seen during the window, in bytes. */
+    uint16_t stack_low_water;
+    /** Highest load sample seen during the window, in percent. */
+    uint8_t  max_load;
+    /** Flag indicating whether or not the task is running. */
+    bool     is_running;
+};
+
+/**
+ * Iterator callback, called for each monitored task by PIOS_TASK_MONITOR_ForEachTaskStats().
+ *
+ * @param task_id The id of the task the stats refer to.
+ * @param stats   Statistics accumulated for the task since the previous call.
+ * @param context Context information optionally provided by the caller to PIOS_TASK_MONITOR_ForEachTaskStats()
+ */
+typedef void (*TaskMonitorTaskStatsCallback)(uint16_t task_id, const struct pios_task_stats *stats, void *context);
+
+/**
+ * Report the accumulated statistics of all tasks via a task-by-task callback
+ * and reset them for the next sampling window.
+ */
+extern void PIOS_TASK_MONITOR_ForEachTaskStats(TaskMonitorTaskStatsCallback callback, void *context);
+
 /**
  * Return the idle task running time percentage.
  */
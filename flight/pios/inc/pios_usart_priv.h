@@ -38,6 +38,19 @@
 
 extern const struct pios_com_driver pios_usart_com_driver;
 
+/*
+ * Optional circular buffer DMA reception (STM32F4 only).  The driver keeps
+ * the stream running into its own buffer and drains filled spans into the
+ * com layer on idle line interrupts, cutting the interrupt rate from per
+ * byte to per frame.  The board supplies the stream, the transfer setup
+ * (circular mode, byte transfers, peripheral to memory) and the buffer
+ * size; the driver fills in the addresses.
+ */
+struct pios_usart_dma_rx_cfg {
+    struct stm32_dma_chan rx;
+    uint16_t buffer_size;
+};
+
 struct pios_usart_cfg {
     USART_TypeDef     *regs;
     uint32_t remap; /* GPIO_Remap_* */
@@ -45,6 +58,7 @@ struct pios_usart_cfg {
     struct stm32_gpio rx;
     struct stm32_gpio tx;
     struct stm32_irq  irq;
+    const struct pios_usart_dma_rx_cfg *dma_rx;
 };
 
 extern int32_t PIOS_USART_Init(uint32_t *usart_id, const struct pios_usart_cfg *cfg);
@@ -59,6 +59,9 @@ extern TTime timex;
 
 extern void PIOS_Video_Init(const struct pios_video_cfg *cfg);
 uint16_t PIOS_Video_GetOSDLines(void);
+extern void PIOS_Video_FrameReady(void);
+extern bool PIOS_Video_InBlanking(void);
+extern int32_t PIOS_Video_WaitForBlanking(uint32_t timeout_ms);
 extern bool PIOS_Hsync_ISR();
 extern bool PIOS_Vsync_ISR();
 
@@ -38,6 +38,9 @@ uint32_t PIOS_BL_HELPER_CRC_Memory_Calc()
     return 0;
 }
 
+void PIOS_BL_HELPER_CRC_Invalidate()
+{}
+
 extern const struct fw_version_info fw_version_blob;
 void PIOS_BL_HELPER_FLASH_Read_Description(uint8_t *array, uint8_t size)
 {
@@ -68,4 +68,10 @@ void PIOS_Servo_Set(uint8_t Servo, uint16_t Position)
 #endif // PIOS_ENABLE_DEBUG_PINS
 }
 
+/**
+ * Start the pulse on all synchronous banks
+ */
+void PIOS_Servo_Update(void)
+{}
+
 #endif /* if defined(PIOS_INCLUDE_SERVO) */
@@ -73,6 +73,10 @@
 /* PIOS Hardware Includes (posix) */
 #include <pios_sys.h>
 #include <pios_delay.h>
+/* Lockstep virtual clock, posix port only: time advances per simulated
+ * sensor frame instead of following the wall clock. */
+extern void PIOS_DELAY_SetVirtualClock(bool enabled);
+extern void PIOS_DELAY_AdvanceuS(uint32_t uS);
 #include <pios_led.h>
 /* FIXME: simposix needs its own custom include directory into
  * which a custom pios_led.h can be put that includes the following
@@ -41,6 +41,17 @@
  */
 #include <time.h>
 
+/*
+ * Lockstep virtual clock for faster-than-realtime simulation.
+ *
+ * When enabled the microsecond clock no longer follows wall time;
+ * it advances only when the simulation feeds in sensor frames via
+ * PIOS_DELAY_AdvanceuS(), and delays consume simulated time instead
+ * of sleeping.  A mission then runs as fast as frames can be served.
+ */
+static bool  virtual_clock;
+static uint32_t virtual_us;
+
 int32_t PIOS_DELAY_Init(void)
 {
     // stub
@@ -49,6 +60,24 @@ int32_t PIOS_DELAY_Init(void)
     return 0;
 }
 
+/**
+ * Switch between the wall clock and the lockstep virtual clock
+ * \param[in] enabled true selects the virtual clock
+ */
+void PIOS_DELAY_SetVirtualClock(bool enabled)
+{
+    virtual_clock = enabled;
+}
+
+/**
+ * Advance the virtual clock, called per simulated sensor frame
+ * \param[in] uS simulated time step
+ */
+void PIOS_DELAY_AdvanceuS(uint32_t uS)
+{
+    virtual_us += uS;
+}
+
 /**
  * Waits for a specific number of uS<BR>
  * Example:<BR>
@@ -63,6 +92,11 @@ int32_t PIOS_DELAY_WaituS(uint32_t uS)
 {
     static struct timespec wait, rest;
 
+    if (virtual_clock) {
+        virtual_us += uS;
+        return 0;
+    }
+
     wait.tv_sec  = 0;
     wait.tv_nsec = 1000 * uS;
     while (nanosleep(&wait, &rest) != 0) {
@@ -90,6 +124,11 @@ int32_t PIOS_DELAY_WaitmS(uint32_t mS)
     // PIOS_DELAY_WaituS(1000);
     static struct timespec wait, rest;
 
+    if (virtual_clock) {
+        virtual_us += mS * 1000;
+        return 0;
+    }
+
     wait.tv_sec  = mS / 1000;
     wait.tv_nsec = (mS % 1000) * 1000000;
     while (nanosleep(&wait, &rest) != 0) {
@@ -109,6 +148,10 @@ uint32_t PIOS_DELAY_GetuS()
 {
     static struct timespec current;
 
+    if (virtual_clock) {
+        return virtual_us;
+    }
+
     clock_gettime(CLOCK_REALTIME, &current);
     return (current.tv_sec * 1000000) + (current.tv_nsec / 1000);
 }
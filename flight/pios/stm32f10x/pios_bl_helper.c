@@ -57,6 +57,7 @@ uint8_t PIOS_BL_HELPER_FLASH_Start()
     uint32_t startAddress = bdinfo->fw_base;
     uint32_t endAddress   = bdinfo->fw_base + bdinfo->fw_size + bdinfo->desc_size;
 
+    PIOS_BL_HELPER_CRC_Invalidate();
     bool success = erase_flash(startAddress, endAddress);
 
     return (success) ? 1 : 0;
@@ -99,14 +100,28 @@ static bool erase_flash(uint32_t startAddress, uint32_t endAddress)
 
 #endif /* if defined(PIOS_INCLUDE_BL_HELPER_WRITE_SUPPORT) */
 
+/* Scanning the whole firmware bank takes long enough to matter at boot,
+ * so the result is cached until a flash erase or program invalidates it. */
+static uint32_t fw_crc;
+static bool fw_crc_valid;
+
 uint32_t PIOS_BL_HELPER_CRC_Memory_Calc()
 {
     const struct pios_board_info *bdinfo = &pios_board_info_blob;
 
-    PIOS_BL_HELPER_CRC_Ini();
-    CRC_ResetDR();
-    CRC_CalcBlockCRC((uint32_t *)bdinfo->fw_base, (bdinfo->fw_size) >> 2);
-    return CRC_GetCRC();
+    if (!fw_crc_valid) {
+        PIOS_BL_HELPER_CRC_Ini();
+        CRC_ResetDR();
+        CRC_CalcBlockCRC((uint32_t *)bdinfo->fw_base, (bdinfo->fw_size) >> 2);
+        fw_crc = CRC_GetCRC();
+        fw_crc_valid = true;
+    }
+    return fw_crc;
+}
+
+void PIOS_BL_HELPER_CRC_Invalidate()
+{
+    fw_crc_valid = false;
 }
 
 void PIOS_BL_HELPER_FLASH_Read_Description(uint8_t *array, uint8_t size)
@@ -33,12 +33,11 @@
 
 #ifdef PIOS_INCLUDE_EXTI
 
-/* Map EXTI line to full config */
-#define EXTI_MAX_LINES    16
-#define PIOS_EXTI_INVALID 0xFF
-static uint8_t pios_exti_line_to_cfg_map[EXTI_MAX_LINES] = {
-    [0 ... EXTI_MAX_LINES - 1] = PIOS_EXTI_INVALID,
-};
+/* Per-line dispatch table.  PIOS_EXTI_Init() flattens the vector of each
+ * registered config into the slot of its line, so interrupt dispatch is a
+ * single indexed call with no config lookup on the way */
+#define EXTI_MAX_LINES 16
+static bool (*pios_exti_vector_table[EXTI_MAX_LINES])(void);
 
 /* Table of exti configs registered at compile time */
 extern struct pios_exti_cfg __start__exti __attribute__((weak));
@@ -153,18 +152,16 @@ int32_t PIOS_EXTI_Init(const struct pios_exti_cfg *cfg)
     PIOS_Assert(cfg >= &__start__exti);
     PIOS_Assert(cfg < &__stop__exti);
 
-    uint8_t cfg_index  = cfg - &__start__exti;
-
     /* Connect this config to the requested vector */
     uint8_t line_index = PIOS_EXTI_line_to_index(cfg->line);
 
-    if (pios_exti_line_to_cfg_map[line_index] != PIOS_EXTI_INVALID) {
+    if (pios_exti_vector_table[line_index]) {
         /* Someone else already has this mapped */
         goto out_fail;
     }
 
-    /* Bind the config to the exti line */
-    pios_exti_line_to_cfg_map[line_index] = cfg_index;
+    /* Bind the vector of this config to the exti line */
+    pios_exti_vector_table[line_index] = cfg->vector;
 
     /* Initialize the GPIO pin */
     GPIO_Init(cfg->pin.gpio, &cfg->pin.init);
@@ -186,18 +183,13 @@ out_fail:
 
 static bool PIOS_EXTI_generic_irq_handler(uint8_t line_index)
 {
-    uint8_t cfg_index = pios_exti_line_to_cfg_map[line_index];
-
-    PIOS_Assert(&__start__exti);
+    bool (*vector)(void) = pios_exti_vector_table[line_index];
 
-    if (cfg_index > NELEMENTS(pios_exti_line_to_cfg_map) ||
-        cfg_index == PIOS_EXTI_INVALID) {
+    if (!vector) {
         /* Unconfigured interrupt just fired! */
         return false;
     }
-
-    struct pios_exti_cfg *cfg = &__start__exti + cfg_index;
-    return cfg->vector();
+    return vector();
 }
 
 #ifdef PIOS_INCLUDE_FREERTOS
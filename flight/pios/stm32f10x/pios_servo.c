@@ -39,6 +39,17 @@
 
 static const struct pios_servo_cfg *servo_cfg;
 
+/* Timers running in synchronous (OneShot style) mode.  These banks do not
+ * free run; the pulse is started explicitly from PIOS_Servo_Update() once
+ * the actuator module has written every channel, so a fresh command never
+ * waits for the natural period wrap. */
+#define PIOS_SERVO_MAX_BANKS        6
+/* Tick multiplier for synchronous banks.  OneShot125 pulses only span
+ * 125-250us, so run the timer at 8MHz instead of 1MHz to keep resolution */
+#define PIOS_SERVO_ONESHOT_PRESCALER 8
+static TIM_TypeDef *servo_sync_timer[PIOS_SERVO_MAX_BANKS];
+static uint8_t servo_sync_timer_count;
+
 /**
  * Initialise Servos
  */
@@ -87,6 +98,9 @@ int32_t PIOS_Servo_Init(const struct pios_servo_cfg *cfg)
 
 /**
  * Set the servo update rate (Max 500Hz)
+ * A rate of 0 puts the bank in synchronous (OneShot) mode: the timer is
+ * parked at its maximum period and the pulse is triggered by
+ * PIOS_Servo_Update() instead of free running.
  * \param[in] array of rates in Hz
  * \param[in] maximum number of banks
  */
@@ -99,10 +113,11 @@ void PIOS_Servo_SetHz(const uint16_t *speeds, uint8_t banks)
     TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure = servo_cfg->tim_base_init;
     TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
     TIM_TimeBaseStructure.TIM_CounterMode   = TIM_CounterMode_Up;
-    TIM_TimeBaseStructure.TIM_Prescaler     = (PIOS_MASTER_CLOCK / 1000000) - 1;
 
     uint8_t set = 0;
 
+    servo_sync_timer_count = 0;
+
     for (uint8_t i = 0; (i < servo_cfg->num_channels) && (set < banks); i++) {
         bool new = true;
         const struct pios_tim_channel *chan = &servo_cfg->channels[i];
@@ -113,13 +128,37 @@ void PIOS_Servo_SetHz(const uint16_t *speeds, uint8_t banks)
         }
 
         if (new) {
-            TIM_TimeBaseStructure.TIM_Period = ((1000000 / speeds[set]) - 1);
+            if (speeds[set] == 0) {
+                /* Synchronous bank: run a finer tick for OneShot125 style
+                 * pulses and let the counter park until the next update */
+                TIM_TimeBaseStructure.TIM_Prescaler = (PIOS_MASTER_CLOCK / (1000000 * PIOS_SERVO_ONESHOT_PRESCALER)) - 1;
+                TIM_TimeBaseStructure.TIM_Period    = 0xFFFF;
+                if (servo_sync_timer_count < PIOS_SERVO_MAX_BANKS) {
+                    servo_sync_timer[servo_sync_timer_count++] = chan->timer;
+                }
+            } else {
+                TIM_TimeBaseStructure.TIM_Prescaler = (PIOS_MASTER_CLOCK / 1000000) - 1;
+                TIM_TimeBaseStructure.TIM_Period    = ((1000000 / speeds[set]) - 1);
+            }
             TIM_TimeBaseInit(chan->timer, &TIM_TimeBaseStructure);
             set++;
         }
     }
 }
 
+/**
+ * Check whether a timer is driven synchronously
+ */
+static bool PIOS_Servo_IsSynchronous(TIM_TypeDef *timer)
+{
+    for (uint8_t i = 0; i < servo_sync_timer_count; i++) {
+        if (servo_sync_timer[i] == timer) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * Set servo position
  * \param[in] Servo Servo number (0-7)
@@ -134,6 +173,12 @@ void PIOS_Servo_Set(uint8_t servo, uint16_t position)
 
     /* Update the position */
     const struct pios_tim_channel *chan = &servo_cfg->channels[servo];
+
+    /* Synchronous banks tick PIOS_SERVO_ONESHOT_PRESCALER times per us */
+    if (PIOS_Servo_IsSynchronous(chan->timer)) {
+        position *= PIOS_SERVO_ONESHOT_PRESCALER;
+    }
+
     switch (chan->timer_chan) {
     case TIM_Channel_1:
         TIM_SetCompare1(chan->timer, position);
@@ -150,4 +195,17 @@ void PIOS_Servo_Set(uint8_t servo, uint16_t position)
     }
 }
 
+/**
+ * Start the pulse on all synchronous banks
+ * Called once per actuator update after every channel has been written; the
+ * update event latches the preloaded compare values and restarts the counter
+ * so the pulse begins immediately instead of at the next period wrap.
+ */
+void PIOS_Servo_Update(void)
+{
+    for (uint8_t i = 0; i < servo_sync_timer_count; i++) {
+        TIM_GenerateEvent(servo_sync_timer[i], TIM_EventSource_Update);
+    }
+}
+
 #endif /* PIOS_INCLUDE_SERVO */
@@ -110,11 +110,20 @@ struct adc_accumulator {
     uint32_t count;
 };
 
+/* Free-running integer sum for coulomb counting.  Unlike the averaging
+ * accumulator above it is only cleared when the consumer fetches it, so
+ * every hardware-paced sample is integrated exactly once. */
+struct adc_coulomb {
+    uint64_t sum;
+    uint32_t count;
+};
+
 #if defined(PIOS_INCLUDE_ADC)
 static const struct dma_config config[] = PIOS_DMA_PIN_CONFIG;
 #define PIOS_ADC_NUM_PINS (sizeof(config) / sizeof(config[0]))
 
 static struct adc_accumulator accumulator[PIOS_ADC_NUM_PINS];
+static struct adc_coulomb coulomb[PIOS_ADC_NUM_PINS];
 
 // Two buffers here for double buffering
 static uint16_t adc_raw_buffer[2][PIOS_ADC_MAX_SAMPLES][PIOS_ADC_NUM_PINS];
@@ -329,6 +338,96 @@ float PIOS_ADC_PinGetVolt(uint32_t pin)
     return ((float)PIOS_ADC_PinGet(pin)) * PIOS_ADC_VOLTAGE_SCALE;
 }
 
+/* Per pin oversample-and-decimate configuration.  Every n extra bits of
+ * resolution requires averaging at least 4^n hardware paced samples,
+ * which the continuous DMA conversion delivers between any two reads at
+ * a sane task rate. */
+#define PIOS_ADC_OVERSAMPLE_MAX_BITS 4
+static uint8_t oversample_bits[PIOS_ADC_NUM_PINS];
+
+/**
+ * @brief Configure the oversample-and-decimate stage of an ADC pin
+ * @param[in] pin number
+ * @param[in] bits extra bits of resolution gained by decimation (0..4)
+ */
+void PIOS_ADC_PinSetOversampleBits(uint32_t pin, uint8_t bits)
+{
+    if (pin >= PIOS_ADC_NUM_PINS) {
+        return;
+    }
+    if (bits > PIOS_ADC_OVERSAMPLE_MAX_BITS) {
+        bits = PIOS_ADC_OVERSAMPLE_MAX_BITS;
+    }
+    oversample_bits[pin] = bits;
+}
+
+/**
+ * Returns the decimated value of an ADC pin
+ * @param[in] pin number
+ * @return pin value averaged over the samples since the last reading,
+ *         scaled to 12 + configured extra bits of resolution
+ * @return -1 if pin doesn't exist
+ * @return -2 if no data acquired since last read
+ */
+int32_t PIOS_ADC_PinGetOversampled(uint32_t pin)
+{
+#if defined(PIOS_INCLUDE_ADC)
+    /* Check if pin exists */
+    if (pin >= PIOS_ADC_NUM_PINS) {
+        return -1;
+    }
+
+    if (accumulator[pin].accumulator <= 0) {
+        return -2;
+    }
+
+    /* decimate with rounding and clear the accumulator */
+    uint32_t count  = accumulator[pin].count ? : 1;
+    uint8_t bits    = oversample_bits[pin];
+    int32_t result  = (int32_t)((((uint64_t)accumulator[pin].accumulator << bits) + count / 2) / count);
+    accumulator[pin].accumulator = result >> bits;
+    accumulator[pin].count = 1;
+
+    return result;
+
+#endif
+    return -1;
+}
+
+/**
+ * Fetch and clear the coulomb counting accumulator of an ADC pin.
+ * The sum of all raw samples and their number since the previous fetch
+ * lets the caller integrate exactly at the hardware sampling rate, no
+ * matter how much its own schedule jitters.
+ * @param[in] pin number
+ * @param[out] raw_sum sum of the raw samples since the last fetch
+ * @param[out] sample_count number of samples summed
+ * @return 0 on success, -1 if pin doesn't exist
+ */
+int32_t PIOS_ADC_PinGetAccumulator(uint32_t pin, uint64_t *raw_sum, uint32_t *sample_count)
+{
+#if defined(PIOS_INCLUDE_ADC)
+    /* Check if pin exists */
+    if (pin >= PIOS_ADC_NUM_PINS) {
+        return -1;
+    }
+
+    /* the DMA handler updates the accumulator, fetch and clear atomically */
+    PIOS_IRQ_Disable();
+    *raw_sum      = coulomb[pin].sum;
+    *sample_count = coulomb[pin].count;
+    coulomb[pin].sum   = 0;
+    coulomb[pin].count = 0;
+    PIOS_IRQ_Enable();
+
+    return 0;
+
+#else
+    return -1;
+
+#endif
+}
+
 /**
  * @brief Set a callback function that is executed whenever
  * the ADC double buffer swaps
@@ -403,8 +502,10 @@ void accumulate(uint16_t *buffer, uint32_t count)
      */
     while (count--) {
         for (uint32_t i = 0; i < PIOS_ADC_NUM_PINS; ++i) {
-            accumulator[i].accumulator += *sp++;
+            accumulator[i].accumulator += *sp;
             accumulator[i].count++;
+            coulomb[i].sum += *sp++;
+            coulomb[i].count++;
             /*
              * If the accumulator reaches half-full, rescale in order to
              * make more space.
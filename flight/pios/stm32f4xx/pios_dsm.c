@@ -46,10 +46,16 @@ static uint16_t PIOS_DSM_RxInCallback(uint32_t context,
                                       uint16_t *headroom,
                                       bool *need_yield);
 static void PIOS_DSM_Supervisor(uint32_t dsm_id);
+#ifdef PIOS_INCLUDE_RCVR_STATS
+static int32_t PIOS_DSM_GetFrameStats(uint32_t rcvr_id, struct pios_rcvr_frame_stats *stats);
+#endif
 
 /* Local Variables */
 const struct pios_rcvr_driver pios_dsm_rcvr_driver = {
     .read = PIOS_DSM_Get,
+#ifdef PIOS_INCLUDE_RCVR_STATS
+    .get_frame_stats = PIOS_DSM_GetFrameStats,
+#endif
 };
 
 enum pios_dsm_dev_magic {
@@ -67,6 +73,10 @@ struct pios_dsm_state {
     uint8_t  frames_lost_last;
     uint16_t frames_lost;
 #endif
+#ifdef PIOS_INCLUDE_RCVR_STATS
+    struct pios_rcvr_frame_stats frame_stats;
+    uint32_t last_frame_raw;
+#endif
 };
 
 struct pios_dsm_dev {
@@ -168,6 +178,9 @@ static void PIOS_DSM_ResetState(struct pios_dsm_dev *dsm_dev)
 #ifdef DSM_LOST_FRAME_COUNTER
     state->frames_lost_last = 0;
     state->frames_lost      = 0;
+#endif
+#ifdef PIOS_INCLUDE_RCVR_STATS
+    memset(&state->frame_stats, 0, sizeof(state->frame_stats));
 #endif
     PIOS_DSM_ResetChannels(dsm_dev);
 }
@@ -254,6 +267,10 @@ static void PIOS_DSM_UpdateState(struct pios_dsm_dev *dsm_dev, uint8_t byte)
                 if (!PIOS_DSM_UnrollChannels(dsm_dev)) {
                     /* data looking good */
                     state->failsafe_timer = 0;
+#ifdef PIOS_INCLUDE_RCVR_STATS
+                    /* timestamp the frame while still in the rx interrupt */
+                    PIOS_RCVR_RecordFrame(&state->frame_stats, &state->last_frame_raw);
+#endif
                 }
 
                 /* prepare for the next frame */
@@ -358,6 +375,26 @@ static int32_t PIOS_DSM_Get(uint32_t rcvr_id, uint8_t channel)
     return dsm_dev->state.channel_data[channel];
 }
 
+#ifdef PIOS_INCLUDE_RCVR_STATS
+/**
+ * Get the frame timing statistics
+ * \output 0 stats filled in
+ * \output -1 invalid device
+ */
+static int32_t PIOS_DSM_GetFrameStats(uint32_t rcvr_id, struct pios_rcvr_frame_stats *stats)
+{
+    struct pios_dsm_dev *dsm_dev = (struct pios_dsm_dev *)rcvr_id;
+
+    if (!PIOS_DSM_Validate(dsm_dev)) {
+        return -1;
+    }
+
+    *stats = dsm_dev->state.frame_stats;
+    stats->frame_age_us = stats->frame_count ? PIOS_DELAY_DiffuS(dsm_dev->state.last_frame_raw) : 0;
+    return 0;
+}
+#endif /* PIOS_INCLUDE_RCVR_STATS */
+
 /**
  * Input data supervisor is called periodically and provides
  * two functions: frame syncing and failsafe triggering.
@@ -161,6 +161,10 @@ static void i2c_adapter_reset_bus(struct pios_i2c_adapter *i2c_adapter);
 static void i2c_adapter_log_fault(enum pios_i2c_error_type type);
 static bool i2c_adapter_callback_handler(struct pios_i2c_adapter *i2c_adapter);
 
+static void i2c_adapter_start_callback_txn(struct pios_i2c_adapter *i2c_adapter, const struct pios_i2c_txn txn_list[], uint32_t num_txns, void *callback);
+static int32_t i2c_adapter_queue_txn(struct pios_i2c_adapter *i2c_adapter, const struct pios_i2c_txn txn_list[], uint32_t num_txns, void *callback);
+static bool i2c_adapter_start_next_txn(struct pios_i2c_adapter *i2c_adapter);
+
 static const struct i2c_adapter_transition i2c_adapter_transitions[I2C_STATE_NUM_STATES] = {
     [I2C_STATE_FSM_FAULT] =             {
         .entry_fn   = go_fsm_fault,
@@ -855,15 +859,19 @@ static bool i2c_adapter_callback_handler(struct pios_i2c_adapter *i2c_adapter)
     i2c_cb_count++;
 
 #ifdef USE_FREERTOS
-    /* Unlock the bus */
-    xSemaphoreGive(i2c_adapter->sem_busy);
+    /* Start the next pending transaction, only unlock the bus once the queue is drained */
+    if (!i2c_adapter_start_next_txn(i2c_adapter)) {
+        xSemaphoreGive(i2c_adapter->sem_busy);
+    }
     if (!semaphore_success) {
         i2c_timeout_counter++;
     }
 #else
-    PIOS_IRQ_Disable();
-    i2c_adapter->busy = 0;
-    PIOS_IRQ_Enable();
+    if (!i2c_adapter_start_next_txn(i2c_adapter)) {
+        PIOS_IRQ_Disable();
+        i2c_adapter->busy = 0;
+        PIOS_IRQ_Enable();
+    }
 #endif /* USE_FREERTOS */
 
 
@@ -997,6 +1005,9 @@ int32_t PIOS_I2C_Init(uint32_t *i2c_id, const struct pios_i2c_adapter_cfg *cfg)
     i2c_adapter->busy     = 0;
 #endif // USE_FREERTOS
 
+    i2c_adapter->txn_queue_head  = 0;
+    i2c_adapter->txn_queue_count = 0;
+
     /* Initialize the state machine */
     i2c_adapter_fsm_init(i2c_adapter);
 
@@ -1124,31 +1135,57 @@ int32_t PIOS_I2C_Transfer_Callback(uint32_t i2c_id, const struct pios_i2c_txn tx
     PIOS_DEBUG_Assert(txn_list);
     PIOS_DEBUG_Assert(num_txns);
 
-    bool semaphore_success = true;
-
 #ifdef USE_FREERTOS
-    /* Lock the bus */
-    portTickType timeout;
-    timeout = i2c_adapter->cfg->transfer_timeout_ms / portTICK_RATE_MS;
-    if (xSemaphoreTake(i2c_adapter->sem_busy, timeout) == pdFALSE) {
-        return -2;
+    /* Try to lock the bus, but never wait for it */
+    if (xSemaphoreTake(i2c_adapter->sem_busy, 0) == pdFALSE) {
+        /* Bus is in use, queue the transaction. It is started from the
+         * completion path of the transfer that currently owns the bus. */
+        int32_t queued = i2c_adapter_queue_txn(i2c_adapter, txn_list, num_txns, callback);
+        if (queued != 0) {
+            return queued;
+        }
+        /* The bus may have gone idle between the failed take and the
+         * enqueue, in which case nobody is left to drain the queue */
+        if (xSemaphoreTake(i2c_adapter->sem_busy, 0) == pdTRUE) {
+            if (!i2c_adapter_start_next_txn(i2c_adapter)) {
+                xSemaphoreGive(i2c_adapter->sem_busy);
+            }
+        }
+        return 0;
     }
 #else
+    PIOS_IRQ_Disable();
     if (i2c_adapter->busy) {
+        /* Bus is in use, queue the transaction. The check and the enqueue
+         * are atomic here, the completion path runs from the ISR. */
+        int32_t queued = i2c_adapter_queue_txn(i2c_adapter, txn_list, num_txns, callback);
         PIOS_IRQ_Enable();
-        return -2;
+        return queued;
     }
+    i2c_adapter->busy = 1;
+    PIOS_IRQ_Enable();
 #endif /* USE_FREERTOS */
 
     PIOS_DEBUG_Assert(i2c_adapter->curr_state == I2C_STATE_STOPPED);
 
+    i2c_adapter_start_callback_txn(i2c_adapter, txn_list, num_txns, callback);
+
+    return 0;
+}
+
+/**
+ * Program the adapter with a callback transaction and start it.
+ * The caller must already own the bus.
+ */
+static void i2c_adapter_start_callback_txn(struct pios_i2c_adapter *i2c_adapter, const struct pios_i2c_txn txn_list[], uint32_t num_txns, void *callback)
+{
     i2c_adapter->first_txn  = &txn_list[0];
     i2c_adapter->last_txn   = &txn_list[num_txns - 1];
     i2c_adapter->active_txn = i2c_adapter->first_txn;
 
 #ifdef USE_FREERTOS
     /* Make sure the done/ready semaphore is consumed before we start */
-    semaphore_success &= (xSemaphoreTake(i2c_adapter->sem_ready, timeout) == pdTRUE);
+    xSemaphoreTake(i2c_adapter->sem_ready, 0);
 #endif
 
     // used in the i2c_adapter_callback_handler function
@@ -1162,9 +1199,52 @@ int32_t PIOS_I2C_Transfer_Callback(uint32_t i2c_id, const struct pios_i2c_txn tx
 
     i2c_adapter->callback  = callback;
     i2c_adapter->bus_error = false;
+    i2c_adapter->nack = false;
     i2c_adapter_inject_event(i2c_adapter, I2C_EVENT_START);
+}
+
+/**
+ * Append a callback transaction to the pending queue.
+ * \return 0 if queued, -2 if the queue is full
+ */
+static int32_t i2c_adapter_queue_txn(struct pios_i2c_adapter *i2c_adapter, const struct pios_i2c_txn txn_list[], uint32_t num_txns, void *callback)
+{
+    PIOS_IRQ_Disable();
+    if (i2c_adapter->txn_queue_count >= PIOS_I2C_TXN_QUEUE_LEN) {
+        PIOS_IRQ_Enable();
+        return -2;
+    }
+    struct pios_i2c_queued_txn *qtxn = &i2c_adapter->txn_queue[(i2c_adapter->txn_queue_head + i2c_adapter->txn_queue_count) % PIOS_I2C_TXN_QUEUE_LEN];
+    qtxn->txn_list = txn_list;
+    qtxn->num_txns = num_txns;
+    qtxn->callback = callback;
+    i2c_adapter->txn_queue_count++;
+    PIOS_IRQ_Enable();
+    return 0;
+}
+
+/**
+ * Start the oldest pending callback transaction, if there is one.
+ * The caller must already own the bus and the fsm must be stopped.
+ * \return true if a queued transaction was started
+ */
+static bool i2c_adapter_start_next_txn(struct pios_i2c_adapter *i2c_adapter)
+{
+    struct pios_i2c_queued_txn qtxn;
+
+    PIOS_IRQ_Disable();
+    if (i2c_adapter->txn_queue_count == 0) {
+        PIOS_IRQ_Enable();
+        return false;
+    }
+    qtxn = i2c_adapter->txn_queue[i2c_adapter->txn_queue_head];
+    i2c_adapter->txn_queue_head = (i2c_adapter->txn_queue_head + 1) % PIOS_I2C_TXN_QUEUE_LEN;
+    i2c_adapter->txn_queue_count--;
+    PIOS_IRQ_Enable();
+
+    i2c_adapter_start_callback_txn(i2c_adapter, qtxn.txn_list, qtxn.num_txns, qtxn.callback);
 
-    return !semaphore_success ? -2 : 0;
+    return true;
 }
 
 void PIOS_I2C_EV_IRQ_Handler(uint32_t i2c_id)
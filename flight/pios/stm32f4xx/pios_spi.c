@@ -98,6 +98,8 @@ int32_t PIOS_SPI_Init(uint32_t *spi_id, const struct pios_spi_cfg *cfg)
     /* Disable callback function */
     spi_dev->callback = NULL;
 
+    spi_dev->claim_queue_count = 0;
+
     /* Set rx/tx dummy bytes to a known value */
     spi_dev->rx_dummy_byte = 0xFF;
     spi_dev->tx_dummy_byte = 0xFF;
@@ -244,6 +246,58 @@ int32_t PIOS_SPI_SetClockSpeed(uint32_t spi_id, SPIPrescalerTypeDef spi_prescale
     return 0;
 }
 
+/**
+ * Append a callback claim to the pending queue.
+ * \return 0 if queued, -2 if the queue is full
+ */
+static int32_t PIOS_SPI_QueueClaim(struct pios_spi_dev *spi_dev, void (*callback)(uint32_t spi_id), SPIClaimPrioTypeDef priority)
+{
+    PIOS_IRQ_Disable();
+    if (spi_dev->claim_queue_count >= PIOS_SPI_CLAIM_QUEUE_LEN) {
+        PIOS_IRQ_Enable();
+        return -2;
+    }
+    spi_dev->claim_queue[spi_dev->claim_queue_count].callback = callback;
+    spi_dev->claim_queue[spi_dev->claim_queue_count].priority = priority;
+    spi_dev->claim_queue_count++;
+    PIOS_IRQ_Enable();
+    return 0;
+}
+
+/**
+ * Hand the bus to the oldest pending claim with the highest priority.
+ * The caller must own the bus; on dispatch, ownership passes to the
+ * claimant which has to release the bus from its callback.
+ * \return true if a pending claim was dispatched
+ */
+static bool PIOS_SPI_DispatchNextClaim(struct pios_spi_dev *spi_dev)
+{
+    void (*callback)(uint32_t spi_id) = NULL;
+
+    PIOS_IRQ_Disable();
+    if (spi_dev->claim_queue_count > 0) {
+        uint8_t best = 0;
+        for (uint8_t i = 1; i < spi_dev->claim_queue_count; i++) {
+            if (spi_dev->claim_queue[i].priority > spi_dev->claim_queue[best].priority) {
+                best = i;
+            }
+        }
+        callback = spi_dev->claim_queue[best].callback;
+        for (uint8_t i = best; i + 1u < spi_dev->claim_queue_count; i++) {
+            spi_dev->claim_queue[i] = spi_dev->claim_queue[i + 1];
+        }
+        spi_dev->claim_queue_count--;
+    }
+    PIOS_IRQ_Enable();
+
+    if (!callback) {
+        return false;
+    }
+
+    callback((uint32_t)spi_dev);
+    return true;
+}
+
 /**
  * Claim the SPI bus semaphore.  Calling the SPI functions does not require this
  * \param[in] spi SPI number (0 or 1)
@@ -315,6 +369,117 @@ int32_t PIOS_SPI_ClaimBusISR(uint32_t spi_id, bool *woken)
 #endif
 }
 
+/**
+ * Claim the SPI bus with a callback instead of waiting for it.
+ * If the bus is free the callback runs immediately in the caller context.
+ * Otherwise the claim is queued and the callback runs from whatever context
+ * releases the bus, higher priority claims first.  Either way the claimant
+ * owns the bus inside the callback and must release it from there.
+ * \param[in] spi SPI number (0 or 1)
+ * \param[in] callback function to run once the bus is claimed
+ * \param[in] priority claim priority, higher wins the bus first
+ * \return 0 if the callback ran or was queued
+ * \return -2 if the claim queue is full
+ */
+int32_t PIOS_SPI_ClaimBusCallback(uint32_t spi_id, void (*callback)(uint32_t spi_id), SPIClaimPrioTypeDef priority)
+{
+    struct pios_spi_dev *spi_dev = (struct pios_spi_dev *)spi_id;
+
+    bool valid = PIOS_SPI_validate(spi_dev);
+
+    PIOS_Assert(valid)
+    PIOS_Assert(callback)
+
+#if defined(PIOS_INCLUDE_FREERTOS)
+    if (xSemaphoreTake(spi_dev->busy, 0) == pdTRUE) {
+        callback(spi_id);
+        return 0;
+    }
+
+    int32_t queued = PIOS_SPI_QueueClaim(spi_dev, callback, priority);
+    if (queued != 0) {
+        return queued;
+    }
+
+    /* The bus may have gone idle between the failed take and the enqueue,
+     * in which case nobody is left to drain the queue */
+    if (xSemaphoreTake(spi_dev->busy, 0) == pdTRUE) {
+        if (!PIOS_SPI_DispatchNextClaim(spi_dev)) {
+            xSemaphoreGive(spi_dev->busy);
+        }
+    }
+    return 0;
+
+#else
+    PIOS_IRQ_Disable();
+    if (!spi_dev->busy) {
+        spi_dev->busy = 1;
+        PIOS_IRQ_Enable();
+        callback(spi_id);
+        return 0;
+    }
+    /* The check and the enqueue are atomic here, the release runs from ISR */
+    int32_t queued = PIOS_SPI_QueueClaim(spi_dev, callback, priority);
+    PIOS_IRQ_Enable();
+    return queued;
+
+#endif /* if defined(PIOS_INCLUDE_FREERTOS) */
+}
+
+/**
+ * Claim the SPI bus with a callback from an ISR, see PIOS_SPI_ClaimBusCallback.
+ * \param[in] spi SPI number (0 or 1)
+ * \param[in] callback function to run once the bus is claimed
+ * \param[in] priority claim priority, higher wins the bus first
+ * \param woken[in,out] If non-NULL, will be set to true if woken was false and a higher priority
+ *                      task has is now eligible to run, else unchanged
+ * \return 0 if the callback ran or was queued
+ * \return -2 if the claim queue is full
+ */
+int32_t PIOS_SPI_ClaimBusCallbackISR(uint32_t spi_id, void (*callback)(uint32_t spi_id), SPIClaimPrioTypeDef priority, bool *woken)
+{
+#if defined(PIOS_INCLUDE_FREERTOS)
+    struct pios_spi_dev *spi_dev = (struct pios_spi_dev *)spi_id;
+    signed portBASE_TYPE higherPriorityTaskWoken = pdFALSE;
+
+    bool valid = PIOS_SPI_validate(spi_dev);
+
+    PIOS_Assert(valid)
+    PIOS_Assert(callback)
+
+    if (xSemaphoreTakeFromISR(spi_dev->busy, &higherPriorityTaskWoken) == pdTRUE) {
+        if (woken) {
+            *woken = *woken || (higherPriorityTaskWoken == pdTRUE);
+        }
+        callback(spi_id);
+        return 0;
+    }
+
+    int32_t queued = PIOS_SPI_QueueClaim(spi_dev, callback, priority);
+    if (queued != 0) {
+        return queued;
+    }
+
+    /* Close the race between the failed take and the enqueue */
+    if (xSemaphoreTakeFromISR(spi_dev->busy, &higherPriorityTaskWoken) == pdTRUE) {
+        if (!PIOS_SPI_DispatchNextClaim(spi_dev)) {
+            xSemaphoreGiveFromISR(spi_dev->busy, &higherPriorityTaskWoken);
+        }
+    }
+    if (woken) {
+        *woken = *woken || (higherPriorityTaskWoken == pdTRUE);
+    }
+    return 0;
+
+#else
+    if (woken) {
+        *woken = false;
+    }
+    return PIOS_SPI_ClaimBusCallback(spi_id, callback, priority);
+
+#endif /* if defined(PIOS_INCLUDE_FREERTOS) */
+}
+
 /**
  * Release the SPI bus semaphore.  Calling the SPI functions does not require this
  * \param[in] spi SPI number (0 or 1)
@@ -328,9 +493,19 @@ int32_t PIOS_SPI_ReleaseBus(uint32_t spi_id)
     bool valid = PIOS_SPI_validate(spi_dev);
     PIOS_Assert(valid)
 
+    /* Hand the bus to the highest priority pending claim before freeing it */
+    if (PIOS_SPI_DispatchNextClaim(spi_dev)) {
+        return 0;
+    }
+
     xSemaphoreGive(spi_dev->busy);
 #else
     struct pios_spi_dev *spi_dev = (struct pios_spi_dev *)spi_id;
+
+    if (PIOS_SPI_DispatchNextClaim(spi_dev)) {
+        return 0;
+    }
+
     PIOS_IRQ_Disable();
     spi_dev->busy = 0;
     PIOS_IRQ_Enable();
@@ -354,6 +529,11 @@ int32_t PIOS_SPI_ReleaseBusISR(uint32_t spi_id, bool *woken)
     bool valid = PIOS_SPI_validate(spi_dev);
     PIOS_Assert(valid)
 
+    /* Hand the bus to the highest priority pending claim before freeing it */
+    if (PIOS_SPI_DispatchNextClaim(spi_dev)) {
+        return 0;
+    }
+
     xSemaphoreGiveFromISR(spi_dev->busy, &higherPriorityTaskWoken);
     if (woken) {
         *woken = *woken || (higherPriorityTaskWoken == pdTRUE);
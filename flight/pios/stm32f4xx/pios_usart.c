@@ -65,8 +65,14 @@ struct pios_usart_dev {
     uint32_t rx_in_context;
     pios_com_callback tx_out_cb;
     uint32_t tx_out_context;
+
+    /* circular DMA reception state, only used when cfg->dma_rx is set */
+    uint8_t  *dma_rx_buf;
+    uint16_t dma_rx_rd;
 };
 
+static bool PIOS_USART_dma_rx_drain(struct pios_usart_dev *usart_dev);
+
 static bool PIOS_USART_validate(struct pios_usart_dev *usart_dev)
 {
     return usart_dev->magic == PIOS_USART_DEV_MAGIC;
@@ -216,7 +222,28 @@ int32_t PIOS_USART_Init(uint32_t *usart_id, const struct pios_usart_cfg *cfg)
         break;
     }
     NVIC_Init((NVIC_InitTypeDef *)&(usart_dev->cfg->irq.init));
-    USART_ITConfig(usart_dev->cfg->regs, USART_IT_RXNE, ENABLE);
+    if (usart_dev->cfg->dma_rx) {
+        /* Receive through a circular DMA buffer and take one interrupt per
+         * frame (idle line) instead of one per byte */
+        const struct pios_usart_dma_rx_cfg *dma_rx = usart_dev->cfg->dma_rx;
+
+        usart_dev->dma_rx_buf = (uint8_t *)pios_malloc(dma_rx->buffer_size);
+        PIOS_Assert(usart_dev->dma_rx_buf);
+        usart_dev->dma_rx_rd  = 0;
+
+        DMA_InitTypeDef dma_init = dma_rx->rx.init;
+        dma_init.DMA_PeripheralBaseAddr = (uint32_t)&usart_dev->cfg->regs->DR;
+        dma_init.DMA_Memory0BaseAddr    = (uint32_t)usart_dev->dma_rx_buf;
+        dma_init.DMA_BufferSize         = dma_rx->buffer_size;
+        DMA_DeInit(dma_rx->rx.channel);
+        DMA_Init(dma_rx->rx.channel, &dma_init);
+        DMA_Cmd(dma_rx->rx.channel, ENABLE);
+
+        USART_DMACmd(usart_dev->cfg->regs, USART_DMAReq_Rx, ENABLE);
+        USART_ITConfig(usart_dev->cfg->regs, USART_IT_IDLE, ENABLE);
+    } else {
+        USART_ITConfig(usart_dev->cfg->regs, USART_IT_RXNE, ENABLE);
+    }
     USART_ITConfig(usart_dev->cfg->regs, USART_IT_TXE, ENABLE);
 
     // FIXME XXX Clear / reset uart here - sends NUL char else
@@ -238,6 +265,16 @@ static void PIOS_USART_RxStart(uint32_t usart_id, __attribute__((unused)) uint16
 
     PIOS_Assert(valid);
 
+    if (usart_dev->cfg->dma_rx) {
+        /* The DMA stream never stops; drain whatever it has deposited since
+         * the last idle interrupt so a saturated line without idle gaps
+         * cannot wrap the buffer while the consumer is reading */
+        PIOS_IRQ_Disable();
+        PIOS_USART_dma_rx_drain(usart_dev);
+        PIOS_IRQ_Enable();
+        return;
+    }
+
     USART_ITConfig(usart_dev->cfg->regs, USART_IT_RXNE, ENABLE);
 }
 static void PIOS_USART_TxStart(uint32_t usart_id, __attribute__((unused)) uint16_t tx_bytes_avail)
@@ -308,6 +345,35 @@ static void PIOS_USART_RegisterTxCallback(uint32_t usart_id, pios_com_callback t
     usart_dev->tx_out_cb = tx_out_cb;
 }
 
+/**
+ * Push the spans the DMA stream has written since the last drain into the
+ * com layer.  Runs from the idle line interrupt and, as a backstop, from
+ * rx_start with interrupts masked.
+ */
+static bool PIOS_USART_dma_rx_drain(struct pios_usart_dev *usart_dev)
+{
+    const struct pios_usart_dma_rx_cfg *dma_rx = usart_dev->cfg->dma_rx;
+    bool rx_need_yield = false;
+
+    /* NDTR counts down from buffer_size as the stream writes */
+    uint16_t wr = dma_rx->buffer_size - DMA_GetCurrDataCounter(dma_rx->rx.channel);
+
+    while (usart_dev->dma_rx_rd != wr) {
+        /* a wrapped region is posted as two contiguous spans */
+        uint16_t end = (wr > usart_dev->dma_rx_rd) ? wr : dma_rx->buffer_size;
+        uint16_t len = end - usart_dev->dma_rx_rd;
+        if (usart_dev->rx_in_cb) {
+            /* like the byte interrupt path, bytes the fifo cannot take are dropped */
+            (void)(usart_dev->rx_in_cb)(usart_dev->rx_in_context,
+                                        &usart_dev->dma_rx_buf[usart_dev->dma_rx_rd],
+                                        len, NULL, &rx_need_yield);
+        }
+        usart_dev->dma_rx_rd = (end >= dma_rx->buffer_size) ? 0 : end;
+    }
+
+    return rx_need_yield;
+}
+
 static void PIOS_USART_generic_irq_handler(uint32_t usart_id)
 {
     struct pios_usart_dev *usart_dev = (struct pios_usart_dev *)usart_id;
@@ -320,9 +386,15 @@ static void PIOS_USART_generic_irq_handler(uint32_t usart_id)
     volatile uint16_t sr = usart_dev->cfg->regs->SR;
     volatile uint8_t dr  = usart_dev->cfg->regs->DR;
 
-    /* Check if RXNE flag is set */
     bool rx_need_yield   = false;
-    if (sr & USART_SR_RXNE) {
+    if (usart_dev->cfg->dma_rx) {
+        /* Line went idle - post everything the DMA stream has collected.
+         * The sr/dr read sequence above already cleared the idle flag. */
+        if (sr & USART_SR_IDLE) {
+            rx_need_yield = PIOS_USART_dma_rx_drain(usart_dev);
+        }
+    } else if (sr & USART_SR_RXNE) {
+        /* Check if RXNE flag is set */
         uint8_t byte = dr;
         if (usart_dev->rx_in_cb) {
             (void)(usart_dev->rx_in_cb)(usart_dev->rx_in_context, &byte, 1, NULL, &rx_need_yield);
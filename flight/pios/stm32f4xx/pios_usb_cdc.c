@@ -56,6 +56,9 @@ enum pios_usb_cdc_dev_magic {
     PIOS_USB_CDC_DEV_MAGIC = 0xAABBCCDD,
 };
 
+/* Max-size packets chained into a single bulk IN transfer */
+#define PIOS_USB_CDC_TX_PACKETS 4
+
 struct pios_usb_cdc_dev {
     enum pios_usb_cdc_dev_magic   magic;
     const struct pios_usb_cdc_cfg *cfg;
@@ -74,12 +77,17 @@ struct pios_usb_cdc_dev {
     volatile bool rx_active;
 
     /*
-     * NOTE: This is -1 as somewhat of a hack.  It ensures that we always send packets
-     * that are strictly < maxPacketSize for this interface which means we never have
-     * to bother with zero length packets (ZLP).
+     * The OTG core splits a bulk IN transfer into max-size packets in
+     * hardware, so queueing several packets worth of fifo data at once
+     * costs a single transfer-complete interrupt instead of one per
+     * packet.  See PIOS_USB_CDC_SendData() for how transfers are kept
+     * strictly short of a whole number of packets so we never have to
+     * bother with zero length packets (ZLP).
      */
-    uint8_t  tx_packet_buffer[PIOS_USB_BOARD_CDC_DATA_LENGTH - 1] __attribute__((aligned(4)));
+    uint8_t  tx_packet_buffer[PIOS_USB_CDC_TX_PACKETS * PIOS_USB_BOARD_CDC_DATA_LENGTH] __attribute__((aligned(4)));
     volatile bool tx_active;
+    uint8_t  tx_carry_byte;
+    bool     tx_carry;
 
     uint8_t  ctrl_tx_packet_buffer[PIOS_USB_BOARD_CDC_MGMT_LENGTH] __attribute__((aligned(4)));
 
@@ -181,6 +189,7 @@ int32_t PIOS_USB_CDC_Init(uint32_t *usbcdc_id, const struct pios_usb_cdc_cfg *cf
     /* Rx and Tx are not active yet */
     usb_cdc_dev->rx_active           = false;
     usb_cdc_dev->tx_active           = false;
+    usb_cdc_dev->tx_carry            = false;
 
     /* Clear stats */
     usb_cdc_dev->rx_dropped          = 0;
@@ -214,14 +223,32 @@ static bool PIOS_USB_CDC_SendData(struct pios_usb_cdc_dev *usb_cdc_dev)
     }
 
     bool need_yield = false;
-    bytes_to_tx = (usb_cdc_dev->tx_out_cb)(usb_cdc_dev->tx_out_context,
-                                           usb_cdc_dev->tx_packet_buffer,
-                                           sizeof(usb_cdc_dev->tx_packet_buffer),
-                                           NULL,
-                                           &need_yield);
+    /* Re-queue the byte held back from the previous transfer, if any */
+    bytes_to_tx = 0;
+    if (usb_cdc_dev->tx_carry) {
+        usb_cdc_dev->tx_packet_buffer[bytes_to_tx++] = usb_cdc_dev->tx_carry_byte;
+    }
+    bytes_to_tx += (usb_cdc_dev->tx_out_cb)(usb_cdc_dev->tx_out_context,
+                                            &usb_cdc_dev->tx_packet_buffer[bytes_to_tx],
+                                            sizeof(usb_cdc_dev->tx_packet_buffer) - bytes_to_tx,
+                                            NULL,
+                                            &need_yield);
     if (bytes_to_tx == 0) {
         return false;
     }
+    usb_cdc_dev->tx_carry = false;
+
+    /*
+     * Make sure every transfer ends in a short packet so the host never
+     * sits on buffered data waiting for more: when the fifo handed us an
+     * exact multiple of the packet size, hold one byte back for the next
+     * transfer instead of terminating with a ZLP.
+     */
+    if ((bytes_to_tx % PIOS_USB_BOARD_CDC_DATA_LENGTH) == 0) {
+        bytes_to_tx--;
+        usb_cdc_dev->tx_carry_byte = usb_cdc_dev->tx_packet_buffer[bytes_to_tx];
+        usb_cdc_dev->tx_carry      = true;
+    }
 
     /*
      * Mark this endpoint as being tx active _before_ actually transmitting
@@ -551,9 +578,14 @@ static void PIOS_USB_CDC_DATA_IF_Init(uint32_t usb_cdc_id)
         return;
     }
 
-    /* Register endpoint specific callbacks with the USBHOOK layer */
+    /*
+     * Register endpoint specific callbacks with the USBHOOK layer.  The
+     * length given here is the wire max packet size the endpoint is
+     * opened with (matching the descriptor), not the size of our tx
+     * buffer - a transfer may span several packets.
+     */
     PIOS_USBHOOK_RegisterEpInCallback(usb_cdc_dev->cfg->data_tx_ep,
-                                      sizeof(usb_cdc_dev->tx_packet_buffer),
+                                      PIOS_USB_BOARD_CDC_DATA_LENGTH,
                                       PIOS_USB_CDC_DATA_EP_IN_Callback,
                                       (uint32_t)usb_cdc_dev);
     PIOS_USBHOOK_RegisterEpOutCallback(usb_cdc_dev->cfg->data_rx_ep,
@@ -54,6 +54,18 @@ enum pios_usb_hid_dev_magic {
     PIOS_USB_HID_DEV_MAGIC = 0xAA00BB00,
 };
 
+/*
+ * Number of reports chained into one IN transfer.  The OTG core splits
+ * the buffer into max-packet sized packets by itself, so one completion
+ * interrupt covers this many reports worth of data.  The bootloader HID
+ * protocol is lockstep and must stay at one report per transfer.
+ */
+#ifdef PIOS_USB_BOARD_BL_HID_HAS_NO_LENGTH_BYTE
+#define PIOS_USB_HID_TX_REPORTS 1
+#else
+#define PIOS_USB_HID_TX_REPORTS 4
+#endif
+
 struct pios_usb_hid_dev {
     enum pios_usb_hid_dev_magic   magic;
     const struct pios_usb_hid_cfg *cfg;
@@ -70,7 +82,7 @@ struct pios_usb_hid_dev {
     uint8_t  rx_packet_buffer[PIOS_USB_BOARD_HID_DATA_LENGTH] __attribute__((aligned(4)));
     volatile bool rx_active;
 
-    uint8_t  tx_packet_buffer[PIOS_USB_BOARD_HID_DATA_LENGTH] __attribute__((aligned(4)));
+    uint8_t  tx_packet_buffer[PIOS_USB_HID_TX_REPORTS * PIOS_USB_BOARD_HID_DATA_LENGTH] __attribute__((aligned(4)));
     volatile bool tx_active;
 
     uint32_t rx_dropped;
@@ -182,27 +194,47 @@ void PIOS_USB_HID_RegisterHidReport(const uint8_t *desc, uint16_t length)
 
 static bool PIOS_USB_HID_SendReport(struct pios_usb_hid_dev *usb_hid_dev)
 {
-    uint16_t bytes_to_tx;
-
     if (!usb_hid_dev->tx_out_cb) {
         return false;
     }
     READ_MEMORY_BARRIER();
     bool need_yield = false;
+    uint8_t reports = 0;
+
+    /*
+     * Chain as many reports as the COM fifo can fill.  Each report keeps
+     * its own ID and length byte so the host parses them unchanged, but
+     * the whole chain goes out as a single transfer.
+     */
+    while (reports < PIOS_USB_HID_TX_REPORTS) {
+        uint8_t *report = &usb_hid_dev->tx_packet_buffer[reports * PIOS_USB_BOARD_HID_DATA_LENGTH];
+        uint16_t bytes_to_tx;
 #ifdef PIOS_USB_BOARD_BL_HID_HAS_NO_LENGTH_BYTE
-    bytes_to_tx = (usb_hid_dev->tx_out_cb)(usb_hid_dev->tx_out_context,
-                                           &usb_hid_dev->tx_packet_buffer[1],
-                                           sizeof(usb_hid_dev->tx_packet_buffer) - 1,
-                                           NULL,
-                                           &need_yield);
+        bytes_to_tx = (usb_hid_dev->tx_out_cb)(usb_hid_dev->tx_out_context,
+                                               &report[1],
+                                               PIOS_USB_BOARD_HID_DATA_LENGTH - 1,
+                                               NULL,
+                                               &need_yield);
 #else
-    bytes_to_tx = (usb_hid_dev->tx_out_cb)(usb_hid_dev->tx_out_context,
-                                           &usb_hid_dev->tx_packet_buffer[2],
-                                           sizeof(usb_hid_dev->tx_packet_buffer) - 2,
-                                           NULL,
-                                           &need_yield);
+        bytes_to_tx = (usb_hid_dev->tx_out_cb)(usb_hid_dev->tx_out_context,
+                                               &report[2],
+                                               PIOS_USB_BOARD_HID_DATA_LENGTH - 2,
+                                               NULL,
+                                               &need_yield);
+#endif
+        if (bytes_to_tx == 0) {
+            break;
+        }
+
+        /* Always set type as report ID */
+        report[0] = 1;
+#ifndef PIOS_USB_BOARD_BL_HID_HAS_NO_LENGTH_BYTE
+        report[1] = bytes_to_tx;
 #endif
-    if (bytes_to_tx == 0) {
+        reports++;
+    }
+
+    if (reports == 0) {
         return false;
     }
 
@@ -212,19 +244,9 @@ static bool PIOS_USB_HID_SendReport(struct pios_usb_hid_dev *usb_hid_dev)
      */
     usb_hid_dev->tx_active = true;
 
-    /* Always set type as report ID */
-    usb_hid_dev->tx_packet_buffer[0] = 1;
-
-#ifdef PIOS_USB_BOARD_BL_HID_HAS_NO_LENGTH_BYTE
     PIOS_USBHOOK_EndpointTx(usb_hid_dev->cfg->data_tx_ep,
                             usb_hid_dev->tx_packet_buffer,
-                            sizeof(usb_hid_dev->tx_packet_buffer));
-#else
-    usb_hid_dev->tx_packet_buffer[1] = bytes_to_tx;
-    PIOS_USBHOOK_EndpointTx(usb_hid_dev->cfg->data_tx_ep,
-                            usb_hid_dev->tx_packet_buffer,
-                            sizeof(usb_hid_dev->tx_packet_buffer));
-#endif
+                            reports * PIOS_USB_BOARD_HID_DATA_LENGTH);
 
 #if defined(PIOS_INCLUDE_FREERTOS)
     if (need_yield) {
@@ -332,9 +354,11 @@ static void PIOS_USB_HID_IF_Init(uint32_t usb_hid_id)
         return;
     }
 
-    /* Register endpoint specific callbacks with the USBHOOK layer */
+    /* Register endpoint specific callbacks with the USBHOOK layer.
+     * The endpoint max packet size stays one report long, the chained
+     * tx buffer is split into packets by the OTG core. */
     PIOS_USBHOOK_RegisterEpInCallback(usb_hid_dev->cfg->data_tx_ep,
-                                      sizeof(usb_hid_dev->tx_packet_buffer),
+                                      PIOS_USB_BOARD_HID_DATA_LENGTH,
                                       PIOS_USB_HID_EP_IN_Callback,
                                       (uint32_t)usb_hid_dev);
     PIOS_USBHOOK_RegisterEpOutCallback(usb_hid_dev->cfg->data_rx_ep,
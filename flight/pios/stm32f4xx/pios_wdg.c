@@ -49,6 +49,14 @@ static struct wdg_configuration {
     uint16_t bootup_flags;
 } wdg_configuration;
 
+/*
+ * RAM mirror of the active flags.  Every UpdateFlag call used to read and
+ * write the RTC backup register; now flags aggregate in this word with a
+ * single atomic or, and the slow backup register is only written when a
+ * bit actually transitions so the post-reset diagnostics stay intact.
+ */
+static volatile uint32_t wdg_active_flags;
+
 /**
  * @brief Initialize the watchdog timer for a specified timeout
  *
@@ -84,6 +92,8 @@ uint16_t PIOS_WDG_Init()
     PWR_BackupAccessCmd(ENABLE);
 
     wdg_configuration.bootup_flags = RTC_ReadBackupRegister(PIOS_WDG_REGISTER);
+    /* start this boot's diagnostics clean, the RAM mirror is zeroed by bss init */
+    RTC_WriteBackupRegister(PIOS_WDG_REGISTER, 0);
 #endif
     return delay;
 }
@@ -108,13 +118,10 @@ bool PIOS_WDG_RegisterFlag(uint16_t flag_requested)
     PIOS_WDG_Clear();
 
     /* Fail if flag already registered */
-    if (wdg_configuration.used_flags & flag_requested) {
+    if (__sync_fetch_and_or(&wdg_configuration.used_flags, flag_requested) & flag_requested) {
         return false;
     }
 
-    // FIXME: Protect with semaphore
-    wdg_configuration.used_flags |= flag_requested;
-
     return true;
 }
 
@@ -130,20 +137,22 @@ bool PIOS_WDG_RegisterFlag(uint16_t flag_requested)
  */
 bool PIOS_WDG_UpdateFlag(uint16_t flag)
 {
-    // we can probably avoid using a semaphore here which will be good for
-    // efficiency and not blocking critical tasks.  race condition could
-    // overwrite their flag update, but unlikely to block _all_ of them
-    // for the timeout window
-    uint16_t cur_flags = RTC_ReadBackupRegister(PIOS_WDG_REGISTER);
+    uint32_t prev_flags = __sync_fetch_and_or(&wdg_active_flags, flag);
+    uint32_t cur_flags  = prev_flags | flag;
 
-    if ((cur_flags | flag) == wdg_configuration.used_flags) {
+    if (cur_flags == wdg_configuration.used_flags) {
         PIOS_WDG_Clear();
+        /* keep any bit another task set since we read; losing a
+         * concurrent update only delays that task by one loop */
+        __sync_and_and_fetch(&wdg_active_flags, flag);
         RTC_WriteBackupRegister(PIOS_WDG_REGISTER, flag);
         return true;
-    } else {
-        RTC_WriteBackupRegister(PIOS_WDG_REGISTER, cur_flags | flag);
-        return false;
     }
+    if (prev_flags != cur_flags) {
+        /* a bit transitioned, persist for post-reset diagnostics */
+        RTC_WriteBackupRegister(PIOS_WDG_REGISTER, cur_flags);
+    }
+    return false;
 }
 
 /**
@@ -168,7 +177,7 @@ uint16_t PIOS_WDG_GetBootupFlags()
  */
 uint16_t PIOS_WDG_GetActiveFlags()
 {
-    return RTC_ReadBackupRegister(PIOS_WDG_REGISTER);
+    return wdg_active_flags;
 }
 
 /**
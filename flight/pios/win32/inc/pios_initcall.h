@@ -39,6 +39,7 @@
  */
 
 #define MODULE_INITCALL(ifn, sfn)
+#define MODULE_INITCALL_DEFERRED(ifn, sfn)
 
 #define MODULE_TASKCREATE_ALL
 
@@ -50,6 +51,8 @@
         /* Initialize the system thread */ \
         SystemModInitialize(); }
 
+#define MODULE_INITIALISE_DEFERRED
+
 
 #endif /* PIOS_INITCALL_H */
 
@@ -117,6 +117,9 @@
 /* #define LOG_FILENAME "startup.log" */
 #define PIOS_INCLUDE_FLASH
 #define PIOS_INCLUDE_FLASH_LOGFS_SETTINGS
+/* Keep settings objects in flash until first write, RAM is what decides
+ * which modules fit on this target */
+#define PIOS_UAVOBJ_FLASH_SETTINGS
 /* #define FLASH_FREERTOS */
 /* #define PIOS_INCLUDE_FLASH_EEPROM */
 /* #define PIOS_INCLUDE_FLASH_INTERNAL */
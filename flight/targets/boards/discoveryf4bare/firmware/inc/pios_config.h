@@ -56,6 +56,15 @@
 #define PIOS_INCLUDE_SYS
 #define PIOS_INCLUDE_TASK_MONITOR
 
+/* PIOS size class memory pools */
+#define PIOS_INCLUDE_MEM_POOLS
+
+/* PIOS COM port statistics and tx rate shaping */
+#define PIOS_INCLUDE_COM_STATS
+
+/* PIOS receiver frame timing statistics */
+#define PIOS_INCLUDE_RCVR_STATS
+
 #define PIOS_INSTRUMENTATION_MAX_COUNTERS 10
 #define PIOS_INCLUDE_INSTRUMENTATION
 
@@ -65,6 +74,7 @@
 #define PIOS_INCLUDE_TIM
 #define PIOS_INCLUDE_USART
 #define PIOS_INCLUDE_ADC
+#define PIOS_ADC_PROVIDES_COULOMB_COUNTER
 #define PIOS_INCLUDE_I2C
 #define PIOS_INCLUDE_SPI
 #define PIOS_INCLUDE_GPIO
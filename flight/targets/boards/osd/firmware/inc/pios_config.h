@@ -62,6 +62,7 @@
 #define PIOS_INCLUDE_TIM
 #define PIOS_INCLUDE_USART
 #define PIOS_INCLUDE_ADC
+#define PIOS_ADC_PROVIDES_COULOMB_COUNTER
 #define PIOS_INCLUDE_I2C
 #define PIOS_INCLUDE_SPI
 #define PIOS_INCLUDE_GPIO
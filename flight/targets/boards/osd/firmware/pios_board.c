@@ -94,7 +94,8 @@ static void Clock(uint32_t spektrum_id);
 #define PIOS_COM_GPS_RX_BUF_LEN       32
 
 #define PIOS_COM_TELEM_USB_RX_BUF_LEN 65
-#define PIOS_COM_TELEM_USB_TX_BUF_LEN 65
+// Four chained USB packets plus the byte the fifo keeps free
+#define PIOS_COM_TELEM_USB_TX_BUF_LEN 257
 
 #define PIOS_COM_BRIDGE_RX_BUF_LEN    65
 #define PIOS_COM_BRIDGE_TX_BUF_LEN    12
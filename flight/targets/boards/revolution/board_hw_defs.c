@@ -726,6 +726,27 @@ static const struct flashfs_logfs_cfg flashfs_internal_cfg = {
 /*
  * MAIN USART
  */
+static const struct pios_usart_dma_rx_cfg pios_usart_main_dma_rx_cfg = {
+    .rx                      = {
+        .channel             = DMA2_Stream2,
+        .init                = {
+            .DMA_Channel     = DMA_Channel_4,
+            .DMA_DIR         = DMA_DIR_PeripheralToMemory,
+            .DMA_PeripheralInc      = DMA_PeripheralInc_Disable,
+            .DMA_MemoryInc   = DMA_MemoryInc_Enable,
+            .DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte,
+            .DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte,
+            .DMA_Mode        = DMA_Mode_Circular,
+            .DMA_Priority    = DMA_Priority_Medium,
+            .DMA_FIFOMode    = DMA_FIFOMode_Disable,
+            .DMA_FIFOThreshold      = DMA_FIFOThreshold_Full,
+            .DMA_MemoryBurst = DMA_MemoryBurst_Single,
+            .DMA_PeripheralBurst    = DMA_PeripheralBurst_Single,
+        },
+    },
+    .buffer_size = 128,
+};
+
 static const struct pios_usart_cfg pios_usart_main_cfg = {
     .regs  = USART1,
     .remap = GPIO_AF_USART1,
@@ -765,6 +786,7 @@ static const struct pios_usart_cfg pios_usart_main_cfg = {
             .GPIO_PuPd  = GPIO_PuPd_UP
         },
     },
+    .dma_rx                                    = &pios_usart_main_dma_rx_cfg,
 };
 #endif /* PIOS_INCLUDE_COM_TELEM */
 
@@ -904,6 +926,27 @@ static const struct pios_sbus_cfg pios_sbus_cfg = {
 /*
  * FLEXI PORT
  */
+static const struct pios_usart_dma_rx_cfg pios_usart_flexi_dma_rx_cfg = {
+    .rx                      = {
+        .channel             = DMA1_Stream1,
+        .init                = {
+            .DMA_Channel     = DMA_Channel_4,
+            .DMA_DIR         = DMA_DIR_PeripheralToMemory,
+            .DMA_PeripheralInc      = DMA_PeripheralInc_Disable,
+            .DMA_MemoryInc   = DMA_MemoryInc_Enable,
+            .DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte,
+            .DMA_MemoryDataSize     = DMA_MemoryDataSize_Byte,
+            .DMA_Mode        = DMA_Mode_Circular,
+            .DMA_Priority    = DMA_Priority_Medium,
+            .DMA_FIFOMode    = DMA_FIFOMode_Disable,
+            .DMA_FIFOThreshold      = DMA_FIFOThreshold_Full,
+            .DMA_MemoryBurst = DMA_MemoryBurst_Single,
+            .DMA_PeripheralBurst    = DMA_PeripheralBurst_Single,
+        },
+    },
+    .buffer_size = 128,
+};
+
 static const struct pios_usart_cfg pios_usart_flexi_cfg = {
     .regs  = USART3,
     .remap = GPIO_AF_USART3,
@@ -944,6 +987,7 @@ static const struct pios_usart_cfg pios_usart_flexi_cfg = {
             .GPIO_PuPd  = GPIO_PuPd_UP
         },
     },
+    .dma_rx                                    = &pios_usart_flexi_dma_rx_cfg,
 };
 
 #endif /* PIOS_INCLUDE_COM_FLEXI */
@@ -56,6 +56,15 @@
 #define PIOS_INCLUDE_SYS
 #define PIOS_INCLUDE_TASK_MONITOR
 
+/* PIOS size class memory pools */
+#define PIOS_INCLUDE_MEM_POOLS
+
+/* PIOS COM port statistics and tx rate shaping */
+#define PIOS_INCLUDE_COM_STATS
+
+/* PIOS receiver frame timing statistics */
+#define PIOS_INCLUDE_RCVR_STATS
+
 #define PIOS_INCLUDE_INSTRUMENTATION
 #define PIOS_INSTRUMENTATION_MAX_COUNTERS 10
 
@@ -65,6 +74,7 @@
 #define PIOS_INCLUDE_TIM
 #define PIOS_INCLUDE_USART
 #define PIOS_INCLUDE_ADC
+#define PIOS_ADC_PROVIDES_COULOMB_COUNTER
 #define PIOS_INCLUDE_I2C
 #define PIOS_INCLUDE_SPI
 #define PIOS_INCLUDE_GPIO
@@ -155,6 +165,9 @@
 /* Performance counters */
 #define IDLE_COUNTS_PER_SEC_AT_NO_LOAD 8379692
 
+/* UAVObject storage arena (single contiguous heap carve-out) */
+#define PIOS_UAVOBJ_ARENA_SIZE         (20 * 1024)
+
 /* Alarm Thresholds */
 #define HEAP_LIMIT_WARNING             1000
 #define HEAP_LIMIT_CRITICAL            500
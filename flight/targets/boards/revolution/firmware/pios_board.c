@@ -223,7 +223,8 @@ uint32_t pios_rcvr_group_map[MANUALCONTROLSETTINGS_CHANNELGROUPS_NONE];
 #define PIOS_COM_GPS_TX_BUF_LEN          32
 
 #define PIOS_COM_TELEM_USB_RX_BUF_LEN    65
-#define PIOS_COM_TELEM_USB_TX_BUF_LEN    65
+// Four chained USB packets plus the byte the fifo keeps free
+#define PIOS_COM_TELEM_USB_TX_BUF_LEN    257
 
 #define PIOS_COM_BRIDGE_RX_BUF_LEN       65
 #define PIOS_COM_BRIDGE_TX_BUF_LEN       12
@@ -927,6 +928,8 @@ void PIOS_Board_Init(void)
 
 #if defined(PIOS_INCLUDE_HMC5X83)
     onboard_mag = PIOS_HMC5x83_Init(&pios_hmc5x83_cfg, pios_i2c_mag_pressure_adapter_id, 0);
+    // Let the DRDY line drive oversampled reads through the async I2C queue
+    PIOS_HMC5x83_AsyncStart(onboard_mag);
 #endif
 
 #if defined(PIOS_INCLUDE_MS5611)
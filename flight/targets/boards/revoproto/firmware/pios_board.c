@@ -294,7 +294,8 @@ uint32_t pios_rcvr_group_map[MANUALCONTROLSETTINGS_CHANNELGROUPS_NONE];
 #define PIOS_COM_GPS_RX_BUF_LEN       32
 
 #define PIOS_COM_TELEM_USB_RX_BUF_LEN 65
-#define PIOS_COM_TELEM_USB_TX_BUF_LEN 65
+// Four chained USB packets plus the byte the fifo keeps free
+#define PIOS_COM_TELEM_USB_TX_BUF_LEN 257
 
 #define PIOS_COM_BRIDGE_RX_BUF_LEN    65
 #define PIOS_COM_BRIDGE_TX_BUF_LEN    12
@@ -0,0 +1,35 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+/* Just enough of the FreeRTOS API for uavtalk.c to compile and run
+ * single threaded on the host.  The semaphore calls degenerate to
+ * always-succeeding no-ops; the benchmark runner is the only task. */
+
+#include <stdint.h>
+
+typedef uint32_t portTickType;
+typedef void     *xSemaphoreHandle;
+
+#define portMAX_DELAY                 ((portTickType)0xFFFFFFFF)
+#define portTICK_RATE_MS              1
+#define pdTRUE                        1
+#define pdFALSE                       0
+
+xSemaphoreHandle ut_sem_create(void);
+portTickType xTaskGetTickCount(void);
+
+/* a function call (unlike a bare constant) can be used both as a
+ * statement and in a condition without tripping -Werror=unused-value */
+static inline int ut_sem_noop(void)
+{
+    return pdTRUE;
+}
+
+#define xSemaphoreCreateRecursiveMutex() ut_sem_create()
+#define vSemaphoreCreateBinary(sem)     ((sem) = ut_sem_create())
+#define xSemaphoreTake(sem, timeout)          ut_sem_noop()
+#define xSemaphoreGive(sem)                   ut_sem_noop()
+#define xSemaphoreTakeRecursive(sem, timeout) ut_sem_noop()
+#define xSemaphoreGiveRecursive(sem)          ut_sem_noop()
+
+#endif /* FREERTOS_H */
@@ -0,0 +1,19 @@
+#ifndef BENCHMARK_BASELINES_H
+#define BENCHMARK_BASELINES_H
+
+/* Recorded kernel-to-calibration time ratios.  These are what the
+ * benchmark tests enforce against when UT_BENCH_ENFORCE=1 is set (on
+ * the reference machine they were recorded on; elsewhere the ratios
+ * are only reported), with the tolerance defined in unittest.cpp.
+ * Re-record after an intentional performance change:
+ *     UT_BENCH_RECORD=1 make ut_benchmark_run
+ * and paste the printed values here.  Record on an idle machine and
+ * keep the worst of a few runs so normal scheduler jitter passes. */
+
+#define BENCH_BASELINE_INSGPS      2.48
+#define BENCH_BASELINE_INSGPS16    3.13 /* build with USE_INS16=YES */
+#define BENCH_BASELINE_PID         3.46
+#define BENCH_BASELINE_COORDINATES 3.60
+#define BENCH_BASELINE_UAVTALK     3.50
+
+#endif /* BENCHMARK_BASELINES_H */
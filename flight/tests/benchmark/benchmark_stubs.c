@@ -0,0 +1,112 @@
+/**
+ ******************************************************************************
+ * @file       benchmark_stubs.c
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @brief      Host side stubs backing the benchmark suite
+ *
+ * Implements the object manager and FreeRTOS entry points that
+ * uavtalk.c links against, on top of a single synthetic 64 byte
+ * object.  This keeps the parser exercising its real code paths
+ * (lookup, length validation, unpack) without dragging the whole
+ * object manager into the host build.
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "openpilot.h"
+#include "pios.h"
+#include "benchmark_stubs.h"
+
+static uint8_t benchObjData[BENCH_OBJ_NUM_BYTES];
+
+UAVObjHandle UAVObjGetByID(uint32_t id)
+{
+    return (id == BENCH_OBJ_ID) ? (UAVObjHandle)benchObjData : NULL;
+}
+
+uint32_t UAVObjGetID(__attribute__((unused)) UAVObjHandle obj)
+{
+    return BENCH_OBJ_ID;
+}
+
+uint32_t UAVObjGetNumBytes(__attribute__((unused)) UAVObjHandle obj)
+{
+    return BENCH_OBJ_NUM_BYTES;
+}
+
+uint16_t UAVObjGetNumInstances(__attribute__((unused)) UAVObjHandle obj)
+{
+    return 1;
+}
+
+bool UAVObjIsSingleInstance(__attribute__((unused)) UAVObjHandle obj)
+{
+    return true;
+}
+
+int32_t UAVObjUnpack(__attribute__((unused)) UAVObjHandle obj_handle, uint16_t instId, const uint8_t *dataIn)
+{
+    if (instId != 0) {
+        return -1;
+    }
+    memcpy(benchObjData, dataIn, BENCH_OBJ_NUM_BYTES);
+    return 0;
+}
+
+int32_t UAVObjPack(__attribute__((unused)) UAVObjHandle obj_handle, uint16_t instId, uint8_t *dataOut)
+{
+    if (instId != 0) {
+        return -1;
+    }
+    memcpy(dataOut, benchObjData, BENCH_OBJ_NUM_BYTES);
+    return 0;
+}
+
+int32_t UAVObjStreamInstanceData(__attribute__((unused)) UAVObjHandle obj_handle, uint16_t instId, UAVObjStreamWriter writer, uint8_t *crc)
+{
+    if (instId != 0) {
+        return -1;
+    }
+    *crc = PIOS_CRC_updateCRC(*crc, benchObjData, BENCH_OBJ_NUM_BYTES);
+    if (writer(benchObjData, BENCH_OBJ_NUM_BYTES) != BENCH_OBJ_NUM_BYTES) {
+        return -1;
+    }
+    return BENCH_OBJ_NUM_BYTES;
+}
+
+int32_t UAVObjSetInstanceDataField(__attribute__((unused)) UAVObjHandle obj_handle, uint16_t instId, const void *dataIn, uint32_t offset, uint32_t size)
+{
+    if (instId != 0 || offset + size > BENCH_OBJ_NUM_BYTES) {
+        return -1;
+    }
+    memcpy(&benchObjData[offset], dataIn, size);
+    return 0;
+}
+
+xSemaphoreHandle ut_sem_create(void)
+{
+    return malloc(1);
+}
+
+portTickType xTaskGetTickCount(void)
+{
+    static portTickType tick;
+
+    return ++tick;
+}
@@ -0,0 +1,8 @@
+#ifndef BENCHMARK_STUBS_H
+#define BENCHMARK_STUBS_H
+
+/* The single synthetic object the stubbed object manager serves */
+#define BENCH_OBJ_ID        0xB55D1234
+#define BENCH_OBJ_NUM_BYTES 64
+
+#endif /* BENCHMARK_STUBS_H */
@@ -0,0 +1,23 @@
+#ifndef OPENPILOT_H
+#define OPENPILOT_H
+
+/* Minimal stand-in for the firmware openpilot.h, just enough to host
+ * the benchmarked kernels on the native toolchain. */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "pios.h"
+#include "FreeRTOS.h"
+#include "pios_mem.h"
+#include "uavobjectmanager.h"
+#include "uavtalk.h"
+
+#define PIOS_Assert(x) \
+    if (!(x)) { while (1) {; } \
+    }
+#define PIOS_DEBUG_Assert(x) PIOS_Assert(x)
+
+#endif /* OPENPILOT_H */
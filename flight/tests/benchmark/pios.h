@@ -0,0 +1,11 @@
+#ifndef PIOS_H
+#define PIOS_H
+
+/* Host stand-in for the firmware pios.h, used to compile pios_crc.c */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <pios_crc.h>
+
+#endif /* PIOS_H */
@@ -0,0 +1,26 @@
+#ifndef UAVOBJECTMANAGER_H
+#define UAVOBJECTMANAGER_H
+
+/* Cut down object manager interface backed by a single synthetic test
+ * object (see benchmark_stubs.c).  Only the entry points uavtalk.c
+ * links against are declared. */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UAVOBJ_ALL_INSTANCES 0xFFFF
+
+typedef void *UAVObjHandle;
+typedef int32_t (*UAVObjStreamWriter)(uint8_t *data, int32_t length);
+
+UAVObjHandle UAVObjGetByID(uint32_t id);
+uint32_t UAVObjGetID(UAVObjHandle obj);
+uint32_t UAVObjGetNumBytes(UAVObjHandle obj);
+uint16_t UAVObjGetNumInstances(UAVObjHandle obj);
+bool UAVObjIsSingleInstance(UAVObjHandle obj);
+int32_t UAVObjUnpack(UAVObjHandle obj_handle, uint16_t instId, const uint8_t *dataIn);
+int32_t UAVObjPack(UAVObjHandle obj_handle, uint16_t instId, uint8_t *dataOut);
+int32_t UAVObjStreamInstanceData(UAVObjHandle obj_handle, uint16_t instId, UAVObjStreamWriter writer, uint8_t *crc);
+int32_t UAVObjSetInstanceDataField(UAVObjHandle obj_handle, uint16_t instId, const void *dataIn, uint32_t offset, uint32_t size);
+
+#endif /* UAVOBJECTMANAGER_H */
@@ -0,0 +1,9 @@
+#ifndef UAVOBJECTSINIT_H
+#define UAVOBJECTSINIT_H
+
+/* The generated uavobjectsinit.h provides the size of the largest
+ * registered object.  The benchmark object set is a single 64 byte
+ * object, but keep the buffer sizing realistic for a flight build. */
+#define UAVOBJECTS_LARGEST 256
+
+#endif /* UAVOBJECTSINIT_H */
@@ -0,0 +1,314 @@
+/**
+ ******************************************************************************
+ * @file       unittest.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @brief      Performance regression tests for the flight hot-path kernels
+ *
+ * Times the EKF, PID, coordinate conversion and UAVTalk parser kernels
+ * on the host and compares against recorded baselines.  Host speed is
+ * factored out by normalizing every kernel time to a fixed calibration
+ * workload measured in the same process, so the enforced quantity is a
+ * dimensionless ratio that is stable across machines of the same
+ * architecture class.  The ratios are always reported; with
+ * UT_BENCH_ENFORCE=1 set (for the reference machine the baselines were
+ * recorded on) a kernel additionally fails when its ratio regresses
+ * more than BENCH_TOLERANCE over the recorded baseline, so the default
+ * all_ut_run stays deterministic on arbitrary hosts.
+ *
+ * To re-record baselines after an intentional change:
+ *     UT_BENCH_RECORD=1 make ut_benchmark_run
+ * and copy the printed table into benchmark_baselines.h.
+ *
+ * @see        The GNU Public License (GPL) Version 3
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+extern "C" {
+#include "openpilot.h"
+#include "pios.h"
+#include "insgps.h"
+#include "pid.h"
+#include "CoordinateConversions.h"
+#include "benchmark_stubs.h"
+}
+
+#include "benchmark_baselines.h"
+
+// Allowed slowdown over the recorded baseline before a test fails
+#define BENCH_TOLERANCE 0.05
+
+// Timing repetitions; the minimum is reported to reject scheduler noise
+#define BENCH_REPS      7
+
+static double now_seconds()
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+}
+
+// Sink keeping the optimizer from deleting kernel results
+static volatile float bench_sink;
+
+// Fixed mixed integer/float workload used as the unit of time.  Any
+// change here invalidates every recorded baseline.
+static void calibration_kernel()
+{
+    float acc = 0.0f;
+    uint32_t lcg = 1;
+
+    for (int iter = 0; iter < 8000; iter++) {
+        float buf[512];
+        for (int i = 0; i < 512; i++) {
+            lcg    = lcg * 1664525 + 1013904223;
+            buf[i] = (float)(lcg >> 16) * (1.0f / 65536.0f);
+        }
+        for (int i = 2; i < 512; i++) {
+            acc += buf[i] * 0.5f - buf[i - 1] * 0.25f + buf[i - 2] * 0.125f;
+        }
+    }
+    bench_sink = acc;
+}
+
+// Best-of-N ratio of kernel time to calibration time.  The two are
+// measured back to back within every repetition so transient load on a
+// shared CI host cancels out instead of skewing the ratio.
+static double bench_ratio(void (*kernel)(void))
+{
+    double best_kernel = 0.0;
+    double best_cal    = 0.0;
+
+    for (int rep = 0; rep < BENCH_REPS; rep++) {
+        double t0 = now_seconds();
+        calibration_kernel();
+        double t1 = now_seconds();
+        kernel();
+        double t2 = now_seconds();
+
+        if (rep == 0 || (t1 - t0) < best_cal) {
+            best_cal = t1 - t0;
+        }
+        if (rep == 0 || (t2 - t1) < best_kernel) {
+            best_kernel = t2 - t1;
+        }
+    }
+    return best_kernel / best_cal;
+}
+
+static void check_ratio(const char *name, double ratio, double baseline)
+{
+    printf("[ BENCH    ] %-24s ratio %7.3f  baseline %7.3f\n", name, ratio, baseline);
+    if (getenv("UT_BENCH_RECORD")) {
+        printf("[ BENCH    ] #define BENCH_BASELINE_%s %.3f\n", name, ratio);
+        return;
+    }
+    // Enforcement is opt-in: the recorded baselines only hold on the
+    // reference machine they were recorded on, and a hard failure from
+    // scheduler jitter on a developer box or shared CI host would just
+    // train everyone to ignore a red suite.  The ratios are always
+    // printed above for eyeballing.
+    if (!getenv("UT_BENCH_ENFORCE")) {
+        return;
+    }
+    EXPECT_LE(ratio, baseline * (1.0 + BENCH_TOLERANCE))
+        << name << " regressed more than " << (BENCH_TOLERANCE * 100.0)
+        << "% over its recorded baseline; if the slowdown is intentional,"
+        << " re-record with UT_BENCH_RECORD=1 and update benchmark_baselines.h";
+}
+
+class KernelBenchmark : public testing::Test {};
+
+// ***** EKF: full predict/correct cycle of the INSGPS filter *****
+// The kernel only uses the common INS interface, so it measures the 13 or
+// the 16 state implementation depending on which one the build linked in.
+
+static void insgps_kernel()
+{
+    float gyro[3]  = { 0.02f, -0.01f, 0.005f };
+    float accel[3] = { 0.1f, -0.05f, -9.81f };
+    float mag[3]   = { 400.0f, 0.0f, 1600.0f };
+    float pos[3]   = { 1.0f, 2.0f, -10.0f };
+    float vel[3]   = { 0.5f, -0.2f, 0.0f };
+
+    INSGPSInit();
+    for (int i = 0; i < 20000; i++) {
+        INSStatePrediction(gyro, accel, 0.01f);
+        INSCovariancePrediction(0.01f);
+        // sensor fusion at a quarter of the prediction rate, as in flight
+        if ((i & 3) == 0) {
+            INSCorrection(mag, pos, vel, -10.0f, FULL_SENSORS);
+        }
+    }
+}
+
+TEST_F(KernelBenchmark, InsgpsPredictCorrect) {
+    if (ins_get_num_states() == 16) {
+        check_ratio("INSGPS16", bench_ratio(&insgps_kernel), BENCH_BASELINE_INSGPS16);
+    } else {
+        check_ratio("INSGPS", bench_ratio(&insgps_kernel), BENCH_BASELINE_INSGPS);
+    }
+}
+
+// ***** PID: three axis rate loop as run by the stabilization inner loop *****
+
+static void pid_kernel()
+{
+    struct pid3 pid;
+    pid_scaler scaler = { 1.0f, 1.0f, 1.0f };
+    float out = 0.0f;
+
+    memset(&pid, 0, sizeof(pid));
+    for (int axis = 0; axis < 3; axis++) {
+        pid3_configure_axis(&pid, axis, 0.003f, 0.008f, 0.00005f, 0.3f);
+    }
+    for (int i = 0; i < 2000000; i++) {
+        float setpoint = 30.0f + (float)(i & 63);
+        float measured = setpoint - 5.0f + (float)(i & 15) * 0.5f;
+        for (int axis = 0; axis < 3; axis++) {
+            out += pid3_apply_setpoint_axis(&pid, axis, &scaler, setpoint, measured, 0.002f);
+        }
+    }
+    bench_sink = out;
+}
+
+TEST_F(KernelBenchmark, PidRateLoop) {
+    check_ratio("PID", bench_ratio(&pid_kernel), BENCH_BASELINE_PID);
+}
+
+// ***** Coordinate conversions: attitude round trip plus a rotation *****
+
+static void coordinates_kernel()
+{
+    float rpy[3] = { 10.0f, -20.0f, 30.0f };
+    float q[4];
+    float Rbe[3][3];
+    float vec[3] = { 1.0f, 2.0f, 3.0f };
+    float out[3];
+    float acc    = 0.0f;
+
+    for (int i = 0; i < 400000; i++) {
+        rpy[2] = (float)(i & 255) - 128.0f;
+        RPY2Quaternion(rpy, q);
+        Quaternion2R(q, Rbe);
+        rot_mult(Rbe, vec, out);
+        Quaternion2RPY(q, rpy);
+        acc   += out[0] + out[1] + out[2];
+    }
+    bench_sink = acc;
+}
+
+TEST_F(KernelBenchmark, CoordinateConversions) {
+    check_ratio("COORDINATES", bench_ratio(&coordinates_kernel), BENCH_BASELINE_COORDINATES);
+}
+
+// ***** UAVTalk: parse a stream of object frames byte by byte *****
+
+static UAVTalkConnection benchConnection;
+static uint8_t benchFrame[10 + BENCH_OBJ_NUM_BYTES + 1];
+
+static int32_t null_output_stream(__attribute__((unused)) uint8_t *data, int32_t length)
+{
+    return length;
+}
+
+static void uavtalk_build_frame()
+{
+    uint32_t objId = BENCH_OBJ_ID;
+    uint16_t size  = 10 + BENCH_OBJ_NUM_BYTES;
+
+    benchFrame[0] = 0x3C; // sync
+    benchFrame[1] = 0x20; // versioned object frame
+    benchFrame[2] = (uint8_t)(size & 0xFF);
+    benchFrame[3] = (uint8_t)(size >> 8);
+    memcpy(&benchFrame[4], &objId, 4);
+    benchFrame[8] = 0;    // instance id
+    benchFrame[9] = 0;
+    for (int i = 0; i < BENCH_OBJ_NUM_BYTES; i++) {
+        benchFrame[10 + i] = (uint8_t)i;
+    }
+    benchFrame[size] = PIOS_CRC_updateCRC(0, benchFrame, size);
+}
+
+static void uavtalk_kernel()
+{
+    for (int frame = 0; frame < 80000; frame++) {
+        for (unsigned i = 0; i < sizeof(benchFrame); i++) {
+            UAVTalkProcessInputStream(benchConnection, benchFrame[i]);
+        }
+    }
+}
+
+TEST_F(KernelBenchmark, UavtalkRxStream) {
+    benchConnection = UAVTalkInitialize(&null_output_stream);
+    ASSERT_TRUE(benchConnection != NULL);
+    uavtalk_build_frame();
+
+    // prove the synthetic frame actually parses before timing it
+    UAVTalkStats stats;
+    for (unsigned i = 0; i < sizeof(benchFrame); i++) {
+        UAVTalkProcessInputStream(benchConnection, benchFrame[i]);
+    }
+    UAVTalkGetStats(benchConnection, &stats, true);
+    ASSERT_EQ(1u, stats.rxObjects);
+    ASSERT_EQ(0u, stats.rxErrors);
+
+    check_ratio("UAVTALK", bench_ratio(&uavtalk_kernel), BENCH_BASELINE_UAVTALK);
+}
+
+TEST_F(KernelBenchmark, UavtalkSpanResync) {
+    UAVTalkConnection connection = UAVTalkInitialize(&null_output_stream);
+
+    ASSERT_TRUE(connection != NULL);
+    uavtalk_build_frame();
+
+    // garbage, a good frame, more garbage, a corrupt frame, a good frame;
+    // the span parser must deliver both good frames and account the rest
+    uint8_t stream[1024];
+    uint16_t pos = 0;
+    memset(&stream[pos], 0x55, 100);
+    pos += 100;
+    memcpy(&stream[pos], benchFrame, sizeof(benchFrame));
+    pos += sizeof(benchFrame);
+    memset(&stream[pos], 0xAA, 50);
+    pos += 50;
+    memcpy(&stream[pos], benchFrame, sizeof(benchFrame));
+    stream[pos + sizeof(benchFrame) - 1] ^= 0xFF; // break the CRC
+    pos += sizeof(benchFrame);
+    memcpy(&stream[pos], benchFrame, sizeof(benchFrame));
+    pos += sizeof(benchFrame);
+
+    // feed it in two pieces so a frame straddles the span boundary
+    UAVTalkProcessInputSpan(connection, stream, 130);
+    UAVTalkProcessInputSpan(connection, &stream[130], pos - 130);
+
+    UAVTalkStats stats;
+    UAVTalkGetStats(connection, &stats, true);
+    EXPECT_EQ(2u, stats.rxObjects);
+    EXPECT_EQ(150u, stats.rxSyncErrors);
+    EXPECT_EQ(1u, stats.rxCrcErrors);
+    EXPECT_EQ(1u, stats.rxResyncs);
+    EXPECT_EQ((uint32_t)pos, stats.rxBytes);
+}
@@ -6,6 +6,7 @@
 
 extern "C" {
 #include "mathmisc.h"
+#include "atan_lookup.h"
 }
 
 #define epsilon 0.00001f
@@ -108,3 +109,53 @@ TEST_F(MathTestRaw, y_on_curve1) {
     EXPECT_NEAR(-0.35f, y_on_curve(1.250f, points, length(points)), epsilon);
     EXPECT_NEAR(-0.50f, y_on_curve(2.000f, points, length(points)), epsilon);
 }
+
+class MathTestAtanLookup : public testing::Test {};
+
+TEST_F(MathTestAtanLookup, atan2_on_axes) {
+    EXPECT_NEAR(0.0f, fast_atan2f(0.0f, 1.0f), 0.00005f);
+    EXPECT_NEAR(M_PI / 2, fast_atan2f(1.0f, 0.0f), 0.00005f);
+    EXPECT_NEAR(-M_PI / 2, fast_atan2f(-1.0f, 0.0f), 0.00005f);
+    EXPECT_NEAR(M_PI, fast_atan2f(0.0f, -1.0f), 0.00005f);
+    // atan2(0,0) is defined as 0 to avoid propagating garbage
+    EXPECT_FLOAT_EQ(0.0f, fast_atan2f(0.0f, 0.0f));
+}
+
+TEST_F(MathTestAtanLookup, atan2_matches_libm) {
+    // sweep the full circle in 0.01 degree steps; worst case error of the
+    // interpolated table is about 2e-5 rad
+    for (int i = -18000; i <= 18000; i++) {
+        float angle = (float)i * (M_PI / 18000.0f);
+        float y     = sinf(angle);
+        float x     = cosf(angle);
+        EXPECT_NEAR(atan2f(y, x), fast_atan2f(y, x), 0.00005f);
+    }
+}
+
+TEST_F(MathTestAtanLookup, atan2_magnitude_invariance) {
+    // the result must only depend on the ratio, not the vector length
+    float scales[] = { 1e-6f, 1e-3f, 1.0f, 1e3f, 1e6f };
+
+    for (unsigned int s = 0; s < length(scales); s++) {
+        EXPECT_NEAR(atan2f(0.3f, 0.7f), fast_atan2f(0.3f * scales[s], 0.7f * scales[s]), 0.00005f);
+        EXPECT_NEAR(atan2f(-0.9f, 0.2f), fast_atan2f(-0.9f * scales[s], 0.2f * scales[s]), 0.00005f);
+        EXPECT_NEAR(atan2f(0.5f, -0.6f), fast_atan2f(0.5f * scales[s], -0.6f * scales[s]), 0.00005f);
+    }
+}
+
+TEST_F(MathTestAtanLookup, asin_matches_libm) {
+    // the fast_invsqrtf in the argument reduction dominates the error at
+    // roughly 1e-3 rad near the ends of the range
+    for (int i = -10000; i <= 10000; i++) {
+        float x = (float)i / 10000.0f;
+        EXPECT_NEAR(asinf(x), fast_asinf(x), 0.002f);
+    }
+}
+
+TEST_F(MathTestAtanLookup, asin_clamps_out_of_range) {
+    // attitude code feeds this values that can leave [-1,1] by rounding
+    EXPECT_FLOAT_EQ(fast_asinf(1.0f), fast_asinf(1.5f));
+    EXPECT_FLOAT_EQ(fast_asinf(-1.0f), fast_asinf(-1.5f));
+    EXPECT_NEAR(M_PI / 2, fast_asinf(1.0f), 0.00005f);
+    EXPECT_NEAR(-M_PI / 2, fast_asinf(-1.0f), 0.00005f);
+}
@@ -60,6 +60,10 @@ typedef struct {
 
 /**
  * List of object properties that are needed for the periodic updates.
+ * The list is kept sorted by timeToNextUpdateMs so the dispatcher only
+ * ever touches due entries at the head instead of walking the full list
+ * each tick.  Entries with no period park at the tail with a deadline
+ * of INT32_MAX.
  */
 struct PeriodicObjectListStruct {
     EventCallbackInfo evInfo; /** Event callback information */
@@ -72,6 +76,7 @@ typedef struct PeriodicObjectListStruct PeriodicObjectList;
 // Private variables
 static PeriodicObjectList *mObjList;
 static xQueueHandle mQueue;
+static xQueueHandle mCriticalQueue;
 static DelayedCallbackInfo *eventSchedulerCallback;
 static xSemaphoreHandle mMutex;
 static EventStats mStats;
@@ -81,6 +86,7 @@ static int32_t processPeriodicUpdates();
 static void eventTask();
 static int32_t eventPeriodicCreate(UAVObjEvent *ev, UAVObjEventCallback cb, xQueueHandle queue, uint16_t periodMs);
 static int32_t eventPeriodicUpdate(UAVObjEvent *ev, UAVObjEventCallback cb, xQueueHandle queue, uint16_t periodMs);
+static void eventPeriodicInsert(PeriodicObjectList *objEntry);
 static uint16_t randomizePeriod(uint16_t periodMs);
 
 
@@ -100,8 +106,12 @@ int32_t EventDispatcherInitialize()
         return -1;
     }
 
-    // Create event queue
+    // Create event queues
+    // Events for priority objects (flight status, actuator, ...) get their
+    // own queue so they are never stuck behind a burst of bulk sensor
+    // updates in the shared queue.
     mQueue = xQueueCreate(MAX_QUEUE_SIZE, sizeof(EventCallbackInfo));
+    mCriticalQueue = xQueueCreate(MAX_QUEUE_SIZE, sizeof(EventCallbackInfo));
 
     // Create callback
     eventSchedulerCallback = PIOS_CALLBACKSCHEDULER_Create(&eventTask, CALLBACK_PRIORITY, TASK_PRIORITY, CALLBACKINFO_RUNNING_EVENTDISPATCHER, STACK_SIZE * 4);
@@ -147,8 +157,17 @@ int32_t EventCallbackDispatch(UAVObjEvent *ev, UAVObjEventCallback cb)
     memcpy(&evInfo.ev, ev, sizeof(UAVObjEvent));
     evInfo.cb    = cb;
     evInfo.queue = 0;
-    // Push to queue
-    int32_t result = xQueueSend(mQueue, &evInfo, 0); // will not block if queue is full
+    // Classify by the object's priority flag and push to the matching queue
+    bool critical  = (ev->obj != NULL) && UAVObjIsPriority(ev->obj);
+    // will not block if queue is full, the event is shed instead
+    int32_t result = xQueueSend(critical ? mCriticalQueue : mQueue, &evInfo, 0);
+    if (result != pdTRUE) {
+        if (critical) {
+            ++mStats.criticalEventDrops;
+        } else {
+            ++mStats.normalEventDrops;
+        }
+    }
     PIOS_CALLBACKSCHEDULER_Dispatch(eventSchedulerCallback);
     return result;
 }
@@ -238,9 +257,13 @@ static int32_t eventPeriodicCreate(UAVObjEvent *ev, UAVObjEventCallback cb, xQue
     objEntry->evInfo.cb = cb;
     objEntry->evInfo.queue       = queue;
     objEntry->updatePeriodMs     = periodMs;
-    objEntry->timeToNextUpdateMs = randomizePeriod(periodMs); // avoid bunching of updates
-    // Add to list
-    LL_APPEND(mObjList, objEntry);
+    if (periodMs > 0) {
+        objEntry->timeToNextUpdateMs = randomizePeriod(periodMs); // avoid bunching of updates
+    } else {
+        objEntry->timeToNextUpdateMs = INT32_MAX; // not scheduled
+    }
+    // Add to the deadline sorted schedule
+    eventPeriodicInsert(objEntry);
     // Release lock
     xSemaphoreGiveRecursive(mMutex);
     return 0;
@@ -267,9 +290,16 @@ static int32_t eventPeriodicUpdate(UAVObjEvent *ev, UAVObjEventCallback cb, xQue
             objEntry->evInfo.ev.obj == ev->obj &&
             objEntry->evInfo.ev.instId == ev->instId &&
             objEntry->evInfo.ev.event == ev->event) {
-            // Object found, update period
-            objEntry->updatePeriodMs     = periodMs;
-            objEntry->timeToNextUpdateMs = randomizePeriod(periodMs); // avoid bunching of updates
+            // Object found, update period and move the entry to its new
+            // slot in the deadline sorted schedule
+            LL_DELETE(mObjList, objEntry);
+            objEntry->updatePeriodMs = periodMs;
+            if (periodMs > 0) {
+                objEntry->timeToNextUpdateMs = randomizePeriod(periodMs); // avoid bunching of updates
+            } else {
+                objEntry->timeToNextUpdateMs = INT32_MAX; // not scheduled
+            }
+            eventPeriodicInsert(objEntry);
             // Release lock
             xSemaphoreGiveRecursive(mMutex);
             return 0;
@@ -288,6 +318,15 @@ static void eventTask()
     static uint32_t timeToNextUpdateMs = 0;
     EventCallbackInfo evInfo;
 
+    // Drain the critical queue first so priority object events keep a
+    // bounded delivery latency even when the normal queue is saturated
+    while (xQueueReceive(mCriticalQueue, &evInfo, 0) == pdTRUE) {
+        // Invoke callback, if any
+        if (evInfo.cb != 0) {
+            evInfo.cb(&evInfo.ev); // the function is expected to copy the event information
+        }
+    }
+
     // Wait for queue message
     int limit = MAX_QUEUE_SIZE;
 
@@ -311,12 +350,35 @@ static void eventTask()
 }
 
 /**
- * Handle periodic updates for all objects.
+ * Insert an entry into the deadline sorted schedule.  Later entries with
+ * an equal deadline keep their relative order.
+ */
+static void eventPeriodicInsert(PeriodicObjectList *objEntry)
+{
+    if (!mObjList || objEntry->timeToNextUpdateMs < mObjList->timeToNextUpdateMs) {
+        objEntry->next = mObjList;
+        mObjList = objEntry;
+        return;
+    }
+
+    PeriodicObjectList *cursor = mObjList;
+    while (cursor->next && cursor->next->timeToNextUpdateMs <= objEntry->timeToNextUpdateMs) {
+        cursor = cursor->next;
+    }
+    objEntry->next = cursor->next;
+    cursor->next   = objEntry;
+}
+
+/**
+ * Handle periodic updates for all due objects.
+ *
+ * The schedule is sorted by deadline, so all due entries are batched at
+ * the head of the list and dispatched in a single pass; entries that
+ * are not due yet are never visited.
  * \return The system time until the next update (in ms) or -1 if failed
  */
 static int32_t processPeriodicUpdates()
 {
-    PeriodicObjectList *objEntry;
     int32_t timeNow;
     int32_t timeToNextUpdate;
     int32_t offset;
@@ -324,37 +386,38 @@ static int32_t processPeriodicUpdates()
     // Get lock
     xSemaphoreTakeRecursive(mMutex, portMAX_DELAY);
 
-    // Iterate through each object and update its timer, if zero then transmit object.
-    // Also calculate smallest delay to next update.
-    timeToNextUpdate = xTaskGetTickCount() * portTICK_RATE_MS + MAX_UPDATE_PERIOD_MS;
-    LL_FOREACH(mObjList, objEntry) {
-        // If object is configured for periodic updates
-        if (objEntry->updatePeriodMs > 0) {
-            // Check if time for the next update
-            timeNow = xTaskGetTickCount() * portTICK_RATE_MS;
-            if (objEntry->timeToNextUpdateMs <= timeNow) {
-                // Reset timer
-                offset = (timeNow - objEntry->timeToNextUpdateMs) % objEntry->updatePeriodMs;
-                objEntry->timeToNextUpdateMs = timeNow + objEntry->updatePeriodMs - offset;
-                // Invoke callback, if one
-                if (objEntry->evInfo.cb != 0) {
-                    objEntry->evInfo.cb(&objEntry->evInfo.ev); // the function is expected to copy the event information
-                }
-                // Push event to queue, if one
-                if (objEntry->evInfo.queue != 0) {
-                    if (xQueueSend(objEntry->evInfo.queue, &objEntry->evInfo.ev, 0) != pdTRUE && !objEntry->evInfo.ev.lowPriority) { // do not block if queue is full
-                        if (objEntry->evInfo.ev.obj != NULL) {
-                            mStats.lastErrorID = UAVObjGetID(objEntry->evInfo.ev.obj);
-                        }
-                        ++mStats.eventErrors;
-                    }
+    // Pop due entries off the head, rearm them and dispatch.  Rearming
+    // always lands in the future, so the loop terminates even when a
+    // callback takes longer than the shortest period.
+    timeNow = xTaskGetTickCount() * portTICK_RATE_MS;
+    while (mObjList && mObjList->updatePeriodMs > 0 && mObjList->timeToNextUpdateMs <= timeNow) {
+        PeriodicObjectList *objEntry = mObjList;
+        mObjList = objEntry->next;
+        // Reset timer and reinsert before dispatching so a callback that
+        // registers or updates periodic events sees a consistent schedule
+        offset = (timeNow - objEntry->timeToNextUpdateMs) % objEntry->updatePeriodMs;
+        objEntry->timeToNextUpdateMs = timeNow + objEntry->updatePeriodMs - offset;
+        eventPeriodicInsert(objEntry);
+        // Invoke callback, if one
+        if (objEntry->evInfo.cb != 0) {
+            objEntry->evInfo.cb(&objEntry->evInfo.ev); // the function is expected to copy the event information
+        }
+        // Push event to queue, if one
+        if (objEntry->evInfo.queue != 0) {
+            if (xQueueSend(objEntry->evInfo.queue, &objEntry->evInfo.ev, 0) != pdTRUE && !objEntry->evInfo.ev.lowPriority) { // do not block if queue is full
+                if (objEntry->evInfo.ev.obj != NULL) {
+                    mStats.lastErrorID = UAVObjGetID(objEntry->evInfo.ev.obj);
                 }
-            }
-            // Update minimum delay
-            if (objEntry->timeToNextUpdateMs < timeToNextUpdate) {
-                timeToNextUpdate = objEntry->timeToNextUpdateMs;
+                ++mStats.eventErrors;
             }
         }
+        timeNow = xTaskGetTickCount() * portTICK_RATE_MS;
+    }
+
+    // The head of the schedule holds the earliest pending deadline
+    timeToNextUpdate = timeNow + MAX_UPDATE_PERIOD_MS;
+    if (mObjList && mObjList->updatePeriodMs > 0 && mObjList->timeToNextUpdateMs < timeToNextUpdate) {
+        timeToNextUpdate = mObjList->timeToNextUpdateMs;
     }
 
     // Done
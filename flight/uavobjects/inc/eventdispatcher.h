@@ -33,6 +33,8 @@
 typedef struct {
     uint32_t lastErrorID;
     uint32_t eventErrors;
+    uint32_t criticalEventDrops; /** events for priority objects shed on queue overflow */
+    uint32_t normalEventDrops; /** events for regular objects shed on queue overflow */
 } EventStats;
 
 // Public functions
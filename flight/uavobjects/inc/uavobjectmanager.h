@@ -199,16 +199,23 @@ bool UAVObjIsPriority(UAVObjHandle obj);
 int32_t UAVObjUnpack(UAVObjHandle obj_handle, uint16_t instId, const uint8_t *dataIn);
 int32_t UAVObjPack(UAVObjHandle obj_handle, uint16_t instId, uint8_t *dataOut);
 uint8_t UAVObjUpdateCRC(UAVObjHandle obj_handle, uint16_t instId, uint8_t crc);
+uint32_t UAVObjGetSettingsCRC(UAVObjHandle obj_handle);
+typedef int32_t (*UAVObjStreamWriter)(uint8_t *data, int32_t length);
+int32_t UAVObjStreamInstanceData(UAVObjHandle obj_handle, uint16_t instId, UAVObjStreamWriter writer, uint8_t *crc);
 int32_t UAVObjSave(UAVObjHandle obj_handle, uint16_t instId);
 int32_t UAVObjLoad(UAVObjHandle obj_handle, uint16_t instId);
+int32_t UAVObjReadData(UAVObjHandle obj_handle, uint16_t instId, void *dataOut);
 int32_t UAVObjDelete(UAVObjHandle obj_handle, uint16_t instId);
 #if defined(PIOS_INCLUDE_SDCARD)
 int32_t UAVObjSaveToFile(UAVObjHandle obj_handle, uint16_t instId, FILEINFO *file);
 int32_t UAVObjLoadFromFile(UAVObjHandle obj_handle, FILEINFO *file);
 #endif
 int32_t UAVObjSaveSettings();
+int32_t UAVObjSaveDirtySettings();
 int32_t UAVObjLoadSettings();
 int32_t UAVObjDeleteSettings();
+int32_t UAVObjSnapshotSettings();
+int32_t UAVObjRevertSettings();
 int32_t UAVObjSaveMetaobjects();
 int32_t UAVObjLoadMetaobjects();
 int32_t UAVObjDeleteMetaobjects();
@@ -216,6 +223,7 @@ int32_t UAVObjSetData(UAVObjHandle obj_handle, const void *dataIn);
 int32_t UAVObjSetDataField(UAVObjHandle obj_handle, const void *dataIn, uint32_t offset, uint32_t size);
 int32_t UAVObjGetData(UAVObjHandle obj_handle, void *dataOut);
 int32_t UAVObjGetDataField(UAVObjHandle obj_handle, void *dataOut, uint32_t offset, uint32_t size);
+const void *UAVObjGetDataPointer(UAVObjHandle obj_handle);
 int32_t UAVObjSetInstanceData(UAVObjHandle obj_handle, uint16_t instId, const void *dataIn);
 int32_t UAVObjSetInstanceDataField(UAVObjHandle obj_handle, uint16_t instId, const void *dataIn, uint32_t offset, uint32_t size);
 int32_t UAVObjGetInstanceData(UAVObjHandle obj_handle, uint16_t instId, void *dataOut);
@@ -100,6 +100,16 @@ struct UAVOBase {
         bool isSingle      : 1;
         bool isSettings    : 1;
         bool isPriority    : 1;
+        /* Settings only: object data differs from its copy in flash */
+        bool isDirty       : 1;
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+        /* Settings only: instance data lives in the settings flash and
+         * reads are served through the settings cache */
+        bool isFlashBacked : 1;
+        /* Flash backed only: permanent RAM storage has been attached
+         * (first write), the data pointer is valid */
+        bool isResident    : 1;
+#endif
     } flags;
 } __attribute__((packed));
 
@@ -132,6 +142,22 @@ struct UAVOSingle {
      */
 } __attribute__((packed));
 
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+/* Augmented type for a flash resident single instance settings UAVO.
+ * Only the header lives in RAM.  While isResident is clear the instance
+ * data stays in the settings flash partition and reads go through the
+ * settings cache; the first write allocates permanent storage and points
+ * data at it. */
+struct UAVOSingleFlash {
+    struct UAVOData uavo;
+    /* Permanent instance storage, valid only when isResident is set */
+    uint8_t *data;
+    /* Default initializer, kept so the object can be reconstructed if
+     * its flash copy disappears (settings wipe) after registration */
+    UAVObjInitializeCallback initCb;
+} __attribute__((packed));
+#endif /* ifdef PIOS_UAVOBJ_FLASH_SETTINGS */
+
 /* Part of a linked list of instances chained off of a multi instance UAVO. */
 struct UAVOMultiInst {
     struct UAVOMultiInst *next;
@@ -168,5 +194,10 @@ struct UAVOMulti {
 // Private functions
 int32_t sendEvent(struct UAVOBase *obj, uint16_t instId, UAVObjEventType event);
 InstanceHandle getInstance(struct UAVOData *obj, uint16_t instId);
+/* Manager lock, used by the persistence handler: instance pointers of
+ * flash backed settings objects point into the settings cache and are
+ * only stable while the lock is held */
+void objLock(void);
+void objUnlock(void);
 
 #endif /* UAVOBJECTPRIVATE_H_ */
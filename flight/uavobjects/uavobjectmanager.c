@@ -46,8 +46,13 @@ int32_t UAVObjPers_stub(__attribute__((unused)) UAVObjHandle obj_handle, __attri
 {
     return 0;
 }
+int32_t UAVObjPersRead_stub(__attribute__((unused)) UAVObjHandle obj_handle, __attribute__((unused)) uint16_t instId, __attribute__((unused)) void *dataOut)
+{
+    return -1;
+}
 int32_t UAVObjSave(UAVObjHandle obj_handle, uint16_t instId)  __attribute__((weak, alias("UAVObjPers_stub")));;
 int32_t UAVObjLoad(UAVObjHandle obj_handle, uint16_t instId) __attribute__((weak, alias("UAVObjPers_stub")));
+int32_t UAVObjReadData(UAVObjHandle obj_handle, uint16_t instId, void *dataOut) __attribute__((weak, alias("UAVObjPersRead_stub")));
 int32_t UAVObjDelete(UAVObjHandle obj_handle, uint16_t instId) __attribute__((weak, alias("UAVObjPers_stub")));
 
 
@@ -67,6 +72,334 @@ static const UAVObjMetadata defMetadata = {
 
 static UAVObjStats stats;
 
+/*
+ * Arena allocator for UAVObject storage.
+ *
+ * Objects are registered once at startup and instances are never freed,
+ * so allocating each of them separately from the general heap only buys
+ * fragmentation and unpredictable allocation times on the small CCM/SRAM
+ * heaps of the STM32 targets.  When the target defines
+ * PIOS_UAVOBJ_ARENA_SIZE one contiguous block of that many bytes is
+ * carved off the heap at UAVObjInitialize() time and all object and
+ * instance storage is bump-allocated from it.  If the arena fills up
+ * (or could not be allocated) we fall back to pios_malloc() so a
+ * mis-sized arena degrades gracefully instead of failing registration.
+ */
+#ifdef PIOS_UAVOBJ_ARENA_SIZE
+static uint8_t *arenaBase;
+static uint32_t arenaUsed;
+
+static void *arenaAlloc(uint32_t size)
+{
+    /* Keep every allocation 4-byte aligned like the heap does */
+    size = (size + 3) & ~3UL;
+
+    if (arenaBase && (arenaUsed + size) <= PIOS_UAVOBJ_ARENA_SIZE) {
+        void *p = arenaBase + arenaUsed;
+        arenaUsed += size;
+        return p;
+    }
+
+    /* Arena exhausted or unavailable, degrade to the general heap */
+    return pios_malloc(size);
+}
+#else /* ifdef PIOS_UAVOBJ_ARENA_SIZE */
+#define arenaAlloc(size) pios_malloc(size)
+#endif /* ifdef PIOS_UAVOBJ_ARENA_SIZE */
+
+/*
+ * Hash index over registered object IDs.
+ *
+ * UAVObjGetByID() sits on the hot path of UAVTalk reception and event
+ * dispatch, so a linear scan over the object list is too expensive at
+ * high telemetry rates.  Registered objects are inserted into a small
+ * open-addressing hash table so lookups complete in O(1).
+ *
+ * The table is sized at compile time to a power of two comfortably
+ * larger than the number of UAVObjects built into any firmware image.
+ * Both an object and its embedded metaobject share one slot: object IDs
+ * always have bit 0 clear and MetaObjectId() only sets bit 0, so the
+ * key is simply the ID with bit 0 masked off.
+ */
+#define UAVOBJ_HASH_NUM_SLOTS 256
+static struct UAVOData *objHashTable[UAVOBJ_HASH_NUM_SLOTS];
+
+static inline uint32_t hashObjectId(uint32_t id)
+{
+    /* Knuth multiplicative hash, folded onto the table size */
+    return (uint32_t)(((id & ~1UL) * 2654435761UL) >> 16) & (UAVOBJ_HASH_NUM_SLOTS - 1);
+}
+
+/**
+ * Insert a newly registered object into the hash index.
+ * Must be called with the mutex held.
+ */
+static void hashInsert(struct UAVOData *obj)
+{
+    uint32_t slot = hashObjectId(obj->id);
+
+    for (uint32_t probe = 0; probe < UAVOBJ_HASH_NUM_SLOTS; probe++) {
+        if (objHashTable[slot] == NULL) {
+            objHashTable[slot] = obj;
+            return;
+        }
+        slot = (slot + 1) & (UAVOBJ_HASH_NUM_SLOTS - 1);
+    }
+
+    /* Table full - should never happen with a sanely sized table */
+    PIOS_Assert(0);
+}
+
+/*
+ * Object data copies.
+ *
+ * Generated object layouts start word aligned and instance storage is
+ * allocated with heap alignment, so whole-object copies can run word at
+ * a time instead of byte-granularity memcpy.
+ *
+ * Writers that must not tear the lockless scalar field readers (see
+ * UAVObjGetDataPointer()) copy under PIOS_IRQ_Disable().  Rather than
+ * holding interrupts off for the whole object, copyDataChunked() opens
+ * a fresh interrupt-off window per chunk.  Chunks are a multiple of 4
+ * bytes, so no aligned scalar field ever straddles a chunk boundary and
+ * a field read between chunks still sees either the old or the new
+ * value, never a mix of both.  This bounds the worst-case interrupt
+ * latency by the chunk size instead of the largest object size.
+ */
+#define UAVOBJ_COPY_CHUNK_SIZE 64
+
+static void copyData(void *dest, const void *src, uint32_t size)
+{
+    if ((((uintptr_t)dest | (uintptr_t)src | size) & 3) == 0) {
+        uint32_t *d = dest;
+        const uint32_t *s = src;
+        for (uint32_t n = size >> 2; n > 0; n--) {
+            *d++ = *s++;
+        }
+    } else {
+        memcpy(dest, src, size);
+    }
+}
+
+static void copyDataChunked(void *dest, const void *src, uint32_t size)
+{
+    uint8_t *d = dest;
+    const uint8_t *s = src;
+
+    while (size > 0) {
+        uint32_t chunk = (size > UAVOBJ_COPY_CHUNK_SIZE) ? UAVOBJ_COPY_CHUNK_SIZE : size;
+        PIOS_IRQ_Disable();
+        copyData(d, s, chunk);
+        PIOS_IRQ_Enable();
+        d    += chunk;
+        s    += chunk;
+        size -= chunk;
+    }
+}
+
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+/*
+ * Flash resident settings objects.
+ *
+ * Settings objects are read rarely after init but normally live in RAM
+ * forever, and on the memory tight F1 targets that RAM decides how many
+ * modules fit.  With PIOS_UAVOBJ_FLASH_SETTINGS defined, single instance
+ * settings objects keep only their header in RAM and their data in the
+ * settings flash partition.  Reads are served from a small MRU cache of
+ * unpacked copies pulled in through UAVObjReadData(), and the first
+ * write attaches permanent RAM storage to the object (see
+ * settingsMakeResident()), so RAM is only spent on objects that
+ * actually change.
+ *
+ * Cache pointers handed out by getInstance() are only stable while the
+ * manager lock is held; the persistence handler takes it through
+ * objLock() for the same reason.  The generated scalar field accessors
+ * read through UAVObjGetDataPointer(), which hands out an unlocked
+ * pointer and therefore also makes the object resident.  Whole struct
+ * XxxGet() reads, the common pattern for settings, stay in flash.
+ */
+#ifndef PIOS_UAVOBJ_FLASH_SETTINGS_CACHE_SLOTS
+#define PIOS_UAVOBJ_FLASH_SETTINGS_CACHE_SLOTS 4
+#endif
+
+struct UAVOCacheSlot {
+    struct UAVOData *obj; /* cached object, NULL when the slot is free */
+    uint8_t *buf;
+    uint16_t buf_size;
+    uint32_t lastUse;
+};
+static struct UAVOCacheSlot settingsCache[PIOS_UAVOBJ_FLASH_SETTINGS_CACHE_SLOTS];
+static uint32_t settingsCacheUse;
+
+/**
+ * Fill a freshly bound cache slot with the content of its object: the
+ * flash copy, or the defaults if the object is not in flash (anymore).
+ * Must be called with the mutex held.
+ */
+static void settingsCacheFill(struct UAVOCacheSlot *slot)
+{
+    struct UAVOData *obj = slot->obj;
+
+    if (UAVObjReadData((UAVObjHandle)obj, 0, slot->buf) != 0) {
+        /* Not in flash (wiped since registration), reconstruct the
+         * defaults.  The initializer writes through the public Set
+         * path, so back the object with the slot while it runs. */
+        struct UAVOSingleFlash *uavo_flash = (struct UAVOSingleFlash *)obj;
+        memset(slot->buf, 0, obj->instance_size);
+        uavo_flash->data = slot->buf;
+        obj->base.flags.isResident = true;
+        if (uavo_flash->initCb) {
+            uavo_flash->initCb((UAVObjHandle)obj, 0);
+        }
+        obj->base.flags.isResident = false;
+        uavo_flash->data = NULL;
+        obj->base.flags.isDirty    = true;
+    }
+}
+
+/**
+ * Find the cache slot holding the data of a flash backed settings
+ * object, binding (and optionally filling) a new slot on a miss.  The
+ * least recently used slot is evicted when the cache is full.
+ * Must be called with the mutex held.
+ * \return The slot, or NULL if no slot buffer could be allocated
+ */
+static struct UAVOCacheSlot *settingsCacheLookup(struct UAVOData *obj, bool fill)
+{
+    struct UAVOCacheSlot *victim = NULL;
+
+    for (int i = 0; i < PIOS_UAVOBJ_FLASH_SETTINGS_CACHE_SLOTS; i++) {
+        struct UAVOCacheSlot *slot = &settingsCache[i];
+        if (slot->obj == obj) {
+            slot->lastUse = ++settingsCacheUse;
+            return slot;
+        }
+    }
+
+    /* Miss: reuse a free slot or evict the least recently used one */
+    for (int i = 0; i < PIOS_UAVOBJ_FLASH_SETTINGS_CACHE_SLOTS; i++) {
+        struct UAVOCacheSlot *slot = &settingsCache[i];
+        if (!slot->obj) {
+            victim = slot;
+            break;
+        }
+        if (!victim || slot->lastUse < victim->lastUse) {
+            victim = slot;
+        }
+    }
+
+    if (victim->buf_size < obj->instance_size) {
+        if (victim->buf) {
+            pios_free(victim->buf);
+        }
+        victim->buf      = (uint8_t *)pios_malloc(obj->instance_size);
+        victim->buf_size = victim->buf ? obj->instance_size : 0;
+        if (!victim->buf) {
+            victim->obj = NULL;
+            return NULL;
+        }
+    }
+    victim->obj     = obj;
+    victim->lastUse = ++settingsCacheUse;
+    if (fill) {
+        settingsCacheFill(victim);
+    }
+    return victim;
+}
+
+/**
+ * Attach permanent RAM storage to a flash backed settings object,
+ * carrying its current content (flash copy or defaults) over.  Called
+ * on the first write; a no-op if the object is already resident.
+ * Must be called with the mutex held.
+ * \return 0 on success, -1 if storage could not be allocated
+ */
+static int32_t settingsMakeResident(struct UAVOData *obj)
+{
+    struct UAVOSingleFlash *uavo_flash = (struct UAVOSingleFlash *)obj;
+
+    if (obj->base.flags.isResident) {
+        return 0;
+    }
+
+    uint8_t *data = (uint8_t *)arenaAlloc(obj->instance_size);
+    if (!data) {
+        return -1;
+    }
+
+    struct UAVOCacheSlot *slot = settingsCacheLookup(obj, true);
+    if (slot) {
+        copyData(data, slot->buf, obj->instance_size);
+        /* Release the slot, reads come from the resident copy now */
+        slot->obj = NULL;
+        uavo_flash->data = data;
+        obj->base.flags.isResident = true;
+    } else {
+        /* Cache unavailable (out of memory): initialize in place and
+         * let the flash copy, when there is one, win over the defaults */
+        memset(data, 0, obj->instance_size);
+        uavo_flash->data = data;
+        obj->base.flags.isResident = true;
+        if (uavo_flash->initCb) {
+            uavo_flash->initCb((UAVObjHandle)obj, 0);
+        }
+        if (UAVObjReadData((UAVObjHandle)obj, 0, data) != 0) {
+            obj->base.flags.isDirty = true;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Stage a freshly registered flash backed settings object in the cache.
+ * The default initializer runs with the object temporarily backed by a
+ * cache slot, so the defaults (fields and metadata) exist without any
+ * permanent instance storage; the regular settings load that follows
+ * registration then overwrites the staged defaults with the flash copy.
+ * Must be called with the mutex held.
+ * \return 0 on success, -1 if neither a cache slot nor fallback storage
+ *         could be set up
+ */
+static int32_t settingsInitFlashBacked(struct UAVOData *obj, UAVObjInitializeCallback initCb)
+{
+    struct UAVOSingleFlash *uavo_flash = (struct UAVOSingleFlash *)obj;
+
+    uavo_flash->initCb = initCb;
+
+    struct UAVOCacheSlot *slot = settingsCacheLookup(obj, false);
+    if (!slot) {
+        /* No slot to stage in, give the object permanent storage */
+        return settingsMakeResident(obj);
+    }
+
+    memset(slot->buf, 0, obj->instance_size);
+    uavo_flash->data = slot->buf;
+    obj->base.flags.isResident = true;
+    if (initCb) {
+        initCb((UAVObjHandle)obj, 0);
+    }
+    obj->base.flags.isResident = false;
+    uavo_flash->data = NULL;
+
+    return 0;
+}
+#endif /* ifdef PIOS_UAVOBJ_FLASH_SETTINGS */
+
+/**
+ * Take/release the object manager lock.  Used by the persistence
+ * handler: instance pointers of flash backed settings objects point
+ * into the settings cache and are only stable while the lock is held.
+ */
+void objLock(void)
+{
+    xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+}
+
+void objUnlock(void)
+{
+    xSemaphoreGiveRecursive(mutex);
+}
+
 /**
  * Initialize the object manager
  * \return 0 Success
@@ -76,6 +409,14 @@ int32_t UAVObjInitialize()
 {
     // Initialize variables
     memset(&stats, 0, sizeof(UAVObjStats));
+    memset(objHashTable, 0, sizeof(objHashTable));
+
+#ifdef PIOS_UAVOBJ_ARENA_SIZE
+    /* Reserve the object storage arena in one piece before the heap
+     * gets a chance to fragment */
+    arenaBase = (uint8_t *)pios_malloc(PIOS_UAVOBJ_ARENA_SIZE);
+    arenaUsed = 0;
+#endif
 
     /* Initialize _uavo_handles start/stop pointers */
         #if (defined(__MACH__) && defined(__APPLE__))
@@ -146,8 +487,8 @@ static struct UAVOData *UAVObjAllocSingle(uint32_t num_bytes)
     /* Compute the complete size of the object, including the data for a single embedded instance */
     uint32_t object_size = sizeof(struct UAVOSingle) + num_bytes;
 
-    /* Allocate the object from the heap */
-    struct UAVOSingle *uavo_single = (struct UAVOSingle *)pios_malloc(object_size);
+    /* Allocate the object from the arena */
+    struct UAVOSingle *uavo_single = (struct UAVOSingle *)arenaAlloc(object_size);
 
     if (!uavo_single) {
         return NULL;
@@ -171,8 +512,8 @@ static struct UAVOData *UAVObjAllocMulti(uint32_t num_bytes)
     /* Compute the complete size of the object, including the data for a single embedded instance */
     uint32_t object_size = sizeof(struct UAVOMulti) + num_bytes;
 
-    /* Allocate the object from the heap */
-    struct UAVOMulti *uavo_multi = (struct UAVOMulti *)pios_malloc(object_size);
+    /* Allocate the object from the arena */
+    struct UAVOMulti *uavo_multi = (struct UAVOMulti *)arenaAlloc(object_size);
 
     if (!uavo_multi) {
         return NULL;
@@ -194,6 +535,32 @@ static struct UAVOData *UAVObjAllocMulti(uint32_t num_bytes)
     return &(uavo_multi->uavo);
 }
 
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+static struct UAVOData *UAVObjAllocSingleFlash(void)
+{
+    /* Only the object header is allocated, the instance data stays in
+     * flash until the object is written (see settingsMakeResident) */
+    struct UAVOSingleFlash *uavo_flash = (struct UAVOSingleFlash *)arenaAlloc(sizeof(struct UAVOSingleFlash));
+
+    if (!uavo_flash) {
+        return NULL;
+    }
+
+    /* Fill in the common part of the UAVO */
+    struct UAVOBase *uavo_base = &(uavo_flash->uavo.base);
+    memset(uavo_base, 0, sizeof(*uavo_base));
+    uavo_base->flags.isSingle      = true;
+    uavo_base->flags.isFlashBacked = true;
+    uavo_base->next_event = NULL;
+
+    uavo_flash->data   = NULL;
+    uavo_flash->initCb = NULL;
+
+    /* Give back the generic UAVO part */
+    return &(uavo_flash->uavo);
+}
+#endif /* ifdef PIOS_UAVOBJ_FLASH_SETTINGS */
+
 /**************************
  * UAVObject Database APIs
  *************************/
@@ -224,7 +591,12 @@ UAVObjHandle UAVObjRegister(uint32_t id,
 
     /* Map the various flags to one of the UAVO types we understand */
     if (isSingleInstance) {
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+        /* Settings objects keep their instance data in flash */
+        uavo_data = isSettings ? UAVObjAllocSingleFlash() : UAVObjAllocSingle(num_bytes);
+#else
         uavo_data = UAVObjAllocSingle(num_bytes);
+#endif
     } else {
         uavo_data = UAVObjAllocMulti(num_bytes);
     }
@@ -246,19 +618,36 @@ UAVObjHandle UAVObjRegister(uint32_t id,
     /* Initialize the embedded meta UAVO */
     UAVObjInitMetaData(&uavo_data->metaObj);
 
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+    if (uavo_data->base.flags.isFlashBacked) {
+        /* Flash backed objects get their defaults staged in the
+         * settings cache instead, no instance storage is allocated */
+        if (settingsInitFlashBacked(uavo_data, initCb) != 0) {
+            uavo_data = NULL;
+            goto unlock_exit;
+        }
+    } else if (initCb) {
+        initCb((UAVObjHandle)uavo_data, 0);
+    }
+#else
     /* Initialize object fields and metadata to default values */
     if (initCb) {
         initCb((UAVObjHandle)uavo_data, 0);
     }
+#endif /* ifdef PIOS_UAVOBJ_FLASH_SETTINGS */
 
     /* Always try to load the meta object from flash */
     UAVObjLoad((UAVObjHandle) & (uavo_data->metaObj), 0);
 
-    /* Attempt to load settings object from flash */
+    /* Attempt to load settings object from flash.  An object that is not in
+     * flash yet starts out dirty so a dirty-only save still persists it. */
     if (uavo_data->base.flags.isSettings) {
-        UAVObjLoad((UAVObjHandle)uavo_data, 0);
+        uavo_data->base.flags.isDirty = (UAVObjLoad((UAVObjHandle)uavo_data, 0) != 0);
     }
 
+    /* Make the object findable through the hash index */
+    hashInsert(uavo_data);
+
     // fire events for outer object and its embedded meta object
     instanceAutoUpdated((UAVObjHandle)uavo_data, 0);
     instanceAutoUpdated((UAVObjHandle) & (uavo_data->metaObj), 0);
@@ -280,21 +669,27 @@ UAVObjHandle UAVObjGetByID(uint32_t id)
     // Get lock
     xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
 
-    // Look for object
-    UAVO_LIST_ITERATE(tmp_obj)
-    if (tmp_obj->id == id) {
-        found_obj = (UAVObjHandle *)tmp_obj;
-        goto unlock_exit;
-    }
-    if (MetaObjectId(tmp_obj->id) == id) {
-        found_obj = (UAVObjHandle *)&(tmp_obj->metaObj);
-        goto unlock_exit;
+    // Probe the hash index (object and metaobject share one slot)
+    uint32_t slot = hashObjectId(id);
+    for (uint32_t probe = 0; probe < UAVOBJ_HASH_NUM_SLOTS; probe++) {
+        struct UAVOData *tmp_obj = objHashTable[slot];
+        if (tmp_obj == NULL) {
+            // Hit an empty slot, the object is not registered
+            break;
+        }
+        if (tmp_obj->id == id) {
+            found_obj = (UAVObjHandle *)tmp_obj;
+            break;
+        }
+        if (MetaObjectId(tmp_obj->id) == id) {
+            found_obj = (UAVObjHandle *)&(tmp_obj->metaObj);
+            break;
+        }
+        slot = (slot + 1) & (UAVOBJ_HASH_NUM_SLOTS - 1);
     }
-}
 
-unlock_exit:
-xSemaphoreGiveRecursive(mutex);
-return found_obj;
+    xSemaphoreGiveRecursive(mutex);
+    return found_obj;
 }
 
 /**
@@ -522,6 +917,14 @@ int32_t UAVObjUnpack(UAVObjHandle obj_handle, uint16_t instId, const uint8_t *da
         // Cast handle to object
         obj = (struct UAVOData *)obj_handle;
 
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+        // The first write to a flash backed settings object attaches
+        // permanent RAM storage to it
+        if (obj->base.flags.isFlashBacked && settingsMakeResident(obj) != 0) {
+            goto unlock_exit;
+        }
+#endif
+
         // Get the instance
         instEntry = getInstance(obj, instId);
 
@@ -532,8 +935,18 @@ int32_t UAVObjUnpack(UAVObjHandle obj_handle, uint16_t instId, const uint8_t *da
                 goto unlock_exit;
             }
         }
-        // Set the data
-        memcpy(InstanceData(instEntry), dataIn, obj->instance_size);
+        // Set the data, tracking whether a settings object actually changed
+        if (obj->base.flags.isSettings &&
+            memcmp(InstanceData(instEntry), dataIn, obj->instance_size) != 0) {
+            obj->base.flags.isDirty = true;
+        }
+        /*
+         * Copied in short interrupt-off chunks so the generated scalar
+         * field accessors can read single fields through
+         * UAVObjGetDataPointer() without taking the manager mutex and
+         * still never observe a half written field.
+         */
+        copyDataChunked(InstanceData(instEntry), dataIn, obj->instance_size);
     }
 
     // Fire event
@@ -579,7 +992,7 @@ int32_t UAVObjPack(UAVObjHandle obj_handle, uint16_t instId, uint8_t *dataOut)
             goto unlock_exit;
         }
         // Pack data
-        memcpy(dataOut, InstanceData(instEntry), obj->instance_size);
+        copyData(dataOut, InstanceData(instEntry), obj->instance_size);
     }
 
     rc = 0;
@@ -629,6 +1042,99 @@ unlock_exit:
     return crc;
 }
 
+/**
+ * Compute a CRC-32 digest over the data of a settings object.
+ *
+ * The GCS computes the same digest over its local profile and only
+ * transfers the objects whose digest differs, so a settings rollout
+ * does not re-send objects the vehicle already holds.
+ * \param[in] obj The object handle
+ * \return The digest, or 0 if the object is not a settings object
+ */
+uint32_t UAVObjGetSettingsCRC(UAVObjHandle obj_handle)
+{
+    PIOS_Assert(obj_handle);
+
+    uint32_t crc = 0;
+
+    // Lock
+    xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+
+    if (UAVObjIsSettings(obj_handle)) {
+        struct UAVOData *obj = (struct UAVOData *)obj_handle;
+        InstanceHandle instEntry;
+        uint16_t instId = 0;
+
+        // Settings objects are normally single instance, but walk all
+        // instances so multi instance settings digest correctly
+        while ((instEntry = getInstance(obj, instId)) != NULL) {
+            crc = PIOS_CRC32_updateCRC(crc, (uint8_t *)InstanceData(instEntry), (int32_t)obj->instance_size);
+            instId++;
+        }
+    }
+
+    xSemaphoreGiveRecursive(mutex);
+    return crc;
+}
+
+/**
+ * Stream the object's data directly out of the instance storage.
+ *
+ * The writer is invoked on the instance data in place, without an
+ * intermediate copy, and the supplied CRC is updated over the very same
+ * bytes in the same critical section.  This is the zero-copy transmit
+ * path used by UAVTalk for high-rate objects.
+ * \param[in] obj The object handle
+ * \param[in] instId The instance ID
+ * \param[in] writer Output function the data is handed to
+ * \param[in,out] crc CRC to update over the streamed bytes
+ * \return The writer's return value (bytes written) or -1 if failure
+ */
+int32_t UAVObjStreamInstanceData(UAVObjHandle obj_handle, uint16_t instId, UAVObjStreamWriter writer, uint8_t *crc)
+{
+    PIOS_Assert(obj_handle);
+    PIOS_Assert(writer);
+
+    // Lock
+    xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+
+    int32_t rc = -1;
+    uint8_t *data;
+    int32_t length;
+
+    if (UAVObjIsMetaobject(obj_handle)) {
+        if (instId != 0) {
+            goto unlock_exit;
+        }
+        data   = (uint8_t *)MetaDataPtr((struct UAVOMeta *)obj_handle);
+        length = MetaNumBytes;
+    } else {
+        struct UAVOData *obj;
+        InstanceHandle instEntry;
+
+        // Cast handle to object
+        obj = (struct UAVOData *)obj_handle;
+
+        // Get the instance
+        instEntry = getInstance(obj, instId);
+        if (instEntry == NULL) {
+            goto unlock_exit;
+        }
+        data   = (uint8_t *)InstanceData(instEntry);
+        length = (int32_t)obj->instance_size;
+    }
+
+    // Update the CRC over the exact bytes that are sent
+    *crc = PIOS_CRC_updateCRC(*crc, data, length);
+
+    // Hand the instance data to the writer without copying it
+    rc   = writer(data, length);
+
+unlock_exit:
+    xSemaphoreGiveRecursive(mutex);
+    return rc;
+}
+
 /**
  * Actually write the object's data to the logfile
  * \param[in] obj The object handle
@@ -696,6 +1202,40 @@ xSemaphoreGiveRecursive(mutex);
 return rc;
 }
 
+/**
+ * Save only the settings objects that have been modified since they were
+ * last saved or loaded.  Objects are marked dirty by the Set/Unpack data
+ * paths and cleaned again by UAVObjSave/UAVObjLoad, so this skips the
+ * (typically large) majority of untouched objects and their flash write
+ * cycles.
+ * @return 0 if success or -1 if failure
+ */
+int32_t UAVObjSaveDirtySettings()
+{
+    // Get lock
+    xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+
+    int32_t rc = -1;
+
+    // Save all modified settings objects
+    UAVO_LIST_ITERATE(obj)
+    // Check if this is a modified settings object
+    if (UAVObjIsSettings(obj) && obj->base.flags.isDirty) {
+        // Save object
+        if (UAVObjSave((UAVObjHandle)obj, 0) ==
+            -1) {
+            goto unlock_exit;
+        }
+    }
+}
+
+rc = 0;
+
+unlock_exit:
+xSemaphoreGiveRecursive(mutex);
+return rc;
+}
+
 /**
  * Load all settings objects from the SD card.
  * @return 0 if success or -1 if failure
@@ -756,6 +1296,125 @@ xSemaphoreGiveRecursive(mutex);
 return rc;
 }
 
+/** RAM shadow copy of every settings object, laid out in iteration order */
+static uint8_t *settingsSnapshot;
+static bool settingsSnapshotValid;
+
+/**
+ * Allocate the snapshot arena.  Settings objects are single instance and
+ * all registered at boot, so the total size never changes and the arena
+ * can be reused for every later snapshot.
+ */
+static uint8_t *allocSettingsSnapshot()
+{
+    uint32_t totalSize = 0;
+
+    UAVO_LIST_ITERATE(obj)
+    if (UAVObjIsSettings(obj)) {
+        totalSize += obj->instance_size;
+    }
+}
+
+return (uint8_t *)pios_malloc(totalSize);
+}
+
+/**
+ * Copy the data of all settings objects into a single RAM arena so a tuning
+ * experiment can be rolled back with UAVObjRevertSettings() without touching
+ * the flash.  The arena is sized on the first call and reused afterwards,
+ * snapshotting is then just one copy per object.
+ * @return 0 if success or -1 if failure
+ */
+int32_t UAVObjSnapshotSettings()
+{
+    // Get lock
+    xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+
+    int32_t rc = -1;
+
+    if (!settingsSnapshot) {
+        settingsSnapshot = allocSettingsSnapshot();
+        if (!settingsSnapshot) {
+            goto unlock_exit;
+        }
+    }
+
+    uint8_t *shadow = settingsSnapshot;
+
+    // Copy all settings objects into the arena
+    UAVO_LIST_ITERATE(obj)
+    if (UAVObjIsSettings(obj)) {
+        InstanceHandle instEntry = getInstance(obj, 0);
+        if (instEntry == NULL) {
+            goto unlock_exit;
+        }
+        copyData(shadow, InstanceData(instEntry), obj->instance_size);
+        shadow += obj->instance_size;
+    }
+}
+
+settingsSnapshotValid = true;
+rc = 0;
+
+unlock_exit:
+xSemaphoreGiveRecursive(mutex);
+return rc;
+}
+
+/**
+ * Restore all settings objects from the snapshot taken by
+ * UAVObjSnapshotSettings().  Unchanged objects are skipped, changed ones
+ * are marked dirty and fire EV_UNPACKED just like a telemetry update so
+ * every consumer picks up the reverted values.
+ * @return 0 if success or -1 if failure (no valid snapshot)
+ */
+int32_t UAVObjRevertSettings()
+{
+    // Get lock
+    xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+
+    int32_t rc = -1;
+
+    if (!settingsSnapshotValid) {
+        goto unlock_exit;
+    }
+
+    uint8_t *shadow = settingsSnapshot;
+
+    // Restore all settings objects from the arena
+    UAVO_LIST_ITERATE(obj)
+    if (UAVObjIsSettings(obj)) {
+        InstanceHandle instEntry = getInstance(obj, 0);
+        if (instEntry == NULL) {
+            goto unlock_exit;
+        }
+        if (memcmp(InstanceData(instEntry), shadow, obj->instance_size) != 0) {
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+            // Reverting modifies the object, it has to be resident
+            if (obj->base.flags.isFlashBacked) {
+                if (settingsMakeResident(obj) != 0) {
+                    goto unlock_exit;
+                }
+                instEntry = getInstance(obj, 0);
+            }
+#endif
+            obj->base.flags.isDirty = true;
+            // Chunked interrupt-off copy for the lockless field
+            // readers, same contract as UAVObjUnpack()
+            copyDataChunked(InstanceData(instEntry), shadow, obj->instance_size);
+            sendEvent((struct UAVOBase *)obj, 0, EV_UNPACKED);
+        }
+        shadow += obj->instance_size;
+    }
+}
+
+rc = 0;
+
+unlock_exit:
+xSemaphoreGiveRecursive(mutex);
+return rc;
+}
+
 /**
  * Save all metaobjects to the SD card.
  * @return 0 if success or -1 if failure
@@ -881,6 +1540,45 @@ int32_t UAVObjGetDataField(UAVObjHandle obj_handle, void *dataOut, uint32_t offs
     return UAVObjGetInstanceDataField(obj_handle, 0, dataOut, offset, size);
 }
 
+/**
+ * Get a pointer to the instance 0 data of a data object.
+ * Object storage is never freed, so the returned pointer stays valid for
+ * the lifetime of the system.  This backs the generated scalar field
+ * accessors: reads through it are only consistent for a single field
+ * copied inside PIOS_IRQ_Disable()/PIOS_IRQ_Enable(), because writers
+ * update the data under the same interrupt-off window rather than a lock
+ * shared with the reader.  The call itself must be made with interrupts
+ * enabled: fetching the pointer can take the manager mutex and fault a
+ * flash backed object in, and it returns NULL when that fails.
+ * \param[in] obj The object handle
+ * \return pointer to the instance 0 data, NULL on failure
+ */
+const void *UAVObjGetDataPointer(UAVObjHandle obj_handle)
+{
+    PIOS_Assert(obj_handle);
+    PIOS_Assert(!UAVObjIsMetaobject(obj_handle));
+
+    if (UAVObjIsSingleInstance(obj_handle)) {
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+        struct UAVOData *obj = (struct UAVOData *)obj_handle;
+        if (obj->base.flags.isFlashBacked) {
+            /* Callers hold the returned pointer without the manager
+             * lock, so the data cannot live in an evictable cache
+             * slot: make the object resident */
+            xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+            int32_t rc = settingsMakeResident(obj);
+            xSemaphoreGiveRecursive(mutex);
+            if (rc != 0) {
+                return NULL;
+            }
+            return ((struct UAVOSingleFlash *)obj)->data;
+        }
+#endif /* ifdef PIOS_UAVOBJ_FLASH_SETTINGS */
+        return ObjSingleInstanceDataOffset(obj_handle);
+    }
+    return InstanceDataOffset(&(((struct UAVOMulti *)obj_handle)->instance0));
+}
+
 /**
  * Set the data of a specific object instance
  * \param[in] obj The object handle
@@ -914,13 +1612,24 @@ int32_t UAVObjSetInstanceData(UAVObjHandle obj_handle, uint16_t instId,
         if (UAVObjReadOnly(obj_handle)) {
             goto unlock_exit;
         }
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+        // A write needs permanent RAM storage, see UAVObjUnpack
+        if (obj->base.flags.isFlashBacked && settingsMakeResident(obj) != 0) {
+            goto unlock_exit;
+        }
+#endif
         // Get instance information
         instEntry = getInstance(obj, instId);
         if (instEntry == NULL) {
             goto unlock_exit;
         }
-        // Set data
-        memcpy(InstanceData(instEntry), dataIn, obj->instance_size);
+        // Set data, tracking whether a settings object actually changed
+        if (obj->base.flags.isSettings &&
+            memcmp(InstanceData(instEntry), dataIn, obj->instance_size) != 0) {
+            obj->base.flags.isDirty = true;
+        }
+        // Chunked interrupt-off copy for the lockless field readers, see UAVObjUnpack
+        copyDataChunked(InstanceData(instEntry), dataIn, obj->instance_size);
     }
 
     // Fire event
@@ -973,6 +1682,13 @@ int32_t UAVObjSetInstanceDataField(UAVObjHandle obj_handle, uint16_t instId, con
             goto unlock_exit;
         }
 
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+        // A write needs permanent RAM storage, see UAVObjUnpack
+        if (obj->base.flags.isFlashBacked && settingsMakeResident(obj) != 0) {
+            goto unlock_exit;
+        }
+#endif
+
         // Get instance information
         instEntry = getInstance(obj, instId);
         if (instEntry == NULL) {
@@ -984,8 +1700,15 @@ int32_t UAVObjSetInstanceDataField(UAVObjHandle obj_handle, uint16_t instId, con
             goto unlock_exit;
         }
 
-        // Set data
+        // Set data, tracking whether a settings object actually changed
+        if (obj->base.flags.isSettings &&
+            memcmp(InstanceData(instEntry) + offset, dataIn, size) != 0) {
+            obj->base.flags.isDirty = true;
+        }
+        // Interrupts off during the copy for the lockless field readers, see UAVObjUnpack
+        PIOS_IRQ_Disable();
         memcpy(InstanceData(instEntry) + offset, dataIn, size);
+        PIOS_IRQ_Enable();
     }
 
 
@@ -1035,7 +1758,7 @@ int32_t UAVObjGetInstanceData(UAVObjHandle obj_handle, uint16_t instId,
             goto unlock_exit;
         }
         // Set data
-        memcpy(dataOut, InstanceData(instEntry), obj->instance_size);
+        copyData(dataOut, InstanceData(instEntry), obj->instance_size);
     }
 
     rc = 0;
@@ -1576,7 +2299,7 @@ static InstanceHandle createInstance(struct UAVOData *obj, uint16_t instId)
 
     /* Create the actual instance */
     uint32_t size = sizeof(struct UAVOMultiInst) + obj->instance_size;
-    instEntry = (struct UAVOMultiInst *)pios_malloc(size);
+    instEntry = (struct UAVOMultiInst *)arenaAlloc(size);
     if (!instEntry) {
         return NULL;
     }
@@ -1614,6 +2337,19 @@ InstanceHandle getInstance(struct UAVOData *obj, uint16_t instId)
             return NULL;
         }
 
+#ifdef PIOS_UAVOBJ_FLASH_SETTINGS
+        if (obj->base.flags.isFlashBacked) {
+            struct UAVOSingleFlash *uavo_flash = (struct UAVOSingleFlash *)obj;
+            if (obj->base.flags.isResident) {
+                return uavo_flash->data;
+            }
+            /* Serve the data from the settings cache.  The returned
+             * pointer is only stable while the manager lock is held. */
+            struct UAVOCacheSlot *slot = settingsCacheLookup(obj, true);
+            return slot ? slot->buf : NULL;
+        }
+#endif /* ifdef PIOS_UAVOBJ_FLASH_SETTINGS */
+
         /* Augment our pointer to reflect the proper type */
         struct UAVOSingle *uavo_single = (struct UAVOSingle *)obj;
         return &(uavo_single->instance0);
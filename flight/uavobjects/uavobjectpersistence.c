@@ -52,19 +52,30 @@ int32_t UAVObjSave(UAVObjHandle obj_handle, uint16_t instId)
             return -1;
         }
     } else {
+        // Hold the manager lock so a cache served instance pointer
+        // stays valid across the flash transaction
+        objLock();
+
         InstanceHandle instEntry = getInstance((struct UAVOData *)obj_handle, instId);
 
         if (instEntry == NULL) {
+            objUnlock();
             return -1;
         }
 
         if (InstanceData(instEntry) == NULL) {
+            objUnlock();
             return -1;
         }
 
         if (PIOS_FLASHFS_ObjSave(pios_uavo_settings_fs_id, UAVObjGetID(obj_handle), instId, InstanceData(instEntry), UAVObjGetNumBytes(obj_handle)) != 0) {
+            objUnlock();
             return -1;
         }
+
+        // The flash copy is up to date again
+        ((struct UAVOBase *)obj_handle)->flags.isDirty = false;
+        objUnlock();
     }
     return 0;
 }
@@ -94,16 +105,25 @@ int32_t UAVObjLoad(UAVObjHandle obj_handle, uint16_t instId)
             return -1;
         }
     } else {
+        // Hold the manager lock so a cache served instance pointer
+        // stays valid across the flash transaction
+        objLock();
+
         InstanceHandle instEntry = getInstance((struct UAVOData *)obj_handle, instId);
 
         if (instEntry == NULL) {
+            objUnlock();
             return -1;
         }
 
         // Fire event on success
         if (PIOS_FLASHFS_ObjLoad(pios_uavo_settings_fs_id, UAVObjGetID(obj_handle), instId, InstanceData(instEntry), UAVObjGetNumBytes(obj_handle)) == 0) {
+            // The object now matches its flash copy
+            ((struct UAVOBase *)obj_handle)->flags.isDirty = false;
             sendEvent((struct UAVOBase *)obj_handle, instId, EV_UNPACKED);
+            objUnlock();
         } else {
+            objUnlock();
             return -1;
         }
     }
@@ -112,6 +132,28 @@ int32_t UAVObjLoad(UAVObjHandle obj_handle, uint16_t instId)
     return 0;
 }
 
+/**
+ * Read the stored copy of an object from the file system into a caller
+ * supplied buffer, without touching the object's instance data and
+ * without firing any event.  This backs the settings cache of the
+ * object manager, which serves reads of flash resident settings objects
+ * straight from their stored copy.
+ * @param[in] obj The object handle.
+ * @param[in] instId The object instance
+ * @param[out] dataOut Buffer of at least UAVObjGetNumBytes() bytes
+ * @return 0 if success or -1 if failure
+ */
+int32_t UAVObjReadData(UAVObjHandle obj_handle, uint16_t instId, void *dataOut)
+{
+    PIOS_Assert(obj_handle);
+    PIOS_Assert(dataOut);
+
+    if (PIOS_FLASHFS_ObjLoad(pios_uavo_settings_fs_id, UAVObjGetID(obj_handle), instId, (uint8_t *)dataOut, UAVObjGetNumBytes(obj_handle)) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
 /**
  * Delete an object from the file system (SD card).
  * @param[in] obj The object handle.
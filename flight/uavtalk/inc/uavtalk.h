@@ -44,6 +44,7 @@ typedef struct {
     uint32_t rxErrors;
     uint32_t rxSyncErrors;
     uint32_t rxCrcErrors;
+    uint32_t rxResyncs;
 } UAVTalkStats;
 
 typedef void *UAVTalkConnection;
@@ -57,8 +58,11 @@ UAVTalkOutputStream UAVTalkGetOutputStream(UAVTalkConnection connection);
 int32_t UAVTalkSendObject(UAVTalkConnection connection, UAVObjHandle obj, uint16_t instId, uint8_t acked, int32_t timeoutMs);
 int32_t UAVTalkSendObjectTimestamped(UAVTalkConnection connectionHandle, UAVObjHandle obj, uint16_t instId, uint8_t acked, int32_t timeoutMs);
 int32_t UAVTalkSendObjectRequest(UAVTalkConnection connection, UAVObjHandle obj, uint16_t instId, int32_t timeoutMs);
+int32_t UAVTalkSendObjectBatch(UAVTalkConnection connection, const UAVObjHandle *objs, const uint16_t *instIds, uint32_t numObjs);
+int32_t UAVTalkEnableDeltaEncoding(UAVTalkConnection connection, UAVObjHandle obj);
 UAVTalkRxState UAVTalkProcessInputStream(UAVTalkConnection connection, uint8_t rxbyte);
 UAVTalkRxState UAVTalkProcessInputStreamQuiet(UAVTalkConnection connection, uint8_t rxbyte);
+void UAVTalkProcessInputSpan(UAVTalkConnection connection, const uint8_t *data, uint16_t length);
 int32_t UAVTalkRelayPacket(UAVTalkConnection inConnectionHandle, UAVTalkConnection outConnectionHandle);
 int32_t UAVTalkReceiveObject(UAVTalkConnection connectionHandle);
 void UAVTalkGetStats(UAVTalkConnection connection, UAVTalkStats *stats, bool reset);
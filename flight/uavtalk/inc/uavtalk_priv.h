@@ -50,6 +50,8 @@ typedef struct {
     uint8_t  type;
     uint16_t packet_size;
     uint32_t objId;
+    // handle looked up when the object ID is complete, null when unknown
+    UAVObjHandle obj;
     uint16_t instId;
     uint32_t length;
     uint8_t  timestampLength;
@@ -60,6 +62,20 @@ typedef struct {
     uint16_t rxPacketLength;
 } UAVTalkInputProcessor;
 
+#define UAVTALK_DELTA_MAX_OBJECTS        4
+#define UAVTALK_DELTA_KEYFRAME_INTERVAL  16
+#define UAVTALK_DELTA_RECORD_OVERHEAD    3
+
+// Per-object state for delta-encoded transmission
+typedef struct {
+    uint32_t objId;
+    UAVObjHandle obj;
+    uint8_t  *shadow; /* snapshot the receiver is known to hold */
+    uint8_t  *scratch; /* packing area for the current data */
+    uint16_t numBytes;
+    uint8_t  framesSinceKey;
+} UAVTalkDeltaEntry;
+
 typedef struct {
     uint8_t canari;
     UAVTalkOutputStream outStream;
@@ -73,6 +89,14 @@ typedef struct {
     UAVTalkInputProcessor iproc;
     uint8_t      *rxBuffer;
     uint8_t      *txBuffer;
+    UAVTalkDeltaEntry deltaEntries[UAVTALK_DELTA_MAX_OBJECTS];
+    uint8_t      numDeltaEntries;
+    // Ack owed to the peer, held back briefly so it can ride the next
+    // outgoing data frame instead of costing a frame of its own
+    bool         ackPending;
+    uint32_t     ackObjId;
+    uint16_t     ackInstId;
+    portTickType ackTime;
 } UAVTalkConnectionData;
 
 #define UAVTALK_CANARI          0xCA
@@ -86,9 +110,34 @@ typedef struct {
 #define UAVTALK_TYPE_OBJ_ACK    (UAVTALK_TYPE_VER | 0x02)
 #define UAVTALK_TYPE_ACK        (UAVTALK_TYPE_VER | 0x03)
 #define UAVTALK_TYPE_NACK       (UAVTALK_TYPE_VER | 0x04)
+// Container frame carrying several object payloads under one header/CRC.
+// The objId/instId header fields are unused (sent as zero); the payload
+// is a sequence of [objId(4) instId(2) data(object size)] records.
+#define UAVTALK_TYPE_OBJ_BATCH  (UAVTALK_TYPE_VER | 0x05)
 #define UAVTALK_TYPE_OBJ_TS     (UAVTALK_TIMESTAMPED | UAVTALK_TYPE_OBJ)
 #define UAVTALK_TYPE_OBJ_ACK_TS (UAVTALK_TIMESTAMPED | UAVTALK_TYPE_OBJ_ACK)
 
+// Per-record overhead inside a batch frame payload
+#define UAVTALK_BATCH_RECORD_OVERHEAD 6
+
+// Delta frame carrying only the byte ranges of the object that changed
+// since the last transmitted snapshot.  The payload is a sequence of
+// [offset(2) length(1) bytes...] records applied on top of the
+// receiver's copy of the object.  Full keyframes are interleaved so a
+// receiver joining mid-stream converges.
+#define UAVTALK_TYPE_OBJ_DELTA  (UAVTALK_TYPE_VER | 0x06)
+
+// Ordinary object frame whose payload is prefixed with an ack record
+// [ackObjId(4) ackInstId(2)], acknowledging an earlier OBJ_ACK from the
+// peer without spending a standalone ACK frame.
+#define UAVTALK_TYPE_OBJ_WITH_ACK     (UAVTALK_TYPE_VER | 0x07)
+
+#define UAVTALK_ACK_RECORD_LENGTH     6
+
+// How long an owed ack may wait for a data frame to ride on before it
+// is flushed standalone; must stay well below the peer's retry timeout
+#define UAVTALK_ACK_FLUSH_MS          50
+
 // macros
 #define CHECKCONHANDLE(handle, variable, failcommand) \
     variable = (UAVTalkConnectionData *)handle; \
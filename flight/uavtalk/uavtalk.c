@@ -52,7 +52,12 @@ static int32_t objectTransaction(UAVTalkConnectionData *connection, uint8_t type
 static int32_t sendObject(UAVTalkConnectionData *connection, uint8_t type, uint32_t objId, uint16_t instId, UAVObjHandle obj);
 static int32_t sendSingleObject(UAVTalkConnectionData *connection, uint8_t type, uint32_t objId, uint16_t instId, UAVObjHandle obj);
 static int32_t receiveObject(UAVTalkConnectionData *connection, uint8_t type, uint32_t objId, uint16_t instId, uint8_t *data);
+static int32_t receiveObjectBatch(UAVTalkConnectionData *connection, uint8_t *data, uint32_t length);
+static int32_t receiveObjectDelta(UAVTalkConnectionData *connection, UAVObjHandle obj, uint16_t instId, uint8_t *data, uint32_t length);
+static UAVTalkDeltaEntry *findDeltaEntry(UAVTalkConnectionData *connection, uint32_t objId);
+static int32_t sendSingleObjectDelta(UAVTalkConnectionData *connection, UAVTalkDeltaEntry *entry, uint16_t instId);
 static void updateAck(UAVTalkConnectionData *connection, uint8_t type, uint32_t objId, uint16_t instId);
+static void queueAck(UAVTalkConnectionData *connection, uint32_t objId, uint16_t instId);
 
 /**
  * Initialize the UAVTalk library
@@ -84,6 +89,8 @@ UAVTalkConnection UAVTalkInitialize(UAVTalkOutputStream outputStream)
     if (!connection->txBuffer) {
         return 0;
     }
+    connection->numDeltaEntries = 0;
+    connection->ackPending      = false;
     vSemaphoreCreateBinary(connection->respSema);
     xSemaphoreTake(connection->respSema, 0); // reset to zero
     UAVTalkResetStats((UAVTalkConnection)connection);
@@ -179,6 +186,7 @@ void UAVTalkAddStats(UAVTalkConnection connectionHandle, UAVTalkStats *statsOut,
     statsOut->rxErrors      += connection->stats.rxErrors;
     statsOut->rxSyncErrors  += connection->stats.rxSyncErrors;
     statsOut->rxCrcErrors   += connection->stats.rxCrcErrors;
+    statsOut->rxResyncs     += connection->stats.rxResyncs;
 
     if (reset) {
         // Clear stats
@@ -347,6 +355,161 @@ static int32_t objectTransaction(UAVTalkConnectionData *connection, uint8_t type
     return ret;
 }
 
+/**
+ * Enable delta encoding for a single-instance object on this connection.
+ *
+ * Subsequent unacked sends of the object only carry the byte ranges that
+ * changed since the previous transmission, with a full keyframe every
+ * UAVTALK_DELTA_KEYFRAME_INTERVAL frames.  The receiver must understand
+ * UAVTALK_TYPE_OBJ_DELTA, so only enable this on links where the peer is
+ * known to support it.
+ * \param[in] connection UAVTalkConnection to be used
+ * \param[in] obj Object to delta-encode (single instance only)
+ * \return 0 Success
+ * \return -1 Failure (table full, out of memory or multi-instance object)
+ */
+int32_t UAVTalkEnableDeltaEncoding(UAVTalkConnection connectionHandle, UAVObjHandle obj)
+{
+    UAVTalkConnectionData *connection;
+
+    CHECKCONHANDLE(connectionHandle, connection, return -1);
+
+    if (!UAVObjIsSingleInstance(obj)) {
+        return -1;
+    }
+
+    xSemaphoreTakeRecursive(connection->lock, portMAX_DELAY);
+
+    int32_t ret = -1;
+
+    if (connection->numDeltaEntries < UAVTALK_DELTA_MAX_OBJECTS && !findDeltaEntry(connection, UAVObjGetID(obj))) {
+        UAVTalkDeltaEntry *entry = &connection->deltaEntries[connection->numDeltaEntries];
+        entry->numBytes = UAVObjGetNumBytes(obj);
+        // one allocation holding the shadow snapshot and the packing area
+        entry->shadow   = pios_malloc(2 * entry->numBytes);
+        if (entry->shadow) {
+            entry->scratch = entry->shadow + entry->numBytes;
+            entry->objId   = UAVObjGetID(obj);
+            entry->obj     = obj;
+            // force an initial keyframe
+            entry->framesSinceKey = UAVTALK_DELTA_KEYFRAME_INTERVAL;
+            connection->numDeltaEntries++;
+            ret = 0;
+        }
+    }
+
+    xSemaphoreGiveRecursive(connection->lock);
+    return ret;
+}
+
+/**
+ * Look up the delta encoding state for an object ID, NULL if not enabled.
+ */
+static UAVTalkDeltaEntry *findDeltaEntry(UAVTalkConnectionData *connection, uint32_t objId)
+{
+    for (uint8_t i = 0; i < connection->numDeltaEntries; i++) {
+        if (connection->deltaEntries[i].objId == objId) {
+            return &connection->deltaEntries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Send several objects in one container frame with a single header and CRC.
+ *
+ * Per-object framing overhead (sync, type, size, objId, instId, CRC) eats
+ * a large share of the airtime on narrowband radio links when many small
+ * objects update together; packing them under one header roughly doubles
+ * the effective throughput.  The receiver must understand
+ * UAVTALK_TYPE_OBJ_BATCH, so only use this on links where the peer is
+ * known to support it.
+ * \param[in] connection UAVTalkConnection to be used
+ * \param[in] objs Array of object handles to send
+ * \param[in] instIds Array of instance IDs, one per object
+ * \param[in] numObjs Number of objects in the arrays
+ * \return 0 Success
+ * \return -1 Failure (nothing sent)
+ */
+int32_t UAVTalkSendObjectBatch(UAVTalkConnection connectionHandle, const UAVObjHandle *objs, const uint16_t *instIds, uint32_t numObjs)
+{
+    UAVTalkConnectionData *connection;
+
+    CHECKCONHANDLE(connectionHandle, connection, return -1);
+
+    if (numObjs == 0) {
+        return -1;
+    }
+
+    xSemaphoreTakeRecursive(connection->lock, portMAX_DELAY);
+
+    int32_t ret = -1;
+
+    if (!connection->outStream) {
+        connection->stats.txErrors++;
+        goto unlock_exit;
+    }
+
+    // Setup sync byte and type
+    connection->txBuffer[0] = UAVTALK_SYNC_VAL;
+    connection->txBuffer[1] = UAVTALK_TYPE_OBJ_BATCH;
+    // next 2 bytes are reserved for data length (inserted here later)
+    // The objId/instId header fields are unused in a batch frame
+    memset(&connection->txBuffer[4], 0, 6);
+    int32_t length = UAVTALK_MIN_HEADER_LENGTH;
+
+    // Append one record per object: objId(4) instId(2) data
+    for (uint32_t i = 0; i < numObjs; i++) {
+        uint32_t objId     = UAVObjGetID(objs[i]);
+        int32_t objLength = UAVObjGetNumBytes(objs[i]);
+
+        // The whole payload must fit the receive side's payload limit
+        if ((length + UAVTALK_BATCH_RECORD_OVERHEAD + objLength - UAVTALK_MIN_HEADER_LENGTH) >= UAVTALK_MAX_PAYLOAD_LENGTH) {
+            connection->stats.txErrors++;
+            goto unlock_exit;
+        }
+
+        connection->txBuffer[length++] = (uint8_t)(objId & 0xFF);
+        connection->txBuffer[length++] = (uint8_t)((objId >> 8) & 0xFF);
+        connection->txBuffer[length++] = (uint8_t)((objId >> 16) & 0xFF);
+        connection->txBuffer[length++] = (uint8_t)((objId >> 24) & 0xFF);
+        connection->txBuffer[length++] = (uint8_t)(instIds[i] & 0xFF);
+        connection->txBuffer[length++] = (uint8_t)((instIds[i] >> 8) & 0xFF);
+
+        if (UAVObjPack(objs[i], instIds[i], &connection->txBuffer[length]) == -1) {
+            connection->stats.txErrors++;
+            goto unlock_exit;
+        }
+        length += objLength;
+    }
+
+    // Store the packet length
+    connection->txBuffer[2] = (uint8_t)(length & 0xFF);
+    connection->txBuffer[3] = (uint8_t)((length >> 8) & 0xFF);
+
+    // Calculate and store the single checksum covering all records
+    connection->txBuffer[length] = PIOS_CRC_updateCRC(0, connection->txBuffer, length);
+
+    // Send the frame
+    uint16_t tx_msg_len = length + UAVTALK_CHECKSUM_LENGTH;
+    int32_t rc = (*connection->outStream)(connection->txBuffer, tx_msg_len);
+
+    // Update stats
+    if (rc == tx_msg_len) {
+        connection->stats.txObjects     += numObjs;
+        connection->stats.txObjectBytes += length - UAVTALK_MIN_HEADER_LENGTH;
+        connection->stats.txBytes       += tx_msg_len;
+        ret = 0;
+    } else {
+        connection->stats.txErrors++;
+        connection->stats.txBytes += (rc > 0) ? rc : 0;
+    }
+
+unlock_exit:
+    xSemaphoreGiveRecursive(connection->lock);
+    return ret;
+}
+
 /**
  * Process an byte from the telemetry stream.
  * \param[in] connectionHandle UAVTalkConnection to be used
@@ -364,6 +527,11 @@ UAVTalkRxState UAVTalkProcessInputStreamQuiet(UAVTalkConnection connectionHandle
     ++connection->stats.rxBytes;
 
     if (iproc->state == UAVTALK_STATE_ERROR || iproc->state == UAVTALK_STATE_COMPLETE) {
+        if (iproc->state == UAVTALK_STATE_ERROR) {
+            // a frame died after its sync byte was accepted, the parser
+            // re-enters sync hunting
+            connection->stats.rxResyncs++;
+        }
         iproc->state = UAVTALK_STATE_SYNC;
     }
 
@@ -443,6 +611,23 @@ UAVTalkRxState UAVTalkProcessInputStreamQuiet(UAVTalkConnection connectionHandle
         }
         iproc->rxCount = 0;
 
+        // Look the object up as soon as its ID is complete; fixed length
+        // frames of a known object imply their exact packet size, so a
+        // corrupt header (or a false sync in a corrupt stream) can be
+        // rejected here instead of committing to the frame.  Unknown IDs
+        // must keep parsing, a NACK may be owed for them.
+        iproc->obj = UAVObjGetByID(iproc->objId);
+        if (iproc->obj && (iproc->type == UAVTALK_TYPE_OBJ || iproc->type == UAVTALK_TYPE_OBJ_TS
+                           || iproc->type == UAVTALK_TYPE_OBJ_ACK || iproc->type == UAVTALK_TYPE_OBJ_ACK_TS)) {
+            uint16_t expected_size = UAVTALK_MIN_HEADER_LENGTH + ((iproc->type & UAVTALK_TIMESTAMPED) ? 2 : 0) + UAVObjGetNumBytes(iproc->obj);
+            if (iproc->packet_size != expected_size) {
+                // packet error - mismatched packet size
+                connection->stats.rxErrors++;
+                iproc->state = UAVTALK_STATE_ERROR;
+                break;
+            }
+        }
+
         iproc->instId  = 0;
         iproc->state   = UAVTALK_STATE_INSTID;
         break;
@@ -458,7 +643,7 @@ UAVTalkRxState UAVTalkProcessInputStreamQuiet(UAVTalkConnection connectionHandle
         }
         iproc->rxCount = 0;
 
-        UAVObjHandle obj = UAVObjGetByID(iproc->objId);
+        UAVObjHandle obj = iproc->obj;
 
         // Determine data length
         if (iproc->type == UAVTALK_TYPE_OBJ_REQ || iproc->type == UAVTALK_TYPE_ACK || iproc->type == UAVTALK_TYPE_NACK) {
@@ -466,9 +651,12 @@ UAVTalkRxState UAVTalkProcessInputStreamQuiet(UAVTalkConnection connectionHandle
             iproc->timestampLength = 0;
         } else {
             iproc->timestampLength = (iproc->type & UAVTALK_TIMESTAMPED) ? 2 : 0;
-            if (obj) {
+            if (obj && iproc->type != UAVTALK_TYPE_OBJ_DELTA && iproc->type != UAVTALK_TYPE_OBJ_BATCH
+                && iproc->type != UAVTALK_TYPE_OBJ_WITH_ACK) {
                 iproc->length = UAVObjGetNumBytes(obj);
             } else {
+                // unknown objects and variable-length frame types carry
+                // their payload length in the packet size
                 iproc->length = iproc->packet_size - iproc->rxPacketLength - iproc->timestampLength;
             }
         }
@@ -589,6 +777,52 @@ UAVTalkRxState UAVTalkProcessInputStream(UAVTalkConnection connectionHandle, uin
     return state;
 }
 
+/**
+ * Process a span of bytes from the telemetry stream, dispatching every
+ * completed packet.  While the parser is hunting for a frame start the
+ * span is scanned for the sync byte in a single memchr() pass (which the
+ * libc vectorizes) instead of taking the state machine once per garbage
+ * byte, so a corrupt stream on a noisy link burns far less CPU resyncing.
+ * \param[in] connectionHandle UAVTalkConnection to be used
+ * \param[in] data Received bytes
+ * \param[in] length Number of received bytes
+ */
+void UAVTalkProcessInputSpan(UAVTalkConnection connectionHandle, const uint8_t *data, uint16_t length)
+{
+    UAVTalkConnectionData *connection;
+
+    CHECKCONHANDLE(connectionHandle, connection, return );
+
+    UAVTalkInputProcessor *iproc = &connection->iproc;
+
+    uint16_t pos = 0;
+    while (pos < length) {
+        if (iproc->state == UAVTALK_STATE_ERROR || iproc->state == UAVTALK_STATE_COMPLETE) {
+            if (iproc->state == UAVTALK_STATE_ERROR) {
+                // a frame died after its sync byte was accepted, the
+                // parser re-enters sync hunting
+                connection->stats.rxResyncs++;
+            }
+            iproc->state = UAVTALK_STATE_SYNC;
+        }
+        if (iproc->state == UAVTALK_STATE_SYNC) {
+            const uint8_t *sync = memchr(&data[pos], UAVTALK_SYNC_VAL, length - pos);
+            // garbage bytes are accounted exactly as the byte-wise
+            // parser would have
+            uint16_t skipped    = sync ? (uint16_t)(sync - &data[pos]) : (uint16_t)(length - pos);
+            connection->stats.rxBytes      += skipped;
+            connection->stats.rxSyncErrors += skipped;
+            if (!sync) {
+                return;
+            }
+            pos += skipped;
+        }
+        if (UAVTalkProcessInputStreamQuiet(connectionHandle, data[pos++]) == UAVTALK_STATE_COMPLETE) {
+            UAVTalkReceiveObject(connectionHandle);
+        }
+    }
+}
+
 /**
  * Send a parsed packet received on one connection handle out on a different connection handle.
  * The packet must be in a complete state, meaning it is completed parsing.
@@ -739,6 +973,12 @@ static int32_t receiveObject(UAVTalkConnectionData *connection, uint8_t type, ui
     // Lock
     xSemaphoreTakeRecursive(connection->lock, portMAX_DELAY);
 
+    // Flush a piggyback ack that has waited too long for a data frame
+    if (connection->ackPending && (((xTaskGetTickCount() - connection->ackTime) * portTICK_RATE_MS) >= UAVTALK_ACK_FLUSH_MS)) {
+        connection->ackPending = false;
+        sendObject(connection, UAVTALK_TYPE_ACK, connection->ackObjId, connection->ackInstId, NULL);
+    }
+
     // Get the handle to the object. Will be null if object does not exist.
     // Warning :
     // Here we ask for instance ID 0 without taking into account the provided instId
@@ -774,8 +1014,9 @@ static int32_t receiveObject(UAVTalkConnectionData *connection, uint8_t type, ui
             // Unpack object, if the instance does not exist it will be created!
             if (UAVObjUnpack(obj, instId, data) == 0) {
                 UAVT_DEBUGLOG_CPRINTF(objId, "OBJ ACK %X %d", objId, instId);
-                // Object updated or created, transmit ACK
-                sendObject(connection, UAVTALK_TYPE_ACK, objId, instId, NULL);
+                // Object updated or created, ack it on the next outgoing
+                // data frame (or standalone if none leaves in time)
+                queueAck(connection, objId, instId);
             } else {
                 ret = -1;
             }
@@ -806,6 +1047,39 @@ static int32_t receiveObject(UAVTalkConnectionData *connection, uint8_t type, ui
         }
         break;
 
+    case UAVTALK_TYPE_OBJ_BATCH:
+        // Container frame, unpack each embedded object record
+        ret = receiveObjectBatch(connection, data, connection->iproc.length);
+        break;
+
+    case UAVTALK_TYPE_OBJ_DELTA:
+        // All instances not allowed for delta frames, and the object must exist
+        if (obj && (instId != UAVOBJ_ALL_INSTANCES)) {
+            ret = receiveObjectDelta(connection, obj, instId, data, connection->iproc.length);
+        } else {
+            ret = -1;
+        }
+        break;
+
+    case UAVTALK_TYPE_OBJ_WITH_ACK:
+        // Ordinary object frame with an ack record prefixed to the payload
+        if (obj && (instId != UAVOBJ_ALL_INSTANCES) &&
+            (connection->iproc.length == (uint32_t)(UAVTALK_ACK_RECORD_LENGTH + UAVObjGetNumBytes(obj)))) {
+            uint32_t ackObjId  = data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+            uint16_t ackInstId = data[4] | (data[5] << 8);
+            // Complete a transaction waiting on the piggybacked ack
+            updateAck(connection, UAVTALK_TYPE_ACK, ackObjId, ackInstId);
+            if (UAVObjUnpack(obj, instId, &data[UAVTALK_ACK_RECORD_LENGTH]) == 0) {
+                // Like any OBJ message this can ack a pending OBJ_REQ
+                updateAck(connection, UAVTALK_TYPE_OBJ, objId, instId);
+            } else {
+                ret = -1;
+            }
+        } else {
+            ret = -1;
+        }
+        break;
+
     case UAVTALK_TYPE_NACK:
         // Do nothing on flight side, let it time out.
         // TODO:
@@ -838,12 +1112,117 @@ static int32_t receiveObject(UAVTalkConnectionData *connection, uint8_t type, ui
     return ret;
 }
 
+/**
+ * Unpack all object records contained in a batch frame.
+ * The frame CRC already passed, so a malformed record means the sender
+ * and receiver disagree on an object layout; remaining records are
+ * dropped in that case as the record boundaries can no longer be trusted.
+ * \param[in] connection UAVTalkConnection to be used
+ * \param[in] data Payload buffer holding the records
+ * \param[in] length Payload length
+ * \return 0 Success
+ * \return -1 Failure
+ */
+static int32_t receiveObjectBatch(UAVTalkConnectionData *connection, uint8_t *data, uint32_t length)
+{
+    uint32_t offset = 0;
+
+    while ((offset + UAVTALK_BATCH_RECORD_OVERHEAD) <= length) {
+        uint32_t objId  = data[offset] | (data[offset + 1] << 8) | (data[offset + 2] << 16) | ((uint32_t)data[offset + 3] << 24);
+        uint16_t instId = data[offset + 4] | (data[offset + 5] << 8);
+        offset += UAVTALK_BATCH_RECORD_OVERHEAD;
+
+        UAVObjHandle obj = UAVObjGetByID(objId);
+        if (!obj) {
+            connection->stats.rxErrors++;
+            return -1;
+        }
+
+        uint32_t objLength = UAVObjGetNumBytes(obj);
+        if ((offset + objLength) > length || instId == UAVOBJ_ALL_INSTANCES) {
+            connection->stats.rxErrors++;
+            return -1;
+        }
+
+        if (UAVObjUnpack(obj, instId, &data[offset]) != 0) {
+            connection->stats.rxErrors++;
+            return -1;
+        }
+        offset += objLength;
+        connection->stats.rxObjects++;
+    }
+
+    return (offset == length) ? 0 : -1;
+}
+
+/**
+ * Apply a delta frame on top of the receiver's copy of the object.
+ * \param[in] connection UAVTalkConnection to be used
+ * \param[in] obj Object the delta applies to
+ * \param[in] instId The instance ID
+ * \param[in] data Payload buffer holding the change records
+ * \param[in] length Payload length
+ * \return 0 Success
+ * \return -1 Failure
+ */
+static int32_t receiveObjectDelta(UAVTalkConnectionData *connection, UAVObjHandle obj, uint16_t instId, uint8_t *data, uint32_t length)
+{
+    uint32_t numBytes = UAVObjGetNumBytes(obj);
+    uint32_t pos      = 0;
+
+    while ((pos + UAVTALK_DELTA_RECORD_OVERHEAD) <= length) {
+        uint16_t offset = data[pos] | (data[pos + 1] << 8);
+        uint8_t  runLen = data[pos + 2];
+        pos += UAVTALK_DELTA_RECORD_OVERHEAD;
+
+        if (runLen == 0 || (pos + runLen) > length || ((uint32_t)offset + runLen) > numBytes) {
+            connection->stats.rxErrors++;
+            return -1;
+        }
+
+        if (UAVObjSetInstanceDataField(obj, instId, &data[pos], offset, runLen) != 0) {
+            connection->stats.rxErrors++;
+            return -1;
+        }
+        pos += runLen;
+    }
+
+    if (pos != length) {
+        connection->stats.rxErrors++;
+        return -1;
+    }
+
+    return 0;
+}
+
 /**
  * Check if an ack is pending on an object and give response semaphore
  * \param[in] connection UAVTalkConnection to be used
  * \param[in] obj Object
  * \param[in] instId The instance ID of UAVOBJ_ALL_INSTANCES for all instances.
  */
+/**
+ * Queue an ack owed to the peer so it can be piggybacked on the next
+ * outgoing data frame.  Back-to-back acked transfers of the same object
+ * (windowed multi-instance writes) collapse into a single cumulative ack
+ * for the latest instance received; an ack owed for a different object
+ * is flushed standalone before the new one takes the slot.
+ * \param[in] connection UAVTalkConnection to be used
+ * \param[in] objId The object ID to acknowledge
+ * \param[in] instId The instance ID to acknowledge
+ */
+static void queueAck(UAVTalkConnectionData *connection, uint32_t objId, uint16_t instId)
+{
+    if (connection->ackPending && (connection->ackObjId != objId)) {
+        connection->ackPending = false;
+        sendObject(connection, UAVTALK_TYPE_ACK, connection->ackObjId, connection->ackInstId, NULL);
+    }
+    connection->ackPending = true;
+    connection->ackObjId   = objId;
+    connection->ackInstId  = instId;
+    connection->ackTime    = xTaskGetTickCount();
+}
+
 static void updateAck(UAVTalkConnectionData *connection, uint8_t type, uint32_t objId, uint16_t instId)
 {
     if ((connection->respObjId == objId) && (connection->respType == type)) {
@@ -928,6 +1307,35 @@ static int32_t sendSingleObject(UAVTalkConnectionData *connection, uint8_t type,
         return -1;
     }
 
+    // An owed ack either rides this frame (ordinary full object frames
+    // only) or is flushed on its own right before it, so it never waits
+    // past the next outgoing frame
+    uint8_t ackLength = 0;
+    if (connection->ackPending && (type != UAVTALK_TYPE_ACK)) {
+        if ((type == UAVTALK_TYPE_OBJ) && (findDeltaEntry(connection, objId) == NULL)
+            && ((UAVObjGetNumBytes(obj) + UAVTALK_ACK_RECORD_LENGTH) <= UAVOBJECTS_LARGEST)) {
+            ackLength = UAVTALK_ACK_RECORD_LENGTH;
+        } else {
+            connection->ackPending = false;
+            sendSingleObject(connection, UAVTALK_TYPE_ACK, connection->ackObjId, connection->ackInstId, NULL);
+        }
+    }
+
+    // Use the delta path for unacked sends of delta-enabled objects
+    UAVTalkDeltaEntry *deltaEntry = NULL;
+    if (type == UAVTALK_TYPE_OBJ && instId == 0) {
+        deltaEntry = findDeltaEntry(connection, objId);
+        if (deltaEntry) {
+            int32_t rc = sendSingleObjectDelta(connection, deltaEntry, instId);
+            if (rc != 1) {
+                // delta frame sent (or failed), done either way
+                return rc;
+            }
+            // keyframe due, fall through to a full frame; the scratch
+            // buffer already holds the packed current data
+        }
+    }
+
     // Setup sync byte
     connection->txBuffer[0] = UAVTALK_SYNC_VAL;
     // Setup type
@@ -951,6 +1359,19 @@ static int32_t sendSingleObject(UAVTalkConnectionData *connection, uint8_t type,
         headerLength += 2;
     }
 
+    if (ackLength > 0) {
+        // Piggyback the owed ack as a payload prefix
+        connection->txBuffer[1] = UAVTALK_TYPE_OBJ_WITH_ACK;
+        connection->txBuffer[headerLength]     = (uint8_t)(connection->ackObjId & 0xFF);
+        connection->txBuffer[headerLength + 1] = (uint8_t)((connection->ackObjId >> 8) & 0xFF);
+        connection->txBuffer[headerLength + 2] = (uint8_t)((connection->ackObjId >> 16) & 0xFF);
+        connection->txBuffer[headerLength + 3] = (uint8_t)((connection->ackObjId >> 24) & 0xFF);
+        connection->txBuffer[headerLength + 4] = (uint8_t)(connection->ackInstId & 0xFF);
+        connection->txBuffer[headerLength + 5] = (uint8_t)((connection->ackInstId >> 8) & 0xFF);
+        headerLength += ackLength;
+        connection->ackPending = false;
+    }
+
     // Determine data length
     int32_t length;
     if (type == UAVTALK_TYPE_OBJ_REQ || type == UAVTALK_TYPE_ACK || type == UAVTALK_TYPE_NACK) {
@@ -965,30 +1386,57 @@ static int32_t sendSingleObject(UAVTalkConnectionData *connection, uint8_t type,
         return -1;
     }
 
-    // Copy data (if any)
-    if (length > 0) {
-        if (UAVObjPack(obj, instId, &connection->txBuffer[headerLength]) == -1) {
-            connection->stats.txErrors++;
-            return -1;
-        }
-    }
-
     // Store the packet length
     connection->txBuffer[2] = (uint8_t)((headerLength + length) & 0xFF);
     connection->txBuffer[3] = (uint8_t)(((headerLength + length) >> 8) & 0xFF);
 
-    // Calculate and store checksum
-    connection->txBuffer[headerLength + length] = PIOS_CRC_updateCRC(0, connection->txBuffer, headerLength + length);
-
-    // Send object
     uint16_t tx_msg_len = headerLength + length + UAVTALK_CHECKSUM_LENGTH;
-    int32_t rc = (*connection->outStream)(connection->txBuffer, tx_msg_len);
+    int32_t rc;
+
+    if (deltaEntry && length > 0) {
+        // Keyframe for a delta-enabled object: send the snapshot already
+        // packed in the scratch buffer so the shadow copy matches the
+        // transmitted bytes exactly, even if the object changes meanwhile.
+        memcpy(&connection->txBuffer[headerLength], deltaEntry->scratch, length);
+        connection->txBuffer[headerLength + length] = PIOS_CRC_updateCRC(0, connection->txBuffer, headerLength + length);
+        rc = (*connection->outStream)(connection->txBuffer, tx_msg_len);
+    } else if (length > 0) {
+        // Scatter-gather send: the header and checksum are staged in the
+        // txBuffer but the object payload is streamed straight out of the
+        // instance storage (under the object lock), skipping the
+        // intermediate UAVObjPack() copy on every data frame.
+        uint8_t cs = PIOS_CRC_updateCRC(0, connection->txBuffer, headerLength);
+
+        rc = (*connection->outStream)(connection->txBuffer, headerLength);
+        if (rc == headerLength) {
+            int32_t sent = UAVObjStreamInstanceData(obj, instId, connection->outStream, &cs);
+            if (sent == length) {
+                rc += sent;
+                connection->txBuffer[0] = cs;
+                int32_t cs_sent = (*connection->outStream)(connection->txBuffer, UAVTALK_CHECKSUM_LENGTH);
+                rc += (cs_sent > 0) ? cs_sent : 0;
+            } else {
+                rc += (sent > 0) ? sent : 0;
+            }
+        }
+    } else {
+        // Calculate and store checksum
+        connection->txBuffer[headerLength] = PIOS_CRC_updateCRC(0, connection->txBuffer, headerLength);
+
+        // Send object
+        rc = (*connection->outStream)(connection->txBuffer, tx_msg_len);
+    }
 
     // Update stats
     if (rc == tx_msg_len) {
         ++connection->stats.txObjects;
         connection->stats.txObjectBytes += length;
         connection->stats.txBytes += tx_msg_len;
+        if (deltaEntry) {
+            // this full frame is the new keyframe the receiver holds
+            memcpy(deltaEntry->shadow, deltaEntry->scratch, deltaEntry->numBytes);
+            deltaEntry->framesSinceKey = 0;
+        }
     } else {
         connection->stats.txErrors++;
         // TODO rc == -1 connection not open, -2 buffer full should retry
@@ -1000,6 +1448,91 @@ static int32_t sendSingleObject(UAVTalkConnectionData *connection, uint8_t type,
     return 0;
 }
 
+/**
+ * Send a delta frame for a delta-enabled object.
+ * \param[in] connection UAVTalkConnection to be used
+ * \param[in] entry Delta state of the object
+ * \param[in] instId The instance ID (only 0 is supported)
+ * \return 0 Success (delta frame sent)
+ * \return 1 Keyframe due, caller must send a full frame
+ * \return -1 Failure
+ */
+static int32_t sendSingleObjectDelta(UAVTalkConnectionData *connection, UAVTalkDeltaEntry *entry, uint16_t instId)
+{
+    // Snapshot the current object data
+    if (UAVObjPack(entry->obj, instId, entry->scratch) == -1) {
+        connection->stats.txErrors++;
+        return -1;
+    }
+
+    if (entry->framesSinceKey >= UAVTALK_DELTA_KEYFRAME_INTERVAL) {
+        return 1;
+    }
+
+    // Setup sync byte, type, object ID and instance ID
+    connection->txBuffer[0] = UAVTALK_SYNC_VAL;
+    connection->txBuffer[1] = UAVTALK_TYPE_OBJ_DELTA;
+    connection->txBuffer[4] = (uint8_t)(entry->objId & 0xFF);
+    connection->txBuffer[5] = (uint8_t)((entry->objId >> 8) & 0xFF);
+    connection->txBuffer[6] = (uint8_t)((entry->objId >> 16) & 0xFF);
+    connection->txBuffer[7] = (uint8_t)((entry->objId >> 24) & 0xFF);
+    connection->txBuffer[8] = (uint8_t)(instId & 0xFF);
+    connection->txBuffer[9] = (uint8_t)((instId >> 8) & 0xFF);
+    int32_t length = UAVTALK_MIN_HEADER_LENGTH;
+
+    // Emit one [offset(2) length(1) bytes] record per changed byte run
+    uint16_t offset = 0;
+    while (offset < entry->numBytes) {
+        if (entry->scratch[offset] == entry->shadow[offset]) {
+            offset++;
+            continue;
+        }
+        // find the run of changed bytes, up to the 255 byte record limit
+        uint16_t runStart = offset;
+        while (offset < entry->numBytes && entry->scratch[offset] != entry->shadow[offset] && (offset - runStart) < 0xFF) {
+            offset++;
+        }
+        uint16_t runLen = offset - runStart;
+
+        // fall back to a keyframe when the delta stops paying off
+        if ((length + UAVTALK_DELTA_RECORD_OVERHEAD + runLen - UAVTALK_MIN_HEADER_LENGTH) >= entry->numBytes) {
+            return 1;
+        }
+
+        connection->txBuffer[length++] = (uint8_t)(runStart & 0xFF);
+        connection->txBuffer[length++] = (uint8_t)((runStart >> 8) & 0xFF);
+        connection->txBuffer[length++] = (uint8_t)runLen;
+        memcpy(&connection->txBuffer[length], &entry->scratch[runStart], runLen);
+        length += runLen;
+    }
+
+    // Store the packet length
+    connection->txBuffer[2] = (uint8_t)(length & 0xFF);
+    connection->txBuffer[3] = (uint8_t)((length >> 8) & 0xFF);
+
+    // Calculate and store checksum
+    connection->txBuffer[length] = PIOS_CRC_updateCRC(0, connection->txBuffer, length);
+
+    // Send the frame
+    uint16_t tx_msg_len = length + UAVTALK_CHECKSUM_LENGTH;
+    int32_t rc = (*connection->outStream)(connection->txBuffer, tx_msg_len);
+
+    // Update stats
+    if (rc == tx_msg_len) {
+        ++connection->stats.txObjects;
+        connection->stats.txObjectBytes += length - UAVTALK_MIN_HEADER_LENGTH;
+        connection->stats.txBytes       += tx_msg_len;
+        // the receiver now holds the current data
+        memcpy(entry->shadow, entry->scratch, entry->numBytes);
+        entry->framesSinceKey++;
+        return 0;
+    }
+
+    connection->stats.txErrors++;
+    connection->stats.txBytes += (rc > 0) ? rc : 0;
+    return -1;
+}
+
 /**
  * @}
  * @}
@@ -130,6 +130,8 @@ const char *fixedOptionsC = " [OPTION]... [FILE]...\n"
                             "    -help               Display this help\n"
                             "    -version            Display application version\n"
                             "    -no-splash          Don't display splash screen\n"
+                            "    -headless           Don't display the GUI and only load the plugins needed to\n"
+                            "                        record telemetry (see the LoggingGadget plugin options)\n"
                             "    -client             Attempt to connect to already running instance\n"
                             "    -D <key>=<value>    Permanently set a user setting, e.g: -D General/OverrideLanguage=de\n"
                             "    -reset              Reset user settings to factory defaults.\n"
@@ -142,6 +144,7 @@ const QLatin1String HELP3_OPTION("/h");
 const QLatin1String HELP4_OPTION("--help");
 const QLatin1String VERSION_OPTION("-version");
 const QLatin1String NO_SPLASH_OPTION("-no-splash");
+const QLatin1String HEADLESS_OPTION("-headless");
 const QLatin1String CLIENT_OPTION("-client");
 const QLatin1String CONFIG_OPTION("-D");
 const QLatin1String RESET_OPTION("-reset");
@@ -335,6 +338,7 @@ AppOptions options()
     appOptions.insert(HELP4_OPTION, false);
     appOptions.insert(VERSION_OPTION, false);
     appOptions.insert(NO_SPLASH_OPTION, false);
+    appOptions.insert(HEADLESS_OPTION, false);
     appOptions.insert(CLIENT_OPTION, false);
     appOptions.insert(CONFIG_OPTION, true);
     appOptions.insert(RESET_OPTION, false);
@@ -537,9 +541,26 @@ int main(int argc, char * *argv)
         return 0;
     }
 
+    // headless mode: no GUI, minimal plugin set, used for field telemetry recording
+    if (appOptionValues.contains(HEADLESS_OPTION)) {
+        qDebug() << "main - headless mode";
+        // the Core plugin checks this property to keep the main window hidden
+        app.setProperty("headless", true);
+        // only the plugins needed to connect and record telemetry,
+        // their dependencies are pulled in automatically
+        pluginManager.setPluginWhitelist(QStringList()
+                                         << QLatin1String("Core")
+                                         << QLatin1String("UAVObjects")
+                                         << QLatin1String("UAVTalk")
+                                         << QLatin1String("LoggingGadget")
+                                         << QLatin1String("Serial")
+                                         << QLatin1String("opHID")
+                                         << QLatin1String("IPconnection"));
+    }
+
     // open the splash screen
     GCSSplashScreen *splash = 0;
-    if (!appOptionValues.contains(NO_SPLASH_OPTION)) {
+    if (!appOptionValues.contains(NO_SPLASH_OPTION) && !appOptionValues.contains(HEADLESS_OPTION)) {
         splash = new GCSSplashScreen();
         // show splash
         splash->showProgressMessage(QObject::tr("Application starting..."));
@@ -37,6 +37,9 @@
 #include <QtCore/QDir>
 #include <QtCore/QTextStream>
 #include <QtCore/QWriteLocker>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
 #include <QtDebug>
 #ifdef WITH_TESTS
 #include <QTest>
@@ -161,6 +164,11 @@ static bool lessThanByPluginName(const PluginSpec *one, const PluginSpec *two)
     return one->name() < two->name();
 }
 
+static bool greaterThanByStartupTime(const PluginSpec *one, const PluginSpec *two)
+{
+    return one->startupTime() > two->startupTime();
+}
+
 PluginManager *PluginManager::m_instance = 0;
 
 /*!
@@ -245,6 +253,17 @@ void PluginManager::loadPlugins()
     return d->loadPlugins();
 }
 
+/*!
+    \fn void PluginManager::loadDeferredPlugins()
+    Loads the plugins that were split off the startup queue because they
+    are marked deferred. Invoked from the event loop after loadPlugins().
+    \internal
+ */
+void PluginManager::loadDeferredPlugins()
+{
+    d->loadDeferredPlugins();
+}
+
 /*!
     \fn QStringList PluginManager::pluginPaths() const
     The list of paths were the plugin manager searches for plugins.
@@ -294,6 +313,18 @@ void PluginManager::setFileExtension(const QString &extension)
     d->extension = extension;
 }
 
+/*!
+    \fn void PluginManager::setPluginWhitelist(const QStringList &names)
+    Restricts the set of plugins that loadPlugins() will load to the plugins
+    named in \a names plus everything they (transitively) depend on.
+    An empty list (the default) loads all plugins.
+    Must be called before loadPlugins() is called.
+ */
+void PluginManager::setPluginWhitelist(const QStringList &names)
+{
+    d->whitelist = names;
+}
+
 /*!
     \fn QStringList PluginManager::arguments() const
     The arguments left over after parsing (Neither startup nor plugin
@@ -581,6 +612,83 @@ void PluginManagerPrivate::removeObject(QObject *obj)
 void PluginManagerPrivate::loadPlugins()
 {
     QList<PluginSpec *> queue = loadQueue();
+
+    // When a whitelist is set only the named plugins and their (transitive)
+    // dependencies are kept on the queue, everything else stays unloaded.
+    if (!whitelist.isEmpty()) {
+        QSet<PluginSpec *> keep;
+        QList<PluginSpec *> worklist;
+        foreach(PluginSpec * spec, queue) {
+            if (whitelist.contains(spec->name())) {
+                worklist.append(spec);
+            }
+        }
+        while (!worklist.isEmpty()) {
+            PluginSpec *spec = worklist.takeFirst();
+            if (keep.contains(spec)) {
+                continue;
+            }
+            keep.insert(spec);
+            worklist += spec->dependencySpecs();
+        }
+        QList<PluginSpec *> filtered;
+        foreach(PluginSpec * spec, queue) {
+            if (keep.contains(spec)) {
+                filtered.append(spec);
+            } else {
+                qDebug() << "Plugin" << spec->name() << "not loaded (not whitelisted)";
+            }
+        }
+        queue = filtered;
+    }
+
+    // Plugins that asked for deferred loading are split off and loaded
+    // from the event loop once the application is up, provided nothing
+    // else depends on them.
+    deferredSpecs.clear();
+    foreach(PluginSpec * spec, queue) {
+        if (spec->isDeferred() && !isDependency(spec)) {
+            deferredSpecs.append(spec);
+        }
+    }
+    foreach(PluginSpec * spec, deferredSpecs) {
+        queue.removeOne(spec);
+    }
+
+    loadPluginQueue(queue);
+    emit q->pluginsChanged();
+
+    if (deferredSpecs.isEmpty()) {
+        q->m_allPluginsLoaded = true;
+        emit q->pluginsLoadEnded();
+        printStartupProfile();
+    } else {
+        QTimer::singleShot(0, q, SLOT(loadDeferredPlugins()));
+    }
+}
+
+/*!
+    \fn void PluginManagerPrivate::loadDeferredPlugins()
+    \internal
+ */
+void PluginManagerPrivate::loadDeferredPlugins()
+{
+    loadPluginQueue(deferredSpecs);
+    deferredSpecs.clear();
+    emit q->pluginsChanged();
+    q->m_allPluginsLoaded = true;
+    emit q->pluginsLoadEnded();
+    printStartupProfile();
+}
+
+/*!
+    \fn void PluginManagerPrivate::loadPluginQueue(const QList<PluginSpec *> &queue)
+    Takes all plugins in the already dependency sorted \a queue through the
+    Loaded, Initialized and Running states.
+    \internal
+ */
+void PluginManagerPrivate::loadPluginQueue(const QList<PluginSpec *> &queue)
+{
     foreach(PluginSpec * spec, queue) {
         loadPlugin(spec, PluginSpec::Loaded);
     }
@@ -594,9 +702,43 @@ void PluginManagerPrivate::loadPlugins()
         emit q->pluginAboutToBeLoaded(plugin);
         loadPlugin(plugin, PluginSpec::Running);
     }
-    emit q->pluginsChanged();
-    q->m_allPluginsLoaded = true;
-    emit q->pluginsLoadEnded();
+}
+
+/*!
+    \fn bool PluginManagerPrivate::isDependency(PluginSpec *spec) const
+    Whether any other plugin declares a dependency on \a spec.
+    \internal
+ */
+bool PluginManagerPrivate::isDependency(PluginSpec *spec) const
+{
+    foreach(PluginSpec * other, pluginSpecs) {
+        if (other != spec && other->dependencySpecs().contains(spec)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+    \fn void PluginManagerPrivate::printStartupProfile() const
+    Prints the startup timeline to the debug log, most expensive
+    plugin first.
+    \internal
+ */
+void PluginManagerPrivate::printStartupProfile() const
+{
+    QList<PluginSpec *> specs = pluginSpecs;
+    qSort(specs.begin(), specs.end(), greaterThanByStartupTime);
+
+    int total = 0;
+    foreach(PluginSpec * spec, specs) {
+        total += spec->startupTime();
+    }
+    qDebug("Plugin startup profile, total %dms:", total);
+    foreach(PluginSpec * spec, specs) {
+        qDebug("%8dms %s%s", spec->startupTime(), qPrintable(spec->name()),
+               spec->isDeferred() ? " (deferred)" : "");
+    }
 }
 
 /*!
@@ -664,18 +806,25 @@ bool PluginManagerPrivate::loadQueue(PluginSpec *spec, QList<PluginSpec *> &queu
  */
 void PluginManagerPrivate::loadPlugin(PluginSpec *spec, PluginSpec::State destState)
 {
+    QElapsedTimer timer;
+
     if (spec->hasError()) {
         return;
     }
     if (destState == PluginSpec::Running) {
+        timer.start();
         spec->d->initializeExtensions();
+        spec->d->startupTime += timer.elapsed();
         return;
     } else if (destState == PluginSpec::Deleted) {
         spec->d->kill();
         return;
     }
     foreach(PluginSpec * depSpec, spec->dependencySpecs()) {
-        if (depSpec->state() != destState) {
+        // a dependency that is already fully running satisfies any of the
+        // startup phases, which is the case when this plugin was deferred
+        if (depSpec->state() != destState
+            && !(depSpec->state() == PluginSpec::Running && destState < PluginSpec::Running)) {
             spec->d->hasError    = true;
             spec->d->errorString =
                 PluginManager::tr("Cannot load plugin because dependency failed to load: %1(%2)\nReason: %3")
@@ -684,9 +833,13 @@ void PluginManagerPrivate::loadPlugin(PluginSpec *spec, PluginSpec::State destSt
         }
     }
     if (destState == PluginSpec::Loaded) {
+        timer.start();
         spec->d->loadLibrary();
+        spec->d->startupTime += timer.elapsed();
     } else if (destState == PluginSpec::Initialized) {
+        timer.start();
         spec->d->initializePlugin();
+        spec->d->startupTime += timer.elapsed();
     } else if (destState == PluginSpec::Stopped) {
         spec->d->stop();
     }
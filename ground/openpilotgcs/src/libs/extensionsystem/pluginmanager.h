@@ -101,6 +101,7 @@ public:
     QList<PluginSpec *> plugins() const;
     void setFileExtension(const QString &extension);
     QString fileExtension() const;
+    void setPluginWhitelist(const QStringList &names);
 
     // command line arguments
     QStringList arguments() const;
@@ -124,6 +125,7 @@ signals:
     void pluginsLoadEnded();
 private slots:
     void startTests();
+    void loadDeferredPlugins();
 
 private:
     Internal::PluginManagerPrivate *d;
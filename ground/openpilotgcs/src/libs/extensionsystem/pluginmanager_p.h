@@ -53,6 +53,7 @@ public:
 
     // Plugin operations
     void loadPlugins();
+    void loadDeferredPlugins();
     void setPluginPaths(const QStringList &paths);
     QList<PluginSpec *> loadQueue();
     void loadPlugin(PluginSpec *spec, PluginSpec::State destState);
@@ -66,6 +67,9 @@ public:
 
     QStringList arguments;
 
+    // when not empty, only these plugins and their dependencies are loaded
+    QStringList whitelist;
+
     // Look in argument descriptions of the specs for the option.
     PluginSpec *pluginForOption(const QString &option, bool *requiresArgument) const;
     PluginSpec *pluginByName(const QString &name) const;
@@ -80,7 +84,14 @@ private:
     bool loadQueue(PluginSpec *spec,
                    QList<PluginSpec *> &queue,
                    QList<PluginSpec *> &circularityCheckQueue);
+    void loadPluginQueue(const QList<PluginSpec *> &queue);
+    bool isDependency(PluginSpec *spec) const;
+    void printStartupProfile() const;
     void stopAll();
+
+    // deferred plugins split off the startup queue, loaded from the
+    // event loop once the rest of the application is up
+    QList<PluginSpec *> deferredSpecs;
 };
 } // namespace Internal
 } // namespace ExtensionSystem
@@ -232,6 +232,27 @@ QList<PluginDependency> PluginSpec::dependencies() const
     return d->dependencies;
 }
 
+/*!
+    \fn bool PluginSpec::isDeferred() const
+    True if the plugin requested deferred loading via deferred="true" in its
+    xml description. This is valid after the PluginSpec::Read state is reached.
+ */
+bool PluginSpec::isDeferred() const
+{
+    return d->deferred;
+}
+
+/*!
+    \fn int PluginSpec::startupTime() const
+    The time in milliseconds that was spent loading and initializing the
+    plugin, summed over all load phases. This is valid after the
+    PluginSpec::Running state is reached.
+ */
+int PluginSpec::startupTime() const
+{
+    return d->startupTime;
+}
+
 /*!
     \fn PluginSpec::PluginArgumentDescriptions PluginSpec::argumentDescriptions() const
     Returns a list of descriptions of command line arguments the plugin processes.
@@ -362,6 +383,7 @@ const char *const PLUGIN = "plugin";
 const char *const PLUGIN_NAME    = "name";
 const char *const PLUGIN_VERSION = "version";
 const char *const PLUGIN_COMPATVERSION = "compatVersion";
+const char *const PLUGIN_DEFERRED      = "deferred";
 const char *const VENDOR             = "vendor";
 const char *const COPYRIGHT          = "copyright";
 const char *const LICENSE            = "license";
@@ -384,6 +406,8 @@ PluginSpecPrivate::PluginSpecPrivate(PluginSpec *spec)
     : plugin(0),
     state(PluginSpec::Invalid),
     hasError(false),
+    deferred(false),
+    startupTime(0),
     q(spec)
 {}
 
@@ -406,6 +430,8 @@ bool PluginSpecPrivate::read(const QString &fileName)
     state       = PluginSpec::Invalid;
     hasError    = false;
     errorString = "";
+    deferred    = false;
+    startupTime = 0;
     dependencies.clear();
     QFile file(fileName);
     if (!file.exists()) {
@@ -508,6 +534,7 @@ void PluginSpecPrivate::readPluginSpec(QXmlStreamReader &reader)
     } else if (compatVersion.isEmpty()) {
         compatVersion = version;
     }
+    deferred = (reader.attributes().value(PLUGIN_DEFERRED).toString() == QLatin1String("true"));
     while (!reader.atEnd()) {
         reader.readNext();
         switch (reader.tokenType()) {
@@ -94,6 +94,14 @@ public:
     // linked plugin instance, valid after 'Loaded' state is reached
     IPlugin *plugin() const;
 
+    // true if the plugin asked to be loaded after the main window is up
+    // (deferred="true" on the plugin element), only honored when no other
+    // plugin depends on it
+    bool isDeferred() const;
+
+    // milliseconds spent loading and initializing this plugin at startup
+    int startupTime() const;
+
     // state
     State state() const;
     bool hasError() const;
@@ -77,6 +77,9 @@ public:
     bool hasError;
     QString errorString;
 
+    bool deferred;
+    int startupTime; // ms, summed over the load/initialize/extensions phases
+
     static bool isValidVersion(const QString &version);
     static int versionCompare(const QString &version1, const QString &version2);
 
@@ -125,9 +125,11 @@ void PluginView::updateList()
                                                     << spec->name()
                                                     << QString("%1 (%2)").arg(spec->version()).arg(spec->compatVersion())
                                                     << spec->vendor()
-                                                    << QDir::toNativeSeparators(spec->filePath()));
+                                                    << QDir::toNativeSeparators(spec->filePath())
+                                                    << tr("%1 ms").arg(spec->startupTime()));
 
         item->setToolTip(4, QDir::toNativeSeparators(spec->filePath()));
+        item->setTextAlignment(5, Qt::AlignRight);
         item->setIcon(0, spec->hasError() ? errorIcon : okIcon);
         item->setData(0, Qt::UserRole, qVariantFromValue(spec));
         items.append(item);
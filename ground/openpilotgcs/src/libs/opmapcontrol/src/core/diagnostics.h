@@ -36,9 +36,11 @@ struct diagnostics {
     int     tilesFromMem;
     int     tilesFromNet;
     int     tilesFromDB;
+    int     memCacheMisses;
+    int     dbCacheMisses;
     QString toString()
     {
-        return QString("Network errors:%1\nEmpty Tiles:%2\nTimeOuts:%3\nRunningThreads:%4\nTilesFromMem:%5\nTilesFromNet:%6\nTilesFromDB:%7").arg(networkerrors).arg(emptytiles).arg(timeouts).arg(runningThreads).arg(tilesFromMem).arg(tilesFromNet).arg(tilesFromDB);
+        return QString("Network errors:%1\nEmpty Tiles:%2\nTimeOuts:%3\nRunningThreads:%4\nTilesFromMem:%5\nTilesFromNet:%6\nTilesFromDB:%7\nMemCacheMisses:%8\nDBCacheMisses:%9").arg(networkerrors).arg(emptytiles).arg(timeouts).arg(runningThreads).arg(tilesFromMem).arg(tilesFromNet).arg(tilesFromDB).arg(memCacheMisses).arg(dbCacheMisses);
 
         ;
     }
@@ -44,9 +44,20 @@ void KiberTileCache::setMemoryCacheCapacity(const int &value)
 int KiberTileCache::MemoryCacheCapacity()
 {
     kiberCacheLock.lockForRead();
-    return _MemoryCacheCapacity;
-
+    int value = _MemoryCacheCapacity;
     kiberCacheLock.unlock();
+    return value;
+}
+
+/**
+ * Move a tile to the back of the eviction queue, so that eviction drops the
+ * least recently used tile instead of the oldest one.
+ * Must be called with the owning MemoryCache lock held for writing.
+ */
+void KiberTileCache::TouchTile(const RawTile &tile)
+{
+    list.removeOne(tile);
+    list.enqueue(tile);
 }
 
 void KiberTileCache::RemoveMemoryOverload()
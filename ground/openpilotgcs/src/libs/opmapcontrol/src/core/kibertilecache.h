@@ -44,6 +44,7 @@ public:
     {
         return memoryCacheSize / 1048576.0;
     }
+    void TouchTile(const RawTile &tile);
     void RemoveMemoryOverload();
     QReadWriteLock kiberCacheLock;
     QHash <RawTile, QByteArray> cachequeue;
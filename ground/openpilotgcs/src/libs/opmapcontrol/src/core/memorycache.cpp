@@ -34,24 +34,30 @@ MemoryCache::MemoryCache()
 
 QByteArray MemoryCache::GetTileFromMemoryCache(const RawTile &tile)
 {
-    kiberCacheLock.lockForRead();
+    kiberCacheLock.lockForWrite();
     QByteArray pic;
     pic = TilesInMemory.cachequeue.value(tile);
-    // TilesInMemory.find(key,&pic);
+    if (!pic.isEmpty()) {
+        // hits move the tile to the back of the eviction queue
+        TilesInMemory.TouchTile(tile);
+    }
     kiberCacheLock.unlock();
     return pic;
 }
 void MemoryCache::AddTileToMemoryCache(const RawTile &tile, const QByteArray &pic)
 {
     kiberCacheLock.lockForWrite();
-    // QPixmapCache::Key key=TilesInMemory.insert(pic);
-    TilesInMemory.memoryCacheSize += pic.size();
+    if (!TilesInMemory.cachequeue.contains(tile)) {
+        TilesInMemory.memoryCacheSize += pic.size();
 #ifdef DEBUG_MEMORY_CACHE
-    qDebug() << "Current memory=" << TilesInMemory.memoryCacheSize << " in " << TilesInMemory.cachequeue.count() << " tiles";
+        qDebug() << "Current memory=" << TilesInMemory.memoryCacheSize << " in " << TilesInMemory.cachequeue.count() << " tiles";
 #endif
-    TilesInMemory.cachequeue.insert(tile, pic);
-    TilesInMemory.list.enqueue(tile);
-
+        TilesInMemory.cachequeue.insert(tile, pic);
+        TilesInMemory.list.enqueue(tile);
+        // evict as tiles are added, so the cache never overshoots its
+        // memory budget by a whole load batch
+        TilesInMemory.RemoveMemoryOverload();
+    }
     kiberCacheLock.unlock();
 }
 }
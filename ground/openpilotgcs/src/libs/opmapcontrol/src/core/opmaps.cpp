@@ -68,11 +68,13 @@ QByteArray OPMaps::GetImageFrom(const MapType::Types &type, const Point &pos, co
         qDebug() << "Try Tile from memory:Size=" << TilesInMemory.MemoryCacheSize();
 #endif // DEBUG_GMAPS
         ret = GetTileFromMemoryCache(RawTile(type, pos, zoom));
+        errorvars.lock();
         if (!ret.isEmpty()) {
-            errorvars.lock();
             ++diag.tilesFromMem;
-            errorvars.unlock();
+        } else {
+            ++diag.memCacheMisses;
         }
+        errorvars.unlock();
     }
     if (ret.isEmpty()) {
 #ifdef DEBUG_GMAPS
@@ -83,7 +85,11 @@ QByteArray OPMaps::GetImageFrom(const MapType::Types &type, const Point &pos, co
             qDebug() << "Try tile from DataBase";
 #endif // DEBUG_GMAPS
             ret = Cache::Instance()->ImageCache.GetImageFromCache(type, pos, zoom);
-            if (!ret.isEmpty()) {
+            if (ret.isEmpty()) {
+                errorvars.lock();
+                ++diag.dbCacheMisses;
+                errorvars.unlock();
+            } else {
                 errorvars.lock();
                 ++diag.tilesFromDB;
                 errorvars.unlock();
@@ -26,6 +26,8 @@
  */
 #include "core.h"
 
+#include <QThread>
+
 #ifdef DEBUG_CORE
 qlonglong internals::Core::debugcounter = 0;
 #endif
@@ -34,12 +36,15 @@ using namespace projections;
 
 namespace internals {
 Core::Core() : MouseWheelZooming(false), currentPosition(0, 0), currentPositionPixel(0, 0), LastLocationInBounds(-1, -1), sizeOfMapArea(0, 0)
-    , minOfTiles(0, 0), maxOfTiles(0, 0), zoom(0), isDragging(false), TooltipTextPadding(10, 10), loaderLimit(5), maxzoom(21), runningThreads(0), started(false)
+    , minOfTiles(0, 0), maxOfTiles(0, 0), zoom(0), isDragging(false), TooltipTextPadding(10, 10), loaderLimit(QThread::idealThreadCount() * 2), maxzoom(21)
+    , prefetchDirection(0, 0), runningThreads(0), started(false)
 {
     mousewheelzoomtype = MouseWheelZoomType::MousePositionAndCenter;
     SetProjection(new MercatorProjection());
     this->setAutoDelete(false);
-    ProcessLoadTaskCallback.setMaxThreadCount(10);
+    // scale tile loading with the machine, fetches are mostly network and
+    // disk bound so two loaders per core keep the cores busy decoding
+    ProcessLoadTaskCallback.setMaxThreadCount(QThread::idealThreadCount() * 2);
     renderOffset = Point(0, 0);
     dragPoint    = Point(0, 0);
     CanDragMap   = true;
@@ -502,6 +507,10 @@ void Core::DragOffset(Point const & offset)
     UpdateCenterTileXYLocation();
 
     if (centerTileXYLocation != centerTileXYLocationLast) {
+        if (centerTileXYLocationLast != Point::Empty) {
+            prefetchDirection.SetX(signOfStep(centerTileXYLocation.X() - centerTileXYLocationLast.X()));
+            prefetchDirection.SetY(signOfStep(centerTileXYLocation.Y() - centerTileXYLocationLast.Y()));
+        }
         centerTileXYLocationLast = centerTileXYLocation;
         UpdateBounds();
     }
@@ -522,6 +531,10 @@ void Core::Drag(Point const & pt)
     UpdateCenterTileXYLocation();
 
     if (centerTileXYLocation != centerTileXYLocationLast) {
+        if (centerTileXYLocationLast != Point::Empty) {
+            prefetchDirection.SetX(signOfStep(centerTileXYLocation.X() - centerTileXYLocationLast.X()));
+            prefetchDirection.SetY(signOfStep(centerTileXYLocation.Y() - centerTileXYLocationLast.Y()));
+        }
         centerTileXYLocationLast = centerTileXYLocation;
         UpdateBounds();
     }
@@ -588,6 +601,27 @@ void Core::UpdateBounds()
     MtileDrawingList.unlock();
     UpdateGroundResolution();
 }
+// orders tiles by their squared distance from the view center, so the tiles
+// in the middle of the screen are loaded first
+struct TileDistanceCompare {
+    core::Point center;
+    TileDistanceCompare(const core::Point &value) : center(value) {}
+    bool operator()(const core::Point &a, const core::Point &b) const
+    {
+        int dxa = a.X() - center.X();
+        int dya = a.Y() - center.Y();
+        int dxb = b.X() - center.X();
+        int dyb = b.Y() - center.Y();
+
+        return (dxa * dxa + dya * dya) < (dxb * dxb + dyb * dyb);
+    }
+};
+
+static int signOfStep(int delta)
+{
+    return (delta > 0) ? 1 : ((delta < 0) ? -1 : 0);
+}
+
 void Core::FindTilesAround(QList<Point> &list)
 {
     list.clear();;
@@ -614,6 +648,38 @@ void Core::FindTilesAround(QList<Point> &list)
             }
         }
     }
+    // the load queue is served in order, so visible tiles closest to the
+    // view center come up first
+    qSort(list.begin(), list.end(), TileDistanceCompare(centerTileXYLocation));
+
+    // speculatively append the tiles just outside the view in the direction
+    // of the last pan, they only load once the visible tiles are queued
+    if (prefetchDirection.X() != 0) {
+        int i = (sizeOfMapArea.Width() + 1) * signOfStep(prefetchDirection.X());
+        for (int j = -sizeOfMapArea.Height(); j <= sizeOfMapArea.Height(); j++) {
+            Point p = centerTileXYLocation;
+            p.SetX(p.X() + i);
+            p.SetY(p.Y() + j);
+            if (p.X() >= minOfTiles.Width() && p.Y() >= minOfTiles.Height() && p.X() <= maxOfTiles.Width() && p.Y() <= maxOfTiles.Height()) {
+                if (!list.contains(p)) {
+                    list.append(p);
+                }
+            }
+        }
+    }
+    if (prefetchDirection.Y() != 0) {
+        int j = (sizeOfMapArea.Height() + 1) * signOfStep(prefetchDirection.Y());
+        for (int i = -sizeOfMapArea.Width(); i <= sizeOfMapArea.Width(); i++) {
+            Point p = centerTileXYLocation;
+            p.SetX(p.X() + i);
+            p.SetY(p.Y() + j);
+            if (p.X() >= minOfTiles.Width() && p.Y() >= minOfTiles.Height() && p.X() <= maxOfTiles.Width() && p.Y() <= maxOfTiles.Height()) {
+                if (!list.contains(p)) {
+                    list.append(p);
+                }
+            }
+        }
+    }
 }
 void Core::UpdateGroundResolution()
 {
@@ -324,6 +324,8 @@ private:
     core::Point renderOffset;
     core::Point centerTileXYLocation;
     core::Point centerTileXYLocationLast;
+    // tile step of the last pan, used for speculative prefetch
+    core::Point prefetchDirection;
     core::Point dragPoint;
     Rectangle tileRect;
     core::Point mouseDown;
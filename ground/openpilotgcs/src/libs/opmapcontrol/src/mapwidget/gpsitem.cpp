@@ -39,8 +39,9 @@ GPSItem::GPSItem(MapGraphicItem *map, OPMapWidget *parent, QString uavPic) : map
     this->setZValue(4);
     trail     = new QGraphicsItemGroup(this);
     trail->setParentItem(map);
-    trailLine = new QGraphicsItemGroup(this);
+    trailLine = new TrailPolylineItem(QBrush(Qt::green), map);
     trailLine->setParentItem(map);
+    connect(this, SIGNAL(setChildLine()), trailLine, SLOT(updatePathSlot()));
     this->setFlag(QGraphicsItem::ItemIgnoresTransformations, true);
     setCacheMode(QGraphicsItem::ItemCoordinateCache);
     mapfollowtype = UAVMapFollowType::None;
@@ -74,12 +75,7 @@ void GPSItem::SetUAVPos(const internals::PointLatLng &position, const int &altit
                 TrailItem *ob = new TrailItem(position, altitude, Qt::red, map);
                 trail->addToGroup(ob);
                 connect(this, SIGNAL(setChildPosition()), ob, SLOT(setPosSLOT()));
-                if (!lasttrailline.IsEmpty()) {
-                    TrailLineItem *obj = new TrailLineItem(lasttrailline, position, Qt::green, map);
-                    trailLine->addToGroup(obj);
-                    connect(this, SIGNAL(setChildLine()), obj, SLOT(setLineSlot()));
-                }
-                lasttrailline = position;
+                trailLine->addPoint(position);
                 timer.restart();
             }
         } else if (trailtype == UAVTrailType::ByDistance) {
@@ -87,13 +83,8 @@ void GPSItem::SetUAVPos(const internals::PointLatLng &position, const int &altit
                 TrailItem *ob = new TrailItem(position, altitude, Qt::red, map);
                 trail->addToGroup(ob);
                 connect(this, SIGNAL(setChildPosition()), ob, SLOT(setPosSLOT()));
-                if (!lasttrailline.IsEmpty()) {
-                    TrailLineItem *obj = new TrailLineItem(lasttrailline, position, Qt::green, map);
-                    trailLine->addToGroup(obj);
-                    connect(this, SIGNAL(setChildLine()), obj, SLOT(setLineSlot()));
-                }
-                lasttrailline = position;
-                lastcoord     = position;
+                trailLine->addPoint(position);
+                lastcoord = position;
             }
         }
         coord = position;
@@ -157,8 +148,7 @@ void GPSItem::DeleteTrail() const
 {
     foreach(QGraphicsItem * i, trail->childItems())
     delete i;
-    foreach(QGraphicsItem * i, trailLine->childItems())
-    delete i;
+    trailLine->clearPoints();
 }
 double GPSItem::Distance3D(const internals::PointLatLng &coord, const int &altitude)
 {
@@ -0,0 +1,143 @@
+/**
+ ******************************************************************************
+ *
+ * @file       maprouteprefetcher.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      A service that warms the tile caches along a planned route
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   OPMapWidget
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "maprouteprefetcher.h"
+#include <QSet>
+#include <math.h>
+namespace mapcontrol {
+MapRoutePrefetcher::MapRoutePrefetcher(internals::Core *core, QObject *parent) : QThread(parent), core(core), corridor(0), minZoom(0), maxZoom(0), bandwidthLimit(0), cancel(false)
+{}
+
+void MapRoutePrefetcher::prefetch(QList<internals::PointLatLng> const & route, double corridorMeters, int minZoom, int maxZoom, int bytesPerSec)
+{
+    if (this->isRunning() || route.isEmpty()) {
+        return;
+    }
+    this->route    = route;
+    corridor       = corridorMeters;
+    this->minZoom  = minZoom;
+    this->maxZoom  = maxZoom;
+    bandwidthLimit = bytesPerSec;
+    type   = core->GetMapType();
+    cancel = false;
+    this->start();
+}
+
+QList<core::Point> MapRoutePrefetcher::tilesForZoom(int zoomLevel) const
+{
+    QList<core::Point> list;
+    QSet<qint64> seen;
+    internals::PureProjection *projection = core->Projection();
+    internals::Size tileSize = projection->TileSize();
+    internals::Size minTile  = projection->GetTileMatrixMinXY(zoomLevel);
+    internals::Size maxTile  = projection->GetTileMatrixMaxXY(zoomLevel);
+
+    for (int i = 0; i < route.count(); i++) {
+        // Corridor half width in tiles at this latitude and zoom
+        double resolution = projection->GetGroundResolution(zoomLevel, route[i].Lat());
+        int radius = (int)ceil(corridor / (resolution * tileSize.Width()));
+        core::Point begin = projection->FromLatLngToPixel(route[i], zoomLevel);
+        core::Point end   = (i + 1 < route.count()) ? projection->FromLatLngToPixel(route[i + 1], zoomLevel) : begin;
+
+        // Walk the segment in half tile steps so no tile is stepped over
+        double dx     = end.X() - begin.X();
+        double dy     = end.Y() - begin.Y();
+        double length = sqrt(dx * dx + dy * dy);
+        int steps     = qMax(1, (int)ceil(length / (tileSize.Width() / 2)));
+        for (int s = 0; s <= steps; s++) {
+            int tileX = (begin.X() + (int)(dx * s / steps)) / tileSize.Width();
+            int tileY = (begin.Y() + (int)(dy * s / steps)) / tileSize.Height();
+            for (int x = tileX - radius; x <= tileX + radius; x++) {
+                for (int y = tileY - radius; y <= tileY + radius; y++) {
+                    if (x < minTile.Width() || x > maxTile.Width() || y < minTile.Height() || y > maxTile.Height()) {
+                        continue;
+                    }
+                    qint64 key = ((qint64)x << 32) | (quint32)y;
+                    if (!seen.contains(key)) {
+                        seen.insert(key);
+                        list.append(core::Point(x, y));
+                    }
+                }
+            }
+        }
+    }
+    return list;
+}
+
+void MapRoutePrefetcher::run()
+{
+    // Enumerate everything first so progress is reported against the
+    // full corridor rather than per zoom level
+    QList<QList<core::Point> > tiles;
+    int all = 0;
+
+    for (int zoomLevel = minZoom; zoomLevel <= maxZoom; zoomLevel++) {
+        QList<core::Point> list = tilesForZoom(zoomLevel);
+        tiles.append(list);
+        all += list.count();
+    }
+    if (all == 0) {
+        return;
+    }
+    emit numberOfTilesChanged(all, 0);
+
+    QVector<core::MapType::Types> types = OPMaps::Instance()->GetAllLayersOfType(type);
+    int done = 0;
+    for (int z = 0; z < tiles.count(); z++) {
+        int zoomLevel = minZoom + z;
+        foreach(core::Point p, tiles[z]) {
+            {
+                QMutexLocker locker(&mutex);
+
+                if (cancel) {
+                    return;
+                }
+            }
+            foreach(core::MapType::Types layerType, types) {
+                // A cache hit returns immediately, a miss downloads the
+                // tile and stores it in both cache tiers
+                QByteArray img = OPMaps::Instance()->GetImageFrom(layerType, p, zoomLevel);
+
+                if ((bandwidthLimit > 0) && (img.length() > 0)) {
+                    // Spread the fetches out so the sustained rate stays
+                    // below the configured budget
+                    QThread::msleep((unsigned long)((qint64)img.length() * 1000 / bandwidthLimit));
+                }
+            }
+            ++done;
+            emit numberOfTilesChanged(all, done);
+            emit percentageChanged(done * 100 / all);
+        }
+    }
+}
+
+void MapRoutePrefetcher::stopFetching()
+{
+    QMutexLocker locker(&mutex);
+
+    cancel = true;
+}
+}
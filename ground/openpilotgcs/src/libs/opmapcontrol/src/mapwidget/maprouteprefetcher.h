@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ *
+ * @file       maprouteprefetcher.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      A service that warms the tile caches along a planned route
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   OPMapWidget
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef MAPROUTEPREFETCHER_H
+#define MAPROUTEPREFETCHER_H
+
+#include <QThread>
+#include <QMutex>
+#include "../internals/core.h"
+namespace mapcontrol {
+/**
+ * Fetches the tiles of a corridor around a planned route into the tile
+ * caches so in-field map use does not block on downloads during flight.
+ * Unlike MapRipper, which rips a user selected rectangle with its own
+ * dialog, this runs as a headless service: the caller supplies the route
+ * and zoom span and observes progress through the signals.  Tiles that
+ * fail to download are skipped, cache warming is best effort.
+ */
+class MapRoutePrefetcher : public QThread {
+    Q_OBJECT
+public:
+    MapRoutePrefetcher(internals::Core *core, QObject *parent = 0);
+
+    // ! Start fetching, corridorMeters is the half width around the route
+    // ! and bytesPerSec caps the sustained download rate (0 = no cap)
+    void prefetch(QList<internals::PointLatLng> const & route, double corridorMeters, int minZoom, int maxZoom, int bytesPerSec = 0);
+
+    void run();
+
+private:
+    // ! Deduplicated tiles covering the corridor at one zoom level
+    QList<core::Point> tilesForZoom(int zoomLevel) const;
+
+    internals::Core *core;
+    QList<internals::PointLatLng> route;
+    double corridor;
+    int minZoom;
+    int maxZoom;
+    int bandwidthLimit;
+    core::MapType::Types type;
+    bool cancel;
+    QMutex mutex;
+
+signals:
+    void percentageChanged(int const & perc);
+    void numberOfTilesChanged(int const & total, int const & actual);
+
+public slots:
+    void stopFetching();
+};
+}
+#endif // MAPROUTEPREFETCHER_H
@@ -14,7 +14,9 @@ SOURCES += mapgraphicitem.cpp \
     homeitem.cpp \
     mapripform.cpp \
     mapripper.cpp \
+    maprouteprefetcher.cpp \
     traillineitem.cpp \
+    trailpolylineitem.cpp \
     waypointline.cpp \
     waypointcircle.cpp
 
@@ -41,7 +43,9 @@ HEADERS += mapgraphicitem.h \
     homeitem.h \
     mapripform.h \
     mapripper.h \
+    maprouteprefetcher.h \
     traillineitem.h \
+    trailpolylineitem.h \
     waypointline.h \
     waypointcircle.h
 QT += opengl
@@ -210,9 +210,15 @@ void OPMapWidget::SetUseOpenGL(const bool &value)
 {
     useOpenGL = value;
     if (useOpenGL) {
+        // Layer composited rendering: the cached item layers (tiles,
+        // overlays, trail) are uploaded as textures and recomposed on the
+        // GPU each frame.  GL swaps complete frames, so partial viewport
+        // updates would only force expensive readbacks.
         setViewport(new QGLWidget(QGLFormat(QGL::SampleBuffers)));
+        setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
     } else {
         setupViewport(new QWidget());
+        setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
     }
     update();
 }
@@ -522,6 +528,15 @@ void OPMapWidget::RipMap()
     new MapRipper(core, map->SelectedArea());
 }
 
+MapRoutePrefetcher *OPMapWidget::PrefetchRoute(QList<internals::PointLatLng> const & route, double corridorMeters, int minZoom, int maxZoom, int bytesPerSec)
+{
+    MapRoutePrefetcher *prefetcher = new MapRoutePrefetcher(core, this);
+
+    connect(prefetcher, SIGNAL(finished()), prefetcher, SLOT(deleteLater()));
+    prefetcher->prefetch(route, corridorMeters, minZoom, maxZoom, bytesPerSec);
+    return prefetcher;
+}
+
 void OPMapWidget::setSelectedWP(QList<WayPointItem * >list)
 {
     this->scene()->clearSelection();
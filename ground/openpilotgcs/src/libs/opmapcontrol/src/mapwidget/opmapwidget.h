@@ -42,6 +42,7 @@
 #include "gpsitem.h"
 #include "homeitem.h"
 #include "mapripper.h"
+#include "maprouteprefetcher.h"
 #include "waypointline.h"
 #include "waypointcircle.h"
 #include "waypointitem.h"
@@ -656,6 +657,9 @@ public slots:
      * @brief Ripps the current selection to the DB
      */
     void RipMap();
+    // ! Warm the tile caches along a route, returns the running service
+    // ! so the caller can observe progress and request cancellation
+    MapRoutePrefetcher *PrefetchRoute(QList<internals::PointLatLng> const & route, double corridorMeters, int minZoom, int maxZoom, int bytesPerSec = 0);
     void OnSelectionChanged();
 };
 }
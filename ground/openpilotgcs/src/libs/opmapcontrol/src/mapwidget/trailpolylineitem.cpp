@@ -0,0 +1,194 @@
+/**
+ ******************************************************************************
+ *
+ * @file       trailpolylineitem.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      A graphicsItem representing the whole UAV trail line
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   OPMapWidget
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "trailpolylineitem.h"
+#include <QLineF>
+#include <math.h>
+
+namespace mapcontrol {
+TrailPolylineItem::TrailPolylineItem(QBrush color, MapGraphicItem *map) : QGraphicsItem(map), m_brush(color), m_map(map)
+{
+    // The trail is its own composition layer: it is only rasterized into
+    // the cache when the path changes, a pan just moves the item and
+    // re-blits (or re-composites, on a GL viewport) the cached layer
+    setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+}
+
+void TrailPolylineItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    QPen pen;
+    pen.setBrush(m_brush);
+    pen.setWidth(1);
+    painter->setPen(pen);
+    painter->drawPath(m_path);
+}
+
+QRectF TrailPolylineItem::boundingRect() const
+{
+    return m_boundingRect;
+}
+
+int TrailPolylineItem::type() const
+{
+    return Type;
+}
+
+void TrailPolylineItem::addPoint(internals::PointLatLng const & coord)
+{
+    m_points.append(coord);
+
+    core::Point local = m_map->FromLatLngToLocal(coord);
+    QPointF mapPoint(local.X(), local.Y());
+    // the path is held in item coordinates so that a pan, which only
+    // moves the item, leaves it (and the cached layer) untouched
+    QPointF point = mapPoint - pos();
+    if (m_path.elementCount() == 0) {
+        prepareGeometryChange();
+        m_path.moveTo(point);
+        m_firstLocal    = mapPoint;
+        m_boundingRect  = QRectF(point.x() - 1, point.y() - 1, 2, 2);
+    } else if (QLineF(m_path.currentPosition(), point).length() >= SIMPLIFY_TOLERANCE_PX) {
+        // points closer than the tolerance to the drawn end are left for the
+        // next full simplification, they would not be visible anyway
+        prepareGeometryChange();
+        m_path.lineTo(point);
+        m_boundingRect |= QRectF(point.x() - 1, point.y() - 1, 2, 2);
+    }
+    m_lastLocal = mapPoint;
+    update();
+}
+
+void TrailPolylineItem::clearPoints()
+{
+    prepareGeometryChange();
+    setPos(0, 0);
+    m_points.clear();
+    m_path = QPainterPath();
+    m_boundingRect = QRectF();
+    update();
+}
+
+void TrailPolylineItem::updatePathSlot()
+{
+    if (m_points.isEmpty()) {
+        return;
+    }
+    core::Point first = m_map->FromLatLngToLocal(m_points.first());
+    core::Point last  = m_map->FromLatLngToLocal(m_points.last());
+    QPointF newFirst(first.X(), first.Y());
+    QPointF newLast(last.X(), last.Y());
+    QPointF delta = newFirst - m_firstLocal;
+
+    if ((newLast - m_lastLocal) == delta) {
+        // a pan only translates the projection: move the whole item and
+        // keep the cached layer valid instead of rewriting the path
+        if (!delta.isNull()) {
+            moveBy(delta.x(), delta.y());
+            m_firstLocal = newFirst;
+            m_lastLocal  = newLast;
+        }
+        return;
+    }
+    rebuildPath();
+}
+
+/**
+ * Re-project all positions at the current zoom and rebuild the cached path
+ * from the simplified point set.
+ */
+void TrailPolylineItem::rebuildPath()
+{
+    QVector<QPointF> localPoints;
+
+    localPoints.reserve(m_points.size());
+    foreach(internals::PointLatLng coord, m_points) {
+        core::Point local = m_map->FromLatLngToLocal(coord);
+
+        localPoints.append(QPointF(local.X(), local.Y()));
+    }
+
+    QVector<QPointF> kept;
+    kept.append(localPoints.first());
+    if (localPoints.size() > 1) {
+        simplifyRange(localPoints, 0, localPoints.size() - 1, kept);
+    }
+
+    prepareGeometryChange();
+    // a rebuild re-rasterizes the layer anyway, so anchor the item back at
+    // the origin and build the path directly in map coordinates
+    setPos(0, 0);
+    m_path = QPainterPath();
+    m_path.moveTo(kept.first());
+    for (int i = 1; i < kept.size(); i++) {
+        m_path.lineTo(kept.at(i));
+    }
+    m_firstLocal   = localPoints.first();
+    m_lastLocal    = localPoints.last();
+    m_boundingRect = m_path.controlPointRect().adjusted(-1, -1, 1, 1);
+    update();
+}
+
+/**
+ * Douglas-Peucker simplification: keep the point farthest from the line
+ * between the range ends if it is farther than the tolerance, and recurse
+ * into both halves, otherwise drop everything between the ends.
+ * The caller has already kept points[first].
+ */
+void TrailPolylineItem::simplifyRange(const QVector<QPointF> &points, int first, int last, QVector<QPointF> &kept)
+{
+    double maxDistance = 0.0;
+    int maxIndex       = -1;
+    QPointF a          = points.at(first);
+    QPointF b          = points.at(last);
+    double dx          = b.x() - a.x();
+    double dy          = b.y() - a.y();
+    double length      = sqrt(dx * dx + dy * dy);
+
+    for (int i = first + 1; i < last; i++) {
+        const QPointF &point = points.at(i);
+        double distance;
+        if (length > 0.0) {
+            distance = fabs(dy * (point.x() - a.x()) - dx * (point.y() - a.y())) / length;
+        } else {
+            distance = QLineF(a, point).length();
+        }
+        if (distance > maxDistance) {
+            maxDistance = distance;
+            maxIndex    = i;
+        }
+    }
+
+    if ((maxIndex > 0) && (maxDistance > SIMPLIFY_TOLERANCE_PX)) {
+        simplifyRange(points, first, maxIndex, kept);
+        simplifyRange(points, maxIndex, last, kept);
+    } else {
+        kept.append(points.at(last));
+    }
+}
+}
@@ -0,0 +1,75 @@
+/**
+ ******************************************************************************
+ *
+ * @file       trailpolylineitem.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @brief      A graphicsItem representing the whole UAV trail line
+ * @see        The GNU Public License (GPL) Version 3
+ * @defgroup   OPMapWidget
+ * @{
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef TRAILPOLYLINEITEM_H
+#define TRAILPOLYLINEITEM_H
+
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QPainterPath>
+#include "../internals/pointlatlng.h"
+#include <QObject>
+#include "mapgraphicitem.h"
+
+namespace mapcontrol {
+/**
+ * The trail line is drawn as one item holding all the positions, instead of
+ * one QGraphicsLineItem per segment. The painted path is simplified to the
+ * current zoom (Douglas-Peucker, one pixel tolerance) and rasterized into a
+ * device coordinate cache, so a pan just moves the item and re-composites
+ * the cached layer while new positions extend it, keeping the render cost
+ * bounded regardless of the flight duration.
+ */
+class TrailPolylineItem : public QObject, public QGraphicsItem {
+    Q_OBJECT Q_INTERFACES(QGraphicsItem)
+public:
+    enum { Type = UserType + 10 };
+    TrailPolylineItem(QBrush color, MapGraphicItem *map);
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
+               QWidget *widget);
+    QRectF boundingRect() const;
+    int type() const;
+    void addPoint(internals::PointLatLng const & coord);
+    void clearPoints();
+private:
+    // pixel tolerance of the simplification, points closer than this to the
+    // line between their kept neighbours cannot be told apart on screen
+    static const int SIMPLIFY_TOLERANCE_PX = 1;
+    void rebuildPath();
+    void simplifyRange(const QVector<QPointF> &points, int first, int last, QVector<QPointF> &kept);
+    QBrush m_brush;
+    MapGraphicItem *m_map;
+    QVector<internals::PointLatLng> m_points;
+    QPainterPath m_path;
+    QRectF m_boundingRect;
+    QPointF m_firstLocal;
+    QPointF m_lastLocal;
+public slots:
+    void updatePathSlot();
+};
+}
+
+#endif // TRAILPOLYLINEITEM_H
@@ -42,8 +42,9 @@ UAVItem::UAVItem(MapGraphicItem *map, OPMapWidget *parent, QString uavPic) : map
     this->setZValue(4);
     trail     = new QGraphicsItemGroup(this);
     trail->setParentItem(map);
-    trailLine = new QGraphicsItemGroup(this);
+    trailLine = new TrailPolylineItem(QBrush(Qt::red), map);
     trailLine->setParentItem(map);
+    connect(this, SIGNAL(setChildLine()), trailLine, SLOT(updatePathSlot()));
     this->setFlag(QGraphicsItem::ItemIgnoresTransformations, true);
     setCacheMode(QGraphicsItem::ItemCoordinateCache);
     mapfollowtype = UAVMapFollowType::None;
@@ -252,12 +253,7 @@ void UAVItem::SetUAVPos(const internals::PointLatLng &position, const int &altit
                 TrailItem *ob = new TrailItem(position, altitude, Qt::green, map);
                 trail->addToGroup(ob);
                 connect(this, SIGNAL(setChildPosition()), ob, SLOT(setPosSLOT()));
-                if (!lasttrailline.IsEmpty()) {
-                    TrailLineItem *obj = new TrailLineItem(lasttrailline, position, Qt::red, map);
-                    trailLine->addToGroup(obj);
-                    connect(this, SIGNAL(setChildLine()), obj, SLOT(setLineSlot()));
-                }
-                lasttrailline = position;
+                trailLine->addPoint(position);
                 timer.restart();
             }
         } else if (trailtype == UAVTrailType::ByDistance) {
@@ -265,13 +261,8 @@ void UAVItem::SetUAVPos(const internals::PointLatLng &position, const int &altit
                 TrailItem *ob = new TrailItem(position, altitude, Qt::green, map);
                 trail->addToGroup(ob);
                 connect(this, SIGNAL(setChildPosition()), ob, SLOT(setPosSLOT()));
-                if (!lasttrailline.IsEmpty()) {
-                    TrailLineItem *obj = new TrailLineItem(lasttrailline, position, Qt::red, map);
-                    trailLine->addToGroup(obj);
-                    connect(this, SIGNAL(setChildLine()), obj, SLOT(setLineSlot()));
-                }
-                lasttrailline = position;
-                lastcoord     = position;
+                trailLine->addPoint(position);
+                lastcoord = position;
             }
         }
         coord = position;
@@ -378,8 +369,7 @@ void UAVItem::DeleteTrail() const
 {
     foreach(QGraphicsItem * i, trail->childItems())
     delete i;
-    foreach(QGraphicsItem * i, trailLine->childItems())
-    delete i;
+    trailLine->clearPoints();
 }
 double UAVItem::Distance3D(const internals::PointLatLng &coord, const int &altitude)
 {
@@ -39,7 +39,7 @@
 #include <QtSvg/QSvgRenderer>
 #include "opmapwidget.h"
 #include "trailitem.h"
-#include "traillineitem.h"
+#include "trailpolylineitem.h"
 namespace mapcontrol {
 class WayPointItem;
 class OPMapWidget;
@@ -283,8 +283,7 @@ private:
     QPixmap pic;
     core::Point localposition;
     QGraphicsItemGroup *trail;
-    QGraphicsItemGroup *trailLine;
-    internals::PointLatLng lasttrailline;
+    TrailPolylineItem *trailLine;
     QTime timer;
     bool showtrail;
     bool showtrailline;
@@ -84,6 +84,7 @@ bool SDLGamepad::init()
     }
 
     loop = true;
+    timeBase.start();
     return true;
 }
 
@@ -154,7 +155,13 @@ void SDLGamepad::updateAxes()
             values.append(value);
         }
 
-        emit axesValues(values);
+        // Coalesce: only emit when at least one axis moved since the
+        // last update, stamped with the monotonic capture time
+        if (values != lastAxesValues) {
+            lastAxesValues = values;
+            emit axesValues(values);
+            emit axesValuesTimed(values, timeBase.elapsed());
+        }
     }
 }
 
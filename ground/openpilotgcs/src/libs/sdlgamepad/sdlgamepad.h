@@ -25,6 +25,7 @@
 
 #include "sdlgamepad_global.h"
 
+#include <QElapsedTimer>
 #include <QThread>
 
 /**
@@ -299,6 +300,22 @@ private:
      */
     QList<qint16> buttonStates;
 
+    /**
+     * The axes values of the last emitted update.
+     *
+     * Kept to coalesce the captured samples; a new axesValues signal
+     * is only emitted when at least one axis actually changed.
+     */
+    QList<qint16> lastAxesValues;
+
+    /**
+     * Monotonic time base for the axesValuesTimed timestamps.
+     *
+     * Started in init and never restarted, so timestamps are
+     * monotonic for the lifetime of the capture thread.
+     */
+    QElapsedTimer timeBase;
+
     /**
      * Variable that holds private members.
      */
@@ -347,6 +364,19 @@ signals:
      * @param values A QListInt16 Type containing all axes values.
      */
     void axesValues(QListInt16 values);
+
+    /**
+     * Like axesValues, with the capture time attached.
+     *
+     * The timestamp is taken from a monotonic clock in milliseconds
+     * when the changed values were read from SDL, so consumers can
+     * rate limit and coalesce on capture time rather than delivery
+     * time.
+     *
+     * @param values The current values of all axes.
+     * @param timestamp Monotonic capture time in milliseconds.
+     */
+    void axesValuesTimed(QListInt16 values, quint64 timestamp);
 };
 
 #endif // SDLGAMEPAD_H
@@ -60,6 +60,31 @@ const quint8 crc_table[256] = {
     0xde, 0xd9, 0xd0, 0xd7, 0xc2, 0xc5, 0xcc, 0xcb, 0xe6, 0xe1, 0xe8, 0xef, 0xfa, 0xfd, 0xf4, 0xf3
 };
 
+/*
+ * Slice-by-8 acceleration tables, derived from crc_table at startup.
+ *
+ * The table-driven update crc' = crc_table[crc ^ byte] is linear over GF(2),
+ * so advancing a value over k bytes of zero input is just crc_table applied
+ * k times. slice_table[k][v] holds that k+1 fold composition, which lets the
+ * buffer variant below fold eight input bytes per iteration instead of one.
+ */
+static quint8 slice_table[8][256];
+
+static bool buildSliceTables()
+{
+    for (int v = 0; v < 256; ++v) {
+        quint8 crc = crc_table[v];
+        slice_table[0][v] = crc;
+        for (int k = 1; k < 8; ++k) {
+            crc = crc_table[crc];
+            slice_table[k][v] = crc;
+        }
+    }
+    return true;
+}
+
+static const bool slice_tables_built = buildSliceTables();
+
 quint8 Crc::updateCRC(quint8 crc, const quint8 data)
 {
     return crc_table[crc ^ data];
@@ -67,8 +92,54 @@ quint8 Crc::updateCRC(quint8 crc, const quint8 data)
 
 quint8 Crc::updateCRC(quint8 crc, const quint8 *data, qint32 length)
 {
+    while (length >= 8) {
+        crc     = slice_table[7][crc ^ data[0]]
+                  ^ slice_table[6][data[1]]
+                  ^ slice_table[5][data[2]]
+                  ^ slice_table[4][data[3]]
+                  ^ slice_table[3][data[4]]
+                  ^ slice_table[2][data[5]]
+                  ^ slice_table[1][data[6]]
+                  ^ slice_table[0][data[7]];
+        data   += 8;
+        length -= 8;
+    }
     while (length--) {
         crc = crc_table[crc ^ *data++];
     }
     return crc;
 }
+
+/*
+ * CRC-32 with polynomial 0x04C11DB7, XorIn 0, no reflection and no XorOut,
+ * the same parameters as CRC_Table32 in flight/pios/common/pios_crc.c.
+ * The table is derived at startup instead of being pasted here.
+ */
+static quint32 crc_table32[256];
+
+static bool buildCrc32Table()
+{
+    for (int v = 0; v < 256; ++v) {
+        quint32 crc = (quint32)v << 24;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x80000000) ? ((crc << 1) ^ 0x04c11db7) : (crc << 1);
+        }
+        crc_table32[v] = crc;
+    }
+    return true;
+}
+
+static const bool crc32_table_built = buildCrc32Table();
+
+quint32 Crc::updateCRC32(quint32 crc, const quint8 data)
+{
+    return (crc << 8) ^ crc_table32[(crc >> 24) ^ data];
+}
+
+quint32 Crc::updateCRC32(quint32 crc, const quint8 *data, qint32 length)
+{
+    while (length--) {
+        crc = (crc << 8) ^ crc_table32[(crc >> 24) ^ *data++];
+    }
+    return crc;
+}
@@ -52,6 +52,28 @@ public:
      * \return         The updated crc value.
      */
     static quint8 updateCRC(quint8 crc, const quint8 *data, qint32 length);
+
+    /**
+     * Update a CRC-32 value with new data.
+     *
+     * Matches PIOS_CRC32_updateCRC on the flight side, so digests computed
+     * over the same packed object bytes compare equal across the link.
+     *
+     * \param crc      The current crc value.
+     * \param data     data to update the crc with.
+     * \return         The updated crc value.
+     */
+    static quint32 updateCRC32(quint32 crc, const quint8 data);
+
+    /**
+     * Update a CRC-32 value with new data.
+     *
+     * \param crc      The current crc value.
+     * \param data     Pointer to a buffer of \a data_len bytes.
+     * \param length   Number of bytes in the \a data buffer.
+     * \return         The updated crc value.
+     */
+    static quint32 updateCRC32(quint32 crc, const quint8 *data, qint32 length);
 };
 } // namespace Utils
 
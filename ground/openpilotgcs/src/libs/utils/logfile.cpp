@@ -2,6 +2,13 @@
 #include <QDebug>
 #include <QtGlobal>
 
+// OPL v2 files start with "OPL2" and a version word, and end with a footer
+// index of sync points followed by a fixed size trailer. v1 files carry
+// neither and are still replayed, just without seek support.
+static const quint32 LOG_FILE_MAGIC  = 0x324C504F; // "OPL2"
+static const quint32 LOG_FILE_VERSION = 2;
+static const quint32 LOG_INDEX_MAGIC = 0x58444E49; // "INDX"
+
 LogFile::LogFile(QObject *parent) :
     QIODevice(parent),
     m_lastTimeStamp(0),
@@ -9,7 +16,11 @@ LogFile::LogFile(QObject *parent) :
     m_timeOffset(0),
     m_playbackSpeed(1.0),
     m_nextTimeStamp(0),
-    m_useProvidedTimeStamp(false)
+    m_useProvidedTimeStamp(false),
+    m_writeIndex(false),
+    m_syncPointFlagged(false),
+    m_dataOffset(0),
+    m_logEndOffset(0)
 {
     connect(&m_timer, SIGNAL(timeout()), this, SLOT(timerFired()));
 }
@@ -36,8 +47,17 @@ bool LogFile::open(OpenMode mode)
         return false;
     }
 
-    // TODO: Write a header at the beginng describing objects so that in future
-    // they can be read back if ID's change
+    m_indexEntries.clear();
+    m_syncPointFlagged = false;
+    if (mode & QIODevice::WriteOnly) {
+        // v2 header, the footer index is appended on close
+        m_file.write((char *)&LOG_FILE_MAGIC, sizeof(LOG_FILE_MAGIC));
+        m_file.write((char *)&LOG_FILE_VERSION, sizeof(LOG_FILE_VERSION));
+        m_writeIndex = true;
+    } else {
+        m_writeIndex = false;
+        readHeaderAndIndex();
+    }
 
     // Must call parent function for QIODevice to pass calls to writeData
     // We always open ReadWrite, because otherwise we will get tons of warnings
@@ -47,6 +67,80 @@ bool LogFile::open(OpenMode mode)
     return true;
 }
 
+/**
+ * Detects the v2 header and loads the footer index. A v2 file without a
+ * valid footer (e.g. the GCS was killed while logging) is replayed like a
+ * v1 file, only seeking is unavailable.
+ */
+void LogFile::readHeaderAndIndex()
+{
+    m_dataOffset   = 0;
+    m_logEndOffset = m_file.size();
+
+    quint32 magic   = 0;
+    quint32 version = 0;
+    if (m_file.size() < (qint64)(sizeof(magic) + sizeof(version))) {
+        return;
+    }
+    m_file.read((char *)&magic, sizeof(magic));
+    m_file.read((char *)&version, sizeof(version));
+    if (magic != LOG_FILE_MAGIC || version != LOG_FILE_VERSION) {
+        m_file.seek(0);
+        return;
+    }
+    m_dataOffset = m_file.pos();
+
+    // trailer: index offset, entry count, index magic
+    qint64 trailerSize = sizeof(qint64) + 2 * sizeof(quint32);
+    if (m_file.size() < m_dataOffset + trailerSize) {
+        return;
+    }
+    qint64 indexOffset = 0;
+    quint32 count      = 0;
+    quint32 indexMagic = 0;
+    m_file.seek(m_file.size() - trailerSize);
+    m_file.read((char *)&indexOffset, sizeof(indexOffset));
+    m_file.read((char *)&count, sizeof(count));
+    m_file.read((char *)&indexMagic, sizeof(indexMagic));
+
+    qint64 entrySize = sizeof(quint32) + sizeof(qint64);
+    if (indexMagic != LOG_INDEX_MAGIC
+        || indexOffset < m_dataOffset
+        || indexOffset + count * entrySize + trailerSize != m_file.size()) {
+        m_file.seek(m_dataOffset);
+        return;
+    }
+
+    m_file.seek(indexOffset);
+    for (quint32 i = 0; i < count; i++) {
+        LogIndexEntry entry;
+        m_file.read((char *)&entry.flightTime, sizeof(entry.flightTime));
+        m_file.read((char *)&entry.offset, sizeof(entry.offset));
+        m_indexEntries.append(entry);
+    }
+    // the footer is not part of the replayed stream
+    m_logEndOffset = indexOffset;
+    m_file.seek(m_dataOffset);
+}
+
+/**
+ * Appends the footer index: all sync point entries, then the trailer
+ * locating them.
+ */
+void LogFile::writeIndex()
+{
+    qint64 indexOffset = m_file.pos();
+
+    foreach(LogIndexEntry entry, m_indexEntries) {
+        m_file.write((char *)&entry.flightTime, sizeof(entry.flightTime));
+        m_file.write((char *)&entry.offset, sizeof(entry.offset));
+    }
+    quint32 count = m_indexEntries.size();
+    m_file.write((char *)&indexOffset, sizeof(indexOffset));
+    m_file.write((char *)&count, sizeof(count));
+    m_file.write((char *)&LOG_INDEX_MAGIC, sizeof(LOG_INDEX_MAGIC));
+}
+
 void LogFile::close()
 {
     emit aboutToClose();
@@ -54,10 +148,24 @@ void LogFile::close()
     if (m_timer.isActive()) {
         m_timer.stop();
     }
+    if (m_writeIndex && m_file.isWritable()) {
+        writeIndex();
+        m_writeIndex = false;
+    }
     m_file.close();
     QIODevice::close();
 }
 
+/**
+ * Marks the next record written as a sync point: its offset and timestamp
+ * are added to the footer index. The caller should follow up with a full
+ * object snapshot so a replay seeked here starts from known state.
+ */
+void LogFile::flagSyncPoint()
+{
+    m_syncPointFlagged = true;
+}
+
 qint64 LogFile::writeData(const char *data, qint64 dataSize)
 {
     if (!m_file.isWritable()) {
@@ -68,6 +176,18 @@ qint64 LogFile::writeData(const char *data, qint64 dataSize)
     // This is used when saving logs from on-board logging
     quint32 timeStamp = m_useProvidedTimeStamp ? m_nextTimeStamp : m_myTime.elapsed();
 
+    // index the first record, flagged snapshots, and writers that never
+    // flag (e.g. on-board log export) on the sync point interval
+    if (m_writeIndex
+        && (m_syncPointFlagged || m_indexEntries.isEmpty()
+            || (timeStamp - m_indexEntries.last().flightTime) >= SYNC_POINT_INTERVAL_MS)) {
+        LogIndexEntry entry;
+        entry.flightTime   = timeStamp;
+        entry.offset       = m_file.pos();
+        m_indexEntries.append(entry);
+        m_syncPointFlagged = false;
+    }
+
     m_file.write((char *)&timeStamp, sizeof(timeStamp));
     m_file.write((char *)&dataSize, sizeof(dataSize));
 
@@ -97,41 +217,42 @@ qint64 LogFile::bytesAvailable() const
 void LogFile::timerFired()
 {
     qint64 dataSize;
+    bool dataQueued = false;
+    bool endOfLog   = false;
 
-    if (m_file.bytesAvailable() > 4) {
+    if (m_logEndOffset - m_file.pos() > 4) {
         int time;
         time = m_myTime.elapsed();
 
         // TODO: going back in time will be a problem
         while ((m_lastPlayed + ((time - m_timeOffset) * m_playbackSpeed) > m_lastTimeStamp)) {
             m_lastPlayed += ((time - m_timeOffset) * m_playbackSpeed);
-            if (m_file.bytesAvailable() < (qint64)sizeof(dataSize)) {
-                stopReplay();
-                return;
+            if (m_logEndOffset - m_file.pos() < (qint64)sizeof(dataSize)) {
+                endOfLog = true;
+                break;
             }
 
             m_file.read((char *)&dataSize, sizeof(dataSize));
 
             if (dataSize < 1 || dataSize > (1024 * 1024)) {
                 qDebug() << "Error: Logfile corrupted! Unlikely packet size: " << dataSize << "\n";
-                stopReplay();
-                return;
+                endOfLog = true;
+                break;
             }
 
-            if (m_file.bytesAvailable() < dataSize) {
-                stopReplay();
-                return;
+            if (m_logEndOffset - m_file.pos() < dataSize) {
+                endOfLog = true;
+                break;
             }
 
             m_mutex.lock();
             m_dataBuffer.append(m_file.read(dataSize));
             m_mutex.unlock();
+            dataQueued = true;
 
-            emit readyRead();
-
-            if (m_file.bytesAvailable() < (qint64)sizeof(m_lastTimeStamp)) {
-                stopReplay();
-                return;
+            if (m_logEndOffset - m_file.pos() < (qint64)sizeof(m_lastTimeStamp)) {
+                endOfLog = true;
+                break;
             }
 
             int save = m_lastTimeStamp;
@@ -140,14 +261,25 @@ void LogFile::timerFired()
             if (m_lastTimeStamp < save // logfile goes back in time
                 || (m_lastTimeStamp - save) > (60 * 60 * 1000)) { // gap of more than 60 minutes)
                 qDebug() << "Error: Logfile corrupted! Unlikely timestamp " << m_lastTimeStamp << " after " << save << "\n";
-                stopReplay();
-                return;
+                endOfLog = true;
+                break;
             }
 
             m_timeOffset = time;
             time = m_myTime.elapsed();
         }
     } else {
+        endOfLog = true;
+    }
+
+    // Signal once per tick: at high playback speeds a tick queues many
+    // records, and the reader drains them in one batch instead of being
+    // woken per record.
+    if (dataQueued) {
+        emit readyRead();
+        emit playTimeChanged(m_lastTimeStamp);
+    }
+    if (endOfLog) {
         stopReplay();
     }
 }
@@ -158,6 +290,7 @@ bool LogFile::startReplay()
     m_myTime.restart();
     m_timeOffset = 0;
     m_lastPlayed = 0;
+    m_file.seek(m_dataOffset);
     m_file.read((char *)&m_lastTimeStamp, sizeof(m_lastTimeStamp));
     m_timer.setInterval(10);
     m_timer.start();
@@ -172,6 +305,35 @@ bool LogFile::stopReplay()
     return true;
 }
 
+/**
+ * Jumps the replay to the last sync point at or before the given flight
+ * time. The stream restarts from the full object snapshot written there,
+ * so no records before it need to be reparsed. Only available for OPL v2
+ * files with a valid footer index.
+ */
+bool LogFile::seekToTime(quint32 timeStampMs)
+{
+    if (m_indexEntries.isEmpty()) {
+        return false;
+    }
+
+    int i = m_indexEntries.size() - 1;
+    while (i > 0 && m_indexEntries.at(i).flightTime > timeStampMs) {
+        i--;
+    }
+
+    m_mutex.lock();
+    m_dataBuffer.clear();
+    m_mutex.unlock();
+
+    m_file.seek(m_indexEntries.at(i).offset);
+    m_file.read((char *)&m_lastTimeStamp, sizeof(m_lastTimeStamp));
+    m_lastPlayed = m_lastTimeStamp;
+    m_timeOffset = m_myTime.elapsed();
+    emit playTimeChanged(m_lastTimeStamp);
+    return true;
+}
+
 void LogFile::pauseReplay()
 {
     m_timer.stop();
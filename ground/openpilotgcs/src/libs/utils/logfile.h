@@ -8,11 +8,25 @@
 #include <QDebug>
 #include <QBuffer>
 #include <QFile>
+#include <QList>
 #include "utils_global.h"
 
+/**
+ * One entry of the OPL v2 footer index: the flight time of a sync point
+ * and the file offset of the record that starts it.
+ */
+struct LogIndexEntry {
+    quint32 flightTime;
+    qint64  offset;
+};
+
 class QTCREATOR_UTILS_EXPORT LogFile : public QIODevice {
     Q_OBJECT
 public:
+    // interval between sync points while writing, each one starts with a
+    // full object snapshot so replay can resume there
+    static const int SYNC_POINT_INTERVAL_MS = 5000;
+
     explicit LogFile(QObject *parent = 0);
     qint64 bytesAvailable() const;
     qint64 bytesToWrite()
@@ -40,6 +54,17 @@ public:
         m_nextTimeStamp = nextTimestamp;
     }
 
+    bool hasIndex() const
+    {
+        return !m_indexEntries.isEmpty();
+    }
+    quint32 lastIndexTime() const
+    {
+        return m_indexEntries.isEmpty() ? 0 : m_indexEntries.last().flightTime;
+    }
+    bool seekToTime(quint32 timeStampMs);
+    void flagSyncPoint();
+
 public slots:
     void setReplaySpeed(double val)
     {
@@ -56,6 +81,9 @@ signals:
     void readReady();
     void replayStarted();
     void replayFinished();
+    // current playhead flight time, emitted while playing and after a
+    // seek so scrubbing UIs (logging gadget, scope, map) can follow
+    void playTimeChanged(quint32 timeStampMs);
 
 protected:
     QByteArray m_dataBuffer;
@@ -71,8 +99,18 @@ protected:
     double m_playbackSpeed;
 
 private:
+    void readHeaderAndIndex();
+    void writeIndex();
+
     quint32 m_nextTimeStamp;
     bool m_useProvidedTimeStamp;
+
+    // OPL v2 index, empty while writing a v1 file or replaying one
+    QList<LogIndexEntry> m_indexEntries;
+    bool m_writeIndex;
+    bool m_syncPointFlagged;
+    qint64 m_dataOffset;
+    qint64 m_logEndOffset;
 };
 
 #endif // LOGFILE_H
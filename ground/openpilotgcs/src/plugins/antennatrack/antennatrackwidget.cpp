@@ -34,6 +34,10 @@
 #include <QtGui>
 #include <QDebug>
 
+// Dead-reckoning between telemetry fixes
+#define PREDICTION_PERIOD_MS 50   // 20Hz pointing output
+#define PREDICTION_MAX_MS    5000 // coast at most this long without a fix
+
 /*
  * Initialize the widget
  */
@@ -41,8 +45,19 @@ AntennaTrackWidget::AntennaTrackWidget(QWidget *parent) : QWidget(parent)
 {
     setupUi(this);
 
-    azimuth_old   = 0;
-    elevation_old = 0;
+    azimuth_old     = 0;
+    elevation_old   = 0;
+
+    haveFix         = false;
+    fixLatitude     = fixLongitude = fixAltitude = 0;
+    velLatitude     = velLongitude = velAltitude = 0;
+    commandPending  = false;
+    targetAzimuth   = 0;
+    targetElevation = 0;
+    azimuth_sent    = 0;
+
+    predictionTimer.setInterval(PREDICTION_PERIOD_MS);
+    connect(&predictionTimer, SIGNAL(timeout()), this, SLOT(predictPosition()));
 }
 
 AntennaTrackWidget::~AntennaTrackWidget()
@@ -50,6 +65,10 @@ AntennaTrackWidget::~AntennaTrackWidget()
 void AntennaTrackWidget::setPort(QPointer<QSerialPort> portx)
 {
     port = portx;
+    if (port) {
+        // retry the latest pointing target once the previous command drained
+        connect(port, SIGNAL(bytesWritten(qint64)), this, SLOT(sendPendingCommand()));
+    }
 }
 
 void AntennaTrackWidget::dumpPacket(const QString &packet)
@@ -92,6 +111,26 @@ void AntennaTrackWidget::setPosition(double lat, double lon, double alt)
     QString str3;
     str3.sprintf("%.2f m", alt);
     coord_value_3->setText(str3);
+
+    // estimate the velocity between the last two fixes so the prediction
+    // timer can dead-reckon the pointing angles until the next update
+    if (haveFix) {
+        double dT = sinceFix.elapsed() / 1000.0;
+        if (dT > 0) {
+            velLatitude  = (lat - fixLatitude) / dT;
+            velLongitude = (lon - fixLongitude) / dT;
+            velAltitude  = (alt - fixAltitude) / dT;
+        }
+    }
+    fixLatitude  = lat;
+    fixLongitude = lon;
+    fixAltitude  = alt;
+    haveFix = true;
+    sinceFix.start();
+    if (!predictionTimer.isActive()) {
+        predictionTimer.start();
+    }
+
     TrackData.Latitude  = lat;
     TrackData.Longitude = lon;
     TrackData.Altitude  = alt;
@@ -196,17 +235,64 @@ void AntennaTrackWidget::calcAntennaPosition(void)
     str3.sprintf("%.0f deg", elevation);
     elevation_value->setText(str3);
 
-    // servo value 2000-4000
-    int servo   = (int)(2000.0 / 180 * elevation + 2000);
-    int stepper = (int)(400.0 / 360 * (azimuth - azimuth_old));
-
-    // send azimuth and elevation to tracker hardware
-    str3.sprintf("move %d 2000 2000 2000 %d\r", stepper, servo);
-    if (port->isOpen()) {
-        if (azimuth_old != azimuth || elevation != elevation_old) {
-            port->write(str3.toLatin1());
-        }
+    // hand the target to the writer instead of blocking on the port here;
+    // only the most recent target is kept if the tracker is slow
+    if (azimuth_old != azimuth || elevation != elevation_old) {
+        targetAzimuth   = azimuth;
+        targetElevation = elevation;
+        commandPending  = true;
+        sendPendingCommand();
     }
     azimuth_old   = azimuth;
     elevation_old = elevation;
 }
+
+/**
+ * Dead-reckon the aircraft position from the last fix and velocity and
+ * recompute the pointing angles, so the dish keeps moving between
+ * telemetry updates
+ */
+void AntennaTrackWidget::predictPosition()
+{
+    if (!haveFix) {
+        return;
+    }
+    qint64 elapsed = sinceFix.elapsed();
+    if (elapsed > PREDICTION_MAX_MS) {
+        // telemetry is gone, hold the last commanded position
+        return;
+    }
+    double dT = elapsed / 1000.0;
+    TrackData.Latitude  = fixLatitude + velLatitude * dT;
+    TrackData.Longitude = fixLongitude + velLongitude * dT;
+    TrackData.Altitude  = fixAltitude + velAltitude * dT;
+    calcAntennaPosition();
+}
+
+/**
+ * Build and send the command for the latest pointing target once the
+ * port has drained the previous one.  The stepper move is relative, so
+ * the delta is always taken from the azimuth actually sent, not from
+ * targets that were superseded before they went out.
+ */
+void AntennaTrackWidget::sendPendingCommand()
+{
+    if (!commandPending || !port || !port->isOpen()) {
+        return;
+    }
+    if (port->bytesToWrite() > 0) {
+        // previous command still draining, keep only the latest target
+        return;
+    }
+
+    // servo value 2000-4000
+    int servo   = (int)(2000.0 / 180 * targetElevation + 2000);
+    int stepper = (int)(400.0 / 360 * (targetAzimuth - azimuth_sent));
+
+    // send azimuth and elevation to tracker hardware
+    QString cmd;
+    cmd.sprintf("move %d 2000 2000 2000 %d\r", stepper, servo);
+    port->write(cmd.toLatin1());
+    azimuth_sent   = targetAzimuth;
+    commandPending = false;
+}
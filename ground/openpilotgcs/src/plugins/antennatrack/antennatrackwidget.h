@@ -36,6 +36,8 @@
 #include <QtSvg/QGraphicsSvgItem>
 #include <QtSerialPort/QSerialPort>
 #include <QPointer>
+#include <QTimer>
+#include <QElapsedTimer>
 
 class Ui_AntennaTrackWidget;
 
@@ -61,6 +63,8 @@ private slots:
     void setPosition(double, double, double);
     void setHomePosition(double, double, double);
     void dumpPacket(const QString &packet);
+    void predictPosition();
+    void sendPendingCommand();
 
 private:
     void calcAntennaPosition(void);
@@ -68,5 +72,18 @@ private:
     QPointer<QSerialPort> port;
     double azimuth_old;
     double elevation_old;
+    // last real fix and the velocity estimated between the last two fixes,
+    // used to dead-reckon the pointing angles between telemetry updates
+    double fixLatitude, fixLongitude, fixAltitude;
+    double velLatitude, velLongitude, velAltitude; // deg/s, deg/s, m/s
+    bool haveFix;
+    QElapsedTimer sinceFix;
+    QTimer predictionTimer;
+    // latest pointing target; the writer only builds and sends a command
+    // once the previous one has drained from the port
+    bool commandPending;
+    double targetAzimuth;
+    double targetElevation;
+    double azimuth_sent;
 };
 #endif /* ANTENNATRACKWIDGET_H_ */
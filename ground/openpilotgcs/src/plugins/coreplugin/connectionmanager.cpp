@@ -101,13 +101,12 @@ void ConnectionManager::addWidget(QWidget *widget)
 }
 
 /**
- *   Method called when the user clicks the "Connect" button
+ *   Connect to the given device.  Called when the user clicks the "Connect"
+ *   button and by plugins (headless recorder) that select a device themselves.
  */
 bool ConnectionManager::connectDevice(DevListItem device)
 {
-    Q_UNUSED(device);
-    QString deviceName = m_availableDevList->itemData(m_availableDevList->currentIndex(), Qt::ToolTipRole).toString();
-    DevListItem connection_device = findDevice(deviceName);
+    DevListItem connection_device = device;
 
     if (!connection_device.connection) {
         return false;
@@ -284,7 +284,11 @@ void MainWindow::extensionsInitialized()
     updateContext();
 
     emit m_coreImpl->coreAboutToOpen();
-    show();
+    // In headless mode the window stays hidden, all the core services keep
+    // running so a recording session can go on without the GUI overhead.
+    if (!qApp->property("headless").toBool()) {
+        show();
+    }
     emit m_coreImpl->coreOpened();
 }
 
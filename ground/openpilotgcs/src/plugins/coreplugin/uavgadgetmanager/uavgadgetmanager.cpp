@@ -48,10 +48,12 @@
 #include <utils/consoleprocess.h>
 #include <utils/qtcassert.h>
 
+#include <QtCore/QDataStream>
 #include <QtCore/QDebug>
 #include <QtCore/QMap>
 #include <QtCore/QProcess>
 #include <QtCore/QSet>
+#include <QtCore/QTemporaryFile>
 
 #include <QAction>
 #include <QtWidgets/QApplication>
@@ -80,6 +82,7 @@ static inline ExtensionSystem::PluginManager *pluginManager()
 
 UAVGadgetManager::UAVGadgetManager(ICore *core, QString name, QIcon icon, int priority, QString uniqueName, QWidget *parent) :
     m_showToolbars(true),
+    m_restorePending(false),
     m_splitterOrView(0),
     m_currentGadget(0),
     m_core(core),
@@ -141,6 +144,9 @@ void UAVGadgetManager::modeChanged(Core::IMode *mode)
         return;
     }
 
+    // Build the workspace's gadgets on first activation
+    restoreDeferredState();
+
     m_currentGadget->widget()->setFocus();
     showToolbars(toolbarsShown());
 }
@@ -345,8 +351,28 @@ void UAVGadgetManager::saveSettings(QSettings *qs)
     // Make sure the old tree is wiped.
     qs->remove("");
 
-    // Do actual saving
-    saveState(qs);
+    QMap<QString, QVariant> state;
+    if (m_restorePending) {
+        // Never activated, the layout we loaded is still current
+        state = m_deferredState;
+    } else {
+        // Collapse the per-key layout tree into a flat map
+        QTemporaryFile file;
+        file.open();
+        file.close();
+        QSettings tmp(file.fileName(), QSettings::IniFormat);
+        saveState(&tmp);
+        foreach(const QString &key, tmp.allKeys()) {
+            state.insert(key, tmp.value(key));
+        }
+    }
+
+    // Store the workspace as one binary blob instead of hundreds of
+    // individual keys, which is much cheaper to read back at startup
+    QByteArray blob;
+    QDataStream stream(&blob, QIODevice::WriteOnly);
+    stream << state;
+    qs->setValue("state", blob);
 
     qs->endGroup();
     qs->endGroup();
@@ -367,14 +393,61 @@ void UAVGadgetManager::readSettings(QSettings *qs)
     }
     qs->beginGroup(uniqueModeName());
 
-    restoreState(qs);
+    m_deferredState.clear();
+    QByteArray blob = qs->value("state").toByteArray();
+    if (!blob.isEmpty()) {
+        QDataStream stream(blob);
+        stream >> m_deferredState;
+    } else {
+        // Legacy configurations store the layout as a key tree
+        foreach(const QString &key, qs->allKeys()) {
+            m_deferredState.insert(key, qs->value(key));
+        }
+    }
+    m_restorePending = !m_deferredState.isEmpty();
 
-    showToolbars(m_showToolbars);
+    // Only the active workspace is built right away; the others defer
+    // their gadget construction until they are first switched to
+    if (m_core->modeManager()->currentMode() == this) {
+        restoreDeferredState();
+    }
 
     qs->endGroup();
     qs->endGroup();
 }
 
+/**
+ * Replay the stored workspace layout, instantiating its gadgets. Run on
+ * the first activation of the mode so that reading the configuration at
+ * startup, or re-reading it on a settings import, only touches the
+ * workspace the user is looking at.
+ */
+void UAVGadgetManager::restoreDeferredState()
+{
+    if (!m_restorePending) {
+        return;
+    }
+    m_restorePending = false;
+
+    // restoreState() and the gadgets consume a QSettings, so replay the
+    // stored map through a throwaway one
+    QTemporaryFile file;
+    file.open();
+    file.close();
+    {
+        QSettings tmp(file.fileName(), QSettings::IniFormat);
+        QMapIterator<QString, QVariant> it(m_deferredState);
+        while (it.hasNext()) {
+            it.next();
+            tmp.setValue(it.key(), it.value());
+        }
+        restoreState(&tmp);
+    }
+    m_deferredState.clear();
+
+    showToolbars(m_showToolbars);
+}
+
 void UAVGadgetManager::split(Qt::Orientation orientation)
 {
     if (m_core->modeManager()->currentMode() != this) {
@@ -36,8 +36,10 @@
 
 #include <QWidget>
 #include <QtCore/QList>
+#include <QtCore/QMap>
 #include <QtCore/QPointer>
 #include <QtCore/QSettings>
+#include <QtCore/QVariant>
 #include <QIcon>
 
 QT_BEGIN_NAMESPACE
@@ -127,6 +129,7 @@ public slots:
 
 private:
     void setCurrentGadget(IUAVGadget *gadget);
+    void restoreDeferredState();
     void addGadgetToContext(IUAVGadget *gadget);
     void removeGadget(IUAVGadget *gadget);
     void closeView(Core::Internal::UAVGadgetView *view);
@@ -134,6 +137,10 @@ private:
     Core::Internal::SplitterOrView *currentSplitterOrView() const;
 
     bool m_showToolbars;
+    // Workspace layout waiting for first activation of this mode, kept as
+    // our own copy because the QSettings it was read from may be temporary
+    QMap<QString, QVariant> m_deferredState;
+    bool m_restorePending;
     Core::Internal::SplitterOrView *m_splitterOrView;
     Core::IUAVGadget *m_currentGadget;
     Core::ICore *m_core;
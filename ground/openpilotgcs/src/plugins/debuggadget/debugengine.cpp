@@ -1,8 +1,15 @@
 #include "debugengine.h"
 
+// Bound on messages buffered while no debug gadget is consuming them or
+// between two refreshes of a visible one; beyond it messages are counted
+// and dropped instead of growing the queue
+#define DEBUGENGINE_MAX_PENDING 2000
+
 debugengine::debugengine()
 {
     mut_lock = new QMutex(QMutex::Recursive);
+    _color   = Qt::black;
+    _dropped = 0;
 }
 
 debugengine *debugengine::getInstance()
@@ -18,27 +25,36 @@ debugengine::~debugengine()
     mut_lock = NULL;
 }
 
-void debugengine::setTextEdit(QTextBrowser *textEdit)
+void debugengine::writeMessage(const QString &message)
 {
     QMutexLocker lock(mut_lock);
 
-    _textEdit = textEdit;
+    if (_pending.count() >= DEBUGENGINE_MAX_PENDING) {
+        _dropped++;
+        return;
+    }
+    DebugMessage msg;
+    msg.color = _color;
+    msg.text  = message;
+    _pending.append(msg);
 }
 
-void debugengine::writeMessage(const QString &message)
+void debugengine::setColor(const QColor &c)
 {
     QMutexLocker lock(mut_lock);
 
-    if (_textEdit) {
-        _textEdit->append(message);
-    }
+    _color = c;
 }
 
-void debugengine::setColor(const QColor &c)
+QList<DebugMessage> debugengine::takeMessages(quint32 *dropped)
 {
     QMutexLocker lock(mut_lock);
+    QList<DebugMessage> messages = _pending;
 
-    if (_textEdit) {
-        _textEdit->setTextColor(c);
+    _pending.clear();
+    if (dropped) {
+        *dropped = _dropped;
     }
+    _dropped = 0;
+    return messages;
 }
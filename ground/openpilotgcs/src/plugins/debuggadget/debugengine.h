@@ -1,8 +1,14 @@
 #ifndef DEBUGENGINE_H
 #define DEBUGENGINE_H
-#include <QTextBrowser>
-#include <QPointer>
+#include <QColor>
+#include <QList>
 #include <QMutex>
+#include <QString>
+
+struct DebugMessage {
+    QColor  color;
+    QString text;
+};
 
 class debugengine {
 // Add all missing constructor etc... to have singleton
@@ -10,12 +16,17 @@ class debugengine {
     ~debugengine();
 public:
     static debugengine *getInstance();
-    void setTextEdit(QTextBrowser *textEdit);
     void writeMessage(const QString &message);
     void setColor(const QColor &c);
+    // Hand the pending messages over to the consumer, with the number of
+    // messages dropped because the bounded queue overflowed since the
+    // last call
+    QList<DebugMessage> takeMessages(quint32 *dropped);
     QMutex *mut_lock;
 private:
-    QPointer<QTextBrowser> _textEdit;
+    QColor _color;
+    QList<DebugMessage> _pending;
+    quint32 _dropped;
 };
 
 #endif // DEBUGENGINE_H
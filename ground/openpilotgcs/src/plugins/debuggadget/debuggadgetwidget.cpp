@@ -37,9 +37,15 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QScrollBar>
+#include <QTextCursor>
 #include <QTime>
+#include <QTimer>
 
-QPointer<QTextBrowser> m_textedit;
+// Refresh period of the text widget; messages arriving in between are
+// queued in the debugengine and appended as one batch
+#define REFRESH_PERIOD_MS   100
+// Oldest lines are discarded beyond this, keeping the document bounded
+#define MAX_DISPLAYED_LINES 1000
 
 void DebugGadgetWidget::customMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
@@ -65,7 +71,6 @@ void DebugGadgetWidget::customMessageHandler(QtMsgType type, const QMessageLogCo
         abort();
     }
 
-    debugengine::getInstance()->setTextEdit(m_textedit);
     debugengine::getInstance()->setColor(color);
     debugengine::getInstance()->writeMessage(txt);
 }
@@ -82,6 +87,12 @@ DebugGadgetWidget::DebugGadgetWidget(QWidget *parent) : QLabel(parent)
     // connect(de, SIGNAL(dbgMsg(QString, QList<QVariant>)), this, SLOT(dbgMsg(QString, QList<QVariant>)));
     // connect(de, SIGNAL(dbgMsgError(QString, QList<QVariant>)), this, SLOT(dbgMsgError(QString, QList<QVariant>)));
     connect(m_config->pushButton, SIGNAL(clicked()), this, SLOT(saveLog()));
+
+    m_config->plainTextEdit->document()->setMaximumBlockCount(MAX_DISPLAYED_LINES);
+
+    QTimer *refreshTimer = new QTimer(this);
+    connect(refreshTimer, SIGNAL(timeout()), this, SLOT(refreshLog()));
+    refreshTimer->start(REFRESH_PERIOD_MS);
 }
 
 DebugGadgetWidget::~DebugGadgetWidget()
@@ -91,20 +102,50 @@ DebugGadgetWidget::~DebugGadgetWidget()
 
 void DebugGadgetWidget::dbgMsg(const QString &level, const QList<QVariant> &msgs)
 {
-    m_config->plainTextEdit->setTextColor(Qt::red);
-
-    m_config->plainTextEdit->append(QString("%2[%0]%1").arg(level).arg(msgs[0].toString()).arg(QTime::currentTime().toString()));
-
-    QScrollBar *sb = m_config->plainTextEdit->verticalScrollBar();
-    sb->setValue(sb->maximum());
+    debugengine::getInstance()->setColor(Qt::red);
+    debugengine::getInstance()->writeMessage(QString("%2[%0]%1").arg(level).arg(msgs[0].toString()).arg(QTime::currentTime().toString()));
 }
 
 void DebugGadgetWidget::dbgMsgError(const QString &level, const QList<QVariant> &msgs)
 {
-    m_config->plainTextEdit->setTextColor(Qt::black);
+    debugengine::getInstance()->setColor(Qt::black);
+    debugengine::getInstance()->writeMessage(QString("%2[%0]%1").arg(level).arg(msgs[0].toString()).arg(QTime::currentTime().toString()));
+}
 
+/**
+ * Append everything queued since the last refresh in a single edit
+ * block, so the widget relayouts once per batch instead of once per
+ * message.
+ */
+void DebugGadgetWidget::refreshLog()
+{
+    quint32 dropped = 0;
+    QList<DebugMessage> messages = debugengine::getInstance()->takeMessages(&dropped);
+
+    if (messages.isEmpty() && !dropped) {
+        return;
+    }
 
-    m_config->plainTextEdit->append(QString("%2[%0]%1").arg(level).arg(msgs[0].toString()).arg(QTime::currentTime().toString()));
+    QTextCursor cursor(m_config->plainTextEdit->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    foreach(const DebugMessage &message, messages) {
+        QTextCharFormat format;
+
+        format.setForeground(message.color);
+        cursor.insertBlock();
+        cursor.setCharFormat(format);
+        cursor.insertText(message.text);
+    }
+    if (dropped) {
+        QTextCharFormat format;
+
+        format.setForeground(QBrush(Qt::red));
+        cursor.insertBlock();
+        cursor.setCharFormat(format);
+        cursor.insertText(tr("[%1 message(s) dropped]").arg(dropped));
+    }
+    cursor.endEditBlock();
 
     QScrollBar *sb = m_config->plainTextEdit->verticalScrollBar();
     sb->setValue(sb->maximum());
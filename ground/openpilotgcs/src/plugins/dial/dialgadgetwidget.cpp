@@ -28,6 +28,7 @@
 
 #include "dialgadgetwidget.h"
 #include <utils/stylehelper.h>
+#include <utils/cachedsvgitem.h>
 #include <iostream>
 #include <QtOpenGL/QGLWidget>
 #include <QDebug>
@@ -47,6 +48,12 @@ DialGadgetWidget::DialGadgetWidget(QWidget *parent) : QGraphicsView(parent)
     obj1    = NULL;
     obj2    = NULL;
     obj3    = NULL;
+    fieldPtr1     = NULL;
+    fieldPtr2     = NULL;
+    fieldPtr3     = NULL;
+    fieldElement1 = 0;
+    fieldElement2 = 0;
+    fieldElement3 = 0;
     m_text1 = NULL;
     m_text2 = NULL;
     m_text3 = NULL; // Should be initialized to NULL otherwise the setFont method
@@ -97,6 +104,10 @@ void DialGadgetWidget::connectNeedles(QString object1, QString nfield1,
         disconnect(obj3, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateNeedle3(UAVObject *)));
     }
 
+    fieldPtr1 = NULL;
+    fieldPtr2 = NULL;
+    fieldPtr3 = NULL;
+
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
 
@@ -115,6 +126,12 @@ void DialGadgetWidget::connectNeedles(QString object1, QString nfield1,
                 field1 = nfield1;
                 haveSubField1 = false;
             }
+            // Resolve the field and element once, the update slot reuses them
+            fieldPtr1     = obj1->getField(field1);
+            fieldElement1 = 0;
+            if (fieldPtr1 && haveSubField1) {
+                fieldElement1 = fieldPtr1->getElementNames().indexOf(QRegExp(subfield1, Qt::CaseSensitive, QRegExp::FixedString));
+            }
         } else {
             qDebug() << "Error: Object is unknown (" << object1 << ").";
         }
@@ -135,6 +152,11 @@ void DialGadgetWidget::connectNeedles(QString object1, QString nfield1,
                 field2 = nfield2;
                 haveSubField2 = false;
             }
+            fieldPtr2     = obj2->getField(field2);
+            fieldElement2 = 0;
+            if (fieldPtr2 && haveSubField2) {
+                fieldElement2 = fieldPtr2->getElementNames().indexOf(QRegExp(subfield2, Qt::CaseSensitive, QRegExp::FixedString));
+            }
         } else {
             qDebug() << "Error: Object is unknown (" << object2 << ").";
         }
@@ -155,6 +177,11 @@ void DialGadgetWidget::connectNeedles(QString object1, QString nfield1,
                 field3 = nfield3;
                 haveSubField3 = false;
             }
+            fieldPtr3     = obj3->getField(field3);
+            fieldElement3 = 0;
+            if (fieldPtr3 && haveSubField3) {
+                fieldElement3 = fieldPtr3->getElementNames().indexOf(QRegExp(subfield3, Qt::CaseSensitive, QRegExp::FixedString));
+            }
         } else {
             qDebug() << "Error: Object is unknown (" << object3 << ").";
         }
@@ -166,17 +193,12 @@ void DialGadgetWidget::connectNeedles(QString object1, QString nfield1,
  */
 void DialGadgetWidget::updateNeedle1(UAVObject *object1)
 {
-    // Double check that the field exists:
+    Q_UNUSED(object1);
     double value;
-    UAVObjectField *field = object1->getField(field1);
 
-    if (field) {
-        if (haveSubField1) {
-            int indexOfSubField = field->getElementNames().indexOf(QRegExp(subfield1, Qt::CaseSensitive, QRegExp::FixedString));
-            value = field->getDouble(indexOfSubField);
-        } else {
-            value = field->getDouble();
-        }
+    // The field and element were resolved at connect time, no name lookups here
+    if (fieldPtr1 && (fieldElement1 >= 0)) {
+        value = fieldPtr1->getDouble(fieldElement1);
         if (value != value) {
             qDebug() << "Dial widget: encountered NaN !!";
             return;
@@ -192,16 +214,11 @@ void DialGadgetWidget::updateNeedle1(UAVObject *object1)
  */
 void DialGadgetWidget::updateNeedle2(UAVObject *object2)
 {
+    Q_UNUSED(object2);
     double value;
-    UAVObjectField *field = object2->getField(field2);
 
-    if (field) {
-        if (haveSubField2) {
-            int indexOfSubField = field->getElementNames().indexOf(QRegExp(subfield2, Qt::CaseSensitive, QRegExp::FixedString));
-            value = field->getDouble(indexOfSubField);
-        } else {
-            value = field->getDouble();
-        }
+    if (fieldPtr2 && (fieldElement2 >= 0)) {
+        value = fieldPtr2->getDouble(fieldElement2);
         if (value != value) {
             qDebug() << "Dial widget: encountered NaN !!";
             return;
@@ -217,16 +234,11 @@ void DialGadgetWidget::updateNeedle2(UAVObject *object2)
  */
 void DialGadgetWidget::updateNeedle3(UAVObject *object3)
 {
+    Q_UNUSED(object3);
     double value;
-    UAVObjectField *field = object3->getField(field3);
 
-    if (field) {
-        if (haveSubField3) {
-            int indexOfSubField = field->getElementNames().indexOf(QRegExp(subfield3, Qt::CaseSensitive, QRegExp::FixedString));
-            value = field->getDouble(indexOfSubField);
-        } else {
-            value = field->getDouble();
-        }
+    if (fieldPtr3 && (fieldElement3 >= 0)) {
+        value = fieldPtr3->getDouble(fieldElement3);
         if (value != value) {
             qDebug() << "Dial widget: encountered NaN !!";
             return;
@@ -251,14 +263,17 @@ void DialGadgetWidget::setDialFile(QString dfn, QString bg, QString fg, QString
     setBackgroundBrush(QBrush(Utils::StyleHelper::baseColor()));
     if (QFile::exists(dfn) && m_renderer->load(dfn) && m_renderer->isValid()) {
         l_scene->clear(); // This also deletes all items contained in the scene.
-        m_background = new QGraphicsSvgItem();
+        // Each layer is a CachedSvgItem: with an OpenGL viewport the SVG is
+        // rasterized to a texture once per scale change and needle movement
+        // only redraws textured quads instead of re-rendering the SVG.
+        m_background = new CachedSvgItem();
         // All other items will be clipped to the shape of the background
         m_background->setFlags(QGraphicsItem::ItemClipsChildrenToShape |
                                QGraphicsItem::ItemClipsToShape);
-        m_foreground = new QGraphicsSvgItem();
-        m_needle1    = new QGraphicsSvgItem();
-        m_needle2    = new QGraphicsSvgItem();
-        m_needle3    = new QGraphicsSvgItem();
+        m_foreground = new CachedSvgItem();
+        m_needle1    = new CachedSvgItem();
+        m_needle2    = new CachedSvgItem();
+        m_needle3    = new CachedSvgItem();
         m_needle1->setParentItem(m_background);
         m_needle2->setParentItem(m_background);
         m_needle3->setParentItem(m_background);
@@ -428,7 +443,7 @@ void DialGadgetWidget::setDialFile(QString dfn, QString bg, QString fg, QString
         qDebug() << "no file: display default background.";
         m_renderer->load(QString(":/dial/images/empty.svg"));
         l_scene->clear(); // This also deletes all items contained in the scene.
-        m_background = new QGraphicsSvgItem();
+        m_background = new CachedSvgItem();
         m_background->setSharedRenderer(m_renderer);
         l_scene->addItem(m_background);
         m_text1   = NULL;
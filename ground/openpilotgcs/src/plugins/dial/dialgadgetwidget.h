@@ -174,6 +174,15 @@ private:
     QString subfield3;
     bool haveSubField3;
 
+    // Fields and element indices resolved once at connect time so the
+    // update slots don't do name lookups on every telemetry update
+    UAVObjectField *fieldPtr1;
+    UAVObjectField *fieldPtr2;
+    UAVObjectField *fieldPtr3;
+    int fieldElement1;
+    int fieldElement2;
+    int fieldElement3;
+
     // Rotation timer
     QTimer dialTimer;
 
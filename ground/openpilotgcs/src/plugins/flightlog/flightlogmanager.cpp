@@ -42,7 +42,11 @@
 #include <uavobjectutil/uavobjectutilmanager.h>
 
 FlightLogManager::FlightLogManager(QObject *parent) :
-    QObject(parent), m_disableControls(false),
+    QObject(parent),
+    m_streamEventLoop(NULL), m_streamTimeoutTimer(NULL),
+    m_streamExpectedFlight(0), m_streamExpectedEntry(0),
+    m_streamReceivedInWindow(0), m_streamGotLast(false),
+    m_disableControls(false),
     m_disableExport(true), m_cancelDownload(false),
     m_adjustExportedTimestamps(true)
 {
@@ -195,54 +199,49 @@ void FlightLogManager::retrieveLogs(int flightToRetrieve)
     UAVObjectRequestHelper requestHelper;
 
     clearLogList();
+    m_rawLogData.clear();
 
     // Set up what to retrieve
     int startFlight = (flightToRetrieve == -1) ? 0 : flightToRetrieve;
     int endFlight   = (flightToRetrieve == -1) ? m_flightLogStatus->getFlight() : flightToRetrieve;
 
-    // Prepare to send request for event retrieval
-    m_flightLogControl->setOperation(DebugLogControl::OPERATION_RETRIEVE);
+    // Try the streamed download first: one request per window of entries,
+    // with the flight side sending the window back to back. If the first
+    // window yields nothing the firmware is too old, fall back to one
+    // request/response round trip per entry.
+    bool useStreaming = true;
+
     for (int flight = startFlight; flight <= endFlight; flight++) {
         m_flightLogControl->setFlight(flight);
         bool gotLast = false;
         int slot     = 0;
-        while (!gotLast) {
+        int retries  = 0;
+        while (!gotLast && !m_cancelDownload) {
+            if (useStreaming) {
+                if (retrieveStreamWindow(flight, slot, gotLast, updateHelper)) {
+                    retries = 0;
+                    continue;
+                }
+                if (flight == startFlight && slot == 0) {
+                    qDebug() << "Flight log streaming not supported, using per entry requests";
+                    useStreaming = false;
+                    continue;
+                }
+                if (++retries > LOG_STREAM_RETRIES) {
+                    // We failed for some reason
+                    break;
+                }
+                continue;
+            }
+
             // Send request for loading flight entry on flight side and wait for ack/nack
             m_flightLogControl->setEntry(slot);
+            m_flightLogControl->setOperation(DebugLogControl::OPERATION_RETRIEVE);
 
             if (updateHelper.doObjectAndWait(m_flightLogControl, UAVTALK_TIMEOUT) == UAVObjectUpdaterHelper::SUCCESS &&
                 requestHelper.doObjectAndWait(m_flightLogEntry, UAVTALK_TIMEOUT) == UAVObjectUpdaterHelper::SUCCESS) {
                 if (m_flightLogEntry->getType() != DebugLogEntry::TYPE_EMPTY) {
-                    // Ok, we retrieved the entry, and it was the correct one. clone it and add it to the list
-                    ExtendedDebugLogEntry *logEntry = new ExtendedDebugLogEntry();
-
-                    logEntry->setData(m_flightLogEntry->getData(), m_objectManager);
-                    m_logEntries << logEntry;
-                    if (logEntry->getData().Type == DebugLogEntry::TYPE_MULTIPLEUAVOBJECTS) {
-                        const quint32 total_len  = sizeof(DebugLogEntry::DataFields);
-                        const quint32 data_len   = sizeof(((DebugLogEntry::DataFields *)0)->Data);
-                        const quint32 header_len = total_len - data_len;
-
-                        DebugLogEntry::DataFields fields;
-                        quint32 start = logEntry->getData().Size;
-
-                        // cycle until there is space for another object
-                        while (start + header_len + 1 < data_len) {
-                            memset(&fields, 0xFF, total_len);
-                            memcpy(&fields, &logEntry->getData().Data[start], header_len);
-                            // check wether a packed object is found
-                            // note that empty data blocks are set as 0xFF in flight side to minimize flash wearing
-                            // thus as soon as this read outside of used area, the test will fail as lenght would be 0xFFFF
-                            quint32 toread = header_len + fields.Size;
-                            if (!(toread + start > data_len)) {
-                                memcpy(&fields, &logEntry->getData().Data[start], toread);
-                                ExtendedDebugLogEntry *subEntry = new ExtendedDebugLogEntry();
-                                subEntry->setData(fields, m_objectManager);
-                                m_logEntries << subEntry;
-                            }
-                            start += toread;
-                        }
-                    }
+                    m_rawLogData << m_flightLogEntry->getData();
 
                     // Increment to get next entry from flight side
                     slot++;
@@ -254,9 +253,6 @@ void FlightLogManager::retrieveLogs(int flightToRetrieve)
                 // We failed for some reason
                 break;
             }
-            if (m_cancelDownload) {
-                break;
-            }
         }
         if (m_cancelDownload) {
             break;
@@ -264,10 +260,18 @@ void FlightLogManager::retrieveLogs(int flightToRetrieve)
     }
 
     if (m_cancelDownload) {
+        m_rawLogData.clear();
         clearLogList();
         m_cancelDownload = false;
     }
 
+    // Deserialize after the link has been drained instead of between
+    // requests, so the download is never stalled by object unpacking
+    foreach(const DebugLogEntry::DataFields &data, m_rawLogData) {
+        addLogEntryData(data);
+    }
+    m_rawLogData.clear();
+
     emit logEntriesChanged();
     setDisableExport(m_logEntries.count() == 0);
 
@@ -275,6 +279,120 @@ void FlightLogManager::retrieveLogs(int flightToRetrieve)
     setDisableControls(false);
 }
 
+/**
+ * Requests one window of streamed entries starting at slot and collects
+ * the unrequested DebugLogEntry updates the flight side sends back.
+ * Returns false if nothing usable arrived, the caller retries or falls
+ * back to per entry requests.
+ */
+bool FlightLogManager::retrieveStreamWindow(int flight, int &slot, bool &gotLast, UAVObjectUpdaterHelper &updateHelper)
+{
+    m_flightLogControl->setEntry(slot);
+    m_flightLogControl->setOperation(DebugLogControl::OPERATION_RETRIEVESTREAM);
+
+    m_streamExpectedFlight   = flight;
+    m_streamExpectedEntry    = slot;
+    m_streamReceivedInWindow = 0;
+    m_streamGotLast = false;
+
+    QEventLoop eventLoop;
+    QTimer timeoutTimer;
+    timeoutTimer.setSingleShot(true);
+    connect(&timeoutTimer, SIGNAL(timeout()), &eventLoop, SLOT(quit()));
+    m_streamEventLoop    = &eventLoop;
+    m_streamTimeoutTimer = &timeoutTimer;
+
+    connect(m_flightLogEntry, SIGNAL(objectUnpacked(UAVObject *)), this, SLOT(streamedEntryReceived(UAVObject *)));
+    if (updateHelper.doObjectAndWait(m_flightLogControl, UAVTALK_TIMEOUT) == UAVObjectUpdaterHelper::SUCCESS) {
+        // entries may already have arrived while waiting for the ack
+        if (!m_streamGotLast && m_streamReceivedInWindow < LOG_STREAM_WINDOW) {
+            timeoutTimer.start(UAVTALK_TIMEOUT);
+            eventLoop.exec();
+        }
+    }
+    disconnect(m_flightLogEntry, SIGNAL(objectUnpacked(UAVObject *)), this, SLOT(streamedEntryReceived(UAVObject *)));
+    m_streamEventLoop    = NULL;
+    m_streamTimeoutTimer = NULL;
+
+    if (!m_streamGotLast && m_streamReceivedInWindow == 0) {
+        return false;
+    }
+    slot   += m_streamReceivedInWindow;
+    gotLast = m_streamGotLast;
+    return true;
+}
+
+/**
+ * Collects one streamed log entry. Entries out of sequence (e.g. after a
+ * dropped update) are ignored, the window times out and is re-requested
+ * from the first missing slot.
+ */
+void FlightLogManager::streamedEntryReceived(UAVObject *object)
+{
+    Q_UNUSED(object);
+
+    DebugLogEntry::DataFields data = m_flightLogEntry->getData();
+
+    if (data.Flight != m_streamExpectedFlight || data.Entry != m_streamExpectedEntry) {
+        return;
+    }
+    if (data.Type == DebugLogEntry::TYPE_EMPTY) {
+        // We are done, not more entries on this flight
+        m_streamGotLast = true;
+        if (m_streamEventLoop) {
+            m_streamEventLoop->quit();
+        }
+        return;
+    }
+    m_rawLogData << data;
+    m_streamExpectedEntry++;
+    m_streamReceivedInWindow++;
+    if (m_streamReceivedInWindow >= LOG_STREAM_WINDOW) {
+        if (m_streamEventLoop) {
+            m_streamEventLoop->quit();
+        }
+    } else if (m_streamTimeoutTimer) {
+        m_streamTimeoutTimer->start(UAVTALK_TIMEOUT);
+    }
+}
+
+/**
+ * Clones a downloaded entry into the visible log entry list, expanding
+ * packed multiple object entries into their contained objects.
+ */
+void FlightLogManager::addLogEntryData(const DebugLogEntry::DataFields &data)
+{
+    ExtendedDebugLogEntry *logEntry = new ExtendedDebugLogEntry();
+
+    logEntry->setData(data, m_objectManager);
+    m_logEntries << logEntry;
+    if (logEntry->getData().Type == DebugLogEntry::TYPE_MULTIPLEUAVOBJECTS) {
+        const quint32 total_len  = sizeof(DebugLogEntry::DataFields);
+        const quint32 data_len   = sizeof(((DebugLogEntry::DataFields *)0)->Data);
+        const quint32 header_len = total_len - data_len;
+
+        DebugLogEntry::DataFields fields;
+        quint32 start = logEntry->getData().Size;
+
+        // cycle until there is space for another object
+        while (start + header_len + 1 < data_len) {
+            memset(&fields, 0xFF, total_len);
+            memcpy(&fields, &logEntry->getData().Data[start], header_len);
+            // check wether a packed object is found
+            // note that empty data blocks are set as 0xFF in flight side to minimize flash wearing
+            // thus as soon as this read outside of used area, the test will fail as lenght would be 0xFFFF
+            quint32 toread = header_len + fields.Size;
+            if (!(toread + start > data_len)) {
+                memcpy(&fields, &logEntry->getData().Data[start], toread);
+                ExtendedDebugLogEntry *subEntry = new ExtendedDebugLogEntry();
+                subEntry->setData(fields, m_objectManager);
+                m_logEntries << subEntry;
+            }
+            start += toread;
+        }
+    }
+}
+
 void FlightLogManager::exportToOPL(QString fileName)
 {
     // Fix the file name
@@ -35,6 +35,8 @@
 #include <QSemaphore>
 #include <QXmlStreamWriter>
 #include <QTextStream>
+#include <QEventLoop>
+#include <QTimer>
 
 #include "uavobjectmanager.h"
 #include "uavobjectutilmanager.h"
@@ -45,6 +47,8 @@
 #include "objectpersistence.h"
 #include "uavtalk/telemetrymanager.h"
 
+class UAVObjectUpdaterHelper;
+
 class UAVOLogSettingsWrapper : public QObject {
     Q_OBJECT Q_PROPERTY(UAVDataObject *object READ object NOTIFY objectChanged)
     Q_PROPERTY(QString name READ name NOTIFY nameChanged)
@@ -318,6 +322,7 @@ private slots:
     void setupLogSettings();
     void setupLogStatuses();
     void connectionStatusChanged();
+    void streamedEntryReceived(UAVObject *object);
     bool updateLogWrapper(QString name, int level, int period);
 
 private:
@@ -342,8 +347,25 @@ private:
     void exportToCSV(QString fileName);
     void exportToXML(QString fileName);
 
+    bool retrieveStreamWindow(int flight, int &slot, bool &gotLast, UAVObjectUpdaterHelper &updateHelper);
+    void addLogEntryData(const DebugLogEntry::DataFields &data);
+
     static const int UAVTALK_TIMEOUT = 4000;
     static const int LOG_SETTINGS_FILE_VERSION = 1;
+    // number of consecutive entries the flight side sends for one
+    // RetrieveStream request, must match LOG_STREAM_WINDOW in Logging.c
+    static const int LOG_STREAM_WINDOW = 16;
+    static const int LOG_STREAM_RETRIES = 2;
+
+    // state of the streamed download, owned by retrieveStreamWindow()
+    QList<DebugLogEntry::DataFields> m_rawLogData;
+    QEventLoop *m_streamEventLoop;
+    QTimer *m_streamTimeoutTimer;
+    int m_streamExpectedFlight;
+    int m_streamExpectedEntry;
+    int m_streamReceivedInWindow;
+    bool m_streamGotLast;
+
     bool m_disableControls;
     bool m_disableExport;
     bool m_cancelDownload;
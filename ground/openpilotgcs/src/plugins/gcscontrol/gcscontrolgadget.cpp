@@ -32,7 +32,9 @@
 #include "uavobject.h"
 #include <QDebug>
 
-#define JOYSTICK_UPDATE_RATE 50
+// Minimum interval between joystick driven command sends; 50Hz is in the
+// same league as an RC link
+#define JOYSTICK_UPDATE_RATE 20
 
 GCSControlGadget::GCSControlGadget(QString classId, GCSControlGadgetWidget *widget, QWidget *parent, QObject *plugin) :
     IUAVGadget(classId, parent),
@@ -48,11 +50,15 @@ GCSControlGadget::GCSControlGadget(QString classId, GCSControlGadgetWidget *widg
 
     connect(control_sock, SIGNAL(readyRead()), this, SLOT(readUDPCommand()));
 
-    joystickTime.start();
+    lastAxesSendTime     = 0;
+    pendingAxesTimestamp = 0;
+    axesSendTimer.setSingleShot(true);
+    connect(&axesSendTimer, SIGNAL(timeout()), this, SLOT(sendPendingAxesValues()));
+
     GCSControlPlugin *pl = dynamic_cast<GCSControlPlugin *>(plugin);
     connect(pl->sdlGamepad, SIGNAL(gamepads(quint8)), this, SLOT(gamepads(quint8)));
     connect(pl->sdlGamepad, SIGNAL(buttonState(ButtonNumber, bool)), this, SLOT(buttonState(ButtonNumber, bool)));
-    connect(pl->sdlGamepad, SIGNAL(axesValues(QListInt16)), this, SLOT(axesValues(QListInt16)));
+    connect(pl->sdlGamepad, SIGNAL(axesValuesTimed(QListInt16, quint64)), this, SLOT(axesValues(QListInt16, quint64)));
 }
 
 GCSControlGadget::~GCSControlGadget()
@@ -420,7 +426,7 @@ void GCSControlGadget::buttonState(ButtonNumber number, bool pressed)
     // buttonSettings[number].Amount
 }
 
-void GCSControlGadget::axesValues(QListInt16 values)
+void GCSControlGadget::axesValues(QListInt16 values, quint64 timestamp)
 {
     int chMax = values.length();
 
@@ -430,6 +436,30 @@ void GCSControlGadget::axesValues(QListInt16 values)
         return;
     }
 
+    // Rate limit on the capture timestamps. Inside the limit only the
+    // most recent sample is kept and a deferred send is scheduled, so
+    // nothing the pilot does is ever dropped for good.
+    if (timestamp - lastAxesSendTime >= JOYSTICK_UPDATE_RATE) {
+        lastAxesSendTime = timestamp;
+        axesSendTimer.stop();
+        processAxesValues(values);
+    } else {
+        pendingAxesValues    = values;
+        pendingAxesTimestamp = timestamp;
+        if (!axesSendTimer.isActive()) {
+            axesSendTimer.start(JOYSTICK_UPDATE_RATE - (timestamp - lastAxesSendTime));
+        }
+    }
+}
+
+void GCSControlGadget::sendPendingAxesValues()
+{
+    lastAxesSendTime = pendingAxesTimestamp;
+    processAxesValues(pendingAxesValues);
+}
+
+void GCSControlGadget::processAxesValues(const QListInt16 &values)
+{
     double rValue = (rollChannel > -1) ? values[rollChannel] : 0;
     double pValue = (pitchChannel > -1) ? values[pitchChannel] : 0;
     double yValue = (yawChannel > -1) ? values[yawChannel] : 0;
@@ -458,27 +488,24 @@ void GCSControlGadget::axesValues(QListInt16 values)
     }
 
 
-    if (joystickTime.elapsed() > JOYSTICK_UPDATE_RATE) {
-        joystickTime.restart();
-        // Remap RPYT to left X/Y and right X/Y depending on mode
-        // Mode 1: LeftX = Yaw, LeftY = Pitch, RightX = Roll, RightY = Throttle
-        // Mode 2: LeftX = Yaw, LeftY = THrottle, RightX = Roll, RightY = Pitch
-        // Mode 3: LeftX = Roll, LeftY = Pitch, RightX = Yaw, RightY = Throttle
-        // Mode 4: LeftX = Roll, LeftY = Throttle, RightX = Yaw, RightY = Pitch;
-        switch (controlsMode) {
-        case 1:
-            sticksChangedLocally(yValue / max, -pValue / max, rValue / max, -tValue / max);
-            break;
-        case 2:
-            sticksChangedLocally(yValue / max, -tValue / max, rValue / max, -pValue / max);
-            break;
-        case 3:
-            sticksChangedLocally(rValue / max, -pValue / max, yValue / max, -tValue / max);
-            break;
-        case 4:
-            sticksChangedLocally(rValue / max, -tValue / max, yValue / max, -pValue / max);
-            break;
-        }
+    // Remap RPYT to left X/Y and right X/Y depending on mode
+    // Mode 1: LeftX = Yaw, LeftY = Pitch, RightX = Roll, RightY = Throttle
+    // Mode 2: LeftX = Yaw, LeftY = THrottle, RightX = Roll, RightY = Pitch
+    // Mode 3: LeftX = Roll, LeftY = Pitch, RightX = Yaw, RightY = Throttle
+    // Mode 4: LeftX = Roll, LeftY = Throttle, RightX = Yaw, RightY = Pitch;
+    switch (controlsMode) {
+    case 1:
+        sticksChangedLocally(yValue / max, -pValue / max, rValue / max, -tValue / max);
+        break;
+    case 2:
+        sticksChangedLocally(yValue / max, -tValue / max, rValue / max, -pValue / max);
+        break;
+    case 3:
+        sticksChangedLocally(rValue / max, -pValue / max, yValue / max, -tValue / max);
+        break;
+    case 4:
+        sticksChangedLocally(rValue / max, -tValue / max, yValue / max, -pValue / max);
+        break;
     }
 }
 
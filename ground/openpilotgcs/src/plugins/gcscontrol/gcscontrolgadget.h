@@ -32,7 +32,7 @@
 #include "manualcontrolcommand.h"
 #include "gcscontrolgadgetconfiguration.h"
 #include "sdlgamepad/sdlgamepad.h"
-#include <QTime>
+#include <QTimer>
 #include "gcscontrolplugin.h"
 #include <QUdpSocket>
 #include <QHostAddress>
@@ -71,7 +71,14 @@ public:
 private:
     ManualControlCommand *getManualControlCommand();
     double constrain(double value);
-    QTime joystickTime;
+    void processAxesValues(const QListInt16 &values);
+    // Joystick send rate limiting on monotonic capture timestamps;
+    // a deferred send keeps the latest coalesced sample so the final
+    // stick position always reaches the flight side
+    quint64 lastAxesSendTime;
+    quint64 pendingAxesTimestamp;
+    QListInt16 pendingAxesValues;
+    QTimer axesSendTimer;
     QWidget *m_widget;
     QList<int> m_context;
     UAVObject::Metadata mccInitialData;
@@ -98,7 +105,8 @@ protected slots:
     // signals from joystick
     void gamepads(quint8 count);
     void buttonState(ButtonNumber number, bool pressed);
-    void axesValues(QListInt16 values);
+    void axesValues(QListInt16 values, quint64 timestamp);
+    void sendPendingAxesValues();
 };
 
 
@@ -36,10 +36,17 @@ GpsDisplayGadget::GpsDisplayGadget(QString classId, GpsDisplayWidget *widget, QW
 {
     connect(m_widget->connectButton, SIGNAL(clicked(bool)), this, SLOT(onConnect()));
     connect(m_widget->disconnectButton, SIGNAL(clicked(bool)), this, SLOT(onDisconnect()));
+
+    parserThread.start();
 }
 
 GpsDisplayGadget::~GpsDisplayGadget()
 {
+    if (parser) {
+        parser->deleteLater();
+    }
+    parserThread.quit();
+    parserThread.wait();
     delete m_widget;
 }
 
@@ -56,9 +63,11 @@ void GpsDisplayGadget::loadConfiguration(IUAVGadgetConfiguration *config)
         delete port;
     }
 
-    // Delete the (old)parser, this also disconnects all signals.
+    // Dispose of the (old)parser, this also disconnects all signals.
+    // The serial parser lives in the parser thread, so it cannot be
+    // deleted directly from here.
     if (parser) {
-        delete parser;
+        parser->deleteLater();
     }
 
     GpsDisplayGadgetConfiguration *gpsDisplayConfig = qobject_cast< GpsDisplayGadgetConfiguration *>(config);
@@ -80,7 +89,13 @@ void GpsDisplayGadget::loadConfiguration(IUAVGadgetConfiguration *config)
             if (nport.portName() == gpsDisplayConfig->port()) {
                 qDebug() << "Using Serial parser";
                 parser = new NMEAParser();
-                port   = new QSerialPort(nport);
+                // parse in the background so a fast NMEA feed does not
+                // contend with rendering on the GUI thread; the parser
+                // signals come back to the widgets as queued events
+                parser->moveToThread(&parserThread);
+                connect(this, SIGNAL(serialDataReady(QByteArray)),
+                        parser, SLOT(processStreamData(QByteArray)));
+                port = new QSerialPort(nport);
                 m_widget->connectButton->setEnabled(true);
                 m_widget->disconnectButton->setEnabled(false);
                 m_widget->connectButton->setHidden(false);
@@ -159,17 +174,9 @@ void GpsDisplayGadget::onDataAvailable()
         serialData.resize(avail);
         int bytesRead = port->read(serialData.data(), serialData.size());
         if (bytesRead > 0) {
-            processNewSerialData(serialData);
+            serialData.truncate(bytesRead);
+            // hand the chunk to the parser thread
+            emit serialDataReady(serialData);
         }
     }
 }
-
-void GpsDisplayGadget::processNewSerialData(QByteArray serialData)
-{
-    int dataLength   = serialData.size();
-    const char *data = serialData.constData();
-
-    for (int pos = 0; pos < dataLength; pos++) {
-        parser->processInputStream(data[pos]);
-    }
-}
@@ -41,3 +41,16 @@ void GPSParser::processInputStream(char c)
         Q_UNUSED(c)
     }
 }
+
+/**
+ * Slot fed from the gadget with raw reads; when the parser has been moved
+ * to a worker thread this is where the parsing work actually runs
+ */
+void GPSParser::processStreamData(QByteArray data)
+{
+    const char *c = data.constData();
+
+    for (int pos = 0; pos < data.size(); pos++) {
+        processInputStream(c[pos]);
+    }
+}
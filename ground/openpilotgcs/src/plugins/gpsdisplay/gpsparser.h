@@ -37,6 +37,9 @@ class GPSParser : public QObject {
 public: ~GPSParser();
     virtual void processInputStream(char c);
 
+public slots:
+    void processStreamData(QByteArray data); // Parse a chunk of raw data at once
+
 protected:
     GPSParser(QObject *parent = 0);
 
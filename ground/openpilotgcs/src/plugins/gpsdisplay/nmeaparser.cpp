@@ -69,6 +69,8 @@ NMEAParser::NMEAParser(QObject *parent) : GPSParser(parent)
 {
     bufferInit(&gpsRxBuffer, (unsigned char *)gpsRxData, 512);
     gpsRxOverflow = 0;
+    memset(satModel, 0, sizeof(satModel));
+    memset(satShown, 0, sizeof(satShown));
 }
 
 NMEAParser::~NMEAParser()
@@ -272,21 +274,32 @@ void NMEAParser::nmeaProcessGPGSV(char *packet)
 
     int sats = (tokenslist.size() - 4) / 4;
     for (int sat = 0; sat < sats; sat++) {
-        int base          = 4 + sat * 4;
-        const int id      = tokenslist.at(base + 0).toInt(); // Satellite PRN number
-        const int elv     = tokenslist.at(base + 1).toInt(); // Elevation, degrees
-        const int azimuth = tokenslist.at(base + 2).toInt(); // Azimuth, degrees
-        const int sig     = tokenslist.at(base + 3).toInt(); // SNR - higher is better
-        const int index   = (sentence_index - 1) * 4 + sat;
-        emit satellite(index, id, elv, azimuth, sig);
+        int base        = 4 + sat * 4;
+        const int index = (sentence_index - 1) * 4 + sat;
+        if (index >= NMEA_MAX_SATELLITES) {
+            continue;
+        }
+        satModel[index][0] = tokenslist.at(base + 0).toInt(); // Satellite PRN number
+        satModel[index][1] = tokenslist.at(base + 1).toInt(); // Elevation, degrees
+        satModel[index][2] = tokenslist.at(base + 2).toInt(); // Azimuth, degrees
+        satModel[index][3] = tokenslist.at(base + 3).toInt(); // SNR - higher is better
     }
 
     if (sentence_index == sentence_total) {
-        // Last sentence
+        // Last sentence: wipe the unused slots, then push the whole cycle
+        // to the widgets in one batch, skipping unchanged slots so the
+        // sky-plot scenes are only touched when a satellite moved
         int total_sats = (sentence_index - 1) * 4 + sats;
-        for (int emptySatIndex = total_sats; emptySatIndex < 16; emptySatIndex++) {
-            // Wipe the rest.
-            emit satellite(emptySatIndex, 0, 0, 0, 0);
+        for (int emptySatIndex = total_sats; emptySatIndex < NMEA_MAX_SATELLITES; emptySatIndex++) {
+            memset(satModel[emptySatIndex], 0, sizeof(satModel[emptySatIndex]));
+        }
+        for (int index = 0; index < NMEA_MAX_SATELLITES; index++) {
+            if (!memcmp(satModel[index], satShown[index], sizeof(satModel[index]))) {
+                continue;
+            }
+            memcpy(satShown[index], satModel[index], sizeof(satModel[index]));
+            emit satellite(index, satModel[index][0], satModel[index][1],
+                           satModel[index][2], satModel[index][3]);
         }
     }
 }
@@ -35,7 +35,8 @@
 #include "gpsparser.h"
 
 // constants/macros/typdefs
-#define NMEA_BUFFERSIZE 128
+#define NMEA_BUFFERSIZE      128
+#define NMEA_MAX_SATELLITES  16
 
 typedef struct struct_GpsData {
     double Latitude;
@@ -77,6 +78,13 @@ public:
     uint32_t numUpdates;
     uint32_t numErrors;
     int32_t gpsRxOverflow;
+
+private:
+    // Sky-plot model: PRN/elevation/azimuth/SNR per slot, accumulated
+    // across the GSV sentences of one cycle and pushed to the widgets in
+    // a single batch, emitting only the slots that actually changed
+    int satModel[NMEA_MAX_SATELLITES][4];
+    int satShown[NMEA_MAX_SATELLITES][4];
 };
 
 #endif // NMEAPARSER_H
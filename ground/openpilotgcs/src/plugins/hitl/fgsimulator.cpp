@@ -30,6 +30,8 @@
 #include "coreplugin/icore.h"
 #include "coreplugin/threadmanager.h"
 
+#include <QtEndian>
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -130,7 +132,10 @@ bool FGSimulator::setupProcess()
         emit processOutput("Start Flightgear from the command line with the following arguments: \n\n" + args + "\n\n" +
                            "You can optionally run Flightgear from a networked computer.\n" +
                            "Make sure the computer running Flightgear can can ping your local interface adapter. ie." + settings.hostAddress + "\n"
-                           "Remote computer must have the correct OpenPilot protocol installed.");
+                           "Remote computer must have the correct OpenPilot protocol installed.\n" +
+                           "For high rate HITL install opfgprotocol-binary.xml as well and use\n" +
+                           "--generic=socket,out,500," + settings.hostAddress + "," + QString::number(settings.inPort) + ",udp,opfgprotocol-binary\n" +
+                           "for the out socket instead, the GCS detects the packed protocol automatically.");
     }
 
     udpCounterGCSsend = 0;
@@ -223,60 +228,83 @@ void FGSimulator::transmitUpdate()
 void FGSimulator::processUpdate(const QByteArray & inp)
 {
     // TODO: this does not use the FLIGHT_PARAM structure, it should!
-    // Split
-    QString data(inp);
-    QStringList fields = data.split(",");
+    float v[FG_BINARY_FIELD_COUNT];
+    int n;
+
+    if (inp.size() == FG_BINARY_PACKET_SIZE &&
+        qFromBigEndian<quint32>((const uchar *)inp.constData() + FG_BINARY_PACKET_SIZE - 4) == FG_BINARY_MAGIC) {
+        // Packed protocol (opfgprotocol-binary.xml): fields in network
+        // byte order, no string parsing needed.
+        const uchar *data = (const uchar *)inp.constData();
+        for (int i = 0; i < FG_BINARY_FIELD_COUNT; i++) {
+            quint32 raw = qFromBigEndian<quint32>(data + 4 * i);
+            memcpy(&v[i], &raw, sizeof(v[i]));
+        }
+        n = (int)qFromBigEndian<quint32>(data + 4 * FG_BINARY_FIELD_COUNT);
+    } else {
+        // Text protocol (opfgprotocol.xml): comma separated line
+        QString datastr(inp);
+        QStringList fields = datastr.split(",");
+        if (fields.length() < FG_BINARY_FIELD_COUNT + 1) {
+            // truncated packet
+            return;
+        }
+        for (int i = 0; i < FG_BINARY_FIELD_COUNT; i++) {
+            v[i] = fields[i].toFloat();
+        }
+        n = fields[FG_BINARY_FIELD_COUNT].toInt();
+    }
+
     // Get xRate (deg/s)
-    // float xRate = fields[0].toFloat() * 180.0/M_PI;
+    // float xRate = v[0] * 180.0/M_PI;
     // Get yRate (deg/s)
-    // float yRate = fields[1].toFloat() * 180.0/M_PI;
+    // float yRate = v[1] * 180.0/M_PI;
     // Get zRate (deg/s)
-    // float zRate = fields[2].toFloat() * 180.0/M_PI;
+    // float zRate = v[2] * 180.0/M_PI;
     // Get xAccel (m/s^2)
-    float xAccel    = fields[3].toFloat() * FT2M;
+    float xAccel    = v[3] * FT2M;
     // Get yAccel (m/s^2)
-    float yAccel    = fields[4].toFloat() * FT2M;
+    float yAccel    = v[4] * FT2M;
     // Get xAccel (m/s^2)
-    float zAccel    = fields[5].toFloat() * FT2M;
+    float zAccel    = v[5] * FT2M;
     // Get pitch (deg)
-    float pitch     = fields[6].toFloat();
+    float pitch     = v[6];
     // Get pitchRate (deg/s)
-    float pitchRate = fields[7].toFloat();
+    float pitchRate = v[7];
     // Get roll (deg)
-    float roll     = fields[8].toFloat();
+    float roll     = v[8];
     // Get rollRate (deg/s)
-    float rollRate = fields[9].toFloat();
+    float rollRate = v[9];
     // Get yaw (deg)
-    float yaw       = fields[10].toFloat();
+    float yaw       = v[10];
     // Get yawRate (deg/s)
-    float yawRate   = fields[11].toFloat();
+    float yawRate   = v[11];
     // Get latitude (deg)
-    float latitude  = fields[12].toFloat();
+    float latitude  = v[12];
     // Get longitude (deg)
-    float longitude = fields[13].toFloat();
+    float longitude = v[13];
     // Get heading (deg)
-    // float heading      = fields[14].toFloat();
+    // float heading      = v[14];
     // Get altitude (m)
-    float altitude_msl = fields[15].toFloat() * FT2M;
+    float altitude_msl = v[15] * FT2M;
     // Get altitudeAGL (m)
-    float altitude_agl = fields[16].toFloat() * FT2M;
+    float altitude_agl = v[16] * FT2M;
     // Get groundspeed (m/s)
-    float groundspeed  = fields[17].toFloat() * KT2MPS;
+    float groundspeed  = v[17] * KT2MPS;
     // Get airspeed (m/s)
-    float airspeed     = fields[18].toFloat() * KT2MPS;
+    float airspeed     = v[18] * KT2MPS;
     // Get temperature (degC)
-    float temperature  = fields[19].toFloat();
+    float temperature  = v[19];
     // Get pressure (kpa)
-    float pressure     = fields[20].toFloat() * INHG2KPA;
+    float pressure     = v[20] * INHG2KPA;
     // Get VelocityState Down (m/s)
-    float velocityStateDown  = -fields[21].toFloat() * FPS2CMPS * 1e-2f;
+    float velocityStateDown  = -v[21] * FPS2CMPS * 1e-2f;
     // Get VelocityState East (m/s)
-    float velocityStateEast  = fields[22].toFloat() * FPS2CMPS * 1e-2f;
+    float velocityStateEast  = v[22] * FPS2CMPS * 1e-2f;
     // Get VelocityState Down (m/s)
-    float velocityStateNorth = fields[23].toFloat() * FPS2CMPS * 1e-2f;
+    float velocityStateNorth = v[23] * FPS2CMPS * 1e-2f;
 
-    // Get UDP packets received by FG
-    int n = fields[24].toInt();
+    // n is the number of UDP packets received by FG
 
     udpCounterFGrecv = n;
 
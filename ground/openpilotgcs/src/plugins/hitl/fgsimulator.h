@@ -47,6 +47,12 @@ private slots:
 
 private:
 
+    // Layout of the packed protocol defined in opfgprotocol-binary.xml:
+    // 24 floats and one int in network byte order plus a magic footer
+    static const int FG_BINARY_FIELD_COUNT = 24;
+    static const int FG_BINARY_PACKET_SIZE = (FG_BINARY_FIELD_COUNT + 1) * 4 + 4;
+    static const quint32 FG_BINARY_MAGIC   = 0x4F504647; // "OPFG"
+
     int udpCounterGCSsend; // keeps track of udp packets sent to FG
     int udpCounterFGrecv; // keeps track of udp packets received by FG
 
@@ -228,16 +228,16 @@ void Simulator::receiveUpdate()
 
     // Process data
     while (inSocket->hasPendingDatagrams()) {
-        // Receive datagram
-        QByteArray datagram;
-        datagram.resize(inSocket->pendingDatagramSize());
+        // Receive datagram into the preallocated buffer. The buffer keeps
+        // its capacity across datagrams, so at steady state no allocation
+        // happens per packet even at high simulation rates.
+        rxDatagram.resize(inSocket->pendingDatagramSize());
         QHostAddress sender;
         quint16 senderPort;
-        inSocket->readDatagram(datagram.data(), datagram.size(),
+        inSocket->readDatagram(rxDatagram.data(), rxDatagram.size(),
                                &sender, &senderPort);
-        // QString datastr(datagram);
         // Process incomming data
-        processUpdate(datagram);
+        processUpdate(rxDatagram);
     }
 }
 
@@ -355,6 +355,8 @@ private:
     QTimer *txTimer;
     QTimer *simTimer;
 
+    QByteArray rxDatagram; // reused across datagrams in receiveUpdate()
+
     QTime attRawTime;
     QTime gpsPosTime;
     QTime groundTruthTime;
@@ -3,6 +3,8 @@
 
 #include "ipconnectionplugin.h"
 
+class QTimer;
+
 // Simple class for creating & destroying a socket in the real-time thread
 // Needed because sockets need to be created in the same thread that they're used
 class IPConnection : public QObject {
@@ -17,6 +19,25 @@ public slots:
 
     void onOpenDevice(QString HostName, int Port, bool UseTCP);
     void onCloseDevice(QAbstractSocket *ipSocket);
+
+private slots:
+
+    void onSocketConnected();
+    void onSocketDown();
+    void onReconnectTimer();
+
+private:
+
+    void applySocketOptions(QAbstractSocket *ipSocket);
+
+    IPconnectionConnection *m_connection;
+    // reconnect state, only ever touched from the real-time thread
+    QAbstractSocket *reconnectSocket;
+    QString hostName;
+    int port;
+    bool useTCP;
+    QTimer *reconnectTimer;
+    int reconnectDelay;
 };
 
 #endif // IPCONNECTION_INTERNAL_H
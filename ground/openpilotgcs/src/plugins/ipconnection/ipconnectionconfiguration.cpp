@@ -32,7 +32,8 @@ IPconnectionConfiguration::IPconnectionConfiguration(QString classId, QSettings
     IUAVGadgetConfiguration(classId, parent),
     m_HostName("127.0.0.1"),
     m_Port(1000),
-    m_UseTCP(1)
+    m_UseTCP(1),
+    m_BufferSize(0)
 {
     Q_UNUSED(qSettings);
 
@@ -46,9 +47,10 @@ IUAVGadgetConfiguration *IPconnectionConfiguration::clone()
 {
     IPconnectionConfiguration *m = new IPconnectionConfiguration(this->classId());
 
-    m->m_Port     = m_Port;
-    m->m_HostName = m_HostName;
-    m->m_UseTCP   = m_UseTCP;
+    m->m_Port       = m_Port;
+    m->m_HostName   = m_HostName;
+    m->m_UseTCP     = m_UseTCP;
+    m->m_BufferSize = m_BufferSize;
     return m;
 }
 
@@ -61,6 +63,7 @@ void IPconnectionConfiguration::saveConfig(QSettings *qSettings) const
     qSettings->setValue("port", m_Port);
     qSettings->setValue("hostName", m_HostName);
     qSettings->setValue("useTCP", m_UseTCP);
+    qSettings->setValue("bufferSize", m_BufferSize);
 }
 
 void IPconnectionConfiguration::savesettings() const
@@ -72,6 +75,7 @@ void IPconnectionConfiguration::savesettings() const
     settings->setValue(QLatin1String("HostName"), m_HostName);
     settings->setValue(QLatin1String("Port"), m_Port);
     settings->setValue(QLatin1String("UseTCP"), m_UseTCP);
+    settings->setValue(QLatin1String("BufferSize"), m_BufferSize);
     settings->endArray();
     settings->endGroup();
 }
@@ -85,7 +89,8 @@ void IPconnectionConfiguration::restoresettings()
     settings->setArrayIndex(0);
     m_HostName = (settings->value(QLatin1String("HostName"), tr("")).toString());
     m_Port     = (settings->value(QLatin1String("Port"), tr("")).toInt());
-    m_UseTCP   = (settings->value(QLatin1String("UseTCP"), tr("")).toInt());
+    m_UseTCP     = (settings->value(QLatin1String("UseTCP"), tr("")).toInt());
+    m_BufferSize = (settings->value(QLatin1String("BufferSize"), 0).toInt());
     settings->endArray();
     settings->endGroup();
 }
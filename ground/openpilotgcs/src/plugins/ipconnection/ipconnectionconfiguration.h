@@ -38,6 +38,7 @@ class IPconnectionConfiguration : public IUAVGadgetConfiguration {
     Q_OBJECT Q_PROPERTY(QString HostName READ HostName WRITE setHostName)
     Q_PROPERTY(int Port READ Port WRITE setPort)
     Q_PROPERTY(int UseTCP READ UseTCP WRITE setUseTCP)
+    Q_PROPERTY(int BufferSize READ BufferSize WRITE setBufferSize)
 
 public:
     explicit IPconnectionConfiguration(QString classId, QSettings *qSettings = 0, QObject *parent = 0);
@@ -62,6 +63,10 @@ public:
     {
         return m_UseTCP;
     }
+    int BufferSize() const
+    {
+        return m_BufferSize;
+    }
 
 
 public slots:
@@ -77,11 +82,17 @@ public slots:
     {
         m_UseTCP = UseTCP;
     }
+    void setBufferSize(int BufferSize)
+    {
+        m_BufferSize = BufferSize;
+    }
 
 private:
     QString m_HostName;
     int m_Port;
     int m_UseTCP;
+    // socket send/receive buffer size in bytes, 0 keeps the OS default
+    int m_BufferSize;
     QSettings *settings;
 };
 
@@ -54,6 +54,7 @@ QWidget *IPconnectionOptionsPage::createPage(QWidget *parent)
     m_page->HostName->setText(m_config->HostName());
     m_page->UseTCP->setChecked(m_config->UseTCP() ? true : false);
     m_page->UseUDP->setChecked(m_config->UseTCP() ? false : true);
+    m_page->BufferSize->setValue(m_config->BufferSize());
 
     return w;
 }
@@ -63,6 +64,7 @@ void IPconnectionOptionsPage::apply()
     m_config->setPort(m_page->Port->value());
     m_config->setHostName(m_page->HostName->text());
     m_config->setUseTCP(m_page->UseTCP->isChecked() ? 1 : 0);
+    m_config->setBufferSize(m_page->BufferSize->value());
     m_config->savesettings();
 
     emit availableDevChanged();
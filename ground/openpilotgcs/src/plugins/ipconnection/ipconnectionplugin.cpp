@@ -42,6 +42,7 @@
 #include <QtNetwork/QUdpSocket>
 #include <QWaitCondition>
 #include <QMutex>
+#include <QTimer>
 #include <coreplugin/threadmanager.h>
 
 #include <QDebug>
@@ -54,8 +55,24 @@ QWaitCondition closeDeviceWait;
 QMutex ipConMutex;
 QAbstractSocket *ret;
 
-IPConnection::IPConnection(IPconnectionConnection *connection) : QObject()
+// Reconnect backoff, doubling from min to max on every failed attempt
+static const int RECONNECT_MIN_DELAY_MS = 500;
+static const int RECONNECT_MAX_DELAY_MS = 16000;
+
+IPConnection::IPConnection(IPconnectionConnection *connection) : QObject(),
+    m_connection(connection),
+    reconnectSocket(NULL),
+    port(0),
+    useTCP(true),
+    reconnectDelay(RECONNECT_MIN_DELAY_MS)
 {
+    // the timer must be a child before moveToThread so it is moved to the
+    // real-time thread along with us
+    reconnectTimer = new QTimer(this);
+    reconnectTimer->setSingleShot(true);
+    QObject::connect(reconnectTimer, SIGNAL(timeout()),
+                     this, SLOT(onReconnectTimer()));
+
     moveToThread(Core::ICore::instance()->threadManager()->getRealTimeThread());
 
     QObject::connect(connection, SIGNAL(CreateSocket(QString, int, bool)),
@@ -72,42 +89,107 @@ IPConnection::IPConnection(IPconnectionConnection *connection) : QObject()
 void IPConnection::onOpenDevice(QString HostName, int Port, bool UseTCP)
 {
     QAbstractSocket *ipSocket;
-    const int Timeout = 5 * 1000;
 
     ipConMutex.lock();
-    if (UseTCP) {
-        ipSocket = new QTcpSocket(this);
-    } else {
-        ipSocket = new QUdpSocket(this);
-    }
 
     // do sanity check on hostname and port...
     if ((HostName.length() == 0) || (Port < 1)) {
         errorMsg = "Please configure Host and Port options before opening the connection";
+        /* BUGBUG TODO - returning null here leads to segfault because some caller still calls disconnect without checking our return value properly
+         * someone needs to debug this, I got lost in the calling chain.*/
+        ret = NULL;
+        openDeviceWait.wakeAll();
+        ipConMutex.unlock();
+        return;
+    }
+
+    if (UseTCP) {
+        ipSocket = new QTcpSocket(this);
     } else {
-        // try to connect...
-        ipSocket->connectToHost(HostName, Port);
-
-        // in blocking mode so we wait for the connection to succeed
-        if (ipSocket->waitForConnected(Timeout)) {
-            ret = ipSocket;
-            openDeviceWait.wakeAll();
-            ipConMutex.unlock();
-            return;
-        }
-        // tell user something went wrong
-        errorMsg = ipSocket->errorString();
+        ipSocket = new QUdpSocket(this);
     }
-    /* BUGBUG TODO - returning null here leads to segfault because some caller still calls disconnect without checking our return value properly
-     * someone needs to debug this, I got lost in the calling chain.*/
-    ret = NULL;
+
+    // remember the target so the reconnect timer can retry on its own
+    reconnectSocket = ipSocket;
+    hostName = HostName;
+    port     = Port;
+    useTCP   = UseTCP;
+    reconnectDelay = RECONNECT_MIN_DELAY_MS;
+
+    QObject::connect(ipSocket, SIGNAL(connected()),
+                     this, SLOT(onSocketConnected()));
+    QObject::connect(ipSocket, SIGNAL(error(QAbstractSocket::SocketError)),
+                     this, SLOT(onSocketDown()));
+    QObject::connect(ipSocket, SIGNAL(disconnected()),
+                     this, SLOT(onSocketDown()));
+
+    // connect asynchronously: the socket is a usable QIODevice right away and
+    // telemetry starts flowing once connected() fires, so neither this thread
+    // nor the GUI blocks on DNS lookups or an unreachable host
+    ipSocket->connectToHost(HostName, Port);
+
+    ret = ipSocket;
     openDeviceWait.wakeAll();
     ipConMutex.unlock();
 }
 
+void IPConnection::onSocketConnected()
+{
+    QAbstractSocket *ipSocket = qobject_cast<QAbstractSocket *>(sender());
+
+    if (!ipSocket || (ipSocket != reconnectSocket)) {
+        return;
+    }
+    reconnectDelay = RECONNECT_MIN_DELAY_MS;
+    applySocketOptions(ipSocket);
+}
+
+void IPConnection::onSocketDown()
+{
+    // a deliberate close clears reconnectSocket first, so anything else
+    // is an error or a dropped link and we schedule a retry
+    if (!reconnectSocket || (sender() != reconnectSocket)) {
+        return;
+    }
+    if (reconnectTimer->isActive()) {
+        return;
+    }
+    reconnectTimer->start(reconnectDelay);
+    if (reconnectDelay < RECONNECT_MAX_DELAY_MS) {
+        reconnectDelay *= 2;
+    }
+}
+
+void IPConnection::onReconnectTimer()
+{
+    if (!reconnectSocket) {
+        return;
+    }
+    reconnectSocket->abort();
+    reconnectSocket->connectToHost(hostName, port);
+}
+
+void IPConnection::applySocketOptions(QAbstractSocket *ipSocket)
+{
+    int bufferSize = m_connection->Config()->BufferSize();
+
+    if (useTCP) {
+        // disable Nagle, telemetry frames are small and latency sensitive
+        ipSocket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    }
+    if (bufferSize > 0) {
+        ipSocket->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, bufferSize);
+        ipSocket->setSocketOption(QAbstractSocket::SendBufferSizeSocketOption, bufferSize);
+    }
+}
+
 void IPConnection::onCloseDevice(QAbstractSocket *ipSocket)
 {
     ipConMutex.lock();
+    if (ipSocket == reconnectSocket) {
+        reconnectTimer->stop();
+        reconnectSocket = NULL;
+    }
     ipSocket->close();
     delete (ipSocket);
     closeDeviceWait.wakeAll();
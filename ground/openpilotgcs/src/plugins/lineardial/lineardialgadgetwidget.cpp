@@ -27,6 +27,7 @@
 
 #include "lineardialgadgetwidget.h"
 #include <utils/stylehelper.h>
+#include <utils/cachedsvgitem.h>
 #include <QFileDialog>
 #include <QtOpenGL/QGLWidget>
 #include <QDebug>
@@ -43,6 +44,8 @@ LineardialGadgetWidget::LineardialGadgetWidget(QWidget *parent) : QGraphicsView(
     paint();
 
     obj1 = NULL;
+    fieldPtr1     = NULL;
+    fieldElement1 = 0;
     fieldName   = NULL;
     fieldValue  = NULL;
     indexTarget = 0;
@@ -80,6 +83,7 @@ void LineardialGadgetWidget::connectInput(QString object1, QString nfield1)
     if (obj1 != NULL) {
         disconnect(obj1, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(updateIndex(UAVObject *)));
     }
+    fieldPtr1 = NULL;
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
 
@@ -99,6 +103,12 @@ void LineardialGadgetWidget::connectInput(QString object1, QString nfield1)
                 field1 = nfield1;
                 haveSubField1 = false;
             }
+            // Resolve the field and element once, updateIndex() reuses them
+            fieldPtr1     = obj1->getField(field1);
+            fieldElement1 = 0;
+            if (fieldPtr1 && haveSubField1) {
+                fieldElement1 = fieldPtr1->getElementNames().indexOf(QRegExp(subfield1, Qt::CaseSensitive, QRegExp::FixedString));
+            }
             if (fieldName) {
                 fieldName->setPlainText(nfield1);
             }
@@ -116,19 +126,14 @@ void LineardialGadgetWidget::connectInput(QString object1, QString nfield1)
  */
 void LineardialGadgetWidget::updateIndex(UAVObject *object1)
 {
-    // Double check that the field exists:
-    UAVObjectField *field = object1->getField(field1);
+    Q_UNUSED(object1);
+    // The field and element were resolved at connect time, no name lookups here
+    UAVObjectField *field = (fieldElement1 >= 0) ? fieldPtr1 : NULL;
 
     if (field) {
         QString s;
         if (field->isNumeric()) {
-            double v;
-            if (haveSubField1) {
-                int indexOfSubField = field->getElementNames().indexOf(QRegExp(subfield1, Qt::CaseSensitive, QRegExp::FixedString));
-                v = field->getDouble(indexOfSubField) * factor;
-            } else {
-                v = field->getDouble() * factor;
-            }
+            double v = field->getDouble(fieldElement1) * factor;
             setIndex(v);
             s.sprintf("%.*f", places, v);
         }
@@ -171,7 +176,9 @@ void LineardialGadgetWidget::setDialFile(QString dfn)
     if (QFile::exists(dfn) && m_renderer->load(dfn) && m_renderer->isValid()) {
         l_scene->clear(); // Beware: clear also deletes all objects
                           // which are currently in the scene
-        background = new QGraphicsSvgItem();
+        // CachedSvgItem keeps each layer as a GL texture on OpenGL viewports,
+        // so moving the index does not re-render the SVG layers.
+        background = new CachedSvgItem();
         background->setSharedRenderer(m_renderer);
         background->setElementId("background");
         background->setFlags(QGraphicsItem::ItemClipsChildrenToShape |
@@ -183,15 +190,15 @@ void LineardialGadgetWidget::setDialFile(QString dfn)
         if (m_renderer->elementExists("red")) {
             // Order is important: red, then yellow then green
             // overlayed on top of each other
-            red = new QGraphicsSvgItem();
+            red = new CachedSvgItem();
             red->setSharedRenderer(m_renderer);
             red->setElementId("red");
             red->setParentItem(background);
-            yellow = new QGraphicsSvgItem();
+            yellow = new CachedSvgItem();
             yellow->setSharedRenderer(m_renderer);
             yellow->setElementId("yellow");
             yellow->setParentItem(background);
-            green = new QGraphicsSvgItem();
+            green = new CachedSvgItem();
             green->setSharedRenderer(m_renderer);
             green->setElementId("green");
             green->setParentItem(background);
@@ -268,7 +275,7 @@ void LineardialGadgetWidget::setDialFile(QString dfn)
             startY = nRect.y();
             QTransform matrix;
             matrix.translate(startX, startY);
-            index  = new QGraphicsSvgItem();
+            index  = new CachedSvgItem();
             index->setSharedRenderer(m_renderer);
             index->setElementId("needle");
             index->setTransform(matrix, false);
@@ -321,7 +328,7 @@ void LineardialGadgetWidget::setDialFile(QString dfn)
             qreal startY = textMatrix.mapRect(m_renderer->boundsOnElement("symbol")).y();
             QTransform matrix;
             matrix.translate(startX, startY);
-            fieldSymbol = new QGraphicsSvgItem();
+            fieldSymbol = new CachedSvgItem();
             fieldSymbol->setElementId("symbol");
             fieldSymbol->setSharedRenderer(m_renderer);
             fieldSymbol->setTransform(matrix, false);
@@ -331,7 +338,7 @@ void LineardialGadgetWidget::setDialFile(QString dfn)
         }
 
         if (m_renderer->elementExists("foreground")) {
-            foreground = new QGraphicsSvgItem();
+            foreground = new CachedSvgItem();
             foreground->setSharedRenderer(m_renderer);
             foreground->setElementId("foreground");
             foreground->setParentItem(background);
@@ -351,7 +358,7 @@ void LineardialGadgetWidget::setDialFile(QString dfn)
         qDebug() << "no file ";
         m_renderer->load(QString(":/lineardial/images/empty.svg"));
         l_scene->clear(); // This also deletes all items contained in the scene.
-        background  = new QGraphicsSvgItem();
+        background  = new CachedSvgItem();
         background->setSharedRenderer(m_renderer);
         l_scene->addItem(background);
         fieldName   = NULL;
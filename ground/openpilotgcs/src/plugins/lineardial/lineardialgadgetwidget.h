@@ -135,6 +135,10 @@ private:
     UAVDataObject *obj1;
     QString field1;
     QString subfield1;
+    // Field and element resolved once at connect time so updateIndex()
+    // doesn't do a name lookup on every telemetry update
+    UAVObjectField *fieldPtr1;
+    int fieldElement1;
     bool haveSubField1;
 };
 #endif /* LINEARDIALGADGETWIDGET_H_ */
@@ -0,0 +1,18 @@
+TEMPLATE = lib
+TARGET = LinkStatsGadget
+
+include(../../openpilotgcsplugin.pri)
+include(../../plugins/coreplugin/coreplugin.pri)
+include(../../plugins/uavobjects/uavobjects.pri)
+include(../../plugins/uavtalk/uavtalk.pri)
+
+HEADERS += linkstatsplugin.h
+HEADERS += linkstatsgadget.h
+HEADERS += linkstatsgadgetwidget.h
+HEADERS += linkstatsgadgetfactory.h
+SOURCES += linkstatsplugin.cpp
+SOURCES += linkstatsgadget.cpp
+SOURCES += linkstatsgadgetfactory.cpp
+SOURCES += linkstatsgadgetwidget.cpp
+
+OTHER_FILES += LinkStatsGadget.pluginspec
@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ *
+ * @file       linkstatsgadget.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup LinkStatsGadgetPlugin Link Statistics Gadget Plugin
+ * @{
+ * @brief Telemetry link instrumentation gadget
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef LINKSTATSGADGET_H_
+#define LINKSTATSGADGET_H_
+
+#include <coreplugin/iuavgadget.h>
+
+namespace Core {
+class IUAVGadget;
+}
+class LinkStatsGadgetWidget;
+
+using namespace Core;
+
+class LinkStatsGadget : public Core::IUAVGadget {
+    Q_OBJECT
+public:
+    LinkStatsGadget(QString classId, LinkStatsGadgetWidget *widget, QWidget *parent = 0);
+    ~LinkStatsGadget();
+
+    QWidget *widget()
+    {
+        return (QWidget *)m_widget;
+    }
+
+private:
+    LinkStatsGadgetWidget *m_widget;
+};
+
+
+#endif // LINKSTATSGADGET_H_
@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ *
+ * @file       linkstatsgadgetfactory.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup LinkStatsGadgetPlugin Link Statistics Gadget Plugin
+ * @{
+ * @brief Telemetry link instrumentation gadget
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "linkstatsgadgetfactory.h"
+#include "linkstatsgadgetwidget.h"
+#include "linkstatsgadget.h"
+#include <coreplugin/iuavgadget.h>
+
+LinkStatsGadgetFactory::LinkStatsGadgetFactory(QObject *parent) :
+    IUAVGadgetFactory(QString("LinkStatsGadget"),
+                      tr("Link Statistics"),
+                      parent)
+{}
+
+LinkStatsGadgetFactory::~LinkStatsGadgetFactory()
+{}
+
+IUAVGadget *LinkStatsGadgetFactory::createGadget(QWidget *parent)
+{
+    LinkStatsGadgetWidget *gadgetWidget = new LinkStatsGadgetWidget(parent);
+
+    return new LinkStatsGadget(QString("LinkStatsGadget"), gadgetWidget, parent);
+}
@@ -0,0 +1,211 @@
+/**
+ ******************************************************************************
+ *
+ * @file       linkstatsgadgetwidget.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup LinkStatsGadgetPlugin Link Statistics Gadget Plugin
+ * @{
+ * @brief Telemetry link instrumentation gadget
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "linkstatsgadgetwidget.h"
+
+#include "uavtalk/telemetrymanager.h"
+#include "uavtalk/telemetry.h"
+#include "extensionsystem/pluginmanager.h"
+#include "uavobjectmanager.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+
+LinkStatsGadgetWidget::LinkStatsGadgetWidget(QWidget *parent) : QWidget(parent),
+    m_haveLastStats(false)
+{
+    QVBoxLayout *layout = new QVBoxLayout(this);
+
+    layout->setContentsMargins(4, 4, 4, 4);
+
+    QHBoxLayout *topLayout = new QHBoxLayout();
+    m_linkLabel    = new QLabel(this);
+    m_latencyLabel = new QLabel(this);
+    m_linkLabel->setTextFormat(Qt::PlainText);
+    m_latencyLabel->setTextFormat(Qt::PlainText);
+    m_latencyLabel->setAlignment(Qt::AlignTop | Qt::AlignLeft);
+    topLayout->addWidget(m_linkLabel, 1);
+    topLayout->addWidget(m_latencyLabel, 1);
+    layout->addLayout(topLayout);
+
+    m_objectTree = new QTreeWidget(this);
+    m_objectTree->setColumnCount(7);
+    m_objectTree->setHeaderLabels(QStringList()
+                                  << tr("Object") << tr("Rx") << tr("Rx bytes") << tr("Rx B/s")
+                                  << tr("Tx") << tr("Tx bytes") << tr("Tx B/s"));
+    m_objectTree->setRootIsDecorated(false);
+    m_objectTree->setSortingEnabled(true);
+    m_objectTree->sortByColumn(3, Qt::DescendingOrder);
+    m_objectTree->header()->setStretchLastSection(false);
+    m_objectTree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    layout->addWidget(m_objectTree, 1);
+
+    m_resetButton = new QPushButton(tr("Reset counters"), this);
+    connect(m_resetButton, SIGNAL(clicked()), this, SLOT(resetStats()));
+    layout->addWidget(m_resetButton, 0, Qt::AlignRight);
+
+    connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(updateStats()));
+    m_updateTimer.start(UPDATE_PERIOD_MS);
+    updateStats();
+}
+
+LinkStatsGadgetWidget::~LinkStatsGadgetWidget()
+{}
+
+TelemetryConnection *LinkStatsGadgetWidget::activeConnection() const
+{
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    TelemetryManager *telMngr = pm->getObject<TelemetryManager>();
+
+    if (!telMngr) {
+        return NULL;
+    }
+    return telMngr->primaryConnection();
+}
+
+void LinkStatsGadgetWidget::updateStats()
+{
+    TelemetryConnection *connection = activeConnection();
+
+    if (!connection) {
+        m_linkLabel->setText(tr("No telemetry link"));
+        m_latencyLabel->clear();
+        m_haveLastStats = false;
+        return;
+    }
+
+    UAVTalk::ComStats stats = connection->uavTalk()->getStats();
+    QMap<quint32, UAVTalk::ObjectComStats> objectStats = connection->uavTalk()->getObjectStats();
+
+    // Counters went backwards: the link was swapped or the stats were
+    // reset, restart the rate history
+    if (m_haveLastStats && ((stats.rxBytes < m_lastStats.rxBytes) || (stats.txBytes < m_lastStats.txBytes))) {
+        m_haveLastStats = false;
+        m_rxRateHistory.clear();
+        m_txRateHistory.clear();
+        m_lastObjectStats.clear();
+    }
+
+    if (m_haveLastStats) {
+        m_rxRateHistory.append((stats.rxBytes - m_lastStats.rxBytes) * 1000.0 / UPDATE_PERIOD_MS);
+        m_txRateHistory.append((stats.txBytes - m_lastStats.txBytes) * 1000.0 / UPDATE_PERIOD_MS);
+        while (m_rxRateHistory.size() > RATE_HISTORY_SIZE) {
+            m_rxRateHistory.removeFirst();
+            m_txRateHistory.removeFirst();
+        }
+    }
+
+    m_linkLabel->setText(tr("Rx: %1 bytes, %2 objects, %3 errors (%4 sync, %5 crc)\n"
+                            "Tx: %6 bytes, %7 objects, %8 errors\n"
+                            "Rx rate: %9\nTx rate: %10")
+                         .arg(stats.rxBytes).arg(stats.rxObjects)
+                         .arg(stats.rxErrors).arg(stats.rxSyncErrors).arg(stats.rxCrcErrors)
+                         .arg(stats.txBytes).arg(stats.txObjects).arg(stats.txErrors)
+                         .arg(formatRates(m_rxRateHistory))
+                         .arg(formatRates(m_txRateHistory)));
+
+    // Transaction latency histogram
+    QVector<quint32> histogram = connection->telemetry()->getTransactionLatencyHistogram();
+    QString latencyText = tr("Transaction latency:");
+    for (int i = 0; i < histogram.size(); i++) {
+        int bound = Telemetry::latencyBucketBoundMs(i);
+        if (bound > 0) {
+            latencyText.append(QString("\n< %1 ms: %2").arg(bound).arg(histogram.at(i)));
+        } else {
+            latencyText.append(QString("\n>= %1 ms: %2")
+                               .arg(Telemetry::latencyBucketBoundMs(i - 1)).arg(histogram.at(i)));
+        }
+    }
+    m_latencyLabel->setText(latencyText);
+
+    // Per object type breakdown
+    UAVObjectManager *objMngr = connection->objectManager();
+    m_objectTree->setSortingEnabled(false);
+    foreach(quint32 objId, objectStats.keys()) {
+        const UAVTalk::ObjectComStats &objStats = objectStats.value(objId);
+
+        QTreeWidgetItem *item = m_objectItems.value(objId, NULL);
+        if (!item) {
+            UAVObject *obj = objMngr->getObject(objId);
+            item = new QTreeWidgetItem(m_objectTree);
+            item->setText(0, obj ? obj->getName() : QString("0x%1").arg(objId, 8, 16, QChar('0')));
+            m_objectItems.insert(objId, item);
+        }
+        UAVTalk::ObjectComStats lastStats = m_lastObjectStats.value(objId, UAVTalk::ObjectComStats());
+        double rxRate = m_haveLastStats ? (objStats.rxBytes - lastStats.rxBytes) * 1000.0 / UPDATE_PERIOD_MS : 0.0;
+        double txRate = m_haveLastStats ? (objStats.txBytes - lastStats.txBytes) * 1000.0 / UPDATE_PERIOD_MS : 0.0;
+        item->setData(1, Qt::DisplayRole, objStats.rxObjects);
+        item->setData(2, Qt::DisplayRole, objStats.rxBytes);
+        item->setData(3, Qt::DisplayRole, rxRate);
+        item->setData(4, Qt::DisplayRole, objStats.txObjects);
+        item->setData(5, Qt::DisplayRole, objStats.txBytes);
+        item->setData(6, Qt::DisplayRole, txRate);
+    }
+    m_objectTree->setSortingEnabled(true);
+
+    m_lastStats       = stats;
+    m_lastObjectStats = objectStats;
+    m_haveLastStats   = true;
+}
+
+void LinkStatsGadgetWidget::resetStats()
+{
+    TelemetryConnection *connection = activeConnection();
+
+    if (connection) {
+        connection->telemetry()->resetStats();
+    }
+    m_haveLastStats = false;
+    m_rxRateHistory.clear();
+    m_txRateHistory.clear();
+    m_lastObjectStats.clear();
+    qDeleteAll(m_objectItems);
+    m_objectItems.clear();
+    updateStats();
+}
+
+/**
+ * Format the current, average and peak byte rate over the ring buffered
+ * history window
+ */
+QString LinkStatsGadgetWidget::formatRates(const QVector<double> &history) const
+{
+    if (history.isEmpty()) {
+        return tr("n/a");
+    }
+    double sum = 0.0;
+    double max = 0.0;
+    for (int i = 0; i < history.size(); i++) {
+        sum += history.at(i);
+        max  = qMax(max, history.at(i));
+    }
+    return tr("%1 B/s (avg %2, peak %3 over %4 s)")
+           .arg(history.last(), 0, 'f', 0)
+           .arg(sum / history.size(), 0, 'f', 0)
+           .arg(max, 0, 'f', 0)
+           .arg(history.size() * UPDATE_PERIOD_MS / 1000);
+}
@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ *
+ * @file       linkstatsgadgetwidget.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup LinkStatsGadgetPlugin Link Statistics Gadget Plugin
+ * @{
+ * @brief Telemetry link instrumentation gadget
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef LINKSTATSGADGETWIDGET_H_
+#define LINKSTATSGADGETWIDGET_H_
+
+#include "uavtalk/uavtalk.h"
+
+#include <QWidget>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QPushButton>
+#include <QTimer>
+#include <QHash>
+#include <QVector>
+
+class TelemetryConnection;
+
+/*!
+   \brief Shows the full instrumentation of the primary telemetry link.
+
+   Polls the UAVTalk and Telemetry counters once per second: link totals with
+   a ring buffered rate history, the CRC error and resync counters, the
+   transaction latency histogram and a per object type traffic breakdown,
+   which is where the link budget discussion starts.
+ */
+class LinkStatsGadgetWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    LinkStatsGadgetWidget(QWidget *parent = 0);
+    ~LinkStatsGadgetWidget();
+
+private slots:
+    void updateStats();
+    void resetStats();
+
+private:
+    // Samples kept in the rate history ring, one per update tick
+    static const int RATE_HISTORY_SIZE = 60;
+    static const int UPDATE_PERIOD_MS  = 1000;
+
+    TelemetryConnection *activeConnection() const;
+    QString formatRates(const QVector<double> &history) const;
+
+    QLabel *m_linkLabel;
+    QLabel *m_latencyLabel;
+    QTreeWidget *m_objectTree;
+    QPushButton *m_resetButton;
+    QTimer m_updateTimer;
+
+    // Previous counter snapshot, for the per tick rate deltas
+    bool m_haveLastStats;
+    UAVTalk::ComStats m_lastStats;
+    QMap<quint32, UAVTalk::ObjectComStats> m_lastObjectStats;
+
+    // Ring buffered byte rate history, newest last
+    QVector<double> m_rxRateHistory;
+    QVector<double> m_txRateHistory;
+
+    QHash<quint32, QTreeWidgetItem *> m_objectItems;
+};
+
+#endif // LINKSTATSGADGETWIDGET_H_
@@ -0,0 +1,157 @@
+/**
+ ******************************************************************************
+ * @file       headlessrecorder.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup   Logging
+ * @{
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "headlessrecorder.h"
+#include "loggingplugin.h"
+
+#include <coreplugin/icore.h>
+#include <coreplugin/connectionmanager.h>
+#include <extensionsystem/pluginmanager.h>
+#include "uavobjectmanager.h"
+#include "gcstelemetrystats.h"
+
+#include <QTextStream>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+// How often to look for the requested device while disconnected
+#define CONNECT_RETRY_MS  1000
+// How often to print a status line to stdout
+#define STATUS_PERIOD_MS  10000
+
+HeadlessRecorder::HeadlessRecorder(LoggingPlugin *plugin, QString deviceName, QString fileName, QObject *parent) :
+    QObject(parent),
+    plugin(plugin),
+    deviceName(deviceName),
+    fileName(fileName),
+    sessions(0)
+{}
+
+void HeadlessRecorder::start()
+{
+    Core::ConnectionManager *cm = Core::ICore::instance()->connectionManager();
+
+    connect(cm, SIGNAL(deviceConnected(QIODevice *)), this, SLOT(onDeviceConnected()));
+    connect(cm, SIGNAL(deviceDisconnected()), this, SLOT(onDeviceDisconnected()));
+
+    connect(&connectTimer, SIGNAL(timeout()), this, SLOT(tryConnect()));
+    connect(&statusTimer, SIGNAL(timeout()), this, SLOT(printStatus()));
+
+    upTime.start();
+    connectTimer.start(CONNECT_RETRY_MS);
+    statusTimer.start(STATUS_PERIOD_MS);
+
+    qDebug() << "HeadlessRecorder: waiting for device" << deviceName;
+}
+
+/**
+ * Poll the available device list until the requested device shows up,
+ * then connect it.  Runs while disconnected only.
+ */
+void HeadlessRecorder::tryConnect()
+{
+    Core::ConnectionManager *cm = Core::ICore::instance()->connectionManager();
+
+    if (cm->isConnected()) {
+        return;
+    }
+    Core::DevListItem device = cm->findDevice(deviceName);
+    if (device.connection) {
+        cm->connectDevice(device);
+    }
+}
+
+void HeadlessRecorder::onDeviceConnected()
+{
+    connectTimer.stop();
+    currentFile = sessionFileName();
+    sessions++;
+    plugin->startLogging(currentFile);
+    qDebug() << "HeadlessRecorder: recording to" << currentFile;
+}
+
+void HeadlessRecorder::onDeviceDisconnected()
+{
+    plugin->stopLogging();
+    // Resume waiting, the next connect starts a new logfile
+    connectTimer.start(CONNECT_RETRY_MS);
+    qDebug() << "HeadlessRecorder: device lost, waiting for" << deviceName;
+}
+
+/**
+ * First session records straight to the requested file, reconnects get
+ * a numbered suffix so earlier recordings are kept.
+ */
+QString HeadlessRecorder::sessionFileName() const
+{
+    if (sessions == 0) {
+        return fileName;
+    }
+    QFileInfo fi(fileName);
+    QString name = fi.path() + QDir::separator() + fi.completeBaseName() + QString("-%1").arg(sessions);
+    if (!fi.suffix().isEmpty()) {
+        name += "." + fi.suffix();
+    }
+    return name;
+}
+
+/**
+ * One line of status to stdout, cheap enough for a serial console or
+ * a log kept on the field box.
+ */
+void HeadlessRecorder::printStatus()
+{
+    Core::ConnectionManager *cm = Core::ICore::instance()->connectionManager();
+
+    qint64 secs = upTime.elapsed() / 1000;
+    QString elapsed = QString("%1:%2:%3")
+                      .arg(secs / 3600)
+                      .arg((secs / 60) % 60, 2, 10, QChar('0'))
+                      .arg(secs % 60, 2, 10, QChar('0'));
+
+    QTextStream out(stdout);
+    out << elapsed;
+
+    if (!cm->isConnected()) {
+        out << " waiting for " << deviceName << endl;
+        return;
+    }
+
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+    GCSTelemetryStats::DataFields gcsStats = GCSTelemetryStats::GetInstance(objManager)->getData();
+
+    out << (gcsStats.Status == GCSTelemetryStats::STATUS_CONNECTED ? " telemetry up" : " telemetry down")
+        << " rx " << (int)gcsStats.RxDataRate << " bytes/sec"
+        << " log " << QFileInfo(currentFile).size() / 1024 << " KB"
+        << endl;
+}
+
+/**
+ * @}
+ * @}
+ */
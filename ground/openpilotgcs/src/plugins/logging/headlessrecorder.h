@@ -0,0 +1,77 @@
+/**
+ ******************************************************************************
+ * @file       headlessrecorder.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2012.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup   Logging
+ * @{
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef HEADLESSRECORDER_H
+#define HEADLESSRECORDER_H
+
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class LoggingPlugin;
+
+/**
+ * Drives an unattended recording session when GCS is started with
+ * -headless: waits for the requested device to appear, connects it,
+ * starts logging and prints a periodic status line to stdout.
+ *
+ * When the device goes away the recorder stops logging and resumes
+ * waiting; each reconnect starts a new numbered logfile so no session
+ * overwrites the previous one.
+ */
+class HeadlessRecorder : public QObject {
+    Q_OBJECT
+
+public:
+    HeadlessRecorder(LoggingPlugin *plugin, QString deviceName, QString fileName, QObject *parent = 0);
+
+    void start();
+
+private slots:
+    void tryConnect();
+    void onDeviceConnected();
+    void onDeviceDisconnected();
+    void printStatus();
+
+private:
+    QString sessionFileName() const;
+
+    LoggingPlugin *plugin;
+    QString deviceName;
+    QString fileName;
+    QString currentFile;
+    int sessions;
+    QTimer connectTimer;
+    QTimer statusTimer;
+    QElapsedTimer upTime;
+};
+
+#endif // HEADLESSRECORDER_H
+/**
+ * @}
+ * @}
+ */
@@ -0,0 +1,410 @@
+/**
+ ******************************************************************************
+ * @file       logfilebulkparser.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2014.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup loggingplugin
+ * @{
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "logfilebulkparser.h"
+
+#include "uavobjectmanager.h"
+#include "uavobjectfield.h"
+#include <extensionsystem/pluginmanager.h>
+#include <utils/crc.h>
+
+#include <QFile>
+#include <QThread>
+#include <QtEndian>
+#include <QtConcurrentMap>
+#include <QDebug>
+
+#include <string.h>
+
+// UAVTalk framing, mirrored from uavtalk.cpp (the constants are private
+// to the state machine there, the wireshark dissector does the same)
+#define SYNC_VAL           0x3C
+#define TYPE_MASK          0xF8
+#define TYPE_VER           0x20
+#define TYPE_OBJ           (TYPE_VER | 0x00)
+#define TYPE_OBJ_ACK       (TYPE_VER | 0x02)
+#define TYPE_OBJ_DELTA     (TYPE_VER | 0x06)
+#define HEADER_LENGTH      10
+#define MAX_PAYLOAD_LENGTH 256
+
+// OPL framing, mirrored from logfile.cpp
+static const quint32 LOG_FILE_MAGIC   = 0x324C504F; // "OPL2"
+static const quint32 LOG_FILE_VERSION = 2;
+static const quint32 LOG_INDEX_MAGIC  = 0x58444E49; // "INDX"
+
+// timestamp + size prefix every logfile record carries
+static const qint64 RECORD_HEADER_LENGTH = sizeof(quint32) + sizeof(qint64);
+
+LogFileBulkParser::LogFileBulkParser(QObject *parent) :
+    QObject(parent),
+    m_packetCount(0),
+    m_crcErrors(0),
+    m_resyncCount(0)
+{}
+
+/**
+ * Cheap structural check of a packet header, used while scanning and
+ * resyncing.  The CRC is left to the workers so the expensive part of
+ * validation runs in parallel too.
+ */
+static bool packetPlausible(const uchar *data, qint64 avail)
+{
+    if (avail < HEADER_LENGTH + 1) {
+        return false;
+    }
+    if (data[0] != SYNC_VAL || ((data[1] & TYPE_MASK) != TYPE_VER)) {
+        return false;
+    }
+    qint32 packetSize = qFromLittleEndian<quint16>(&data[2]);
+    if (packetSize < HEADER_LENGTH || packetSize > HEADER_LENGTH + MAX_PAYLOAD_LENGTH) {
+        return false;
+    }
+    // +1 for the CRC byte that follows the packet
+    return (packetSize + 1) <= avail;
+}
+
+/**
+ * True when a whole record starts at pos: plausible size prefix and a
+ * plausible packet right after it.
+ */
+static bool recordPlausible(const uchar *data, qint64 pos, qint64 logEnd)
+{
+    if (pos + RECORD_HEADER_LENGTH >= logEnd) {
+        return false;
+    }
+    qint64 recordSize = qFromLittleEndian<qint64>(&data[pos + 4]);
+    return recordSize > 0
+           && recordSize <= HEADER_LENGTH + MAX_PAYLOAD_LENGTH + 1
+           && pos + RECORD_HEADER_LENGTH + recordSize <= logEnd
+           && packetPlausible(&data[pos + RECORD_HEADER_LENGTH], recordSize);
+}
+
+QList<LogFileColumn> LogFileBulkParser::parse(const QString &fileName, QString *errorString)
+{
+    m_packetCount = 0;
+    m_crcErrors   = 0;
+    m_resyncCount = 0;
+
+    QList<LogFileColumn> columns;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString) {
+            *errorString = tr("Unable to open %1").arg(fileName);
+        }
+        return columns;
+    }
+
+    // Map the whole file so the scan and the workers read straight from
+    // the page cache, falling back to an in-memory copy when mapping is
+    // not available (e.g. network filesystems)
+    QByteArray fallback;
+    const uchar *data = file.map(0, file.size());
+    if (data == NULL) {
+        fallback = file.readAll();
+        data     = (const uchar *)fallback.constData();
+    }
+    qint64 size = file.size();
+
+    QList<qint64> syncOffsets;
+    qint64 logEnd     = size;
+    qint64 dataOffset = findDataRange(data, size, syncOffsets, logEnd);
+
+    QVector<PacketRef> packets = scanPackets(data, dataOffset, logEnd);
+    if (packets.isEmpty()) {
+        if (errorString) {
+            *errorString = tr("No UAVTalk packets found in %1").arg(fileName);
+        }
+        return columns;
+    }
+
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objMngr = pm->getObject<UAVObjectManager>();
+
+    // Cut the packet list at sync point offsets.  Every sync point starts
+    // with a full object snapshot, so each chunk decodes without state
+    // from its predecessor and delta frames stay self contained.  Aim for
+    // a few chunks per core, small logs stay in one chunk.
+    int minChunkSize = packets.size() / (QThread::idealThreadCount() * 4) + 1;
+    QList<Chunk> chunks;
+    int nextSync     = 0;
+    foreach(const PacketRef &packet, packets) {
+        qint64 offset    = packet.data - data;
+        bool atSyncPoint = false;
+
+        while (nextSync < syncOffsets.size() && offset >= syncOffsets.at(nextSync) + RECORD_HEADER_LENGTH) {
+            atSyncPoint = true;
+            nextSync++;
+        }
+        if (chunks.isEmpty() || (atSyncPoint && chunks.last().packets.size() >= minChunkSize)) {
+            chunks.append(Chunk());
+        }
+        chunks.last().packets.append(packet);
+    }
+
+    // Give each chunk private clones of the objects it will see, built
+    // here on the calling thread so workers never touch the registry
+    for (int i = 0; i < chunks.size(); i++) {
+        Chunk & chunk = chunks[i];
+        foreach(const PacketRef &packet, chunk.packets) {
+            quint32 objId  = qFromLittleEndian<quint32>(&packet.data[4]);
+            quint16 instId = qFromLittleEndian<quint16>(&packet.data[8]);
+            quint64 key    = ((quint64)objId << 16) | instId;
+            if (chunk.clones.contains(key)) {
+                continue;
+            }
+            UAVDataObject *prototype = qobject_cast<UAVDataObject *>(objMngr->getObject(objId));
+            if (prototype) {
+                chunk.clones.insert(key, prototype->clone(instId));
+            }
+        }
+    }
+
+    QList<ChunkResult> results = QtConcurrent::blockingMapped(chunks, &LogFileBulkParser::parseChunk);
+
+    // Merge in chunk order, the packet scan was sequential so appending
+    // keeps every column sorted by time
+    QMap<QString, LogFileColumn> merged;
+    foreach(const ChunkResult &result, results) {
+        m_packetCount += result.packets;
+        m_crcErrors   += result.crcErrors;
+        QMap<QString, LogFileColumn>::const_iterator it;
+        for (it = result.columns.constBegin(); it != result.columns.constEnd(); ++it) {
+            if (!merged.contains(it.key())) {
+                merged.insert(it.key(), it.value());
+            } else {
+                LogFileColumn & column = merged[it.key()];
+                column.timestamps += it.value().timestamps;
+                column.values     += it.value().values;
+            }
+        }
+    }
+
+    foreach(const Chunk &chunk, chunks) {
+        qDeleteAll(chunk.clones);
+    }
+
+    qDebug() << "LogFileBulkParser: parsed" << m_packetCount << "packets into"
+             << merged.size() << "columns," << chunks.size() << "chunks,"
+             << m_crcErrors << "CRC errors," << m_resyncCount << "resyncs";
+
+    return merged.values();
+}
+
+/**
+ * Detects the OPL v2 header and footer index, mirroring
+ * LogFile::readHeaderAndIndex() on the mapped buffer.  Returns the
+ * offset of the first record and fills in the sync point offsets and
+ * the end of the record area.  v1 files yield offset 0 and no sync
+ * points.
+ */
+qint64 LogFileBulkParser::findDataRange(const uchar *data, qint64 size, QList<qint64> &syncOffsets, qint64 &logEnd)
+{
+    logEnd = size;
+    if (size < (qint64)(2 * sizeof(quint32))) {
+        return 0;
+    }
+    if (qFromLittleEndian<quint32>(&data[0]) != LOG_FILE_MAGIC
+        || qFromLittleEndian<quint32>(&data[4]) != LOG_FILE_VERSION) {
+        return 0;
+    }
+    qint64 dataOffset  = 2 * sizeof(quint32);
+
+    // trailer: index offset, entry count, index magic
+    qint64 trailerSize = sizeof(qint64) + 2 * sizeof(quint32);
+    if (size < dataOffset + trailerSize) {
+        return dataOffset;
+    }
+    const uchar *trailer = data + size - trailerSize;
+    qint64 indexOffset   = qFromLittleEndian<qint64>(&trailer[0]);
+    quint32 count        = qFromLittleEndian<quint32>(&trailer[8]);
+    quint32 indexMagic   = qFromLittleEndian<quint32>(&trailer[12]);
+
+    qint64 entrySize     = sizeof(quint32) + sizeof(qint64);
+    if (indexMagic != LOG_INDEX_MAGIC
+        || indexOffset < dataOffset
+        || indexOffset + count * entrySize + trailerSize != size) {
+        return dataOffset;
+    }
+
+    for (quint32 i = 0; i < count; i++) {
+        const uchar *entry = data + indexOffset + i * entrySize;
+        syncOffsets.append(qFromLittleEndian<qint64>(&entry[4]));
+    }
+    logEnd = indexOffset;
+    return dataOffset;
+}
+
+/**
+ * Sequential scan of the record area.  Record framing makes this a
+ * pointer walk, packets are only checked structurally here.  After a
+ * corrupt record the scan hunts for the next sync byte with memchr
+ * (vectorized by every libc we build against) and backs up over the
+ * record header to relock on the record framing.
+ */
+QVector<LogFileBulkParser::PacketRef> LogFileBulkParser::scanPackets(const uchar *data, qint64 dataOffset, qint64 logEnd)
+{
+    QVector<PacketRef> packets;
+    qint64 pos = dataOffset;
+
+    while (pos + RECORD_HEADER_LENGTH < logEnd) {
+        if (!recordPlausible(data, pos, logEnd)) {
+            // hunt for the next sync byte that starts a plausible packet
+            // preceded by a plausible record header
+            m_resyncCount++;
+            const uchar *next = &data[pos + RECORD_HEADER_LENGTH + 1];
+            while (true) {
+                next = (const uchar *)memchr(next, SYNC_VAL, logEnd - (next - data));
+                if (next == NULL) {
+                    return packets;
+                }
+                if ((next - data) > RECORD_HEADER_LENGTH
+                    && recordPlausible(data, (next - data) - RECORD_HEADER_LENGTH, logEnd)) {
+                    break;
+                }
+                next++;
+            }
+            pos = (next - data) - RECORD_HEADER_LENGTH;
+            continue;
+        }
+        quint32 timeStamp = qFromLittleEndian<quint32>(&data[pos]);
+        qint64 recordSize = qFromLittleEndian<qint64>(&data[pos + 4]);
+
+        // a record may hold several packets back to back
+        qint64 packetPos  = pos + RECORD_HEADER_LENGTH;
+        qint64 recordEnd  = packetPos + recordSize;
+        while (packetPlausible(&data[packetPos], recordEnd - packetPos)) {
+            PacketRef packet;
+            packet.timeStamp = timeStamp;
+            packet.data      = &data[packetPos];
+            packet.size      = qFromLittleEndian<quint16>(&data[packetPos + 2]) + 1;
+            packets.append(packet);
+            packetPos += packet.size;
+        }
+        pos = recordEnd;
+    }
+    return packets;
+}
+
+/**
+ * Decode one chunk: CRC check every packet, unpack it into the chunk's
+ * private clone and append every numeric field element to its column.
+ * Runs on a worker thread, touches nothing shared.
+ */
+LogFileBulkParser::ChunkResult LogFileBulkParser::parseChunk(const Chunk &chunk)
+{
+    ChunkResult result;
+
+    result.packets   = 0;
+    result.crcErrors = 0;
+
+    QByteArray deltaBuffer;
+
+    foreach(const PacketRef &packet, chunk.packets) {
+        quint8 type = packet.data[1];
+        if (type != TYPE_OBJ && type != TYPE_OBJ_ACK && type != TYPE_OBJ_DELTA) {
+            continue;
+        }
+        if (Crc::updateCRC(0, packet.data, packet.size - 1) != packet.data[packet.size - 1]) {
+            result.crcErrors++;
+            continue;
+        }
+
+        quint32 objId  = qFromLittleEndian<quint32>(&packet.data[4]);
+        quint16 instId = qFromLittleEndian<quint16>(&packet.data[8]);
+        UAVDataObject *obj = chunk.clones.value(((quint64)objId << 16) | instId);
+        if (obj == NULL) {
+            // not a registered object (e.g. newer firmware), skip it
+            continue;
+        }
+
+        const uchar *payload = packet.data + HEADER_LENGTH;
+        qint32 length = packet.size - HEADER_LENGTH - 1;
+
+        if (type == TYPE_OBJ_DELTA) {
+            // apply the change records on top of the clone's current
+            // data, same format as UAVTalk::applyObjectDelta()
+            qint32 numBytes = obj->getNumBytes();
+            deltaBuffer.resize(numBytes);
+            obj->pack((quint8 *)deltaBuffer.data());
+            qint32 pos     = 0;
+            bool malformed = false;
+            while (pos < length) {
+                if ((length - pos) < 3) {
+                    malformed = true;
+                    break;
+                }
+                quint16 offset   = qFromLittleEndian<quint16>(&payload[pos]);
+                quint8 runLength = payload[pos + 2];
+                pos += 3;
+                if ((runLength == 0) || ((offset + runLength) > numBytes) || ((pos + runLength) > length)) {
+                    malformed = true;
+                    break;
+                }
+                memcpy(deltaBuffer.data() + offset, &payload[pos], runLength);
+                pos += runLength;
+            }
+            if (malformed) {
+                result.crcErrors++;
+                continue;
+            }
+            obj->unpack((quint8 *)deltaBuffer.data());
+        } else {
+            if (length != (qint32)obj->getNumBytes()) {
+                continue;
+            }
+            obj->unpack(payload);
+        }
+        result.packets++;
+
+        foreach(UAVObjectField * field, obj->getFields()) {
+            if (!field->isNumeric()) {
+                continue;
+            }
+            for (quint32 element = 0; element < field->getNumElements(); element++) {
+                QString key = QString("%1:%2:%3:%4")
+                              .arg(obj->getName()).arg(instId).arg(field->getName()).arg(element);
+                QMap<QString, LogFileColumn>::iterator it = result.columns.find(key);
+                if (it == result.columns.end()) {
+                    LogFileColumn column;
+                    column.objectName  = obj->getName();
+                    column.objectId    = objId;
+                    column.instId      = instId;
+                    column.fieldName   = field->getName();
+                    column.elementName = field->getNumElements() > 1 ? field->getElementNames().at(element) : QString();
+                    it = result.columns.insert(key, column);
+                }
+                it.value().timestamps.append(packet.timeStamp);
+                it.value().values.append(field->getValue(element).toDouble());
+            }
+        }
+    }
+    return result;
+}
+/**
+ * @}
+ * @}
+ */
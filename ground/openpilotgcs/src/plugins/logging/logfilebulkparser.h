@@ -0,0 +1,133 @@
+/**
+ ******************************************************************************
+ * @file       logfilebulkparser.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2014.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup loggingplugin
+ * @{
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef LOGFILEBULKPARSER_H
+#define LOGFILEBULKPARSER_H
+
+#include "uavdataobject.h"
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QMap>
+#include <QHash>
+
+/**
+ * One column produced by the bulk parser: every value one numeric field
+ * element took over the course of the log, together with the logfile
+ * timestamp (ms) each value arrived with.  Column oriented so the scope
+ * and offline analysis can plot a field without touching the rest of
+ * the stream.
+ */
+class LogFileColumn {
+public:
+    QString objectName;
+    quint32 objectId;
+    quint16 instId;
+    QString fieldName;
+    QString elementName;
+    QVector<quint32> timestamps;
+    QVector<double> values;
+};
+
+/**
+ * Bulk decoder for OPL logfiles.  Unlike replay, which feeds the file
+ * through the realtime UAVTalk state machine one byte at a time, this
+ * memory-maps the whole file, walks the record framing directly and
+ * unpacks the UAVTalk packets across worker threads into columnar
+ * per-field arrays.
+ *
+ * OPL v2 files are split at their sync point index for the parallel
+ * phase.  Every sync point starts with a full snapshot of all objects,
+ * so each chunk is self contained and delta frames never depend on
+ * state decoded by another worker.  v1 files (no index) are parsed in
+ * a single chunk.
+ */
+class LogFileBulkParser : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LogFileBulkParser(QObject *parent = 0);
+
+    /**
+     * Parses the whole file and returns one column per numeric field
+     * element seen in the log.  Blocks until done, workers run on the
+     * global thread pool.
+     */
+    QList<LogFileColumn> parse(const QString &fileName, QString *errorString = 0);
+
+    quint32 packetCount() const
+    {
+        return m_packetCount;
+    }
+    quint32 crcErrors() const
+    {
+        return m_crcErrors;
+    }
+    quint32 resyncCount() const
+    {
+        return m_resyncCount;
+    }
+
+private:
+    // One UAVTalk packet (sync byte through CRC) and the timestamp of
+    // the logfile record it was found in.  Points into the mapped file.
+    struct PacketRef {
+        quint32 timeStamp;
+        const uchar *data;
+        qint32 size;
+    };
+
+    // A run of packets one worker decodes independently
+    struct Chunk {
+        QVector<PacketRef> packets;
+        // clones the worker unpacks into, keyed by objId << 16 | instId,
+        // created up front so workers never touch the shared registry
+        QHash<quint64, UAVDataObject *> clones;
+    };
+
+    // What one worker hands back, merged in chunk order afterwards
+    struct ChunkResult {
+        QMap<QString, LogFileColumn> columns;
+        quint32 packets;
+        quint32 crcErrors;
+    };
+
+    qint64 findDataRange(const uchar *data, qint64 size, QList<qint64> &syncOffsets, qint64 &logEnd);
+    QVector<PacketRef> scanPackets(const uchar *data, qint64 dataOffset, qint64 logEnd);
+    static ChunkResult parseChunk(const Chunk &chunk);
+
+    quint32 m_packetCount;
+    quint32 m_crcErrors;
+    quint32 m_resyncCount;
+};
+
+#endif // LOGFILEBULKPARSER_H
+/**
+ * @}
+ * @}
+ */
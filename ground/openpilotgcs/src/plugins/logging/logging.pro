@@ -2,16 +2,20 @@ TEMPLATE = lib
 
 TARGET = LoggingGadget
 DEFINES += LOGGING_LIBRARY
-QT += svg
+QT += svg concurrent
 
 include(../../openpilotgcsplugin.pri)
 include(logging_dependencies.pri)
 HEADERS += loggingplugin.h \
+    headlessrecorder.h \
+    logfilebulkparser.h \
     logginggadgetwidget.h \
     logginggadget.h \
     logginggadgetfactory.h
 
 SOURCES += loggingplugin.cpp \
+    headlessrecorder.cpp \
+    logfilebulkparser.cpp \
     logginggadgetwidget.cpp \
     logginggadget.cpp \
     logginggadgetfactory.cpp
@@ -58,14 +58,47 @@ void LoggingGadgetWidget::setPlugin(LoggingPlugin *p)
     connect(m_logging->pauseButton, SIGNAL(clicked()), p->getLogfile(), SLOT(pauseReplay()));
     connect(m_logging->pauseButton, SIGNAL(clicked()), scpPlugin, SLOT(stopPlotting()));
     connect(m_logging->playbackSpeed, SIGNAL(valueChanged(double)), p->getLogfile(), SLOT(setReplaySpeed(double)));
-    void pauseReplay();
-    void resumeReplay();
+    connect(p->getLogfile(), SIGNAL(playTimeChanged(quint32)), this, SLOT(playTimeChanged(quint32)));
+    connect(m_logging->playbackPosition, SIGNAL(sliderMoved(int)), this, SLOT(positionSliderMoved(int)));
 }
 
 
 void LoggingGadgetWidget::stateChanged(QString status)
 {
     m_logging->statusLabel->setText(status);
+
+    // Scrubbing needs the footer index of an OPL v2 file, older logs
+    // still play but only linearly
+    if (status == "REPLAY") {
+        LogFile *logFile = loggingPlugin->getLogfile();
+        m_logging->playbackPosition->setMaximum(logFile->lastIndexTime() / 1000);
+        m_logging->playbackPosition->setEnabled(logFile->hasIndex());
+    } else {
+        m_logging->playbackPosition->setValue(0);
+        m_logging->playbackPosition->setEnabled(false);
+    }
+}
+
+/**
+ * Follows the playhead: updates the position slider (unless the user is
+ * dragging it) and the time label.
+ */
+void LoggingGadgetWidget::playTimeChanged(quint32 timeStampMs)
+{
+    if (!m_logging->playbackPosition->isSliderDown()) {
+        m_logging->playbackPosition->setValue(timeStampMs / 1000);
+    }
+    m_logging->positionLabel->setText(QString("%1:%2")
+                                      .arg(timeStampMs / 60000)
+                                      .arg((timeStampMs / 1000) % 60, 2, 10, QChar('0')));
+}
+
+/**
+ * Jumps the replay to the sync point closest to the slider position.
+ */
+void LoggingGadgetWidget::positionSliderMoved(int positionSeconds)
+{
+    loggingPlugin->getLogfile()->seekToTime((quint32)positionSeconds * 1000);
 }
 
 /**
@@ -47,6 +47,8 @@ public:
 
 protected slots:
     void stateChanged(QString status);
+    void playTimeChanged(quint32 timeStampMs);
+    void positionSliderMoved(int positionSeconds);
 
 signals:
     void pause();
@@ -29,6 +29,7 @@
 
 #include "loggingplugin.h"
 #include "logginggadgetfactory.h"
+#include "headlessrecorder.h"
 #include <QDebug>
 #include <QtPlugin>
 #include <QThread>
@@ -154,6 +155,33 @@ void LoggingThread::objectUpdated(UAVObject *obj)
     }
 };
 
+/**
+ * Writes a sync point to the file: the current state of every object
+ * instance, with the start of the block flagged in the logfile index.
+ * Replay can then seek to any sync point and resume from known state
+ * instead of reparsing the stream from the beginning.
+ */
+void LoggingThread::writeSyncSnapshot()
+{
+    QWriteLocker locker(&lock);
+
+    ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
+    UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
+
+    logFile.flagSyncPoint();
+
+    QList< QList<UAVObject *> > list = objManager->getObjects();
+    QList< QList<UAVObject *> >::const_iterator i;
+    QList<UAVObject *>::const_iterator j;
+    for (i = list.constBegin(); i != list.constEnd(); ++i) {
+        for (j = (*i).constBegin(); j != (*i).constEnd(); ++j) {
+            if (!uavTalk->sendObject(*j, false, false)) {
+                qDebug() << "Error logging " << (*j)->getName();
+            }
+        }
+    }
+};
+
 /**
  * Connect signals from all the objects updates to the write routine then
  * run event loop
@@ -186,6 +214,10 @@ void LoggingThread::run()
         qDebug() << "Logging: not connected, do no ask for settings";
     }
 
+    // Periodic sync points so the logfile index has seek targets
+    QTimer syncTimer;
+    connect(&syncTimer, SIGNAL(timeout()), this, SLOT(writeSyncSnapshot()), Qt::DirectConnection);
+    syncTimer.start(LogFile::SYNC_POINT_INTERVAL_MS);
 
     exec();
 }
@@ -294,7 +326,8 @@ LoggingPlugin::LoggingPlugin() :
     loggingThread(NULL),
     logConnection(new LoggingConnection(this)),
     mf(NULL),
-    cmd(NULL)
+    cmd(NULL),
+    recorder(NULL)
 {}
 
 LoggingPlugin::~LoggingPlugin()
@@ -310,11 +343,19 @@ LoggingPlugin::~LoggingPlugin()
  */
 bool LoggingPlugin::initialize(const QStringList & args, QString *errMsg)
 {
-    Q_UNUSED(args);
     Q_UNUSED(errMsg);
 
     loggingThread = NULL;
 
+    // Arguments declared in the pluginspec, used by the headless recorder
+    for (int i = 0; i < args.length() - 1; ++i) {
+        if (args.at(i) == "-rec-device") {
+            recDevice = args.at(++i);
+        } else if (args.at(i) == "-rec-file") {
+            recFile = args.at(++i);
+        }
+    }
+
     // Add Menu entry
     Core::ActionManager *am   = Core::ICore::instance()->actionManager();
     Core::ActionContainer *ac = am->actionContainer(Core::Constants::M_TOOLS);
@@ -439,6 +480,14 @@ void LoggingPlugin::replayStarted()
 void LoggingPlugin::extensionsInitialized()
 {
     addAutoReleasedObject(logConnection);
+
+    if (!recDevice.isEmpty()) {
+        if (recFile.isEmpty()) {
+            recFile = tr("OP-%0.opl").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss"));
+        }
+        recorder = new HeadlessRecorder(this, recDevice, recFile, this);
+        recorder->start();
+    }
 }
 
 void LoggingPlugin::shutdown()
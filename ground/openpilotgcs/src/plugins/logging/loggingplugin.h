@@ -43,6 +43,7 @@
 
 class LoggingPlugin;
 class LoggingGadgetFactory;
+class HeadlessRecorder;
 
 /**
  *   Define a connection via the IConnection interface
@@ -97,6 +98,7 @@ public:
 private slots:
     void objectUpdated(UAVObject *obj);
     void transactionCompleted(UAVObject *obj, bool success);
+    void writeSyncSnapshot();
 
 public slots:
     void stopLogging();
@@ -119,6 +121,7 @@ class LoggingPlugin : public ExtensionSystem::IPlugin {
                                               Q_PLUGIN_METADATA(IID "OpenPilot.Logging")
 
     friend class LoggingConnection;
+    friend class HeadlessRecorder;
 
 public:
     LoggingPlugin();
@@ -163,6 +166,11 @@ private slots:
 private:
     LoggingGadgetFactory *mf;
     Core::Command *cmd;
+
+    // headless recording session, set up from the command line
+    HeadlessRecorder *recorder;
+    QString recDevice;
+    QString recFile;
 };
 #endif /* LoggingPLUGIN_H_ */
 /**
@@ -42,21 +42,19 @@
 
 static const QString VERSION = "1.0.0";
 
+// play at most this many notifications at once, the backend mixes them;
+// anything above that still goes through the pending queue
+enum { eMaxConcurrentNotifications = 2 };
+
 // #define DEBUG_NOTIFIES
 
 
 SoundNotifyPlugin::SoundNotifyPlugin()
-{
-    phonon.mo = NULL;
-}
+{}
 
 SoundNotifyPlugin::~SoundNotifyPlugin()
 {
     Core::ICore::instance()->saveSettings(this);
-
-    if (phonon.mo != NULL) {
-        delete phonon.mo;
-    }
 }
 
 bool SoundNotifyPlugin::initialize(const QStringList & args, QString *errMsg)
@@ -181,10 +179,14 @@ void SoundNotifyPlugin::connectNotifications()
             disconnect(obj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(on_arrived_Notification(UAVObject *)));
         }
     }
-    if (phonon.mo != NULL) {
-        delete phonon.mo;
-        phonon.mo = NULL;
+    // the notification list may be replaced, stop anything in flight and
+    // drop the sound cache so it is rebuilt from the new list
+    _activeSequences.clear();
+    foreach(QSoundEffect * effect, _soundCache) {
+        effect->stop();
+        delete effect;
     }
+    _soundCache.clear();
 
     if (!enableSound) {
         return;
@@ -229,11 +231,13 @@ void SoundNotifyPlugin::connectNotifications()
     if (_notificationList.isEmpty()) {
         return;
     }
-    // set notification message to current event
-    phonon.mo = new QMediaPlayer;
-    phonon.firstPlay = true;
-    connect(phonon.mo, SIGNAL(stateChanged(QMediaPlayer::State)),
-            this, SLOT(stateChanged(QMediaPlayer::State)));
+    // decode every configured sound up front so the first occurrence of an
+    // alert plays immediately instead of stalling on file loading
+    foreach(NotificationItem * notify, _notificationList) {
+        foreach(QString soundFile, notify->toSoundList()) {
+            cachedSound(soundFile);
+        }
+    }
 }
 
 void SoundNotifyPlugin::on_arrived_Notification(UAVObject *object)
@@ -245,7 +249,7 @@ void SoundNotifyPlugin::on_arrived_Notification(UAVObject *object)
 
 
         // skip duplicate notifications
-        if (_nowPlayingNotification == ntf) {
+        if (isPlayingNotification(ntf)) {
             continue;
         }
 
@@ -285,7 +289,7 @@ void SoundNotifyPlugin::on_timerRepeated_Notification()
     // skip duplicate notifications
     // WARNING: generally we shoudn't ever trap here
     // this means, that timer fires to early and notification overlap itself
-    if (_nowPlayingNotification == notification) {
+    if (isPlayingNotification(notification)) {
         qNotifyDebug() << "WARN: on_timerRepeated - notification was skipped!";
         notification->restartTimer();
         return;
@@ -323,34 +327,71 @@ void SoundNotifyPlugin::on_expiredTimer_Notification()
     }
 }
 
-void SoundNotifyPlugin::stateChanged(QMediaPlayer::State newstate)
+/**
+ * Look up a preloaded sound, decoding it now if it was not configured
+ * when the cache was filled
+ */
+QSoundEffect *SoundNotifyPlugin::cachedSound(const QString &filename)
+{
+    QSoundEffect *effect = _soundCache.value(filename);
+
+    if (!effect) {
+        effect = new QSoundEffect(this);
+        effect->setSource(QUrl::fromLocalFile(filename));
+        connect(effect, SIGNAL(playingChanged()), this, SLOT(onSoundFinished()));
+        _soundCache.insert(filename, effect);
+    }
+    return effect;
+}
+
+bool SoundNotifyPlugin::isPlayingNotification(NotificationItem *notification) const
+{
+    foreach(const ActiveSequence &seq, _activeSequences) {
+        if (seq.notification == notification) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SoundNotifyPlugin::onSoundFinished()
 {
-    // qNotifyDebug() << "File length (ms): " << phonon.mo->totalTime();
-
-#ifndef Q_OS_WIN
-    // This is a hack to force Linux to wait until the end of the
-    // wav file before moving to the next in the queue.
-    // I wish I did not have to go through a #define, but I did not
-    // manage to make this work on both platforms any other way!
-// if (phonon.mo->totalTime() > 0) {
-// phonon.mo->setTransitionTime(phonon.mo->totalTime());
-// }
-#endif
-    if ((newstate == QMediaPlayer::PausedState) ||
-        (newstate == QMediaPlayer::StoppedState)) {
-        qNotifyDebug() << "New State: " << QVariant(newstate).toString();
-
-        // assignment to NULL needed to detect that palying is finished
-        // it's useful in repeat timer handler, where we can detect
-        // that notification has not overlap with itself
-        _nowPlayingNotification = NULL;
-
-        if (!_pendingNotifications.isEmpty()) {
-            NotificationItem *notification = _pendingNotifications.takeFirst();
-            qNotifyDebug_if(notification) << "play audioFree - " << notification->toString();
-            playNotification(notification);
-            qNotifyDebug() << "end playNotification";
+    QSoundEffect *effect = qobject_cast<QSoundEffect *>(sender());
+
+    // playingChanged also fires when playback starts
+    if (!effect || effect->isPlaying()) {
+        return;
+    }
+
+    for (int i = 0; i < _activeSequences.size(); i++) {
+        ActiveSequence &seq = _activeSequences[i];
+        if (seq.effect != effect) {
+            continue;
         }
+        seq.sounds.removeFirst();
+        // advance to the next sound of the phrase, skipping any that are
+        // busy mixing in a concurrent notification
+        while (!seq.sounds.isEmpty()) {
+            QSoundEffect *next = cachedSound(seq.sounds.first());
+            if (!next->isPlaying()) {
+                seq.effect = next;
+                next->play();
+                return;
+            }
+            qNotifyDebug() << "skip busy sound - " << seq.sounds.first();
+            seq.sounds.removeFirst();
+        }
+        _activeSequences.removeAt(i);
+        break;
+    }
+
+    // a mixing slot freed up, start the next queued notification
+    if ((_activeSequences.count() < eMaxConcurrentNotifications)
+        && !_pendingNotifications.isEmpty()) {
+        NotificationItem *notification = _pendingNotifications.takeFirst();
+        qNotifyDebug_if(notification) << "play audioFree - " << notification->toString();
+        playNotification(notification);
+        qNotifyDebug() << "end playNotification";
     }
 }
 
@@ -454,7 +495,7 @@ void SoundNotifyPlugin::checkNotificationRule(NotificationItem *notification, UA
 
     if (!playNotification(notification)) {
         if (!_pendingNotifications.contains(notification)
-            && (_nowPlayingNotification != notification)) {
+            && !isPlayingNotification(notification)) {
             notification->stopTimer();
 
             qNotifyDebug() << "add to pending list - " << notification->toString();
@@ -471,22 +512,31 @@ void SoundNotifyPlugin::checkNotificationRule(NotificationItem *notification, UA
 
 bool SoundNotifyPlugin::playNotification(NotificationItem *notification)
 {
-    playlist = new QMediaPlaylist;
     if (!notification) {
         return false;
     }
 
-    // Check: race condition, if phonon.mo got deleted don't go further
-    if (phonon.mo == NULL) {
+    if (!enableSound) {
         return false;
     }
 
-    // qNotifyDebug() << "Phonon State: " << phonon.mo->state();
+    QStringList sounds = notification->toSoundList();
+    if (sounds.isEmpty()) {
+        return false;
+    }
+
+    // overlapping notifications are mixed instead of queued serially,
+    // up to the concurrency limit
+    if (_activeSequences.count() >= eMaxConcurrentNotifications) {
+        return false;
+    }
+    QSoundEffect *effect = cachedSound(sounds.first());
+    if (effect->isPlaying()) {
+        // first sound is still mixing in a concurrent notification
+        return false;
+    }
 
-    if ((phonon.mo->state() == QMediaPlayer::PausedState)
-        || (phonon.mo->state() == QMediaPlayer::StoppedState)
-        || phonon.firstPlay) {
-        _nowPlayingNotification = notification;
+    {
         notification->stopExpireTimer();
 
         if (notification->retryValue() == NotificationItem::repeatOnce) {
@@ -518,19 +568,15 @@ bool SoundNotifyPlugin::playNotification(NotificationItem *notification)
                         this, SLOT(on_timerRepeated_Notification()), Qt::UniqueConnection);
             }
         }
-        phonon.mo->stop();
         qNotifyDebug() << "play: " << notification->toString();
-        foreach(QString item, notification->toSoundList()) {
-            playlist->addMedia(QUrl::fromLocalFile(item));
-        }
+        ActiveSequence seq;
+        seq.notification = notification;
+        seq.sounds = sounds;
+        seq.effect = effect;
+        _activeSequences.append(seq);
         qNotifyDebug() << "begin play";
-        phonon.mo->setPlaylist(playlist);
-        phonon.mo->play();
+        effect->play();
         qNotifyDebug() << "end play";
-        phonon.firstPlay = false; // On Linux, you sometimes have to nudge Phonon to play 1 time before
-                                  // the state is not "Loading" anymore.
         return true;
     }
-
-    return false;
 }
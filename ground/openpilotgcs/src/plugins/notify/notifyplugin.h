@@ -34,17 +34,11 @@
 #include "notificationitem.h"
 
 #include <QSettings>
-#include <QMediaPlaylist>
-#include <QMediaPlayer>
+#include <QHash>
+#include <QSoundEffect>
 
 class NotifyPluginOptionsPage;
 
-typedef struct {
-    QMediaPlayer *mo;
-    NotificationItem *notify;
-    bool firstPlay;
-} PhononObject, *pPhononObject;
-
 
 class SoundNotifyPlugin : public Core::IConfigurablePlugin {
     Q_OBJECT
@@ -83,6 +77,8 @@ private:
     Q_DISABLE_COPY(SoundNotifyPlugin)
 
     bool playNotification(NotificationItem *notification);
+    bool isPlayingNotification(NotificationItem *notification) const;
+    QSoundEffect *cachedSound(const QString &filename);
     void checkNotificationRule(NotificationItem *notification, UAVObject *object);
 
 private slots:
@@ -95,7 +91,7 @@ private slots:
     void on_arrived_Notification(UAVObject *object);
     void on_timerRepeated_Notification(void);
     void on_expiredTimer_Notification(void);
-    void stateChanged(QMediaPlayer::State newstate);
+    void onSoundFinished();
 
 private:
     bool enableSound;
@@ -106,11 +102,19 @@ private:
     QList<NotificationItem *> _toRemoveNotifications;
 
     NotificationItem currentNotification;
-    NotificationItem *_nowPlayingNotification;
 
-    PhononObject phonon;
+    // One in-flight notification: the remaining sound files of its phrase,
+    // the head of the list is playing on the referenced cached effect
+    struct ActiveSequence {
+        NotificationItem *notification;
+        QStringList sounds;
+        QSoundEffect *effect;
+    };
+
+    QList<ActiveSequence> _activeSequences;
+    // decoded PCM buffers for every configured sound file, keyed by filename
+    QHash<QString, QSoundEffect *> _soundCache;
     NotifyPluginOptionsPage *mop;
-    QMediaPlaylist *playlist;
 };
 
 #endif // SOUNDNOTIFYPLUGIN_H
@@ -39,6 +39,9 @@ class IConnection;
 // timeout value used when we want to return directly without waiting
 static const int READ_TIMEOUT  = 200;
 static const int READ_SIZE     = 64;
+// upper bound on how much payload is drained per wakeup of the read
+// thread before the buffered data is published to the consumer
+static const int READ_BATCH_SIZE = 2048;
 
 static const int WRITE_TIMEOUT = 1000;
 static const int WRITE_SIZE    = 64;
@@ -169,12 +172,30 @@ void RawHIDReadThread::run()
         int ret = hiddev->receive(hidno, buffer, READ_SIZE, READ_TIMEOUT);
 
         if (ret > 0) { // read some data
-            QMutexLocker lock(&m_readBufMtx);
             // Note: Preprocess the USB packets in this OS independent code
             // First byte is report ID, second byte is the number of valid bytes
-            m_readBuffer.append(&buffer[2], buffer[1]);
+            QByteArray batch(&buffer[2], buffer[1]);
+
+            // Drain the reports that already arrived in the meantime so
+            // the batch costs one buffer lock and one readyRead signal
+            while (batch.size() < READ_BATCH_SIZE) {
+                char next[READ_SIZE] = { 0 };
+                ret = hiddev->receive(hidno, next, READ_SIZE, 0);
+                if (ret <= 0) {
+                    break;
+                }
+                batch.append(&next[2], next[1]);
+            }
 
+            {
+                QMutexLocker lock(&m_readBufMtx);
+                m_readBuffer.append(batch);
+            }
             emit m_hid->readyRead();
+
+            if (ret < 0) { // error while draining
+                m_running = false;
+            }
         } else if (ret == 0) { // nothing read
         } else { // < 0 => error
                  // TODO! make proper error handling, this only quick hack for unplug freeze
@@ -243,6 +264,16 @@ void RawHIDWriteThread::run()
                 size = m_writeBuffer.size();
             }
 
+            // Coalesce small sends: while the report is not full and
+            // more data keeps trickling in, wait a moment longer so the
+            // report goes out filled instead of one per small message
+            while (m_writeBuffer.size() < WRITE_SIZE - 2 &&
+                   m_newDataToWrite.wait(&m_writeBufMtx, 1)) {
+                if (!m_running) {
+                    return;
+                }
+            }
+
             // NOTE: data size is limited to 2 bytes less than the
             // usb packet size (64 bytes for interrupt) to make room
             // for the reportID and valid data length
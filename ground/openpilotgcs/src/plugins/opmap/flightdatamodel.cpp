@@ -28,6 +28,13 @@
 #include "flightdatamodel.h"
 #include <QMessageBox>
 #include <QDomDocument>
+#include <QDataStream>
+
+// Compact binary mission format. The file is mapped into memory and decoded
+// in a single sequential pass, which skips the DOM round trip of the XML
+// format and keeps large survey plans loading in milliseconds.
+#define MISSION_FILE_MAGIC   0x424d504f // "OPMB"
+#define MISSION_FILE_VERSION 1
 
 flightDataModel::flightDataModel(QObject *parent) : QAbstractTableModel(parent)
 {}
@@ -53,7 +60,7 @@ QVariant flightDataModel::data(const QModelIndex &index, int role) const
         if (rowNumber > dataStorage.length() - 1 || rowNumber < 0) {
             return QVariant::Invalid;
         }
-        pathPlanData *myRow = dataStorage.at(rowNumber);
+        const pathPlanData *myRow = &dataStorage.at(rowNumber);
         QVariant ret = getColumnByIndex(myRow, columnNumber);
         return ret;
     }
@@ -350,7 +357,12 @@ bool flightDataModel::setData(const QModelIndex &index, const QVariant &value, i
         if (rowIndex > dataStorage.length() - 1) {
             return false;
         }
-        pathPlanData *myRow = dataStorage.at(rowIndex);
+        pathPlanData *myRow = &dataStorage[rowIndex];
+        // only notify the views and the map proxy when the value actually
+        // changes, otherwise bulk edits trigger redundant map updates
+        if (getColumnByIndex(myRow, columnIndex) == value) {
+            return true;
+        }
         setColumnByIndex(myRow, columnIndex, value);
         emit dataChanged(index, index);
     }
@@ -364,50 +376,50 @@ Qt::ItemFlags flightDataModel::flags(const QModelIndex & /*index*/) const
 
 bool flightDataModel::insertRows(int row, int count, const QModelIndex & /*parent*/)
 {
-    pathPlanData *data;
+    pathPlanData data;
 
     beginInsertRows(QModelIndex(), row, row + count - 1);
     for (int x = 0; x < count; ++x) {
-        data = new pathPlanData;
-        data->latPosition         = 0;
-        data->lngPosition         = 0;
-        data->disRelative         = 0;
-        data->beaRelative         = 0;
-        data->altitudeRelative    = 0;
-        data->isRelative          = true;
-        data->altitude            = 0;
-        data->velocity            = 0;
-        data->mode = 1;
-        data->mode_params[0]      = 0;
-        data->mode_params[1]      = 0;
-        data->mode_params[2]      = 0;
-        data->mode_params[3]      = 0;
-        data->condition           = 3;
-        data->condition_params[0] = 0;
-        data->condition_params[1] = 0;
-        data->condition_params[2] = 0;
-        data->condition_params[3] = 0;
-        data->command = 0;
-        data->jumpdestination     = 0;
-        data->errordestination    = 0;
-        data->locked = false;
+        data.latPosition         = 0;
+        data.lngPosition         = 0;
+        data.disRelative         = 0;
+        data.beaRelative         = 0;
+        data.altitudeRelative    = 0;
+        data.isRelative          = true;
+        data.altitude            = 0;
+        data.velocity            = 0;
+        data.mode = 1;
+        data.mode_params[0]      = 0;
+        data.mode_params[1]      = 0;
+        data.mode_params[2]      = 0;
+        data.mode_params[3]      = 0;
+        data.condition           = 3;
+        data.condition_params[0] = 0;
+        data.condition_params[1] = 0;
+        data.condition_params[2] = 0;
+        data.condition_params[3] = 0;
+        data.command = 0;
+        data.jumpdestination     = 0;
+        data.errordestination    = 0;
+        data.locked = false;
         if (rowCount() > 0) {
-            data->altitude            = this->data(this->index(rowCount() - 1, ALTITUDE)).toDouble();
-            data->altitudeRelative    = this->data(this->index(rowCount() - 1, ALTITUDERELATIVE)).toDouble();
-            data->isRelative          = this->data(this->index(rowCount() - 1, ISRELATIVE)).toBool();
-            data->velocity            = this->data(this->index(rowCount() - 1, VELOCITY)).toFloat();
-            data->mode = this->data(this->index(rowCount() - 1, MODE)).toInt();
-            data->mode_params[0]      = this->data(this->index(rowCount() - 1, MODE_PARAMS0)).toFloat();
-            data->mode_params[1]      = this->data(this->index(rowCount() - 1, MODE_PARAMS1)).toFloat();
-            data->mode_params[2]      = this->data(this->index(rowCount() - 1, MODE_PARAMS2)).toFloat();
-            data->mode_params[3]      = this->data(this->index(rowCount() - 1, MODE_PARAMS3)).toFloat();
-            data->condition           = this->data(this->index(rowCount() - 1, CONDITION)).toInt();
-            data->condition_params[0] = this->data(this->index(rowCount() - 1, CONDITION_PARAMS0)).toFloat();
-            data->condition_params[1] = this->data(this->index(rowCount() - 1, CONDITION_PARAMS1)).toFloat();
-            data->condition_params[2] = this->data(this->index(rowCount() - 1, CONDITION_PARAMS2)).toFloat();
-            data->condition_params[3] = this->data(this->index(rowCount() - 1, CONDITION_PARAMS3)).toFloat();
-            data->command = this->data(this->index(rowCount() - 1, COMMAND)).toInt();
-            data->errordestination    = this->data(this->index(rowCount() - 1, ERRORDESTINATION)).toInt();
+            const pathPlanData *lastRow = &dataStorage.at(rowCount() - 1);
+            data.altitude            = lastRow->altitude;
+            data.altitudeRelative    = lastRow->altitudeRelative;
+            data.isRelative          = lastRow->isRelative;
+            data.velocity            = lastRow->velocity;
+            data.mode = lastRow->mode;
+            data.mode_params[0]      = lastRow->mode_params[0];
+            data.mode_params[1]      = lastRow->mode_params[1];
+            data.mode_params[2]      = lastRow->mode_params[2];
+            data.mode_params[3]      = lastRow->mode_params[3];
+            data.condition           = lastRow->condition;
+            data.condition_params[0] = lastRow->condition_params[0];
+            data.condition_params[1] = lastRow->condition_params[1];
+            data.condition_params[2] = lastRow->condition_params[2];
+            data.condition_params[3] = lastRow->condition_params[3];
+            data.command = lastRow->command;
+            data.errordestination    = lastRow->errordestination;
         }
         dataStorage.insert(row, data);
     }
@@ -421,15 +433,44 @@ bool flightDataModel::removeRows(int row, int count, const QModelIndex & /*paren
         return false;
     }
     beginRemoveRows(QModelIndex(), row, row + count - 1);
-    for (int x = 0; x < count; ++x) {
-        delete dataStorage.at(row);
-        dataStorage.removeAt(row);
-    }
+    dataStorage.remove(row, count);
     endRemoveRows();
     return true;
 }
 
 bool flightDataModel::writeToFile(QString fileName)
+{
+    if (fileName.endsWith(QLatin1String(".opmb"), Qt::CaseInsensitive)) {
+        return writeToBinaryFile(fileName);
+    }
+    return writeToXmlFile(fileName);
+}
+
+void flightDataModel::readFromFile(QString fileName)
+{
+    if (fileName.endsWith(QLatin1String(".opmb"), Qt::CaseInsensitive)) {
+        readFromBinaryFile(fileName);
+    } else {
+        readFromXmlFile(fileName);
+    }
+}
+
+/**
+ * Replace the model contents with a single batched insert so that the views
+ * and the map proxy rebuild their items and overlays once instead of once
+ * per waypoint.
+ */
+void flightDataModel::replaceData(const QVector<pathPlanData> &rows)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), 0, rows.count() - 1);
+    dataStorage = rows;
+    endInsertRows();
+}
+
+bool flightDataModel::writeToBinaryFile(QString fileName)
 {
     QFile file(fileName);
 
@@ -438,14 +479,110 @@ bool flightDataModel::writeToFile(QString fileName)
         return false;
     }
     QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_4_8);
+    out << (quint32)MISSION_FILE_MAGIC;
+    out << (quint32)MISSION_FILE_VERSION;
+    out << (quint32)dataStorage.count();
+    for (int i = 0; i < dataStorage.count(); i++) {
+        const pathPlanData *obj = &dataStorage.at(i);
+        out << obj->wpDescritption;
+        out << obj->latPosition << obj->lngPosition;
+        out << obj->disRelative << obj->beaRelative << obj->altitudeRelative;
+        out << obj->isRelative << obj->altitude << obj->velocity;
+        out << (qint32)obj->mode;
+        out << obj->mode_params[0] << obj->mode_params[1] << obj->mode_params[2] << obj->mode_params[3];
+        out << (qint32)obj->condition;
+        out << obj->condition_params[0] << obj->condition_params[1] << obj->condition_params[2] << obj->condition_params[3];
+        out << (qint32)obj->command << (qint32)obj->jumpdestination << (qint32)obj->errordestination;
+        out << obj->locked;
+    }
+    file.close();
+    return true;
+}
+
+void flightDataModel::readFromBinaryFile(QString fileName)
+{
+    removeRows(0, rowCount());
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        QMessageBox::information(NULL, tr("Unable to open file"), file.errorString());
+        return;
+    }
+    // Decode straight out of the mapped file, falling back to a buffered
+    // read when mapping is not available (e.g. some network filesystems).
+    QByteArray array;
+    uchar *map = file.map(0, file.size());
+    if (map) {
+        array = QByteArray::fromRawData((const char *)map, file.size());
+    } else {
+        array = file.readAll();
+    }
+    QDataStream in(array);
+    in.setVersion(QDataStream::Qt_4_8);
+    quint32 magic   = 0;
+    quint32 version = 0;
+    quint32 count   = 0;
+    in >> magic >> version >> count;
+    if (magic != MISSION_FILE_MAGIC || version != MISSION_FILE_VERSION) {
+        QMessageBox msgBox;
+        msgBox.setText(tr("Wrong file contents"));
+        msgBox.setInformativeText(tr("This file is not a valid binary path plan"));
+        msgBox.setStandardButtons(QMessageBox::Ok);
+        msgBox.exec();
+        return;
+    }
+    QVector<pathPlanData> rows;
+    rows.reserve(count);
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+        pathPlanData data;
+        qint32 mode, condition, command, jumpdestination, errordestination;
+        in >> data.wpDescritption;
+        in >> data.latPosition >> data.lngPosition;
+        in >> data.disRelative >> data.beaRelative >> data.altitudeRelative;
+        in >> data.isRelative >> data.altitude >> data.velocity;
+        in >> mode;
+        in >> data.mode_params[0] >> data.mode_params[1] >> data.mode_params[2] >> data.mode_params[3];
+        in >> condition;
+        in >> data.condition_params[0] >> data.condition_params[1] >> data.condition_params[2] >> data.condition_params[3];
+        in >> command >> jumpdestination >> errordestination;
+        in >> data.locked;
+        data.mode      = mode;
+        data.condition = condition;
+        data.command   = command;
+        data.jumpdestination  = jumpdestination;
+        data.errordestination = errordestination;
+        rows.append(data);
+    }
+    bool truncated = (in.status() != QDataStream::Ok) || ((quint32)rows.count() != count);
+    file.close();
+    if (truncated) {
+        QMessageBox msgBox;
+        msgBox.setText(tr("File Parsing Failed."));
+        msgBox.setInformativeText(tr("This file is truncated or corrupt"));
+        msgBox.setStandardButtons(QMessageBox::Ok);
+        msgBox.exec();
+        return;
+    }
+    replaceData(rows);
+}
+
+bool flightDataModel::writeToXmlFile(QString fileName)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        QMessageBox::information(NULL, tr("Unable to open file"), file.errorString());
+        return false;
+    }
     QDomDocument doc("PathPlan");
     QDomElement root = doc.createElement("waypoints");
     doc.appendChild(root);
 
-    foreach(pathPlanData * obj, dataStorage) {
-        QDomElement waypoint = doc.createElement("waypoint");
+    for (int i = 0; i < dataStorage.count(); i++) {
+        const pathPlanData *obj = &dataStorage.at(i);
+        QDomElement waypoint    = doc.createElement("waypoint");
 
-        waypoint.setAttribute("number", dataStorage.indexOf(obj));
+        waypoint.setAttribute("number", i);
         root.appendChild(waypoint);
         QDomElement field = doc.createElement("field");
         field.setAttribute("value", obj->wpDescritption);
@@ -567,7 +704,7 @@ bool flightDataModel::writeToFile(QString fileName)
     return true;
 }
 
-void flightDataModel::readFromFile(QString fileName)
+void flightDataModel::readFromXmlFile(QString fileName)
 {
     // TODO warning message
     removeRows(0, rowCount());
@@ -597,74 +734,73 @@ void flightDataModel::readFromFile(QString fileName)
         return;
     }
 
-    pathPlanData *data = NULL;
+    QVector<pathPlanData> rows;
     QDomNode node = root.firstChild();
     while (!node.isNull()) {
         QDomElement e = node.toElement();
         if (e.tagName() == "waypoint") {
             QDomNode fieldNode = e.firstChild();
-            data = new pathPlanData;
+            pathPlanData data;
             while (!fieldNode.isNull()) {
                 QDomElement field = fieldNode.toElement();
                 if (field.tagName() == "field") {
                     QString name  = field.attribute("name");
                     QString value = field.attribute("value");
                     if (name == "altitude") {
-                        data->altitude = value.toDouble();
+                        data.altitude = value.toDouble();
                     } else if (name == "description") {
-                        data->wpDescritption = value;
+                        data.wpDescritption = value;
                     } else if (name == "latitude") {
-                        data->latPosition = value.toDouble();
+                        data.latPosition = value.toDouble();
                     } else if (name == "longitude") {
-                        data->lngPosition = value.toDouble();
+                        data.lngPosition = value.toDouble();
                     } else if (name == "distance_to_home") {
-                        data->disRelative = value.toDouble();
+                        data.disRelative = value.toDouble();
                     } else if (name == "bearing_from_home") {
-                        data->beaRelative = value.toDouble();
+                        data.beaRelative = value.toDouble();
                     } else if (name == "altitude_above_home") {
-                        data->altitudeRelative = value.toFloat();
+                        data.altitudeRelative = value.toFloat();
                     } else if (name == "is_relative_to_home") {
-                        data->isRelative = value.toInt();
+                        data.isRelative = value.toInt();
                     } else if (name == "altitude") {
-                        data->altitude = value.toDouble();
+                        data.altitude = value.toDouble();
                     } else if (name == "velocity") {
-                        data->velocity = value.toFloat();
+                        data.velocity = value.toFloat();
                     } else if (name == "mode") {
-                        data->mode = value.toInt();
+                        data.mode = value.toInt();
                     } else if (name == "mode_param0") {
-                        data->mode_params[0] = value.toFloat();
+                        data.mode_params[0] = value.toFloat();
                     } else if (name == "mode_param1") {
-                        data->mode_params[1] = value.toFloat();
+                        data.mode_params[1] = value.toFloat();
                     } else if (name == "mode_param2") {
-                        data->mode_params[2] = value.toFloat();
+                        data.mode_params[2] = value.toFloat();
                     } else if (name == "mode_param3") {
-                        data->mode_params[3] = value.toFloat();
+                        data.mode_params[3] = value.toFloat();
                     } else if (name == "condition") {
-                        data->condition = value.toDouble();
+                        data.condition = value.toDouble();
                     } else if (name == "condition_param0") {
-                        data->condition_params[0] = value.toFloat();
+                        data.condition_params[0] = value.toFloat();
                     } else if (name == "condition_param1") {
-                        data->condition_params[1] = value.toFloat();
+                        data.condition_params[1] = value.toFloat();
                     } else if (name == "condition_param2") {
-                        data->condition_params[2] = value.toFloat();
+                        data.condition_params[2] = value.toFloat();
                     } else if (name == "condition_param3") {
-                        data->condition_params[3] = value.toFloat();
+                        data.condition_params[3] = value.toFloat();
                     } else if (name == "command") {
-                        data->command = value.toInt();
+                        data.command = value.toInt();
                     } else if (name == "jumpdestination") {
-                        data->jumpdestination = value.toInt();
+                        data.jumpdestination = value.toInt();
                     } else if (name == "errordestination") {
-                        data->errordestination = value.toInt();
+                        data.errordestination = value.toInt();
                     } else if (name == "is_locked") {
-                        data->locked = value.toInt();
+                        data.locked = value.toInt();
                     }
                 }
                 fieldNode = fieldNode.nextSibling();
             }
-            beginInsertRows(QModelIndex(), dataStorage.length(), dataStorage.length());
-            dataStorage.append(data);
-            endInsertRows();
+            rows.append(data);
         }
         node = node.nextSibling();
     }
+    replaceData(rows);
 }
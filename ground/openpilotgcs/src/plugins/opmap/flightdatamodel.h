@@ -71,9 +71,16 @@ public:
     bool writeToFile(QString filename);
     void readFromFile(QString fileName);
 private:
-    QList<pathPlanData *> dataStorage;
+    // Rows are stored by value in a contiguous array so that editing and
+    // (de)serializing large missions does not chase one heap object per row.
+    QVector<pathPlanData> dataStorage;
     QVariant getColumnByIndex(const pathPlanData *row, const int index) const;
     bool setColumnByIndex(pathPlanData *row, const int index, const QVariant value);
+    bool writeToXmlFile(QString fileName);
+    bool writeToBinaryFile(QString fileName);
+    void readFromXmlFile(QString fileName);
+    void readFromBinaryFile(QString fileName);
+    void replaceData(const QVector<pathPlanData> &rows);
 };
 
 #endif // FLIGHTDATAMODEL_H
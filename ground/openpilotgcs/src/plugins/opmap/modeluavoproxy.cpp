@@ -31,6 +31,10 @@
 #include <QProgressDialog>
 #include <math.h>
 
+// number of acked instance transactions kept in flight while transferring a
+// path plan, so that a long plan does not pay a full round trip per instance
+static const int PATH_PLAN_BATCH_SIZE = 8;
+
 ModelUavoProxy::ModelUavoProxy(QObject *parent, flightDataModel *model) : QObject(parent), myModel(model)
 {
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
@@ -56,34 +60,35 @@ void ModelUavoProxy::sendPathPlan()
     progress.show();
 
     UAVObjectUpdaterHelper updateHelper;
+    UAVObjectBatchUpdaterHelper batchUpdateHelper;
 
     // send PathPlan
     bool success = (updateHelper.doObjectAndWait(pathPlan) == UAVObjectUpdaterHelper::SUCCESS);
     progress.setValue(1);
 
     if (success) {
-        // send Waypoint instances
+        // send Waypoint instances, several in flight at a time
         qDebug() << "sending" << waypointCount << "waypoints";
-        for (int i = 0; i < waypointCount; ++i) {
-            Waypoint *waypoint = Waypoint::GetInstance(objMngr, i);
-            success = (updateHelper.doObjectAndWait(waypoint) == UAVObjectUpdaterHelper::SUCCESS);
-            if (!success) {
-                break;
+        for (int i = 0; i < waypointCount && success; i += PATH_PLAN_BATCH_SIZE) {
+            QList<UAVObject *> batch;
+            for (int j = i; j < waypointCount && j < i + PATH_PLAN_BATCH_SIZE; ++j) {
+                batch.append(Waypoint::GetInstance(objMngr, j));
             }
-            progress.setValue(progress.value() + 1);
+            success = (batchUpdateHelper.doObjectsAndWait(batch) == UAVObjectBatchUpdaterHelper::SUCCESS);
+            progress.setValue(progress.value() + batch.count());
         }
     }
 
     if (success) {
-        // send PathAction instances
+        // send PathAction instances, several in flight at a time
         qDebug() << "sending" << actionCount << "path actions";
-        for (int i = 0; i < actionCount; ++i) {
-            PathAction *action = PathAction::GetInstance(objMngr, i);
-            success = (updateHelper.doObjectAndWait(action) == UAVObjectUpdaterHelper::SUCCESS);
-            if (!success) {
-                break;
+        for (int i = 0; i < actionCount && success; i += PATH_PLAN_BATCH_SIZE) {
+            QList<UAVObject *> batch;
+            for (int j = i; j < actionCount && j < i + PATH_PLAN_BATCH_SIZE; ++j) {
+                batch.append(PathAction::GetInstance(objMngr, j));
             }
-            progress.setValue(progress.value() + 1);
+            success = (batchUpdateHelper.doObjectsAndWait(batch) == UAVObjectBatchUpdaterHelper::SUCCESS);
+            progress.setValue(progress.value() + batch.count());
         }
     }
 
@@ -104,6 +109,7 @@ void ModelUavoProxy::receivePathPlan()
     progress.show();
 
     UAVObjectRequestHelper requestHelper;
+    UAVObjectBatchRequestHelper batchRequestHelper;
 
     PathPlan *pathPlan = PathPlan::GetInstance(objMngr);
     bool success = (requestHelper.doObjectAndWait(pathPlan) == UAVObjectUpdaterHelper::SUCCESS);
@@ -121,15 +127,15 @@ void ModelUavoProxy::receivePathPlan()
         success = objMngr->registerObject(waypoint);
     }
     if (success) {
-        // request Waypoint instances
+        // request Waypoint instances, several in flight at a time
         qDebug() << "requesting" << waypointCount << "waypoints";
-        for (int i = 0; i < waypointCount; ++i) {
-            Waypoint *waypoint = Waypoint::GetInstance(objMngr, i);
-            success = (requestHelper.doObjectAndWait(waypoint) == UAVObjectRequestHelper::SUCCESS);
-            if (!success) {
-                break;
+        for (int i = 0; i < waypointCount && success; i += PATH_PLAN_BATCH_SIZE) {
+            QList<UAVObject *> batch;
+            for (int j = i; j < waypointCount && j < i + PATH_PLAN_BATCH_SIZE; ++j) {
+                batch.append(Waypoint::GetInstance(objMngr, j));
             }
-            progress.setValue(progress.value() + 1);
+            success = (batchRequestHelper.doObjectsAndWait(batch) == UAVObjectBatchRequestHelper::SUCCESS);
+            progress.setValue(progress.value() + batch.count());
         }
     }
 
@@ -140,15 +146,15 @@ void ModelUavoProxy::receivePathPlan()
         success = objMngr->registerObject(action);
     }
     if (success) {
-        // request PathAction isntances
+        // request PathAction isntances, several in flight at a time
         qDebug() << "requesting" << actionCount << "path actions";
-        for (int i = 0; i < actionCount; ++i) {
-            PathAction *action = PathAction::GetInstance(objMngr, i);
-            success = (requestHelper.doObjectAndWait(action) == UAVObjectRequestHelper::SUCCESS);
-            if (!success) {
-                break;
+        for (int i = 0; i < actionCount && success; i += PATH_PLAN_BATCH_SIZE) {
+            QList<UAVObject *> batch;
+            for (int j = i; j < actionCount && j < i + PATH_PLAN_BATCH_SIZE; ++j) {
+                batch.append(PathAction::GetInstance(objMngr, j));
             }
-            progress.setValue(progress.value() + 1);
+            success = (batchRequestHelper.doObjectsAndWait(batch) == UAVObjectBatchRequestHelper::SUCCESS);
+            progress.setValue(progress.value() + batch.count());
         }
     }
 
@@ -34,6 +34,8 @@
 #include <QVBoxLayout>
 #include <QInputDialog>
 #include <QClipboard>
+#include <QMessageBox>
+#include <QProgressDialog>
 #include <QMenu>
 #include <QStringList>
 #include <QDir>
@@ -374,6 +376,7 @@ void OPMapGadgetWidget::contextMenuEvent(QContextMenuEvent *event)
     contextMenu.addAction(reloadAct);
     contextMenu.addSeparator();
     contextMenu.addAction(ripAct);
+    contextMenu.addAction(prefetchRouteAct);
     contextMenu.addSeparator();
 
     QMenu maxUpdateRateSubMenu(tr("&Max Update Rate ") + "(" + QString::number(m_maxUpdateRate) + " ms)", this);
@@ -1318,6 +1321,10 @@ void OPMapGadgetWidget::createActions()
     ripAct->setStatusTip(tr("Rip the map tiles"));
     connect(ripAct, SIGNAL(triggered()), this, SLOT(onRipAct_triggered()));
 
+    prefetchRouteAct = new QAction(tr("&Prefetch route tiles"), this);
+    prefetchRouteAct->setStatusTip(tr("Download the map tiles along the flight plan into the cache"));
+    connect(prefetchRouteAct, SIGNAL(triggered()), this, SLOT(onPrefetchRouteAct_triggered()));
+
     copyMouseLatLonToClipAct = new QAction(tr("Mouse latitude and longitude"), this);
     copyMouseLatLonToClipAct->setStatusTip(tr("Copy the mouse latitude and longitude to the clipboard"));
     connect(copyMouseLatLonToClipAct, SIGNAL(triggered()), this, SLOT(onCopyMouseLatLonToClipAct_triggered()));
@@ -1605,6 +1612,40 @@ void OPMapGadgetWidget::onRipAct_triggered()
     m_map->RipMap();
 }
 
+void OPMapGadgetWidget::onPrefetchRouteAct_triggered()
+{
+    if (!m_widget || !m_map || model.isNull()) {
+        return;
+    }
+
+    QList<internals::PointLatLng> route;
+    for (int i = 0; i < model->rowCount(); i++) {
+        double lat = model->data(model->index(i, flightDataModel::LATPOSITION)).toDouble();
+        double lng = model->data(model->index(i, flightDataModel::LNGPOSITION)).toDouble();
+        route.append(internals::PointLatLng(lat, lng));
+    }
+    if (route.isEmpty()) {
+        QMessageBox::information(this, tr("Prefetch route tiles"), tr("The flight plan has no waypoints.\n\nPlease create a path before prefetching its map tiles."));
+        return;
+    }
+
+    // From the current zoom down to two levels of detail deeper, over a
+    // corridor wide enough to keep the map usable when flying offset of the path
+    int minZoom = (int)m_map->ZoomTotal();
+    int maxZoom = qMin(minZoom + 2, m_map->MaxZoom());
+
+    QProgressDialog *progress = new QProgressDialog(tr("Prefetching route tiles..."), tr("Cancel"), 0, 100, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setAttribute(Qt::WA_DeleteOnClose);
+
+    // 500 m corridor, capped at 256 KB/s so a shared hotspot stays usable
+    mapcontrol::MapRoutePrefetcher *prefetcher = m_map->PrefetchRoute(route, 500.0, minZoom, maxZoom, 256 * 1024);
+    connect(prefetcher, SIGNAL(percentageChanged(int)), progress, SLOT(setValue(int)));
+    connect(prefetcher, SIGNAL(finished()), progress, SLOT(close()));
+    connect(progress, SIGNAL(canceled()), prefetcher, SLOT(stopFetching()));
+    progress->show();
+}
+
 void OPMapGadgetWidget::onCopyMouseLatLonToClipAct_triggered()
 {
     QClipboard *clipboard = QApplication::clipboard();
@@ -167,6 +167,7 @@ private slots:
      */
     void onReloadAct_triggered();
     void onRipAct_triggered();
+    void onPrefetchRouteAct_triggered();
     void onCopyMouseLatLonToClipAct_triggered();
     void onCopyMouseLatToClipAct_triggered();
     void onCopyMouseLonToClipAct_triggered();
@@ -238,6 +239,7 @@ private:
     bool m_telemetry_connected;
     QAction *reloadAct;
     QAction *ripAct;
+    QAction *prefetchRouteAct;
     QAction *copyMouseLatLonToClipAct;
     QAction *copyMouseLatToClipAct;
     QAction *copyMouseLonToClipAct;
@@ -33,6 +33,8 @@
 
 #include <QDebug>
 
+#include <string.h>
+
 PathCompiler::PathCompiler(QObject *parent) :
     QObject(parent)
 {
@@ -298,7 +300,17 @@ void PathCompiler::doUpdateFromUAV(UAVObject *obj)
         return;
     }
 
-    /* Get all the waypoints from the UAVO and create a representation for the visualization */
+    /* Every cached conversion is relative to home, so a home location */
+    /* change invalidates the whole cache */
+    HomeLocation *homeLocation = HomeLocation::GetInstance(objManager);
+    if (homeLocation && (obj == homeLocation)) {
+        waypointCache.clear();
+    }
+
+    /* Get all the waypoints from the UAVO and create a representation for */
+    /* the visualization.  Only waypoints whose raw data changed are */
+    /* converted again; the rest reuse the cached conversion so dragging */
+    /* one point of a long path stays cheap */
     QList <waypoint> waypoints;
     waypoints.clear();
     int numWaypoints = objManager->getNumInstances(waypointObj->getObjID());
@@ -311,10 +323,25 @@ void PathCompiler::doUpdateFromUAV(UAVObject *obj)
         }
 
         Waypoint::DataFields waypointData = waypoint->getData();
-        waypoints.append(UavoToInternal(waypointData));
+        if ((i < waypointCache.count()) && (i < previousWaypoints.count()) &&
+            (memcmp(&waypointCache[i], &waypointData, sizeof(waypointData)) == 0)) {
+            waypoints.append(previousWaypoints.at(i));
+        } else {
+            if (i < waypointCache.count()) {
+                waypointCache[i] = waypointData;
+            } else {
+                waypointCache.append(waypointData);
+            }
+            waypoints.append(UavoToInternal(waypointData));
+        }
         stopped = waypointData.Action == Waypoint::ACTION_STOP;
     }
 
+    /* Drop cache entries beyond the active part of the list */
+    while (waypointCache.count() > waypoints.count()) {
+        waypointCache.removeLast();
+    }
+
     if (previousWaypoints != waypoints) {
         /* Because the waypoints have to update periodically (or we miss new ones on the FC */
         /* side - needs telem fix) we want to filter updates to map that are simply periodic */
@@ -90,6 +90,10 @@ private:
     Waypoint::DataFields InternalToUavo(waypoint);
 
     QList <waypoint> previousWaypoints;
+
+    // ! Raw UAVO data backing previousWaypoints so unchanged entries can
+    // ! reuse their cached coordinate conversion during recompilation
+    QList <Waypoint::DataFields> waypointCache;
 signals:
     /**
      * Indicates something changed the waypoints and the map should
@@ -91,7 +91,11 @@ void pathPlanner::on_tbReadFromFile_clicked()
     if (!myModel) {
         return;
     }
-    QString fileName = QFileDialog::getOpenFileName(this, tr("Open File"));
+    QString fileName = QFileDialog::getOpenFileName(this, tr("Open File"), QString(),
+                                                    tr("All mission files (*.xml *.opmb);;XML mission (*.xml);;Binary mission (*.opmb)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
     myModel->readFromFile(fileName);
 }
 
@@ -100,7 +104,11 @@ void pathPlanner::on_tbSaveToFile_clicked()
     if (!myModel) {
         return;
     }
-    QString fileName = QFileDialog::getSaveFileName(this, tr("Save File"));
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Save File"), QString(),
+                                                    tr("XML mission (*.xml);;Binary mission (*.opmb)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
     myModel->writeToFile(fileName);
 }
 
@@ -95,11 +95,14 @@ using namespace osgEarth::Annotation;
 #include "utils/homelocationutil.h"
 #include "utils/worldmagmodel.h"
 #include "utils/coordinateconversions.h"
+#include <osgDB/DatabasePager>
+
 #include "attitudestate.h"
 #include "gpspositionsensor.h"
 #include "homelocation.h"
 #include "positionstate.h"
 #include "systemsettings.h"
+#include "velocitystate.h"
 
 using namespace Utils;
 
@@ -135,8 +138,13 @@ OsgViewerWidget::OsgViewerWidget(QWidget *parent) : QWidget(parent)
     layout()->addWidget(viewWidget);
 
 
+    lastNED[0] = lastNED[1] = lastNED[2] = 0;
+    _predictTimer.start();
+
     connect(&_timer, SIGNAL(timeout()), this, SLOT(update()));
-    _timer.start(10);
+    // cap the earth view at ~30 fps, the pager threads need the CPU more
+    // than extra frames and telemetry arrives slower than that anyway
+    _timer.start(33);
 }
 
 OsgViewerWidget::~OsgViewerWidget()
@@ -152,7 +160,15 @@ QWidget *OsgViewerWidget::createViewWidget(osg::Camera *camera, osg::Node *scene
 
     view->setSceneData(scene);
     view->addEventHandler(new osgViewer::StatsHandler);
-    view->getDatabasePager()->setDoPreCompile(true);
+
+    // page terrain on a dedicated thread pool so tile loads never stall the
+    // draw traversal; one of the threads is reserved for remote (http)
+    // sources so local cache hits are not queued behind slow downloads
+    osgDB::DatabasePager *pager = view->getDatabasePager();
+    pager->setDoPreCompile(true);
+    pager->setUpThreads(3, 1);
+    // keep enough expired tiles around that turning back does not reload
+    pager->setTargetMaximumNumberOfPageLOD(150);
 
     manip = new EarthManipulator();
     view->setCameraManipulator(manip);
@@ -260,6 +276,24 @@ void OsgViewerWidget::paintEvent(QPaintEvent *event)
     PositionState::DataFields positionState = positionStateObj->getData();
     double NED[3] = { positionState.North, positionState.East, positionState.Down };
 
+    // Dead reckon between telemetry updates using the velocity estimate.
+    // This keeps the tethered camera moving smoothly instead of jumping at
+    // telemetry rate, and since the camera continuously leads the last
+    // received fix along the velocity vector, the database pager requests
+    // the tiles along the flight path before the aircraft reaches them.
+    if (NED[0] != lastNED[0] || NED[1] != lastNED[1] || NED[2] != lastNED[2]) {
+        lastNED[0] = NED[0];
+        lastNED[1] = NED[1];
+        lastNED[2] = NED[2];
+        _predictTimer.restart();
+    }
+    VelocityState::DataFields velocityState = VelocityState::GetInstance(objMngr)->getData();
+    // don't extrapolate stale data forever when the link drops
+    double dT = qMin(_predictTimer.elapsed() / 1000.0, 0.5);
+    NED[0] += velocityState.North * dT;
+    NED[1] += velocityState.East * dT;
+    NED[2] += velocityState.Down * dT;
+
     bool positionStateUpdate = true;
     if (positionStateUpdate) {
         HomeLocation *homeLocationObj = HomeLocation::GetInstance(objMngr);
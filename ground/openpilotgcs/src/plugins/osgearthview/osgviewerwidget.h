@@ -34,6 +34,7 @@
 #include "uavobject.h"
 
 #include <QTimer>
+#include <QElapsedTimer>
 
 #include <osg/Notify>
 #include <osg/PositionAttitudeTransform>
@@ -105,6 +106,9 @@ protected:
 
 private: /* Private variables */
     QTimer _timer;
+    // dead reckoning of the position between telemetry updates
+    double lastNED[3];
+    QElapsedTimer _predictTimer;
     EarthManipulator *manip;
     osgEarth::Util::ObjectLocatorNode *uavPos;
     osg::MatrixTransform *uavAttitudeAndScale;
@@ -18,6 +18,7 @@
 #include "extensionsystem/pluginmanager.h"
 #include "uavobjectmanager.h"
 #include "uavobject.h"
+#include "uavdataobject.h"
 #include "utils/svgimageprovider.h"
 #ifdef USE_OSG
 #include "osgearth.h"
@@ -87,11 +88,25 @@ PfdQmlGadgetWidget::PfdQmlGadgetWidget(QWindow *parent) :
 
         if (object) {
             engine()->rootContext()->setContextProperty(objectName, object);
+
+            // batch the property notifications: a telemetry update only
+            // schedules a frame and the QML bindings are re-evaluated once
+            // per rendered frame instead of once per update
+            UAVDataObject *dataObject = qobject_cast<UAVDataObject *>(object);
+            if (dataObject) {
+                dataObject->setDeferredNotifications(true);
+                connect(dataObject, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(requestFrameUpdate()));
+                m_exportedObjects.append(dataObject);
+            }
         } else {
             qWarning() << "Failed to load object" << objectName;
         }
     }
 
+    // afterAnimating is emitted on the GUI thread right before the scene
+    // graph is synchronized, so the flushed values are what the frame shows
+    connect(this, SIGNAL(afterAnimating()), this, SLOT(flushUpdates()));
+
     // to expose settings values
     engine()->rootContext()->setContextProperty("qmlWidget", this);
 #ifdef USE_OSG
@@ -100,7 +115,33 @@ PfdQmlGadgetWidget::PfdQmlGadgetWidget(QWindow *parent) :
 }
 
 PfdQmlGadgetWidget::~PfdQmlGadgetWidget()
-{}
+{
+    // drop the deferrals so other consumers get immediate notifications again
+    foreach(UAVDataObject * object, m_exportedObjects) {
+        object->setDeferredNotifications(false);
+    }
+}
+
+/**
+ * A subscribed object changed, make sure a frame gets rendered so the
+ * deferred notifications are flushed and shown.
+ */
+void PfdQmlGadgetWidget::requestFrameUpdate()
+{
+    if (isVisible()) {
+        update();
+    } else {
+        // not rendering, don't hold the updates back from other consumers
+        flushUpdates();
+    }
+}
+
+void PfdQmlGadgetWidget::flushUpdates()
+{
+    foreach(UAVDataObject * object, m_exportedObjects) {
+        object->flushNotifications();
+    }
+}
 
 void PfdQmlGadgetWidget::setQmlFile(QString fn)
 {
@@ -20,6 +20,8 @@
 #include "pfdqmlgadgetconfiguration.h"
 #include <QQuickView>
 
+class UAVDataObject;
+
 class PfdQmlGadgetWidget : public QQuickView {
     Q_OBJECT Q_PROPERTY(QString earthFile READ earthFile WRITE setEarthFile NOTIFY earthFileChanged)
     Q_PROPERTY(bool terrainEnabled READ terrainEnabled WRITE setTerrainEnabled NOTIFY terrainEnabledChanged)
@@ -101,6 +103,10 @@ public slots:
 
     void setActualPositionUsed(bool arg);
 
+private slots:
+    void requestFrameUpdate();
+    void flushUpdates();
+
 signals:
     void earthFileChanged(QString arg);
     void terrainEnabledChanged(bool arg);
@@ -119,6 +125,9 @@ protected:
     void mouseReleaseEvent(QMouseEvent *event);
 
 private:
+    // objects exported to QML, their notifications are batched per frame
+    QList<UAVDataObject *> m_exportedObjects;
+
     QString m_qmlFileName;
     QString m_earthFile;
     bool m_openGLEnabled;
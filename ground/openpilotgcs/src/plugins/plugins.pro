@@ -252,3 +252,10 @@ plugin_flightlog.depends += plugin_uavobjects
 plugin_flightlog.depends += plugin_uavtalk
 SUBDIRS += plugin_flightlog
 
+# Link Statistics plugin
+plugin_linkstats.subdir = linkstats
+plugin_linkstats.depends = plugin_coreplugin
+plugin_linkstats.depends += plugin_uavobjects
+plugin_linkstats.depends += plugin_uavtalk
+SUBDIRS += plugin_linkstats
+
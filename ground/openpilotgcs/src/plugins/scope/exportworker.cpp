@@ -0,0 +1,138 @@
+/**
+ ******************************************************************************
+ *
+ * @file       exportworker.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ScopePlugin Scope Gadget Plugin
+ * @{
+ * @brief The scope Gadget, graphically plots the states of UAVObjects
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "exportworker.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+// Magic and version of the columnar file, bumped when the layout changes
+static const quint32 EXPORT_MAGIC   = 0x4F505343; // "OPSC"
+static const quint32 EXPORT_VERSION = 1;
+
+/**
+ * Export one snapshot of scope history.  The columnar file is written
+ * first (cheap), then the CSV (the bulk of the work); progress covers
+ * both so the dialog moves steadily through a large window.
+ */
+void ExportWorker::exportSnapshot(QString baseName, QStringList plotNames,
+                                  QList<QVector<double> > xColumns, QList<QVector<double> > yColumns)
+{
+    emit exportProgress(0);
+
+    bool success = writeColumnar(baseName + ".opsc", plotNames, xColumns, yColumns)
+                   && writeCsv(baseName + ".csv", plotNames, xColumns, yColumns);
+
+    emit exportProgress(100);
+    emit exportFinished(baseName, success);
+}
+
+/**
+ * Serialize the columns with QDataStream and deflate the result with
+ * qCompress.  Doubles are stored exactly, and an hour of multi-channel
+ * telemetry compresses to a fraction of its CSV size.
+ */
+bool ExportWorker::writeColumnar(const QString &fileName, const QStringList &plotNames,
+                                 const QList<QVector<double> > &xColumns, const QList<QVector<double> > &yColumns)
+{
+    QByteArray raw;
+    QDataStream ds(&raw, QIODevice::WriteOnly);
+
+    ds.setVersion(QDataStream::Qt_4_8);
+    ds << EXPORT_MAGIC << EXPORT_VERSION;
+    ds << plotNames;
+    for (int curve = 0; curve < plotNames.size(); curve++) {
+        ds << xColumns.at(curve);
+        ds << yColumns.at(curve);
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Unable to open" << fileName << "for scope export";
+        return false;
+    }
+    file.write(qCompress(raw));
+    file.close();
+
+    emit exportProgress(10);
+    return true;
+}
+
+/**
+ * Write a plain CSV with one "<name> time","<name> value" column pair per
+ * curve.  The curves do not share timestamps, so short columns are padded
+ * with empty fields instead of resampling the data.
+ */
+bool ExportWorker::writeCsv(const QString &fileName, const QStringList &plotNames,
+                            const QList<QVector<double> > &xColumns, const QList<QVector<double> > &yColumns)
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Unable to open" << fileName << "for scope export";
+        return false;
+    }
+    QTextStream ts(&file);
+    ts.setRealNumberPrecision(10);
+
+    int rows = 0;
+    for (int curve = 0; curve < plotNames.size(); curve++) {
+        if (curve > 0) {
+            ts << ",";
+        }
+        ts << "\"" << plotNames.at(curve) << " time\",\"" << plotNames.at(curve) << " value\"";
+        rows = qMax(rows, xColumns.at(curve).size());
+    }
+    ts << "\n";
+
+    int lastPercent = 10;
+    for (int row = 0; row < rows; row++) {
+        for (int curve = 0; curve < plotNames.size(); curve++) {
+            if (curve > 0) {
+                ts << ",";
+            }
+            if (row < xColumns.at(curve).size()) {
+                ts << xColumns.at(curve).at(row) << "," << yColumns.at(curve).at(row);
+            } else {
+                ts << ",";
+            }
+        }
+        ts << "\n";
+
+        // the columnar file accounted for the first 10 percent
+        int percent = 10 + (90 * (row + 1)) / rows;
+        if (percent != lastPercent) {
+            lastPercent = percent;
+            emit exportProgress(percent);
+        }
+    }
+
+    file.close();
+    return true;
+}
@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ *
+ * @file       exportworker.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ScopePlugin Scope Gadget Plugin
+ * @{
+ * @brief The scope Gadget, graphically plots the states of UAVObjects
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef EXPORTWORKER_H
+#define EXPORTWORKER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+/*!
+   \brief Writes captured scope history to disk off the GUI thread.
+
+   Lives on a worker thread owned by the scope widget, like the FFT worker,
+   so serializing and compressing a long capture window never stalls flight
+   monitoring. The widget snapshots the per-curve sample columns and hands
+   copies over a queued signal, so no locking is needed while writing.
+
+   Two files are produced per export: a compressed columnar file (the
+   deflated serialized columns, exact doubles, small and fast to write) and
+   a plain CSV with one time/value column pair per curve for tools that
+   want text.
+ */
+class ExportWorker : public QObject {
+    Q_OBJECT
+
+public slots:
+    void exportSnapshot(QString baseName, QStringList plotNames,
+                        QList<QVector<double> > xColumns, QList<QVector<double> > yColumns);
+
+signals:
+    /*! Percentage of the export done, for the progress dialog */
+    void exportProgress(int percent);
+    /*! Emitted once per export; fileName is the base name of the written files */
+    void exportFinished(QString baseName, bool success);
+
+private:
+    bool writeColumnar(const QString &fileName, const QStringList &plotNames,
+                       const QList<QVector<double> > &xColumns, const QList<QVector<double> > &yColumns);
+    bool writeCsv(const QString &fileName, const QStringList &plotNames,
+                  const QList<QVector<double> > &xColumns, const QList<QVector<double> > &yColumns);
+};
+
+#endif // EXPORTWORKER_H
@@ -0,0 +1,107 @@
+/**
+ ******************************************************************************
+ *
+ * @file       fftworker.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ScopePlugin Scope Gadget Plugin
+ * @{
+ * @brief The scope Gadget, graphically plots the states of UAVObjects
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "fftworker.h"
+
+#include <math.h>
+
+/**
+ * Compute the single sided amplitude spectrum of the most recent power of two
+ * samples in the window. The mean is removed and a Hann window applied before
+ * an iterative radix-2 transform, so spectral leakage does not smear sharp
+ * vibration peaks and the DC bin does not dominate the plot scale.
+ */
+void FFTWorker::computeSpectrum(QString plotName, QVector<double> samples, double sampleRate)
+{
+    int n = 1;
+
+    while (2 * n <= samples.size()) {
+        n *= 2;
+    }
+    if ((n < 8) || (sampleRate <= 0.0)) {
+        return;
+    }
+    int offset  = samples.size() - n;
+
+    double mean = 0.0;
+    for (int i = 0; i < n; i++) {
+        mean += samples.at(offset + i);
+    }
+    mean /= n;
+
+    QVector<double> re(n);
+    QVector<double> im(n, 0.0);
+    for (int i = 0; i < n; i++) {
+        double window = 0.5 * (1.0 - cos(2.0 * M_PI * i / (n - 1)));
+        re[i] = (samples.at(offset + i) - mean) * window;
+    }
+
+    // bit reversal permutation
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            qSwap(re[i], re[j]);
+        }
+    }
+
+    // iterative radix-2 butterflies
+    for (int len = 2; len <= n; len <<= 1) {
+        double ang = -2.0 * M_PI / len;
+        double wRe = cos(ang);
+        double wIm = sin(ang);
+        for (int i = 0; i < n; i += len) {
+            double curRe = 1.0;
+            double curIm = 0.0;
+            for (int k = 0; k < len / 2; k++) {
+                int a = i + k;
+                int b = i + k + len / 2;
+                double tRe = re[b] * curRe - im[b] * curIm;
+                double tIm = re[b] * curIm + im[b] * curRe;
+                re[b]  = re[a] - tRe;
+                im[b]  = im[a] - tIm;
+                re[a] += tRe;
+                im[a] += tIm;
+                double nextRe = curRe * wRe - curIm * wIm;
+                curIm = curRe * wIm + curIm * wRe;
+                curRe = nextRe;
+            }
+        }
+    }
+
+    // single sided amplitudes; the factor 4 folds the negative frequencies
+    // and compensates the Hann window coherent gain of 0.5
+    QVector<double> magnitudes(n / 2);
+    for (int i = 0; i < n / 2; i++) {
+        magnitudes[i] = 4.0 * sqrt(re.at(i) * re.at(i) + im.at(i) * im.at(i)) / n;
+    }
+
+    emit spectrumComputed(plotName, magnitudes, sampleRate / n);
+}
@@ -0,0 +1,52 @@
+/**
+ ******************************************************************************
+ *
+ * @file       fftworker.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2016.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup ScopePlugin Scope Gadget Plugin
+ * @{
+ * @brief The scope Gadget, graphically plots the states of UAVObjects
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef FFTWORKER_H
+#define FFTWORKER_H
+
+#include <QObject>
+#include <QVector>
+
+/*!
+   \brief Computes amplitude spectra for the scope spectrum plots.
+
+   Lives on a worker thread owned by the scope widget so the transform of a
+   fast logged field (e.g. gyro data at full rate) never stalls the GUI
+   thread. Sample windows arrive and results return through queued signals,
+   both passing copies, so no locking is needed.
+ */
+class FFTWorker : public QObject {
+    Q_OBJECT
+
+public slots:
+    void computeSpectrum(QString plotName, QVector<double> samples, double sampleRate);
+
+signals:
+    void spectrumComputed(QString plotName, QVector<double> magnitudes, double binWidth);
+};
+
+#endif // FFTWORKER_H
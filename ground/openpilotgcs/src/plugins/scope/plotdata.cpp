@@ -27,9 +27,189 @@
 
 
 #include "plotdata.h"
+#include "qwt/src/qwt_plot_directpainter.h"
 #include <math.h>
 #include <QDebug>
 
+// Initial per-curve sample capacity, grown geometrically on demand
+#define RING_INITIAL_CAPACITY 512
+// Lower bound for the decimation target, used when the canvas width is not
+// known yet (curve not attached or widget not laid out)
+#define DECIMATION_MIN_POINTS 250
+
+// Number of samples handed to the FFT worker per transform, and the number of
+// fresh samples required before the window is transformed again (the hop)
+#define SPECTRUM_WINDOW_SIZE  512
+#define SPECTRUM_WINDOW_HOP   (SPECTRUM_WINDOW_SIZE / 8)
+
+PlotRingBuffer::PlotRingBuffer() :
+    m_x(RING_INITIAL_CAPACITY), m_y(RING_INITIAL_CAPACITY), m_start(0), m_count(0)
+{}
+
+void PlotRingBuffer::append(double x, double y)
+{
+    if (m_count == m_x.size()) {
+        grow();
+    }
+    int pos = (m_start + m_count) % m_x.size();
+    m_x[pos] = x;
+    m_y[pos] = y;
+    m_count++;
+}
+
+void PlotRingBuffer::popFront()
+{
+    if (m_count > 0) {
+        m_start = (m_start + 1) % m_x.size();
+        m_count--;
+    }
+}
+
+/**
+ * Copy the stored samples, oldest first, into two plain columns.
+ */
+void PlotRingBuffer::copyColumns(QVector<double> &x, QVector<double> &y) const
+{
+    x.resize(m_count);
+    y.resize(m_count);
+    for (int i = 0; i < m_count; i++) {
+        x[i] = this->x(i);
+        y[i] = this->y(i);
+    }
+}
+
+void PlotRingBuffer::grow()
+{
+    // linearize into a buffer of twice the capacity
+    QVector<double> newX(2 * m_x.size());
+    QVector<double> newY(2 * m_y.size());
+
+    for (int i = 0; i < m_count; i++) {
+        newX[i] = x(i);
+        newY[i] = y(i);
+    }
+    m_x     = newX;
+    m_y     = newY;
+    m_start = 0;
+}
+
+DecimatedRingSeries::DecimatedRingSeries(const PlotRingBuffer *ring) :
+    m_ring(ring), m_indexedX(false), m_passThrough(true)
+{}
+
+/**
+ * Rebuild the snapshot served to the curve, reduced to at most maxPoints
+ * samples with the largest-triangle-three-buckets algorithm: the first and
+ * last samples are kept, the remaining samples are split into equally sized
+ * buckets and the sample forming the largest triangle with the previously
+ * selected sample and the average of the next bucket is kept per bucket.
+ * Peaks survive the reduction, unlike with plain subsampling.
+ */
+void DecimatedRingSeries::decimate(int maxPoints)
+{
+    int n = m_ring->size();
+
+    m_points.clear();
+    if (n == 0) {
+        m_passThrough  = true;
+        d_boundingRect = QRectF(0.0, 0.0, -1.0, -1.0);
+        return;
+    }
+    if ((maxPoints < 3) || (n <= maxPoints)) {
+        // small enough, serve everything
+        m_passThrough = true;
+        m_points.reserve(n);
+        for (int i = 0; i < n; i++) {
+            m_points.append(sourcePoint(i));
+        }
+    } else {
+        m_passThrough = false;
+        m_points.reserve(maxPoints);
+        m_points.append(sourcePoint(0));
+        double bucketSize = (double)(n - 2) / (double)(maxPoints - 2);
+        int selected      = 0;
+        for (int bucket = 0; bucket < maxPoints - 2; bucket++) {
+            int rangeStart = (int)(bucket * bucketSize) + 1;
+            int rangeEnd   = (int)((bucket + 1) * bucketSize) + 1;
+            if (rangeEnd > n - 1) {
+                rangeEnd = n - 1;
+            }
+            // average of the following bucket (the last sample for the final bucket)
+            int nextStart = rangeEnd;
+            int nextEnd   = (int)((bucket + 2) * bucketSize) + 1;
+            if (nextEnd > n) {
+                nextEnd = n;
+            }
+            double avgX = 0.0;
+            double avgY = 0.0;
+            if (nextStart < nextEnd) {
+                for (int i = nextStart; i < nextEnd; i++) {
+                    QPointF point = sourcePoint(i);
+                    avgX += point.x();
+                    avgY += point.y();
+                }
+                avgX /= nextEnd - nextStart;
+                avgY /= nextEnd - nextStart;
+            } else {
+                QPointF point = sourcePoint(n - 1);
+                avgX = point.x();
+                avgY = point.y();
+            }
+            // keep the sample spanning the largest triangle
+            QPointF previous = sourcePoint(selected);
+            double maxArea   = -1.0;
+            int maxIndex     = rangeStart;
+            for (int i = rangeStart; i < rangeEnd; i++) {
+                QPointF point = sourcePoint(i);
+                double area   = fabs((previous.x() - avgX) * (point.y() - previous.y())
+                                     - (previous.x() - point.x()) * (avgY - previous.y()));
+                if (area > maxArea) {
+                    maxArea  = area;
+                    maxIndex = i;
+                }
+            }
+            m_points.append(sourcePoint(maxIndex));
+            selected = maxIndex;
+        }
+        m_points.append(sourcePoint(n - 1));
+    }
+    // cache the bounding rectangle for autoscaling
+    double minX = m_points.first().x();
+    double maxX = minX;
+    double minY = m_points.first().y();
+    double maxY = minY;
+    for (int i = 1; i < m_points.size(); i++) {
+        const QPointF &point = m_points.at(i);
+        minX = qMin(minX, point.x());
+        maxX = qMax(maxX, point.x());
+        minY = qMin(minY, point.y());
+        maxY = qMax(maxY, point.y());
+    }
+    d_boundingRect = QRectF(minX, minY, maxX - minX, maxY - minY);
+}
+
+/**
+ * Append the next not yet served ring buffer sample without re-decimating.
+ * Only valid while the series is a pass-through copy of the ring buffer.
+ * Returns the index of the appended point.
+ */
+int DecimatedRingSeries::appendNext()
+{
+    QPointF point = sourcePoint(m_points.size());
+
+    m_points.append(point);
+    // extend the cached bounding rectangle
+    if (d_boundingRect.width() < 0.0) {
+        d_boundingRect = QRectF(point.x(), point.y(), 0.0, 0.0);
+    } else {
+        d_boundingRect.setLeft(qMin(d_boundingRect.left(), point.x()));
+        d_boundingRect.setRight(qMax(d_boundingRect.right(), point.x()));
+        d_boundingRect.setTop(qMin(d_boundingRect.top(), point.y()));
+        d_boundingRect.setBottom(qMax(d_boundingRect.bottom(), point.y()));
+    }
+    return m_points.size() - 1;
+}
+
 PlotData::PlotData(UAVObject *object, UAVObjectField *field, int element,
                    int scaleOrderFactor, int meanSamples, QString mathFunction,
                    double plotDataSize, QPen pen, bool antialiased) :
@@ -43,7 +223,11 @@ PlotData::PlotData(UAVObject *object, UAVObjectField *field, int element,
         m_elementName = m_field->getElementNames().at(m_element);
     }
 
-    m_plotName.append(QString("%1.%2").arg(m_object->getName()).arg(m_field->getName()));
+    m_plotName.append(QString("%1").arg(m_object->getName()));
+    if (m_object->getInstID() > 0) {
+        m_plotName.append(QString(".%1").arg(m_object->getInstID()));
+    }
+    m_plotName.append(QString(".%1").arg(m_field->getName()));
     if (!m_elementName.isEmpty()) {
         m_plotName.append(QString(".%1").arg(m_elementName));
     }
@@ -62,7 +246,9 @@ PlotData::PlotData(UAVObject *object, UAVObjectField *field, int element,
     }
 
     m_plotCurve->setPen(m_pen);
-    m_plotCurve->setSamples(m_xDataEntries, m_yDataEntries);
+    // the curve takes ownership of the series, the series reads the ring
+    m_plotSeries = new DecimatedRingSeries(&m_dataRing);
+    m_plotCurve->setData(m_plotSeries);
     m_isEnumPlot = m_field->getType() == UAVObjectField::ENUM;
 }
 
@@ -90,13 +276,43 @@ void PlotData::setVisible(bool visible)
 
 void PlotData::updatePlotData()
 {
-    m_plotCurve->setSamples(m_xDataEntries, m_yDataEntries);
+    // decimate to the canvas resolution, more points cannot be told apart
+    int maxPoints = 0;
+
+    if (m_plotCurve->plot() && m_plotCurve->plot()->canvas()) {
+        maxPoints = m_plotCurve->plot()->canvas()->width();
+    }
+    if (maxPoints < DECIMATION_MIN_POINTS) {
+        maxPoints = DECIMATION_MIN_POINTS;
+    }
+    m_plotSeries->decimate(maxPoints);
+}
+
+bool PlotData::canDrawAppended() const
+{
+    return false;
+}
+
+/**
+ * Paint the samples received since the last full replot directly onto the
+ * canvas, without redrawing the rest of the curve.
+ */
+void PlotData::drawAppended(QwtPlotDirectPainter *painter)
+{
+    if (!m_plotCurve->plot() || !m_plotCurve->isVisible()) {
+        return;
+    }
+    while ((int)m_plotSeries->size() < m_dataRing.size()) {
+        int index = m_plotSeries->appendNext();
+        // draw the connecting line from the previous point too
+        painter->drawSeries(m_plotCurve, (index > 0) ? index - 1 : index, index);
+    }
 }
 
 bool PlotData::hasData() const
 {
     if (!m_isEnumPlot) {
-        return !m_xDataEntries.isEmpty();
+        return !m_dataRing.isEmpty();
     } else {
         return !m_enumMarkerList.isEmpty();
     }
@@ -105,7 +321,7 @@ bool PlotData::hasData() const
 QString PlotData::lastDataAsString()
 {
     if (!m_isEnumPlot) {
-        return QString().sprintf("%3.10g", m_yDataEntries.last());
+        return QString().sprintf("%3.10g", m_dataRing.lastY());
     } else {
         return m_enumMarkerList.last()->title().text();
     }
@@ -125,7 +341,7 @@ void PlotData::visibilityChanged(QwtPlotItem *item)
     }
 }
 
-void PlotData::calcMathFunction(double currentValue)
+double PlotData::calcMathFunction(double currentValue)
 {
     // Put the new value at the back
     m_yDataHistory.append(currentValue);
@@ -152,10 +368,9 @@ void PlotData::calcMathFunction(double currentValue)
         for (int i = 0; i < m_yDataHistory.size(); i++) {
             stdSum += pow(m_yDataHistory.at(i) - boxcarAvg, 2) / (m_meanSamples - 1);
         }
-        m_yDataEntries.append(sqrt(stdSum));
-    } else {
-        m_yDataEntries.append(boxcarAvg);
+        return sqrt(stdSum);
     }
+    return boxcarAvg;
 }
 
 QwtPlotMarker *PlotData::createMarker(QString value)
@@ -186,26 +401,22 @@ bool SequentialPlotData::append(UAVObject *obj)
 {
     if (m_object == obj && m_field) {
         if (!m_isEnumPlot) {
-            double currentValue = m_field->getValue(m_element).toDouble() * pow(10, m_scalePower);
+            double currentValue = m_field->getDouble(m_element) * pow(10, m_scalePower);
 
             // Perform scope math, if necessary
             if (m_mathFunction == "Boxcar average" || m_mathFunction == "Standard deviation") {
-                calcMathFunction(currentValue);
-            } else {
-                m_yDataEntries.append(currentValue);
+                currentValue = calcMathFunction(currentValue);
             }
+            m_dataRing.append(m_dataRing.isEmpty() ? 0.0 : m_dataRing.lastX() + 1.0, currentValue);
 
-            if (m_yDataEntries.size() > m_plotDataSize) {
-                // If new data overflows the window, remove old data...
-                m_yDataEntries.pop_front();
-            } else {
-                // ...otherwise, add a new y point at position xData
-                m_xDataEntries.insert(m_xDataEntries.size(), m_xDataEntries.size());
+            // If new data overflows the window, remove old data
+            while (m_dataRing.size() > m_plotDataSize) {
+                m_dataRing.popFront();
             }
             return true;
         } else {
             // Enum markers
-            QString value = m_field->getValue(m_element).toString();
+            QString value = m_field->getOptions().value(m_field->getEnumIndex(m_element));
 
             QwtPlotMarker *marker = m_enumMarkerList.isEmpty() ? NULL : m_enumMarkerList.last();
             if (!marker || marker->title() != value) {
@@ -222,6 +433,16 @@ bool SequentialPlotData::append(UAVObject *obj)
     return false;
 }
 
+bool SequentialPlotData::canDrawAppended() const
+{
+    // Direct painting is only valid while the points already on the canvas
+    // stay where they are: once the window is full the whole curve starts
+    // scrolling, and once decimation has kicked in the series indexes no
+    // longer map onto the ring buffer.
+    return !m_isEnumPlot && m_plotSeries->isPassThrough()
+           && (m_dataRing.size() < m_plotDataSize);
+}
+
 bool ChronoPlotData::append(UAVObject *obj)
 {
     if (m_object == obj && m_field) {
@@ -231,19 +452,17 @@ bool ChronoPlotData::append(UAVObject *obj)
 
         double xValue = NOW.toTime_t() + NOW.time().msec() / 1000.0;
         if (!m_isEnumPlot) {
-            double currentValue = m_field->getValue(m_element).toDouble() * pow(10, m_scalePower);
+            double currentValue = m_field->getDouble(m_element) * pow(10, m_scalePower);
 
             // Perform scope math, if necessary
             if (m_mathFunction == "Boxcar average" || m_mathFunction == "Standard deviation") {
-                calcMathFunction(currentValue);
-            } else {
-                m_yDataEntries.append(currentValue);
+                currentValue = calcMathFunction(currentValue);
             }
 
-            m_xDataEntries.append(xValue);
+            m_dataRing.append(xValue, currentValue);
         } else {
             // Enum markers
-            QString value = m_field->getValue(m_element).toString();
+            QString value = m_field->getOptions().value(m_field->getEnumIndex(m_element));
 
             QwtPlotMarker *marker = m_enumMarkerList.isEmpty() ? NULL : m_enumMarkerList.last();
             if (!marker || marker->title() != value) {
@@ -262,12 +481,66 @@ bool ChronoPlotData::append(UAVObject *obj)
     return false;
 }
 
+bool SpectrumPlotData::append(UAVObject *obj)
+{
+    if (m_object == obj && m_field && !m_isEnumPlot) {
+        double currentValue = m_field->getDouble(m_element) * pow(10, m_scalePower);
+
+        // Perform scope math, if necessary
+        if (m_mathFunction == "Boxcar average" || m_mathFunction == "Standard deviation") {
+            currentValue = calcMathFunction(currentValue);
+        }
+        m_samples.append(currentValue);
+        while (m_samples.size() > SPECTRUM_WINDOW_SIZE) {
+            m_samples.pop_front();
+        }
+        m_newSamples++;
+
+        // Estimate the sample rate from the update arrival times; it sets the
+        // frequency scale of the computed spectrum
+        if (m_rateCount == 0) {
+            m_rateTime.start();
+        }
+        m_rateCount++;
+        int elapsed = m_rateTime.elapsed();
+        if ((elapsed >= 1000) && (m_rateCount > 1)) {
+            m_sampleRate = 1000.0 * (m_rateCount - 1) / elapsed;
+            m_rateTime.restart();
+            m_rateCount = 1;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool SpectrumPlotData::windowReady() const
+{
+    return (m_samples.size() >= SPECTRUM_WINDOW_SIZE)
+           && (m_newSamples >= SPECTRUM_WINDOW_HOP)
+           && (m_sampleRate > 0.0);
+}
+
+QVector<double> SpectrumPlotData::takeWindow()
+{
+    m_newSamples = 0;
+    return m_samples;
+}
+
+void SpectrumPlotData::setSpectrum(const QVector<double> &magnitudes, double binWidth)
+{
+    while (!m_dataRing.isEmpty()) {
+        m_dataRing.popFront();
+    }
+    for (int i = 0; i < magnitudes.size(); i++) {
+        m_dataRing.append(i * binWidth, magnitudes.at(i));
+    }
+}
+
 void ChronoPlotData::removeStaleData()
 {
-    while (!m_xDataEntries.isEmpty() &&
-           (m_xDataEntries.last() - m_xDataEntries.first()) > m_plotDataSize) {
-        m_yDataEntries.pop_front();
-        m_xDataEntries.pop_front();
+    while (!m_dataRing.isEmpty() &&
+           (m_dataRing.lastX() - m_dataRing.firstX()) > m_plotDataSize) {
+        m_dataRing.popFront();
     }
     while (!m_enumMarkerList.isEmpty() &&
            (m_enumMarkerList.last()->xValue() - m_enumMarkerList.first()->xValue()) > m_plotDataSize) {
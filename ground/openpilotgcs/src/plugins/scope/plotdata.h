@@ -35,17 +35,127 @@
 #include "qwt/src/qwt_plot_curve.h"
 #include "qwt/src/qwt_scale_draw.h"
 #include "qwt/src/qwt_scale_widget.h"
+#include "qwt/src/qwt_series_data.h"
 #include <qwt/src/qwt_plot_marker.h>
 
 #include <QTimer>
 #include <QTime>
 #include <QVector>
+#include <QPointF>
 #include <uavdataobject.h>
 
+class QwtPlotDirectPainter;
+
 /*!
    \brief Defines the different type of plots.
  */
-enum PlotType { SequentialPlot, ChronoPlot };
+enum PlotType { SequentialPlot, ChronoPlot, SpectrumPlot };
+
+/*!
+   \brief Fixed-capacity circular sample store for one curve.
+
+   Appends and front removals are O(1) instead of the O(n) shifts a QVector
+   pop_front costs; the capacity grows geometrically when a time based window
+   needs more room.
+ */
+class PlotRingBuffer {
+public:
+    PlotRingBuffer();
+
+    int size() const
+    {
+        return m_count;
+    }
+    bool isEmpty() const
+    {
+        return m_count == 0;
+    }
+    double x(int index) const
+    {
+        return m_x.at(physicalIndex(index));
+    }
+    double y(int index) const
+    {
+        return m_y.at(physicalIndex(index));
+    }
+    double firstX() const
+    {
+        return x(0);
+    }
+    double lastX() const
+    {
+        return x(m_count - 1);
+    }
+    double lastY() const
+    {
+        return y(m_count - 1);
+    }
+    void append(double x, double y);
+    void popFront();
+    void copyColumns(QVector<double> &x, QVector<double> &y) const;
+
+private:
+    int physicalIndex(int index) const
+    {
+        return (m_start + index) % m_x.size();
+    }
+    void grow();
+
+    QVector<double> m_x;
+    QVector<double> m_y;
+    int m_start;
+    int m_count;
+};
+
+/*!
+   \brief Curve samples served to Qwt as a decimated snapshot of a PlotRingBuffer.
+
+   decimate() reduces the stored samples to at most the requested number of
+   points using largest-triangle-three-buckets, so replotting cost is bound by
+   the canvas resolution and not by the window length.
+ */
+class DecimatedRingSeries : public QwtSeriesData<QPointF> {
+public:
+    DecimatedRingSeries(const PlotRingBuffer *ring);
+
+    /*! Sequential plots use the position in the window as x coordinate */
+    void setIndexedX(bool indexedX)
+    {
+        m_indexedX = indexedX;
+    }
+    void decimate(int maxPoints);
+
+    /*! True while the served points map one to one onto the ring buffer */
+    bool isPassThrough() const
+    {
+        return m_passThrough;
+    }
+    int appendNext();
+
+    virtual size_t size() const
+    {
+        return m_points.size();
+    }
+    virtual QPointF sample(size_t i) const
+    {
+        return m_points.at((int)i);
+    }
+    virtual QRectF boundingRect() const
+    {
+        return d_boundingRect;
+    }
+
+private:
+    QPointF sourcePoint(int index) const
+    {
+        return QPointF(m_indexedX ? index : m_ring->x(index), m_ring->y(index));
+    }
+
+    const PlotRingBuffer *m_ring;
+    bool m_indexedX;
+    bool m_passThrough;
+    QVector<QPointF> m_points;
+};
 
 /*!
    \brief Base class that keeps the data for each curve in the plot.
@@ -94,9 +204,20 @@ public:
 
     void updatePlotData();
 
+    /*! True when new points can be painted on top of the current canvas
+       content, without moving what has already been drawn */
+    virtual bool canDrawAppended() const;
+    void drawAppended(QwtPlotDirectPainter *painter);
+
     bool hasData() const;
     QString lastDataAsString();
 
+    /*! Snapshot the sample ring as time and value columns, for export */
+    void copyColumns(QVector<double> &x, QVector<double> &y) const
+    {
+        m_dataRing.copyColumns(x, y);
+    }
+
     void attach(QwtPlot *plot);
 
 public slots:
@@ -112,8 +233,8 @@ protected:
     int m_correctionCount;
     double m_plotDataSize;
 
-    QVector<double> m_xDataEntries;
-    QVector<double> m_yDataEntries;
+    PlotRingBuffer m_dataRing;
+    DecimatedRingSeries *m_plotSeries; // owned by m_plotCurve
     QVector<double> m_yDataHistory;
 
     UAVObject *m_object;
@@ -126,7 +247,7 @@ protected:
     bool m_isVisible;
     QPen m_pen;
     bool m_isEnumPlot;
-    virtual void calcMathFunction(double currentValue);
+    virtual double calcMathFunction(double currentValue);
     QwtPlotMarker *createMarker(QString value);
 };
 
@@ -141,7 +262,10 @@ public:
                        int scaleFactor, int meanSamples, QString mathFunction,
                        double plotDataSize, QPen pen, bool antialiased)
         : PlotData(object, field, element, scaleFactor, meanSamples,
-                   mathFunction, plotDataSize, pen, antialiased) {}
+                   mathFunction, plotDataSize, pen, antialiased)
+    {
+        m_plotSeries->setIndexedX(true);
+    }
     ~SequentialPlotData() {}
 
     bool append(UAVObject *obj);
@@ -150,6 +274,7 @@ public:
         return SequentialPlot;
     }
     void removeStaleData() {}
+    bool canDrawAppended() const;
 };
 
 /*!
@@ -174,4 +299,49 @@ public:
     void removeStaleData();
 };
 
+/*!
+   \brief The spectrum plot shows the frequency content of a field instead of its
+   time history. Samples collect in a rolling window; once enough new samples
+   arrived the window is handed to the FFT worker thread, and the resulting
+   magnitudes replace the curve data with frequency on the x axis.
+ */
+class SpectrumPlotData : public PlotData {
+    Q_OBJECT
+public:
+    SpectrumPlotData(UAVObject *object, UAVObjectField *field, int element,
+                     int scaleFactor, int meanSamples, QString mathFunction,
+                     double plotDataSize, QPen pen, bool antialiased)
+        : PlotData(object, field, element, scaleFactor, meanSamples,
+                   mathFunction, plotDataSize, pen, antialiased),
+        m_sampleRate(0.0), m_rateCount(0), m_newSamples(0)
+    {}
+    ~SpectrumPlotData() {}
+
+    bool append(UAVObject *obj);
+    PlotType plotType() const
+    {
+        return SpectrumPlot;
+    }
+    void removeStaleData() {}
+
+    /*! True once the window holds enough fresh samples for the next transform */
+    bool windowReady() const;
+    /*! Hand out the current window and reset the fresh sample count */
+    QVector<double> takeWindow();
+    double sampleRate() const
+    {
+        return m_sampleRate;
+    }
+    /*! Replace the curve data with the magnitudes computed by the FFT worker */
+    void setSpectrum(const QVector<double> &magnitudes, double binWidth);
+
+private:
+    QVector<double> m_samples;
+    // sample rate estimated from the arrival times of the updates
+    double m_sampleRate;
+    QTime m_rateTime;
+    int m_rateCount;
+    int m_newSamples;
+};
+
 #endif // PLOTDATA_H
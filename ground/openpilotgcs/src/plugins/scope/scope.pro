@@ -1,6 +1,8 @@
 TEMPLATE = lib
 TARGET = ScopeGadget
 
+QT += opengl
+
 DEFINES += SCOPE_LIBRARY
 
 include(../../openpilotgcsplugin.pri)
@@ -9,6 +11,8 @@ include (scope_dependencies.pri)
 HEADERS += \
     scopeplugin.h \
     plotdata.h \
+    fftworker.h \
+    exportworker.h \
     scope_global.h \
     scopegadgetoptionspage.h \
     scopegadgetconfiguration.h \
@@ -19,6 +23,8 @@ HEADERS += \
 SOURCES += \
     scopeplugin.cpp \
     plotdata.cpp \
+    fftworker.cpp \
+    exportworker.cpp \
     scopegadgetoptionspage.cpp \
     scopegadgetconfiguration.cpp \
     scopegadget.cpp \
@@ -49,11 +49,14 @@ void ScopeGadget::loadConfiguration(IUAVGadgetConfiguration *config)
 
     widget->setPlotDataSize(sgConfig->dataSize());
     widget->setRefreshInterval(sgConfig->refreshInterval());
+    widget->setUseOpenGLCanvas(sgConfig->useOpenGLCanvas());
 
     if (sgConfig->plotType() == SequentialPlot) {
         widget->setupSequentialPlot();
     } else if (sgConfig->plotType() == ChronoPlot) {
         widget->setupChronoPlot();
+    } else if (sgConfig->plotType() == SpectrumPlot) {
+        widget->setupSpectrumPlot();
     }
 
     foreach(PlotCurveConfiguration * plotCurveConfig, sgConfig->plotCurveConfigs()) {
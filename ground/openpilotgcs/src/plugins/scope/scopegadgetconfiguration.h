@@ -71,6 +71,10 @@ public:
     {
         m_refreshInterval = value;
     }
+    void setUseOpenGLCanvas(bool value)
+    {
+        m_useOpenGLCanvas = value;
+    }
     void addPlotCurveConfig(PlotCurveConfiguration *value)
     {
         m_plotCurveConfigs.append(value);
@@ -94,6 +98,10 @@ public:
     {
         return m_refreshInterval;
     }
+    bool useOpenGLCanvas()
+    {
+        return m_useOpenGLCanvas;
+    }
     QList<PlotCurveConfiguration *> plotCurveConfigs()
     {
         return m_plotCurveConfigs;
@@ -137,6 +145,8 @@ private:
     int m_dataSize;
     // The interval to replot the curve widget. The data buffer is refresh as the data comes in.
     int m_refreshInterval;
+    // Whether to render the plot on an OpenGL canvas
+    bool m_useOpenGLCanvas;
     // The type of math function to be used in the scope analysis
     int m_mathFunctionType;
     QList<PlotCurveConfiguration *> m_plotCurveConfigs;
@@ -55,6 +55,7 @@ QWidget *ScopeGadgetOptionsPage::createPage(QWidget *parent)
 
     options_page->cmbPlotType->addItem("Sequential Plot", "");
     options_page->cmbPlotType->addItem("Chronological Plot", "");
+    options_page->cmbPlotType->addItem("Spectrum Plot", "");
 
     // Fills the combo boxes for the UAVObjects
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
@@ -65,6 +66,10 @@ QWidget *ScopeGadgetOptionsPage::createPage(QWidget *parent)
             options_page->cmbUAVObjects->addItem(obj->getName());
         }
     }
+    // Allow "ObjectName.instance" to be typed for multi instance objects
+    options_page->cmbUAVObjects->setEditable(true);
+    options_page->cmbUAVObjects->setInsertPolicy(QComboBox::NoInsert);
+    connect(options_page->cmbUAVObjects, SIGNAL(editTextChanged(QString)), this, SLOT(on_cmbUAVObjects_currentIndexChanged(QString)));
 
     // Connect signals to slots cmbUAVObjects.currentIndexChanged
     connect(options_page->cmbUAVObjects, SIGNAL(currentIndexChanged(QString)), this, SLOT(on_cmbUAVObjects_currentIndexChanged(QString)));
@@ -100,6 +105,7 @@ QWidget *ScopeGadgetOptionsPage::createPage(QWidget *parent)
     options_page->mathFunctionComboBox->setCurrentIndex(m_config->mathFunctionType());
     options_page->spnDataSize->setValue(m_config->dataSize());
     options_page->spnRefreshInterval->setValue(m_config->refreshInterval());
+    options_page->chkUseOpenGL->setChecked(m_config->useOpenGLCanvas());
 
     // add the configured curves
     foreach(PlotCurveConfiguration * plotData, m_config->plotCurveConfigs()) {
@@ -237,9 +243,15 @@ void ScopeGadgetOptionsPage::on_cmbUAVObjects_currentIndexChanged(QString val)
 {
     options_page->cmbUAVField->clear();
 
+    if (val.isEmpty()) {
+        return;
+    }
+    // Strip an optional ".instance" suffix, the field list is the same for all instances
+    QString objectName = val.split(".", QString::SkipEmptyParts).at(0);
+
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
-    UAVDataObject *obj = dynamic_cast<UAVDataObject *>(objManager->getObject(val));
+    UAVDataObject *obj = dynamic_cast<UAVDataObject *>(objManager->getObject(objectName));
 
     if (obj == NULL) {
         return; // Rare case: the config contained a UAVObject name which does not exist anymore.
@@ -275,6 +287,7 @@ void ScopeGadgetOptionsPage::apply()
     m_config->setMathFunctionType(options_page->mathFunctionComboBox->currentIndex());
     m_config->setDataSize(options_page->spnDataSize->value());
     m_config->setRefreashInterval(options_page->spnRefreshInterval->value());
+    m_config->setUseOpenGLCanvas(options_page->chkUseOpenGL->isChecked());
 
     QList<PlotCurveConfiguration *> plotCurveConfigs;
     for (int iIndex = 0; iIndex < options_page->lstCurves->count(); iIndex++) {
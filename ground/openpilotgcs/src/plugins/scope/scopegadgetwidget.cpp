@@ -26,6 +26,8 @@
  */
 
 #include "scopegadgetwidget.h"
+#include "exportworker.h"
+#include "fftworker.h"
 #include "utils/stylehelper.h"
 
 #include "extensionsystem/pluginmanager.h"
@@ -48,12 +50,97 @@
 #include <QPushButton>
 #include <QMutexLocker>
 #include <QWheelEvent>
+#include <QPainter>
+#include <QMenu>
+#include <QFileDialog>
+#include <QProgressDialog>
+#include <QContextMenuEvent>
+#include <string.h>
 
 #include <qwt/src/qwt_legend_label.h>
 #include <qwt/src/qwt_plot_canvas.h>
+#include <qwt/src/qwt_plot_directpainter.h>
+#include <qwt/src/qwt_plot_glcanvas.h>
 #include <qwt/src/qwt_plot_layout.h>
+#include <qwt/src/qwt_scale_map.h>
+
+// Number of past spectra kept in the waterfall, and the share of the canvas
+// height the waterfall covers below the live spectrum curves
+#define WATERFALL_HISTORY_ROWS    64
+#define WATERFALL_HEIGHT_FRACTION 3
+
+SpectrumWaterfallItem::SpectrumWaterfallItem() : m_maxFrequency(0.0)
+{
+    // the waterfall image must not influence the axis autoscaling
+    setItemAttribute(QwtPlotItem::AutoScale, false);
+    // stay below the grid and the curves
+    setZ(1.0);
+}
+
+/**
+ * Push the newest spectrum on top of the waterfall, scrolling the older rows
+ * down. Magnitudes are mapped to colors on a logarithmic scale relative to
+ * the row peak, which keeps weak harmonics visible next to a dominant peak.
+ */
+void SpectrumWaterfallItem::addRow(const QVector<double> &magnitudes, double maxFrequency)
+{
+    if (magnitudes.isEmpty()) {
+        return;
+    }
+    if (m_history.width() != magnitudes.size()) {
+        m_history = QImage(magnitudes.size(), WATERFALL_HISTORY_ROWS, QImage::Format_RGB32);
+        m_history.fill(Qt::black);
+    }
+    memmove(m_history.scanLine(1), m_history.scanLine(0),
+            (WATERFALL_HISTORY_ROWS - 1) * m_history.bytesPerLine());
+
+    double peak = 0.0;
+    for (int i = 0; i < magnitudes.size(); i++) {
+        peak = qMax(peak, magnitudes.at(i));
+    }
+    QRgb *row = (QRgb *)m_history.scanLine(0);
+    for (int i = 0; i < magnitudes.size(); i++) {
+        double db = (peak > 0.0 && magnitudes.at(i) > 0.0)
+                    ? 20.0 * log10(magnitudes.at(i) / peak) : -60.0;
+        // map -60dB..0dB relative to the row peak onto the color ramp
+        row[i] = heatColor(1.0 + db / 60.0);
+    }
+    m_maxFrequency = maxFrequency;
+    itemChanged();
+}
+
+QRgb SpectrumWaterfallItem::heatColor(double value)
+{
+    value = qBound(0.0, value, 1.0);
+    // black - blue - yellow - white ramp
+    if (value < 0.4) {
+        return qRgb(0, 0, (int)(value / 0.4 * 255));
+    }
+    if (value < 0.8) {
+        double t = (value - 0.4) / 0.4;
+        return qRgb((int)(t * 255), (int)(t * 255), (int)((1.0 - t) * 255));
+    }
+    return qRgb(255, 255, (int)((value - 0.8) / 0.2 * 255));
+}
+
+void SpectrumWaterfallItem::draw(QPainter *painter, const QwtScaleMap &xMap,
+                                 const QwtScaleMap &yMap, const QRectF &canvasRect) const
+{
+    Q_UNUSED(yMap);
+    if (m_history.isNull() || (m_maxFrequency <= 0.0)) {
+        return;
+    }
+    // share the frequency axis with the curves, occupy the lower canvas part
+    QRectF target(QPointF(xMap.transform(0.0),
+                          canvasRect.bottom() - canvasRect.height() / WATERFALL_HEIGHT_FRACTION),
+                  QPointF(xMap.transform(m_maxFrequency), canvasRect.bottom()));
+
+    painter->drawImage(target, m_history);
+}
 
 ScopeGadgetWidget::ScopeGadgetWidget(QWidget *parent) : QwtPlot(parent),
+    m_fftWorker(NULL), m_waterfallItem(NULL),
+    m_exportWorker(NULL), m_exportProgressDialog(NULL),
     m_csvLoggingStarted(false), m_csvLoggingEnabled(false),
     m_csvLoggingHeaderSaved(false), m_csvLoggingDataSaved(false),
     m_csvLoggingNameSet(false), m_csvLoggingDataValid(false),
@@ -65,6 +152,8 @@ ScopeGadgetWidget::ScopeGadgetWidget(QWidget *parent) : QwtPlot(parent),
 {
     setMouseTracking(true);
 
+    m_useOpenGLCanvas = false;
+
     QwtPlotCanvas *plotCanvas = dynamic_cast<QwtPlotCanvas *>(canvas());
     if (plotCanvas) {
         plotCanvas->setFrameStyle(QFrame::StyledPanel | QFrame::Sunken);
@@ -74,6 +163,10 @@ ScopeGadgetWidget::ScopeGadgetWidget(QWidget *parent) : QwtPlot(parent),
     axisWidget(QwtPlot::yLeft)->setMargin(2);
     axisWidget(QwtPlot::xBottom)->setMargin(2);
 
+    // Used to paint new points between full replots
+    m_directPainter = new QwtPlotDirectPainter(this);
+    m_lastFullReplot.start();
+
     // Setup the timer that replots data
     replotTimer = new QTimer(this);
     connect(replotTimer, SIGNAL(timeout()), this, SLOT(replotNewData()));
@@ -107,6 +200,18 @@ ScopeGadgetWidget::~ScopeGadgetWidget()
         disconnect(obj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(uavObjectReceived(UAVObject *)));
     }
 
+    if (m_fftWorker) {
+        // the worker is deleted by the finished() signal
+        m_fftThread.quit();
+        m_fftThread.wait();
+    }
+
+    if (m_exportWorker) {
+        // the worker is deleted by the finished() signal
+        m_exportThread.quit();
+        m_exportThread.wait();
+    }
+
     clearCurvePlots();
 }
 
@@ -181,6 +286,96 @@ void ScopeGadgetWidget::showEvent(QShowEvent *e)
     QwtPlot::showEvent(e);
 }
 
+void ScopeGadgetWidget::contextMenuEvent(QContextMenuEvent *e)
+{
+    QMenu menu;
+    QAction *exportAction = menu.addAction(tr("Export captured data..."));
+
+    exportAction->setEnabled(!m_curvesData.isEmpty());
+    if (menu.exec(e->globalPos()) == exportAction) {
+        exportHistory();
+    }
+}
+
+/**
+ * Snapshot the captured history of all curves and hand it to the export
+ * worker.  Only the snapshot is taken on the GUI thread; serializing and
+ * compressing a long window happens on the worker so flight monitoring
+ * does not pause.
+ */
+void ScopeGadgetWidget::exportHistory()
+{
+    if (m_curvesData.isEmpty()) {
+        return;
+    }
+
+    QString baseName = QFileDialog::getSaveFileName(this, tr("Export scope data"),
+                                                    m_csvLoggingPath, tr("Scope export (*.csv *.opsc)"));
+    if (baseName.isEmpty()) {
+        return;
+    }
+    // both files get their own suffix
+    if (baseName.endsWith(".csv") || baseName.endsWith(".opsc")) {
+        baseName.truncate(baseName.lastIndexOf('.'));
+    }
+
+    QStringList plotNames;
+    QList<QVector<double> > xColumns;
+    QList<QVector<double> > yColumns;
+    m_mutex.lock();
+    foreach(PlotData * plotData, m_curvesData.values()) {
+        QVector<double> x;
+        QVector<double> y;
+
+        plotData->copyColumns(x, y);
+        plotNames.append(plotData->plotName());
+        xColumns.append(x);
+        yColumns.append(y);
+    }
+    m_mutex.unlock();
+
+    if (!m_exportWorker) {
+        qRegisterMetaType<QList<QVector<double> > >("QList<QVector<double> >");
+        m_exportWorker = new ExportWorker();
+        m_exportWorker->moveToThread(&m_exportThread);
+        connect(&m_exportThread, SIGNAL(finished()), m_exportWorker, SLOT(deleteLater()));
+        connect(this, SIGNAL(exportRequested(QString, QStringList, QList<QVector<double> >, QList<QVector<double> >)),
+                m_exportWorker, SLOT(exportSnapshot(QString, QStringList, QList<QVector<double> >, QList<QVector<double> >)));
+        connect(m_exportWorker, SIGNAL(exportProgress(int)), this, SLOT(exportProgressed(int)));
+        connect(m_exportWorker, SIGNAL(exportFinished(QString, bool)), this, SLOT(exportCompleted(QString, bool)));
+        m_exportThread.start();
+    }
+
+    if (!m_exportProgressDialog) {
+        // no cancel button: the worker writes the snapshot through once
+        m_exportProgressDialog = new QProgressDialog(tr("Exporting scope data..."), QString(), 0, 100, this);
+        m_exportProgressDialog->setWindowModality(Qt::NonModal);
+        m_exportProgressDialog->setAutoClose(false);
+        m_exportProgressDialog->setAutoReset(false);
+    }
+    m_exportProgressDialog->setValue(0);
+    m_exportProgressDialog->show();
+
+    emit exportRequested(baseName, plotNames, xColumns, yColumns);
+}
+
+void ScopeGadgetWidget::exportProgressed(int percent)
+{
+    if (m_exportProgressDialog) {
+        m_exportProgressDialog->setValue(percent);
+    }
+}
+
+void ScopeGadgetWidget::exportCompleted(QString baseName, bool success)
+{
+    if (m_exportProgressDialog) {
+        m_exportProgressDialog->hide();
+    }
+    if (!success) {
+        qDebug() << "Scope export to" << baseName << "failed";
+    }
+}
+
 /**
  * Starts/stops telemetry
  */
@@ -246,6 +441,29 @@ void ScopeGadgetWidget::preparePlot(PlotType plotType)
 
     clearCurvePlots();
 
+    if (m_waterfallItem && (plotType != SpectrumPlot)) {
+        m_waterfallItem->detach();
+        delete m_waterfallItem;
+        m_waterfallItem = NULL;
+    }
+
+    // Switch between the raster and the OpenGL canvas when the configuration
+    // asks for it, setCanvas deletes the previous canvas
+    bool glCanvasActive = qobject_cast<QwtPlotGLCanvas *>(canvas()) != NULL;
+    if (m_useOpenGLCanvas != glCanvasActive) {
+        m_directPainter->reset();
+        if (m_useOpenGLCanvas) {
+            QwtPlotGLCanvas *glCanvas = new QwtPlotGLCanvas();
+            glCanvas->setFrameStyle(QFrame::StyledPanel | QFrame::Sunken);
+            setCanvas(glCanvas);
+        } else {
+            QwtPlotCanvas *plotCanvas = new QwtPlotCanvas();
+            plotCanvas->setFrameStyle(QFrame::StyledPanel | QFrame::Sunken);
+            plotCanvas->setBorderRadius(8);
+            setCanvas(plotCanvas);
+        }
+    }
+
     setMinimumSize(64, 64);
     setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::MinimumExpanding);
 
@@ -318,6 +536,40 @@ void ScopeGadgetWidget::setupChronoPlot()
     setAxisFont(QwtPlot::yLeft, fnt); // y-axis
 }
 
+void ScopeGadgetWidget::setupSpectrumPlot()
+{
+    preparePlot(SpectrumPlot);
+
+    setAxisScaleDraw(QwtPlot::xBottom, new QwtScaleDraw());
+    setAxisTitle(QwtPlot::xBottom, "Hz");
+    setAxisAutoScale(QwtPlot::xBottom, true);
+    setAxisLabelRotation(QwtPlot::xBottom, 0.0);
+    setAxisLabelAlignment(QwtPlot::xBottom, Qt::AlignLeft | Qt::AlignBottom);
+
+    // reduce the axis font size
+    QFont fnt(axisFont(QwtPlot::xBottom));
+    fnt.setPointSize(7);
+    setAxisFont(QwtPlot::xBottom, fnt); // x-axis
+    setAxisFont(QwtPlot::yLeft, fnt); // y-axis
+
+    if (!m_waterfallItem) {
+        m_waterfallItem = new SpectrumWaterfallItem();
+        m_waterfallItem->attach(this);
+    }
+
+    if (!m_fftWorker) {
+        qRegisterMetaType<QVector<double> >("QVector<double>");
+        m_fftWorker = new FFTWorker();
+        m_fftWorker->moveToThread(&m_fftThread);
+        connect(&m_fftThread, SIGNAL(finished()), m_fftWorker, SLOT(deleteLater()));
+        connect(this, SIGNAL(spectrumRequested(QString, QVector<double>, double)),
+                m_fftWorker, SLOT(computeSpectrum(QString, QVector<double>, double)));
+        connect(m_fftWorker, SIGNAL(spectrumComputed(QString, QVector<double>, double)),
+                this, SLOT(spectrumComputed(QString, QVector<double>, double)));
+        m_fftThread.start();
+    }
+}
+
 void ScopeGadgetWidget::addCurvePlot(QString objectName, QString fieldPlusSubField, int scaleFactor,
                                      int meanSamples, QString mathFunction, QPen pen, bool antialiased)
 {
@@ -331,10 +583,20 @@ void ScopeGadgetWidget::addCurvePlot(QString objectName, QString fieldPlusSubFie
         elementName = fieldSubfield.at(1);
     }
 
+    // A multi instance object may carry the instance id appended to its name
+    // (e.g. "PerfCounter.1"), instance 0 is used when there is no suffix
+    QString baseObjectName = objectName;
+    quint32 instId = 0;
+    if (objectName.contains(".")) {
+        QStringList objectInstance = objectName.split(".", QString::SkipEmptyParts);
+        baseObjectName = objectInstance.at(0);
+        instId = objectInstance.at(1).toUInt();
+    }
+
     // Get the uav object
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
-    UAVDataObject *object = dynamic_cast<UAVDataObject *>(objManager->getObject(objectName));
+    UAVDataObject *object = dynamic_cast<UAVDataObject *>(objManager->getObject(baseObjectName, instId));
     if (!object) {
         qDebug() << "Object" << objectName << "is missing";
         return;
@@ -366,6 +628,10 @@ void ScopeGadgetWidget::addCurvePlot(QString objectName, QString fieldPlusSubFie
         plotData = new ChronoPlotData(object, field, element, scaleFactor,
                                       meanSamples, mathFunction, m_plotDataSize,
                                       pen, antialiased);
+    } else {
+        plotData = new SpectrumPlotData(object, field, element, scaleFactor,
+                                        meanSamples, mathFunction, m_plotDataSize,
+                                        pen, antialiased);
     }
     connect(this, SIGNAL(visibilityChanged(QwtPlotItem *)), plotData, SLOT(visibilityChanged(QwtPlotItem *)));
     plotData->attach(this);
@@ -377,9 +643,9 @@ void ScopeGadgetWidget::addCurvePlot(QString objectName, QString fieldPlusSubFie
     // Keep the curve details for later
     m_curvesData.insert(plotData->plotName(), plotData);
 
-    // Link to the new signal data only if this UAVObject has not been connected yet
-    if (!m_connectedUAVObjects.contains(object->getName())) {
-        m_connectedUAVObjects.append(object->getName());
+    // Link to the new signal data only if this UAVObject instance has not been connected yet
+    if (!m_connectedUAVObjects.contains(objectName)) {
+        m_connectedUAVObjects.append(objectName);
         connect(object, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(uavObjectReceived(UAVObject *)));
     }
 
@@ -405,11 +671,51 @@ void ScopeGadgetWidget::replotNewData()
     }
 
     QMutexLocker locker(&m_mutex);
+
+    // Between full replots new points are painted directly onto the canvas,
+    // which avoids redrawing every curve at high refresh rates. Full replots
+    // still happen periodically to rescale the axes, and whenever a curve
+    // cannot extend its drawn data in place. Direct painting needs the
+    // backing store of the raster canvas, with the OpenGL canvas every
+    // frame is a full redraw anyway.
+    bool incremental = !m_curvesData.isEmpty() &&
+                       (qobject_cast<QwtPlotCanvas *>(canvas()) != NULL) &&
+                       (m_lastFullReplot.elapsed() < FULL_REPLOT_INTERVAL_MS);
+    foreach(PlotData * plotData, m_curvesData.values()) {
+        if (!plotData->canDrawAppended()) {
+            incremental = false;
+            break;
+        }
+    }
+
+    if (incremental) {
+        foreach(PlotData * plotData, m_curvesData.values()) {
+            plotData->drawAppended(m_directPainter);
+        }
+        csvLoggingInsertData();
+        return;
+    }
+
     foreach(PlotData * plotData, m_curvesData.values()) {
         plotData->removeStaleData();
         plotData->updatePlotData();
     }
 
+    // Hand complete sample windows to the FFT worker, at most one transform
+    // in flight per curve; results come back through spectrumComputed()
+    if (m_plotType == SpectrumPlot) {
+        foreach(PlotData * plotData, m_curvesData.values()) {
+            SpectrumPlotData *spectrumData = qobject_cast<SpectrumPlotData *>(plotData);
+
+            if (spectrumData && spectrumData->windowReady()
+                && !m_fftInFlight.contains(spectrumData->plotName())) {
+                m_fftInFlight.insert(spectrumData->plotName());
+                emit spectrumRequested(spectrumData->plotName(), spectrumData->takeWindow(),
+                                       spectrumData->sampleRate());
+            }
+        }
+    }
+
     QDateTime NOW = QDateTime::currentDateTime();
     double toTime = NOW.toTime_t();
     toTime += NOW.time().msec() / 1000.0;
@@ -420,6 +726,28 @@ void ScopeGadgetWidget::replotNewData()
     csvLoggingInsertData();
 
     replot();
+    m_lastFullReplot.restart();
+}
+
+/**
+ * Receives the magnitudes computed by the FFT worker and swaps them into the
+ * curve; the waterfall tracks the first configured curve. Queued from the
+ * worker thread, so this runs on the GUI thread.
+ */
+void ScopeGadgetWidget::spectrumComputed(QString plotName, QVector<double> magnitudes, double binWidth)
+{
+    m_fftInFlight.remove(plotName);
+
+    SpectrumPlotData *spectrumData = qobject_cast<SpectrumPlotData *>(m_curvesData.value(plotName, NULL));
+    if (!spectrumData || (m_plotType != SpectrumPlot)) {
+        return;
+    }
+    spectrumData->setSpectrum(magnitudes, binWidth);
+
+    if (m_waterfallItem && (m_curvesData.values().first() == spectrumData)) {
+        m_waterfallItem->addRow(magnitudes, binWidth * (magnitudes.size() - 1));
+    }
+    // the new spectrum is picked up by the next replotNewData tick
 }
 
 void ScopeGadgetWidget::clearCurvePlots()
@@ -429,6 +757,7 @@ void ScopeGadgetWidget::clearCurvePlots()
     }
 
     m_curvesData.clear();
+    m_fftInFlight.clear();
 }
 
 void ScopeGadgetWidget::saveState(QSettings *qSettings)
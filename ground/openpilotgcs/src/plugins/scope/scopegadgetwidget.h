@@ -41,8 +41,15 @@
 #include <QTime>
 #include <QVector>
 #include <QMutex>
+#include <QThread>
+#include <QSet>
+#include <QImage>
 
 class QSettings;
+class QwtPlotDirectPainter;
+class FFTWorker;
+class ExportWorker;
+class QProgressDialog;
 
 /*!
    \brief This class is used to render the time values on the horizontal axis for the
@@ -62,6 +69,28 @@ public:
     }
 };
 
+/*!
+   \brief Scrolling waterfall drawn below the spectrum curves.
+
+   Keeps the recent spectra as rows of an image, newest on top, and paints it
+   into the lower part of the canvas with the same frequency axis as the
+   curves, so peaks can be matched against their history at a glance.
+ */
+class SpectrumWaterfallItem : public QwtPlotItem {
+public:
+    SpectrumWaterfallItem();
+
+    void addRow(const QVector<double> &magnitudes, double maxFrequency);
+    virtual void draw(QPainter *painter, const QwtScaleMap &xMap,
+                      const QwtScaleMap &yMap, const QRectF &canvasRect) const;
+
+private:
+    static QRgb heatColor(double value);
+
+    QImage m_history;
+    double m_maxFrequency;
+};
+
 class ScopeGadgetWidget : public QwtPlot {
     Q_OBJECT
 
@@ -71,6 +100,7 @@ public:
 
     void setupSequentialPlot();
     void setupChronoPlot();
+    void setupSpectrumPlot();
     void setupUAVObjectPlot();
     PlotType plotType()
     {
@@ -93,6 +123,11 @@ public:
     {
         return m_refreshInterval;
     }
+    // Takes effect on the next setupSequentialPlot/setupChronoPlot call
+    void setUseOpenGLCanvas(bool value)
+    {
+        m_useOpenGLCanvas = value;
+    }
 
 
     void addCurvePlot(QString uavObject, QString uavFieldSubField, int scaleOrderFactor = 0, int meanSamples = 1,
@@ -106,6 +141,9 @@ public:
     int csvLoggingStop();
     void csvLoggingSetName(QString);
 
+    // Snapshot the captured history and write it on the export thread
+    void exportHistory();
+
     void setLoggingEnabled(bool value)
     {
         m_csvLoggingEnabled = value;
@@ -120,6 +158,9 @@ public:
     }
 signals:
     void visibilityChanged(QwtPlotItem *item);
+    void spectrumRequested(QString plotName, QVector<double> samples, double sampleRate);
+    void exportRequested(QString baseName, QStringList plotNames,
+                         QList<QVector<double> > xColumns, QList<QVector<double> > yColumns);
 
 protected:
     void mousePressEvent(QMouseEvent *e);
@@ -128,18 +169,26 @@ protected:
     void mouseMoveEvent(QMouseEvent *e);
     void wheelEvent(QWheelEvent *e);
     void showEvent(QShowEvent *e);
+    void contextMenuEvent(QContextMenuEvent *e);
 
 private slots:
     void uavObjectReceived(UAVObject *);
     void replotNewData();
     void showCurve(QVariant itemInfo, bool visible, int index);
+    void spectrumComputed(QString plotName, QVector<double> magnitudes, double binWidth);
     void startPlotting();
     void stopPlotting();
     void csvLoggingConnect();
     void csvLoggingDisconnect();
+    void exportProgressed(int percent);
+    void exportCompleted(QString baseName, bool success);
 
 private:
 
+    // Interval between full replots, which rescale the axes and redraw all
+    // curves; in between only newly received points are painted
+    static const int FULL_REPLOT_INTERVAL_MS = 1000;
+
     void preparePlot(PlotType plotType);
     void setupExamplePlot();
 
@@ -147,10 +196,26 @@ private:
 
     double m_plotDataSize;
     int m_refreshInterval;
+    bool m_useOpenGLCanvas;
     QList<QString> m_connectedUAVObjects;
     QMap<QString, PlotData *> m_curvesData;
 
     QTimer *replotTimer;
+    QwtPlotDirectPainter *m_directPainter;
+    QTime m_lastFullReplot;
+
+    // FFT computation for the spectrum plot runs on a worker thread, created
+    // on the first setupSpectrumPlot call
+    QThread m_fftThread;
+    FFTWorker *m_fftWorker;
+    QSet<QString> m_fftInFlight;
+    SpectrumWaterfallItem *m_waterfallItem;
+
+    // History export runs on its own worker thread, created on the first
+    // export so gadgets that never export pay nothing
+    QThread m_exportThread;
+    ExportWorker *m_exportWorker;
+    QProgressDialog *m_exportProgressDialog;
 
     bool m_csvLoggingStarted;
     bool m_csvLoggingEnabled;
@@ -29,12 +29,19 @@
 
 #include <extensionsystem/pluginmanager.h>
 #include <coreplugin/icore.h>
+#include <utils/crc.h>
 
 #include <QtCore/QtPlugin>
 #include <QMainWindow>
+#include <QTime>
 
 #include <QDebug>
 
+#ifdef Q_OS_LINUX
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+#endif
+
 
 SerialEnumerationThread::SerialEnumerationThread(SerialConnection *serial)
     : m_serial(serial), m_running(false)
@@ -43,12 +50,15 @@ SerialEnumerationThread::SerialEnumerationThread(SerialConnection *serial)
 void SerialEnumerationThread::run()
 {
     m_running = true;
-    QList <Core::IConnection::device> devices = m_serial->availableDevices();
+    QList <Core::IConnection::device> devices;
     while (m_running) {
         if (!m_serial->deviceOpened()) {
-            QList <Core::IConnection::device> newDev = m_serial->availableDevices();
+            // the scan can block for hundreds of ms on some systems, so it
+            // runs here and only the cached result is handed to the GUI
+            QList <Core::IConnection::device> newDev = m_serial->enumerateDevices();
             if (devices != newDev) {
                 devices = newDev;
+                m_serial->setAvailableDevices(devices);
                 emit enumerationChanged();
             }
         }
@@ -134,7 +144,19 @@ QList<QSerialPortInfo> SerialConnection::availablePorts()
 }
 
 
+/**
+ * Returns the result of the last port scan made by the enumeration
+ * thread. Called by the connection manager on the GUI thread, so it
+ * must never scan the hardware itself.
+ */
 QList <Core::IConnection::device> SerialConnection::availableDevices()
+{
+    QMutexLocker locker(&m_devicesMutex);
+
+    return m_cachedDevices;
+}
+
+QList <Core::IConnection::device> SerialConnection::enumerateDevices()
 {
     QList <Core::IConnection::device> list;
 
@@ -155,6 +177,13 @@ QList <Core::IConnection::device> SerialConnection::availableDevices()
     return list;
 }
 
+void SerialConnection::setAvailableDevices(const QList <Core::IConnection::device> &devices)
+{
+    QMutexLocker locker(&m_devicesMutex);
+
+    m_cachedDevices = devices;
+}
+
 QIODevice *SerialConnection::openDevice(const QString &deviceName)
 {
     if (serialHandle) {
@@ -168,13 +197,17 @@ QIODevice *SerialConnection::openDevice(const QString &deviceName)
             serialHandle = new QSerialPort(port);
             // we need to handle port settings here...
             if (serialHandle->open(QIODevice::ReadWrite)) {
-                if (serialHandle->setBaudRate(m_config->speed().toInt())
-                    && serialHandle->setDataBits(QSerialPort::Data8)
+                if (serialHandle->setDataBits(QSerialPort::Data8)
                     && serialHandle->setParity(QSerialPort::NoParity)
                     && serialHandle->setStopBits(QSerialPort::OneStop)
                     && serialHandle->setFlowControl(QSerialPort::NoFlowControl)) {
-                    qDebug() << "Serial telemetry running at " << m_config->speed();
-                    m_deviceOpened = true;
+                    setLowLatency();
+                    qint32 speed = (m_config->speed() == "Auto") ? negotiateSpeed()
+                                   : m_config->speed().toInt();
+                    if (speed > 0 && serialHandle->setBaudRate(speed)) {
+                        qDebug() << "Serial telemetry running at " << speed;
+                        m_deviceOpened = true;
+                    }
                 }
             }
             return serialHandle;
@@ -183,6 +216,70 @@ QIODevice *SerialConnection::openDevice(const QString &deviceName)
     return NULL;
 }
 
+/**
+ * Probe the flight side for the highest common telemetry rate.
+ *
+ * For every candidate rate (highest first) a UAVTalk object request for
+ * object id 0 is written to the port. No object has id 0, so the firmware
+ * answers it with a NACK right away - but only when the rates match, which
+ * makes the reply a cheap rate detector that works with any object set.
+ * The candidates mirror the HwSettings.TelemetrySpeed options of the
+ * firmware; the worst case (nothing connected) costs about a second.
+ */
+qint32 SerialConnection::negotiateSpeed()
+{
+    static const qint32 candidates[] = { 115200, 57600, 38400, 19200, 9600 };
+
+    // UAVTalk object request: sync, type, size, objid 0, instid 0, CRC
+    quint8 request[11] = { 0x3C, 0x21, 0x0A, 0x00, 0, 0, 0, 0, 0, 0, 0 };
+
+    request[10] = Utils::Crc::updateCRC(0, request, sizeof(request) - 1);
+
+    for (quint32 i = 0; i < sizeof(candidates) / sizeof(candidates[0]); ++i) {
+        if (!serialHandle->setBaudRate(candidates[i])) {
+            continue;
+        }
+        serialHandle->clear();
+        serialHandle->write((const char *)request, sizeof(request));
+        serialHandle->waitForBytesWritten(100);
+
+        // the board replies within a few milliseconds, the window is generous
+        QByteArray reply;
+        QTime timeout;
+        timeout.start();
+        while (timeout.elapsed() < 200) {
+            serialHandle->waitForReadyRead(50);
+            reply += serialHandle->readAll();
+            // look for the sync / NACK type sequence rather than a lone sync
+            // byte so that line noise at a wrong rate cannot cause a match
+            if (reply.contains(QByteArray("\x3C\x23", 2))) {
+                qDebug() << "Serial telemetry speed negotiated at " << candidates[i];
+                return candidates[i];
+            }
+        }
+    }
+    qDebug() << "Serial telemetry speed negotiation failed, falling back to 57600";
+    return 57600;
+}
+
+/**
+ * Ask the driver for minimal receive latency. USB serial adapters (FTDI
+ * in particular) batch received bytes for up to 16ms before delivering
+ * them, which dominates the telemetry round trip time at high rates.
+ */
+void SerialConnection::setLowLatency()
+{
+#ifdef Q_OS_LINUX
+    struct serial_struct ser;
+    int fd = serialHandle->handle();
+
+    if (ioctl(fd, TIOCGSERIAL, &ser) == 0) {
+        ser.flags |= ASYNC_LOW_LATENCY;
+        ioctl(fd, TIOCSSERIAL, &ser);
+    }
+#endif
+}
+
 void SerialConnection::closeDevice(const QString &deviceName)
 {
     Q_UNUSED(deviceName);
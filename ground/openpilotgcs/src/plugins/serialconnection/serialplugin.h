@@ -36,6 +36,8 @@
 #include "serialpluginconfiguration.h"
 #include "serialpluginoptionspage.h"
 #include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
 
 class IConnection;
 class QSerialPortInfo;
@@ -79,6 +81,8 @@ public:
     virtual ~SerialConnection();
 
     virtual QList <Core::IConnection::device> availableDevices();
+    // blocking port scan, only called from the enumeration thread
+    QList <Core::IConnection::device> enumerateDevices();
     virtual QIODevice *openDevice(const QString &deviceName);
     virtual void closeDevice(const QString &deviceName);
 
@@ -109,6 +113,18 @@ private:
 
     QList<QSerialPortInfo> availablePorts();
 
+    qint32 negotiateSpeed();
+    void setLowLatency();
+
+    void setAvailableDevices(const QList <Core::IConnection::device> &devices);
+
+    // last scan result published by the enumeration thread, handed out
+    // by availableDevices() without touching the hardware
+    QMutex m_devicesMutex;
+    QList <Core::IConnection::device> m_cachedDevices;
+
+    friend class SerialEnumerationThread;
+
 protected slots:
     void onEnumerationChanged();
 
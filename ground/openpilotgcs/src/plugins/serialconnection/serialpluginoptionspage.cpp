@@ -46,7 +46,8 @@ QWidget *SerialPluginOptionsPage::createPage(QWidget *parent)
     // main layout
     options_page->setupUi(optionsPageWidget);
     QStringList allowedSpeeds;
-    allowedSpeeds << "1200"
+    allowedSpeeds << "Auto"              // probe the flight side for the highest common rate
+                  << "1200"
         #ifdef Q_OS_UNIX
                   << "1800"              // POSIX ONLY
         #endif
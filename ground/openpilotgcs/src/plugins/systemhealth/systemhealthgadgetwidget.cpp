@@ -86,54 +86,65 @@ void SystemHealthGadgetWidget::onAutopilotDisconnect()
 
 void SystemHealthGadgetWidget::updateAlarms(UAVObject *systemAlarm)
 {
-    // This code does not know anything about alarms beforehand, and
-    // I found no efficient way to locate items inside the scene by
-    // name, so it's just as simple to reset the scene:
-    // And add the one with the right name.
-    QGraphicsScene *m_scene = scene();
-
-    foreach(QGraphicsItem * item, background->childItems()) {
-        m_scene->removeItem(item);
-        delete item; // removeItem does _not_ delete the item.
-    }
-
+    // The items are kept between updates, keyed by element name, so only
+    // the cells whose severity actually changed get touched; everything
+    // else repaints from its cached pixmap.
     QMatrix backgroundMatrix = (m_renderer->matrixForElement(background->elementId())).inverted();
 
-    QString alarm = systemAlarm->getName();
     foreach(UAVObjectField * field, systemAlarm->getFields()) {
         for (uint i = 0; i < field->getNumElements(); ++i) {
             QString element = field->getElementNames()[i];
             QString value   = field->getValue(i).toString();
-            if (!missingElements->contains(element)) {
-                if (m_renderer->elementExists(element)) {
-                    QString element2 = element + "-" + value;
-                    if (!missingElements->contains(element2)) {
-                        if (m_renderer->elementExists(element2)) {
-                            // element2 is in global coordinates
-                            // transform its matrix into the coordinates of background
-                            QMatrix blockMatrix   = backgroundMatrix * m_renderer->matrixForElement(element2);
-                            // use this composed projection to get the position in background coordinates
-                            QRectF rectProjected  = blockMatrix.mapRect(m_renderer->boundsOnElement(element2));
-
-                            QGraphicsSvgItem *ind = new QGraphicsSvgItem();
-                            ind->setSharedRenderer(m_renderer);
-                            ind->setElementId(element2);
-                            ind->setParentItem(background);
-                            QTransform matrix;
-                            matrix.translate(rectProjected.x(), rectProjected.y());
-                            ind->setTransform(matrix, false);
-                        } else {
-                            if (value.compare("Uninitialised") != 0) {
-                                missingElements->append(element2);
-                                qDebug() << "Warning: element " << element2 << " not found in SVG.";
-                            }
-                        }
+            if (alarmValues.contains(element) && (alarmValues.value(element) == value)) {
+                // severity unchanged, leave the cell alone
+                continue;
+            }
+            if (missingElements->contains(element)) {
+                continue;
+            }
+            if (!m_renderer->elementExists(element)) {
+                missingElements->append(element);
+                qDebug() << "Warning: Element " << element << " not found in SVG.";
+                continue;
+            }
+            QString element2 = element + "-" + value;
+            if (missingElements->contains(element2) || !m_renderer->elementExists(element2)) {
+                if (!missingElements->contains(element2)) {
+                    if (value.compare("Uninitialised") != 0) {
+                        missingElements->append(element2);
+                        qDebug() << "Warning: element " << element2 << " not found in SVG.";
                     }
-                } else {
-                    missingElements->append(element);
-                    qDebug() << "Warning: Element " << element << " not found in SVG.";
                 }
+                // no cell for this state, drop a stale one from the previous state
+                QGraphicsSvgItem *stale = alarmItems.take(element);
+                if (stale) {
+                    scene()->removeItem(stale);
+                    delete stale; // removeItem does _not_ delete the item.
+                }
+                alarmValues.insert(element, value);
+                continue;
+            }
+
+            // element2 is in global coordinates
+            // transform its matrix into the coordinates of background
+            QMatrix blockMatrix   = backgroundMatrix * m_renderer->matrixForElement(element2);
+            // use this composed projection to get the position in background coordinates
+            QRectF rectProjected  = blockMatrix.mapRect(m_renderer->boundsOnElement(element2));
+
+            QGraphicsSvgItem *ind = alarmItems.value(element);
+            if (!ind) {
+                ind = new QGraphicsSvgItem();
+                ind->setSharedRenderer(m_renderer);
+                ind->setParentItem(background);
+                // rasterize once per state change, repaints then blit the pixmap
+                ind->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+                alarmItems.insert(element, ind);
             }
+            ind->setElementId(element2);
+            QTransform matrix;
+            matrix.translate(rectProjected.x(), rectProjected.y());
+            ind->setTransform(matrix, false);
+            alarmValues.insert(element, value);
         }
     }
 }
@@ -148,6 +159,13 @@ void SystemHealthGadgetWidget::setSystemFile(QString dfn)
 {
     // Clear the list of elements not found on svg
     missingElements->clear();
+    // The renderer is reloaded below, drop the cached alarm cells
+    foreach(QGraphicsSvgItem * item, alarmItems) {
+        scene()->removeItem(item);
+        delete item;
+    }
+    alarmItems.clear();
+    alarmValues.clear();
     setBackgroundBrush(QBrush(Utils::StyleHelper::baseColor()));
     if (QFile::exists(dfn)) {
         m_renderer->load(dfn);
@@ -37,6 +37,7 @@
 #include <QMouseEvent>
 
 #include <QFile>
+#include <QHash>
 #include <QTimer>
 
 class SystemHealthGadgetWidget : public QGraphicsView {
@@ -65,6 +66,10 @@ private:
     QGraphicsSvgItem *foreground;
     QGraphicsSvgItem *nolink;
     QStringList *missingElements;
+    // One item per alarm cell, keyed by element name, plus the severity it
+    // currently shows so unchanged alarms are left alone on update
+    QHash<QString, QGraphicsSvgItem *> alarmItems;
+    QHash<QString, QString> alarmValues;
     // Simple flag to skip rendering if the
     bool fgenabled; // layer does not exist.
 
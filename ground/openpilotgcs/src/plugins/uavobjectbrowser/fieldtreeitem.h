@@ -93,11 +93,7 @@ public:
 
     void setData(QVariant value, int column)
     {
-        QStringList options = m_field->getOptions();
-        QVariant tmpValue   = m_field->getValue(m_index);
-        int tmpValIndex     = options.indexOf(tmpValue.toString());
-
-        setChanged(tmpValIndex != value);
+        setChanged(m_field->getEnumIndex(m_index) != value);
         TreeItem::setData(value, column);
     }
 
@@ -120,9 +116,7 @@ public:
 
     void update()
     {
-        QStringList options = m_field->getOptions();
-        QVariant value = m_field->getValue(m_index);
-        int valIndex   = options.indexOf(value.toString());
+        int valIndex = m_field->getEnumIndex(m_index);
 
         if (data() != valIndex || changed()) {
             TreeItem::setData(valIndex);
@@ -246,7 +240,7 @@ public:
 
     void update()
     {
-        int value = m_field->getValue(m_index).toInt();
+        int value = m_field->getInt(m_index);
 
         if (data() != value || changed()) {
             TreeItem::setData(value);
@@ -282,7 +276,7 @@ public:
 
     void update()
     {
-        double value = m_field->getValue(m_index).toDouble();
+        double value = m_field->getDouble(m_index);
 
         if (data() != value || changed()) {
             TreeItem::setData(value);
@@ -156,6 +156,36 @@ public:
         m_changed = changed;
     }
 
+    // expansion state mirrored from the tree view, used to skip value
+    // refreshes of subtrees nobody can see
+    inline bool expanded() const
+    {
+        return m_expanded;
+    }
+    inline void setExpanded(bool expanded)
+    {
+        m_expanded = expanded;
+    }
+    inline bool updateNeeded() const
+    {
+        return m_updateNeeded;
+    }
+    inline void setUpdateNeeded(bool updateNeeded)
+    {
+        m_updateNeeded = updateNeeded;
+    }
+
+    // returns true (and restarts the interval) when the last refresh of
+    // this item is at least intervalMs ago
+    bool refreshIsDue(int intervalMs)
+    {
+        if (m_lastRefresh.isNull() || m_lastRefresh.elapsed() >= intervalMs) {
+            m_lastRefresh = QTime::currentTime();
+            return true;
+        }
+        return false;
+    }
+
     virtual void setHighlightManager(HighLightManager *mgr);
 
     QTime getHiglightExpires();
@@ -239,6 +269,9 @@ private:
     TreeItem *m_parent;
     bool m_highlight;
     bool m_changed;
+    bool m_expanded;
+    bool m_updateNeeded;
+    QTime m_lastRefresh;
     QTime m_highlightExpires;
     HighLightManager *m_highlightManager;
 };
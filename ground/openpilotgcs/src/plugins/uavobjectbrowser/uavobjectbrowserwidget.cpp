@@ -51,6 +51,9 @@ UAVObjectBrowserWidget::UAVObjectBrowserWidget(QWidget *parent) : QWidget(parent
     m_model = new UAVObjectTreeModel();
     m_browser->treeView->setModel(m_model);
     m_browser->treeView->setColumnWidth(0, 300);
+    // let the model know what is expanded so it can skip hidden subtrees
+    connect(m_browser->treeView, SIGNAL(expanded(QModelIndex)), m_model, SLOT(indexExpanded(QModelIndex)));
+    connect(m_browser->treeView, SIGNAL(collapsed(QModelIndex)), m_model, SLOT(indexCollapsed(QModelIndex)));
 
     BrowserItemDelegate *m_delegate = new BrowserItemDelegate();
     m_browser->treeView->setItemDelegate(m_delegate);
@@ -121,6 +124,8 @@ void UAVObjectBrowserWidget::categorize(bool categorize)
     m_model->setOnlyHilightChangedValues(m_onlyHilightChangedValues);
     m_model->setUnknowObjectColor(m_unknownObjectColor);
     m_browser->treeView->setModel(m_model);
+    connect(m_browser->treeView, SIGNAL(expanded(QModelIndex)), m_model, SLOT(indexExpanded(QModelIndex)));
+    connect(m_browser->treeView, SIGNAL(collapsed(QModelIndex)), m_model, SLOT(indexCollapsed(QModelIndex)));
     showMetaData(m_viewoptions->cbMetaData->isChecked());
     connect(m_browser->treeView->selectionModel(), SIGNAL(currentChanged(QModelIndex, QModelIndex)), this, SLOT(currentChanged(QModelIndex, QModelIndex)), Qt::UniqueConnection);
 
@@ -137,6 +142,8 @@ void UAVObjectBrowserWidget::useScientificNotation(bool scientific)
     m_model->setRecentlyUpdatedTimeout(m_recentlyUpdatedTimeout);
     m_model->setUnknowObjectColor(m_unknownObjectColor);
     m_browser->treeView->setModel(m_model);
+    connect(m_browser->treeView, SIGNAL(expanded(QModelIndex)), m_model, SLOT(indexExpanded(QModelIndex)));
+    connect(m_browser->treeView, SIGNAL(collapsed(QModelIndex)), m_model, SLOT(indexCollapsed(QModelIndex)));
     showMetaData(m_viewoptions->cbMetaData->isChecked());
     connect(m_browser->treeView->selectionModel(), SIGNAL(currentChanged(QModelIndex, QModelIndex)), this, SLOT(currentChanged(QModelIndex, QModelIndex)), Qt::UniqueConnection);
 
@@ -42,6 +42,7 @@ UAVObjectTreeModel::UAVObjectTreeModel(QObject *parent, bool categorize, bool us
     m_useScientificFloatNotation(useScientificNotation),
     m_categorize(categorize),
     m_recentlyUpdatedTimeout(500), // ms
+    m_viewRefreshInterval(100), // ms, max value refresh rate per object
     m_recentlyUpdatedColor(QColor(255, 230, 230)),
     m_manuallyChangedColor(QColor(230, 230, 255)),
     m_unknownObjectColor(QColor(Qt::gray))
@@ -53,6 +54,10 @@ UAVObjectTreeModel::UAVObjectTreeModel(QObject *parent, bool categorize, bool us
 
     // Create highlight manager, let it run every 300 ms.
     m_highlightManager = new HighLightManager(300);
+
+    m_refreshTimer     = new QTimer(this);
+    connect(m_refreshTimer, SIGNAL(timeout()), this, SLOT(flushPendingUpdates()));
+
     connect(objManager, SIGNAL(newObject(UAVObject *)), this, SLOT(newObject(UAVObject *)));
     connect(objManager, SIGNAL(newInstance(UAVObject *)), this, SLOT(newObject(UAVObject *)));
 
@@ -452,7 +457,26 @@ void UAVObjectTreeModel::highlightUpdatedObject(UAVObject *obj)
     if (!m_onlyHilightChangedValues) {
         item->setHighlight(true);
     }
-    item->update();
+    // Only refresh the value rows somebody can actually see: a collapsed
+    // subtree just remembers that it is stale and catches up on expand,
+    // and a visible one refreshes at most every m_viewRefreshInterval so
+    // high rate telemetry cannot flood the view with repaints.
+    if (!subtreeVisible(item)) {
+        // collapsed subtrees catch up when they are expanded again
+        item->setUpdateNeeded(true);
+    } else if (item->refreshIsDue(m_viewRefreshInterval)) {
+        item->setUpdateNeeded(false);
+        item->update();
+    } else {
+        // throttled, the refresh timer applies the latest value shortly
+        item->setUpdateNeeded(true);
+        if (!m_pendingRefresh.contains(item)) {
+            m_pendingRefresh.insert(item);
+            if (!m_refreshTimer->isActive()) {
+                m_refreshTimer->start(m_viewRefreshInterval);
+            }
+        }
+    }
     if (!m_onlyHilightChangedValues) {
         QModelIndex itemIndex = index(item);
         Q_ASSERT(itemIndex != QModelIndex());
@@ -460,6 +484,53 @@ void UAVObjectTreeModel::highlightUpdatedObject(UAVObject *obj)
     }
 }
 
+/**
+ * Returns true when the children of the item can be seen, i.e. the item
+ * and all its ancestors up to the invisible root are expanded.
+ */
+bool UAVObjectTreeModel::subtreeVisible(TreeItem *item) const
+{
+    for (; item && item != m_rootItem; item = item->parent()) {
+        if (!item->expanded()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void UAVObjectTreeModel::indexExpanded(const QModelIndex &index)
+{
+    TreeItem *item = static_cast<TreeItem *>(index.internalPointer());
+
+    item->setExpanded(true);
+    // catch up with the updates that arrived while the subtree was hidden
+    if (item->updateNeeded() && subtreeVisible(item)) {
+        item->setUpdateNeeded(false);
+        item->update();
+    }
+}
+
+void UAVObjectTreeModel::indexCollapsed(const QModelIndex &index)
+{
+    static_cast<TreeItem *>(index.internalPointer())->setExpanded(false);
+}
+
+void UAVObjectTreeModel::flushPendingUpdates()
+{
+    foreach(ObjectTreeItem * item, m_pendingRefresh) {
+        if (!item->updateNeeded()) {
+            m_pendingRefresh.remove(item);
+        } else if (subtreeVisible(item)) {
+            m_pendingRefresh.remove(item);
+            item->setUpdateNeeded(false);
+            item->update();
+        }
+    }
+    if (m_pendingRefresh.isEmpty()) {
+        m_refreshTimer->stop();
+    }
+}
+
 ObjectTreeItem *UAVObjectTreeModel::findObjectTreeItem(UAVObject *object)
 {
     UAVDataObject *dataObject = qobject_cast<UAVDataObject *>(object);
@@ -32,6 +32,7 @@
 #include <QAbstractItemModel>
 #include <QtCore/QMap>
 #include <QtCore/QList>
+#include <QtCore/QSet>
 #include <QColor>
 
 class TopTreeItem;
@@ -90,12 +91,16 @@ signals:
 
 public slots:
     void newObject(UAVObject *obj);
+    // expansion tracking fed by the tree view, see highlightUpdatedObject()
+    void indexExpanded(const QModelIndex &index);
+    void indexCollapsed(const QModelIndex &index);
 
 private slots:
     void updateHighlight(TreeItem *item);
     void updateIsKnown(TreeItem *item);
     void highlightUpdatedObject(UAVObject *obj);
     void isKnownChanged(UAVObject *object, bool isKnown);
+    void flushPendingUpdates();
 
 private:
     void setupModelData(UAVObjectManager *objManager);
@@ -109,6 +114,7 @@ private:
     TreeItem *createCategoryItems(QStringList categoryPath, TreeItem *root);
 
     QString updateMode(quint8 updateMode);
+    bool subtreeVisible(TreeItem *item) const;
     ObjectTreeItem *findObjectTreeItem(UAVObject *obj);
     DataObjectTreeItem *findDataObjectTreeItem(UAVDataObject *obj);
     MetaObjectTreeItem *findMetaObjectTreeItem(UAVMetaObject *obj);
@@ -119,6 +125,7 @@ private:
     bool m_useScientificFloatNotation;
     bool m_categorize;
     int m_recentlyUpdatedTimeout;
+    int m_viewRefreshInterval;
     QColor m_recentlyUpdatedColor;
     QColor m_manuallyChangedColor;
     QColor m_unknownObjectColor;
@@ -126,6 +133,11 @@ private:
 
     // Highlight manager to handle highlighting of tree items.
     HighLightManager *m_highlightManager;
+
+    // visible items whose refresh got throttled, flushed by m_refreshTimer
+    // so the last update of a burst is not lost
+    QSet<ObjectTreeItem *> m_pendingRefresh;
+    QTimer *m_refreshTimer;
 };
 
 #endif // UAVOBJECTTREEMODEL_H
@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ *
+ * @file       benchdataobject.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief      Hand written data object used by the benchmark suite
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include "benchdataobject.h"
+#include "uavobjectfield.h"
+
+/**
+ * Build the immutable field definition tree, shared by every type index
+ * and instance the way generated objects share their per-type templates.
+ */
+const QList<UAVObjectField *> &BenchDataObject::fieldTemplates()
+{
+    static QList<UAVObjectField *> templates;
+
+    if (templates.isEmpty()) {
+        QList<UAVObjectField *> fields;
+        fields.append(new UAVObjectField(QString("q"), QString(""), QString(""), UAVObjectField::FLOAT32, 4, QStringList()));
+        fields.append(new UAVObjectField(QString("gyro"), QString(""), QString("deg/s"), UAVObjectField::FLOAT32, 3, QStringList()));
+        fields.append(new UAVObjectField(QString("accel"), QString(""), QString("mg"), UAVObjectField::INT16, 3, QStringList()));
+        fields.append(new UAVObjectField(QString("status"), QString(""), QString(""), UAVObjectField::UINT8, 1, QStringList()));
+        templates = fields;
+    }
+    return templates;
+}
+
+/**
+ * Constructor
+ */
+BenchDataObject::BenchDataObject(quint32 typeIndex) :
+    UAVDataObject(OBJID_BASE + (typeIndex << 8), ISSINGLEINST, ISSETTINGS, QString("BenchObject%1").arg(typeIndex)),
+    m_typeIndex(typeIndex)
+{
+    QList<UAVObjectField *> fields = cloneFieldTemplates(fieldTemplates());
+    initializeFields(fields, (quint8 *)&data, NUMBYTES);
+    memset(&data, 0, sizeof(data));
+}
+
+/**
+ * Get the default metadata for this object
+ */
+UAVObject::Metadata BenchDataObject::getDefaultMetadata()
+{
+    UAVObject::Metadata metadata;
+
+    metadata.flags =
+        ACCESS_READWRITE << UAVOBJ_ACCESS_SHIFT |
+        ACCESS_READWRITE << UAVOBJ_GCS_ACCESS_SHIFT |
+        0 << UAVOBJ_TELEMETRY_ACKED_SHIFT |
+        0 << UAVOBJ_GCS_TELEMETRY_ACKED_SHIFT |
+        UPDATEMODE_PERIODIC << UAVOBJ_TELEMETRY_UPDATE_MODE_SHIFT |
+        UPDATEMODE_MANUAL << UAVOBJ_GCS_TELEMETRY_UPDATE_MODE_SHIFT |
+        UPDATEMODE_MANUAL << UAVOBJ_LOGGING_UPDATE_MODE_SHIFT;
+    metadata.flightTelemetryUpdatePeriod = 10;
+    metadata.gcsTelemetryUpdatePeriod    = 0;
+    metadata.loggingUpdatePeriod = 0;
+    return metadata;
+}
+
+void BenchDataObject::emitNotifications()
+{}
+
+/**
+ * Create a clone of this object, a new instance ID must be specified.
+ * Do not use this function directly to create new instances, the
+ * UAVObjectManager should be used instead.
+ */
+UAVDataObject *BenchDataObject::clone(quint32 instID)
+{
+    BenchDataObject *obj = new BenchDataObject(m_typeIndex);
+
+    obj->initialize(instID, this->getMetaObject());
+    return obj;
+}
+
+/**
+ * Create a clone of this object only to be used to retrieve defaults
+ */
+UAVDataObject *BenchDataObject::dirtyClone()
+{
+    BenchDataObject *obj = new BenchDataObject(m_typeIndex);
+
+    return obj;
+}
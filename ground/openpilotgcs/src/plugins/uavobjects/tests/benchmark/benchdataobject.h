@@ -0,0 +1,73 @@
+/**
+ ******************************************************************************
+ *
+ * @file       benchdataobject.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief      Hand written data object used by the benchmark suite
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#ifndef BENCHDATAOBJECT_H
+#define BENCHDATAOBJECT_H
+
+#include "uavdataobject.h"
+#include "uavobjectmanager.h"
+
+/**
+ * A data object shaped like a typical telemetry state object (quaternion,
+ * rates, accelerations and a status byte).  The benchmark registers many
+ * distinct object types, so the object ID and name are derived from a type
+ * index instead of being generated from an XML definition.
+ */
+class BenchDataObject : public UAVDataObject {
+    Q_OBJECT
+
+public:
+    // Field structure
+    typedef struct {
+        float q[4];
+        float gyro[3];
+        qint16 accel[3];
+        quint8 status;
+    } __attribute__((packed)) DataFields;
+
+    // Constants
+    static const quint32 OBJID_BASE  = 0xBE4C0010;
+    static const bool ISSINGLEINST   = 0;
+    static const bool ISSETTINGS     = 0;
+    static const quint32 NUMBYTES    = sizeof(DataFields);
+
+    explicit BenchDataObject(quint32 typeIndex = 0);
+
+    Metadata getDefaultMetadata();
+    UAVDataObject *clone(quint32 instID);
+    UAVDataObject *dirtyClone();
+
+protected slots:
+    void emitNotifications();
+
+private:
+    quint32 m_typeIndex;
+    DataFields data;
+
+    static const QList<UAVObjectField *> &fieldTemplates();
+};
+
+#endif // BENCHDATAOBJECT_H
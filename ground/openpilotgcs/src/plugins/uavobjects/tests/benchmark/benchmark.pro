@@ -0,0 +1,31 @@
+# Ground-side performance benchmark, the counterpart of the flight
+# benchmark suite in flight/tests/benchmark.  Standalone console app in
+# the style of ../uavobjectstest.pro: the sources under test are pulled
+# in directly instead of linking the plugin libraries, so the benchmark
+# builds without the plugin loader.
+#
+# Run from this directory so the recorded telemetry corpus under
+# fixtures/ is found; a nonzero exit code means a benchmark regressed
+# more than the tolerance over its recorded baseline.
+QT += widgets
+TARGET = uavobjectsbenchmark
+CONFIG += console
+CONFIG -= app_bundle
+TEMPLATE = app
+INCLUDEPATH += ../.. \
+    ../../../../libs
+SOURCES += main.cpp \
+    benchdataobject.cpp \
+    ../../uavobjectmanager.cpp \
+    ../../uavobjectfield.cpp \
+    ../../uavobject.cpp \
+    ../../uavmetaobject.cpp \
+    ../../uavdataobject.cpp \
+    ../../../../libs/utils/crc.cpp
+HEADERS += benchdataobject.h \
+    benchmark_baselines.h \
+    ../../uavobjectmanager.h \
+    ../../uavobjectfield.h \
+    ../../uavobject.h \
+    ../../uavmetaobject.h \
+    ../../uavdataobject.h
@@ -0,0 +1,17 @@
+#ifndef BENCHMARK_BASELINES_H
+#define BENCHMARK_BASELINES_H
+
+/* Recorded benchmark-to-calibration time ratios, enforced with the
+ * tolerance defined in main.cpp.  A baseline of 0 is not yet recorded
+ * and is reported without being enforced.  To (re)record after an
+ * intentional performance change, run
+ *     GCS_BENCH_RECORD=1 ./uavobjectsbenchmark
+ * on an idle reference machine and paste the printed values here; keep
+ * the worst of a few runs so normal scheduler jitter passes. */
+
+#define BENCH_BASELINE_REGISTER 0
+#define BENCH_BASELINE_LOOKUP   0
+#define BENCH_BASELINE_PARSE    0
+#define BENCH_BASELINE_PACK     0
+
+#endif /* BENCHMARK_BASELINES_H */
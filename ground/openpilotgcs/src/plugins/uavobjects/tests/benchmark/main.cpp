@@ -0,0 +1,324 @@
+/**
+ ******************************************************************************
+ *
+ * @file       main.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2015.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief      Performance regression benchmark for the GCS object layer
+ *
+ * Ground-side counterpart of flight/tests/benchmark.  Times the hot paths
+ * a telemetry stream exercises in the GCS - object registration, manager
+ * lookups, frame validation plus unpack driven by a recorded telemetry
+ * corpus, and object packing - and reports ops/sec and peak RSS for each.
+ *
+ * Host speed is factored out the same way as on the flight side: every
+ * phase is normalized to a fixed calibration workload measured in the
+ * same process, and the dimensionless ratio is compared against the
+ * recorded baseline in benchmark_baselines.h.  A phase whose ratio
+ * regresses more than BENCH_TOLERANCE fails the run with a nonzero exit
+ * code, so a CI job running this binary fails the build on a regression.
+ *
+ * The corpus is loaded from fixtures/telemetry.bin relative to the
+ * working directory; a deterministic one is generated and saved there on
+ * the first run, and a corpus recorded from a real flight can be dropped
+ * in its place.
+ *
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+#include <QtCore/QCoreApplication>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QFile>
+#include <QVector>
+#include <QtEndian>
+
+#include <utils/crc.h>
+
+#include "uavobjectmanager.h"
+#include "benchdataobject.h"
+#include "benchmark_baselines.h"
+
+#ifndef Q_OS_WIN
+#include <sys/resource.h>
+#endif
+
+// A phase whose time ratio regresses more than this over its recorded
+// baseline fails the run.
+#define BENCH_TOLERANCE     0.10
+
+#define BENCH_NUM_TYPES     256
+#define BENCH_NUM_INSTANCES 4
+#define BENCH_LOOKUP_ITERS  2000000
+#define BENCH_PACK_ITERS    2000000
+#define BENCH_CORPUS_FRAMES 200000
+#define BENCH_PARSE_PASSES  5
+
+// Telemetry frame layout used by the corpus: sync, type, size (LE16),
+// object ID (LE32), instance ID (LE16), packed object data, CRC over
+// everything before it.
+#define FRAME_SYNC          0x3C
+#define FRAME_TYPE_OBJ      0x20
+#define FRAME_HEADER_BYTES  10
+#define FRAME_TOTAL_BYTES   (FRAME_HEADER_BYTES + BenchDataObject::NUMBYTES + 1)
+
+#define CORPUS_FILE         "fixtures/telemetry.bin"
+
+static QTextStream sout(stdout);
+
+/* Deterministic generator so a synthesized corpus is identical on every
+ * machine that has no recorded one. */
+static quint32 benchRand(quint32 *state)
+{
+    quint32 x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/* Fixed workload used to normalize out the host speed. */
+static double calibrationSeconds()
+{
+    QElapsedTimer timer;
+    quint32 state = 0xB5AD4ECE;
+
+    timer.start();
+    for (int i = 0; i < 20000000; i++) {
+        benchRand(&state);
+    }
+    qint64 ns = timer.nsecsElapsed();
+    // keep the workload observable so it cannot be optimized away
+    if (state == 0) {
+        sout << "";
+    }
+    return ns / 1e9;
+}
+
+/* Peak resident set size in megabytes, 0 where it cannot be read. */
+static double peakRssMb()
+{
+#ifndef Q_OS_WIN
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef Q_OS_MAC
+        return usage.ru_maxrss / (1024.0 * 1024.0);
+
+#else
+        return usage.ru_maxrss / 1024.0;
+
+#endif
+    }
+#endif /* ifndef Q_OS_WIN */
+    return 0;
+}
+
+static QByteArray loadOrGenerateCorpus()
+{
+    QFile file(CORPUS_FILE);
+
+    if (file.open(QIODevice::ReadOnly)) {
+        sout << "corpus: " << CORPUS_FILE << " (" << file.size() << " bytes, recorded)\n";
+        return file.readAll();
+    }
+
+    // No recorded corpus; synthesize a deterministic one and save it so
+    // later runs (and other machines) parse identical bytes.
+    QByteArray corpus;
+    corpus.reserve(BENCH_CORPUS_FRAMES * FRAME_TOTAL_BYTES);
+    quint32 state = 0x5EED1234;
+    for (int n = 0; n < BENCH_CORPUS_FRAMES; n++) {
+        quint8 frame[FRAME_TOTAL_BYTES];
+        frame[0] = FRAME_SYNC;
+        frame[1] = FRAME_TYPE_OBJ;
+        qToLittleEndian<quint16>(FRAME_HEADER_BYTES + BenchDataObject::NUMBYTES, &frame[2]);
+        quint32 objId  = BenchDataObject::OBJID_BASE + ((benchRand(&state) % BENCH_NUM_TYPES) << 8);
+        quint16 instId = benchRand(&state) % BENCH_NUM_INSTANCES;
+        qToLittleEndian<quint32>(objId, &frame[4]);
+        qToLittleEndian<quint16>(instId, &frame[8]);
+        for (quint32 i = 0; i < BenchDataObject::NUMBYTES; i++) {
+            frame[FRAME_HEADER_BYTES + i] = benchRand(&state) & 0xFF;
+        }
+        quint8 crc = Utils::Crc::updateCRC(0, frame, FRAME_TOTAL_BYTES - 1);
+        // corrupt a small fraction of the frames so the reject path is
+        // part of the measured workload
+        if ((n % 97) == 96) {
+            crc ^= 0xFF;
+        }
+        frame[FRAME_TOTAL_BYTES - 1] = crc;
+        corpus.append((const char *)frame, FRAME_TOTAL_BYTES);
+    }
+
+    QDir().mkpath(QFileInfo(CORPUS_FILE).path());
+    QFile out(CORPUS_FILE);
+    if (out.open(QIODevice::WriteOnly)) {
+        out.write(corpus);
+        sout << "corpus: " << CORPUS_FILE << " (" << corpus.size() << " bytes, generated)\n";
+    } else {
+        sout << "corpus: generated in memory only, could not write " << CORPUS_FILE << "\n";
+    }
+    return corpus;
+}
+
+/* One pass over the corpus: validate framing and CRC, look the object up
+ * and unpack the payload into it, the same per-frame work a telemetry
+ * stream costs the object layer.  Returns the number of accepted frames. */
+static int parseCorpus(UAVObjectManager *objMngr, const QByteArray &corpus)
+{
+    const quint8 *data = (const quint8 *)corpus.constData();
+    int len      = corpus.size();
+    int pos      = 0;
+    int accepted = 0;
+
+    while (pos + FRAME_HEADER_BYTES <= len) {
+        if ((data[pos] != FRAME_SYNC) || (data[pos + 1] != FRAME_TYPE_OBJ)) {
+            pos++;
+            continue;
+        }
+        quint16 size = qFromLittleEndian<quint16>(&data[pos + 2]);
+        if ((size < FRAME_HEADER_BYTES) || (pos + size + 1 > len)) {
+            pos++;
+            continue;
+        }
+        if (data[pos + size] != Utils::Crc::updateCRC(0, &data[pos], size)) {
+            pos++;
+            continue;
+        }
+        quint32 objId  = qFromLittleEndian<quint32>(&data[pos + 4]);
+        quint16 instId = qFromLittleEndian<quint16>(&data[pos + 8]);
+        UAVObject *obj = objMngr->getObject(objId, instId);
+        if (obj && ((quint32)(size - FRAME_HEADER_BYTES) == obj->getNumBytes())) {
+            obj->unpack(&data[pos + FRAME_HEADER_BYTES]);
+            accepted++;
+        }
+        pos += size + 1;
+    }
+    return accepted;
+}
+
+/* Report one phase and enforce its baseline; returns 1 on regression. */
+static int reportPhase(const char *name, double seconds, double ops, double calibration, double baseline, bool record)
+{
+    double ratio = seconds / calibration;
+
+    sout << QString("%1 %2 ops/sec  ratio %3  rss %4 MB")
+        .arg(QString(name), -10)
+        .arg(ops / seconds, 12, 'f', 0)
+        .arg(ratio, 7, 'f', 3)
+        .arg(peakRssMb(), 0, 'f', 1) << "\n";
+    sout.flush();
+
+    if (record || (baseline <= 0)) {
+        return 0;
+    }
+    if (ratio > baseline * (1.0 + BENCH_TOLERANCE)) {
+        sout << QString("FAIL: %1 regressed, ratio %2 exceeds baseline %3 by more than %4%")
+            .arg(name).arg(ratio, 0, 'f', 3).arg(baseline, 0, 'f', 3).arg(BENCH_TOLERANCE * 100, 0, 'f', 0) << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    bool record  = !qgetenv("GCS_BENCH_RECORD").isEmpty();
+    int failures = 0;
+
+    QByteArray corpus  = loadOrGenerateCorpus();
+    double calibration = calibrationSeconds();
+    sout << QString("calibration %1 s\n").arg(calibration, 0, 'f', 3);
+
+    UAVObjectManager *objMngr = new UAVObjectManager();
+    QElapsedTimer timer;
+
+    // Registration: object types, their metaobjects and extra instances.
+    timer.start();
+    for (int t = 0; t < BENCH_NUM_TYPES; t++) {
+        for (int i = 0; i < BENCH_NUM_INSTANCES; i++) {
+            objMngr->registerObject(new BenchDataObject(t));
+        }
+    }
+    double registerSec = timer.nsecsElapsed() / 1e9;
+    failures += reportPhase("register", registerSec, BENCH_NUM_TYPES * BENCH_NUM_INSTANCES,
+                            calibration, BENCH_BASELINE_REGISTER, record);
+
+    // Lookups by ID and by name, alternating like mixed GCS consumers do.
+    QVector<QString> names(BENCH_NUM_TYPES);
+    for (int t = 0; t < BENCH_NUM_TYPES; t++) {
+        names[t] = QString("BenchObject%1").arg(t);
+    }
+    quint32 state = 0xCAFEB0B5;
+    timer.restart();
+    for (int i = 0; i < BENCH_LOOKUP_ITERS; i++) {
+        quint32 t = benchRand(&state) % BENCH_NUM_TYPES;
+        UAVObject *obj;
+        if (i & 1) {
+            obj = objMngr->getObject(names[t]);
+        } else {
+            obj = objMngr->getObject(BenchDataObject::OBJID_BASE + (t << 8));
+        }
+        if (!obj) {
+            sout << "FAIL: lookup returned no object\n";
+            return 1;
+        }
+    }
+    double lookupSec = timer.nsecsElapsed() / 1e9;
+    failures += reportPhase("lookup", lookupSec, BENCH_LOOKUP_ITERS,
+                            calibration, BENCH_BASELINE_LOOKUP, record);
+
+    // Telemetry parse: framing, CRC, lookup and unpack over the corpus.
+    int accepted = 0;
+    timer.restart();
+    for (int pass = 0; pass < BENCH_PARSE_PASSES; pass++) {
+        accepted += parseCorpus(objMngr, corpus);
+    }
+    double parseSec = timer.nsecsElapsed() / 1e9;
+    sout << QString("parse accepted %1 frames, %2 MB/s\n")
+        .arg(accepted)
+        .arg(((double)corpus.size() * BENCH_PARSE_PASSES) / (1024 * 1024) / parseSec, 0, 'f', 1);
+    failures += reportPhase("parse", parseSec, (double)accepted,
+                            calibration, BENCH_BASELINE_PARSE, record);
+
+    // Packing, the transmit-side counterpart.
+    UAVObject *packObj = objMngr->getObject(BenchDataObject::OBJID_BASE);
+    quint8 packBuffer[BenchDataObject::NUMBYTES];
+    timer.restart();
+    for (int i = 0; i < BENCH_PACK_ITERS; i++) {
+        packObj->pack(packBuffer);
+    }
+    double packSec = timer.nsecsElapsed() / 1e9;
+    failures += reportPhase("pack", packSec, BENCH_PACK_ITERS,
+                            calibration, BENCH_BASELINE_PACK, record);
+
+    if (record) {
+        sout << "\nPaste into benchmark_baselines.h:\n";
+        sout << QString("#define BENCH_BASELINE_REGISTER %1\n").arg(registerSec / calibration, 0, 'f', 3);
+        sout << QString("#define BENCH_BASELINE_LOOKUP   %1\n").arg(lookupSec / calibration, 0, 'f', 3);
+        sout << QString("#define BENCH_BASELINE_PARSE    %1\n").arg(parseSec / calibration, 0, 'f', 3);
+        sout << QString("#define BENCH_BASELINE_PACK     %1\n").arg(packSec / calibration, 0, 'f', 3);
+    }
+
+    sout << (failures ? "FAILED\n" : "OK\n");
+    sout.flush();
+    return failures;
+}
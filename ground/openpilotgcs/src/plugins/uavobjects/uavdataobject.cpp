@@ -35,6 +35,60 @@ UAVDataObject::UAVDataObject(quint32 objID, bool isSingleInst, bool isSettings,
 {
     m_metaObject = NULL;
     this->m_isSettings = isSettings;
+    m_deferNotifications   = 0;
+    m_notificationsPending = false;
+
+    connect(this, SIGNAL(objectUpdated(UAVObject *)), SLOT(scheduleNotifications()));
+}
+
+/**
+ * Defer the per field property Changed notifications.
+ *
+ * While at least one consumer holds a deferral, object updates only mark
+ * the object as pending and the notifications are emitted as one batch by
+ * the next flushNotifications() call. The QML gadgets use this to
+ * re-evaluate their bindings once per rendered frame instead of once per
+ * telemetry update.
+ */
+void UAVDataObject::setDeferredNotifications(bool enable)
+{
+    m_deferNotifications += enable ? 1 : -1;
+}
+
+/**
+ * Emit the property notifications held back since the last flush, if any.
+ */
+void UAVDataObject::flushNotifications()
+{
+    if (m_notificationsPending) {
+        m_notificationsPending = false;
+        emitNotifications();
+    }
+}
+
+void UAVDataObject::scheduleNotifications()
+{
+    if (m_deferNotifications > 0) {
+        m_notificationsPending = true;
+    } else {
+        emitNotifications();
+    }
+}
+
+/**
+ * Create this instance's fields from a type's immutable field templates.
+ * The templates are built once per object type; every further instance
+ * only pays for these shallow copies, which matters both for registry
+ * initialization at launch and for multi-vehicle instance creation.
+ */
+QList<UAVObjectField *> UAVDataObject::cloneFieldTemplates(const QList<UAVObjectField *> & fieldTemplates)
+{
+    QList<UAVObjectField *> fields;
+
+    foreach(UAVObjectField * fieldTemplate, fieldTemplates) {
+        fields.append(new UAVObjectField(fieldTemplate));
+    }
+    return fields;
 }
 
 /**
@@ -50,9 +50,25 @@ public:
     bool isSettingsObject();
     bool isDataObject();
 
+    void setDeferredNotifications(bool enable);
+    void flushNotifications();
+
+protected:
+    static QList<UAVObjectField *> cloneFieldTemplates(const QList<UAVObjectField *> & fieldTemplates);
+
+protected slots:
+    // emits the per field property Changed signals,
+    // implemented by the generated object classes
+    virtual void emitNotifications() = 0;
+
+private slots:
+    void scheduleNotifications();
+
 private:
     UAVMetaObject *m_metaObject;
     bool m_isSettings;
+    int m_deferNotifications;
+    bool m_notificationsPending;
 };
 
 #endif // UAVDATAOBJECT_H
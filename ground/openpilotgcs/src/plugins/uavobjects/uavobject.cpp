@@ -64,6 +64,9 @@ UAVObject::UAVObject(quint32 objID, bool isSingleInst, const QString & name)
     this->numBytes     = 0;
     this->mutex        = new QMutex(QMutex::Recursive);
     m_isKnown = false;
+    updateCoalesceTimer = NULL;
+    updateEmitScheduled = false;
+    dataWriteNesting    = 0;
 }
 
 /**
@@ -205,7 +208,7 @@ void UAVObject::requestUpdateAll()
 void UAVObject::updated()
 {
     emit objectUpdatedManual(this);
-    emit objectUpdated(this);
+    emitObjectUpdated();
 }
 
 /**
@@ -253,6 +256,54 @@ QMutex *UAVObject::getMutex()
     return mutex;
 }
 
+/**
+ * Mark the start of a write to the object data. Must be called with the
+ * object mutex held; the data version becomes odd so lock-free readers
+ * know a write is in progress. Write sections nest (a field write inside
+ * unpack()), only the outermost one bumps the version.
+ */
+void UAVObject::beginDataWrite()
+{
+    if (dataWriteNesting++ == 0) {
+        dataVersion.fetchAndAddOrdered(1);
+    }
+}
+
+/**
+ * Mark the end of a write to the object data, making the version even
+ * again. Readers that copied the data during the write will retry.
+ */
+void UAVObject::endDataWrite()
+{
+    if (--dataWriteNesting == 0) {
+        dataVersion.fetchAndAddOrdered(1);
+    }
+}
+
+/**
+ * Start a lock-free read of the object data: returns the current data
+ * version, spinning out a write in progress. Writers only hold the odd
+ * state for the duration of a memcpy, so the spin is short.
+ */
+int UAVObject::beginDataRead()
+{
+    int version;
+
+    do {
+        version = dataVersion.loadAcquire();
+    } while (version & 1);
+    return version;
+}
+
+/**
+ * Finish a lock-free read of the object data: returns true if a write
+ * raced the read and the copied data must be thrown away and read again.
+ */
+bool UAVObject::retryDataRead(int version)
+{
+    return dataVersion.loadAcquire() != version;
+}
+
 /**
  * Get the number of fields held by this object
  */
@@ -293,6 +344,36 @@ UAVObjectField *UAVObject::getField(const QString & name)
     return NULL;
 }
 
+/**
+ * Get a specific field by its index, see the generated FieldIndex
+ * enumeration of each object.  Unlike getField() this does not compare
+ * name strings, so it is the accessor to use on telemetry-driven paths.
+ * @returns The field or NULL if the index is out of range
+ */
+UAVObjectField *UAVObject::getFieldByIndex(qint32 index)
+{
+    QMutexLocker locker(mutex);
+
+    if (index < 0 || index >= fields.count()) {
+        qWarning() << "UAVObject::getFieldByIndex Field index" << index << "out of range."
+                   << "This indicates a bug. Make sure you also have null checking for non-debug code.";
+        return NULL;
+    }
+    return fields[index];
+}
+
+/**
+ * Get the index of a field, suitable for getFieldByIndex() on this
+ * object or on a clone of it
+ * @returns The field index or -1 if the field does not belong to this object
+ */
+qint32 UAVObject::getFieldIndex(UAVObjectField *field)
+{
+    QMutexLocker locker(mutex);
+
+    return fields.indexOf(field);
+}
+
 /**
  * Pack the object data into a byte array
  * @returns The number of bytes copied
@@ -318,16 +399,92 @@ qint32 UAVObject::unpack(const quint8 *dataIn)
     QMutexLocker locker(mutex);
     qint32 offset = 0;
 
+    beginDataWrite();
     for (int n = 0; n < fields.length(); ++n) {
         fields[n]->unpack(&dataIn[offset]);
         offset += fields[n]->getNumBytes();
     }
+    endDataWrite();
     emit objectUnpacked(this); // trigger object updated event
-    emit objectUpdated(this);
+    emitObjectUpdated();
 
     return numBytes;
 }
 
+/**
+ * Emit objectUpdated, coalescing high rate update bursts to roughly the GUI
+ * frame rate.  The first update of a burst is emitted immediately; updates
+ * arriving within UPDATE_COALESCE_MS of an emission are folded into a single
+ * trailing one.  Consumers read the current object data when the signal is
+ * delivered, so the last received value always wins.  Consumers that need
+ * every single update (e.g. telemetry transaction handling) connect to
+ * objectUnpacked or the objectUpdatedAuto/Manual/Periodic signals instead,
+ * which are never coalesced.
+ *
+ * May be called from any thread; the emission itself always happens on the
+ * object's own thread.
+ */
+void UAVObject::emitObjectUpdated()
+{
+    bool schedule;
+
+    {
+        QMutexLocker locker(mutex);
+        schedule = !updateEmitScheduled;
+        updateEmitScheduled = true;
+    }
+    if (schedule) {
+        // further updates arriving before delivery are folded into this one
+        QMetaObject::invokeMethod(this, "emitCoalescedUpdate", Qt::QueuedConnection);
+    }
+}
+
+/**
+ * Runs on the object's thread.  Emits the pending objectUpdated unless an
+ * emission happened less than UPDATE_COALESCE_MS ago, in which case the
+ * running timer picks the update up when the window expires.
+ */
+void UAVObject::emitCoalescedUpdate()
+{
+    {
+        QMutexLocker locker(mutex);
+        if (updateCoalesceTimer == NULL) {
+            // created here so the timer lives in the object's thread
+            updateCoalesceTimer = new QTimer(this);
+            updateCoalesceTimer->setSingleShot(true);
+            updateCoalesceTimer->setInterval(UPDATE_COALESCE_MS);
+            connect(updateCoalesceTimer, SIGNAL(timeout()), this, SLOT(coalesceTimeout()));
+        }
+        if (updateCoalesceTimer->isActive()) {
+            // keep updateEmitScheduled set, coalesceTimeout() will emit
+            return;
+        }
+        updateEmitScheduled = false;
+        updateCoalesceTimer->start();
+    }
+    emit objectUpdated(this);
+}
+
+/**
+ * Coalescing window expired, emit the trailing update if one was folded in
+ */
+void UAVObject::coalesceTimeout()
+{
+    bool pending;
+
+    {
+        QMutexLocker locker(mutex);
+        pending = updateEmitScheduled;
+        if (pending) {
+            updateEmitScheduled = false;
+            updateCoalesceTimer->start();
+        }
+    }
+    if (pending) {
+        emit objectUpdated(this);
+    }
+}
+
 /**
  * Update a CRC with the object data
  * @returns The updated CRC
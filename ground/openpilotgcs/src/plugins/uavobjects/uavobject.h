@@ -33,9 +33,11 @@
 #include <QObject>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QAtomicInt>
 #include <QString>
 #include <QList>
 #include <QFile>
+#include <QTimer>
 #include <stdint.h>
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
@@ -126,9 +128,19 @@ public:
     void lock(int timeoutMs);
     void unlock();
     QMutex *getMutex();
+    // Seqlock style access to the object data: writers serialize on the
+    // object mutex and bump the data version around their write, readers
+    // copy the data and retry if a write raced them instead of taking
+    // the mutex and blocking the telemetry writer.
+    void beginDataWrite();
+    void endDataWrite();
+    int beginDataRead();
+    bool retryDataRead(int version);
     qint32 getNumFields();
     QList<UAVObjectField *> getFields();
     UAVObjectField *getField(const QString & name);
+    UAVObjectField *getFieldByIndex(qint32 index);
+    qint32 getFieldIndex(UAVObjectField *field);
     QString toString();
     QString toStringBrief();
     QString toStringData();
@@ -198,12 +210,28 @@ protected:
     void initializeFields(QList<UAVObjectField *> & fields, quint8 *data, quint32 numBytes);
     void setDescription(const QString & description);
     void setCategory(const QString & category);
+    void emitObjectUpdated();
 
 private:
+    // Coalescing window for objectUpdated, roughly one GUI frame.
+    // Signals that drive telemetry transactions are not coalesced.
+    static const int UPDATE_COALESCE_MS = 33;
+
     bool m_isKnown;
+    QTimer *updateCoalesceTimer; // created lazily, lives in the object's thread
+    bool updateEmitScheduled;
+
+    // Version counter of the object data, odd while a write is in
+    // progress.  The nesting count (guarded by the object mutex) keeps
+    // field level writes inside an object level write from ending the
+    // write section early.
+    QAtomicInt dataVersion;
+    int dataWriteNesting;
 
 private slots:
     void fieldUpdated(UAVObjectField *field);
+    void emitCoalescedUpdate();
+    void coalesceTimeout();
 };
 
 #endif // UAVOBJECT_H
@@ -47,6 +47,28 @@ UAVObjectField::UAVObjectField(const QString & name, const QString & description
     constructorInitialize(name, description, units, type, elementNames, options, limits);
 }
 
+/**
+ * Construct a field from an immutable template. The Qt containers are
+ * implicitly shared, so the strings, element names, options and parsed
+ * limits are not duplicated and the already parsed limit rules are
+ * reused instead of being parsed again.
+ */
+UAVObjectField::UAVObjectField(const UAVObjectField *fieldTemplate)
+{
+    this->name = fieldTemplate->name;
+    this->description   = fieldTemplate->description;
+    this->units         = fieldTemplate->units;
+    this->type          = fieldTemplate->type;
+    this->options       = fieldTemplate->options;
+    this->elementNames  = fieldTemplate->elementNames;
+    this->numElements   = fieldTemplate->numElements;
+    this->numBytesPerElement = fieldTemplate->numBytesPerElement;
+    this->elementLimits = fieldTemplate->elementLimits;
+    this->offset        = 0;
+    this->data          = NULL;
+    this->obj           = NULL;
+}
+
 void UAVObjectField::constructorInitialize(const QString & name, const QString & description, const QString & units, FieldType type, const QStringList & elementNames, const QStringList & options, const QString &limits)
 {
     // Copy params
@@ -637,6 +659,7 @@ void UAVObjectField::clear()
 {
     QMutexLocker locker(obj->getMutex());
 
+    obj->beginDataWrite();
     switch (type) {
     case BITFIELD:
         memset(&data[offset], 0, numBytesPerElement * ((quint32)(1 + (numElements - 1) / 8)));
@@ -645,6 +668,7 @@ void UAVObjectField::clear()
         memset(&data[offset], 0, numBytesPerElement * numElements);
         break;
     }
+    obj->endDataWrite();
 }
 
 QString UAVObjectField::getName()
@@ -837,6 +861,7 @@ qint32 UAVObjectField::unpack(const quint8 *dataIn)
 {
     QMutexLocker locker(obj->getMutex());
 
+    obj->beginDataWrite();
     // Unpack each element from input buffer
     switch (type) {
     case INT8:
@@ -896,6 +921,7 @@ qint32 UAVObjectField::unpack(const quint8 *dataIn)
         memcpy(&data[offset], dataIn, numElements);
         break;
     }
+    obj->endDataWrite();
     // Done
     return getNumBytes();
 }
@@ -1102,6 +1128,7 @@ void UAVObjectField::setValue(const QVariant & value, quint32 index)
     UAVObject::Metadata mdata = obj->getMetadata();
     // Update value if the access mode permits
     if (UAVObject::GetGcsAccess(mdata) == UAVObject::ACCESS_READWRITE) {
+        obj->beginDataWrite();
         switch (type) {
         case INT8:
         {
@@ -1175,15 +1202,122 @@ void UAVObjectField::setValue(const QVariant & value, quint32 index)
             break;
         }
         }
+        obj->endDataWrite();
     }
 }
 
+/**
+ * Get the value of a numeric field element as a double, reading it straight
+ * out of the packed data buffer.  Unlike getValue() this involves no QVariant
+ * construction, which matters for consumers polling fields at full telemetry
+ * rate (scopes, dials, the object browser).
+ */
 double UAVObjectField::getDouble(quint32 index)
 {
-    return getValue(index).toDouble();
+    QMutexLocker locker(obj->getMutex());
+
+    // Check that index is not out of bounds
+    if (index >= numElements) {
+        return 0.0;
+    }
+    switch (type) {
+    case INT8:
+    {
+        qint8 tmpint8;
+        memcpy(&tmpint8, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        return tmpint8;
+    }
+    case INT16:
+    {
+        qint16 tmpint16;
+        memcpy(&tmpint16, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        return tmpint16;
+    }
+    case INT32:
+    {
+        qint32 tmpint32;
+        memcpy(&tmpint32, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        return tmpint32;
+    }
+    case UINT8:
+    {
+        quint8 tmpuint8;
+        memcpy(&tmpuint8, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        return tmpuint8;
+    }
+    case UINT16:
+    {
+        quint16 tmpuint16;
+        memcpy(&tmpuint16, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        return tmpuint16;
+    }
+    case UINT32:
+    {
+        quint32 tmpuint32;
+        memcpy(&tmpuint32, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        return tmpuint32;
+    }
+    case FLOAT32:
+    {
+        float tmpfloat;
+        memcpy(&tmpfloat, &data[offset + numBytesPerElement * index], numBytesPerElement);
+        return tmpfloat;
+    }
+    case BITFIELD:
+    {
+        quint8 tmpbitfield;
+        memcpy(&tmpbitfield, &data[offset + numBytesPerElement * ((quint32)(index / 8))], numBytesPerElement);
+        return (tmpbitfield >> (index % 8)) & 1;
+    }
+    case ENUM:
+    case STRING:
+        // not numeric, keep the historic QVariant conversion behaviour
+        return getValue(index).toDouble();
+    }
+    // If this point is reached then we got an invalid type
+    return 0.0;
 }
 
 void UAVObjectField::setDouble(double value, quint32 index)
 {
     setValue(QVariant(value), index);
 }
+
+/**
+ * Same as getDouble() but returns a float
+ */
+float UAVObjectField::getFloat(quint32 index)
+{
+    return (float)getDouble(index);
+}
+
+/**
+ * Same as getDouble() but returns an integer
+ */
+qint32 UAVObjectField::getInt(quint32 index)
+{
+    return (qint32)getDouble(index);
+}
+
+/**
+ * Get the index of the currently selected option of an ENUM field element,
+ * without going through the option string like getValue() does.
+ * @returns The option index or -1 if the field is not an ENUM or the element
+ *          index is out of bounds
+ */
+int UAVObjectField::getEnumIndex(quint32 index)
+{
+    QMutexLocker locker(obj->getMutex());
+
+    // Check the type and that index is not out of bounds
+    if ((type != ENUM) || (index >= numElements)) {
+        return -1;
+    }
+    quint8 tmpenum;
+    memcpy(&tmpenum, &data[offset + numBytesPerElement * index], numBytesPerElement);
+    if (tmpenum >= options.length()) {
+        // same fallback as getValue()
+        tmpenum = 0;
+    }
+    return tmpenum;
+}
@@ -54,6 +54,7 @@ public:
 
     UAVObjectField(const QString & name, const QString & description, const QString & units, FieldType type, quint32 numElements, const QStringList & options, const QString & limits = QString());
     UAVObjectField(const QString & name, const QString & description, const QString & units, FieldType type, const QStringList & elementNames, const QStringList & options, const QString & limits = QString());
+    UAVObjectField(const UAVObjectField *fieldTemplate);
     void initialize(quint8 *data, quint32 dataOffset, UAVObject *obj);
     UAVObject *getObject();
     FieldType getType();
@@ -71,6 +72,9 @@ public:
     void setValue(const QVariant & data, quint32 index = 0);
     double getDouble(quint32 index = 0);
     void setDouble(double value, quint32 index = 0);
+    float getFloat(quint32 index = 0);
+    qint32 getInt(quint32 index = 0);
+    int getEnumIndex(quint32 index = 0);
     quint32 getDataOffset();
     quint32 getNumBytes();
     bool isNumeric();
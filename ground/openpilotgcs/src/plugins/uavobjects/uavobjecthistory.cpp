@@ -0,0 +1,174 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavobjecthistory.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2014.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief      The UAVUObjects GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "uavobjecthistory.h"
+
+#include "uavdataobject.h"
+#include "uavobjectfield.h"
+
+#include <QDateTime>
+#include <QDebug>
+
+UAVObjectHistoryColumn::UAVObjectHistoryColumn(int capacity) :
+    instId(0),
+    element(0),
+    m_capacity(capacity),
+    m_first(0),
+    m_count(0)
+{}
+
+void UAVObjectHistoryColumn::append(double timestamp, double value)
+{
+    if (m_count == m_timestamps.size() && m_count < m_capacity) {
+        // grow geometrically up to the capacity, unwinding the ring so
+        // the new room lands behind the newest sample
+        int newSize = qMin(qMax(m_timestamps.size() * 2, 64), m_capacity);
+        QVector<double> timestamps;
+        QVector<double> values;
+        timestamps.reserve(newSize);
+        values.reserve(newSize);
+        for (int i = 0; i < m_count; i++) {
+            timestamps.append(this->timestamp(i));
+            values.append(this->value(i));
+        }
+        timestamps.resize(newSize);
+        values.resize(newSize);
+        m_timestamps = timestamps;
+        m_values     = values;
+        m_first      = 0;
+    }
+
+    if (m_count < m_timestamps.size()) {
+        int index = (m_first + m_count) % m_timestamps.size();
+        m_timestamps[index] = timestamp;
+        m_values[index]     = value;
+        m_count++;
+    } else {
+        // full: overwrite the oldest sample
+        m_timestamps[m_first] = timestamp;
+        m_values[m_first]     = value;
+        m_first = (m_first + 1) % m_timestamps.size();
+    }
+}
+
+UAVObjectHistory::UAVObjectHistory(UAVObjectManager *objMngr, QObject *parent) :
+    QObject(parent),
+    m_objectManager(objMngr),
+    m_capacity(DEFAULT_CAPACITY)
+{}
+
+UAVObjectHistory::~UAVObjectHistory()
+{
+    qDeleteAll(m_columns);
+}
+
+void UAVObjectHistory::setCapacity(int samples)
+{
+    m_capacity = samples;
+}
+
+static QString columnKey(const QString &objectName, quint32 instId, const QString &fieldName, int element)
+{
+    return QString("%1:%2:%3:%4").arg(objectName).arg(instId).arg(fieldName).arg(element);
+}
+
+UAVObjectHistoryColumn *UAVObjectHistory::column(const QString &objectName, quint32 instId, const QString &fieldName, int element)
+{
+    QString key = columnKey(objectName, instId, fieldName, element);
+
+    UAVObjectHistoryColumn *column = m_columns.value(key);
+
+    if (column) {
+        return column;
+    }
+
+    UAVObject *obj = m_objectManager->getObject(objectName, instId);
+    if (obj == NULL) {
+        return NULL;
+    }
+    if (!m_captured.contains(obj)) {
+        captureObject(obj);
+    }
+    return m_columns.value(key);
+}
+
+/**
+ * Creates the columns for every numeric field element of the object and
+ * hooks its update signal.  The connection is automatic, so updates
+ * emitted on the telemetry thread are appended on the store's thread.
+ */
+void UAVObjectHistory::captureObject(UAVObject *obj)
+{
+    QList<UAVObjectHistoryColumn *> columns;
+    foreach(UAVObjectField * field, obj->getFields()) {
+        if (!field->isNumeric()) {
+            continue;
+        }
+        for (quint32 element = 0; element < field->getNumElements(); element++) {
+            UAVObjectHistoryColumn *column = new UAVObjectHistoryColumn(m_capacity);
+            column->objectName = obj->getName();
+            column->instId     = obj->getInstID();
+            column->fieldName  = field->getName();
+            column->element    = element;
+            m_columns.insert(columnKey(column->objectName, column->instId, column->fieldName, element), column);
+            columns.append(column);
+        }
+    }
+    m_captured.insert(obj, columns);
+
+    connect(obj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objectUpdated(UAVObject *)));
+}
+
+void UAVObjectHistory::objectUpdated(UAVObject *obj)
+{
+    QList<UAVObjectHistoryColumn *> columns = m_captured.value(obj);
+
+    if (columns.isEmpty()) {
+        return;
+    }
+
+    double now = QDateTime::currentMSecsSinceEpoch() / 1000.0;
+
+    // fields and elements enumerate in the same order captureObject()
+    // created the columns in
+    int index  = 0;
+    foreach(UAVObjectField * field, obj->getFields()) {
+        if (!field->isNumeric()) {
+            continue;
+        }
+        for (quint32 element = 0; element < field->getNumElements(); element++) {
+            columns.at(index++)->append(now, field->getValue(element).toDouble());
+        }
+    }
+
+    emit historyUpdated(obj);
+}
+/**
+ * @}
+ * @}
+ */
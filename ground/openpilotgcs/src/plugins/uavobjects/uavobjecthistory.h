@@ -0,0 +1,155 @@
+/**
+ ******************************************************************************
+ *
+ * @file       uavobjecthistory.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2014.
+ * @see        The GNU Public License (GPL) Version 3
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVObjectsPlugin UAVObjects Plugin
+ * @{
+ * @brief      The UAVUObjects GCS plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef UAVOBJECTHISTORY_H
+#define UAVOBJECTHISTORY_H
+
+#include "uavobjects_global.h"
+#include "uavobjectmanager.h"
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+/**
+ * Ring bounded column of samples for one field element of one object
+ * instance.  Owned by UAVObjectHistory; consumers hold the pointer the
+ * store hands out and index into it without copying.  Columns are only
+ * touched on the store's thread, so a gadget living on the same (GUI)
+ * thread can read them directly from its paint and update paths.
+ */
+class UAVOBJECTS_EXPORT UAVObjectHistoryColumn {
+public:
+    int size() const
+    {
+        return m_count;
+    }
+    bool isEmpty() const
+    {
+        return m_count == 0;
+    }
+    //! sample time in fractional seconds since the epoch
+    double timestamp(int index) const
+    {
+        return m_timestamps.at(physicalIndex(index));
+    }
+    double value(int index) const
+    {
+        return m_values.at(physicalIndex(index));
+    }
+    double lastTimestamp() const
+    {
+        return timestamp(m_count - 1);
+    }
+    double lastValue() const
+    {
+        return value(m_count - 1);
+    }
+
+    QString objectName;
+    quint32 instId;
+    QString fieldName;
+    int element;
+
+private:
+    friend class UAVObjectHistory;
+
+    UAVObjectHistoryColumn(int capacity);
+
+    void append(double timestamp, double value);
+    int physicalIndex(int index) const
+    {
+        return (m_first + index) % m_timestamps.size();
+    }
+
+    // circular storage, grown geometrically up to the capacity so idle
+    // columns stay small
+    QVector<double> m_timestamps;
+    QVector<double> m_values;
+    int m_capacity;
+    int m_first;
+    int m_count;
+};
+
+/**
+ * Shared in-memory time series store over the object registry.  Fed once
+ * from the object update signals, it keeps one ring bounded column per
+ * numeric field element of every object a consumer asked for, so scope
+ * gadgets, the map trail and export features can share a single history
+ * instead of each buffering their own copy of the telemetry stream.
+ *
+ * Capture is per object and starts with the first column() call for it;
+ * objects nobody asked about cost nothing.  The per column capacity
+ * bounds total memory no matter how long the session runs.
+ */
+class UAVOBJECTS_EXPORT UAVObjectHistory : public QObject {
+    Q_OBJECT
+
+public:
+    explicit UAVObjectHistory(UAVObjectManager *objMngr, QObject *parent = 0);
+    ~UAVObjectHistory();
+
+    /**
+     * Returns the column for one field element, starting capture of the
+     * object if this is the first interest in it.  The pointer stays
+     * valid for the lifetime of the store.  NULL if the object or field
+     * does not exist or the field is not numeric.
+     */
+    UAVObjectHistoryColumn *column(const QString &objectName, quint32 instId, const QString &fieldName, int element = 0);
+
+    //! per column sample bound applied to columns created afterwards
+    void setCapacity(int samples);
+    int capacity() const
+    {
+        return m_capacity;
+    }
+
+signals:
+    //! emitted once per captured object update, after its columns grew
+    void historyUpdated(UAVObject *obj);
+
+private slots:
+    void objectUpdated(UAVObject *obj);
+
+private:
+    void captureObject(UAVObject *obj);
+
+    // 1h at 10Hz; 16 bytes per sample keeps a fully grown column under
+    // 600KB and columns only exist for requested fields
+    static const int DEFAULT_CAPACITY = 36000;
+
+    UAVObjectManager *m_objectManager;
+    int m_capacity;
+    // objects whose updates are captured, value lists the columns to
+    // append to in field/element order
+    QHash<UAVObject *, QList<UAVObjectHistoryColumn *> > m_captured;
+    QHash<QString, UAVObjectHistoryColumn *> m_columns;
+};
+
+#endif // UAVOBJECTHISTORY_H
@@ -33,6 +33,7 @@
 #include "uavdataobject.h"
 #include "uavmetaobject.h"
 #include <QList>
+#include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QJsonObject>
@@ -69,9 +70,15 @@ private:
     static const quint32 MAX_INSTANCES = 1000;
 
     QList< QList<UAVObject *> > objects;
+    // Persistent lookup indices into the objects list.  Object types are
+    // never unregistered so the cached indices stay valid for the whole
+    // manager lifetime.
+    QHash<quint32, int> objectsByObjId;
+    QHash<QString, int> objectsByName;
     QMutex *mutex;
 
     void addObject(UAVObject *obj);
+    int getObjectIndex(const QString *name, quint32 objId);
     UAVObject *getObject(const QString *name, quint32 objId, quint32 instId);
     QList<UAVObject *> getObjectInstances(const QString *name, quint32 objId);
     qint32 getNumInstances(const QString *name, quint32 objId);
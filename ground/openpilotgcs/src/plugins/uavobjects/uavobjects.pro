@@ -13,6 +13,7 @@ HEADERS += \
     uavobjectmanager.h \
     uavdataobject.h \
     uavobjectfield.h \
+    uavobjecthistory.h \
     uavobjectsinit.h \
     uavobjectsplugin.h
 SOURCES += \
@@ -21,6 +22,7 @@ SOURCES += \
     uavobjectmanager.cpp \
     uavdataobject.cpp \
     uavobjectfield.cpp \
+    uavobjecthistory.cpp \
     uavobjectsplugin.cpp
 
 OTHER_FILES += UAVObjects.pluginspec
@@ -27,6 +27,7 @@
  */
 #include "uavobjectsplugin.h"
 #include "uavobjectsinit.h"
+#include "uavobjecthistory.h"
 
 UAVObjectsPlugin::UAVObjectsPlugin()
 {}
@@ -45,6 +46,8 @@ bool UAVObjectsPlugin::initialize(const QStringList & arguments, QString *errorS
     addAutoReleasedObject(objMngr);
     // Initialize UAVObjects
     UAVObjectsInitialize(objMngr);
+    // Shared telemetry history store over the registry
+    addAutoReleasedObject(new UAVObjectHistory(objMngr));
     // Done
     Q_UNUSED(arguments);
     Q_UNUSED(errorString);
@@ -107,3 +107,100 @@ void UAVObjectRequestHelper::doObjectAndWaitImpl()
 {
     m_object->requestUpdate();
 }
+
+AbstractUAVObjectBatchHelper::AbstractUAVObjectBatchHelper(QObject *parent) :
+    QObject(parent), m_timeoutTimer(NULL), m_timeout(0), m_pendingCount(0), m_transactionResult(false)
+{}
+
+AbstractUAVObjectBatchHelper::~AbstractUAVObjectBatchHelper()
+{}
+
+AbstractUAVObjectBatchHelper::Result AbstractUAVObjectBatchHelper::doObjectsAndWait(const QList<UAVObject *> &objects, int timeout)
+{
+    // Lock, we can't call this twice from different threads
+    QMutexLocker locker(&m_mutex);
+
+    if (objects.isEmpty()) {
+        return SUCCESS;
+    }
+
+    // Reset variables
+    m_transactionResult = true;
+    m_pendingCount = objects.count();
+    m_timeout = timeout;
+
+    // Create timer and connect it, connect object tx completed to local slot
+    QTimer timeoutTimer;
+    timeoutTimer.setSingleShot(true);
+    m_timeoutTimer = &timeoutTimer;
+    connect(&timeoutTimer, SIGNAL(timeout()), &m_eventLoop, SLOT(quit()));
+    foreach(UAVObject * object, objects) {
+        connect(object, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(transactionCompleted(UAVObject *, bool)));
+    }
+
+    // Start timeout timer
+    timeoutTimer.start(timeout);
+
+    // Start all transactions, the acks are matched per object and instance
+    foreach(UAVObject * object, objects) {
+        doObjectImpl(object);
+    }
+
+    // Wait if not completed
+    if (m_pendingCount > 0) {
+        m_eventLoop.exec();
+    }
+    timeoutTimer.stop();
+    m_timeoutTimer = NULL;
+
+    // Disconnect
+    foreach(UAVObject * object, objects) {
+        disconnect(object, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(transactionCompleted(UAVObject *, bool)));
+    }
+    disconnect(&timeoutTimer, SIGNAL(timeout()), &m_eventLoop, SLOT(quit()));
+
+    // Return result
+    if (m_pendingCount > 0) {
+        return TIMEOUT;
+    } else {
+        return m_transactionResult ? SUCCESS : FAIL;
+    }
+}
+
+void AbstractUAVObjectBatchHelper::transactionCompleted(UAVObject *object, bool success)
+{
+    Q_UNUSED(object)
+
+    // Set variables and quit event loop once the whole batch completed
+    if (!success) {
+        m_transactionResult = false;
+    }
+    if (--m_pendingCount == 0) {
+        m_eventLoop.quit();
+    } else if (m_timeoutTimer) {
+        // the timeout applies per transaction, not to the batch as a whole
+        m_timeoutTimer->start(m_timeout);
+    }
+}
+
+UAVObjectBatchUpdaterHelper::UAVObjectBatchUpdaterHelper(QObject *parent) : AbstractUAVObjectBatchHelper(parent)
+{}
+
+UAVObjectBatchUpdaterHelper::~UAVObjectBatchUpdaterHelper()
+{}
+
+void UAVObjectBatchUpdaterHelper::doObjectImpl(UAVObject *object)
+{
+    object->updated();
+}
+
+UAVObjectBatchRequestHelper::UAVObjectBatchRequestHelper(QObject *parent) : AbstractUAVObjectBatchHelper(parent)
+{}
+
+UAVObjectBatchRequestHelper::~UAVObjectBatchRequestHelper()
+{}
+
+void UAVObjectBatchRequestHelper::doObjectImpl(UAVObject *object)
+{
+    object->requestUpdate();
+}
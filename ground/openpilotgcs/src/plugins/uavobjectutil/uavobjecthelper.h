@@ -32,6 +32,7 @@
 #include <QEventLoop>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QTimer>
 
 #include "uavobjectutil_global.h"
 #include "uavobject.h"
@@ -82,4 +83,57 @@ protected:
     virtual void doObjectAndWaitImpl();
 };
 
+/**
+ * Performs a batch of acked object transactions with all of them in flight
+ * at the same time, instead of paying a full round trip per object.
+ * The telemetry layer tracks transactions per object and instance, so the
+ * acks are matched up individually. Useful when sending or requesting many
+ * instances of a multi instance object, e.g. a path plan.
+ */
+class UAVOBJECTUTIL_EXPORT AbstractUAVObjectBatchHelper : public QObject {
+    Q_OBJECT
+public:
+    explicit AbstractUAVObjectBatchHelper(QObject *parent = 0);
+    virtual ~AbstractUAVObjectBatchHelper();
+
+    enum Result { SUCCESS, FAIL, TIMEOUT };
+
+    // the timeout applies per transaction, it is restarted whenever one completes
+    Result doObjectsAndWait(const QList<UAVObject *> &objects, int timeout = 800);
+
+protected:
+    virtual void doObjectImpl(UAVObject *object) = 0;
+
+private slots:
+    void transactionCompleted(UAVObject *object, bool success);
+
+private:
+    QMutex m_mutex;
+    QEventLoop m_eventLoop;
+    QTimer *m_timeoutTimer;
+    int m_timeout;
+    int m_pendingCount;
+    bool m_transactionResult;
+};
+
+class UAVOBJECTUTIL_EXPORT UAVObjectBatchUpdaterHelper : public AbstractUAVObjectBatchHelper {
+    Q_OBJECT
+public:
+    explicit UAVObjectBatchUpdaterHelper(QObject *parent = 0);
+    virtual ~UAVObjectBatchUpdaterHelper();
+
+protected:
+    virtual void doObjectImpl(UAVObject *object);
+};
+
+class UAVOBJECTUTIL_EXPORT UAVObjectBatchRequestHelper : public AbstractUAVObjectBatchHelper {
+    Q_OBJECT
+public:
+    explicit UAVObjectBatchRequestHelper(QObject *parent = 0);
+    virtual ~UAVObjectBatchRequestHelper();
+
+protected:
+    virtual void doObjectImpl(UAVObject *object);
+};
+
 #endif // UAVOBJECTHELPER_H
@@ -105,6 +105,23 @@ void UAVObjectUtilManager::saveObjectToSD(UAVObject *obj)
     }
 }
 
+/*
+   Ask the board to persist every settings object that differs from its flash
+   copy in a single ObjectPersistence operation. Much faster than queueing the
+   objects one by one when restoring a complete profile, especially over radio
+   telemetry where every save is a full round trip plus a flash write.
+ */
+void UAVObjectUtilManager::saveAllSettingsToSD()
+{
+    // A null entry in the queue stands for "all settings"
+    queue.enqueue(NULL);
+    qDebug() << "Enqueue all settings save";
+
+    if (queue.length() == 1) {
+        saveNextObject();
+    }
+}
+
 void UAVObjectUtilManager::saveNextObject()
 {
     if (queue.isEmpty()) {
@@ -113,23 +130,27 @@ void UAVObjectUtilManager::saveNextObject()
 
     Q_ASSERT(saveState == IDLE);
 
-    // Get next object from the queue
+    // Get next object from the queue, a null object means "all settings"
     UAVObject *obj = queue.head();
-    qDebug() << "Send save object request to board " << obj->getName();
+    qDebug() << "Send save object request to board " << (obj ? obj->getName() : QString("<all settings>"));
 
     ObjectPersistence *objper = dynamic_cast<ObjectPersistence *>(getObjectManager()->getObject(ObjectPersistence::NAME));
     connect(objper, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(objectPersistenceTransactionCompleted(UAVObject *, bool)));
     connect(objper, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objectPersistenceUpdated(UAVObject *)));
     saveState = AWAITING_ACK;
+    ObjectPersistence::DataFields data;
+    data.Operation = ObjectPersistence::OPERATION_SAVE;
     if (obj != NULL) {
-        ObjectPersistence::DataFields data;
-        data.Operation  = ObjectPersistence::OPERATION_SAVE;
         data.Selection  = ObjectPersistence::SELECTION_SINGLEOBJECT;
         data.ObjectID   = obj->getObjID();
         data.InstanceID = obj->getInstID();
-        objper->setData(data);
-        objper->updated();
+    } else {
+        data.Selection  = ObjectPersistence::SELECTION_ALLSETTINGS;
+        data.ObjectID   = 0;
+        data.InstanceID = 0;
     }
+    objper->setData(data);
+    objper->updated();
     // Now: we are going to get two "objectUpdated" messages (one coming from GCS, one coming from Flight, which
     // will confirm the object was properly received by both sides) and then one "transactionCompleted" indicating
     // that the Flight side did not only receive the object but it did receive it without error. Last we will get
@@ -158,7 +179,9 @@ void UAVObjectUtilManager::objectPersistenceTransactionCompleted(UAVObject *obj,
         // the queue:
         saveState = AWAITING_COMPLETED;
         disconnect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(objectPersistenceTransactionCompleted(UAVObject *, bool)));
-        failureTimer.start(2000); // Create a timeout
+        // Create a timeout, allowing more time for an "all settings" save
+        // which can write dozens of objects to flash in one go
+        failureTimer.start(queue.head() ? 2000 : 10000);
     } else {
         // Can be caused by timeout errors on sending.  Forget it and send next.
         qDebug() << "objectPersistenceTranscationCompleted (error)";
@@ -186,12 +209,11 @@ void UAVObjectUtilManager::objectPersistenceOperationFailed()
         Q_ASSERT(objectPersistence);
 
         UAVObject *obj = queue.dequeue(); // We can now remove the object, it failed anyway.
-        Q_ASSERT(obj);
 
         objectPersistence->disconnect(this);
 
         saveState = IDLE;
-        emit saveCompleted(obj->getObjID(), false);
+        emit saveCompleted(obj ? obj->getObjID() : 0, false);
 
         saveNextObject();
     }
@@ -215,9 +237,9 @@ void UAVObjectUtilManager::objectPersistenceUpdated(UAVObject *obj)
     } else if (saveState == AWAITING_COMPLETED &&
                objectPersistence.Operation == ObjectPersistence::OPERATION_COMPLETED) {
         failureTimer.stop();
-        // Check right object saved
+        // Check right object saved (an all settings save echoes ObjectID 0)
         UAVObject *savingObj = queue.head();
-        if (objectPersistence.ObjectID != savingObj->getObjID()) {
+        if (savingObj && objectPersistence.ObjectID != savingObj->getObjID()) {
             objectPersistenceOperationFailed();
             return;
         }
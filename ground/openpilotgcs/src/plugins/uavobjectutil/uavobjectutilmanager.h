@@ -67,6 +67,7 @@ public:
     static bool descriptionToStructure(QByteArray desc, deviceDescriptorStruct & struc);
     UAVObjectManager *getObjectManager();
     void saveObjectToSD(UAVObject *obj);
+    void saveAllSettingsToSD();
 protected:
     FirmwareIAPObj::DataFields getFirmwareIap();
 
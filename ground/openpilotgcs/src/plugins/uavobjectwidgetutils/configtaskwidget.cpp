@@ -27,6 +27,7 @@
 #include "configtaskwidget.h"
 
 #include <uavtalk/telemetrymanager.h>
+#include <uavtalk/objectprefetcher.h>
 #include "uavsettingsimportexport/uavsettingsimportexportfactory.h"
 
 #include <QWidget>
@@ -34,7 +35,8 @@
 #include <QToolButton>
 
 ConfigTaskWidget::ConfigTaskWidget(QWidget *parent) : QWidget(parent), m_currentBoardId(-1), m_isConnected(false), m_isWidgetUpdatesAllowed(true),
-    m_saveButton(NULL), m_isDirty(false), m_outOfLimitsStyle("background-color: rgb(255, 0, 0);"), m_realtimeUpdateTimer(NULL)
+    m_saveButton(NULL), m_isDirty(false), m_outOfLimitsStyle("background-color: rgb(255, 0, 0);"), m_realtimeUpdateTimer(NULL),
+    m_refreshScheduled(false)
 {
     m_pluginManager     = ExtensionSystem::PluginManager::instance();
     TelemetryManager *telMngr = m_pluginManager->getObject<TelemetryManager>();
@@ -132,9 +134,12 @@ void ConfigTaskWidget::doAddWidgetBinding(QString objectName, QString fieldName,
     if (!objectName.isEmpty()) {
         object = getObject(QString(objectName), instID);
         Q_ASSERT(object);
+        // Teach the connect-time retrieval that a config page binds this
+        // object so it is prefetched before the connection is announced
+        ObjectPrefetcher::registerObject(object->getName());
         m_updatedObjects.insert(object, true);
         connect(object, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(objectUpdated(UAVObject *)));
-        connect(object, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(refreshWidgetsValues(UAVObject *)), Qt::UniqueConnection);
+        connect(object, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(scheduleWidgetsRefresh(UAVObject *)), Qt::UniqueConnection);
     }
 
     if (!fieldName.isEmpty() && object) {
@@ -280,6 +285,8 @@ void ConfigTaskWidget::populateWidgets()
     foreach(WidgetBinding * binding, m_widgetBindingsPerObject) {
         if (binding->isEnabled() && binding->object() != NULL && binding->field() != NULL && binding->widget() != NULL) {
             setWidgetFromField(binding->widget(), binding->field(), binding);
+            binding->markClean(getVariantFromWidget(binding->widget(), binding));
+            m_dirtyBindings.remove(binding);
         }
     }
     setDirty(dirtyBack);
@@ -298,6 +305,9 @@ void ConfigTaskWidget::refreshWidgetsValues(UAVObject *obj)
         if (binding->field() != NULL && binding->widget() != NULL) {
             if (binding->isEnabled()) {
                 setWidgetFromField(binding->widget(), binding->field(), binding);
+                // The widget now mirrors the object again
+                binding->markClean(getVariantFromWidget(binding->widget(), binding));
+                m_dirtyBindings.remove(binding);
             } else {
                 binding->updateValueFromObjectField();
             }
@@ -306,6 +316,32 @@ void ConfigTaskWidget::refreshWidgetsValues(UAVObject *obj)
     setDirty(dirtyBack);
 }
 
+void ConfigTaskWidget::scheduleWidgetsRefresh(UAVObject *object)
+{
+    m_pendingRefreshObjects.insert(object);
+    if (!m_refreshScheduled) {
+        // Coalesce all object updates arriving within one event loop cycle
+        // into a single deferred refresh pass
+        m_refreshScheduled = true;
+        QTimer::singleShot(0, this, SLOT(performScheduledRefresh()));
+    }
+}
+
+void ConfigTaskWidget::performScheduledRefresh()
+{
+    QSet<UAVObject *> pending = m_pendingRefreshObjects;
+
+    m_pendingRefreshObjects.clear();
+    m_refreshScheduled = false;
+
+    if (!m_isWidgetUpdatesAllowed) {
+        return;
+    }
+    foreach(UAVObject * object, pending) {
+        refreshWidgetsValues(object);
+    }
+}
+
 void ConfigTaskWidget::updateObjectsFromWidgets()
 {
     emit updateObjectsFromWidgetsRequested();
@@ -421,6 +457,12 @@ void ConfigTaskWidget::widgetsContentsChanged()
             }
             binding->setValue(value);
 
+            if (binding->isClean(value)) {
+                m_dirtyBindings.remove(binding);
+            } else {
+                m_dirtyBindings.insert(binding);
+            }
+
             if (binding->widget() != emitter) {
                 disconnectWidgetUpdatesToSlot(binding->widget(), SLOT(widgetsContentsChanged()));
 
@@ -449,7 +491,12 @@ void ConfigTaskWidget::widgetsContentsChanged()
     if (m_saveButton) {
         m_saveButton->resetIcons();
     }
-    setDirty(true);
+    if (!m_dirtyBindings.isEmpty()) {
+        setDirty(true);
+    } else if (isDirty()) {
+        // Every tracked edit went back to its clean reference value
+        setDirty(false);
+    }
 }
 
 void ConfigTaskWidget::clearDirty()
@@ -459,9 +506,24 @@ void ConfigTaskWidget::clearDirty()
 
 void ConfigTaskWidget::setDirty(bool value)
 {
+    if (!value) {
+        // The widgets now represent the saved state: snapshot the clean
+        // reference values the per binding dirty tracking compares against
+        m_dirtyBindings.clear();
+        markAllBindingsClean();
+    }
     m_isDirty = value;
 }
 
+void ConfigTaskWidget::markAllBindingsClean()
+{
+    foreach(WidgetBinding * binding, m_widgetBindingsPerWidget) {
+        if (binding->isEnabled() && binding->widget() && binding->field()) {
+            binding->markClean(getVariantFromWidget(binding->widget(), binding));
+        }
+    }
+}
+
 bool ConfigTaskWidget::isDirty()
 {
     if (m_isConnected) {
@@ -476,7 +538,7 @@ void ConfigTaskWidget::disableObjectUpdates()
     m_isWidgetUpdatesAllowed = false;
     foreach(WidgetBinding * binding, m_widgetBindingsPerWidget) {
         if (binding->object()) {
-            disconnect(binding->object(), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(refreshWidgetsValues(UAVObject *)));
+            disconnect(binding->object(), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(scheduleWidgetsRefresh(UAVObject *)));
         }
     }
 }
@@ -486,7 +548,7 @@ void ConfigTaskWidget::enableObjectUpdates()
     m_isWidgetUpdatesAllowed = true;
     foreach(WidgetBinding * binding, m_widgetBindingsPerWidget) {
         if (binding->object()) {
-            connect(binding->object(), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(refreshWidgetsValues(UAVObject *)), Qt::UniqueConnection);
+            connect(binding->object(), SIGNAL(objectUpdated(UAVObject *)), this, SLOT(scheduleWidgetsRefresh(UAVObject *)), Qt::UniqueConnection);
         }
     }
 }
@@ -733,7 +795,8 @@ void ConfigTaskWidget::defaultButtonClicked()
             continue;
         }
         UAVDataObject *temp = ((UAVDataObject *)binding->object())->dirtyClone();
-        setWidgetFromField(binding->widget(), temp->getField(binding->field()->getName()), binding);
+        // The clone carries its fields in the same order, look up by index
+        setWidgetFromField(binding->widget(), temp->getFieldByIndex(binding->object()->getFieldIndex(binding->field())), binding);
     }
 }
 
@@ -1204,6 +1267,16 @@ void WidgetBinding::setValue(const QVariant &value)
      */
 }
 
+void WidgetBinding::markClean(const QVariant &value)
+{
+    m_cleanValue = value;
+}
+
+bool WidgetBinding::isClean(const QVariant &value) const
+{
+    return m_cleanValue.isValid() && m_cleanValue == value;
+}
+
 void WidgetBinding::updateObjectFieldFromValue()
 {
     if (m_value.isValid()) {
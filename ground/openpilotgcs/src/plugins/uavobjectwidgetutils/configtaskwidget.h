@@ -34,6 +34,7 @@
 #include <QQueue>
 #include <QWidget>
 #include <QList>
+#include <QSet>
 #include <QLabel>
 #include "smartsavebutton.h"
 #include "mixercurvewidget.h"
@@ -85,6 +86,11 @@ public:
     QVariant value() const;
     void setValue(const QVariant &value);
 
+    // Reference value the dirty state is computed against, captured when
+    // the page is known to match the object (populate, refresh, save)
+    void markClean(const QVariant &value);
+    bool isClean(const QVariant &value) const;
+
     void updateObjectFieldFromValue();
     void updateValueFromObjectField();
 
@@ -95,6 +101,7 @@ private:
     bool m_isEnabled;
     QList<ShadowWidgetBinding *> m_shadows;
     QVariant m_value;
+    QVariant m_cleanValue;
 };
 
 class UAVOBJECTWIDGETUTILS_EXPORT ConfigTaskWidget : public QWidget {
@@ -178,6 +185,8 @@ signals:
 
 private slots:
     void objectUpdated(UAVObject *object);
+    void scheduleWidgetsRefresh(UAVObject *object);
+    void performScheduledRefresh();
     void defaultButtonClicked();
     void reloadButtonClicked();
 
@@ -223,6 +232,15 @@ private:
     QString m_outOfLimitsStyle;
     QTimer *m_realtimeUpdateTimer;
 
+    // Objects whose refresh is coalesced into one pass per event loop cycle
+    QSet<UAVObject *> m_pendingRefreshObjects;
+    bool m_refreshScheduled;
+    // Bindings whose widget value differs from their clean reference; the
+    // dirty state is their emptiness instead of a full page recompute
+    QSet<WidgetBinding *> m_dirtyBindings;
+
+    void markAllBindingsClean();
+
     bool setWidgetFromField(QWidget *widget, UAVObjectField *field, WidgetBinding *binding);
 
     QVariant getVariantFromWidget(QWidget *widget, WidgetBinding *binding);
@@ -96,7 +96,8 @@ void ImportSummaryDialog::addLine(QString uavObjectName, QString text, bool stat
  */
 void ImportSummaryDialog::doTheSaving()
 {
-    int itemCount = 0;
+    int itemCount   = 0;
+    bool allChecked = true;
     ExtensionSystem::PluginManager *pm = ExtensionSystem::PluginManager::instance();
     UAVObjectManager *objManager = pm->getObject<UAVObjectManager>();
     UAVObjectUtilManager *utilManager  = pm->getObject<UAVObjectUtilManager>();
@@ -107,20 +108,32 @@ void ImportSummaryDialog::doTheSaving()
         QCheckBox *box = dynamic_cast<QCheckBox *>(ui->importSummaryList->cellWidget(i, 0));
         if (box->isChecked()) {
             ++itemCount;
+        } else if (box->isEnabled()) {
+            allChecked = false;
         }
     }
     if (itemCount == 0) {
         return;
     }
-    ui->progressBar->setMaximum(itemCount + 1);
-    ui->progressBar->setValue(1);
-    for (int i = 0; i < ui->importSummaryList->rowCount(); i++) {
-        QString uavObjectName = ui->importSummaryList->item(i, 1)->text();
-        QCheckBox *box = dynamic_cast<QCheckBox *>(ui->importSummaryList->cellWidget(i, 0));
-        if (box->isChecked()) {
-            UAVObject *obj = objManager->getObject(uavObjectName);
-            utilManager->saveObjectToSD(obj);
-            this->repaint();
+    if (allChecked) {
+        // The usual full profile restore: ask the board to persist every
+        // modified settings object in a single ObjectPersistence operation
+        // instead of round tripping one save per object, which takes minutes
+        // over radio telemetry.
+        ui->progressBar->setMaximum(2);
+        ui->progressBar->setValue(1);
+        utilManager->saveAllSettingsToSD();
+    } else {
+        ui->progressBar->setMaximum(itemCount + 1);
+        ui->progressBar->setValue(1);
+        for (int i = 0; i < ui->importSummaryList->rowCount(); i++) {
+            QString uavObjectName = ui->importSummaryList->item(i, 1)->text();
+            QCheckBox *box = dynamic_cast<QCheckBox *>(ui->importSummaryList->cellWidget(i, 0));
+            if (box->isChecked()) {
+                UAVObject *obj = objManager->getObject(uavObjectName);
+                utilManager->saveObjectToSD(obj);
+                this->repaint();
+            }
         }
     }
 
@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ *
+ * @file       objectprefetcher.cpp
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2014.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVTalkPlugin UAVTalk Plugin
+ * @{
+ * @brief The UAVTalk protocol plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#include "objectprefetcher.h"
+
+#include "coreplugin/icore.h"
+
+#include <QSettings>
+#include <QStringList>
+
+QSet<QString> ObjectPrefetcher::learnedObjects;
+bool ObjectPrefetcher::loaded = false;
+
+/**
+ * Record that a configuration page binds this object.  Newly learned
+ * objects are appended to the persisted set immediately, a config page
+ * opened once is enough for every later GCS session to prefetch its
+ * objects.
+ */
+void ObjectPrefetcher::registerObject(const QString & objectName)
+{
+    if (objectName.isEmpty()) {
+        return;
+    }
+
+    loadLearnedObjects();
+
+    if (learnedObjects.contains(objectName)) {
+        return;
+    }
+    learnedObjects.insert(objectName);
+
+    QSettings *settings = Core::ICore::instance()->settings();
+    settings->beginGroup(QLatin1String("ObjectPrefetcher"));
+    settings->setValue(QLatin1String("learnedObjects"), QStringList(learnedObjects.toList()));
+    settings->endGroup();
+}
+
+/**
+ * Whether a configuration page is known to bind this object
+ */
+bool ObjectPrefetcher::isLearnedObject(const QString & objectName)
+{
+    loadLearnedObjects();
+
+    return learnedObjects.contains(objectName);
+}
+
+void ObjectPrefetcher::loadLearnedObjects()
+{
+    if (loaded) {
+        return;
+    }
+    loaded = true;
+
+    QSettings *settings = Core::ICore::instance()->settings();
+    settings->beginGroup(QLatin1String("ObjectPrefetcher"));
+    foreach(const QString &objectName, settings->value(QLatin1String("learnedObjects")).toStringList()) {
+        learnedObjects.insert(objectName);
+    }
+    settings->endGroup();
+}
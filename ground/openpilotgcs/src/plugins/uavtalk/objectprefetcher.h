@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ *
+ * @file       objectprefetcher.h
+ * @author     The OpenPilot Team, http://www.openpilot.org Copyright (C) 2014.
+ * @addtogroup GCSPlugins GCS Plugins
+ * @{
+ * @addtogroup UAVTalkPlugin UAVTalk Plugin
+ * @{
+ * @brief The UAVTalk protocol plugin
+ *****************************************************************************/
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ */
+
+#ifndef OBJECTPREFETCHER_H
+#define OBJECTPREFETCHER_H
+
+#include "uavtalk_global.h"
+
+#include <QSet>
+#include <QString>
+
+/**
+ * Registry of the objects the configuration pages bind to their widgets.
+ *
+ * ConfigTaskWidget reports every object it binds; the set is persisted
+ * in the GCS settings so it is already known the next time the GCS
+ * starts, before any config page has been opened.  TelemetryMonitor
+ * moves the learned objects to the front of the connect-time retrieval
+ * queue, so by the time the connection is announced the config pages
+ * have fresh data and open instantly instead of waiting on a
+ * multi-second bulk fetch over a radio link.
+ */
+class UAVTALK_EXPORT ObjectPrefetcher {
+public:
+    static void registerObject(const QString & objectName);
+    static bool isLearnedObject(const QString & objectName);
+
+private:
+    static void loadLearnedObjects();
+
+    static QSet<QString> learnedObjects;
+    static bool loaded;
+};
+
+#endif // OBJECTPREFETCHER_H
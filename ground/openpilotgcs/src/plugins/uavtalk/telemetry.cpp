@@ -26,11 +26,14 @@
  */
 
 #include "telemetry.h"
+#include "uavdataobject.h"
 #include "oplinksettings.h"
 #include "objectpersistence.h"
+#include <utils/crc.h>
 #include <QTime>
 #include <QtGlobal>
 #include <stdlib.h>
+#include <string.h>
 #include <QDebug>
 
 /**
@@ -70,8 +73,10 @@ Telemetry::Telemetry(UAVTalk *utalk, UAVObjectManager *objMngr) : objMngr(objMng
     updateTimer->start(1000);
 
     // Setup and start the stats timer
+    transPendingAcked = 0;
     txErrors  = 0;
     txRetries = 0;
+    memset(latencyHistogram, 0, sizeof(latencyHistogram));
 }
 
 Telemetry::~Telemetry()
@@ -168,6 +173,12 @@ void Telemetry::connectToObject(UAVObject *obj, quint32 eventMask)
     if ((eventMask & EV_UPDATE_REQ) != 0) {
         connect(obj, SIGNAL(updateRequested(UAVObject *, bool)), this, SLOT(updateRequested(UAVObject *, bool)));
     }
+    // Track the settings state of the vehicle as objects are received, so
+    // that manual sends of unchanged settings can be skipped altogether
+    UAVDataObject *dobj = dynamic_cast<UAVDataObject *>(obj);
+    if ((dobj != NULL) && dobj->isSettingsObject() && obj->isSingleInstance()) {
+        connect(obj, SIGNAL(objectUnpacked(UAVObject *)), this, SLOT(settingsUnpacked(UAVObject *)));
+    }
 }
 
 /**
@@ -243,10 +254,26 @@ void Telemetry::transactionCompleted(UAVObject *obj, bool success)
     ObjectTransactionInfo *transInfo = findTransaction(obj);
 
     if (transInfo) {
+        // Bin the transaction latency, retries included
+        if (transInfo->started.isValid()) {
+            qint64 elapsedMs = transInfo->started.elapsed();
+            int bucket = 0;
+            while ((bucket < LATENCY_BUCKETS - 1) && (elapsedMs >= latencyBucketBoundMs(bucket))) {
+                bucket++;
+            }
+            latencyHistogram[bucket]++;
+        }
+
         if (success) {
             // We now know tat the flight side knows of this object.
             obj->setIsKnown(true);
 
+            // An acked send means the vehicle now holds exactly this data
+            UAVDataObject *dobj = dynamic_cast<UAVDataObject *>(obj);
+            if (!transInfo->objRequest && (dobj != NULL) && dobj->isSettingsObject() && obj->isSingleInstance()) {
+                vehicleSettingsCrc.insert(obj->getObjID(), settingsCrc(obj));
+            }
+
 #ifdef VERBOSE_TELEMETRY
             qDebug() << "Telemetry - transaction successful for object" << obj->toStringBrief();
 #endif
@@ -349,7 +376,19 @@ void Telemetry::processObjectUpdates(UAVObject *obj, EventMask event, bool allIn
     objInfo.obj   = obj;
     objInfo.event = event;
     objInfo.allInstances = allInstances;
-    if (priority) {
+    if (priority && ((event == EV_UPDATED) || (event == EV_UPDATED_MANUAL))
+        && !UAVObject::GetGcsTelemetryAcked(obj->getMetadata())) {
+        // Un-acked object updates are the control stream (GCSControl,
+        // GCSReceiver): they get their own lane so a bulk settings write
+        // cannot delay or drop them.
+        if (objControlQueue.length() < MAX_QUEUE_SIZE) {
+            objControlQueue.enqueue(objInfo);
+        } else {
+            ++txErrors;
+            qWarning().nospace() << "Telemetry - !!! control event queue is full, event lost " << obj->toStringBrief();
+            obj->emitTransactionCompleted(false);
+        }
+    } else if (priority) {
         if (objPriorityQueue.length() < MAX_QUEUE_SIZE) {
             objPriorityQueue.enqueue(objInfo);
         } else {
@@ -376,10 +415,15 @@ void Telemetry::processObjectUpdates(UAVObject *obj, EventMask event, bool allIn
  */
 void Telemetry::processObjectQueue()
 {
-    // Get object information from queue (first the priority and then the regular queue)
+    // Get object information from queue: control lane first, then the
+    // transacted lane (held back while its outstanding window is full so
+    // the queue is re-examined when a transaction completes), then the
+    // periodic lane.
     ObjectQueueInfo objInfo;
 
-    if (!objPriorityQueue.isEmpty()) {
+    if (!objControlQueue.isEmpty()) {
+        objInfo = objControlQueue.dequeue();
+    } else if (!objPriorityQueue.isEmpty() && (transPendingAcked < MAX_ACKED_TRANSACTIONS)) {
         objInfo = objPriorityQueue.dequeue();
     } else if (!objQueue.isEmpty()) {
         objInfo = objQueue.dequeue();
@@ -531,6 +575,33 @@ Telemetry::TelemetryStats Telemetry::getStats()
     return stats;
 }
 
+/**
+ * Get the transaction latency histogram, one counter per doubling bucket;
+ * see latencyBucketBoundMs() for the bucket boundaries
+ */
+QVector<quint32> Telemetry::getTransactionLatencyHistogram()
+{
+    QMutexLocker locker(mutex);
+
+    QVector<quint32> histogram(LATENCY_BUCKETS);
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        histogram[i] = latencyHistogram[i];
+    }
+    return histogram;
+}
+
+/**
+ * Upper bound in ms of a latency histogram bucket, -1 for the open ended
+ * last bucket
+ */
+int Telemetry::latencyBucketBoundMs(int bucket)
+{
+    if (bucket >= LATENCY_BUCKETS - 1) {
+        return -1;
+    }
+    return 2 << bucket;
+}
+
 void Telemetry::resetStats()
 {
     QMutexLocker locker(mutex);
@@ -538,6 +609,7 @@ void Telemetry::resetStats()
     utalk->resetStats();
     txErrors  = 0;
     txRetries = 0;
+    memset(latencyHistogram, 0, sizeof(latencyHistogram));
 }
 
 void Telemetry::objectUpdatedAuto(UAVObject *obj)
@@ -553,6 +625,20 @@ void Telemetry::objectUpdatedManual(UAVObject *obj, bool all)
 
     bool allInstances = obj->isSingleInstance() ? false : all;
 
+    // Differential settings sync: when the vehicle is known to hold exactly
+    // this data already, acknowledge the update without using the link.
+    // Bulk imports then only transfer the objects that actually changed.
+    UAVDataObject *dobj = dynamic_cast<UAVDataObject *>(obj);
+    if ((dobj != NULL) && dobj->isSettingsObject() && obj->isSingleInstance() && obj->isKnown() &&
+        vehicleSettingsCrc.contains(obj->getObjID()) &&
+        (vehicleSettingsCrc.value(obj->getObjID()) == settingsCrc(obj))) {
+#ifdef VERBOSE_TELEMETRY
+        qDebug() << "Telemetry - settings digest unchanged, not sending" << obj->toStringBrief();
+#endif
+        obj->emitTransactionCompleted(true);
+        return;
+    }
+
     processObjectUpdates(obj, EV_UPDATED_MANUAL, allInstances, true);
 }
 
@@ -570,6 +656,29 @@ void Telemetry::objectUnpacked(UAVObject *obj)
     processObjectUpdates(obj, EV_UNPACKED, false, true);
 }
 
+/**
+ * Called when a settings object is received from the vehicle: the received
+ * data is by definition what the vehicle holds, so refresh its digest.
+ */
+void Telemetry::settingsUnpacked(UAVObject *obj)
+{
+    QMutexLocker locker(mutex);
+
+    vehicleSettingsCrc.insert(obj->getObjID(), settingsCrc(obj));
+}
+
+/**
+ * Compute the CRC-32 digest of an object's packed data, the same digest
+ * UAVObjGetSettingsCRC() computes over the instance data on the flight side.
+ */
+quint32 Telemetry::settingsCrc(UAVObject *obj)
+{
+    QByteArray data(obj->getNumBytes(), 0);
+
+    obj->pack((quint8 *)data.data());
+    return Utils::Crc::updateCRC32(0, (const quint8 *)data.constData(), data.size());
+}
+
 void Telemetry::updateRequested(UAVObject *obj, bool all)
 {
     QMutexLocker locker(mutex);
@@ -630,6 +739,10 @@ void Telemetry::openTransaction(ObjectTransactionInfo *trans)
         transMap.insert(objId, objTransactions);
     }
     objTransactions->insert(instId, trans);
+    if (trans->objRequest || trans->acked) {
+        ++transPendingAcked;
+        trans->started.start();
+    }
 }
 
 void Telemetry::closeTransaction(ObjectTransactionInfo *trans)
@@ -639,7 +752,9 @@ void Telemetry::closeTransaction(ObjectTransactionInfo *trans)
 
     QMap<quint32, ObjectTransactionInfo *> *objTransactions = transMap.value(objId);
     if (objTransactions != NULL) {
-        objTransactions->remove(instId);
+        if (objTransactions->remove(instId) && (trans->objRequest || trans->acked)) {
+            --transPendingAcked;
+        }
         // Keep the map even if it is empty
         // There are at most 100 different object IDs...
     }
@@ -660,6 +775,7 @@ void Telemetry::closeAllTransactions()
         transMap.remove(objId);
         delete objTransactions;
     }
+    transPendingAcked = 0;
 }
 
 ObjectTransactionInfo::ObjectTransactionInfo(QObject *parent) : QObject(parent)
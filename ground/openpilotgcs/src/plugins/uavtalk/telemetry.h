@@ -34,8 +34,11 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QQueue>
 #include <QMap>
+#include <QHash>
+#include <QVector>
 
 class ObjectTransactionInfo : public QObject {
     Q_OBJECT
@@ -50,6 +53,8 @@ public:
     bool acked;
     QPointer<class Telemetry>telem;
     QTimer *timer;
+    // Measures the full transaction latency, retries included
+    QElapsedTimer started;
 private slots:
     void timeout();
 };
@@ -73,9 +78,15 @@ public:
         quint32 rxCrcErrors;
     } TelemetryStats;
 
+    // Transaction latencies are binned into doubling buckets, the first
+    // bucket covers [0, 2) ms and the last is open ended
+    static const int LATENCY_BUCKETS = 8;
+
     Telemetry(UAVTalk *utalk, UAVObjectManager *objMngr);
     ~Telemetry();
     TelemetryStats getStats();
+    QVector<quint32> getTransactionLatencyHistogram();
+    static int latencyBucketBoundMs(int bucket);
     void resetStats();
     void transactionTimeout(ObjectTransactionInfo *info);
 
@@ -86,6 +97,10 @@ private:
     static const int MAX_UPDATE_PERIOD_MS = 1000;
     static const int MIN_UPDATE_PERIOD_MS = 1;
     static const int MAX_QUEUE_SIZE = 20;
+    // Outstanding transacted (acked or request) transactions allowed at
+    // once: bounds how far a bulk settings write can fill the link ahead
+    // of the control and periodic lanes.
+    static const int MAX_ACKED_TRANSACTIONS = 4;
 
     // Types
     /**
@@ -117,6 +132,10 @@ private:
     UAVTalk *utalk;
     GCSTelemetryStats *gcsStatsObj;
     QList<ObjectTimeInfo> objList;
+    // Three lanes, served in this order: un-acked control stream
+    // (GCSControl and friends), transacted events (acked settings writes,
+    // object requests), then periodic updates.
+    QQueue<ObjectQueueInfo> objControlQueue;
     QQueue<ObjectQueueInfo> objQueue;
     QQueue<ObjectQueueInfo> objPriorityQueue;
     QMap<quint32, QMap<quint32, ObjectTransactionInfo *> *> transMap;
@@ -124,8 +143,14 @@ private:
     QTimer *updateTimer;
     QTimer *statsTimer;
     qint32 timeToNextUpdateMs;
+    qint32 transPendingAcked; // open transacted transactions, see MAX_ACKED_TRANSACTIONS
     quint32 txErrors;
     quint32 txRetries;
+    quint32 latencyHistogram[LATENCY_BUCKETS];
+    // Digest of the settings data the vehicle is known to hold, by object
+    // ID: fed from received objects and successful acked sends, used to
+    // skip sending settings the vehicle already has (differential sync)
+    QHash<quint32, quint32> vehicleSettingsCrc;
 
     // Methods
     void registerObject(UAVObject *obj);
@@ -138,6 +163,8 @@ private:
     void processObjectTransaction(ObjectTransactionInfo *transInfo);
     void processObjectQueue();
 
+    static quint32 settingsCrc(UAVObject *obj);
+
     ObjectTransactionInfo *findTransaction(UAVObject *obj);
     void openTransaction(ObjectTransactionInfo *trans);
     void closeTransaction(ObjectTransactionInfo *trans);
@@ -148,6 +175,7 @@ private slots:
     void objectUpdatedManual(UAVObject *obj, bool all = false);
     void objectUpdatedPeriodic(UAVObject *obj);
     void objectUnpacked(UAVObject *obj);
+    void settingsUnpacked(UAVObject *obj);
     void updateRequested(UAVObject *obj, bool all = false);
     void newObject(UAVObject *obj);
     void newInstance(UAVObject *obj);
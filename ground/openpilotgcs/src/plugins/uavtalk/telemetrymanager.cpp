@@ -28,11 +28,65 @@
 #include "telemetrymanager.h"
 #include "telemetry.h"
 #include "telemetrymonitor.h"
+#include "uavobjectsinit.h"
 #include <extensionsystem/pluginmanager.h>
 #include <coreplugin/icore.h>
 #include <coreplugin/threadmanager.h>
 
-TelemetryManager::TelemetryManager() : m_isAutopilotConnected(false)
+TelemetryConnection::TelemetryConnection(QIODevice *dev, UAVObjectManager *objMngr, bool ownsObjectManager) :
+    m_device(dev),
+    m_objectManager(objMngr),
+    m_ownsObjectManager(ownsObjectManager),
+    m_reader(NULL),
+    m_isAutopilotConnected(false)
+{
+    m_uavTalk = new UAVTalk(dev, objMngr);
+
+    // UAVTalk is thread safe:
+    // 1- all public methods lock a mutex
+    // 2- the reader thread locks that mutex too
+    // The reader thread locks the mutex once a packet is read and decoded.
+    // It is assumed that the UAVObjectManager is thread safe
+    // Decoded object updates reach their subscribers through queued signal
+    // connections, so framing, CRC and unpacking never run on the GUI thread.
+
+    m_telemetry = new Telemetry(m_uavTalk, objMngr);
+    m_telemetryMonitor = new TelemetryMonitor(objMngr, m_telemetry);
+
+    connect(m_telemetryMonitor, SIGNAL(connected()), this, SLOT(onConnect()));
+    connect(m_telemetryMonitor, SIGNAL(disconnected()), this, SLOT(onDisconnect()));
+    connect(m_telemetryMonitor, SIGNAL(telemetryUpdated(double, double)), this, SLOT(onTelemetryUpdate(double, double)));
+}
+
+TelemetryConnection::~TelemetryConnection()
+{
+    m_telemetryMonitor->disconnect(this);
+    delete m_telemetryMonitor;
+    delete m_telemetry;
+    delete m_uavTalk;
+    if (m_ownsObjectManager) {
+        delete m_objectManager;
+    }
+}
+
+void TelemetryConnection::onConnect()
+{
+    m_isAutopilotConnected = true;
+    emit connected(this);
+}
+
+void TelemetryConnection::onDisconnect()
+{
+    m_isAutopilotConnected = false;
+    emit disconnected(this);
+}
+
+void TelemetryConnection::onTelemetryUpdate(double txRate, double rxRate)
+{
+    emit telemetryUpdated(this, txRate, rxRate);
+}
+
+TelemetryManager::TelemetryManager() : m_telemetryDevice(NULL), m_isAutopilotConnected(false)
 {
     moveToThread(Core::ICore::instance()->threadManager()->getRealTimeThread());
     // Get UAVObjectManager instance
@@ -52,6 +106,20 @@ bool TelemetryManager::isConnected()
     return m_isAutopilotConnected;
 }
 
+/**
+ * The connection bound to the global UAVObjectManager, i.e. the vehicle
+ * all single vehicle gadgets follow.  NULL when no link is started.
+ */
+TelemetryConnection *TelemetryManager::primaryConnection() const
+{
+    foreach(TelemetryConnection * connection, m_connections) {
+        if (!connection->m_ownsObjectManager) {
+            return connection;
+        }
+    }
+    return NULL;
+}
+
 void TelemetryManager::start(QIODevice *dev)
 {
     m_telemetryDevice = dev;
@@ -66,70 +134,107 @@ void TelemetryManager::start(QIODevice *dev)
 
 void TelemetryManager::onStart()
 {
-    m_uavTalk = new UAVTalk(m_telemetryDevice, m_uavobjectManager);
-    if (false) {
-        // UAVTalk must be thread safe and for that:
-        // 1- all public methods must lock a mutex
-        // 2- the reader thread must lock that mutex too
-        // The reader thread locks the mutex once a packet is read and decoded.
-        // It is assumed that the UAVObjectManager is thread safe
-
-        // Create the reader and move it to the reader thread
-        IODeviceReader *reader = new IODeviceReader(m_uavTalk);
-        reader->moveToThread(&m_telemetryReaderThread);
-        // The reader will be deleted (later) when the thread finishes
-        connect(&m_telemetryReaderThread, &QThread::finished, reader, &QObject::deleteLater);
-        // Connect IO device to reader
-        connect(m_telemetryDevice, SIGNAL(readyRead()), reader, SLOT(read()));
-        // start the reader thread
-        m_telemetryReaderThread.start();
+    UAVObjectManager *objMngr;
+    bool ownsObjectManager;
+
+    if (m_connections.isEmpty()) {
+        // First link: decode into the global registry that every gadget reads
+        objMngr = m_uavobjectManager;
+        ownsObjectManager = false;
     } else {
-        // Connect IO device to reader
-        connect(m_telemetryDevice, SIGNAL(readyRead()), m_uavTalk, SLOT(processInputStream()));
+        // Additional vehicle: give the link a registry of its own so two
+        // vehicles never fight over the same object instances.  Gadget
+        // context switching between registries builds on connectionAdded()
+        // and TelemetryConnection::objectManager().
+        objMngr = new UAVObjectManager();
+        UAVObjectsInitialize(objMngr);
+        ownsObjectManager = true;
     }
 
-    m_telemetry = new Telemetry(m_uavTalk, m_uavobjectManager);
-    m_telemetryMonitor = new TelemetryMonitor(m_uavobjectManager, m_telemetry);
+    TelemetryConnection *connection = new TelemetryConnection(m_telemetryDevice, objMngr, ownsObjectManager);
+
+    // Create the reader and move it to the shared reader thread.  One thread
+    // serves every link, an idle link costs no thread of its own.
+    IODeviceReader *reader = new IODeviceReader(connection->m_uavTalk);
+    connection->m_reader = reader;
+    reader->moveToThread(&m_telemetryReaderThread);
+    // The reader will be deleted when its connection is removed (or, for
+    // readers still alive at shutdown, when the thread finishes)
+    connect(&m_telemetryReaderThread, &QThread::finished, reader, &QObject::deleteLater);
+    // Move the device to the reader thread as well, so that readyRead is
+    // emitted and the data is read from the same thread (same reasoning as
+    // OP-1383 above)
+    m_telemetryDevice->moveToThread(&m_telemetryReaderThread);
+    // Connect IO device to reader
+    connect(m_telemetryDevice, SIGNAL(readyRead()), reader, SLOT(read()));
+    // start the reader thread
+    if (!m_telemetryReaderThread.isRunning()) {
+        m_telemetryReaderThread.start();
+    }
 
-    connect(m_telemetryMonitor, SIGNAL(connected()), this, SLOT(onConnect()));
-    connect(m_telemetryMonitor, SIGNAL(disconnected()), this, SLOT(onDisconnect()));
-    connect(m_telemetryMonitor, SIGNAL(telemetryUpdated(double, double)), this, SLOT(onTelemetryUpdate(double, double)));
+    connect(connection, SIGNAL(connected(TelemetryConnection *)), this, SLOT(onConnectionConnected(TelemetryConnection *)));
+    connect(connection, SIGNAL(disconnected(TelemetryConnection *)), this, SLOT(onConnectionDisconnected(TelemetryConnection *)));
+    connect(connection, SIGNAL(telemetryUpdated(TelemetryConnection *, double, double)), this, SLOT(onConnectionTelemetryUpdate(TelemetryConnection *, double, double)));
+
+    m_connections.append(connection);
+    emit connectionAdded(connection);
 }
 
 void TelemetryManager::stop()
 {
     emit myStop();
 
-    if (false) {
-        m_telemetryReaderThread.quit();
-        m_telemetryReaderThread.wait();
-    }
+    m_telemetryReaderThread.quit();
+    m_telemetryReaderThread.wait();
 }
 
 void TelemetryManager::onStop()
 {
-    m_telemetryMonitor->disconnect(this);
-    delete m_telemetryMonitor;
-    delete m_telemetry;
-    delete m_uavTalk;
-    onDisconnect();
+    while (!m_connections.isEmpty()) {
+        removeConnection(m_connections.last());
+    }
 }
 
-void TelemetryManager::onConnect()
+void TelemetryManager::removeConnection(TelemetryConnection *connection)
 {
-    m_isAutopilotConnected = true;
-    emit connected();
+    m_connections.removeAll(connection);
+
+    if (connection->m_reader) {
+        disconnect(connection->m_device, SIGNAL(readyRead()), connection->m_reader, SLOT(read()));
+        connection->m_reader->deleteLater();
+    }
+
+    bool wasPrimary = !connection->m_ownsObjectManager;
+    emit connectionRemoved(connection);
+    delete connection;
+
+    if (wasPrimary) {
+        m_isAutopilotConnected = false;
+        emit disconnected();
+    }
 }
 
-void TelemetryManager::onDisconnect()
+void TelemetryManager::onConnectionConnected(TelemetryConnection *connection)
 {
-    m_isAutopilotConnected = false;
-    emit disconnected();
+    if (!connection->m_ownsObjectManager) {
+        m_isAutopilotConnected = true;
+        emit connected();
+    }
 }
 
-void TelemetryManager::onTelemetryUpdate(double txRate, double rxRate)
+void TelemetryManager::onConnectionDisconnected(TelemetryConnection *connection)
 {
-    emit telemetryUpdated(txRate, rxRate);
+    if (!connection->m_ownsObjectManager) {
+        m_isAutopilotConnected = false;
+        emit disconnected();
+    }
+}
+
+void TelemetryManager::onConnectionTelemetryUpdate(TelemetryConnection *connection, double txRate, double rxRate)
+{
+    if (!connection->m_ownsObjectManager) {
+        emit telemetryUpdated(txRate, rxRate);
+    }
 }
 
 IODeviceReader::IODeviceReader(UAVTalk *uavTalk) : m_uavTalk(uavTalk)
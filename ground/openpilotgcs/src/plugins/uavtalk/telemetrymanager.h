@@ -33,9 +33,72 @@
 #include "uavobjectmanager.h"
 #include <QIODevice>
 #include <QObject>
+#include <QList>
 
 class Telemetry;
 class TelemetryMonitor;
+class IODeviceReader;
+
+/**
+ * One telemetry link and everything that belongs to it: the IO device,
+ * the UAVTalk codec, the telemetry scheduler, the connection monitor
+ * and the object registry the link decodes into.
+ *
+ * The first link started is bound to the global UAVObjectManager so
+ * every existing gadget keeps working unchanged.  Each additional link
+ * gets a private registry, its vehicle's state cannot clobber the
+ * primary vehicle's objects.  All links share a single reader thread.
+ */
+class UAVTALK_EXPORT TelemetryConnection : public QObject {
+    Q_OBJECT
+
+public:
+    TelemetryConnection(QIODevice *dev, UAVObjectManager *objMngr, bool ownsObjectManager);
+    ~TelemetryConnection();
+
+    QIODevice *device() const
+    {
+        return m_device;
+    }
+    UAVObjectManager *objectManager() const
+    {
+        return m_objectManager;
+    }
+    UAVTalk *uavTalk() const
+    {
+        return m_uavTalk;
+    }
+    Telemetry *telemetry() const
+    {
+        return m_telemetry;
+    }
+    bool isConnected() const
+    {
+        return m_isAutopilotConnected;
+    }
+
+signals:
+    void connected(TelemetryConnection *connection);
+    void disconnected(TelemetryConnection *connection);
+    void telemetryUpdated(TelemetryConnection *connection, double txRate, double rxRate);
+
+private slots:
+    void onConnect();
+    void onDisconnect();
+    void onTelemetryUpdate(double txRate, double rxRate);
+
+private:
+    friend class TelemetryManager;
+
+    QIODevice *m_device;
+    UAVObjectManager *m_objectManager;
+    bool m_ownsObjectManager;
+    UAVTalk *m_uavTalk;
+    Telemetry *m_telemetry;
+    TelemetryMonitor *m_telemetryMonitor;
+    IODeviceReader *m_reader;
+    bool m_isAutopilotConnected;
+};
 
 class UAVTALK_EXPORT TelemetryManager : public QObject {
     Q_OBJECT
@@ -48,25 +111,35 @@ public:
     void stop();
     bool isConnected();
 
+    QList<TelemetryConnection *> connections() const
+    {
+        return m_connections;
+    }
+    TelemetryConnection *primaryConnection() const;
+
 signals:
+    // Primary vehicle state, kept for all existing single vehicle consumers
     void connected();
     void disconnected();
     void telemetryUpdated(double txRate, double rxRate);
+    // Per vehicle link lifecycle, the hook for multi vehicle consumers
+    void connectionAdded(TelemetryConnection *connection);
+    void connectionRemoved(TelemetryConnection *connection);
     void myStart();
     void myStop();
 
 private slots:
-    void onConnect();
-    void onDisconnect();
-    void onTelemetryUpdate(double txRate, double rxRate);
+    void onConnectionConnected(TelemetryConnection *connection);
+    void onConnectionDisconnected(TelemetryConnection *connection);
+    void onConnectionTelemetryUpdate(TelemetryConnection *connection, double txRate, double rxRate);
     void onStart();
     void onStop();
 
 private:
+    void removeConnection(TelemetryConnection *connection);
+
     UAVObjectManager *m_uavobjectManager;
-    UAVTalk *m_uavTalk;
-    Telemetry *m_telemetry;
-    TelemetryMonitor *m_telemetryMonitor;
+    QList<TelemetryConnection *> m_connections;
     QIODevice *m_telemetryDevice;
     bool m_isAutopilotConnected;
     QThread m_telemetryReaderThread;
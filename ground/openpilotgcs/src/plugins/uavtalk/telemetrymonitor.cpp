@@ -29,6 +29,22 @@
 #include "coreplugin/connectionmanager.h"
 #include "coreplugin/icore.h"
 
+#include "uavmetaobject.h"
+#include "objectprefetcher.h"
+#include "flightstatus.h"
+#include "systemalarms.h"
+
+#include <QSet>
+
+// Aircraft (board type + CPU serial + firmware description) whose
+// metadata has been fully retrieved during this GCS session.  On a
+// reconnect to a known aircraft only the metaobjects that deviate from
+// their compiled-in defaults are fetched again; anything the flight
+// side could have reset by rebooting is back at those same defaults,
+// and anything this GCS changed is already reflected in the object
+// manager.  Settings objects are always re-fetched.
+static QSet<QString> retrievedSessions;
+
 /**
  * Constructor
  */
@@ -39,9 +55,9 @@ TelemetryMonitor::TelemetryMonitor(UAVObjectManager *objMngr, Telemetry *tel) :
     flightStatsObj(FlightTelemetryStats::GetInstance(objMngr)),
     firmwareIAPObj(FirmwareIAPObj::GetInstance(objMngr)),
     statsTimer(new QTimer(this)),
-    objPending(NULL),
     mutex(new QMutex(QMutex::Recursive)),
-    connectionTimer(new QTime())
+    connectionTimer(new QTime()),
+    identityPending(false)
 {
     // Listen for flight stats updates
     connect(flightStatsObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(flightStatsUpdated(UAVObject *)));
@@ -62,35 +78,119 @@ TelemetryMonitor::~TelemetryMonitor()
 }
 
 /**
- * Initiate object retrieval, initialize queue with objects to be retrieved.
+ * Initiate object retrieval.  The aircraft identity is fetched first,
+ * it decides whether the session cache can trim the retrieval queue.
  */
 void TelemetryMonitor::startRetrievingObjects()
 {
     // Clear object queue
     queue.clear();
-    // Get all objects, add metaobjects, settings and data objects with OnChange update mode to the queue
+    queue.enqueue(firmwareIAPObj);
+    identityPending = true;
+    retrieveNextObject();
+}
+
+/**
+ * Key identifying an aircraft and its firmware build for the session cache
+ */
+QString TelemetryMonitor::sessionKey()
+{
+    FirmwareIAPObj::DataFields iapData = firmwareIAPObj->getData();
+    QByteArray identity;
+
+    identity.append((char)iapData.BoardType);
+    identity.append((char)iapData.BoardRevision);
+    for (unsigned int i = 0; i < FirmwareIAPObj::CPUSERIAL_NUMELEM; i++) {
+        identity.append(iapData.CPUSerial[i]);
+    }
+    for (unsigned int i = 0; i < FirmwareIAPObj::DESCRIPTION_NUMELEM; i++) {
+        identity.append(iapData.Description[i]);
+    }
+    return QString(identity.toHex());
+}
+
+/**
+ * Initialize queue with objects to be retrieved, called once the
+ * aircraft identity is known.
+ */
+void TelemetryMonitor::buildRetrievalQueue()
+{
+    // Incremental retrieval is possible when this aircraft was already
+    // fully retrieved during this GCS session
+    bool incremental = retrievedSessions.contains(sessionKey());
+
+    // Get all objects, add metaobjects, settings and data objects with OnChange update mode to the queue.
+    // Objects the UI needs to become usable (flight status, alarms, then the objects the
+    // configuration pages are known to bind, then the remaining settings) go to the front
+    // so they arrive within the first second, the bulk streams in behind them.
+    QList<UAVObject *> statusObjs;
+    QList<UAVObject *> prefetchObjs;
+    QList<UAVObject *> settingsObjs;
+    QList<UAVObject *> bulkObjs;
     QList< QList<UAVObject *> > objs = objMngr->getObjects();
+
     for (int n = 0; n < objs.length(); ++n) {
         UAVObject *obj = objs[n][0];
         UAVMetaObject *mobj = dynamic_cast<UAVMetaObject *>(obj);
         UAVDataObject *dobj = dynamic_cast<UAVDataObject *>(obj);
         UAVObject::Metadata mdata = obj->getMetadata();
         if (mobj != NULL) {
-            queue.enqueue(obj);
+            if (incremental) {
+                // A metaobject still at its compiled-in defaults is
+                // current on both ends: the flight side reverts to the
+                // same defaults on reboot and any change made through
+                // this GCS is already in the object manager.  Only
+                // deviating metaobjects need a round trip.
+                UAVObject::Metadata dflt = mobj->getDefaultMetadata();
+                if (mdata.flags == dflt.flags
+                    && mdata.flightTelemetryUpdatePeriod == dflt.flightTelemetryUpdatePeriod
+                    && mdata.gcsTelemetryUpdatePeriod == dflt.gcsTelemetryUpdatePeriod
+                    && mdata.loggingUpdatePeriod == dflt.loggingUpdatePeriod) {
+                    continue;
+                }
+            }
+            bulkObjs.append(obj);
         } else if (dobj != NULL) {
             if (dobj->isSettingsObject()) {
-                queue.enqueue(obj);
+                if (ObjectPrefetcher::isLearnedObject(obj->getName())) {
+                    prefetchObjs.append(obj);
+                } else {
+                    settingsObjs.append(obj);
+                }
             } else {
                 if (UAVObject::GetFlightTelemetryUpdateMode(mdata) == UAVObject::UPDATEMODE_ONCHANGE) {
-                    queue.enqueue(obj);
+                    if ((obj->getObjID() == FlightStatus::OBJID) || (obj->getObjID() == SystemAlarms::OBJID)) {
+                        statusObjs.append(obj);
+                    } else if (ObjectPrefetcher::isLearnedObject(obj->getName())) {
+                        prefetchObjs.append(obj);
+                    } else {
+                        bulkObjs.append(obj);
+                    }
+                } else if (UAVObject::GetFlightTelemetryUpdateMode(mdata) == UAVObject::UPDATEMODE_MANUAL
+                           && ObjectPrefetcher::isLearnedObject(obj->getName())) {
+                    // Manual mode objects are normally never retrieved, but a
+                    // config page binds this one so warm it anyway; without it
+                    // the page would open showing stale defaults.
+                    prefetchObjs.append(obj);
                 }
             }
         }
     }
+    foreach(UAVObject * obj, statusObjs) {
+        queue.enqueue(obj);
+    }
+    foreach(UAVObject * obj, prefetchObjs) {
+        queue.enqueue(obj);
+    }
+    foreach(UAVObject * obj, settingsObjs) {
+        queue.enqueue(obj);
+    }
+    foreach(UAVObject * obj, bulkObjs) {
+        queue.enqueue(obj);
+    }
     // Start retrieving
-    qDebug() << tr("Starting to retrieve meta and settings objects from the autopilot (%1 objects)")
-        .arg(queue.length());
-    retrieveNextObject();
+    qDebug() << tr("Starting to retrieve meta and settings objects from the autopilot (%1 objects%2)")
+        .arg(queue.length()).arg(incremental ? tr(", incremental") : QString());
 }
 
 /**
@@ -100,17 +200,27 @@ void TelemetryMonitor::stopRetrievingObjects()
 {
     qDebug("Object retrieval has been cancelled");
     queue.clear();
+    foreach(UAVObject * obj, pendingObjects) {
+        obj->disconnect(this);
+    }
+    pendingObjects.clear();
 }
 
 /**
- * Retrieve the next object in the queue
+ * Top up the window of outstanding object requests from the queue.
+ * Several requests are kept in flight at once so the link round trip
+ * time is not paid per object; completions are matched per object in
+ * transactionCompleted().
  */
 void TelemetryMonitor::retrieveNextObject()
 {
-    // If queue is empty return
-    if (queue.isEmpty()) {
+    // Retrieval is complete once both the queue and the window are empty
+    if (queue.isEmpty() && pendingObjects.isEmpty()) {
         qDebug("Object retrieval completed");
         if (firmwareIAPObj->getBoardType()) {
+            // everything this aircraft reports is now in the object
+            // manager; later reconnects can retrieve incrementally
+            retrievedSessions.insert(sessionKey());
             emit connected();
         } else {
             connect(firmwareIAPObj, SIGNAL(objectUpdated(UAVObject *)), this, SLOT(firmwareIAPUpdated(UAVObject *)));
@@ -118,31 +228,39 @@ void TelemetryMonitor::retrieveNextObject()
         return;
     }
 
-    // Get next object from the queue
-    UAVObject *obj = queue.dequeue();
-    // qDebug( tr("Retrieving object: %1").arg(obj->getName()) );
+    while (!queue.isEmpty() && (pendingObjects.count() < RETRIEVE_WINDOW_SIZE)) {
+        // Get next object from the queue
+        UAVObject *obj = queue.dequeue();
+        // qDebug( tr("Retrieving object: %1").arg(obj->getName()) );
 
-    // Connect to object
-    connect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(transactionCompleted(UAVObject *, bool)));
+        // Connect to object
+        connect(obj, SIGNAL(transactionCompleted(UAVObject *, bool)), this, SLOT(transactionCompleted(UAVObject *, bool)));
 
-    // Request update
-    obj->requestUpdate();
-    objPending = obj;
+        // Request update
+        pendingObjects.insert(obj);
+        obj->requestUpdate();
+    }
 }
 
 /**
- * Called by the retrieved object when a transaction is completed.
+ * Called by a retrieved object when its transaction is completed.
  */
 void TelemetryMonitor::transactionCompleted(UAVObject *obj, bool success)
 {
     Q_UNUSED(success);
     QMutexLocker locker(mutex);
 
-    if (obj == objPending) {
+    if (pendingObjects.contains(obj)) {
         // Disconnect from sending object
         obj->disconnect(this);
-        objPending = NULL;
-        // Process next object if telemetry is still available
+        pendingObjects.remove(obj);
+        // The first transaction fetches the aircraft identity; the
+        // retrieval queue proper is built once it is in
+        if (identityPending) {
+            identityPending = false;
+            buildRetrievalQueue();
+        }
+        // Refill the window if telemetry is still available
         GCSTelemetryStats::DataFields gcsStats = gcsStatsObj->getData();
 
         if (gcsStats.Status == GCSTelemetryStats::STATUS_CONNECTED) {
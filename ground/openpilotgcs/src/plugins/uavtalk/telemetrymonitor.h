@@ -30,6 +30,7 @@
 
 #include <QObject>
 #include <QQueue>
+#include <QSet>
 #include <QTimer>
 #include <QTime>
 #include <QMutex>
@@ -63,6 +64,8 @@ private:
     static const int STATS_UPDATE_PERIOD_MS  = 4000;
     static const int STATS_CONNECT_PERIOD_MS = 2000;
     static const int CONNECTION_TIMEOUT_MS   = 8000;
+    // Number of outstanding object requests during retrieval
+    static const int RETRIEVE_WINDOW_SIZE    = 4;
 
     UAVObjectManager *objMngr;
     Telemetry *tel;
@@ -71,13 +74,16 @@ private:
     FlightTelemetryStats *flightStatsObj;
     FirmwareIAPObj *firmwareIAPObj;
     QTimer *statsTimer;
-    UAVObject *objPending;
+    QSet<UAVObject *> pendingObjects;
     QMutex *mutex;
     QTime *connectionTimer;
+    bool identityPending;
 
     void startRetrievingObjects();
+    void buildRetrievalQueue();
     void retrieveNextObject();
     void stopRetrievingObjects();
+    QString sessionKey();
 };
 
 #endif // TELEMETRYMONITOR_H
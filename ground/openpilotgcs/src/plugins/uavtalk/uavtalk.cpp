@@ -86,6 +86,7 @@ void UAVTalk::resetStats()
     QMutexLocker locker(&mutex);
 
     memset(&stats, 0, sizeof(ComStats));
+    objectStats.clear();
 }
 
 /**
@@ -98,6 +99,16 @@ UAVTalk::ComStats UAVTalk::getStats()
     return stats;
 }
 
+/**
+ * Get the per object type traffic counters
+ */
+QMap<quint32, UAVTalk::ObjectComStats> UAVTalk::getObjectStats()
+{
+    QMutexLocker locker(&mutex);
+
+    return objectStats;
+}
+
 void UAVTalk::dummyUDPRead()
 {
     QUdpSocket *socket = qobject_cast<QUdpSocket *>(sender());
@@ -208,21 +219,65 @@ bool UAVTalk::objectTransaction(quint8 type, quint32 objId, quint16 instId, UAVO
  */
 void UAVTalk::processInputStream()
 {
-    quint8 tmp;
+    quint8 buffer[RX_READ_CHUNK_SIZE];
 
     if (io && io->isReadable()) {
         while (io->bytesAvailable() > 0) {
-            int ret = io->read((char *)&tmp, 1);
-            if (ret != -1) {
-                processInputByte(tmp);
-            } else {
+            qint64 bytesRead = io->read((char *)buffer, sizeof(buffer));
+            if (bytesRead == -1) {
                 // TODOD
+                break;
+            }
+            processInputData(buffer, bytesRead);
+        }
+    }
+}
+
+/**
+ * Process a chunk of bytes from the telemetry stream.
+ * Payload bytes are consumed in bulk so the CRC runs over whole buffers,
+ * all other states go through the per byte state machine.
+ * \param[in] data   Received bytes
+ * \param[in] length Number of bytes in \a data
+ */
+void UAVTalk::processInputData(const quint8 *data, qint32 length)
+{
+    qint32 pos = 0;
+
+    while (pos < length) {
+        if (rxState == STATE_DATA) {
+            // payload bulk path, the only state that spans many bytes
+            qint32 chunk = length - pos;
+            if (chunk > rxLength - rxCount) {
+                chunk = rxLength - rxCount;
+            }
+
+            stats.rxBytes  += chunk;
+            rxPacketLength += chunk;
+            if (useUDPMirror) {
+                rxDataArray.append((const char *)&data[pos], chunk);
             }
+
+            rxCS = Crc::updateCRC(rxCS, &data[pos], chunk);
+            memcpy(&rxBuffer[rxCount], &data[pos], chunk);
+            rxCount += chunk;
+            pos     += chunk;
+
+            if (rxCount == rxLength) {
+                rxCount = 0;
+                rxState = STATE_CS;
+            }
+        } else {
+            processInputByte(data[pos++]);
+
             if (rxState == STATE_COMPLETE) {
                 mutex.lock();
                 if (receiveObject(rxType, rxObjId, rxInstId, rxBuffer, rxLength)) {
                     stats.rxObjectBytes += rxLength;
                     stats.rxObjects++;
+                    ObjectComStats &objStats = objectStats[rxObjId];
+                    objStats.rxObjects++;
+                    objStats.rxBytes += rxPacketLength;
                 } else {
                     // TODO...
                 }
@@ -372,6 +427,12 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
             // Determine data length
             if (rxType == TYPE_OBJ_REQ || rxType == TYPE_ACK || rxType == TYPE_NACK) {
                 rxLength = 0;
+            } else if (rxType == TYPE_OBJ_DELTA) {
+                // delta frames carry a variable number of change records
+                rxLength = packetSize - rxPacketLength;
+            } else if (rxType == TYPE_OBJ_WITH_ACK) {
+                // object data prefixed with a fixed size ack record
+                rxLength = packetSize - rxPacketLength;
             } else {
                 if (rxObj) {
                     rxLength = rxObj->getNumBytes();
@@ -474,8 +535,6 @@ bool UAVTalk::processInputByte(quint8 rxbyte)
  */
 bool UAVTalk::receiveObject(quint8 type, quint32 objId, quint16 instId, quint8 *data, qint32 length)
 {
-    Q_UNUSED(length);
-
     UAVObject *obj    = NULL;
     bool error        = false;
     bool allInstances = (instId == ALL_INSTANCES);
@@ -503,6 +562,54 @@ bool UAVTalk::receiveObject(quint8 type, quint32 objId, quint16 instId, quint8 *
         }
         break;
 
+    case TYPE_OBJ_WITH_ACK:
+        // All instances, not allowed for OBJ_WITH_ACK messages
+        obj = objMngr->getObject(objId);
+        if (!allInstances && (obj != NULL) && (length == (qint32)(ACK_RECORD_LENGTH + obj->getNumBytes()))) {
+            // The ack record completes a transaction just like a standalone ACK
+            {
+                quint32 ackObjId  = qFromLittleEndian<quint32>(&data[0]);
+                quint16 ackInstId = qFromLittleEndian<quint16>(&data[4]);
+                UAVObject *ackObj = objMngr->getObject(ackObjId, ackInstId);
+#ifdef VERBOSE_UAVTALK
+                VERBOSE_FILTER(ackObjId) qDebug() << "UAVTalk - received piggybacked ack" << ackObjId << ackInstId << (ackObj != NULL ? ackObj->toStringBrief() : "<null object>");
+#endif
+                if (ackObj != NULL) {
+                    updateAck(TYPE_ACK, ackObjId, ackInstId, ackObj);
+                }
+            }
+            // The rest of the payload is an ordinary object update
+            obj = updateObject(objId, instId, &data[ACK_RECORD_LENGTH]);
+#ifdef VERBOSE_UAVTALK
+            VERBOSE_FILTER(objId) qDebug() << "UAVTalk - received object" << objId << instId << (obj != NULL ? obj->toStringBrief() : "<null object>");
+#endif
+            if (obj != NULL) {
+                // Like any OBJ message this can ack a pending OBJ_REQ message
+                updateAck(TYPE_OBJ, objId, instId, obj);
+            } else {
+                error = true;
+            }
+        } else {
+            error = true;
+        }
+        break;
+
+    case TYPE_OBJ_DELTA:
+        // All instances, not allowed for OBJ_DELTA messages
+        if (!allInstances) {
+            // Apply the change records on top of the current object data
+            obj = applyObjectDelta(objId, instId, data, length);
+#ifdef VERBOSE_UAVTALK
+            VERBOSE_FILTER(objId) qDebug() << "UAVTalk - received object delta" << objId << instId << (obj != NULL ? obj->toStringBrief() : "<null object>");
+#endif
+            if (obj == NULL) {
+                error = true;
+            }
+        } else {
+            error = true;
+        }
+        break;
+
     case TYPE_OBJ_ACK:
         // All instances, not allowed for OBJ_ACK messages
         if (!allInstances) {
@@ -632,6 +739,49 @@ UAVObject *UAVTalk::updateObject(quint32 objId, quint16 instId, quint8 *data)
     }
 }
 
+/**
+ * Apply a delta frame to an existing object instance.
+ * The payload is a sequence of [offset(2) length(1) bytes...] records
+ * which are patched into the packed representation of the current data.
+ * Deltas are only meaningful against known state, so unlike updateObject
+ * no instance is created if it does not exist yet; the sender's periodic
+ * keyframes (regular OBJ frames) will create it and resynchronize us.
+ */
+UAVObject *UAVTalk::applyObjectDelta(quint32 objId, quint16 instId, quint8 *data, qint32 length)
+{
+    // Get object
+    UAVObject *obj = objMngr->getObject(objId, instId);
+
+    if (obj == NULL) {
+        qWarning() << "UAVTalk - error : delta for unknown object instance" << objId << instId;
+        return NULL;
+    }
+
+    qint32 numBytes = obj->getNumBytes();
+    QByteArray buffer(numBytes, 0);
+    obj->pack((quint8 *)buffer.data());
+
+    qint32 pos = 0;
+    while (pos < length) {
+        if ((length - pos) < 3) {
+            qWarning() << "UAVTalk - error : truncated delta record" << objId;
+            return NULL;
+        }
+        quint16 offset = qFromLittleEndian<quint16>(&data[pos]);
+        quint8 runLength = data[pos + 2];
+        pos += 3;
+        if ((runLength == 0) || ((offset + runLength) > numBytes) || ((pos + runLength) > length)) {
+            qWarning() << "UAVTalk - error : malformed delta record" << objId;
+            return NULL;
+        }
+        memcpy(buffer.data() + offset, &data[pos], runLength);
+        pos += runLength;
+    }
+
+    obj->unpack((quint8 *)buffer.data());
+    return obj;
+}
+
 /**
  * Check if a transaction is pending and if yes complete it.
  */
@@ -808,6 +958,10 @@ bool UAVTalk::transmitSingleObject(quint8 type, quint32 objId, quint16 instId, U
     stats.txObjectBytes += length;
     stats.txBytes += HEADER_LENGTH + length + CHECKSUM_LENGTH;
 
+    ObjectComStats &objStats = objectStats[objId];
+    objStats.txObjects++;
+    objStats.txBytes += HEADER_LENGTH + length + CHECKSUM_LENGTH;
+
     // Done
     return true;
 }
@@ -883,6 +1037,16 @@ const char *UAVTalk::typeToString(quint8 type)
 
         break;
 
+    case TYPE_OBJ_DELTA:
+        return "object delta";
+
+        break;
+
+    case TYPE_OBJ_WITH_ACK:
+        return "object (with ack)";
+
+        break;
+
     case TYPE_OBJ_REQ:
         return "object request";
 
@@ -60,10 +60,20 @@ public:
         quint32 rxCrcErrors;
     } ComStats;
 
+    // Per object type traffic counters, keyed by object ID; byte counts
+    // include the framing overhead so they add up to the link budget
+    typedef struct {
+        quint32 txObjects;
+        quint32 txBytes;
+        quint32 rxObjects;
+        quint32 rxBytes;
+    } ObjectComStats;
+
     UAVTalk(QIODevice *iodev, UAVObjectManager *objMngr);
     ~UAVTalk();
 
     ComStats getStats();
+    QMap<quint32, ObjectComStats> getObjectStats();
     void resetStats();
 
     bool sendObject(UAVObject *obj, bool acked, bool allInstances);
@@ -93,6 +103,16 @@ private:
     static const int TYPE_OBJ_ACK  = (TYPE_VER | 0x02);
     static const int TYPE_ACK      = (TYPE_VER | 0x03);
     static const int TYPE_NACK     = (TYPE_VER | 0x04);
+    // Delta frame : payload is a sequence of [offset(2) length(1) bytes...]
+    // records applied on top of the current object data, interleaved with
+    // periodic full OBJ keyframes by the sender
+    static const int TYPE_OBJ_DELTA = (TYPE_VER | 0x06);
+    // Ordinary object frame whose payload is prefixed with an ack record
+    // [ackObjId(4) ackInstId(2)], acknowledging an earlier OBJ_ACK without
+    // spending a standalone ACK frame
+    static const int TYPE_OBJ_WITH_ACK = (TYPE_VER | 0x07);
+
+    static const int ACK_RECORD_LENGTH = 6;
 
     // header : sync(1), type (1), size(2), object ID(4), instance ID(2)
     static const int HEADER_LENGTH = 10;
@@ -105,6 +125,8 @@ private:
 
     static const int TX_BUFFER_SIZE     = 2 * 1024;
 
+    static const int RX_READ_CHUNK_SIZE = 512;
+
     // Types
     typedef enum {
         STATE_SYNC, STATE_TYPE, STATE_SIZE, STATE_OBJID, STATE_INSTID, STATE_DATA, STATE_CS, STATE_COMPLETE, STATE_ERROR
@@ -117,6 +139,8 @@ private:
 
     ComStats stats;
 
+    QMap<quint32, ObjectComStats> objectStats;
+
     QMutex mutex;
 
     QMap<quint32, QMap<quint32, Transaction *> *> transMap;
@@ -148,8 +172,10 @@ private:
     // Methods
     bool objectTransaction(quint8 type, quint32 objId, quint16 instId, UAVObject *obj);
     bool processInputByte(quint8 rxbyte);
+    void processInputData(const quint8 *data, qint32 length);
     bool receiveObject(quint8 type, quint32 objId, quint16 instId, quint8 *data, qint32 length);
     UAVObject *updateObject(quint32 objId, quint16 instId, quint8 *data);
+    UAVObject *applyObjectDelta(quint32 objId, quint16 instId, quint8 *data, qint32 length);
     void updateAck(quint8 type, quint32 objId, quint16 instId, UAVObject *obj);
     void updateNack(quint32 objId, quint16 instId, UAVObject *obj);
     bool transmitObject(quint8 type, quint32 objId, quint16 instId, UAVObject *obj);
@@ -17,13 +17,15 @@ HEADERS += \
     telemetrymonitor.h \
     telemetrymanager.h \
     uavtalk_global.h \
-    telemetry.h
+    telemetry.h \
+    objectprefetcher.h
 
 SOURCES += \
     uavtalk.cpp \
     uavtalkplugin.cpp \
     telemetrymonitor.cpp \
     telemetrymanager.cpp \
-    telemetry.cpp
+    telemetry.cpp \
+    objectprefetcher.cpp
 
 OTHER_FILES += UAVTalk.pluginspec
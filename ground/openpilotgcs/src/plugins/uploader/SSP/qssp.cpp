@@ -149,6 +149,8 @@ void qssp::ssp_Init(const PortConfig_t *const info)
     thisport->RxError = 0;
     thisport->txSeqNo = 0;
     thisport->rxSeqNo = 0;
+    txWinHead  = 0;
+    txWinCount = 0;
 }
 
 /*!
@@ -169,8 +171,17 @@ int16_t qssp::ssp_SendProcess()
     if (thisport->SendState == SSP_AWAITING_ACK) {
         if (sf_CheckTimeout() == TRUE) {
             if (thisport->retryCount < thisport->maxRetryCount) {
-                // Try again
-                sf_SendPacket();
+                // Try again. With several packets in flight this is a
+                // go-back-N restart: resend every packet the other end has
+                // not acknowledged yet, oldest first.
+                if (txWinCount > 0) {
+                    for (uint8_t n = 0; n < txWinCount; n++) {
+                        sf_SendPacketBuf(txWindow[(txWinHead + n) % SSP_TX_WINDOW_SIZE].buf);
+                    }
+                    thisport->retryCount++;
+                } else {
+                    sf_SendPacket();
+                }
                 sf_SetSendTimeout();
                 value = SSP_TX_WAITING;
             } else {
@@ -178,6 +189,7 @@ int16_t qssp::ssp_SendProcess()
                 value = SSP_TX_TIMEOUT;
                 CLEARBIT(thisport->flags, ACK_RECEIVED);
                 thisport->SendState = SSP_IDLE;
+                txWinCount = 0; // drop whatever was still in flight
                 if (debug) {
                     qDebug() << "Send TimeOut!";
                 }
@@ -277,10 +289,12 @@ uint16_t qssp::ssp_SendDataBlock(uint8_t *data, uint16_t length)
  * \param	length = number of bytes to send
  * \return	SSP_TX_BUFOVERRUN = tried to send too much data
  * \return	SSP_TX_WAITING = data sent and waiting for an ack to arrive
- * \return	SSP_TX_BUSY = a packet has already been sent, but not yet acked
+ * \return	SSP_TX_BUSY = the transmit window is full, all slots are awaiting an ack
  *
  * \note
- *
+ * Up to SSP_TX_WINDOW_SIZE packets may be in flight at a time. Each packet
+ * is kept in its window slot until the other end acknowledges it, so that
+ * it can be resent on a timeout.
  */
 int16_t qssp::ssp_SendData(const uint8_t *data, const uint16_t length)
 {
@@ -289,59 +303,57 @@ int16_t qssp::ssp_SendData(const uint8_t *data, const uint16_t length)
     if ((length + 2) > thisport->txBufSize) {
         // TRYING to send too much data.
         value = SSP_TX_BUFOVERRUN;
-    } else if (thisport->SendState == SSP_IDLE) {
-#ifdef ACTIVE_SYNCH
-        if (thisport->sendSynch == TRUE) {
-            sf_SendSynchPacket();
-        }
-#endif
-
-#ifdef SYNCH_SEND
-        if (length == 0) {
-            // TODO this method could allow a task/user to start a synchronisation step if a zero is mistakenly passed to this function.
-            // could add a check for a NULL data pointer, or use some sort of static flag that can only be accessed by a static function
-            // that must be called before calling this function.
-            // we are attempting to send a synch packet
-            thisport->txSeqNo = 0; // make this zero to cause the other end to re-synch with us
-            SETBIT(thisport->flags, SENT_SYNCH);
-        } else {
-            // we are sending a data packet
-            CLEARBIT(thisport->txSeqNo, ACK_BIT); // make sure we are not sending a ACK packet
-            thisport->txSeqNo++; // update the sequence number.
-            if (thisport->txSeqNo > 0x7F) { // check for sequence number rollover
-                thisport->txSeqNo = 1; // if we do have rollover then reset to 1 not zero,
-                // zero is reserviced for synchronization requests
-            }
+    } else if ((txWinCount == 0) && (thisport->SendState == SSP_AWAITING_ACK)) {
+        // a synchronisation request is still outstanding, wait for its ack first.
+        value = SSP_TX_BUSY;
+        if (debug) {
+            qDebug() << "Error sending TX was busy";
         }
-
-#else
+    } else if (txWinCount < SSP_TX_WINDOW_SIZE) {
         CLEARBIT(thisport->txSeqNo, ACK_BIT); // make sure we are not sending a ACK packet
         thisport->txSeqNo++; // update the sequence number.
         if (thisport->txSeqNo > 0x7F) { // check for sequence number rollover
             thisport->txSeqNo = 1; // if we do have rollover then reset to 1 not zero,
             // zero is reserved for synchronization requests
         }
-#endif // ifdef SYNCH_SEND
-        CLEARBIT(thisport->flags, ACK_RECEIVED);
-        thisport->SendState  = SSP_AWAITING_ACK;
+        TxSlot_t *slot = &txWindow[(txWinHead + txWinCount) % SSP_TX_WINDOW_SIZE];
+        slot->seqNo = thisport->txSeqNo;
+        sf_MakePacket(slot->buf, data, length, thisport->txSeqNo);
+        txWinCount++;
+        if (txWinCount == 1) {
+            // first packet in flight, start the retransmit timer
+            CLEARBIT(thisport->flags, ACK_RECEIVED);
+            thisport->retryCount = 0; // zero out the retry counter for this transmission
+            sf_SetSendTimeout(); // do the timeout values
+        }
+        thisport->SendState = SSP_AWAITING_ACK;
         value = SSP_TX_WAITING;
-        thisport->retryCount = 0; // zero out the retry counter for this transmission
-        sf_MakePacket(thisport->txBuf, data, length, thisport->txSeqNo);
-        sf_SendPacket(); // punch out the packet to the serial port
-        sf_SetSendTimeout(); // do the timeout values
+        sf_SendPacketBuf(slot->buf); // punch out the packet to the serial port
         if (debug) {
             qDebug() << "Sent DATA PACKET:" << thisport->txSeqNo;
         }
     } else {
-        // error we are already sending a packet. Need to wait for the current packet to be acked or timeout.
+        // error the window is full. Need to wait for the oldest packet to be acked or timeout.
         value = SSP_TX_BUSY;
         if (debug) {
-            qDebug() << "Error sending TX was busy";
+            qDebug() << "Error sending TX window was full";
         }
     }
     return value;
 }
 
+/*!
+ * \brief   returns the number of data packets that have been sent but not yet acked
+ * \return  number of unacked packets still in the transmit window
+ *
+ * \note
+ *
+ */
+uint16_t qssp::ssp_OutstandingPackets()
+{
+    return txWinCount;
+}
+
 /*!
  * \brief   Attempts to synchronize the sequence numbers with the other end of the connectin.
  * \param   thisport = which port to use
@@ -362,6 +374,8 @@ uint16_t qssp::ssp_Synchronise()
     uint16_t retval = FALSE;
 
 #ifndef USE_SENDPACKET_DATA
+    txWinHead  = 0; // forget any packets still in flight, we are starting over
+    txWinCount = 0;
     thisport->txSeqNo = 0; // make this zero to cause the other end to re-synch with us
     SETBIT(thisport->flags, SENT_SYNCH);
     // TODO - should this be using ssp_SendPacketData()??
@@ -405,16 +419,31 @@ uint16_t qssp::ssp_Synchronise()
  * Packet should be formed through the use of sf_MakePacket before calling this function.
  */
 void qssp::sf_SendPacket()
+{
+    sf_SendPacketBuf(thisport->txBuf);
+    thisport->retryCount++;
+}
+
+/*!
+ * \brief   sends out a preformatted packet from the given buffer
+ * \param   txBuf = buffer holding the packet, formatted by sf_MakePacket
+ * \return  none.
+ *
+ * \note
+ * Unlike sf_SendPacket this does not touch the retry counter, the window
+ * send and resend code accounts for retries per resend round instead of
+ * per packet.
+ */
+void qssp::sf_SendPacketBuf(uint8_t *txBuf)
 {
     // add 3 to packet data length for: 1 length + 2 CRC (packet overhead)
-    uint8_t packetLen = thisport->txBuf[LENGTH] + 3;
+    uint8_t packetLen = txBuf[LENGTH] + 3;
 
     // use the raw serial write function so the SYNC byte does not get 'escaped'
     thisport->pfSerialWrite(SYNC);
     for (uint8_t x = 0; x < packetLen; x++) {
-        sf_write_byte(thisport->txBuf[x]);
+        sf_write_byte(txBuf[x]);
     }
-    thisport->retryCount++;
 }
 
 
@@ -737,9 +766,36 @@ int16_t qssp::sf_ReceivePacket()
     int16_t value = FALSE;
 
     if (ISBITSET(thisport->rxBuf[SEQNUM], ACK_BIT)) {
-        // Received an ACK packet, need to check if it matches the previous sent packet
-        if ((thisport->rxBuf[SEQNUM] & 0x7F) == (thisport->txSeqNo & 0x7f)) {
-            // It matches the last packet sent by us
+        uint8_t ackSeqNo = thisport->rxBuf[SEQNUM] & 0x7F;
+        if (txWinCount > 0) {
+            // Received an ACK packet, need to check if it matches one of the
+            // outstanding packets in the transmit window. Acks are cumulative:
+            // acking a packet also acks every packet sent before it, so a
+            // lost ack is repaired by the ack of a later packet.
+            uint8_t acked = 0;
+            for (uint8_t n = 0; n < txWinCount; n++) {
+                if (txWindow[(txWinHead + n) % SSP_TX_WINDOW_SIZE].seqNo == ackSeqNo) {
+                    acked = n + 1;
+                    break;
+                }
+            }
+            if (acked) {
+                txWinHead   = (txWinHead + acked) % SSP_TX_WINDOW_SIZE;
+                txWinCount -= acked;
+                if (txWinCount == 0) {
+                    thisport->SendState = SSP_ACKED;
+                } else {
+                    // restart the timer for the new oldest unacked packet
+                    thisport->retryCount = 0;
+                    sf_SetSendTimeout();
+                }
+                if (debug) {
+                    qDebug() << "Received ACK:" << ackSeqNo;
+                }
+            }
+            // else ignore the ACK packet, it is stale or a duplicate
+        } else if (ackSeqNo == (thisport->txSeqNo & 0x7f)) {
+            // It matches the synchronisation request sent by us
             SETBIT(thisport->txSeqNo, ACK_BIT);
             thisport->SendState = SSP_ACKED;
             value = FALSE;
@@ -766,21 +822,37 @@ int16_t qssp::sf_ReceivePacket()
             sf_SendAckPacket(thisport->rxBuf[SEQNUM]);
             value = FALSE;
         } else {
-            // New Packet
-            thisport->rxSeqNo = thisport->rxBuf[SEQNUM];
-            // Let the application do something with the data/packet.
-
-            // skip the first two bytes (length and seq. no.) in the buffer.
-            if (debug) {
-                qDebug() << "Received DATA PACKET seq=" << thisport->rxSeqNo << "Data=" << (uint8_t)thisport->rxBuf[2] << (uint8_t)thisport->rxBuf[3] << (uint8_t)thisport->rxBuf[4];
+            // Figure out the sequence number we expect next. Sequence numbers
+            // roll over from 0x7F back to 1, zero is reserved for
+            // synchronization requests.
+            uint8_t expectedSeqNo = thisport->rxSeqNo + 1;
+            if (expectedSeqNo > 0x7F) {
+                expectedSeqNo = 1;
             }
-            pfCallBack(&(thisport->rxBuf[2]), thisport->rxBufLen);
+            if ((thisport->rxSeqNo == 255) || (thisport->rxBuf[SEQNUM] == expectedSeqNo)) {
+                // New Packet
+                thisport->rxSeqNo = thisport->rxBuf[SEQNUM];
+                // Let the application do something with the data/packet.
 
-            // after we send the ACK, it is possible for the host to send a new packet.
-            // Thus the application needs to copy the data and reset the receive buffer
-            // inside of thisport->pfCallBack()
-            sf_SendAckPacket(thisport->rxBuf[SEQNUM]);
-            value = TRUE;
+                // skip the first two bytes (length and seq. no.) in the buffer.
+                if (debug) {
+                    qDebug() << "Received DATA PACKET seq=" << thisport->rxSeqNo << "Data=" << (uint8_t)thisport->rxBuf[2] << (uint8_t)thisport->rxBuf[3] << (uint8_t)thisport->rxBuf[4];
+                }
+                pfCallBack(&(thisport->rxBuf[2]), thisport->rxBufLen);
+
+                // after we send the ACK, it is possible for the host to send a new packet.
+                // Thus the application needs to copy the data and reset the receive buffer
+                // inside of thisport->pfCallBack()
+                sf_SendAckPacket(thisport->rxBuf[SEQNUM]);
+                value = TRUE;
+            } else {
+                // Out of sequence, a packet in between must have been lost.
+                // Drop the packet but re-ack the last one received in order, so
+                // the sender backs up and resends from the first missing packet.
+                thisport->RxError++;
+                sf_SendAckPacket(thisport->rxSeqNo);
+                value = FALSE;
+            }
         }
     }
     return value;
@@ -805,6 +877,8 @@ qssp::qssp(port *info, bool debug) : debug(debug)
     thisport->RxError = 0;
     thisport->txSeqNo = 0;
     thisport->rxSeqNo = 0;
+    txWinHead  = 0;
+    txWinCount = 0;
 }
 void qssp::pfCallBack(uint8_t *buf, uint16_t size)
 {
@@ -50,6 +50,13 @@
 #define SSP_RX_RECEIVING  1
 #define SSP_RX_COMPLETE   2
 
+// number of data packets that may be in flight (sent but not yet acked) at a
+// time. Acks are cumulative, lost packets trigger a go-back-N resend of every
+// unacked packet.
+#define SSP_TX_WINDOW_SIZE  8
+// largest framed packet: length + seq. no. + data + 2 CRC bytes
+#define SSP_MAX_PACKET_SIZE (1 + 1 + 255 + 2)
+
 // types of packet that can be received
 #define SSP_RX_DATA       5
 #define SSP_RX_ACK        6
@@ -79,10 +86,18 @@ typedef struct {
 
 /** EXTERNAL FUNCTIONS **/
 
+typedef struct {
+    uint8_t buf[SSP_MAX_PACKET_SIZE]; // formatted packet, kept in case a resend is needed
+    uint8_t seqNo; // sequence number the packet was sent with
+} TxSlot_t;
+
 class qssp {
 private:
     port *thisport;
     decodeState_ DecodeState_t;
+    TxSlot_t txWindow[SSP_TX_WINDOW_SIZE]; // packets sent but not yet acked
+    uint8_t txWinHead; // slot of the oldest unacked packet
+    uint8_t txWinCount; // number of unacked packets in the window
     /** PRIVATE FUNCTIONS **/
     // static void      sf_SendSynchPacket( Port_t *thisport );
     uint16_t sf_crc16(uint16_t crc, uint8_t data);
@@ -93,6 +108,7 @@ private:
     int16_t     sf_ReceiveState(uint8_t c);
 
     void        sf_SendPacket();
+    void        sf_SendPacketBuf(uint8_t *txBuf);
     void        sf_SendAckPacket(uint8_t seqNumber);
     void     sf_MakePacket(uint8_t *buf, const uint8_t *pdata, uint16_t length, uint8_t seqNo);
     int16_t     sf_ReceivePacket();
@@ -105,6 +121,7 @@ public:
     int16_t     ssp_SendProcess();
     uint16_t    ssp_SendString(char *str);
     int16_t     ssp_SendData(const uint8_t *data, const uint16_t length);
+    uint16_t    ssp_OutstandingPackets();
     void        ssp_Init(const PortConfig_t *const info);
     int16_t             ssp_ReceiveByte();
     uint16_t    ssp_Synchronise();
@@ -37,8 +37,19 @@ void qsspt::run()
         msleep(1);
         sendbufmutex.lock();
         if (datapending && receivestatus == SSP_TX_IDLE) {
-            this->ssp_SendData(mbuf, msize);
-            datapending = false;
+            if (this->ssp_SendData(mbuf, msize) != SSP_TX_BUSY) {
+                datapending = false;
+            }
+        }
+        // move queued packets into the transmit window until it is full
+        while (!sendqueue.isEmpty()) {
+            QByteArray &packet = sendqueue.head();
+            if (this->ssp_SendData((uint8_t *)packet.data(), packet.size()) == SSP_TX_WAITING) {
+                sendqueue.dequeue();
+                queuewait.wakeAll();
+            } else {
+                break;
+            }
         }
         sendbufmutex.unlock();
         if (sendstatus == SSP_TX_ACKED) {
@@ -62,6 +73,44 @@ bool qsspt::sendData(uint8_t *buf, uint16_t size)
     return true;
 }
 
+/**
+   Queues a packet for transmission and returns as soon as there is room in
+   the send queue, without waiting for the ack. Several packets are kept in
+   flight at a time, call waitAllSent() before switching back to the
+   blocking sendData() path.
+ */
+bool qsspt::sendDataAsync(uint8_t *buf, uint16_t size)
+{
+    sendbufmutex.lock();
+    while (sendqueue.count() >= (2 * SSP_TX_WINDOW_SIZE) && !endthread) {
+        queuewait.wait(&sendbufmutex, 1000);
+    }
+    sendqueue.enqueue(QByteArray((const char *)buf, size));
+    sendbufmutex.unlock();
+    return !endthread;
+}
+
+/**
+   Blocks until every queued packet has been sent and acked, or the timeout
+   (in ms) expires.
+ */
+bool qsspt::waitAllSent(int timeout)
+{
+    QTime time;
+
+    time.start();
+    while (time.elapsed() < timeout) {
+        sendbufmutex.lock();
+        bool pending = !sendqueue.isEmpty();
+        sendbufmutex.unlock();
+        if (!pending && this->ssp_OutstandingPackets() == 0) {
+            return true;
+        }
+        msleep(1);
+    }
+    return false;
+}
+
 void qsspt::pfCallBack(uint8_t *buf, uint16_t size)
 {
     if (debug) {
@@ -95,5 +144,6 @@ int qsspt::read_Packet(void *data)
 qsspt::~qsspt()
 {
     endthread = true;
+    queuewait.wakeAll();
     wait(1000);
 }
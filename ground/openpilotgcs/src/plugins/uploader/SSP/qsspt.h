@@ -40,11 +40,14 @@ public:
     int read_Packet(void *);
     ~qsspt();
     bool sendData(uint8_t *buf, uint16_t size);
+    bool sendDataAsync(uint8_t *buf, uint16_t size);
+    bool waitAllSent(int timeout);
 private:
     virtual void pfCallBack(uint8_t *, uint16_t);
     uint8_t *mbuf;
     uint16_t msize;
     QQueue<QByteArray> queue;
+    QQueue<QByteArray> sendqueue;
     QMutex mutex;
     QMutex sendbufmutex;
     bool endthread;
@@ -52,6 +55,7 @@ private:
     uint16_t sendstatus;
     uint16_t receivestatus;
     QWaitCondition sendwait;
+    QWaitCondition queuewait;
     QMutex msendwait;
     bool debug;
 };
@@ -209,8 +209,11 @@ bool DFUObject::StartUpload(qint32 const & numberOfBytes, TransferTypes const &
         qDebug() << "Number of packets:" << numberOfPackets << " Size of last packet:" << lastPacketCount;
     }
 
+    // Note: this only sends the command. The bootloader starts erasing as
+    // soon as it receives it and answers the next status request once the
+    // erase is complete, so callers wait by polling the status instead of
+    // a fixed worst case delay here.
     int result = sendData(buf, BUF_LEN);
-    delay::msleep(1000);
 
     if (debug) {
         qDebug() << result << " bytes sent";
@@ -278,7 +281,7 @@ bool DFUObject::UploadData(qint32 const & numberOfBytes, QByteArray & data)
         // delay::msleep(send_delay);
 
         // if(StatusRequest()!=OP_DFU::uploading) return false;
-        int result = sendData(buf, BUF_LEN);
+        int result = sendDataAsync(buf, BUF_LEN);
         // qDebug()<<"sent:"<<result;
         if (result < 1) {
             return false;
@@ -286,6 +289,13 @@ bool DFUObject::UploadData(qint32 const & numberOfBytes, QByteArray & data)
 
         // qDebug() << "UPLOAD:"<<"Data="<<(int)buf[6]<<(int)buf[7]<<(int)buf[8]<<(int)buf[9]<<";"<<result << " bytes sent";
     }
+    if (use_serial) {
+        // make sure the board has acked every packet still in flight before
+        // we go back to the blocking request/response commands
+        if (!serialhandle->waitAllSent(10000)) {
+            return false;
+        }
+    }
     cout << "\n";
     // while(true){}
     return true;
@@ -317,6 +327,10 @@ OP_DFU::Status DFUObject::UploadDescription(QVariant desc)
     if (!StartUpload(array.length(), OP_DFU::Descript, 0)) {
         return OP_DFU::abort;
     }
+    // wait for the description area erase to finish
+    if (StatusRequest() != OP_DFU::uploading) {
+        return OP_DFU::abort;
+    }
     if (!UploadData(array.length(), array)) {
         return OP_DFU::abort;
     }
@@ -775,12 +789,12 @@ OP_DFU::Status DFUObject::UploadFirmwareT(const QString &sfile, const bool &veri
     if (debug) {
         qDebug() << "Erasing memory";
     }
-    if (StatusRequest() == OP_DFU::abort) {
-        return OP_DFU::abort;
-    }
 
-    // TODO: why is there a loop there? The "if" statement
-    // will cause a break or return anyway!!
+    // The bootloader answers the status request as soon as the erase is
+    // done, so programming starts with no fixed delay. A request that
+    // comes back as abort most likely just timed out while the erase was
+    // still running, so retry a few times before giving up.
+    ret = OP_DFU::abort;
     for (int x = 0; x < 3; ++x) {
         ret = StatusRequest();
         if (debug) {
@@ -788,10 +802,15 @@ OP_DFU::Status DFUObject::UploadFirmwareT(const QString &sfile, const bool &veri
         }
         if (ret == OP_DFU::uploading) {
             break;
-        } else {
+        }
+        if (ret != OP_DFU::abort) {
+            // a real status reported by the bootloader, not a timeout
             return ret;
         }
     }
+    if (ret != OP_DFU::uploading) {
+        return ret;
+    }
 
     emit operationProgress(QString("Uploading firmware"));
     if (!UploadData(arr.length(), arr)) {
@@ -963,33 +982,42 @@ void DFUObject::printProgBar(int const & percent, QString const & label)
     }
 }
 
+// Byte lookup table for the 0x04C11DB7 polynomial used in the STM32
+// bootloader, built once from the polynomial on first use
+static quint32 crc32Table[256];
+static bool crc32TableBuilt = false;
+
+static void buildCRC32Table()
+{
+    for (quint32 byte = 0; byte < 256; byte++) {
+        quint32 crc = byte << 24;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : (crc << 1);
+        }
+        crc32Table[byte] = crc;
+    }
+    crc32TableBuilt = true;
+}
+
 /**
    Utility function
  */
 quint32 DFUObject::CRC32WideFast(quint32 Crc, quint32 Size, quint32 *Buffer)
 {
-    // Size = Size >> 2; // /4  Size passed in as a byte count, assumed to be a multiple of 4
-
-    while (Size--) {
-        static const quint32 CrcTable[16] = { // Nibble lookup table for 0x04C11DB7 polynomial
-            0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
-            0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD
-        };
+    // Size passed in as a word count
 
-        Crc     = Crc ^ *((quint32 *)Buffer); // Apply all 32-bits
-
-        Buffer += 1;
+    if (!crc32TableBuilt) {
+        buildCRC32Table();
+    }
 
-        // Process 32-bits, 4 at a time, or 8 rounds
+    while (Size--) {
+        quint32 word = *Buffer++;
 
-        Crc = (Crc << 4) ^ CrcTable[Crc >> 28]; // Assumes 32-bit reg, masking index to 4-bits
-        Crc = (Crc << 4) ^ CrcTable[Crc >> 28]; // 0x04C11DB7 Polynomial used in STM32
-        Crc = (Crc << 4) ^ CrcTable[Crc >> 28];
-        Crc = (Crc << 4) ^ CrcTable[Crc >> 28];
-        Crc = (Crc << 4) ^ CrcTable[Crc >> 28];
-        Crc = (Crc << 4) ^ CrcTable[Crc >> 28];
-        Crc = (Crc << 4) ^ CrcTable[Crc >> 28];
-        Crc = (Crc << 4) ^ CrcTable[Crc >> 28];
+        // Process 32-bits, a byte at a time, most significant first
+        Crc = (Crc << 8) ^ crc32Table[(Crc >> 24) ^ (word >> 24)];
+        Crc = (Crc << 8) ^ crc32Table[(Crc >> 24) ^ ((word >> 16) & 0xFF)];
+        Crc = (Crc << 8) ^ crc32Table[(Crc >> 24) ^ ((word >> 8) & 0xFF)];
+        Crc = (Crc << 8) ^ crc32Table[(Crc >> 24) ^ (word & 0xFF)];
     }
 
     return Crc;
@@ -1003,23 +1031,22 @@ quint32 DFUObject::CRCFromQBArray(QByteArray array, quint32 Size)
     quint32 pad = Size - array.length();
 
     array.append(QByteArray(pad, 255));
-    quint32 *t  = new quint32[Size / 4];
-    for (int x = 0; x < array.length() / 4; x++) {
-        quint32 aux = 0;
-        aux  = (char)array[x * 4 + 3] & 0xFF;
-        aux  = aux << 8;
-        aux += (char)array[x * 4 + 2] & 0xFF;
-        aux  = aux << 8;
-        aux += (char)array[x * 4 + 1] & 0xFF;
-        aux  = aux << 8;
-        aux += (char)array[x * 4 + 0] & 0xFF;
-        t[x] = aux;
-    }
-    quint32 ret = DFUObject::CRC32WideFast(0xFFFFFFFF, Size / 4, t);
-
-    delete[] t;
 
-    return ret;
+    if (!crc32TableBuilt) {
+        buildCRC32Table();
+    }
+
+    // The bootloader checksums the firmware as little endian words, so the
+    // bytes of each word are consumed most significant first
+    const quint8 *data = (const quint8 *)array.constData();
+    quint32 crc = 0xFFFFFFFF;
+    for (quint32 x = 0; x < Size; x += 4) {
+        crc = (crc << 8) ^ crc32Table[(crc >> 24) ^ data[x + 3]];
+        crc = (crc << 8) ^ crc32Table[(crc >> 24) ^ data[x + 2]];
+        crc = (crc << 8) ^ crc32Table[(crc >> 24) ^ data[x + 1]];
+        crc = (crc << 8) ^ crc32Table[(crc >> 24) ^ data[x]];
+    }
+    return crc;
 }
 
 
@@ -1046,6 +1073,25 @@ int DFUObject::sendData(void *data, int size)
     return -1;
 }
 
+/**
+   Send data to the bootloader without waiting for the ack. Over serial this
+   keeps several packets in flight, which avoids paying a round trip per
+   packet during firmware upload. The HID path already streams, so it is
+   unchanged.
+ */
+int DFUObject::sendDataAsync(void *data, int size)
+{
+    if (!use_serial) {
+        return hidHandle.send(0, data, size, 5000);
+    }
+
+    // Serial Mode:
+    if (serialhandle->sendDataAsync((uint8_t *)data + 1, size - 1)) {
+        return size;
+    }
+    return -1;
+}
+
 
 /**
    Receive data from the bootloader, either through the serial port
@@ -175,6 +175,7 @@ private:
     int RWFlags;
     qsspt *serialhandle;
     int sendData(void *, int);
+    int sendDataAsync(void *, int);
     int receiveData(void *data, int size);
     uint8_t sspTxBuf[MAX_PACKET_BUF_SIZE];
     uint8_t sspRxBuf[MAX_PACKET_BUF_SIZE];
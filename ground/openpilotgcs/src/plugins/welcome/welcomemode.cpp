@@ -48,6 +48,10 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 
+#include <QEvent>
+#include <QTimer>
+#include <QVBoxLayout>
+
 #include <QtQuick>
 #include <QQuickView>
 #include <QQmlEngine>
@@ -65,7 +69,7 @@ struct WelcomeModePrivate {
     QQuickView *quickView;
 };
 
-WelcomeModePrivate::WelcomeModePrivate()
+WelcomeModePrivate::WelcomeModePrivate() : quickView(NULL)
 {}
 
 // ---  WelcomeMode
@@ -74,26 +78,9 @@ WelcomeMode::WelcomeMode() :
     m_priority(Core::Constants::P_MODE_WELCOME),
     m_newVersionText("")
 {
-    m_d->quickView = new QQuickView;
-    m_d->quickView->setResizeMode(QQuickView::SizeRootObjectToView);
-    m_d->quickView->engine()->rootContext()->setContextProperty("welcomePlugin", this);
-    m_d->quickView->setSource(QUrl("qrc:/welcome/qml/main.qml"));
+    // The QML engine and the version check are expensive to start and are
+    // deferred until the Welcome tab is first shown, see loadContent()
     m_container = NULL;
-
-    QNetworkAccessManager *networkAccessManager = new QNetworkAccessManager;
-
-    // Only attempt to request our version info if the network is accessible
-    if (networkAccessManager->networkAccessible() == QNetworkAccessManager::Accessible) {
-        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), this, SLOT(networkResponseReady(QNetworkReply *)));
-
-        // This will delete the network access manager instance when we're done
-        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), networkAccessManager, SLOT(deleteLater()));
-
-        networkAccessManager->get(QNetworkRequest(QUrl("http://www.openpilot.org/opver")));
-    } else {
-        // No network, can delete this now as we don't need it.
-        delete networkAccessManager;
-    }
 }
 
 WelcomeMode::~WelcomeMode()
@@ -120,13 +107,53 @@ int WelcomeMode::priority() const
 QWidget *WelcomeMode::widget()
 {
     if (!m_container) {
-        m_container = QWidget::createWindowContainer(m_d->quickView);
+        // Plain placeholder; the QML view is only added once the tab is shown
+        m_container = new QWidget;
         m_container->setMinimumSize(64, 64);
         m_container->setSizePolicy(QSizePolicy::MinimumExpanding, QSizePolicy::MinimumExpanding);
+        QVBoxLayout *layout = new QVBoxLayout(m_container);
+        layout->setContentsMargins(0, 0, 0, 0);
+        m_container->installEventFilter(this);
     }
     return m_container;
 }
 
+bool WelcomeMode::eventFilter(QObject *object, QEvent *event)
+{
+    if ((object == m_container) && (event->type() == QEvent::Show) && !m_d->quickView) {
+        // Let the main window finish its first paint before spinning up QML
+        QTimer::singleShot(0, this, SLOT(loadContent()));
+    }
+    return Core::IMode::eventFilter(object, event);
+}
+
+void WelcomeMode::loadContent()
+{
+    if (m_d->quickView) {
+        return;
+    }
+    m_d->quickView = new QQuickView;
+    m_d->quickView->setResizeMode(QQuickView::SizeRootObjectToView);
+    m_d->quickView->engine()->rootContext()->setContextProperty("welcomePlugin", this);
+    m_d->quickView->setSource(QUrl("qrc:/welcome/qml/main.qml"));
+    m_container->layout()->addWidget(QWidget::createWindowContainer(m_d->quickView, m_container));
+
+    QNetworkAccessManager *networkAccessManager = new QNetworkAccessManager;
+
+    // Only attempt to request our version info if the network is accessible
+    if (networkAccessManager->networkAccessible() == QNetworkAccessManager::Accessible) {
+        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), this, SLOT(networkResponseReady(QNetworkReply *)));
+
+        // This will delete the network access manager instance when we're done
+        connect(networkAccessManager, SIGNAL(finished(QNetworkReply *)), networkAccessManager, SLOT(deleteLater()));
+
+        networkAccessManager->get(QNetworkRequest(QUrl("http://www.openpilot.org/opver")));
+    } else {
+        // No network, can delete this now as we don't need it.
+        delete networkAccessManager;
+    }
+}
+
 const char *WelcomeMode::uniqueModeName() const
 {
     return Core::Constants::MODE_WELCOME;
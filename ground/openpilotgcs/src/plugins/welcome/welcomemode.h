@@ -38,6 +38,7 @@
 QT_BEGIN_NAMESPACE
 class QWidget;
 class QUrl;
+class QEvent;
 class QNetworkReply;
 QT_END_NAMESPACE
 
@@ -77,6 +78,8 @@ public:
         return m_newVersionText;
     }
 
+    bool eventFilter(QObject *object, QEvent *event);
+
 signals:
     void newVersionTextChanged();
 
@@ -92,6 +95,7 @@ private:
     QString m_newVersionText;
 
 private slots:
+    void loadContent();
     void networkResponseReady(QNetworkReply *reply);
 };
 } // namespace Welcome
@@ -278,10 +278,21 @@ bool UAVObjectGeneratorFlight::process_object(ObjectInfo *info)
                                     .arg(info->name)
                                     .arg(info->fields[n]->name));
                 setgetfields.append(QString("{\n"));
-                setgetfields.append(QString("    UAVObjGetDataField(%1Handle(), (void *)New%2, offsetof(%1Data, %2), sizeof(%3));\n")
-                                    .arg(info->name)
-                                    .arg(info->fields[n]->name)
-                                    .arg(fieldTypeStrC[info->fields[n]->type]));
+                setgetfields.append(QString("    /* Word sized field, read it directly under a short interrupt-off\n"));
+                setgetfields.append(QString("     * window instead of through the object manager lock.  Writers copy\n"));
+                setgetfields.append(QString("     * with interrupts off too, so the read cannot tear.  The pointer\n"));
+                setgetfields.append(QString("     * is taken before interrupts go off: fetching it can lock the\n"));
+                setgetfields.append(QString("     * manager and fault a flash backed object in, and it is NULL when\n"));
+                setgetfields.append(QString("     * that fails. */\n"));
+                setgetfields.append(QString("    const %1Data *dataPtr = (const %1Data *)UAVObjGetDataPointer(%1Handle());\n")
+                                    .arg(info->name));
+                setgetfields.append(QString("    if (dataPtr == NULL) {\n"));
+                setgetfields.append(QString("        return;\n"));
+                setgetfields.append(QString("    }\n"));
+                setgetfields.append(QString("    PIOS_IRQ_Disable();\n"));
+                setgetfields.append(QString("    *New%1 = dataPtr->%1;\n")
+                                    .arg(info->fields[n]->name));
+                setgetfields.append(QString("    PIOS_IRQ_Enable();\n"));
                 setgetfields.append(QString("}\n"));
             } else {
                 // When no struct accessor is available for a field array accessor is the default.
@@ -283,6 +283,15 @@ bool UAVObjectGeneratorGCS::process_object(ObjectInfo *info)
     // Replace the $(DATAFIELDINFO) tag
     QString name;
     QString enums;
+    // Compile-time field indices, pair with UAVObject::getFieldByIndex()
+    // so telemetry-driven code can avoid field name string lookups
+    enums.append("    /* Field index enumeration */\n");
+    enums.append("    typedef enum { ");
+    for (int n = 0; n < info->fields.length(); ++n) {
+        QString s = (n != (info->fields.length() - 1)) ? "%1_FIELDINDEX=%2, " : "%1_FIELDINDEX=%2";
+        enums.append(s.arg(info->fields[n]->name.toUpper()).arg(n));
+    }
+    enums.append(" } FieldIndex;\n\n");
     for (int n = 0; n < info->fields.length(); ++n) {
         enums.append(QString("    // Field %1 information\n").arg(info->fields[n]->name));
         // Only for enum types
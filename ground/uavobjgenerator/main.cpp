@@ -24,9 +24,13 @@
  * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
  */
 #include <QtCore/QCoreApplication>
+#include <QCryptographicHash>
 #include <QFile>
+#include <QFuture>
+#include <QMap>
 #include <QString>
 #include <QStringList>
+#include <QtConcurrentRun>
 #include <iostream>
 
 #include "generators/java/uavobjectgeneratorjava.h"
@@ -145,6 +149,14 @@ int main(int argc, char *argv[])
     xmlPath.setNameFilters(filters);
     QFileInfoList xmlList   = xmlPath.entryInfoList();
 
+    // Content hash manifest of the previous run, used to skip generation
+    // entirely when no definition (and no language selection) changed.
+    // One line per XML file plus one line for the selected languages.
+    QStringList manifest_stringlist;
+    manifest_stringlist << QString("languages: gcs=%1 flight=%2 java=%3 python=%4 matlab=%5 wireshark=%6")
+        .arg(do_gcs | do_all).arg(do_flight | do_all).arg(do_java | do_all)
+        .arg(do_python | do_all).arg(do_matlab | do_all).arg(do_wireshark | do_all);
+
     // Read in each XML file and parse object(s) in them
 
     for (int n = 0; n < xmlList.length(); ++n) {
@@ -163,6 +175,9 @@ int main(int argc, char *argv[])
         QString filename = fileinfo.fileName();
         QString xmlstr   = readFile(fileinfo.absoluteFilePath());
 
+        manifest_stringlist << QString(QCryptographicHash::hash(xmlstr.toUtf8(), QCryptographicHash::Sha1).toHex())
+            + " " + filename;
+
         QString res = parser->parseXML(xmlstr, filename);
 
         if (!res.isNull()) {
@@ -209,46 +224,110 @@ int main(int argc, char *argv[])
         return RETURN_OK;
     }
 
+    // The templates shape the outputs just as much as the definitions do,
+    // so they are part of the manifest as well.
+    QStringList templatedirs;
+    templatedirs << "flight/uavobjects"
+                 << "flight/uavobjects/inc"
+                 << "flight/modules/FlightPlan/lib"
+                 << "ground/openpilotgcs/src/plugins/uavobjects"
+                 << "ground/openpilotgcs/src/plugins/uavobjects/wireshark/op-uavobjects"
+                 << "ground/openpilotgcs/src/libs/juavobjects/templates";
+    foreach(const QString &dirname, templatedirs) {
+        QDir templatedir(templatepath + dirname);
+        foreach(const QFileInfo &templateinfo, templatedir.entryInfoList(QStringList("*.template"), QDir::Files, QDir::Name)) {
+            QString templatestr = readFile(templateinfo.absoluteFilePath());
+            manifest_stringlist << QString(QCryptographicHash::hash(templatestr.toUtf8(), QCryptographicHash::Sha1).toHex())
+                + " " + dirname + "/" + templateinfo.fileName();
+        }
+    }
+
+    // Compare the manifest against the previous run. Unchanged outputs are
+    // never rewritten (so their timestamps are preserved and nothing
+    // downstream rebuilds), and if no definition changed at all the
+    // generators are skipped entirely. Partial runs (explicit UAVObject
+    // arguments) do not cover all outputs, so they bypass the manifest.
+    QString manifestpath = outputpath + "uavobjgenerator.hashes";
+    QString manifeststr  = manifest_stringlist.join("\n") + "\n";
+    if (do_allObjects) {
+        QString old_manifeststr = readFile(manifestpath, false);
+        if (old_manifeststr == manifeststr) {
+            cout << "No UAVObject definition changed since the last run, outputs are up to date." << endl;
+            return RETURN_OK;
+        }
+        if (verbose && !old_manifeststr.isEmpty()) {
+            QMap<QString, QString> old_hashes;
+            foreach(const QString &line, old_manifeststr.split("\n", QString::SkipEmptyParts)) {
+                old_hashes.insert(line.section(' ', 1), line.section(' ', 0, 0));
+            }
+            foreach(const QString &line, manifest_stringlist) {
+                QString name = line.section(' ', 1);
+                if (old_hashes.value(name) != line.section(' ', 0, 0)) {
+                    cout << "changed since last run: " << name.toStdString() << endl;
+                }
+            }
+        }
+    }
+
+    bool gen_ok = true;
+
+    // The backends only read the parsed object tree and write to disjoint
+    // output directories, so each requested language runs as its own
+    // QtConcurrent task and generation scales with the host cores.
+    UAVObjectGeneratorFlight flightgen;
+    UAVObjectGeneratorGCS gcsgen;
+    UAVObjectGeneratorJava javagen;
+    UAVObjectGeneratorPython pygen;
+    UAVObjectGeneratorMatlab matlabgen;
+    UAVObjectGeneratorWireshark wiresharkgen;
+
+    QList<QFuture<bool> > generators;
+
     // generate flight code if wanted
     if (do_flight | do_all) {
         cout << "generating flight code" << endl;
-        UAVObjectGeneratorFlight flightgen;
-        flightgen.generate(parser, templatepath, outputpath);
+        generators << QtConcurrent::run(&flightgen, &UAVObjectGeneratorFlight::generate, parser, templatepath, outputpath);
     }
 
     // generate gcs code if wanted
     if (do_gcs | do_all) {
         cout << "generating gcs code" << endl;
-        UAVObjectGeneratorGCS gcsgen;
-        gcsgen.generate(parser, templatepath, outputpath);
+        generators << QtConcurrent::run(&gcsgen, &UAVObjectGeneratorGCS::generate, parser, templatepath, outputpath);
     }
 
     // generate java code if wanted
     if (do_java | do_all) {
         cout << "generating java code" << endl;
-        UAVObjectGeneratorJava javagen;
-        javagen.generate(parser, templatepath, outputpath);
+        generators << QtConcurrent::run(&javagen, &UAVObjectGeneratorJava::generate, parser, templatepath, outputpath);
     }
 
     // generate python code if wanted
     if (do_python | do_all) {
         cout << "generating python code" << endl;
-        UAVObjectGeneratorPython pygen;
-        pygen.generate(parser, templatepath, outputpath);
+        generators << QtConcurrent::run(&pygen, &UAVObjectGeneratorPython::generate, parser, templatepath, outputpath);
     }
 
     // generate matlab code if wanted
     if (do_matlab | do_all) {
         cout << "generating matlab code" << endl;
-        UAVObjectGeneratorMatlab matlabgen;
-        matlabgen.generate(parser, templatepath, outputpath);
+        generators << QtConcurrent::run(&matlabgen, &UAVObjectGeneratorMatlab::generate, parser, templatepath, outputpath);
     }
 
     // generate wireshark plugin if wanted
     if (do_wireshark | do_all) {
         cout << "generating wireshark code" << endl;
-        UAVObjectGeneratorWireshark wiresharkgen;
-        wiresharkgen.generate(parser, templatepath, outputpath);
+        generators << QtConcurrent::run(&wiresharkgen, &UAVObjectGeneratorWireshark::generate, parser, templatepath, outputpath);
+    }
+
+    // result() waits for the task to finish
+    for (int i = 0; i < generators.length(); ++i) {
+        gen_ok &= generators[i].result();
+    }
+
+    // Record the manifest only after a fully successful run over all
+    // objects, a failed or partial run must not mark outputs up to date.
+    if (do_allObjects && gen_ok) {
+        writeFile(manifestpath, manifeststr);
     }
 
     return RETURN_OK;
@@ -4,6 +4,7 @@
 #
 
 QT += xml
+QT += concurrent
 QT -= gui
 macx {
     QMAKE_CXXFLAGS  += -fpermissive
@@ -86,6 +86,7 @@ SRC += $(PIOSCOMMON)/pios_sdcard.c
 SRC += $(FLIGHTLIB)/sanitycheck.c
 SRC += $(FLIGHTLIB)/CoordinateConversions.c
 SRC += $(MATHLIB)/sin_lookup.c
+SRC += $(MATHLIB)/atan_lookup.c
 SRC += $(MATHLIB)/pid.c
 
 ## PIOS Hardware (Common)
@@ -115,9 +116,11 @@ SRC += $(PIOSCOMMON)/pios_instrumentation.c
 SRC += $(PIOSCOMMON)/pios_mem.c
 ## Misc library functions
 SRC += $(FLIGHTLIB)/fifo_buffer.c
+SRC += $(FLIGHTLIB)/lzss.c
 
 SRC += $(MATHLIB)/mathmisc.c
 SRC += $(MATHLIB)/butterworth.c
+SRC += $(MATHLIB)/filterbank.c
 SRC += $(FLIGHTLIB)/printf-stdarg.c
 SRC += $(FLIGHTLIB)/optypes.c
 